@@ -106,6 +106,7 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
 {
     CMN_LOG_CLASS_INIT_DEBUG << "SetOutput: file \"" << fileName
                              << "\" using file format \"" << fileFormat << "\"" << std::endl;
+    this->FlushPendingOutput();
     // test if there was a file opened before
     if (this->OutputFile) {
         CMN_LOG_CLASS_INIT_VERBOSE << "SetOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
@@ -144,6 +145,9 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
         case COLLECTOR_FILE_FORMAT_PLAIN_TEXT:
             ext = ".txt";
             break;
+        case COLLECTOR_FILE_FORMAT_COLUMNAR:
+            ext = ".ccol";
+            break;
         default:
             ext = ".cdat";
             break;
@@ -170,6 +174,7 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
 
     case COLLECTOR_FILE_FORMAT_PLAIN_TEXT:
     case COLLECTOR_FILE_FORMAT_BINARY:
+    case COLLECTOR_FILE_FORMAT_COLUMNAR:
     default:
         Delimiter = ' ';
         break;
@@ -179,6 +184,7 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
 
 void mtsCollectorBase::CloseOutput(void)
 {
+    this->FlushPendingOutput();
     if (this->FileOpened) {
         CMN_LOG_CLASS_INIT_VERBOSE << "CloseOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
         this->OutputFile->close();
@@ -213,6 +219,12 @@ void mtsCollectorBase::OpenFileIfNeeded(void)
         this->OutputHeaderFile->open(this->OutputHeaderFileName.c_str(), std::ios::trunc);
         this->FileOpened = true;
         break;
+    case COLLECTOR_FILE_FORMAT_COLUMNAR:
+        // data file is created by the derived class, see mtsCollectorState
+        CMN_LOG_CLASS_INIT_VERBOSE << "SetOutput: opening header file \"" << this->OutputHeaderFileName << "\" for columnar output" << std::endl;
+        this->OutputHeaderFile->open(this->OutputHeaderFileName.c_str(), std::ios::trunc);
+        this->FileOpened = true;
+        break;
     default:
         CMN_LOG_CLASS_INIT_ERROR << "SetOutput: unexpected file format.";
         break;
@@ -233,6 +245,8 @@ void mtsCollectorBase::SetOutputToDefault(const CollectorFileFormat fileFormat)
         suffix = "txt";
     } else if (fileFormat == COLLECTOR_FILE_FORMAT_CSV) {
         suffix = "csv";
+    } else if (fileFormat == COLLECTOR_FILE_FORMAT_COLUMNAR) {
+        suffix = "ccol"; // for cisst columnar
     } else {
         suffix = "cdat"; // for cisst dat
     }
@@ -267,6 +281,7 @@ void mtsCollectorBase::SetOutputToDefault(void)
 void mtsCollectorBase::SetOutput(std::ostream & outputStream, const CollectorFileFormat fileFormat)
 {
     CMN_LOG_CLASS_INIT_DEBUG << "SetOutput: using user provided output stream with file format \"" << fileFormat << "\"" << std::endl;
+    this->FlushPendingOutput();
     // test if there was a file opened before
     if (this->OutputFile) {
         CMN_LOG_CLASS_INIT_VERBOSE << "SetOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
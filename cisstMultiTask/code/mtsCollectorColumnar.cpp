@@ -0,0 +1,696 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstMultiTask/mtsCollectorColumnar.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnUnits.h>
+
+#include <sstream>
+#include <algorithm>
+
+#if (CISST_OS == CISST_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const char mtsCollectorColumnar::FileMagic[8] = {'c', 'i', 's', 's', 't', 'C', 'O', 'L'};
+const char mtsCollectorColumnar::ChunkMagic[4] = {'C', 'H', 'N', 'K'};
+const unsigned int mtsCollectorColumnar::ByteOrderMark = 0x01020304;
+
+namespace {
+    // alignment used for the write buffers, matches most page sizes
+    const size_t mtsCollectorColumnarPageSize = 4096;
+
+    void mtsCollectorColumnarAppend(std::vector<char> & output, const void * data, size_t size)
+    {
+        const char * bytes = static_cast<const char *>(data);
+        output.insert(output.end(), bytes, bytes + size);
+    }
+
+    void mtsCollectorColumnarAppendString(std::vector<char> & output, const std::string & value)
+    {
+        const unsigned int length = static_cast<unsigned int>(value.size());
+        mtsCollectorColumnarAppend(output, &length, sizeof(length));
+        mtsCollectorColumnarAppend(output, value.data(), value.size());
+        output.resize(mtsCollectorColumnar::Align(output.size(), mtsCollectorColumnar::ALIGNMENT), 0);
+    }
+}
+
+
+size_t mtsCollectorColumnar::SignalColumnsSize(const SignalDescription & signal,
+                                               size_t numberOfRows, size_t serializedSize)
+{
+    size_t size = Align(numberOfRows * sizeof(double), ALIGNMENT) // timestamps
+        + Align(numberOfRows, ALIGNMENT);                         // valid flags
+    if (signal.Encoding == ENCODING_RAW) {
+        size += Align(numberOfRows * signal.PayloadSize, ALIGNMENT);
+    } else {
+        size += Align((numberOfRows + 1) * sizeof(unsigned long long), ALIGNMENT)
+            + Align(serializedSize, ALIGNMENT);
+    }
+    return size;
+}
+
+
+mtsCollectorColumnarWriter::mtsCollectorColumnarWriter(void):
+    File(0),
+    ProducerIndex(0),
+    WriterIndex(0),
+    Pending(0),
+    Stopping(false),
+    WriteError(false),
+    ThreadRunning(false)
+{
+}
+
+
+mtsCollectorColumnarWriter::~mtsCollectorColumnarWriter()
+{
+    this->Close();
+}
+
+
+bool mtsCollectorColumnarWriter::Open(const std::string & fileName,
+                                      const std::string & description,
+                                      const mtsCollectorColumnar::SignalsType & signals,
+                                      double timeOrigin,
+                                      size_t numberOfBuffers,
+                                      size_t bufferSize)
+{
+    this->Close();
+    this->File = std::fopen(fileName.c_str(), "wb");
+    if (!this->File) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Open: unable to create file \""
+                           << fileName << "\"" << std::endl;
+        return false;
+    }
+    this->FileName = fileName;
+    // buffers are large and aligned, bypass the stdio buffer
+    std::setvbuf(this->File, 0, _IONBF, 0);
+    if (!this->WriteHeader(description, signals, timeOrigin)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Open: failed to write header in file \""
+                           << fileName << "\"" << std::endl;
+        std::fclose(this->File);
+        this->File = 0;
+        return false;
+    }
+
+    // double buffering at least
+    if (numberOfBuffers < 2) {
+        numberOfBuffers = 2;
+    }
+    this->Buffers.resize(numberOfBuffers);
+    for (size_t index = 0; index < numberOfBuffers; index++) {
+        Buffer & buffer = this->Buffers[index];
+        buffer.Allocation = 0;
+        buffer.Memory = 0;
+        buffer.Capacity = 0;
+        buffer.Size = 0;
+        this->Reallocate(buffer, bufferSize);
+    }
+    this->ProducerIndex = 0;
+    this->WriterIndex = 0;
+    this->Pending = 0;
+    this->Stopping = false;
+    this->WriteError = false;
+    this->Thread.Create(this, &mtsCollectorColumnarWriter::Run, 0, "ColWriter");
+    this->ThreadRunning = true;
+    return true;
+}
+
+
+bool mtsCollectorColumnarWriter::WriteHeader(const std::string & description,
+                                             const mtsCollectorColumnar::SignalsType & signals,
+                                             double timeOrigin)
+{
+    mtsCollectorColumnar::FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, mtsCollectorColumnar::FileMagic, sizeof(header.Magic));
+    header.Version = mtsCollectorColumnar::VERSION;
+    header.ByteOrder = mtsCollectorColumnar::ByteOrderMark;
+    header.NumberOfSignals = static_cast<unsigned int>(signals.size());
+    header.TimeOrigin = timeOrigin;
+
+    std::vector<char> output;
+    mtsCollectorColumnarAppend(output, &header, sizeof(header));
+    mtsCollectorColumnarAppendString(output, description);
+    unsigned int value;
+    mtsCollectorColumnar::SignalsType::const_iterator signal;
+    for (signal = signals.begin(); signal != signals.end(); ++signal) {
+        value = static_cast<unsigned int>(signal->Encoding);
+        mtsCollectorColumnarAppend(output, &value, sizeof(value));
+        value = static_cast<unsigned int>(signal->PayloadSize);
+        mtsCollectorColumnarAppend(output, &value, sizeof(value));
+        mtsCollectorColumnarAppendString(output, signal->Name);
+        mtsCollectorColumnarAppendString(output, signal->TypeName);
+    }
+    output.resize(mtsCollectorColumnar::Align(output.size(), mtsCollectorColumnar::CHUNK_ALIGNMENT), 0);
+    // update header size now that it is known
+    reinterpret_cast<mtsCollectorColumnar::FileHeader *>(&(output[0]))->HeaderSize = output.size();
+    return (std::fwrite(&(output[0]), 1, output.size(), this->File) == output.size());
+}
+
+
+void mtsCollectorColumnarWriter::Reallocate(Buffer & buffer, size_t size)
+{
+    if (buffer.Capacity >= size) {
+        return;
+    }
+    delete[] buffer.Allocation;
+    const size_t capacity = mtsCollectorColumnar::Align(size, mtsCollectorColumnarPageSize);
+    buffer.Allocation = new char[capacity + mtsCollectorColumnarPageSize];
+    const size_t address = reinterpret_cast<size_t>(buffer.Allocation);
+    buffer.Memory = buffer.Allocation
+        + (mtsCollectorColumnar::Align(address, mtsCollectorColumnarPageSize) - address);
+    buffer.Capacity = capacity;
+}
+
+
+void mtsCollectorColumnarWriter::Close(void)
+{
+    if (!this->File) {
+        return;
+    }
+    if (this->ThreadRunning) {
+        this->Mutex.Lock();
+        this->Stopping = true;
+        this->Mutex.Unlock();
+        this->DataSignal.Raise();
+        this->Thread.Wait();
+        this->ThreadRunning = false;
+    }
+    if (this->WriteError) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Close: some data could not be written to file \""
+                           << this->FileName << "\"" << std::endl;
+    }
+    std::fclose(this->File);
+    this->File = 0;
+    for (size_t index = 0; index < this->Buffers.size(); index++) {
+        delete[] this->Buffers[index].Allocation;
+    }
+    this->Buffers.clear();
+}
+
+
+char * mtsCollectorColumnarWriter::Reserve(size_t size)
+{
+    if (!this->File) {
+        return 0;
+    }
+    // wait for the writer thread to release a buffer
+    this->Mutex.Lock();
+    while (this->Pending == this->Buffers.size()) {
+        this->Mutex.Unlock();
+        this->SpaceSignal.Wait(0.01 * cmn_s);
+        this->Mutex.Lock();
+    }
+    Buffer & buffer = this->Buffers[this->ProducerIndex];
+    this->Mutex.Unlock();
+    // buffer is owned by the producer until committed
+    this->Reallocate(buffer, size);
+    return buffer.Memory;
+}
+
+
+void mtsCollectorColumnarWriter::Commit(size_t size)
+{
+    this->Mutex.Lock();
+    this->Buffers[this->ProducerIndex].Size = size;
+    this->ProducerIndex = (this->ProducerIndex + 1) % this->Buffers.size();
+    this->Pending++;
+    this->Mutex.Unlock();
+    this->DataSignal.Raise();
+}
+
+
+bool mtsCollectorColumnarWriter::HasWriteError(void)
+{
+    this->Mutex.Lock();
+    const bool result = this->WriteError;
+    this->Mutex.Unlock();
+    return result;
+}
+
+
+void * mtsCollectorColumnarWriter::Run(int CMN_UNUSED(data))
+{
+    Buffer * buffer;
+    bool error;
+    while (true) {
+        this->Mutex.Lock();
+        // the signal can be raised before we wait, use a timeout
+        while ((this->Pending == 0) && !this->Stopping) {
+            this->Mutex.Unlock();
+            this->DataSignal.Wait(0.01 * cmn_s);
+            this->Mutex.Lock();
+        }
+        if (this->Pending == 0) {
+            // stopping and all buffers have been written
+            this->Mutex.Unlock();
+            break;
+        }
+        buffer = &(this->Buffers[this->WriterIndex]);
+        this->Mutex.Unlock();
+
+        error = (std::fwrite(buffer->Memory, 1, buffer->Size, this->File) != buffer->Size);
+
+        this->Mutex.Lock();
+        if (error) {
+            this->WriteError = true;
+        }
+        this->WriterIndex = (this->WriterIndex + 1) % this->Buffers.size();
+        this->Pending--;
+        this->Mutex.Unlock();
+        this->SpaceSignal.Raise();
+    }
+    std::fflush(this->File);
+    return 0;
+}
+
+
+mtsCollectorColumnarReader::mtsCollectorColumnarReader(void):
+    Data(0),
+    DataSize(0),
+    MappingHandle(0),
+    TimeOrigin(0.0),
+    NumberOfRows(0)
+{
+}
+
+
+mtsCollectorColumnarReader::~mtsCollectorColumnarReader()
+{
+    this->Close();
+}
+
+
+bool mtsCollectorColumnarReader::Map(const std::string & fileName)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart == 0)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return false;
+    }
+    void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+    this->MappingHandle = mapping;
+    this->Data = static_cast<const char *>(data);
+    this->DataSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int file = open(fileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat fileStatus;
+    if ((fstat(file, &fileStatus) != 0) || (fileStatus.st_size == 0)) {
+        close(file);
+        return false;
+    }
+    void * data = mmap(0, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    // the mapping remains valid after the file is closed
+    close(file);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    this->Data = static_cast<const char *>(data);
+    this->DataSize = static_cast<size_t>(fileStatus.st_size);
+#endif
+    return true;
+}
+
+
+void mtsCollectorColumnarReader::Unmap(void)
+{
+    if (!this->Data) {
+        return;
+    }
+#if (CISST_OS == CISST_WINDOWS)
+    UnmapViewOfFile(this->Data);
+    CloseHandle(static_cast<HANDLE>(this->MappingHandle));
+    this->MappingHandle = 0;
+#else
+    munmap(const_cast<char *>(this->Data), this->DataSize);
+#endif
+    this->Data = 0;
+    this->DataSize = 0;
+}
+
+
+bool mtsCollectorColumnarReader::Open(const std::string & fileName)
+{
+    this->Close();
+    if (!this->Map(fileName)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::Open: unable to map file \""
+                           << fileName << "\"" << std::endl;
+        return false;
+    }
+    size_t offset = 0;
+    if (!this->ParseHeader(offset)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::Open: invalid header in file \""
+                           << fileName << "\"" << std::endl;
+        this->Close();
+        return false;
+    }
+    while (offset < this->DataSize) {
+        if (!this->ParseChunk(offset)) {
+            CMN_LOG_INIT_WARNING << "mtsCollectorColumnarReader::Open: ignoring incomplete data at offset "
+                                 << offset << " in file \"" << fileName << "\"" << std::endl;
+            break;
+        }
+    }
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorColumnarReader::Open: file \"" << fileName << "\" contains "
+                         << this->NumberOfRows << " row(s) in " << this->Chunks.size() << " chunk(s)" << std::endl;
+    return true;
+}
+
+
+void mtsCollectorColumnarReader::Close(void)
+{
+    this->Unmap();
+    this->Description.clear();
+    this->TimeOrigin = 0.0;
+    this->Signals.clear();
+    this->Chunks.clear();
+    this->NumberOfRows = 0;
+}
+
+
+bool mtsCollectorColumnarReader::ParseHeader(size_t & offset)
+{
+    if (this->DataSize < sizeof(mtsCollectorColumnar::FileHeader)) {
+        return false;
+    }
+    const mtsCollectorColumnar::FileHeader * header =
+        reinterpret_cast<const mtsCollectorColumnar::FileHeader *>(this->Data);
+    if ((memcmp(header->Magic, mtsCollectorColumnar::FileMagic, sizeof(header->Magic)) != 0)
+        || (header->ByteOrder != mtsCollectorColumnar::ByteOrderMark)
+        || (header->Version > mtsCollectorColumnar::VERSION)
+        || (header->HeaderSize > this->DataSize)) {
+        return false;
+    }
+    this->TimeOrigin = header->TimeOrigin;
+    const size_t end = static_cast<size_t>(header->HeaderSize);
+    offset = sizeof(mtsCollectorColumnar::FileHeader);
+
+    // strings are stored as length and characters, padded
+    std::string * strings[2];
+    unsigned int length;
+    size_t index, stringIndex;
+    if (offset + sizeof(length) > end) {
+        return false;
+    }
+    memcpy(&length, this->Data + offset, sizeof(length));
+    offset += sizeof(length);
+    if (offset + length > end) {
+        return false;
+    }
+    this->Description.assign(this->Data + offset, length);
+    offset = mtsCollectorColumnar::Align(offset + length, mtsCollectorColumnar::ALIGNMENT);
+
+    unsigned int values[2];
+    this->Signals.resize(header->NumberOfSignals);
+    for (index = 0; index < this->Signals.size(); index++) {
+        mtsCollectorColumnar::SignalDescription & signal = this->Signals[index];
+        if (offset + sizeof(values) > end) {
+            return false;
+        }
+        memcpy(values, this->Data + offset, sizeof(values));
+        offset += sizeof(values);
+        signal.Encoding = static_cast<mtsCollectorColumnar::EncodingType>(values[0]);
+        signal.PayloadSize = values[1];
+        strings[0] = &(signal.Name);
+        strings[1] = &(signal.TypeName);
+        for (stringIndex = 0; stringIndex < 2; stringIndex++) {
+            if (offset + sizeof(length) > end) {
+                return false;
+            }
+            memcpy(&length, this->Data + offset, sizeof(length));
+            offset += sizeof(length);
+            if (offset + length > end) {
+                return false;
+            }
+            strings[stringIndex]->assign(this->Data + offset, length);
+            offset = mtsCollectorColumnar::Align(offset + length, mtsCollectorColumnar::ALIGNMENT);
+        }
+    }
+    offset = end;
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::ParseChunk(size_t & offset)
+{
+    if (offset + sizeof(mtsCollectorColumnar::ChunkHeader) > this->DataSize) {
+        return false;
+    }
+    const mtsCollectorColumnar::ChunkHeader * header =
+        reinterpret_cast<const mtsCollectorColumnar::ChunkHeader *>(this->Data + offset);
+    if ((memcmp(header->Magic, mtsCollectorColumnar::ChunkMagic, sizeof(header->Magic)) != 0)
+        || (header->ChunkSize == 0)
+        || (header->ChunkSize > this->DataSize - offset)) {
+        return false;
+    }
+    const size_t end = offset + static_cast<size_t>(header->ChunkSize);
+    const size_t rows = header->NumberOfRows;
+    const size_t alignment = mtsCollectorColumnar::ALIGNMENT;
+    size_t position = offset + sizeof(mtsCollectorColumnar::ChunkHeader);
+
+    Chunk chunk;
+    chunk.FirstRow = this->NumberOfRows;
+    chunk.NumberOfRows = rows;
+    chunk.FirstTime = header->FirstTime;
+    chunk.LastTime = header->LastTime;
+    chunk.Ticks = reinterpret_cast<const unsigned long long *>(this->Data + position);
+    position += mtsCollectorColumnar::Align(rows * sizeof(unsigned long long), alignment);
+    chunk.Time = reinterpret_cast<const double *>(this->Data + position);
+    position += mtsCollectorColumnar::Align(rows * sizeof(double), alignment);
+
+    chunk.Signals.resize(this->Signals.size());
+    for (size_t index = 0; index < this->Signals.size(); index++) {
+        SignalColumns & columns = chunk.Signals[index];
+        columns.Timestamps = reinterpret_cast<const double *>(this->Data + position);
+        position += mtsCollectorColumnar::Align(rows * sizeof(double), alignment);
+        columns.Valid = this->Data + position;
+        position += mtsCollectorColumnar::Align(rows, alignment);
+        if (this->Signals[index].Encoding == mtsCollectorColumnar::ENCODING_RAW) {
+            columns.Offsets = 0;
+            columns.Payloads = this->Data + position;
+            position += mtsCollectorColumnar::Align(rows * this->Signals[index].PayloadSize, alignment);
+        } else {
+            columns.Offsets = reinterpret_cast<const unsigned long long *>(this->Data + position);
+            position += mtsCollectorColumnar::Align((rows + 1) * sizeof(unsigned long long), alignment);
+            if (position > end) {
+                return false;
+            }
+            columns.Payloads = this->Data + position;
+            position += mtsCollectorColumnar::Align(static_cast<size_t>(columns.Offsets[rows]), alignment);
+        }
+        if (position > end) {
+            return false;
+        }
+    }
+    if (rows != 0) {
+        this->Chunks.push_back(chunk);
+        this->NumberOfRows += rows;
+    }
+    offset = end;
+    return true;
+}
+
+
+int mtsCollectorColumnarReader::GetSignalIndex(const std::string & name) const
+{
+    for (size_t index = 0; index < this->Signals.size(); index++) {
+        if (this->Signals[index].Name == name) {
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+
+
+bool mtsCollectorColumnarReader::LocateRow(size_t row, const Chunk * & chunk, size_t & rowInChunk) const
+{
+    if (row >= this->NumberOfRows) {
+        return false;
+    }
+    // binary search for the last chunk starting at or before row
+    size_t low = 0;
+    size_t high = this->Chunks.size();
+    size_t middle;
+    while (high - low > 1) {
+        middle = (low + high) / 2;
+        if (this->Chunks[middle].FirstRow <= row) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    chunk = &(this->Chunks[low]);
+    rowInChunk = row - chunk->FirstRow;
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::FindRows(double startTime, double endTime,
+                                          size_t & firstRow, size_t & lastRow) const
+{
+    if (this->Chunks.empty() || (startTime > endTime)) {
+        return false;
+    }
+    // first chunk ending at or after startTime
+    size_t first = 0;
+    while ((first < this->Chunks.size()) && (this->Chunks[first].LastTime < startTime)) {
+        first++;
+    }
+    if (first == this->Chunks.size()) {
+        return false;
+    }
+    // last chunk starting at or before endTime
+    size_t last = this->Chunks.size();
+    while ((last > 0) && (this->Chunks[last - 1].FirstTime > endTime)) {
+        last--;
+    }
+    if (last == 0) {
+        return false;
+    }
+    last--;
+    const Chunk & chunkFirst = this->Chunks[first];
+    const Chunk & chunkLast = this->Chunks[last];
+    firstRow = chunkFirst.FirstRow
+        + (std::lower_bound(chunkFirst.Time, chunkFirst.Time + chunkFirst.NumberOfRows, startTime)
+           - chunkFirst.Time);
+    const size_t endInLast =
+        std::upper_bound(chunkLast.Time, chunkLast.Time + chunkLast.NumberOfRows, endTime)
+        - chunkLast.Time;
+    if (endInLast == 0) {
+        return false;
+    }
+    lastRow = chunkLast.FirstRow + endInLast - 1;
+    return (firstRow <= lastRow);
+}
+
+
+unsigned long long mtsCollectorColumnarReader::GetTicks(size_t row) const
+{
+    const Chunk * chunk;
+    size_t rowInChunk;
+    if (!LocateRow(row, chunk, rowInChunk)) {
+        return 0;
+    }
+    return chunk->Ticks[rowInChunk];
+}
+
+
+double mtsCollectorColumnarReader::GetTime(size_t row) const
+{
+    const Chunk * chunk;
+    size_t rowInChunk;
+    if (!LocateRow(row, chunk, rowInChunk)) {
+        return 0.0;
+    }
+    return chunk->Time[rowInChunk];
+}
+
+
+double mtsCollectorColumnarReader::GetTimestamp(size_t signal, size_t row) const
+{
+    const Chunk * chunk;
+    size_t rowInChunk;
+    if ((signal >= this->Signals.size()) || !LocateRow(row, chunk, rowInChunk)) {
+        return 0.0;
+    }
+    return chunk->Signals[signal].Timestamps[rowInChunk];
+}
+
+
+bool mtsCollectorColumnarReader::GetValid(size_t signal, size_t row) const
+{
+    const Chunk * chunk;
+    size_t rowInChunk;
+    if ((signal >= this->Signals.size()) || !LocateRow(row, chunk, rowInChunk)) {
+        return false;
+    }
+    return (chunk->Signals[signal].Valid[rowInChunk] != 0);
+}
+
+
+const char * mtsCollectorColumnarReader::GetPayload(size_t signal, size_t row, size_t & size) const
+{
+    const Chunk * chunk;
+    size_t rowInChunk;
+    size = 0;
+    if ((signal >= this->Signals.size()) || !LocateRow(row, chunk, rowInChunk)) {
+        return 0;
+    }
+    const SignalColumns & columns = chunk->Signals[signal];
+    if (this->Signals[signal].Encoding == mtsCollectorColumnar::ENCODING_RAW) {
+        size = this->Signals[signal].PayloadSize;
+        return columns.Payloads + rowInChunk * size;
+    }
+    size = static_cast<size_t>(columns.Offsets[rowInChunk + 1] - columns.Offsets[rowInChunk]);
+    return columns.Payloads + columns.Offsets[rowInChunk];
+}
+
+
+bool mtsCollectorColumnarReader::GetObject(size_t signal, size_t row, mtsGenericObject & object) const
+{
+    if ((signal >= this->Signals.size())
+        || (this->Signals[signal].Encoding != mtsCollectorColumnar::ENCODING_SERIALIZED)) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetObject: invalid signal or signal not serialized" << std::endl;
+        return false;
+    }
+    if (object.Services()->GetName() != this->Signals[signal].TypeName) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetObject: type mismatch, expected "
+                          << this->Signals[signal].TypeName << std::endl;
+        return false;
+    }
+    size_t size;
+    const char * payload = this->GetPayload(signal, row, size);
+    if (!payload) {
+        return false;
+    }
+    std::istringstream input(std::string(payload, size));
+    try {
+        object.DeSerializeRaw(input);
+    } catch (std::exception & exception) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetObject: failed to deserialize: "
+                          << exception.what() << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -544,6 +544,9 @@ void mtsCollectorEvent::PrintHeader(const CollectorFileFormat & fileFormat)
         if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY) {
             CMN_LOG_CLASS_INIT_ERROR << "PrintHeader: binary format not supported yet" << std::endl;
         }
+        if (fileFormat == COLLECTOR_FILE_FORMAT_COLUMNAR) {
+            CMN_LOG_CLASS_INIT_ERROR << "PrintHeader: columnar format not supported for events" << std::endl;
+        }
     } else {
         CMN_LOG_CLASS_RUN_ERROR << "PrintHeader: output stream for collector \""
                                 << this->GetName() << "\" is not available." << std::endl;
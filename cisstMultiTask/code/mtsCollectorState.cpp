@@ -27,10 +27,12 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaTimeServer.h>
 #include <cisstMultiTask/mtsTaskManager.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <string.h>
 
 /* Header Definition. The value of END_OF_HEADER_SIZE should match the size of
    END_OF_HEADER array. */
@@ -46,8 +48,16 @@ static char EndOfHeader[END_OF_HEADER_SIZE] = END_OF_HEADER;
 mtsCollectorState::mtsCollectorState(const std::string & collectorName):
     mtsCollectorBase(collectorName,
                      COLLECTOR_FILE_FORMAT_UNDEFINED),
+    NumberOfBatches(2),
+    ProducerIndex(0),
+    WriterIndex(0),
+    Pending(0),
+    PipelineStopping(false),
+    PipelineRunning(false),
+    FillingBatch(0),
     TargetComponent(0),
-    TargetStateTable(0)
+    TargetStateTable(0),
+    ColumnarWriter(0)
 {
     this->Initialize();
 }
@@ -58,8 +68,16 @@ mtsCollectorState::mtsCollectorState(const std::string & targetComponentName,
                                      const mtsCollectorBase::CollectorFileFormat fileFormat):
     mtsCollectorBase(std::string("StateCollectorFor") + targetComponentName + targetStateTableName,
                      fileFormat),
+    NumberOfBatches(2),
+    ProducerIndex(0),
+    WriterIndex(0),
+    Pending(0),
+    PipelineStopping(false),
+    PipelineRunning(false),
+    FillingBatch(0),
     TargetComponent(0),
-    TargetStateTable(0)
+    TargetStateTable(0),
+    ColumnarWriter(0)
 {
     this->SetStateTable(targetComponentName, targetStateTableName);
     this->SetOutputToDefault(fileFormat);
@@ -69,6 +87,12 @@ mtsCollectorState::mtsCollectorState(const std::string & targetComponentName,
 
 mtsCollectorState::~mtsCollectorState()
 {
+    // write pending batches before closing files
+    this->StopPipeline();
+    // columnar writer flushes pending chunks when deleted
+    if (this->ColumnarWriter) {
+        delete this->ColumnarWriter;
+    }
     // serializer was created for a binary output
     if (this->Serializer) {
         delete this->Serializer;
@@ -189,6 +213,19 @@ void mtsCollectorState::Initialize(void)
                                  << this->GetName() << "\"" << std::endl;
         cmnThrow(std::runtime_error("mtsCollectorState::Connect: unable to add required interface"));
     }
+
+    // pipeline statistics
+    if (this->ControlInterface) {
+        this->ControlInterface->AddCommandRead(&mtsCollectorState::GetRowsDropped, this,
+                                               "GetRowsDropped");
+        this->ControlInterface->AddCommandRead(&mtsCollectorState::GetMaxQueueDepth, this,
+                                               "GetMaxQueueDepth");
+        this->ControlInterface->AddCommandRead(&mtsCollectorState::GetWriteLatencyHistogram, this,
+                                               "GetWriteLatencyHistogram",
+                                               mtsUIntVec(WRITE_LATENCY_HISTOGRAM_SIZE));
+        this->ControlInterface->AddCommandVoid(&mtsCollectorState::ResetPipelineStatistics, this,
+                                               "ResetPipelineStatistics");
+    }
 }
 
 
@@ -355,16 +392,32 @@ void mtsCollectorState::BatchCollect(const mtsStateTable::IndexRange & range)
 
     // If this method is called for the first time, print out some information.
     if (FirstRunningFlag) {
+        // batches are allocated for the current signals and storage modes
+        this->StopPipeline();
         this->OpenFileIfNeeded();
         PrintHeader(this->FileFormat);
     }
+    if (!this->PipelineRunning) {
+        this->StartPipeline();
+    }
 
     const size_t startIndex = range.First.Ticks() % TableHistoryLength;
     const size_t endIndex = range.Last.Ticks() % TableHistoryLength;
+    const mtsStateIndex::TimeTicksType lastTicks = range.Last.Ticks();
+
+    // get a free batch, rows are dropped if the writer thread is behind
+    this->PipelineMutex.Lock();
+    if (this->Pending < this->Batches.size()) {
+        this->FillingBatch = &(this->Batches[this->ProducerIndex]);
+        this->FillingBatch->NumberOfRows = 0;
+    } else {
+        this->FillingBatch = 0;
+    }
+    this->PipelineMutex.Unlock();
 
     if (startIndex < endIndex) {
         // normal case
-        if (FetchStateTableData(TargetStateTable, startIndex, endIndex)) {
+        if (FetchStateTableData(TargetStateTable, startIndex, endIndex, lastTicks)) {
             LastReadIndex = (endIndex + (OffsetForNextRead - 1)) % TableHistoryLength;
         }
     } else if (startIndex == endIndex) {
@@ -372,13 +425,168 @@ void mtsCollectorState::BatchCollect(const mtsStateTable::IndexRange & range)
     } else {
         // Wrap-around case
         // first part: from the last read index to the end of the array
-        if (FetchStateTableData(TargetStateTable, startIndex, TableHistoryLength - 1)) {
+        if (FetchStateTableData(TargetStateTable, startIndex, TableHistoryLength - 1, lastTicks)) {
             // second part: from the beginning of the array to the end of range
-            if (FetchStateTableData(TargetStateTable, 0, endIndex)) {
+            if (FetchStateTableData(TargetStateTable, 0, endIndex, lastTicks)) {
                 LastReadIndex = (endIndex + (OffsetForNextRead - 1)) % TableHistoryLength;
             }
         }
     }
+
+    if (!this->FillingBatch) {
+        CMN_LOG_CLASS_RUN_WARNING << "BatchCollect: writer thread can't keep up, rows dropped for collector \""
+                                  << this->GetName() << "\"" << std::endl;
+        return;
+    }
+    if (this->FillingBatch->NumberOfRows != 0) {
+        // hand over the batch to the writer thread
+        this->PipelineMutex.Lock();
+        this->ProducerIndex = (this->ProducerIndex + 1) % this->Batches.size();
+        this->Pending++;
+        const size_t depth = this->Pending;
+        this->PipelineMutex.Unlock();
+        if (depth > this->MaxQueueDepth.LoadRelaxed()) {
+            this->MaxQueueDepth.Store(depth);
+        }
+        this->PipelineDataSignal.Raise();
+    }
+    this->FillingBatch = 0;
+}
+
+
+void mtsCollectorState::StartPipeline(void)
+{
+    const size_t numberOfSignals = RegisteredSignalElements.size();
+    const mtsStateArrayBase * tic = TargetStateTable->StateVector[TargetStateTable->TicId];
+    this->Batches.resize(this->NumberOfBatches);
+    for (size_t index = 0; index < this->Batches.size(); ++index) {
+        Batch & batch = this->Batches[index];
+        batch.Ticks.resize(TableHistoryLength);
+        batch.Tic = tic->Clone(TableHistoryLength);
+        batch.Signals.resize(numberOfSignals);
+        for (size_t j = 0; j < numberOfSignals; ++j) {
+            batch.Signals[j] = TargetStateTable->StateVector[RegisteredSignalElements[j].ID]->Clone(TableHistoryLength);
+        }
+        batch.NumberOfRows = 0;
+    }
+    this->ProducerIndex = 0;
+    this->WriterIndex = 0;
+    this->Pending = 0;
+    this->PipelineStopping = false;
+    this->PipelineThread.Create(this, &mtsCollectorState::PipelineRun, 0, "StateWriter");
+    this->PipelineRunning = true;
+}
+
+
+void mtsCollectorState::StopPipeline(void)
+{
+    if (!this->PipelineRunning) {
+        return;
+    }
+    this->PipelineMutex.Lock();
+    this->PipelineStopping = true;
+    this->PipelineMutex.Unlock();
+    this->PipelineDataSignal.Raise();
+    this->PipelineThread.Wait();
+    this->PipelineRunning = false;
+    for (size_t index = 0; index < this->Batches.size(); ++index) {
+        Batch & batch = this->Batches[index];
+        delete batch.Tic;
+        for (size_t j = 0; j < batch.Signals.size(); ++j) {
+            delete batch.Signals[j];
+        }
+    }
+    this->Batches.clear();
+}
+
+
+void mtsCollectorState::FlushPendingOutput(void)
+{
+    if (!this->PipelineRunning) {
+        return;
+    }
+    this->PipelineMutex.Lock();
+    while (this->Pending != 0) {
+        this->PipelineMutex.Unlock();
+        // the signal can be raised before we wait, use a timeout
+        this->PipelineSpaceSignal.Wait(0.01 * cmn_s);
+        this->PipelineMutex.Lock();
+    }
+    this->PipelineMutex.Unlock();
+}
+
+
+void * mtsCollectorState::PipelineRun(int CMN_UNUSED(data))
+{
+    Batch * batch;
+    double startTime, latency, bound;
+    size_t bin;
+    while (true) {
+        this->PipelineMutex.Lock();
+        // the signal can be raised before we wait, use a timeout
+        while ((this->Pending == 0) && !this->PipelineStopping) {
+            this->PipelineMutex.Unlock();
+            this->PipelineDataSignal.Wait(0.01 * cmn_s);
+            this->PipelineMutex.Lock();
+        }
+        if (this->Pending == 0) {
+            // stopping and all batches have been written
+            this->PipelineMutex.Unlock();
+            break;
+        }
+        batch = &(this->Batches[this->WriterIndex]);
+        this->PipelineMutex.Unlock();
+
+        startTime = osaGetTime();
+        this->WriteBatch(*batch);
+        latency = osaGetTime() - startTime;
+        // bins are powers of two starting at 0.1 ms
+        bin = 0;
+        bound = 0.1 * cmn_ms;
+        while ((latency >= bound) && (bin < WRITE_LATENCY_HISTOGRAM_SIZE - 1)) {
+            bound *= 2.0;
+            bin++;
+        }
+        this->WriteLatencyHistogram[bin].FetchAdd(1);
+
+        this->PipelineMutex.Lock();
+        this->WriterIndex = (this->WriterIndex + 1) % this->Batches.size();
+        this->Pending--;
+        this->PipelineMutex.Unlock();
+        this->PipelineSpaceSignal.Raise();
+    }
+    return 0;
+}
+
+
+void mtsCollectorState::GetRowsDropped(mtsUInt & placeHolder) const
+{
+    placeHolder = static_cast<unsigned int>(this->RowsDropped.Load());
+}
+
+
+void mtsCollectorState::GetMaxQueueDepth(mtsUInt & placeHolder) const
+{
+    placeHolder = static_cast<unsigned int>(this->MaxQueueDepth.Load());
+}
+
+
+void mtsCollectorState::GetWriteLatencyHistogram(mtsUIntVec & placeHolder) const
+{
+    placeHolder.SetSize(WRITE_LATENCY_HISTOGRAM_SIZE);
+    for (size_t bin = 0; bin < WRITE_LATENCY_HISTOGRAM_SIZE; ++bin) {
+        placeHolder[bin] = static_cast<unsigned int>(this->WriteLatencyHistogram[bin].Load());
+    }
+}
+
+
+void mtsCollectorState::ResetPipelineStatistics(void)
+{
+    this->RowsDropped.Store(0);
+    this->MaxQueueDepth.Store(0);
+    for (size_t bin = 0; bin < WRITE_LATENCY_HISTOGRAM_SIZE; ++bin) {
+        this->WriteLatencyHistogram[bin].Store(0);
+    }
 }
 
 
@@ -434,6 +642,8 @@ void mtsCollectorState::PrintHeader(const CollectorFileFormat & fileFormat)
             *(this->OutputHeaderStream) << "Text" << std::endl ;
         } else if (fileFormat == COLLECTOR_FILE_FORMAT_CSV) {
             *(this->OutputHeaderStream) << "CSV" << std::endl ;
+        } else if (fileFormat == COLLECTOR_FILE_FORMAT_COLUMNAR) {
+            *(this->OutputHeaderStream) << "Columnar" << std::endl ;
         } else {
             *(this->OutputHeaderStream) << "Binary" << std::endl;
         }
@@ -511,10 +721,66 @@ void mtsCollectorState::PrintHeader(const CollectorFileFormat & fileFormat)
     } else {
         CMN_LOG_CLASS_RUN_ERROR << "PrintHeader: output stream for collector \"" << this->GetName() << "\" is not available." << std::endl;
     }
+    if (fileFormat == COLLECTOR_FILE_FORMAT_COLUMNAR) {
+        this->OpenColumnarWriter(origin.ToSeconds());
+    }
     FirstRunningFlag = false;
 }
 
 
+bool mtsCollectorState::OpenColumnarWriter(double timeOrigin)
+{
+    if (this->OutputFile == 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "OpenColumnarWriter: columnar format can't be used with a user provided stream for collector \""
+                                 << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    if (!this->ColumnarWriter) {
+        this->ColumnarWriter = new mtsCollectorColumnarWriter;
+    }
+    this->ColumnarWriter->Close();
+
+    // describe signals, raw if the state table stores the element in columns
+    const size_t numberOfSignals = RegisteredSignalElements.size();
+    this->ColumnarSignals.resize(numberOfSignals);
+    for (size_t index = 0; index < numberOfSignals; ++index) {
+        const mtsStateArrayBase * array = TargetStateTable->StateVector[RegisteredSignalElements[index].ID];
+        mtsCollectorColumnar::SignalDescription & signal = this->ColumnarSignals[index];
+        signal.Name = RegisteredSignalElements[index].Name;
+        signal.TypeName = array->ElementServices()->GetName();
+        if (array->IsColumnar()) {
+            signal.Encoding = mtsCollectorColumnar::ENCODING_RAW;
+            signal.PayloadSize = array->GetColumnPayloadSize();
+        } else {
+            signal.Encoding = mtsCollectorColumnar::ENCODING_SERIALIZED;
+            signal.PayloadSize = 0;
+        }
+    }
+    this->ColumnarSerialized.resize(numberOfSignals);
+    this->ColumnarOffsets.resize(numberOfSignals);
+
+    if (!this->ColumnarWriter->Open(this->OutputFileName,
+                                    TargetComponent->GetName() + "/" + TargetStateTable->GetName(),
+                                    this->ColumnarSignals, timeOrigin)) {
+        CMN_LOG_CLASS_INIT_ERROR << "OpenColumnarWriter: failed to create file \"" << this->OutputFileName
+                                 << "\" for collector \"" << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+void mtsCollectorState::CloseOutput(void)
+{
+    // batches might still be waiting for the columnar writer
+    this->FlushPendingOutput();
+    if (this->ColumnarWriter) {
+        this->ColumnarWriter->Close();
+    }
+    mtsCollectorBase::CloseOutput();
+}
+
+
 void mtsCollectorState::MarkHeaderEnd(std::ostream & output)
 {
     for (int i = 0; i < END_OF_HEADER_SIZE; ++i) {
@@ -537,45 +803,195 @@ bool mtsCollectorState::IsHeaderEndMark(const char * buffer)
 
 bool mtsCollectorState::FetchStateTableData(const mtsStateTable * table,
                                             const size_t startIndex,
-                                            const size_t endIndex)
+                                            const size_t endIndex,
+                                            const mtsStateIndex::TimeTicksType lastTicks)
 {
+    size_t i, j;
+    Batch * batch = this->FillingBatch;
+    if (!batch) {
+        // no batch available, all rows are dropped
+        const size_t numberOfRows = (endIndex - startIndex) / SamplingInterval + 1;
+        this->RowsDropped.FetchAdd(numberOfRows);
+        i = startIndex + numberOfRows * SamplingInterval;
+        OffsetForNextRead = (i - endIndex == 0 ? SamplingInterval : i - endIndex);
+        return true;
+    }
+    const size_t numberOfSignals = RegisteredSignalElements.size();
+    const mtsStateArrayBase * tic = table->StateVector[table->TicId];
+    size_t sequence, row;
+    for (i = startIndex; i <= endIndex; i += SamplingInterval) {
+        // skip rows being written or already overwritten by the state table
+        sequence = table->RowSequence[i].Load();
+        if ((sequence & 1) || (table->Ticks[i] > lastTicks)) {
+            this->RowsDropped.FetchAdd(1);
+            continue;
+        }
+        row = batch->NumberOfRows;
+        batch->Ticks[row] = table->Ticks[i];
+        batch->Tic->CopyFrom(row, *tic, i);
+        for (j = 0; j < numberOfSignals; ++j) {
+            batch->Signals[j]->CopyFrom(row, *(table->StateVector[RegisteredSignalElements[j].ID]), i);
+        }
+        // the copies must be complete before the sequence number is checked again
+        osaAtomicThreadFence();
+        if (table->RowSequence[i].LoadRelaxed() != sequence) {
+            this->RowsDropped.FetchAdd(1);
+            continue;
+        }
+        batch->NumberOfRows++;
+    }
+    OffsetForNextRead = (i - endIndex == 0 ? SamplingInterval : i - endIndex);
+    return true;
+}
+
+
+void mtsCollectorState::WriteBatch(const Batch & batch)
+{
+    if (FileFormat == COLLECTOR_FILE_FORMAT_COLUMNAR) {
+        WriteBatchColumnar(batch);
+        return;
+    }
     if (this->OutputStream) {
         if (this->OutputStream->good()) {
+            size_t row, j;
             if (FileFormat == COLLECTOR_FILE_FORMAT_BINARY) {
                 cmnULongLong timeTick;
-                size_t i, j;
-                for (i = startIndex; i <= endIndex; i += SamplingInterval) {
+                for (row = 0; row < batch.NumberOfRows; ++row) {
                     StringStreamBufferForSerialization.str("");
-                    timeTick.Data = TargetStateTable->Ticks[i];
+                    timeTick.Data = batch.Ticks[row];
                     Serializer->Serialize(timeTick);
                     *(this->OutputStream) << StringStreamBufferForSerialization.str();
 
-                    for (j = 0; j < RegisteredSignalElements.size(); ++j) {
+                    for (j = 0; j < batch.Signals.size(); ++j) {
                         StringStreamBufferForSerialization.str("");
-                        Serializer->Serialize((*table->StateVector[RegisteredSignalElements[j].ID])[i]);
+                        Serializer->Serialize((*batch.Signals[j])[row]);
                         *(this->OutputStream) << StringStreamBufferForSerialization.str();
                     }
                 }
-                OffsetForNextRead = (i - endIndex == 0 ? SamplingInterval : i - endIndex);
             } else {
-                size_t i, j;
-                for (i = startIndex; i <= endIndex; i += SamplingInterval) {
-                    *(this->OutputStream) << TargetStateTable->Ticks[i];
-                    for (j = 0; j < RegisteredSignalElements.size(); ++j) {
+                for (row = 0; row < batch.NumberOfRows; ++row) {
+                    *(this->OutputStream) << batch.Ticks[row];
+                    for (j = 0; j < batch.Signals.size(); ++j) {
                         *(this->OutputStream) << this->Delimiter;
-                        (*table->StateVector[RegisteredSignalElements[j].ID])[i].ToStreamRaw(*(this->OutputStream), this->Delimiter);
+                        (*batch.Signals[j])[row].ToStreamRaw(*(this->OutputStream), this->Delimiter);
                     }
                     *(this->OutputStream) << std::endl;
                 }
-                OffsetForNextRead = (i - endIndex == 0 ? SamplingInterval : i - endIndex);
             }
         } else {
-            CMN_LOG_CLASS_RUN_ERROR << "FetchStateTableData: encountered problem on output stream for collector \""
+            CMN_LOG_CLASS_RUN_ERROR << "WriteBatch: encountered problem on output stream for collector \""
                                     << this->GetName() << "\"" << std::endl;
         }
     } else {
-        CMN_LOG_CLASS_RUN_ERROR << "FetchStateTableData: output stream for collector \"" << this->GetName() << "\" is not available." << std::endl;
+        CMN_LOG_CLASS_RUN_ERROR << "WriteBatch: output stream for collector \"" << this->GetName() << "\" is not available." << std::endl;
+    }
+}
+
+
+bool mtsCollectorState::WriteBatchColumnar(const Batch & batch)
+{
+    if (!(this->ColumnarWriter && this->ColumnarWriter->IsOpen())) {
+        CMN_LOG_CLASS_RUN_ERROR << "WriteBatchColumnar: columnar output for collector \""
+                                << this->GetName() << "\" is not available." << std::endl;
+        return false;
+    }
+    const size_t numberOfRows = batch.NumberOfRows;
+    const size_t numberOfSignals = batch.Signals.size();
+    const size_t alignment = mtsCollectorColumnar::ALIGNMENT;
+    size_t row, j;
+
+    // serialize signals not stored in columns first to compute the chunk size
+    size_t chunkSize = sizeof(mtsCollectorColumnar::ChunkHeader)
+        + mtsCollectorColumnar::Align(numberOfRows * sizeof(unsigned long long), alignment)
+        + mtsCollectorColumnar::Align(numberOfRows * sizeof(double), alignment);
+    for (j = 0; j < numberOfSignals; ++j) {
+        const mtsStateArrayBase * array = batch.Signals[j];
+        const mtsCollectorColumnar::SignalDescription & signal = ColumnarSignals[j];
+        size_t serializedSize = 0;
+        // elements stored in columns can't be accessed by reference
+        const bool storageChanged = (signal.Encoding == mtsCollectorColumnar::ENCODING_RAW)
+            ? (!array->IsColumnar() || (array->GetColumnPayloadSize() != signal.PayloadSize))
+            : array->IsColumnar();
+        if (storageChanged) {
+            CMN_LOG_CLASS_RUN_ERROR << "WriteBatchColumnar: storage of signal \"" << signal.Name
+                                    << "\" changed since collection started for collector \""
+                                    << this->GetName() << "\"" << std::endl;
+            return false;
+        }
+        if (signal.Encoding == mtsCollectorColumnar::ENCODING_SERIALIZED) {
+            std::vector<unsigned long long> & offsets = ColumnarOffsets[j];
+            offsets.resize(numberOfRows + 1);
+            offsets[0] = 0;
+            ColumnarSerializationStream.str("");
+            for (row = 0; row < numberOfRows; ++row) {
+                (*array)[row].SerializeRaw(ColumnarSerializationStream);
+                offsets[row + 1] = static_cast<unsigned long long>(ColumnarSerializationStream.tellp());
+            }
+            ColumnarSerialized[j] = ColumnarSerializationStream.str();
+            serializedSize = ColumnarSerialized[j].size();
+        }
+        chunkSize += mtsCollectorColumnar::SignalColumnsSize(signal, numberOfRows, serializedSize);
+    }
+    chunkSize = mtsCollectorColumnar::Align(chunkSize, mtsCollectorColumnar::CHUNK_ALIGNMENT);
+
+    char * buffer = this->ColumnarWriter->Reserve(chunkSize);
+    if (!buffer) {
+        CMN_LOG_CLASS_RUN_ERROR << "WriteBatchColumnar: can't allocate chunk for collector \""
+                                << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    // padding is zeroed so files are reproducible
+    memset(buffer, 0, chunkSize);
+    mtsCollectorColumnar::ChunkHeader * header = reinterpret_cast<mtsCollectorColumnar::ChunkHeader *>(buffer);
+    memcpy(header->Magic, mtsCollectorColumnar::ChunkMagic, sizeof(header->Magic));
+    header->NumberOfRows = static_cast<unsigned int>(numberOfRows);
+    header->ChunkSize = chunkSize;
+    size_t position = sizeof(mtsCollectorColumnar::ChunkHeader);
+
+    // ticks and time (Tic) of each row
+    unsigned long long * ticks = reinterpret_cast<unsigned long long *>(buffer + position);
+    position += mtsCollectorColumnar::Align(numberOfRows * sizeof(unsigned long long), alignment);
+    double * time = reinterpret_cast<double *>(buffer + position);
+    position += mtsCollectorColumnar::Align(numberOfRows * sizeof(double), alignment);
+    mtsDouble tic;
+    for (row = 0; row < numberOfRows; ++row) {
+        ticks[row] = batch.Ticks[row];
+        batch.Tic->Get(row, tic);
+        time[row] = tic.Data;
+    }
+    header->FirstTime = time[0];
+    header->LastTime = time[numberOfRows - 1];
+
+    // columns for each signal, rows are contiguous in the batch
+    for (j = 0; j < numberOfSignals; ++j) {
+        const mtsStateArrayBase * array = batch.Signals[j];
+        const mtsCollectorColumnar::SignalDescription & signal = ColumnarSignals[j];
+        double * timestamps = reinterpret_cast<double *>(buffer + position);
+        position += mtsCollectorColumnar::Align(numberOfRows * sizeof(double), alignment);
+        char * valid = buffer + position;
+        position += mtsCollectorColumnar::Align(numberOfRows, alignment);
+        if (signal.Encoding == mtsCollectorColumnar::ENCODING_RAW) {
+            memcpy(timestamps, array->GetColumnTimestamps(), numberOfRows * sizeof(double));
+            memcpy(valid, array->GetColumnValid(), numberOfRows);
+            if (signal.PayloadSize != 0) {
+                memcpy(buffer + position, array->GetColumnValues(), numberOfRows * signal.PayloadSize);
+            }
+            position += mtsCollectorColumnar::Align(numberOfRows * signal.PayloadSize, alignment);
+        } else {
+            for (row = 0; row < numberOfRows; ++row) {
+                const mtsGenericObject & element = (*array)[row];
+                timestamps[row] = element.Timestamp();
+                valid[row] = element.Valid();
+            }
+            memcpy(buffer + position, &(ColumnarOffsets[j][0]), (numberOfRows + 1) * sizeof(unsigned long long));
+            position += mtsCollectorColumnar::Align((numberOfRows + 1) * sizeof(unsigned long long), alignment);
+            if (!ColumnarSerialized[j].empty()) {
+                memcpy(buffer + position, ColumnarSerialized[j].data(), ColumnarSerialized[j].size());
+            }
+            position += mtsCollectorColumnar::Align(ColumnarSerialized[j].size(), alignment);
+        }
     }
+    this->ColumnarWriter->Commit(chunkSize);
     return true;
 }
 
@@ -24,7 +24,9 @@ http://www.cisst.org/cisst/license.txt.
 mtsCommandQueuedVoid::mtsCommandQueuedVoid(void):
     BaseType(),
     MailBox(0)
-{}
+{
+    this->QueuedKind = MTS_COMMAND_KIND_QUEUED_VOID;
+}
 
 
 mtsCommandQueuedVoid::mtsCommandQueuedVoid(mtsCallableVoidBase * callable,
@@ -36,6 +38,7 @@ mtsCommandQueuedVoid::mtsCommandQueuedVoid(mtsCallableVoidBase * callable,
     BlockingFlagQueue(size, MTS_NOT_BLOCKING),
     FinishedEventQueue()
 {
+    this->QueuedKind = MTS_COMMAND_KIND_QUEUED_VOID;
     mtsCommandWriteBase *cmd = 0;
     FinishedEventQueue.SetSize(size, cmd);
 }
@@ -33,6 +33,8 @@ mtsCommandQueuedVoidReturnBase<_Base>::mtsCommandQueuedVoidReturnBase(CallableTy
     ReturnsQueue(),
     FinishedEventQueue()
 {
+    // queued read commands are handled like void return commands
+    this->QueuedKind = this->Returns() ? MTS_COMMAND_KIND_QUEUED_VOID_RETURN : MTS_COMMAND_KIND_QUEUED_READ;
     mtsGenericObject *obj = 0;
     ReturnsQueue.SetSize(size, obj);
     mtsCommandWriteBase *cmd = 0;
@@ -38,6 +38,61 @@ mtsExecutionResult mtsCommandQueuedWriteBase::Execute(const mtsGenericObject & a
     return Execute(argument, blocking, 0);
 }
 
+mtsExecutionResult mtsCommandQueuedWriteBase::ExecuteReserved(mtsBlockingType blocking,
+                                                              mtsCommandWriteBase * finishedEventHandler)
+{
+    // check if this command is enabled, the reserved slot can be reused later
+    if (!this->IsEnabled()) {
+        return mtsExecutionResult::COMMAND_DISABLED;
+    }
+    // check if there is a mailbox (i.e. if the command is associated to an interface)
+    if (!MailBox) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteReserved: no mailbox for \""
+                          << this->Name << "\"" << std::endl;
+        return mtsExecutionResult::COMMAND_HAS_NO_MAILBOX;
+    }
+    // check if all queues have some space, arguments queue is checked by ArgumentCommit
+    if (BlockingFlagQueue.IsFull() || FinishedEventQueue.IsFull() || MailBox->IsFull()) {
+        CMN_LOG_RUN_WARNING << "Class mtsCommandQueuedWriteBase: ExecuteReserved: Queue full for \""
+                            << this->Name << "\" ["
+                            << BlockingFlagQueue.IsFull() << "|"
+                            << FinishedEventQueue.IsFull() << "|"
+                            << MailBox->IsFull() << "]"
+                            << std::endl;
+        return mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL;
+    }
+    // publish the argument filled in place by the caller, fails if
+    // there is no reserved slot (queue full or not reserved)
+    if (!this->ArgumentCommit()) {
+        CMN_LOG_RUN_WARNING << "Class mtsCommandQueuedWriteBase: ExecuteReserved: no argument reserved for \""
+                            << this->Name << "\"" << std::endl;
+        return mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL;
+    }
+    // copy the blocking flag to the local storage.
+    if (!BlockingFlagQueue.Put(blocking)) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteReserved: BlockingFlagQueue.Put failed for \""
+                          << this->Name << "\"" << std::endl;
+        cmnThrow("mtsCommandQueuedWriteBase: ExecuteReserved: BlockingFlagQueue.Put failed");
+        return mtsExecutionResult::UNDEFINED;
+    }
+    // copy the finished event handler to the local storage.
+    if (!FinishedEventQueue.Put(finishedEventHandler)) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteReserved: FinishedEventQueue.Put failed for \""
+                          << this->Name << "\"" << std::endl;
+        cmnThrow("mtsCommandQueuedWriteBase: ExecuteReserved: FinishedEventQueue.Put failed");
+        return mtsExecutionResult::UNDEFINED;
+    }
+    // finally try to queue to mailbox
+    if (!MailBox->Write(this)) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteReserved: MailBox.Write failed for \""
+                          << this->Name << "\"" << std::endl;
+        cmnThrow("mtsCommandQueuedWriteBase: ExecuteReserved: MailBox.Write failed");
+        return mtsExecutionResult::UNDEFINED;
+    }
+    return mtsExecutionResult::COMMAND_QUEUED;
+}
+
+
 mtsBlockingType mtsCommandQueuedWriteBase::BlockingFlagGet(void)
 {
     return *(this->BlockingFlagQueue.Get());
@@ -35,6 +35,8 @@ mtsCommandQueuedWriteReturnBase<_Base>::mtsCommandQueuedWriteReturnBase(Callable
     ReturnsQueue(),
     FinishedEventQueue()
 {
+    // queued qualified read commands are handled like write return commands
+    this->QueuedKind = this->Returns() ? MTS_COMMAND_KIND_QUEUED_WRITE_RETURN : MTS_COMMAND_KIND_QUEUED_QUALIFIED_READ;
     ArgumentsQueue.SetSize(size, *argumentPrototype);
     mtsGenericObject *obj = 0;
     ReturnsQueue.SetSize(size, obj);
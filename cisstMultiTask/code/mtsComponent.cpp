@@ -704,6 +704,22 @@ size_t mtsComponent::ProcessMailBoxes(InterfacesProvidedMapType & interfaces)
 }
 
 
+size_t mtsComponent::ProcessQueuedCommands(double deadline, size_t & deferred)
+{
+    const osaTimeServer & timeServer = mtsManagerLocal::GetInstance()->GetTimeServer();
+    deferred = 0;
+    size_t numberOfCommands = 0;
+    InterfacesProvidedMapType::iterator iterator = InterfacesProvided.begin();
+    const InterfacesProvidedMapType::iterator end = InterfacesProvided.end();
+    for (;
+         iterator != end;
+         ++iterator) {
+        numberOfCommands += iterator->second->ProcessMailBoxes(timeServer, deadline, deferred);
+    }
+    return numberOfCommands;
+}
+
+
 size_t mtsComponent::ProcessQueuedEvents(void) {
     InterfacesRequiredMapType::iterator iterator = InterfacesRequired.begin();
     const InterfacesRequiredMapType::iterator end = InterfacesRequired.end();
@@ -19,6 +19,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstMultiTask/mtsFunctionWrite.h>
 #include <cisstMultiTask/mtsCommandWriteBase.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteBase.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
 
 
@@ -62,6 +63,29 @@ mtsExecutionResult mtsFunctionWrite::ExecuteGeneric(const mtsGenericObject & arg
 }
 
 
+mtsGenericObject * mtsFunctionWrite::ArgumentReserve(void) const
+{
+    if (Command && (Command->GetQueuedKind() == MTS_COMMAND_KIND_QUEUED_WRITE)) {
+        return static_cast<mtsCommandQueuedWriteBase *>(Command)->ArgumentReserve();
+    }
+    return 0;
+}
+
+
+mtsExecutionResult mtsFunctionWrite::ExecuteReserved(void) const
+{
+    if (!Command) {
+        return mtsExecutionResult::FUNCTION_NOT_BOUND;
+    }
+    if (Command->GetQueuedKind() != MTS_COMMAND_KIND_QUEUED_WRITE) {
+        CMN_LOG_RUN_ERROR << "mtsFunctionWrite::ExecuteReserved: command \"" << Command->GetName()
+                          << "\" is not a queued write command" << std::endl;
+        return mtsExecutionResult::UNDEFINED;
+    }
+    return static_cast<mtsCommandQueuedWriteBase *>(Command)->ExecuteReserved(MTS_NOT_BLOCKING);
+}
+
+
 mtsExecutionResult mtsFunctionWrite::ExecuteBlockingGeneric(const mtsGenericObject & argument) const
 {
     if (!Command)
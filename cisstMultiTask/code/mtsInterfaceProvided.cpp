@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -41,6 +41,8 @@ mtsInterfaceProvided::mtsInterfaceProvided(const std::string & name, mtsComponen
     MailBox(0),
     QueueingPolicy(queueingPolicy),
     ArgumentQueuesSize(DEFAULT_MAIL_BOX_AND_ARGUMENT_QUEUES_SIZE),
+    MailBoxProducerPolicy(MTS_MAILBOX_SINGLE_PRODUCER),
+    SharedMailBox(0),
     BlockingCommandExecuted(0),
     BlockingCommandReturnExecuted(0),
     OriginalInterface(0),
@@ -120,6 +122,8 @@ mtsInterfaceProvided::mtsInterfaceProvided(mtsInterfaceProvided * originalInterf
     QueueingPolicy(MTS_COMMANDS_SHOULD_BE_QUEUED),
     MailBoxSize(mailBoxSize),
     ArgumentQueuesSize(argumentQueuesSize),
+    MailBoxProducerPolicy(originalInterface->MailBoxProducerPolicy),
+    SharedMailBox(0),
     BlockingCommandExecuted(0),
     BlockingCommandReturnExecuted(0),
     OriginalInterface(originalInterface),
@@ -150,9 +154,20 @@ mtsInterfaceProvided::mtsInterfaceProvided(mtsInterfaceProvided * originalInterf
 
     if (mailBoxSize != 0) {
         // duplicate what needs to be duplicated (i.e. void and write commands)
-        MailBox = new mtsMailBox(this->GetName(),
-                                 mailBoxSize,
-                                 this->PostCommandQueuedCallable);
+        if (this->MailBoxProducerPolicy == MTS_MAILBOX_MULTIPLE_PRODUCERS) {
+            // all end user interfaces share the mailbox owned by the original interface
+            if (!originalInterface->SharedMailBox) {
+                originalInterface->SharedMailBox = new mtsMailBox(originalInterface->GetName(),
+                                                                  mailBoxSize,
+                                                                  this->PostCommandQueuedCallable,
+                                                                  MTS_MAILBOX_MULTIPLE_PRODUCERS);
+            }
+            MailBox = originalInterface->SharedMailBox;
+        } else {
+            MailBox = new mtsMailBox(this->GetName(),
+                                     mailBoxSize,
+                                     this->PostCommandQueuedCallable);
+        }
 
         // clone void commands
         CloneCommands<CommandVoidMapType, mtsCommandQueuedVoid>("void", originalInterface->CommandsVoid, CommandsVoid);
@@ -234,6 +249,22 @@ void mtsInterfaceProvided::SetMailBoxAndArgumentQueuesSize(size_t desiredSize)
 }
 
 
+void mtsInterfaceProvided::SetMailBoxProducerPolicy(mtsMailBoxProducerPolicy policy)
+{
+    if (this->QueueingPolicy == MTS_COMMANDS_SHOULD_NOT_BE_QUEUED) {
+        CMN_LOG_CLASS_INIT_WARNING << "SetMailBoxProducerPolicy: interface \"" << this->GetFullName()
+                                   << "\" is not queuing commands, calling SetMailBoxProducerPolicy has no effect"
+                                   << std::endl;
+    }
+    if (this->UserCounter != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetMailBoxProducerPolicy: interface \"" << this->GetFullName()
+                                 << "\" is already used, the producer policy can't be changed" << std::endl;
+        return;
+    }
+    this->MailBoxProducerPolicy = policy;
+}
+
+
 
 // Execute all commands in the mailbox.  This is just a temporary implementation, where
 // all commands in a mailbox are executed before moving on the next mailbox.  The final
@@ -243,6 +274,13 @@ size_t mtsInterfaceProvided::ProcessMailBoxes(void)
 {
     if (!this->EndUserInterface) {
         size_t numberOfCommands = 0;
+        // single mailbox shared by all users
+        if (this->SharedMailBox) {
+            while (this->SharedMailBox->ExecuteNext()) {
+                numberOfCommands++;
+            }
+            return numberOfCommands;
+        }
         InterfaceProvidedCreatedListType::iterator iterator = InterfacesProvidedCreated.begin();
         //const InterfaceProvidedCreatedVectorType::iterator end = InterfacesProvidedCreated.end();
         mtsMailBox * mailBox;
@@ -264,6 +302,39 @@ size_t mtsInterfaceProvided::ProcessMailBoxes(void)
 }
 
 
+size_t mtsInterfaceProvided::ProcessMailBoxes(const osaTimeServer & timeServer, double deadline, size_t & deferred)
+{
+    if (!this->EndUserInterface) {
+        size_t numberOfCommands = 0;
+        size_t mailBoxDeferred;
+        // single mailbox shared by all users
+        if (this->SharedMailBox) {
+            numberOfCommands = this->SharedMailBox->ExecuteBatch(this->MailBoxSize, &timeServer,
+                                                                 deadline, mailBoxDeferred);
+            deferred += mailBoxDeferred;
+            return numberOfCommands;
+        }
+        InterfaceProvidedCreatedListType::iterator iterator = InterfacesProvidedCreated.begin();
+        const InterfaceProvidedCreatedListType::iterator end = InterfacesProvidedCreated.end();
+        mtsMailBox * mailBox;
+        for (;
+             iterator != end;
+             ++iterator) {
+            mailBox = iterator->second->GetMailBox();
+            if (mailBox) {
+                // once the deadline is reached, each mailbox still executes one command
+                numberOfCommands += mailBox->ExecuteBatch(iterator->second->MailBoxSize, &timeServer,
+                                                          deadline, mailBoxDeferred);
+                deferred += mailBoxDeferred;
+            }
+        }
+        return numberOfCommands;
+    }
+    CMN_LOG_CLASS_RUN_ERROR << "ProcessMailBoxes: called on end user interface for " << this->GetFullName() << std::endl;
+    return 0;
+}
+
+
 void mtsInterfaceProvided::ToStream(std::ostream & outputStream) const
 {
     outputStream << "Provided Interface \"" << this->GetFullName() << "\"" << std::endl;
@@ -897,7 +968,7 @@ bool mtsInterfaceProvided::AddSystemEvents(void)
                                  << this->GetFullName() << "\"" << std::endl;
         return false;
     }
-    if (this->MailBox) {
+    if (this->MailBox && (this->MailBoxProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER)) {
         MailBox->SetPostCommandDequeuedCommand(this->BlockingCommandExecuted);
     } else {
         CMN_LOG_CLASS_INIT_VERBOSE << "AddSystemEvents: can not set mailbox post dequeued command for blocking commands for interface \""
@@ -910,7 +981,7 @@ bool mtsInterfaceProvided::AddSystemEvents(void)
                                  << this->GetFullName() << "\"" << std::endl;
         return false;
     }
-    if (this->MailBox) {
+    if (this->MailBox && (this->MailBoxProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER)) {
         MailBox->SetPostCommandReturnDequeuedCommand(this->BlockingCommandReturnExecuted);
     } else {
         CMN_LOG_CLASS_INIT_VERBOSE << "AddSystemEvents: can not set mailbox post dequeued command for blocking return commands for interface \""
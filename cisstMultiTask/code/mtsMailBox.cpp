@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -17,6 +17,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstCommon/cmnAssert.h>
+#include <cisstOSAbstraction/osaTimeServer.h>
 #include <cisstMultiTask/mtsMailBox.h>
 #include <cisstMultiTask/mtsCallableVoidBase.h>
 #include <cisstMultiTask/mtsCallableVoidReturnBase.h>
@@ -29,13 +30,20 @@ http://www.cisst.org/cisst/license.txt.
 
 mtsMailBox::mtsMailBox(const std::string & name,
                        size_t size,
-                       mtsCallableVoidBase * postCommandQueuedCallable):
-    CommandQueue(size, 0),
+                       mtsCallableVoidBase * postCommandQueuedCallable,
+                       mtsMailBoxProducerPolicy producerPolicy):
+    ProducerPolicy(producerPolicy),
     Name(name),
     PostCommandQueuedCallable(postCommandQueuedCallable),
     PostCommandDequeuedCommand(0),
     PostCommandReturnDequeuedCommand(0)
-{}
+{
+    if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+        CommandQueue.SetSize(size, 0);
+    } else {
+        CommandQueueMPSC.SetSize(size, 0);
+    }
+}
 
 
 mtsMailBox::~mtsMailBox(void)
@@ -51,7 +59,11 @@ const std::string & mtsMailBox::GetName(void) const
 bool mtsMailBox::Write(mtsCommandBase * command)
 {
     bool result;
-    result = (CommandQueue.Put(command) != 0);
+    if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+        result = (CommandQueue.Put(command) != 0);
+    } else {
+        result = (CommandQueueMPSC.Put(command) != 0);
+    }
     if (this->PostCommandQueuedCallable) {
         this->PostCommandQueuedCallable->Execute();
     }
@@ -62,13 +74,54 @@ bool mtsMailBox::Write(mtsCommandBase * command)
 // return false if nothing to execute; true otherwise.
 bool mtsMailBox::ExecuteNext(void)
 {
-   mtsCommandBase** command = CommandQueue.Peek();
+   mtsCommandBase ** commandSlot = PeekCommand();
 
    // test for empty queue
-   if (!command) {
+   if (!commandSlot) {
        return false;
    }
 
+   // keep a copy, the slot can be reused by producers once the command is removed
+   mtsCommandBase * command = *commandSlot;
+   return this->ExecuteCommand(command, true);
+}
+
+
+size_t mtsMailBox::ExecuteBatch(size_t maxCount, const osaTimeServer * timeServer,
+                                double deadline, size_t & deferred)
+{
+    size_t executed = 0;
+    mtsCommandBase ** commandSlot;
+    try {
+        while (executed < maxCount) {
+            // always execute at least one command
+            if (timeServer && (executed > 0)
+                && (timeServer->GetRelativeTime() >= deadline)) {
+                break;
+            }
+            commandSlot = PeekCommand(executed);
+            if (!commandSlot) {
+                break;
+            }
+            // count the command as executed before running it so it
+            // is removed along the others if an exception is thrown
+            executed++;
+            this->ExecuteCommand(*commandSlot, false);
+        }
+    }
+    catch (...) {
+        RemoveCommands(executed);
+        throw;
+    }
+    // publish all the freed slots at once
+    RemoveCommands(executed);
+    deferred = this->GetAvailable();
+    return executed;
+}
+
+
+bool mtsMailBox::ExecuteCommand(mtsCommandBase * command, bool removeCommand)
+{
    mtsCommandQueuedVoid * commandVoid;
    mtsCommandQueuedWriteBase * commandWrite;
    mtsCommandQueuedVoidReturn * commandVoidReturn;
@@ -83,118 +136,112 @@ bool mtsMailBox::ExecuteNext(void)
    bool isBlocking = false;
    bool isBlockingReturn = false;
    try {
-       if (!(*command)->Returns()) {
-           switch ((*command)->NumberOfArguments()) {
-           case 0:
-               commandVoid = dynamic_cast<mtsCommandQueuedVoid *>(*command);
-               CMN_ASSERT(commandVoid);
-               isBlocking = (commandVoid->BlockingFlagGet() == MTS_BLOCKING);
-               finishedEvent = commandVoid->FinishedEventGet();
-               result = commandVoid->GetCallable()->Execute();
-               break;
-           case 1:
-               commandWrite = dynamic_cast<mtsCommandQueuedWriteBase *>(*command);
-               if (commandWrite) {
-                   isBlocking = (commandWrite->BlockingFlagGet() == MTS_BLOCKING);
-                   finishedEvent = commandWrite->FinishedEventGet();
-                   try {
-                       result = commandWrite->GetActualCommand()->Execute(*(commandWrite->ArgumentPeek()), MTS_NOT_BLOCKING);
-                   }
-                   catch (...) {
-                       commandWrite->ArgumentGet();  // Remove from parameter queue
-                       throw;
-                   }
-                   commandWrite->ArgumentGet();  // Remove from parameter queue
-               }
-               else {
-                   // For the Read command, NumberOfArguments() is 1, and Returns() is false.
-                   // But, we will handle a queued Read command the same as a queued Void Return
-                   commandRead = dynamic_cast<mtsCommandQueuedRead *>(*command);
-                   CMN_ASSERT(commandRead);
-                   resultPointer = commandRead->ReturnGet();
-                   finishedEvent = commandRead->FinishedEventGet();
-                   isBlockingReturn = true;
-                   result = commandRead->GetCallable()->Execute(*resultPointer);
-               }
-               break;
-           case 2:
-               // For the Qualified Read command, NumberOfArguments() is 2, and Returns() is false.
-               // But, we will handle a queued Qualified Read command the same as a queued Write Return.
-               commandQualifiedRead = dynamic_cast<mtsCommandQueuedQualifiedRead *>(*command);
-               CMN_ASSERT(commandQualifiedRead);
-               resultPointer = commandQualifiedRead->ReturnGet();
-               finishedEvent = commandQualifiedRead->FinishedEventGet();
-               isBlockingReturn = true;
-               try {
-                   result = commandQualifiedRead->GetCallable()->Execute( *(commandQualifiedRead->ArgumentPeek()), *resultPointer);
-               }
-               catch (...) {
-                   commandQualifiedRead->ArgumentGet();  // Remove from parameter queue
-                   throw;
-               }
+       // the kind is set when the queued command is created, static casts are safe
+       switch (command->GetQueuedKind()) {
+       case MTS_COMMAND_KIND_QUEUED_VOID:
+           commandVoid = static_cast<mtsCommandQueuedVoid *>(command);
+           isBlocking = (commandVoid->BlockingFlagGet() == MTS_BLOCKING);
+           finishedEvent = commandVoid->FinishedEventGet();
+           result = commandVoid->GetCallable()->Execute();
+           break;
+       case MTS_COMMAND_KIND_QUEUED_WRITE:
+           commandWrite = static_cast<mtsCommandQueuedWriteBase *>(command);
+           isBlocking = (commandWrite->BlockingFlagGet() == MTS_BLOCKING);
+           finishedEvent = commandWrite->FinishedEventGet();
+           try {
+               result = commandWrite->GetActualCommand()->Execute(*(commandWrite->ArgumentPeek()), MTS_NOT_BLOCKING);
+           }
+           catch (...) {
+               commandWrite->ArgumentGet();  // Remove from parameter queue
+               throw;
+           }
+           commandWrite->ArgumentGet();  // Remove from parameter queue
+           break;
+       case MTS_COMMAND_KIND_QUEUED_READ:
+           // we handle a queued Read command the same as a queued Void Return
+           commandRead = static_cast<mtsCommandQueuedRead *>(command);
+           resultPointer = commandRead->ReturnGet();
+           finishedEvent = commandRead->FinishedEventGet();
+           isBlockingReturn = true;
+           result = commandRead->GetCallable()->Execute(*resultPointer);
+           break;
+       case MTS_COMMAND_KIND_QUEUED_QUALIFIED_READ:
+           // we handle a queued Qualified Read command the same as a queued Write Return.
+           commandQualifiedRead = static_cast<mtsCommandQueuedQualifiedRead *>(command);
+           resultPointer = commandQualifiedRead->ReturnGet();
+           finishedEvent = commandQualifiedRead->FinishedEventGet();
+           isBlockingReturn = true;
+           try {
+               result = commandQualifiedRead->GetCallable()->Execute( *(commandQualifiedRead->ArgumentPeek()), *resultPointer);
+           }
+           catch (...) {
                commandQualifiedRead->ArgumentGet();  // Remove from parameter queue
-               break;
-           default:
-               CMN_LOG_RUN_ERROR << "Class mtsMailBox: Invalid parameter in ExecuteNext" << std::endl;
-               return false;
+               throw;
+           }
+           commandQualifiedRead->ArgumentGet();  // Remove from parameter queue
+           break;
+       case MTS_COMMAND_KIND_QUEUED_VOID_RETURN:
+           commandVoidReturn = static_cast<mtsCommandQueuedVoidReturn *>(command);
+           resultPointer = commandVoidReturn->ReturnGet();
+           finishedEvent = commandVoidReturn->FinishedEventGet();
+           isBlockingReturn = true;
+           result = commandVoidReturn->GetCallable()->Execute(*resultPointer);
+           break;
+       case MTS_COMMAND_KIND_QUEUED_WRITE_RETURN:
+           commandWriteReturn = static_cast<mtsCommandQueuedWriteReturn *>(command);
+           resultPointer = commandWriteReturn->ReturnGet();
+           finishedEvent = commandWriteReturn->FinishedEventGet();
+           isBlockingReturn = true;
+           try {
+               result = commandWriteReturn->GetCallable()->Execute( *(commandWriteReturn->ArgumentPeek()), *resultPointer);
            }
-       } else {
-           switch ((*command)->NumberOfArguments()) {
-           case 0:
-               commandVoidReturn = dynamic_cast<mtsCommandQueuedVoidReturn *>(*command);
-               CMN_ASSERT(commandVoidReturn);
-               resultPointer = commandVoidReturn->ReturnGet();
-               finishedEvent = commandVoidReturn->FinishedEventGet();
-               isBlockingReturn = true;
-               result = commandVoidReturn->GetCallable()->Execute(*resultPointer);
-               break;
-           case 1:
-               commandWriteReturn = dynamic_cast<mtsCommandQueuedWriteReturn *>(*command);
-               CMN_ASSERT(commandWriteReturn);
-               resultPointer = commandWriteReturn->ReturnGet();
-               finishedEvent = commandWriteReturn->FinishedEventGet();
-               isBlockingReturn = true;
-               try {
-                   result = commandWriteReturn->GetCallable()->Execute( *(commandWriteReturn->ArgumentPeek()), *resultPointer);
-               }
-               catch (...) {
-                   commandWriteReturn->ArgumentGet();  // Remove from parameter queue
-                   throw;
-               }
+           catch (...) {
                commandWriteReturn->ArgumentGet();  // Remove from parameter queue
-               break;
-           default:
-               CMN_LOG_RUN_ERROR << "Class mtsMailBox: Invalid parameter in ExecuteNext" << std::endl;
-               return false;
+               throw;
            }
+           commandWriteReturn->ArgumentGet();  // Remove from parameter queue
+           break;
+       default:
+           CMN_LOG_RUN_ERROR << "Class mtsMailBox: Invalid command kind in ExecuteNext for command \""
+                             << command->GetName() << "\"" << std::endl;
+           if (removeCommand) {
+               RemoveCommand();
+           }
+           return false;
        }
    }
    catch (std::exception & exceptionCaught) {
-       CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
+       CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << command->GetName()
                            << "\" caught exception \"" << exceptionCaught.what() << "\"" << std::endl;
        this->TriggerPostQueuedCommandIfNeeded(isBlocking, isBlockingReturn);
-       CommandQueue.Get();  // Remove command from mailbox queue
+       if (removeCommand) {
+           RemoveCommand();  // Remove command from mailbox queue
+       }
        if (resultPointer || isBlocking)
-          TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
+          TriggerFinishedEventIfNeeded(command->GetName(), finishedEvent, resultPointer, result);
        throw;
    }
    catch (...) {
-       CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
+       CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << command->GetName()
                            << "\" caught exception, blocking = " << isBlocking << std::endl;
        this->TriggerPostQueuedCommandIfNeeded(isBlocking, isBlockingReturn);
-       CommandQueue.Get();  // Remove command from mailbox queue
+       if (removeCommand) {
+           RemoveCommand();  // Remove command from mailbox queue
+       }
        if (resultPointer || isBlocking)
-           TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
+           TriggerFinishedEventIfNeeded(command->GetName(), finishedEvent, resultPointer, result);
        throw;
    }
    this->TriggerPostQueuedCommandIfNeeded(isBlocking, isBlockingReturn);
    if (!result.IsOK()) {
-       CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
+       CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << command->GetName()
                            << "\" failed, execution result is \"" << result << "\"" << std::endl;
    }
-   CommandQueue.Get();  // Remove command from mailbox queue
+   if (removeCommand) {
+       RemoveCommand();  // Remove command from mailbox queue
+   }
    if (resultPointer || isBlocking)
-       TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
+       TriggerFinishedEventIfNeeded(command->GetName(), finishedEvent, resultPointer, result);
    return true;
 }
 
@@ -239,21 +286,42 @@ void mtsMailBox::TriggerFinishedEventIfNeeded(const std::string &commandName, mt
 
 void mtsMailBox::SetSize(size_t size)
 {
-    if (CommandQueue.GetSize() != size) {
-        CommandQueue.SetSize(size, 0); // array of null pointers
+    if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+        if (CommandQueue.GetSize() != size) {
+            CommandQueue.SetSize(size, 0); // array of null pointers
+        }
+    } else {
+        if (CommandQueueMPSC.GetSize() != size) {
+            CommandQueueMPSC.SetSize(size, 0);
+        }
     }
 }
 
 
+size_t mtsMailBox::GetAvailable(void) const
+{
+    if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+        return CommandQueue.GetAvailable();
+    }
+    return CommandQueueMPSC.GetAvailable();
+}
+
+
 bool mtsMailBox::IsEmpty(void) const
 {
-    return CommandQueue.IsEmpty();
+    if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+        return CommandQueue.IsEmpty();
+    }
+    return CommandQueueMPSC.IsEmpty();
 }
 
 
 bool mtsMailBox::IsFull(void) const
 {
-    return CommandQueue.IsFull();
+    if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+        return CommandQueue.IsFull();
+    }
+    return CommandQueueMPSC.IsFull();
 }
 
 
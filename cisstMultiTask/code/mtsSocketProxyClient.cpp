@@ -38,7 +38,6 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstOSAbstraction/osaGetTime.h>
 
-#include "mtsProxySerializer.h"
 
 //************************ mtsSocketProxyClientConstructorArg *********************************
 //
@@ -108,16 +107,17 @@ bool mtsSocketProxyClientConstructorArg::FromStreamRaw(std::istream & inputStrea
 //********************************* EventReceiverWriteProxy **********************************************
 //
 // This class provides a receiver for the write events used by mtsSocketProxyServer to send back
-// execution results. The ExecuteSerialized method receives a string, and expects either the return
-// value or the serialized mtsExecutionResult (actually, an mtsExecutionResultProxy, which
-// is derived from mtsGenericObject).
+// execution results. The ExecuteSerialized method receives the response, which starts with a
+// character indicating whether it contains the return value (SOCKET_PROXY_RESPONSE_ARGUMENT) or
+// the serialized mtsExecutionResult (SOCKET_PROXY_RESPONSE_RESULT, actually an mtsExecutionResultProxy,
+// which is derived from mtsGenericObject).
 //
 // The CommandWrapper class (see below) contains an instance of this class, and indicates whether
 // a return value is expected by calling SetArg, passing either 0 (no return value expected) or
 // a pointer to the expected type (derived from mtsGenericObject).
 //
-// This class maintains a pointer to the Serializer for the client (note that there may be multiple clients
-// connected to the provided interface, but they can share a single serializer).
+// This class maintains a pointer to the DeSerializer for the client (note that there may be multiple clients
+// connected to the provided interface, but they can share a single deserializer).
 //
 // The class also contains a pointer to a CallerEvent, which is used to unblock commands waiting
 // for a response.
@@ -125,14 +125,14 @@ bool mtsSocketProxyClientConstructorArg::FromStreamRaw(std::istream & inputStrea
 class EventReceiverWriteProxy
 {
 private:
-    mtsProxySerializer *Serializer;
+    mtsSocketProxyDeSerializer *DeSerializer;
     mtsGenericObject   *arg;
     bool                isBlocking;
     mtsCommandWriteBase *CallerEvent;
 
 public:
-    EventReceiverWriteProxy(mtsProxySerializer *serializer) : Serializer(serializer), arg(0),
-                                                              isBlocking(false), CallerEvent(0) {}
+    EventReceiverWriteProxy(mtsSocketProxyDeSerializer *deserializer) : DeSerializer(deserializer), arg(0),
+                                                                        isBlocking(false), CallerEvent(0) {}
     ~EventReceiverWriteProxy() {}
 
     void SetArg(mtsGenericObject *a) { arg = a; }
@@ -141,18 +141,33 @@ public:
     void SetCallerEvent(mtsCommandWriteBase *cmd) { CallerEvent = cmd; }
 
     void ExecuteSerialized(const std::string &argString)
+    {
+        ExecuteSerialized(argString.data(), argString.size());
+    }
+
+    void ExecuteSerialized(const char *data, size_t size)
     {
         if (!CallerEvent) {
             CMN_LOG_RUN_WARNING << "EventReceiverWriteProxy: CallerEvent is NULL" << std::endl;
         }
-        if (arg && Serializer->DeSerialize(argString, *arg)) {
+        const char responseType = (size > 0) ? data[0] : 0;
+        if (size > 0) {
+            data++;
+            size--;
+        }
+        bool argDeSerialized = false;
+        if (arg && (responseType == mtsSocketProxy::SOCKET_PROXY_RESPONSE_ARGUMENT)) {
+            argDeSerialized = DeSerializer->DeSerialize(data, size, *arg);
+        }
+        if (argDeSerialized) {
             if (CallerEvent) {
                 CallerEvent->Execute(*arg, MTS_NOT_BLOCKING);
             }
         }
         else {
             mtsExecutionResultProxy resultProxy;
-            if (!Serializer->DeSerialize(argString, resultProxy)) {
+            if ((responseType != mtsSocketProxy::SOCKET_PROXY_RESPONSE_RESULT)
+                || !DeSerializer->DeSerialize(data, size, resultProxy)) {
                 CMN_LOG_RUN_ERROR << "EventReceiverWriteProxy: failed to deserialize execution result" << std::endl;
                 resultProxy = mtsExecutionResult(mtsExecutionResult::DESERIALIZATION_ERROR);
             }
@@ -179,6 +194,21 @@ public:
     }
 };
 
+// Command used as the receive handle sent to the server (see CommandWrapperBase). The client dispatches
+// the responses directly to the receiver, without copying them into the command argument (std::string).
+class EventReceiverWriteCommand : public mtsCommandWrite<EventReceiverWriteProxy, std::string>
+{
+    EventReceiverWriteProxy *Receiver;
+public:
+    EventReceiverWriteCommand(EventReceiverWriteProxy *receiver, const std::string &name) :
+        mtsCommandWrite<EventReceiverWriteProxy, std::string>(&EventReceiverWriteProxy::ExecuteSerialized,
+                                                              receiver, name, std::string()),
+        Receiver(receiver) {}
+    ~EventReceiverWriteCommand() {}
+
+    EventReceiverWriteProxy *GetReceiver(void) const { return Receiver; }
+};
+
 //****************************************** Command Wrappers **************************************************
 //
 // These classes provide the methods for the mtsCommand objects that populate the provided interface.
@@ -189,14 +219,15 @@ public:
 // The implementation uses classes because there is data that needs to be associated with each class instance.
 // The CommandWrapperBase class contains the data that is needed by all derived classes:
 //    Name:           name of command
-//    Socket:         reference to mtsSocketProxyClient::Socket (single socket shared by all)
+//    Channel:        reference to mtsSocketProxyClient::Channel (single channel shared by all)
 //    Handle:         "handle" for this command (see mtsSocketProxyCommon); basically, this is the address of
 //                    the command object, preceeded by some identifying data (space, command type)
 //    Receiver:       An instance of the EventReceiverWriteProxy, which is used to receive return events from the Server
 //    receiveHandler: A (write) command object that is used to call EventReceiverWriteProxy::ExecuteSerialized; this is
 //                    sent to the Server (as a recv_handle)
-//    Proxy:          A pointer to mtsSocketProxyClient; these classes use it to access the Serializer and a few
-//                    methods; it could also be used to access the Socket
+//    SendBuffer:     Buffer used to build and send the command messages, reused for each call
+//    Proxy:          A pointer to mtsSocketProxyClient; these classes use it to access the DeSerializer and a few
+//                    methods; it could also be used to access the Channel
 //
 // These classes include a Clone method because some items, such as the Receiver and receiveHandler, should
 // be distinct within each provided interface instance (end-user interface).
@@ -204,32 +235,48 @@ public:
 class CommandWrapperBase {
 protected:
     std::string Name;
-    osaSocket   &Socket;
+    mtsSocketProxyChannel &Channel;
     char        Handle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
     EventReceiverWriteProxy *Receiver;
     mtsCommandWriteBase     *receiveHandler;
+    mtsSocketProxySendBuffer *SendBuffer;
     mtsSocketProxyClient    *Proxy;
+
+    // Start a new message: command handle, with the specified command type, followed by
+    // the receive handle. The serialized arguments, if any, are then appended.
+    void StartMessage(char cmdType) const
+    {
+        SendBuffer->Reset();
+        SendBuffer->Append(Handle, sizeof(Handle));
+        SendBuffer->GetData()[1] = cmdType;
+        char recvHandle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+        CommandHandle recv_handle('W', receiveHandler);
+        recv_handle.ToString(recvHandle);
+        SendBuffer->Append(recvHandle, sizeof(recvHandle));
+    }
+
 public:
-    CommandWrapperBase(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : Name(name), Socket(socket), Proxy(proxy)
+    CommandWrapperBase(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : Name(name), Channel(channel), Proxy(proxy)
     {
         Handle[0] = 0;
-        Receiver = new EventReceiverWriteProxy(Proxy->Serializer);
-        receiveHandler = new mtsCommandWrite<EventReceiverWriteProxy, std::string>(&EventReceiverWriteProxy::ExecuteSerialized,
-                                                                                   Receiver, name+"Receiver", std::string());
+        Receiver = new EventReceiverWriteProxy(&Proxy->DeSerializer);
+        receiveHandler = new EventReceiverWriteCommand(Receiver, name+"Receiver");
+        SendBuffer = new mtsSocketProxySendBuffer;
     }
 
-    CommandWrapperBase(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : Name(name), Socket(socket), Proxy(proxy)
+    CommandWrapperBase(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : Name(name), Channel(channel), Proxy(proxy)
     {
         SetHandle(handle);
-        Receiver = new EventReceiverWriteProxy(Proxy->Serializer);
-        receiveHandler = new mtsCommandWrite<EventReceiverWriteProxy, std::string>(&EventReceiverWriteProxy::ExecuteSerialized,
-                                                                                   Receiver, name+"Receiver", std::string());
+        Receiver = new EventReceiverWriteProxy(&Proxy->DeSerializer);
+        receiveHandler = new EventReceiverWriteCommand(Receiver, name+"Receiver");
+        SendBuffer = new mtsSocketProxySendBuffer;
     }
 
     ~CommandWrapperBase()
     {
+        delete SendBuffer;
         delete receiveHandler;
         delete Receiver;
     }
@@ -254,15 +301,15 @@ public:
 
 class CommandWrapperVoid : public CommandWrapperBase {
 public:
-    CommandWrapperVoid(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) {}
-    CommandWrapperVoid(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) {}
+    CommandWrapperVoid(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, channel, proxy) {}
+    CommandWrapperVoid(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, channel, proxy, handle) {}
     ~CommandWrapperVoid() {}
 
     CommandWrapperVoid *Clone(void) const
     {
-        return new CommandWrapperVoid(Name, Socket, Proxy, Handle);
+        return new CommandWrapperVoid(Name, Channel, Proxy, Handle);
     }
 
     // This is called just before the Method is called via the command object
@@ -275,13 +322,8 @@ public:
             return;
         }
         Receiver->SetArg(0);
-        char sendBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-        memcpy(sendBuffer, Handle, sizeof(Handle));
-        if (Receiver->IsBlocking())
-            sendBuffer[1] = 'v';
-        CommandHandle recv_handle('W', receiveHandler);
-        recv_handle.ToString(sendBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-        Socket.Send(sendBuffer, sizeof(sendBuffer));
+        StartMessage(Receiver->IsBlocking() ? 'v' : 'V');
+        SendBuffer->Send(Channel);
         // Now return to the caller. If this is a blocking command, the caller will
         // wait on a thread signal, which will be raised in the Receiver object.
     }
@@ -289,15 +331,15 @@ public:
 
 class CommandWrapperWrite : public CommandWrapperBase {
 public:
-    CommandWrapperWrite(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) {}
-    CommandWrapperWrite(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) {}
+    CommandWrapperWrite(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, channel, proxy) {}
+    CommandWrapperWrite(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, channel, proxy, handle) {}
     ~CommandWrapperWrite() {}
 
     CommandWrapperWrite *Clone(void) const
     {
-        return new CommandWrapperWrite(Name, Socket, Proxy, Handle);
+        return new CommandWrapperWrite(Name, Channel, Proxy, Handle);
     }
 
     // This is called just before the Method is called via the command object
@@ -309,17 +351,10 @@ public:
             CMN_LOG_RUN_ERROR << "CommandWrapperWrite: invalid handle = " << Handle[1] << std::endl;
             return;
         }
-        std::string sendBuffer;
         Receiver->SetArg(0);
-        if (Proxy->Serialize(arg, sendBuffer)) {
-            char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-            memcpy(cmdBuffer, Handle, sizeof(Handle));
-            if (Receiver->IsBlocking())
-                cmdBuffer[1] = 'w';
-            CommandHandle recv_handle('W', receiveHandler);
-            recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+        StartMessage(Receiver->IsBlocking() ? 'w' : 'W');
+        if (SendBuffer->Serialize(arg)) {
+            SendBuffer->Send(Channel);
             // Now return to the caller. If this is a blocking command, the caller will
             // wait on a thread signal, which will be raised in the Receiver object.
         }
@@ -330,16 +365,16 @@ class CommandWrapperRead : public CommandWrapperBase {
 public:
     typedef mtsCallableReadMethodGeneric<CommandWrapperRead> CallableType;
 
-    CommandWrapperRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) { }
-    CommandWrapperRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) { }
+    CommandWrapperRead(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, channel, proxy) { }
+    CommandWrapperRead(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, channel, proxy, handle) { }
 
     ~CommandWrapperRead() { }
 
     CommandWrapperRead *Clone(void) const
     {
-        return new CommandWrapperRead(Name, Socket, Proxy, Handle);
+        return new CommandWrapperRead(Name, Channel, Proxy, Handle);
     }
 
     bool Method(mtsGenericObject &arg) const
@@ -349,11 +384,8 @@ public:
             return false;
         }
         Receiver->SetArg(&arg);
-        char sendBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-        memcpy(sendBuffer, Handle, sizeof(Handle));
-        CommandHandle recv_handle('W', receiveHandler);
-        recv_handle.ToString(sendBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-        return (Socket.Send(sendBuffer, sizeof(sendBuffer)) > 0);
+        StartMessage(Handle[1]);
+        return (SendBuffer->Send(Channel) > 0);
     }
 };
 
@@ -361,15 +393,15 @@ class CommandWrapperQualifiedRead : public CommandWrapperBase {
 public:
     typedef mtsCallableQualifiedReadMethodGeneric<CommandWrapperQualifiedRead> CallableType;
 
-    CommandWrapperQualifiedRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) {}
-    CommandWrapperQualifiedRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) {}
+    CommandWrapperQualifiedRead(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, channel, proxy) {}
+    CommandWrapperQualifiedRead(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, channel, proxy, handle) {}
     ~CommandWrapperQualifiedRead() {}
 
     CommandWrapperQualifiedRead *Clone(void) const
     {
-        return new CommandWrapperQualifiedRead(Name, Socket, Proxy, Handle);
+        return new CommandWrapperQualifiedRead(Name, Channel, Proxy, Handle);
     }
 
     bool Method(const mtsGenericObject &arg1, mtsGenericObject &arg2) const
@@ -379,14 +411,9 @@ public:
             return false;
         }
         Receiver->SetArg(&arg2);
-        std::string sendBuffer;
-        if (Proxy->Serialize(arg1, sendBuffer)) {
-            char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-            memcpy(cmdBuffer, Handle, sizeof(Handle));
-            CommandHandle recv_handle('W', receiveHandler);
-            recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            return (Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05) > 0);
+        StartMessage(Handle[1]);
+        if (SendBuffer->Serialize(arg1)) {
+            return (SendBuffer->Send(Channel) > 0);
         }
         return false;
     }
@@ -396,16 +423,16 @@ class CommandWrapperVoidReturn : public CommandWrapperBase {
 public:
     typedef mtsCallableVoidReturnMethodGeneric<CommandWrapperVoidReturn> CallableType;
 
-    CommandWrapperVoidReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) { }
-    CommandWrapperVoidReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) { }
+    CommandWrapperVoidReturn(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, channel, proxy) { }
+    CommandWrapperVoidReturn(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, channel, proxy, handle) { }
 
     ~CommandWrapperVoidReturn() { }
 
     CommandWrapperVoidReturn *Clone(void) const
     {
-        return new CommandWrapperVoidReturn(Name, Socket, Proxy, Handle);
+        return new CommandWrapperVoidReturn(Name, Channel, Proxy, Handle);
     }
 
     void Method(mtsGenericObject &arg)
@@ -415,11 +442,8 @@ public:
             return;
         }
         Receiver->SetArg(&arg);
-        char sendBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-        memcpy(sendBuffer, Handle, sizeof(Handle));
-        CommandHandle recv_handle('W', receiveHandler);
-        recv_handle.ToString(sendBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-        Socket.Send(sendBuffer, sizeof(sendBuffer));
+        StartMessage(Handle[1]);
+        SendBuffer->Send(Channel);
         // Now return to the caller. The caller will wait on a thread signal, which
         // will be raised in the Receiver object.
     }
@@ -429,16 +453,16 @@ class CommandWrapperWriteReturn : public CommandWrapperBase {
 public:
     typedef mtsCallableWriteReturnMethodGeneric<CommandWrapperWriteReturn> CallableType;
 
-    CommandWrapperWriteReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) { }
-    CommandWrapperWriteReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) { }
+    CommandWrapperWriteReturn(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, channel, proxy) { }
+    CommandWrapperWriteReturn(const std::string &name, mtsSocketProxyChannel &channel, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, channel, proxy, handle) { }
 
     ~CommandWrapperWriteReturn() { }
 
     CommandWrapperWriteReturn *Clone(void) const
     {
-        return new CommandWrapperWriteReturn(Name, Socket, Proxy, Handle);
+        return new CommandWrapperWriteReturn(Name, Channel, Proxy, Handle);
     }
 
     void Method(const mtsGenericObject &arg1, mtsGenericObject &arg2)
@@ -448,14 +472,9 @@ public:
             return;
         }
         Receiver->SetArg(&arg2);
-        std::string sendBuffer;
-        if (Proxy->Serialize(arg1, sendBuffer)) {
-            char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-            memcpy(cmdBuffer, Handle, sizeof(Handle));
-            CommandHandle recv_handle('W', receiveHandler);
-            recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+        StartMessage(Handle[1]);
+        if (SendBuffer->Serialize(arg1)) {
+            SendBuffer->Send(Channel);
             // Now return to the caller. The caller will wait on a thread signal, which
             // will be raised in the Receiver object.
         }
@@ -702,7 +721,7 @@ public:
         return Execute(argument, blocking);
     }
 
-    mtsExecutionResult ExecuteSerialized(const std::string &inputArgSerialized, mtsBlockingType blocking);
+    mtsExecutionResult ExecuteSerialized(const char *inputArgSerialized, size_t size, mtsBlockingType blocking);
 };
 
 MulticastCommandWriteProxy::MulticastCommandWriteProxy(const std::string &name, const std::string &argPrototypeSerialized,
@@ -775,7 +794,7 @@ mtsExecutionResult MulticastCommandWriteProxy::Execute(const mtsGenericObject &
     return mtsExecutionResult::COMMAND_SUCCEEDED;
 }
 
-mtsExecutionResult MulticastCommandWriteProxy::ExecuteSerialized(const std::string &inputArgSerialized,
+mtsExecutionResult MulticastCommandWriteProxy::ExecuteSerialized(const char *inputArgSerialized, size_t size,
                                                                  mtsBlockingType blocking)
 {
     mtsExecutionResult ret = mtsExecutionResult:: ARGUMENT_DYNAMIC_CREATION_FAILED;
@@ -786,7 +805,7 @@ mtsExecutionResult MulticastCommandWriteProxy::ExecuteSerialized(const std::stri
     // sends the incorrect type.
     CreateArg();
     if (arg) {
-        if (Proxy->DeSerialize(inputArgSerialized, *arg))
+        if (Proxy->DeSerialize(inputArgSerialized, size, *arg))
             ret = Execute(*arg, blocking);
         else
             ret = mtsExecutionResult::DESERIALIZATION_ERROR;
@@ -802,25 +821,42 @@ mtsExecutionResult MulticastCommandWriteProxy::ExecuteSerialized(const std::stri
 
 mtsSocketProxyClient::mtsSocketProxyClient(const std::string & proxyName, const std::string & ip, short port) :
     mtsTaskContinuous(proxyName),
-    Socket(osaSocket::UDP),
-    Serializer(0),
+    Channel(0),
     localUnblockingCommand(0),
     EventEnableCommand(0),
     EventDisableCommand(0)
 {
-    Socket.SetDestination(ip, port);
+    mtsSocketProxyChannelUDP *channel = new mtsSocketProxyChannelUDP;
+    channel->SetDestination(ip, port);
+    Channel = channel;
     CreateClientProxy("Provided");
 }
 
+mtsSocketProxyClient::mtsSocketProxyClient(const std::string & proxyName, const std::string & sharedMemoryName) :
+    mtsTaskContinuous(proxyName),
+    Channel(0),
+    localUnblockingCommand(0),
+    EventEnableCommand(0),
+    EventDisableCommand(0)
+{
+    mtsSocketProxyChannelSharedMemory *channel = new mtsSocketProxyChannelSharedMemory;
+    Channel = channel;
+    if (channel->Connect(sharedMemoryName))
+        CreateClientProxy("Provided");
+    else
+        CMN_LOG_CLASS_INIT_ERROR << "Failed to connect to shared memory channel " << sharedMemoryName << std::endl;
+}
+
 mtsSocketProxyClient::mtsSocketProxyClient(const mtsSocketProxyClientConstructorArg &arg) :
     mtsTaskContinuous(arg.Name),
-    Socket(osaSocket::UDP),
-    Serializer(0),
+    Channel(0),
     localUnblockingCommand(0),
     EventEnableCommand(0),
     EventDisableCommand(0)
 {
-    Socket.SetDestination(arg.IP, arg.Port);
+    mtsSocketProxyChannelUDP *channel = new mtsSocketProxyChannelUDP;
+    channel->SetDestination(arg.IP, arg.Port);
+    Channel = channel;
     CreateClientProxy("Provided");
 }
 
@@ -830,13 +866,13 @@ mtsSocketProxyClient::~mtsSocketProxyClient()
     for (i = 0; i < EventGenerators.size(); i++)
         delete EventGenerators[i];
 
-    delete Serializer;
     delete localUnblockingCommand;
     // PK: Need to do following
     // delete EventEnableCommand->ClassInstantiation;
     // delete EventDisableCommand->ClassInstantiation;
     delete EventEnableCommand;
     delete EventDisableCommand;
+    delete Channel;
 }
 
 void mtsSocketProxyClient::Startup(void)
@@ -852,14 +888,16 @@ void mtsSocketProxyClient::Run(void)
 // Check for events
 void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
 {
-    std::string inputArgString;
-    char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
-    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), timeoutInSec, 0.5);
+    int bytesRead = ReceiveBuffer.Receive(*Channel, timeoutInSec, 0.5);
     if (bytesRead > 0) {
-        size_t pos = inputArgString.find(' ');
-        if ((pos == 0) && (inputArgString.size() >= CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
-            CommandHandle handle(inputArgString);
-            inputArgString.erase(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        const char *message = ReceiveBuffer.GetData();
+        const size_t messageSize = ReceiveBuffer.GetSize();
+        if (ReceiveBuffer.IsFramed() && (messageSize >= CommandHandle::COMMAND_HANDLE_STRING_SIZE)
+            && (message[0] == ' ')) {
+            CommandHandle handle(message);
+            // Serialized argument, if any, follows the handle
+            const char *inputArg = message + CommandHandle::COMMAND_HANDLE_STRING_SIZE;
+            const size_t inputArgSize = messageSize - CommandHandle::COMMAND_HANDLE_STRING_SIZE;
             // Since we know the command type (handle.cmdType) we could reinterpret_cast directly to
             // the correct mtsCommandXXXX type, but to be safe we first reinterpret_cast to the base
             // type, mtsCommandBase, and then do a dynamic_cast to the expected type. If the address
@@ -869,7 +907,7 @@ void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
             try {
                 MulticastCommandVoidProxy *commandVoid;
                 MulticastCommandWriteProxy *commandWrite;
-                mtsCommandWriteBase *commandWriteInternal;
+                EventReceiverWriteCommand *commandWriteInternal;
                 switch (handle.cmdType) {
                   case 'V':
                       commandVoid = dynamic_cast<MulticastCommandVoidProxy *>(commandBase);
@@ -881,12 +919,12 @@ void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
                   case 'W':
                       commandWrite = dynamic_cast<MulticastCommandWriteProxy *>(commandBase);
                       if (commandWrite)
-                          commandWrite->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING);
+                          commandWrite->ExecuteSerialized(inputArg, inputArgSize, MTS_NOT_BLOCKING);
                       else {
                           // Check if this command is the event with the return value
-                          commandWriteInternal = dynamic_cast<mtsCommandWrite<EventReceiverWriteProxy, std::string> *>(commandBase);
+                          commandWriteInternal = dynamic_cast<EventReceiverWriteCommand *>(commandBase);
                           if (commandWriteInternal)
-                              commandWriteInternal->Execute(mtsStdString(inputArgString), MTS_NOT_BLOCKING);
+                              commandWriteInternal->GetReceiver()->ExecuteSerialized(inputArg, inputArgSize);
                           else
                               CMN_LOG_CLASS_RUN_ERROR << "MulticastCommandWriteProxy dynamic cast failed" << std::endl;
                       }
@@ -901,28 +939,18 @@ void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
             }
         }
         else
-            CMN_LOG_CLASS_RUN_ERROR << "Received invalid data: " << inputArgString << std::endl;
+            CMN_LOG_CLASS_RUN_ERROR << "Received invalid data, size = " << messageSize << std::endl;
     }
 }
 
-bool mtsSocketProxyClient::Serialize(const mtsGenericObject & originalObject, std::string & serializedObject)
-{
-     return Serializer->Serialize(originalObject, serializedObject);
-}
-
-bool mtsSocketProxyClient::DeSerialize(const std::string & serializedObject, mtsGenericObject & originalObject)
-{
-    return Serializer->DeSerialize(serializedObject, originalObject);
-}
-
-mtsGenericObject * mtsSocketProxyClient::DeSerialize(const std::string & serializedObject)
+bool mtsSocketProxyClient::DeSerialize(const char * serializedObject, size_t size, mtsGenericObject & originalObject)
 {
-    return Serializer->DeSerialize(serializedObject);
+    return DeSerializer.DeSerialize(serializedObject, size, originalObject);
 }
 
 void mtsSocketProxyClient::Cleanup(void)
 {
-    Socket.Close();
+    Channel->Close();
 }
 
 void mtsSocketProxyClient::LocalUnblockingHandler(const mtsGenericObject & CMN_UNUSED(arg))
@@ -959,11 +987,10 @@ bool mtsSocketProxyClient::WaitForResponse(double timeoutInSec)
 //-----------------------------------------------------------------------------
 bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfaceName)
 {
-    Serializer = new mtsProxySerializer;
     localUnblockingCommand = new mtsCommandWriteGeneric<mtsSocketProxyClient>(&mtsSocketProxyClient::LocalUnblockingHandler, this,
                                                                               "UnblockingCommand", 0);
 
-    CommandWrapperRead GetInitData("GetInitData", Socket, this);
+    CommandWrapperRead GetInitData("GetInitData", *Channel, this);
     GetInitData.SetHandle(" I        ");
     GetInitData.SetCallerEvent(localUnblockingCommand);
     LocalWaiting = true;
@@ -972,8 +999,8 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
             CMN_LOG_CLASS_RUN_WARNING << "Client interface version = " << mtsSocketProxy::SOCKET_PROXY_VERSION
                                       << ", Server interface version = " << ServerData.InterfaceVersion() << std::endl;
         }
-        if (ServerData.PacketSize() != mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE) {
-            CMN_LOG_CLASS_RUN_WARNING << "Client packet size = " << mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE
+        if (ServerData.PacketSize() != Channel->GetPacketSize()) {
+            CMN_LOG_CLASS_RUN_WARNING << "Client packet size = " << Channel->GetPacketSize()
                                       << ", Server packet size = " << ServerData.PacketSize() << std::endl;
         }
     }
@@ -988,17 +1015,17 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     // to enable or disable sending of events on the server. If thread safety is required, it would be better to
     // make AddObserver and RemoveObserver available as queued commands.
     mtsStdString arg;
-    CommandWrapperWrite *eventEnableWrapper = new CommandWrapperWrite("EventEnable", Socket, this, ServerData.EventEnable());
+    CommandWrapperWrite *eventEnableWrapper = new CommandWrapperWrite("EventEnable", *Channel, this, ServerData.EventEnable());
     EventEnableCommand = new mtsCommandWriteGeneric<CommandWrapperWrite>(&CommandWrapperWrite::Method, eventEnableWrapper,
                                                                          "EventEnable", &arg);
-    CommandWrapperWrite *eventDisableWrapper = new CommandWrapperWrite("EventDisable", Socket, this, ServerData.EventDisable());
+    CommandWrapperWrite *eventDisableWrapper = new CommandWrapperWrite("EventDisable", *Channel, this, ServerData.EventDisable());
     EventDisableCommand = new mtsCommandWriteGeneric<CommandWrapperWrite>(&CommandWrapperWrite::Method, eventDisableWrapper,
                                                                           "EventDisable", &arg);
 
 
     // Create the client proxy based on the provided interface description obtained from the server proxy.
     mtsGenericObjectProxy<mtsInterfaceProvidedDescription> descProxy;
-    CommandWrapperRead GetInterfaceDescription("GetInterfaceDescription", Socket, this, ServerData.GetInterfaceDescription());
+    CommandWrapperRead GetInterfaceDescription("GetInterfaceDescription", *Channel, this, ServerData.GetInterfaceDescription());
     GetInterfaceDescription.SetCallerEvent(localUnblockingCommand);
     LocalWaiting = true;
     if (!GetInterfaceDescription.Method(descProxy) || !WaitForResponse(3.0)) {
@@ -1019,11 +1046,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     mtsStdString handleSerialized;
 
     // Create Void command proxies
-    CommandWrapperQualifiedRead GetHandleVoid("GetHandleVoid", Socket, this, ServerData.GetHandleVoid());
+    CommandWrapperQualifiedRead GetHandleVoid("GetHandleVoid", *Channel, this, ServerData.GetHandleVoid());
     GetHandleVoid.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsVoid.size(); ++i) {
         std::string commandName = providedInterfaceDescription.CommandsVoid[i].Name;
-        CommandWrapperVoid *wrapper = new CommandWrapperVoid(commandName, Socket, this);
+        CommandWrapperVoid *wrapper = new CommandWrapperVoid(commandName, *Channel, this);
         LocalWaiting = true;
         if (GetHandleVoid.Method(mtsStdString(commandName), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1035,11 +1062,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create Write command proxies
-    CommandWrapperQualifiedRead GetHandleWrite("GetHandleWrite", Socket, this, ServerData.GetHandleWrite());
+    CommandWrapperQualifiedRead GetHandleWrite("GetHandleWrite", *Channel, this, ServerData.GetHandleWrite());
     GetHandleWrite.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsWrite.size(); ++i) {
         const mtsCommandWriteDescription &cmd = providedInterfaceDescription.CommandsWrite[i];
-        CommandWrapperWrite *wrapper = new CommandWrapperWrite(cmd.Name, Socket, this);
+        CommandWrapperWrite *wrapper = new CommandWrapperWrite(cmd.Name, *Channel, this);
         LocalWaiting = true;
         if (GetHandleWrite.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1061,11 +1088,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create Read command proxies
-    CommandWrapperQualifiedRead GetHandleRead("GetHandleRead", Socket, this, ServerData.GetHandleRead());
+    CommandWrapperQualifiedRead GetHandleRead("GetHandleRead", *Channel, this, ServerData.GetHandleRead());
     GetHandleRead.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsRead.size(); ++i) {
         const mtsCommandReadDescription &cmd = providedInterfaceDescription.CommandsRead[i];
-        CommandWrapperRead *wrapper = new CommandWrapperRead(cmd.Name, Socket, this);
+        CommandWrapperRead *wrapper = new CommandWrapperRead(cmd.Name, *Channel, this);
         LocalWaiting = true;
         if (GetHandleRead.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1087,11 +1114,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create QualifiedRead command proxies
-    CommandWrapperQualifiedRead GetHandleQualifiedRead("GetHandleQualifiedRead", Socket, this, ServerData.GetHandleQualifiedRead());
+    CommandWrapperQualifiedRead GetHandleQualifiedRead("GetHandleQualifiedRead", *Channel, this, ServerData.GetHandleQualifiedRead());
     GetHandleQualifiedRead.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsQualifiedRead.size(); ++i) {
         const mtsCommandQualifiedReadDescription &cmd = providedInterfaceDescription.CommandsQualifiedRead[i];
-        CommandWrapperQualifiedRead *wrapper = new CommandWrapperQualifiedRead(cmd.Name, Socket, this);
+        CommandWrapperQualifiedRead *wrapper = new CommandWrapperQualifiedRead(cmd.Name, *Channel, this);
         LocalWaiting = true;
         if (GetHandleQualifiedRead.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1116,11 +1143,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create VoidReturn command proxies
-    CommandWrapperQualifiedRead GetHandleVoidReturn("GetHandleVoidReturn", Socket, this, ServerData.GetHandleVoidReturn());
+    CommandWrapperQualifiedRead GetHandleVoidReturn("GetHandleVoidReturn", *Channel, this, ServerData.GetHandleVoidReturn());
     GetHandleVoidReturn.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsVoidReturn.size(); ++i) {
         const mtsCommandVoidReturnDescription &cmd = providedInterfaceDescription.CommandsVoidReturn[i];
-        CommandWrapperVoidReturn *wrapper = new CommandWrapperVoidReturn(cmd.Name, Socket, this);
+        CommandWrapperVoidReturn *wrapper = new CommandWrapperVoidReturn(cmd.Name, *Channel, this);
         LocalWaiting = true;
         if (GetHandleVoidReturn.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1142,11 +1169,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create WriteReturn command proxies
-    CommandWrapperQualifiedRead GetHandleWriteReturn("GetHandleWriteReturn", Socket, this, ServerData.GetHandleWriteReturn());
+    CommandWrapperQualifiedRead GetHandleWriteReturn("GetHandleWriteReturn", *Channel, this, ServerData.GetHandleWriteReturn());
     GetHandleWriteReturn.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsWriteReturn.size(); ++i) {
         const mtsCommandWriteReturnDescription &cmd = providedInterfaceDescription.CommandsWriteReturn[i];
-        CommandWrapperWriteReturn *wrapper = new CommandWrapperWriteReturn(cmd.Name, Socket, this);
+        CommandWrapperWriteReturn *wrapper = new CommandWrapperWriteReturn(cmd.Name, *Channel, this);
         LocalWaiting = true;
         if (GetHandleWriteReturn.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
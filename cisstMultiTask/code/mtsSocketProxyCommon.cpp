@@ -19,6 +19,9 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstMultiTask/mtsSocketProxyCommon.h>
 
+#include <algorithm>
+#include <string.h>
+
 CommandHandle::CommandHandle(char cmd, void *ptr) : cmdType(cmd)
 {
     addr = (long long int)ptr;
@@ -195,3 +198,283 @@ bool mtsSocketProxyInitData::FromStreamRaw(std::istream & inputStream, const cha
         return false;
     return (typeid(*this) == typeid(mtsSocketProxyInitData));
 }
+
+//********************************** Binary message buffers *********************************************
+
+int mtsSocketProxyChannel::SendAsPackets(const std::string & message, double timeoutSec)
+{
+    const unsigned int packetSize = GetPacketSize();
+    const char * data = message.data();
+    unsigned int remaining = static_cast<unsigned int>(message.size());
+    int sent = 0;
+    do {
+        const unsigned int size = std::min(remaining, packetSize);
+        const int n = Send(data, size, timeoutSec);
+        if (n > 0)
+            sent += n;
+        if (n != static_cast<int>(size))
+            break;
+        data += size;
+        remaining -= size;
+    } while (remaining > 0);
+    return sent;
+}
+
+unsigned int mtsSocketProxyChannelSharedMemory::GetPacketSize(void) const
+{
+    return std::min(Channel.GetMaximumMessageSize(), mtsSocketProxy::SOCKET_PROXY_MAX_DATAGRAM_SIZE);
+}
+
+void mtsSocketProxyChannelSharedMemory::SetDestination(const osaIPandPort & ip_port)
+{
+    // Clients always send to the server
+    if (Channel.IsServer())
+        Channel.SetDestination(ip_port.Port);
+}
+
+bool mtsSocketProxyChannelSharedMemory::GetDestination(osaIPandPort & ip_port) const
+{
+    ip_port.IP = "shm";
+    ip_port.Port = static_cast<unsigned short>(Channel.GetDestination());
+    return Channel.IsOpen();
+}
+
+int mtsSocketProxyChannelSharedMemory::Receive(char * buffer, unsigned int maxlen, double timeoutSec)
+{
+    const int n = Channel.Receive(buffer, maxlen, timeoutSec);
+    if (n >= 0)
+        buffer[n] = 0;
+    return n;
+}
+
+mtsSocketProxyAppendBuffer::int_type mtsSocketProxyAppendBuffer::overflow(int_type c)
+{
+    if (!Target)
+        return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+        Target->push_back(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+}
+
+std::streamsize mtsSocketProxyAppendBuffer::xsputn(const char * data, std::streamsize size)
+{
+    if (!Target)
+        return 0;
+    Target->append(data, static_cast<size_t>(size));
+    return size;
+}
+
+void mtsSocketProxyReadBuffer::SetSource(const char * data, size_t size)
+{
+    // The get area is never written to
+    char * begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+}
+
+bool mtsSocketProxyDeSerializer::DeSerialize(const char * data, size_t size, mtsGenericObject & object)
+{
+    Buffer.SetSource(data, size);
+    Stream.clear();
+    try {
+        object.DeSerializeRaw(Stream);
+    } catch (const std::runtime_error &e) {
+        object.SetValid(false);
+        CMN_LOG_RUN_ERROR << "mtsSocketProxyDeSerializer: deserialization failed: " << e.what() << std::endl;
+        return false;
+    }
+    if (Stream.fail()) {
+        object.SetValid(false);
+        CMN_LOG_RUN_ERROR << "mtsSocketProxyDeSerializer: not enough data to deserialize "
+                          << object.Services()->GetName() << ", size = " << size << std::endl;
+        return false;
+    }
+    return true;
+}
+
+mtsSocketProxySendBuffer::mtsSocketProxySendBuffer(size_t capacity) :
+    StreamBuffer(&Buffer),
+    Stream(&StreamBuffer),
+    Sequence(0)
+{
+    // Buffers are created along with the proxies, during initialization
+    static unsigned int numberOfBuffers = 0;
+    Sequence = (numberOfBuffers++) << 20;
+    Buffer.reserve(capacity);
+    Reset();
+}
+
+void mtsSocketProxySendBuffer::Reset(void)
+{
+    // resize doesn't release the capacity
+    Buffer.resize(mtsSocketProxy::SOCKET_PROXY_FRAGMENT_HEADER_SIZE);
+}
+
+bool mtsSocketProxySendBuffer::Serialize(const mtsGenericObject & object)
+{
+    const size_t previousSize = Buffer.size();
+    Stream.clear();
+    try {
+        object.SerializeRaw(Stream);
+    } catch (const std::runtime_error &e) {
+        CMN_LOG_RUN_ERROR << "mtsSocketProxySendBuffer: serialization failed: " << object.ToString() << std::endl;
+        CMN_LOG_RUN_ERROR << e.what() << std::endl;
+        Buffer.resize(previousSize);
+        return false;
+    }
+    return true;
+}
+
+int mtsSocketProxySendBuffer::Send(mtsSocketProxyChannel & channel, double timeoutSec)
+{
+    const unsigned int packetSize = channel.GetPacketSize();
+    const size_t headerSize = mtsSocketProxy::SOCKET_PROXY_FRAGMENT_HEADER_SIZE;
+    if ((packetSize <= headerSize) || (packetSize - headerSize > 0xFFFF)) {
+        CMN_LOG_RUN_ERROR << "mtsSocketProxySendBuffer: invalid packet size " << packetSize << std::endl;
+        return -1;
+    }
+    const size_t fragmentSize = packetSize - headerSize;
+    const size_t messageSize = GetSize();
+    const size_t numberOfFragments = (messageSize == 0) ? 1 : 1 + (messageSize - 1) / fragmentSize;
+    if (numberOfFragments > 0xFFFF) {
+        CMN_LOG_RUN_ERROR << "mtsSocketProxySendBuffer: message too large, size = " << messageSize << std::endl;
+        return -1;
+    }
+
+    Sequence++;
+    unsigned short header[3];
+    header[1] = static_cast<unsigned short>(numberOfFragments);
+    header[2] = static_cast<unsigned short>(fragmentSize);
+    char saved[mtsSocketProxy::SOCKET_PROXY_FRAGMENT_HEADER_SIZE];
+    int sent = 0;
+    for (size_t index = 0; index < numberOfFragments; index++) {
+        // Fragment header is written in front of the fragment payload, i.e. at the end of
+        // the previous fragment (or in the space reserved for the first one)
+        char * fragment = &Buffer[index * fragmentSize];
+        const size_t payloadSize = (index == numberOfFragments - 1) ? (messageSize - index * fragmentSize) : fragmentSize;
+        if (index > 0)
+            memcpy(saved, fragment, headerSize);
+        header[0] = static_cast<unsigned short>(index);
+        fragment[0] = mtsSocketProxy::SOCKET_PROXY_FRAGMENT_MARKER;
+        fragment[1] = 0;
+        memcpy(fragment + 2, header, sizeof(header));
+        memcpy(fragment + 8, &Sequence, sizeof(Sequence));
+        const int n = channel.Send(fragment, static_cast<unsigned int>(headerSize + payloadSize), timeoutSec);
+        if (index > 0)
+            memcpy(fragment, saved, headerSize);
+        if (n != static_cast<int>(headerSize + payloadSize)) {
+            CMN_LOG_RUN_ERROR << "mtsSocketProxySendBuffer: failed to send fragment " << index << " of "
+                              << numberOfFragments << std::endl;
+            return -1;
+        }
+        sent += n;
+    }
+    return sent;
+}
+
+mtsSocketProxyReceiveBuffer::mtsSocketProxyReceiveBuffer() :
+    Packet(mtsSocketProxy::SOCKET_PROXY_MAX_DATAGRAM_SIZE + 1),
+    Sequence(0),
+    NumberOfFragments(0),
+    FragmentSize(0),
+    FragmentsPending(0),
+    MessageSize(0),
+    Reassembling(false),
+    Data(0),
+    Size(0),
+    Framed(false),
+    MessagesDropped(0)
+{
+}
+
+int mtsSocketProxyReceiveBuffer::Receive(mtsSocketProxyChannel & channel, double timeoutStartSec, double timeoutNextSec)
+{
+    Data = 0;
+    Size = 0;
+    Framed = false;
+    double timeout = timeoutStartSec;
+    while (true) {
+        // Packet is one byte larger than needed since Receive null terminates
+        const int n = channel.Receive(&Packet[0], mtsSocketProxy::SOCKET_PROXY_MAX_DATAGRAM_SIZE, timeout);
+        if (n <= 0)
+            return n;
+        if (ProcessDatagram(channel, static_cast<size_t>(n)))
+            return static_cast<int>(Size);
+        timeout = timeoutNextSec;
+    }
+}
+
+bool mtsSocketProxyReceiveBuffer::ProcessDatagram(mtsSocketProxyChannel & channel, size_t length)
+{
+    const size_t headerSize = mtsSocketProxy::SOCKET_PROXY_FRAGMENT_HEADER_SIZE;
+    if ((length < headerSize) || (Packet[0] != mtsSocketProxy::SOCKET_PROXY_FRAGMENT_MARKER)) {
+        Data = &Packet[0];
+        Size = length;
+        Framed = false;
+        return true;
+    }
+
+    unsigned short header[3];
+    unsigned int sequence;
+    memcpy(header, &Packet[2], sizeof(header));
+    memcpy(&sequence, &Packet[8], sizeof(sequence));
+    const unsigned short index = header[0];
+    const unsigned short numberOfFragments = header[1];
+    const unsigned short fragmentSize = header[2];
+    const size_t payloadSize = length - headerSize;
+    if ((index >= numberOfFragments) || (payloadSize > fragmentSize)
+        || ((index < numberOfFragments - 1) && (payloadSize != fragmentSize))) {
+        CMN_LOG_RUN_ERROR << "mtsSocketProxyReceiveBuffer: invalid fragment " << index << " of "
+                          << numberOfFragments << ", size = " << payloadSize << std::endl;
+        return false;
+    }
+
+    // Most messages fit in one datagram, use it in place
+    if (numberOfFragments == 1) {
+        Data = &Packet[headerSize];
+        Size = payloadSize;
+        Framed = true;
+        return true;
+    }
+
+    osaIPandPort source;
+    channel.GetDestination(source);
+    if (Reassembling
+        && ((sequence != Sequence) || (source != Source)
+            || (numberOfFragments != NumberOfFragments) || (fragmentSize != FragmentSize))) {
+        CMN_LOG_RUN_WARNING << "mtsSocketProxyReceiveBuffer: dropping incomplete message " << Sequence
+                            << ", missing " << FragmentsPending << " of " << NumberOfFragments
+                            << " fragments" << std::endl;
+        MessagesDropped++;
+        Reassembling = false;
+    }
+    if (!Reassembling) {
+        Source = source;
+        Sequence = sequence;
+        NumberOfFragments = numberOfFragments;
+        FragmentSize = fragmentSize;
+        FragmentsPending = numberOfFragments;
+        MessageSize = 0;
+        const size_t capacity = static_cast<size_t>(numberOfFragments) * fragmentSize;
+        if (Message.size() < capacity)
+            Message.resize(capacity);
+        if (FragmentReceived.size() < numberOfFragments)
+            FragmentReceived.resize(numberOfFragments);
+        std::fill(FragmentReceived.begin(), FragmentReceived.begin() + numberOfFragments, 0);
+        Reassembling = true;
+    }
+    if (FragmentReceived[index])
+        return false;  // duplicate
+    FragmentReceived[index] = 1;
+    memcpy(&Message[static_cast<size_t>(index) * fragmentSize], &Packet[headerSize], payloadSize);
+    if (index == numberOfFragments - 1)
+        MessageSize = static_cast<size_t>(index) * fragmentSize + payloadSize;
+    FragmentsPending--;
+    if (FragmentsPending > 0)
+        return false;
+
+    Reassembling = false;
+    Data = &Message[0];
+    Size = MessageSize;
+    Framed = true;
+    return true;
+}
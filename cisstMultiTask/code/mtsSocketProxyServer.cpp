@@ -99,21 +99,20 @@ bool mtsSocketProxyServerConstructorArg::FromStreamRaw(std::istream & inputStrea
 //********************************* Event Senders (Void and Write) ******************************************
 //
 // These classes are used to send events to the clients that have registered observers. This class maintains
-// a list of clients (ClientInfo) which has the IP+port, event handle (from the client), and a pointer
-// to the serializer for that client (maintained by mtsSocketProxyServer). The AddClient and RemoveClient
-// methods are called by the mtsSocketProxyServer EventEnable and EventDisable methods, respectively.
+// a list of clients (ClientInfo) which has the IP+port and event handle (from the client). The AddClient
+// and RemoveClient methods are called by the mtsSocketProxyServer EventEnable and EventDisable methods,
+// respectively. Each event sender has its own buffer, reused for each event.
 
 class mtsEventSenderBase {
 protected:
-    osaSocket   &Socket;
+    mtsSocketProxyChannel &Channel;
+    mtsSocketProxySendBuffer Buffer;
 
     struct ClientInfo {
         osaIPandPort IP_Port;
         char Handle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-        mtsProxySerializer *Serializer;   // Only used by mtsEventSenderWrite
 
-        ClientInfo(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer) : IP_Port(ip_port),
-                                                                                                      Serializer(serializer)
+        ClientInfo(const osaIPandPort &ip_port, const char *handle) : IP_Port(ip_port)
         {
             memcpy(Handle, handle, sizeof(Handle));
         }
@@ -124,21 +123,21 @@ protected:
 
 public:
 
-    mtsEventSenderBase(osaSocket &socket) : Socket(socket) {}
+    mtsEventSenderBase(mtsSocketProxyChannel &channel) : Channel(channel) {}
     ~mtsEventSenderBase() {}
 
-    bool AddClient(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer);
+    bool AddClient(const osaIPandPort &ip_port, const char *handle);
     bool RemoveClient(const osaIPandPort &ip_port, const char *handle);
 };
 
-bool mtsEventSenderBase::AddClient(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer)
+bool mtsEventSenderBase::AddClient(const osaIPandPort &ip_port, const char *handle)
 {
     std::vector<ClientInfo>::iterator it;
     for (it = ClientList.begin(); it != ClientList.end(); it++) {
         if (it->IP_Port == ip_port)
             return false;
     }
-    ClientList.push_back(ClientInfo(ip_port, handle, serializer));
+    ClientList.push_back(ClientInfo(ip_port, handle));
     return true;
 }
 
@@ -157,50 +156,38 @@ bool mtsEventSenderBase::RemoveClient(const osaIPandPort &ip_port, const char *h
 
 class mtsEventSenderVoid : public mtsEventSenderBase {
 public:
-    mtsEventSenderVoid(osaSocket &socket) : mtsEventSenderBase(socket) {}
+    mtsEventSenderVoid(mtsSocketProxyChannel &channel) : mtsEventSenderBase(channel) {}
     ~mtsEventSenderVoid() {}
     void Method(void)
     {
         std::vector<ClientInfo>::const_iterator it;
         for (it = ClientList.begin(); it != ClientList.end(); it++) {
-            Socket.SetDestination(it->IP_Port);
-            Socket.Send(it->Handle, sizeof(it->Handle));
+            Buffer.Reset();
+            Buffer.Append(it->Handle, sizeof(it->Handle));
+            Channel.SetDestination(it->IP_Port);
+            Buffer.Send(Channel);
         }
     }
 };
 
 class mtsEventSenderWrite : public mtsEventSenderBase {
 public:
-    mtsEventSenderWrite(osaSocket &socket) : mtsEventSenderBase(socket) {}
+    mtsEventSenderWrite(mtsSocketProxyChannel &channel) : mtsEventSenderBase(channel) {}
     ~mtsEventSenderWrite() {}
     void Method(const mtsGenericObject &arg)
     {
-        std::string sendBuffer;
-        std::string sendBufferWithServices;
+        if (ClientList.empty())
+            return;
+        // Serialize the argument once, the handle of each client is then copied in front of it
+        Buffer.Reset();
+        Buffer.Append(ClientList[0].Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        if (!Buffer.Serialize(arg))
+            return;
         std::vector<ClientInfo>::const_iterator it;
         for (it = ClientList.begin(); it != ClientList.end(); it++) {
-            if (it->Serializer->ServicesSerialized(arg.Services())) {
-                if (sendBuffer.empty()) {
-                    if (it->Serializer->Serialize(arg, sendBuffer))
-                        sendBuffer.insert(0, it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                }
-                else
-                    sendBuffer.replace(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                       it->Handle,CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                Socket.SetDestination(it->IP_Port);
-                Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
-            }
-            else {
-                if (sendBufferWithServices.empty()) {
-                    if (it->Serializer->Serialize(arg, sendBufferWithServices))
-                        sendBufferWithServices.insert(0, it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                }
-                else
-                    sendBufferWithServices.replace(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                               it->Handle,CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                Socket.SetDestination(it->IP_Port);
-                Socket.SendAsPackets(sendBufferWithServices, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
-            }
+            memcpy(Buffer.GetData(), it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+            Channel.SetDestination(it->IP_Port);
+            Buffer.Send(Channel);
         }
     }
 };
@@ -214,21 +201,25 @@ public:
 // for the "finished event".  After the server dequeues and executes the command from the mailbox,
 // it calls the finished event proxy (this class), which then serializes the argument and passes it,
 // along with the RecvHandle, to the client via the socket.
+//
+// Commands received with the CommandHandle protocol (Framed) get a binary response (see
+// mtsSocketProxyServer::ProcessCommandHandle); the Serializer is only used for the CommandString protocol.
 
 class FinishedEventEntry {
-    osaSocket *Socket;
+    mtsSocketProxyChannel *Channel;
+    mtsSocketProxySendBuffer *SendBuffer;
     osaIPandPort IP_Port;
     char RecvHandle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
     mtsProxySerializer *Serializer;
+    bool Framed;
     bool Used;
 public:
-    FinishedEventEntry() : Socket(0), Serializer(0), Used(false) {}
-    FinishedEventEntry(osaSocket *socket, const osaIPandPort &ip_port, const std::string &recv_handle, mtsProxySerializer *serializer) :
-        Socket(socket), IP_Port(ip_port), Serializer(serializer), Used(true)
+    FinishedEventEntry() : Channel(0), SendBuffer(0), Serializer(0), Framed(false), Used(false) {}
+    FinishedEventEntry(mtsSocketProxyChannel *channel, mtsSocketProxySendBuffer *sendBuffer, const osaIPandPort &ip_port,
+                       const char *recv_handle, mtsProxySerializer *serializer, bool framed) :
+        Channel(channel), SendBuffer(sendBuffer), IP_Port(ip_port), Serializer(serializer), Framed(framed), Used(true)
     {
-        // Make sure recv_handle string is big enough (should be exactly COMMAND_HANDLE_STRING_SIZE)
-        CMN_ASSERT(recv_handle.size() >= sizeof(CommandHandle::COMMAND_HANDLE_STRING_SIZE));
-        memcpy(RecvHandle, recv_handle.data(), sizeof(RecvHandle));
+        memcpy(RecvHandle, recv_handle, sizeof(RecvHandle));
     }
     ~FinishedEventEntry() {}
 
@@ -251,8 +242,27 @@ bool FinishedEventEntry::SerializeFilter(const mtsGenericObject &arg, mtsGeneric
         CMN_LOG_RUN_ERROR << "FinishedEventEntry: output is not a string type, class = " << out.Services()->GetName() << std::endl;
         return false;
     }
-    if (!Serializer->Serialize(arg, argSerialized->GetData())) {
-        CMN_LOG_RUN_ERROR << "FinishedEventEntry: failed to serialize return value" << std::endl;
+    if (!Framed) {
+        if (!Serializer->Serialize(arg, argSerialized->GetData())) {
+            CMN_LOG_RUN_ERROR << "FinishedEventEntry: failed to serialize return value" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    // Response type followed by the argument serialized with SerializeRaw. This is called from the
+    // thread of the server component, so the proxy's send buffer can't be used.
+    std::string &output = argSerialized->GetData();
+    output.clear();
+    if (dynamic_cast<const mtsExecutionResultProxy *>(&arg))
+        output.push_back(mtsSocketProxy::SOCKET_PROXY_RESPONSE_RESULT);
+    else
+        output.push_back(mtsSocketProxy::SOCKET_PROXY_RESPONSE_ARGUMENT);
+    mtsSocketProxyAppendBuffer buffer(&output);
+    std::ostream stream(&buffer);
+    try {
+        arg.SerializeRaw(stream);
+    } catch (const std::runtime_error &e) {
+        CMN_LOG_RUN_ERROR << "FinishedEventEntry: failed to serialize return value: " << e.what() << std::endl;
         return false;
     }
     return true;
@@ -263,32 +273,45 @@ void FinishedEventEntry::Method(const mtsStdString &argSerialized)
     if (!Used) {
         CMN_LOG_RUN_WARNING << "FinishedEventEntry: attempt to execute unused entry" << std::endl;
     }
-    CMN_ASSERT(Socket);
-    CMN_ASSERT(Serializer);
-    std::string sendBuffer(RecvHandle, sizeof(RecvHandle));
-    sendBuffer.append(argSerialized.GetData());
-    Socket->SetDestination(IP_Port);
-    Socket->SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+    CMN_ASSERT(Channel);
+    if (Framed) {
+        CMN_ASSERT(SendBuffer);
+        SendBuffer->Reset();
+        SendBuffer->Append(RecvHandle, sizeof(RecvHandle));
+        SendBuffer->Append(argSerialized.GetData().data(), argSerialized.GetData().size());
+        Channel->SetDestination(IP_Port);
+        SendBuffer->Send(*Channel);
+    }
+    else {
+        CMN_ASSERT(Serializer);
+        std::string sendBuffer(RecvHandle, sizeof(RecvHandle));
+        sendBuffer.append(argSerialized.GetData());
+        Channel->SetDestination(IP_Port);
+        Channel->SendAsPackets(sendBuffer, 0.05);
+    }
     Used = false;
 }
 
 // The FinishedEventList is a pre-allocated list of FinishedEventEntry objects. This avoids
 // the need for a lot of dynamic memory allocation at runtime. This is a fixed-size list,
 // but that does not place any further restrictions on the system because there the number of
-// outstanding finished events is bounded by the server's mailbox size. Note that there still
-// is some dynamic memory allocation, since std::string objects are used.
+// outstanding finished events is bounded by the server's mailbox size. The responses are sent
+// using a single buffer, since the entries are executed by the server proxy's mailbox. Note that
+// std::string objects are used for the queued responses, they keep their capacity once the
+// largest response has been queued.
 
 class FinishedEventList {
     mtsMailBox *mailBox;
     size_t mailBoxSize;
     std::vector<FinishedEventEntry> List;
     std::vector<mtsCommandWriteBase *> Cmd;
+    mtsSocketProxySendBuffer SendBuffer;
 public:
     FinishedEventList(size_t size, mtsMailBox *mbox, size_t mbox_size);
     ~FinishedEventList();
 
-    mtsCommandWriteBase *AllocateEntry(osaSocket *socket, const osaIPandPort &ip_port,
-                                       const std::string &recv_handle, mtsProxySerializer *serializer);
+    mtsCommandWriteBase *AllocateEntry(mtsSocketProxyChannel *channel, const osaIPandPort &ip_port,
+                                       const char *recv_handle, mtsProxySerializer *serializer, bool framed);
 
     bool FreeEntry(mtsCommandWriteBase *cmd);
 };
@@ -318,12 +341,12 @@ FinishedEventList::~FinishedEventList()
     }
 }
 
-mtsCommandWriteBase *FinishedEventList::AllocateEntry(osaSocket *socket, const osaIPandPort &ip_port,
-                                                      const std::string &recv_handle, mtsProxySerializer *serializer)
+mtsCommandWriteBase *FinishedEventList::AllocateEntry(mtsSocketProxyChannel *channel, const osaIPandPort &ip_port,
+                                                      const char *recv_handle, mtsProxySerializer *serializer, bool framed)
 {
     for (size_t i = 0; i < List.size(); i++) {
         if (List[i].IsAvailable()) {
-            List[i] = FinishedEventEntry(socket, ip_port, recv_handle, serializer);
+            List[i] = FinishedEventEntry(channel, &SendBuffer, ip_port, recv_handle, serializer, framed);
             return Cmd[i];
         }
     }
@@ -347,9 +370,11 @@ bool FinishedEventList::FreeEntry(mtsCommandWriteBase *cmd)
 //************************************** Function Proxies *************************************************
 //
 // These are proxies for the mtsFunctionXXXX objects. Their input data comes from the socket, therefore
-// they have an ExecuteSerialized method that accepts an std::string for each parameter. Each of these
-// classes also keeps a pointer to the mtsSocketProxyServer, to enable it to obtain the Serializer associated
-// with the current client (since the server proxy can be associated with multiple client proxies).
+// they have an ExecuteSerialized method that accepts an std::string for each parameter (CommandString
+// protocol) and an ExecuteRaw method that deserializes the arguments in place and serializes the
+// result directly in the response buffer (CommandHandle protocol). Each of these classes also keeps a
+// pointer to the mtsSocketProxyServer, to enable it to obtain the Serializer associated with the current
+// client (since the server proxy can be associated with multiple client proxies) or the DeSerializer.
 
 class FunctionVoidProxy : public mtsFunctionVoid {
 protected:
@@ -386,6 +411,9 @@ public:
     void InitObjects(void);
 
     mtsExecutionResult ExecuteSerialized(const std::string &inputArgSerialized, mtsBlockingType blocking, mtsCommandWriteBase *eventSenderCommand);
+
+    mtsExecutionResult ExecuteRaw(const char *inputArg, size_t inputArgSize, mtsBlockingType blocking,
+                                  mtsCommandWriteBase *eventSenderCommand);
 };
 
 FunctionWriteProxy::FunctionWriteProxy(mtsSocketProxyServer *proxy, const std::string &argumentPrototypeSerialized)
@@ -440,6 +468,28 @@ mtsExecutionResult FunctionWriteProxy::ExecuteSerialized(const std::string &inpu
     return ret;
 }
 
+mtsExecutionResult FunctionWriteProxy::ExecuteRaw(const char *inputArg, size_t inputArgSize, mtsBlockingType blocking,
+                                                  mtsCommandWriteBase *eventSenderCommand)
+{
+    CMN_ASSERT(Proxy);
+    mtsExecutionResult ret(mtsExecutionResult::ARGUMENT_DYNAMIC_CREATION_FAILED);
+    InitObjects();
+    if (!arg) {
+        CMN_LOG_INIT_WARNING << "FunctionWriteProxy: could not deserialize argument prototype" << std::endl;
+    }
+    if (arg) {
+        if (Proxy->GetDeSerializer().DeSerialize(inputArg, inputArgSize, *arg)) {
+            if (blocking == MTS_BLOCKING)
+                ret = GetCommand()->Execute(*arg, blocking, eventSenderCommand);
+            else
+                ret = Execute(*arg);
+        }
+        else
+            ret = mtsExecutionResult::DESERIALIZATION_ERROR;
+    }
+    return ret;
+}
+
 class FunctionReadProxy : public mtsFunctionRead {
 protected:
     mtsSocketProxyServer *Proxy;
@@ -454,6 +504,7 @@ public:
 
     mtsExecutionResult ExecuteSerialized(std::string &resultArgSerialized, mtsCommandWriteBase *eventSenderCommand);
 
+    mtsExecutionResult ExecuteRaw(mtsSocketProxySendBuffer &result, mtsCommandWriteBase *eventSenderCommand);
 };
 
 FunctionReadProxy::FunctionReadProxy(mtsSocketProxyServer *proxy, const std::string &argumentPrototypeSerialized)
@@ -503,6 +554,23 @@ mtsExecutionResult FunctionReadProxy::ExecuteSerialized(std::string &resultArgSe
     return ret;
 }
 
+mtsExecutionResult FunctionReadProxy::ExecuteRaw(mtsSocketProxySendBuffer &result, mtsCommandWriteBase *eventSenderCommand)
+{
+    CMN_ASSERT(Proxy);
+    mtsExecutionResult ret(mtsExecutionResult::ARGUMENT_DYNAMIC_CREATION_FAILED);
+    InitObjects();
+    if (arg) {
+        ret = GetCommand()->Execute(*arg, eventSenderCommand);
+        if (ret.GetResult() == mtsExecutionResult::COMMAND_SUCCEEDED) {
+            if (!result.Serialize(*arg))
+                ret = mtsExecutionResult::SERIALIZATION_ERROR;
+        }
+    }
+    else
+        CMN_LOG_INIT_WARNING << "FunctionReadProxy: could not deserialize argument prototype" << std::endl;
+    return ret;
+}
+
 
 class FunctionQualifiedReadProxy : public mtsFunctionQualifiedRead {
 protected:
@@ -521,6 +589,9 @@ public:
 
     mtsExecutionResult ExecuteSerialized(const std::string &inputArgSerialized, std::string &resultArgSerialized,
                                          mtsCommandWriteBase *eventSenderCommand);
+
+    mtsExecutionResult ExecuteRaw(const char *inputArg, size_t inputArgSize, mtsSocketProxySendBuffer &result,
+                                  mtsCommandWriteBase *eventSenderCommand);
 };
 
 FunctionQualifiedReadProxy::FunctionQualifiedReadProxy(mtsSocketProxyServer *proxy, const std::string &arg1PrototypeSerialized,
@@ -595,6 +666,29 @@ mtsExecutionResult FunctionQualifiedReadProxy::ExecuteSerialized(const std::stri
     return ret;
 }
 
+mtsExecutionResult FunctionQualifiedReadProxy::ExecuteRaw(const char *inputArg, size_t inputArgSize,
+                                                          mtsSocketProxySendBuffer &result,
+                                                          mtsCommandWriteBase *eventSenderCommand)
+{
+    CMN_ASSERT(Proxy);
+    mtsExecutionResult ret(mtsExecutionResult::ARGUMENT_DYNAMIC_CREATION_FAILED);
+    InitObjects();
+    if (arg1 && arg2) {
+        if (Proxy->GetDeSerializer().DeSerialize(inputArg, inputArgSize, *arg1)) {
+            ret = GetCommand()->Execute(*arg1, *arg2, eventSenderCommand);
+            if (ret.GetResult() == mtsExecutionResult::COMMAND_SUCCEEDED) {
+                if (!result.Serialize(*arg2))
+                    ret = mtsExecutionResult::SERIALIZATION_ERROR;
+            }
+        }
+        else
+            ret = mtsExecutionResult::DESERIALIZATION_ERROR;
+    }
+    else
+        CMN_LOG_INIT_WARNING << "FunctionQualifiedReadProxy: could not deserialize argument prototypes" << std::endl;
+    return ret;
+}
+
 
 class FunctionVoidReturnProxy : public mtsFunctionVoidReturn {
     mtsSocketProxyServer *Proxy;
@@ -663,6 +757,7 @@ public:
 
     void InitObjects(void);
     mtsExecutionResult ExecuteSerialized(const std::string &inputArgSerialized, mtsCommandWriteBase *eventSenderCommand);
+    mtsExecutionResult ExecuteRaw(const char *inputArg, size_t inputArgSize, mtsCommandWriteBase *eventSenderCommand);
 };
 
 FunctionWriteReturnProxy::FunctionWriteReturnProxy(mtsSocketProxyServer *proxy,
@@ -729,6 +824,23 @@ mtsExecutionResult FunctionWriteReturnProxy::ExecuteSerialized(const std::string
     return ret;
 }
 
+mtsExecutionResult FunctionWriteReturnProxy::ExecuteRaw(const char *inputArg, size_t inputArgSize,
+                                                        mtsCommandWriteBase *eventSenderCommand)
+{
+    CMN_ASSERT(Proxy);
+    mtsExecutionResult ret(mtsExecutionResult::ARGUMENT_DYNAMIC_CREATION_FAILED);
+    InitObjects();
+    if (arg && retVal) {
+        if (Proxy->GetDeSerializer().DeSerialize(inputArg, inputArgSize, *arg))
+            ret = GetCommand()->Execute(*arg, *retVal, eventSenderCommand);
+        else
+            ret = mtsExecutionResult::DESERIALIZATION_ERROR;
+    }
+    else
+        CMN_LOG_INIT_WARNING << "FunctionWriteReturnProxy: could not deserialize argument prototypes" << std::endl;
+    return ret;
+}
+
 
 //**************************************** mtsSocketProxyServer ***********************************************
 //
@@ -737,7 +849,31 @@ mtsExecutionResult FunctionWriteReturnProxy::ExecuteSerialized(const std::string
 mtsSocketProxyServer::mtsSocketProxyServer(const std::string & proxyName, const std::string & componentName,
                                            const std::string & providedInterfaceName, unsigned short port) :
     mtsTaskContinuous(proxyName),
-    Socket(osaSocket::UDP),
+    Channel(0),
+    FunctionVoidProxyMap("FunctionVoidProxyMap"),
+    FunctionWriteProxyMap("FunctionWriteProxyMap"),
+    FunctionReadProxyMap("FunctionReadProxyMap"),
+    FunctionQualifiedReadProxyMap("FunctionQualifiedReadProxyMap"),
+    FunctionVoidReturnProxyMap("FunctionVoidReturnProxyMap"),
+    FunctionWriteReturnProxyMap("FunctionWriteReturnProxyMap"),
+    EventGeneratorVoidProxyMap("EventGeneratorVoidProxyMap"),
+    EventGeneratorWriteProxyMap("EventGeneratorWriteProxyMap"),
+    FinishedEvents(0)
+{
+    // Channel must exist before Init creates the event senders
+    mtsSocketProxyChannelUDP *channel = new mtsSocketProxyChannelUDP;
+    channel->AssignPort(port);
+    Channel = channel;
+    if (Init(componentName, providedInterfaceName)) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "Created required interface in " << proxyName << std::endl;
+    }
+}
+
+mtsSocketProxyServer::mtsSocketProxyServer(const std::string & proxyName, const std::string & componentName,
+                                           const std::string & providedInterfaceName,
+                                           const std::string & sharedMemoryName) :
+    mtsTaskContinuous(proxyName),
+    Channel(0),
     FunctionVoidProxyMap("FunctionVoidProxyMap"),
     FunctionWriteProxyMap("FunctionWriteProxyMap"),
     FunctionReadProxyMap("FunctionReadProxyMap"),
@@ -748,15 +884,19 @@ mtsSocketProxyServer::mtsSocketProxyServer(const std::string & proxyName, const
     EventGeneratorWriteProxyMap("EventGeneratorWriteProxyMap"),
     FinishedEvents(0)
 {
+    mtsSocketProxyChannelSharedMemory *channel = new mtsSocketProxyChannelSharedMemory;
+    if (!channel->Create(sharedMemoryName)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Failed to create shared memory channel " << sharedMemoryName << std::endl;
+    }
+    Channel = channel;
     if (Init(componentName, providedInterfaceName)) {
         CMN_LOG_CLASS_INIT_VERBOSE << "Created required interface in " << proxyName << std::endl;
     }
-    Socket.AssignPort(port);
 }
 
 mtsSocketProxyServer::mtsSocketProxyServer(const mtsSocketProxyServerConstructorArg &arg) :
     mtsTaskContinuous(arg.Name),
-    Socket(osaSocket::UDP),
+    Channel(0),
     FunctionVoidProxyMap("FunctionVoidProxyMap"),
     FunctionWriteProxyMap("FunctionWriteProxyMap"),
     FunctionReadProxyMap("FunctionReadProxyMap"),
@@ -767,10 +907,12 @@ mtsSocketProxyServer::mtsSocketProxyServer(const mtsSocketProxyServerConstructor
     EventGeneratorWriteProxyMap("EventGeneratorWriteProxyMap"),
     FinishedEvents(0)
 {
+    mtsSocketProxyChannelUDP *channel = new mtsSocketProxyChannelUDP;
+    channel->AssignPort(arg.Port);
+    Channel = channel;
     if (Init(arg.ComponentName, arg.ProvidedInterfaceName)) {
         CMN_LOG_CLASS_INIT_VERBOSE << "Created required interface in " << arg.Name << std::endl;
     }
-    Socket.AssignPort(arg.Port);
 }
 
 mtsSocketProxyServer::~mtsSocketProxyServer()
@@ -794,6 +936,7 @@ mtsSocketProxyServer::~mtsSocketProxyServer()
         delete SpecialCommands[i];
 
     delete FinishedEvents;
+    delete Channel;
 }
 
 void mtsSocketProxyServer::Startup(void)
@@ -805,16 +948,15 @@ void mtsSocketProxyServer::Run(void)
     ProcessQueuedCommands();
     ProcessQueuedEvents();
 
-    std::string inputArgString;
-    char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
-    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), 0.001, 0.1);
+    int bytesRead = ReceiveBuffer.Receive(*Channel, 0.001, 0.1);
     if (bytesRead > 0) {
 
-        // Process the input string. The code currently supports two protocols, which
-        // are distinguished by looking at the first byte. If it is a space, then
-        // we are using a CommandHandle (#1 below); otherwise, we are using a
-        // CommandString (#2 below). The CommandHandle protocol is more run-time
-        // efficient because there is no string lookup.
+        // Process the input message. The code currently supports two protocols, which
+        // are distinguished by the framing of the message. Messages sent by mtsSocketProxyClient
+        // are framed (see mtsSocketProxySendBuffer) and use a CommandHandle (#1 below); unframed
+        // messages use a CommandString (#2 below). The CommandHandle protocol is more run-time
+        // efficient because there is no string lookup and the arguments are serialized in binary
+        // (SerializeRaw), without the class services.
         //
         // 1) CommandHandle protocol: The first 10 bytes are the CommandHandle, where
         //    the first byte is a space, the second byte is a character that designates
@@ -835,270 +977,304 @@ void mtsSocketProxyServer::Run(void)
         //    it does not provide a proper return value. This can be fixed by passing a symbolic
         //    name (string) for the return value; the server proxy can then send a message (event)
         //    that is identified by this symbolic name.
-        //
-        // There is currently only one protocol for the response packet. It begins with the
-        // EventReceiverHandle (which is an empty string for the CommandString protocol), followed by
-        // the serialized serialized return value (for read, qualified read, void return, write return)
-        // or by the serialized mtsExecutionResult (for blocking void and write).
 
-        mtsExecutionResult ret;
-        std::string        RecvHandle;
-        std::string        outputArgString;
+        if (ReceiveBuffer.IsFramed())
+            ProcessCommandHandle(ReceiveBuffer.GetData(), ReceiveBuffer.GetSize());
+        else if (ReceiveBuffer.GetData()[0] == ' ') {
+            CMN_LOG_CLASS_RUN_ERROR << "Received command handle without framing, client uses a protocol version older than "
+                                    << mtsSocketProxy::SOCKET_PROXY_VERSION << std::endl;
+        }
+        else
+            ProcessCommandString(std::string(ReceiveBuffer.GetData(), ReceiveBuffer.GetSize()));
+    }
+}
 
-        osaIPandPort ip_port;
-        Socket.GetDestination(ip_port);
-        mtsProxySerializer *serializer = GetSerializerForClient(ip_port);
-        // Most commands are blocking
-        bool isBlocking = true;
-        // Event sender command
-        mtsCommandWriteBase *eventSenderCommand = 0;
-
-        size_t pos = inputArgString.find(' ');
-        if ((pos == 0) && (inputArgString.size() >= 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
-            CommandHandle handle(inputArgString);
-            RecvHandle = inputArgString.substr(CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                               CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            inputArgString.erase(0, 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            // Since we know the command type (handle.cmdType) we could reinterpret_cast directly to
-            // the correct mtsFunctionXXXX type, but to be safe we first reinterpret_cast to the base
-            // type, mtsFunctionBase, and then do a dynamic_cast to the expected type. If the address
-            // (handle.addr) is corrupted, this would lead to either a dynamic_cast failure (i.e.,
-            // a null pointer) or possibly a runtime exception.
-            mtsFunctionBase *functionBase = reinterpret_cast<mtsFunctionBase *>(handle.addr);
-            try {
-                FunctionVoidProxy *functionVoid;
-                FunctionReadProxy *functionReadProxy;
-                FunctionWriteProxy *functionWriteProxy;
-                FunctionQualifiedReadProxy *functionQualifiedReadProxy;
-				FunctionVoidReturnProxy *functionVoidReturnProxy;
-				FunctionWriteReturnProxy *functionWriteReturnProxy;
-                switch (handle.cmdType) {
-                  case 'I':
-                      ret = GetInitData(outputArgString, serializer);
-                      break;
-                  case 'V':
-                      isBlocking = false;
-                      functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
-                      if (functionVoid)
-                          ret = functionVoid->ExecuteSerialized(MTS_NOT_BLOCKING, 0);
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'v':   // blocking
-                      functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
-                      if (functionVoid) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionVoid->ExecuteSerialized(MTS_BLOCKING, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy(blocking) dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'R':
-                      functionReadProxy = dynamic_cast<FunctionReadProxy *>(functionBase);
-                      if (functionReadProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionReadProxy->ExecuteSerialized(outputArgString, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionReadProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'W':
-                      isBlocking = false;
-                      functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
-                      if (functionWriteProxy)
-                          ret = functionWriteProxy->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'w':   // blocking
-                      functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
-                      if (functionWriteProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionWriteProxy->ExecuteSerialized(inputArgString, MTS_BLOCKING, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'Q':
-                      functionQualifiedReadProxy = dynamic_cast<FunctionQualifiedReadProxy *>(functionBase);
-                      if (functionQualifiedReadProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionQualifiedReadProxy->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionQualifiedReadProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'r':
-                      functionVoidReturnProxy = dynamic_cast<FunctionVoidReturnProxy *>(functionBase);
-                      if (functionVoidReturnProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionVoidReturnProxy->ExecuteSerialized(eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidReturnProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'q':
-                      functionWriteReturnProxy = dynamic_cast<FunctionWriteReturnProxy *>(functionBase);
-                      if (functionWriteReturnProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionWriteReturnProxy->ExecuteSerialized(inputArgString, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteReturnProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                default:
-                    CMN_LOG_CLASS_RUN_ERROR << "Invalid command type: " << handle.cmdType << std::endl;
-                }
-            }
-            catch (const std::runtime_error &e) {
-                CMN_LOG_CLASS_RUN_ERROR << "Exception while using command handle for type " << handle.cmdType
-                                        << ", addr = " << std::hex << handle.addr << ": " << e.what() << std::endl;
-                ret = mtsExecutionResult::INVALID_COMMAND_ID;
-            }
-            if (!ret.IsOK()) {
-                CMN_LOG_CLASS_RUN_WARNING << "Command type: " << handle.cmdType << ", result = " << ret << std::endl;
+void mtsSocketProxyServer::ProcessCommandHandle(const char *data, size_t size)
+{
+    // The response begins with the EventReceiverHandle, followed by the response type and either
+    // the serialized return value (for read, qualified read, void return, write return), or
+    // the serialized mtsExecutionResult (for blocking void and write, or if the command failed).
+    // The return value is serialized directly in SendBuffer by the function proxies.
+    if ((size < 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE) || (data[0] != ' ')) {
+        CMN_LOG_CLASS_RUN_ERROR << "ProcessCommandHandle: invalid message, size = " << size << std::endl;
+        return;
+    }
+    CommandHandle handle(data);
+    const char *recvHandle = data + CommandHandle::COMMAND_HANDLE_STRING_SIZE;
+    const char *inputArg = data + 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE;
+    const size_t inputArgSize = size - 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE;
+
+    SendBuffer.Reset();
+    SendBuffer.Append(recvHandle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+    SendBuffer.Append(mtsSocketProxy::SOCKET_PROXY_RESPONSE_ARGUMENT);
+    const size_t responseHeaderSize = SendBuffer.GetSize();
+
+    mtsExecutionResult ret;
+    // Most commands are blocking
+    bool isBlocking = true;
+    // Event sender command
+    mtsCommandWriteBase *eventSenderCommand = 0;
+
+    // Since we know the command type (handle.cmdType) we could reinterpret_cast directly to
+    // the correct mtsFunctionXXXX type, but to be safe we first reinterpret_cast to the base
+    // type, mtsFunctionBase, and then do a dynamic_cast to the expected type. If the address
+    // (handle.addr) is corrupted, this would lead to either a dynamic_cast failure (i.e.,
+    // a null pointer) or possibly a runtime exception.
+    mtsFunctionBase *functionBase = reinterpret_cast<mtsFunctionBase *>(handle.addr);
+    try {
+        FunctionVoidProxy *functionVoid;
+        FunctionReadProxy *functionReadProxy;
+        FunctionWriteProxy *functionWriteProxy;
+        FunctionQualifiedReadProxy *functionQualifiedReadProxy;
+        FunctionVoidReturnProxy *functionVoidReturnProxy;
+        FunctionWriteReturnProxy *functionWriteReturnProxy;
+        switch (handle.cmdType) {
+          case 'I':
+              ret = GetInitData(SendBuffer);
+              break;
+          case 'V':
+              isBlocking = false;
+              functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
+              if (functionVoid)
+                  ret = functionVoid->ExecuteSerialized(MTS_NOT_BLOCKING, 0);
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'v':   // blocking
+              functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
+              if (functionVoid) {
+                  eventSenderCommand = AllocateFinishedEvent(recvHandle, true);
+                  if (eventSenderCommand)
+                      ret = functionVoid->ExecuteSerialized(MTS_BLOCKING, eventSenderCommand);
+                  else
+                      ret = mtsExecutionResult::NO_FINISHED_EVENT;
+              }
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy(blocking) dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'R':
+              functionReadProxy = dynamic_cast<FunctionReadProxy *>(functionBase);
+              if (functionReadProxy) {
+                  eventSenderCommand = AllocateFinishedEvent(recvHandle, true);
+                  if (eventSenderCommand)
+                      ret = functionReadProxy->ExecuteRaw(SendBuffer, eventSenderCommand);
+                  else
+                      ret = mtsExecutionResult::NO_FINISHED_EVENT;
+              }
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionReadProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'W':
+              isBlocking = false;
+              functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
+              if (functionWriteProxy)
+                  ret = functionWriteProxy->ExecuteRaw(inputArg, inputArgSize, MTS_NOT_BLOCKING, 0);
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'w':   // blocking
+              functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
+              if (functionWriteProxy) {
+                  eventSenderCommand = AllocateFinishedEvent(recvHandle, true);
+                  if (eventSenderCommand)
+                      ret = functionWriteProxy->ExecuteRaw(inputArg, inputArgSize, MTS_BLOCKING, eventSenderCommand);
+                  else
+                      ret = mtsExecutionResult::NO_FINISHED_EVENT;
+              }
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'Q':
+              functionQualifiedReadProxy = dynamic_cast<FunctionQualifiedReadProxy *>(functionBase);
+              if (functionQualifiedReadProxy) {
+                  eventSenderCommand = AllocateFinishedEvent(recvHandle, true);
+                  if (eventSenderCommand)
+                      ret = functionQualifiedReadProxy->ExecuteRaw(inputArg, inputArgSize, SendBuffer, eventSenderCommand);
+                  else
+                      ret = mtsExecutionResult::NO_FINISHED_EVENT;
+              }
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionQualifiedReadProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'r':
+              functionVoidReturnProxy = dynamic_cast<FunctionVoidReturnProxy *>(functionBase);
+              if (functionVoidReturnProxy) {
+                  eventSenderCommand = AllocateFinishedEvent(recvHandle, true);
+                  if (eventSenderCommand)
+                      ret = functionVoidReturnProxy->ExecuteSerialized(eventSenderCommand);
+                  else
+                      ret = mtsExecutionResult::NO_FINISHED_EVENT;
+              }
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidReturnProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+          case 'q':
+              functionWriteReturnProxy = dynamic_cast<FunctionWriteReturnProxy *>(functionBase);
+              if (functionWriteReturnProxy) {
+                  eventSenderCommand = AllocateFinishedEvent(recvHandle, true);
+                  if (eventSenderCommand)
+                      ret = functionWriteReturnProxy->ExecuteRaw(inputArg, inputArgSize, eventSenderCommand);
+                  else
+                      ret = mtsExecutionResult::NO_FINISHED_EVENT;
+              }
+              else {
+                  CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteReturnProxy dynamic cast failed" << std::endl;
+                  ret = mtsExecutionResult::INVALID_COMMAND_ID;
+              }
+              break;
+        default:
+            CMN_LOG_CLASS_RUN_ERROR << "Invalid command type: " << handle.cmdType << std::endl;
+        }
+    }
+    catch (const std::runtime_error &e) {
+        CMN_LOG_CLASS_RUN_ERROR << "Exception while using command handle for type " << handle.cmdType
+                                << ", addr = " << std::hex << handle.addr << ": " << e.what() << std::endl;
+        ret = mtsExecutionResult::INVALID_COMMAND_ID;
+    }
+    if (!ret.IsOK()) {
+        CMN_LOG_CLASS_RUN_WARNING << "Command type: " << handle.cmdType << ", result = " << ret << std::endl;
+    }
+
+    // If this was a blocking command, but was not queued, we need to send a response now.  If it was
+    // queued, we can rely on mtsMailBox::ExeuteNext to send the response via an event.
+    if (isBlocking && (ret.Value() != mtsExecutionResult::COMMAND_QUEUED)) {
+        // If the command failed or did not return a value, send the execution result instead
+        if (ret.Value() != mtsExecutionResult::COMMAND_SUCCEEDED) {
+            CMN_LOG_CLASS_RUN_WARNING << "Returning failed execution result: "
+                                      << mtsExecutionResult::ToString(ret.Value()) << std::endl;
+        }
+        if ((ret.Value() != mtsExecutionResult::COMMAND_SUCCEEDED) || (SendBuffer.GetSize() == responseHeaderSize)) {
+            SendBuffer.Reset();
+            SendBuffer.Append(recvHandle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+            SendBuffer.Append(mtsSocketProxy::SOCKET_PROXY_RESPONSE_RESULT);
+            if (!SendBuffer.Serialize(mtsExecutionResultProxy(ret))) {
+                CMN_LOG_CLASS_RUN_ERROR << "Failed to serialize execution result for blocking command" << std::endl;
             }
         }
+        // We won't be using the eventSender, so free it
+        if (eventSenderCommand)
+            FinishedEvents->FreeEntry(eventSenderCommand);
+        SendBuffer.Send(*Channel, 0.1);
+    }
+}
+
+void mtsSocketProxyServer::ProcessCommandString(const std::string &message)
+{
+    mtsExecutionResult ret;
+    // There is no EventReceiverHandle with this protocol
+    const char blankHandle[CommandHandle::COMMAND_HANDLE_STRING_SIZE+1] = "          ";
+    std::string inputArgString(message);
+    std::string outputArgString;
+
+    mtsProxySerializer *serializer = GetSerializerForCurrentClient();
+    // Event sender command
+    mtsCommandWriteBase *eventSenderCommand = 0;
+
+    std::string commandName;
+    size_t pos = inputArgString.find(' ');
+    if (pos != std::string::npos) {
+        commandName = inputArgString.substr(0, pos);
+        inputArgString.erase(0, pos+1);
+    }
+    else {
+        commandName = inputArgString;
+        inputArgString.clear();
+    }
+
+    if (commandName == "GetInitData")
+        ret = GetInitData(outputArgString, serializer);
+    else if (inputArgString.empty()) {
+        // Void, Read, or VoidReturn
+        FunctionVoidProxy *functionVoid = FunctionVoidProxyMap.GetItem(commandName);
+        if (functionVoid)
+            ret = functionVoid->Execute();
         else {
-            // PK TODO: RecvHandle is not handled
-            std::string commandName;
-            if (pos != std::string::npos) {
-                commandName = inputArgString.substr(0, pos);
-                inputArgString.erase(0, pos+1);
+            FunctionReadProxy *functionRead = FunctionReadProxyMap.GetItem(commandName);
+            if (functionRead) {
+                eventSenderCommand = AllocateFinishedEvent(blankHandle, false);
+                if (eventSenderCommand)
+                    ret = functionRead->ExecuteSerialized(outputArgString, eventSenderCommand);
+                else
+                    ret = mtsExecutionResult::NO_FINISHED_EVENT;
             }
             else {
-                commandName = inputArgString;
-                inputArgString.clear();
-            }
-
-            if (commandName == "GetInitData")
-                ret = GetInitData(outputArgString, serializer);
-            else if (inputArgString.empty()) {
-                // Void, Read, or VoidReturn
-                FunctionVoidProxy *functionVoid = FunctionVoidProxyMap.GetItem(commandName);
-                if (functionVoid)
-                    ret = functionVoid->Execute();
-                else {
-                    FunctionReadProxy *functionRead = FunctionReadProxyMap.GetItem(commandName);
-                    if (functionRead) {
-                        eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                        if (eventSenderCommand)
-                            ret = functionRead->ExecuteSerialized(outputArgString, eventSenderCommand);
-                        else
-                            ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                    }
-                    else {
-                        FunctionVoidReturnProxy *functionVoidReturn = FunctionVoidReturnProxyMap.GetItem(commandName);
-                        if (functionVoidReturn) {
-                            eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                            if (eventSenderCommand)
-                                ret = functionVoidReturn->ExecuteSerialized(eventSenderCommand);
-                            else
-                                ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                        }
-                    }
+                FunctionVoidReturnProxy *functionVoidReturn = FunctionVoidReturnProxyMap.GetItem(commandName);
+                if (functionVoidReturn) {
+                    eventSenderCommand = AllocateFinishedEvent(blankHandle, false);
+                    if (eventSenderCommand)
+                        ret = functionVoidReturn->ExecuteSerialized(eventSenderCommand);
+                    else
+                        ret = mtsExecutionResult::NO_FINISHED_EVENT;
                 }
             }
+        }
+    }
+    else {
+        // Write, QualifiedRead, or WriteReturn
+        FunctionWriteProxy *functionWrite = FunctionWriteProxyMap.GetItem(commandName);
+        if (functionWrite)
+            ret = functionWrite->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
+        else {
+            FunctionQualifiedReadProxy *functionQualifiedRead = FunctionQualifiedReadProxyMap.GetItem(commandName);
+            if (functionQualifiedRead) {
+                eventSenderCommand = AllocateFinishedEvent(blankHandle, false);
+                if (eventSenderCommand)
+                    ret = functionQualifiedRead->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
+                else
+                    ret = mtsExecutionResult::NO_FINISHED_EVENT;
+            }
             else {
-                // Write, QualifiedRead, or WriteReturn
-                FunctionWriteProxy *functionWrite = FunctionWriteProxyMap.GetItem(commandName);
-                if (functionWrite)
-                    ret = functionWrite->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
-                else {
-                    FunctionQualifiedReadProxy *functionQualifiedRead = FunctionQualifiedReadProxyMap.GetItem(commandName);
-                    if (functionQualifiedRead) {
-                        eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                        if (eventSenderCommand)
-                            ret = functionQualifiedRead->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
-                        else
-                            ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                    }
-                    else {
-                        FunctionWriteReturnProxy *functionWriteReturn = FunctionWriteReturnProxyMap.GetItem(commandName);
-                        if (functionWriteReturn) {
-                            eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                            if (eventSenderCommand)
-                                ret = functionWriteReturn->ExecuteSerialized(inputArgString, eventSenderCommand);
-                            else
-                                ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                        }
-                    }
+                FunctionWriteReturnProxy *functionWriteReturn = FunctionWriteReturnProxyMap.GetItem(commandName);
+                if (functionWriteReturn) {
+                    eventSenderCommand = AllocateFinishedEvent(blankHandle, false);
+                    if (eventSenderCommand)
+                        ret = functionWriteReturn->ExecuteSerialized(inputArgString, eventSenderCommand);
+                    else
+                        ret = mtsExecutionResult::NO_FINISHED_EVENT;
                 }
             }
-            if (!ret.IsOK()) {
-                CMN_LOG_CLASS_RUN_WARNING << "Command: " << commandName << ", result = " << ret << std::endl;
-            }
         }
+    }
+    if (!ret.IsOK()) {
+        CMN_LOG_CLASS_RUN_WARNING << "Command: " << commandName << ", result = " << ret << std::endl;
+    }
 
-        // If this was a blocking command, but was not queued, we need to send a response now.  If it was
-        // queued, we can rely on mtsMailBox::ExeuteNext to send the response via an event.
-        if (isBlocking && (ret.Value() != mtsExecutionResult::COMMAND_QUEUED)) {
-            // If the command failed, send the execution result instead
-            if (ret.Value() != mtsExecutionResult::COMMAND_SUCCEEDED) {
-                outputArgString.clear();
-                CMN_LOG_CLASS_RUN_WARNING << "Returning failed execution result: "
-                                          << mtsExecutionResult::ToString(ret.Value()) << std::endl;
+    // Send a response now unless the command was queued (see ProcessCommandHandle)
+    if (ret.Value() != mtsExecutionResult::COMMAND_QUEUED) {
+        if (ret.Value() != mtsExecutionResult::COMMAND_SUCCEEDED)
+            outputArgString.clear();
+        if (outputArgString.empty()) {
+            if (!serializer->Serialize(mtsExecutionResultProxy(ret), outputArgString)) {
+                CMN_LOG_CLASS_RUN_ERROR << "Failed to serialize execution result for blocking command" << std::endl;
             }
-            if (outputArgString.empty()) {
-                if (!serializer->Serialize(mtsExecutionResultProxy(ret), outputArgString)) {
-                    CMN_LOG_CLASS_RUN_ERROR << "Failed to serialize execution result for blocking command" << std::endl;
-                }
-            }
-            // We won't be using the eventSender, so free it
-            if (eventSenderCommand)
-                FinishedEvents->FreeEntry(eventSenderCommand);
-            // Send a reply to the caller with the following format:
-            //    RecvHandle | outputString
-            outputArgString.insert(0, RecvHandle);
-
-            size_t nBytes = outputArgString.size();
-            // If the packet size is an exact multiple of SOCKET_PROXY_PACKET_SIZE (nBytes == 0), then we
-            // send an extra byte so that the receiver does not have to rely on a timeout to figure out
-            // when a packet stream is finished.
-            if ((nBytes%mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE) == 0)
-                outputArgString.append(" ");
-            Socket.SendAsPackets(outputArgString, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.1);
         }
+        if (eventSenderCommand)
+            FinishedEvents->FreeEntry(eventSenderCommand);
+        // If the packet size is an exact multiple of the channel packet size, then we send an extra byte
+        // so that the receiver does not have to rely on a timeout to figure out when a packet stream is finished.
+        if ((outputArgString.size()%Channel->GetPacketSize()) == 0)
+            outputArgString.append(" ");
+        Channel->SendAsPackets(outputArgString, 0.1);
     }
 }
 
 void mtsSocketProxyServer::Cleanup(void)
 {
-    Socket.Close();
+    Channel->Close();
 }
 
 bool mtsSocketProxyServer::Init(const std::string &componentName, const std::string &providedInterfaceName)
@@ -1245,7 +1421,7 @@ bool mtsSocketProxyServer::CreateServerProxy(const std::string & requiredInterfa
     for (i = 0; i < InterfaceDescription.EventsVoid.size(); ++i) {
         const mtsEventVoidDescription &evt = InterfaceDescription.EventsVoid[i];
         if (!mtsInterfaceProvided::IsSystemEventVoid(evt.Name)) {
-            mtsEventSenderVoid *eventSender = new mtsEventSenderVoid(Socket);
+            mtsEventSenderVoid *eventSender = new mtsEventSenderVoid(*Channel);
             success = false;
             if (requiredInterfaceProxy->AddEventHandlerVoid(&mtsEventSenderVoid::Method, eventSender, evt.Name))
                 success = EventGeneratorVoidProxyMap.AddItem(evt.Name, eventSender);
@@ -1260,7 +1436,7 @@ bool mtsSocketProxyServer::CreateServerProxy(const std::string & requiredInterfa
     // Create EventWrite proxies
     for (i = 0; i < InterfaceDescription.EventsWrite.size(); ++i) {
         const mtsEventWriteDescription &evt = InterfaceDescription.EventsWrite[i];
-        mtsEventSenderWrite *eventSender = new mtsEventSenderWrite(Socket);
+        mtsEventSenderWrite *eventSender = new mtsEventSenderWrite(*Channel);
         success = false;
         std::stringstream argStream(evt.ArgumentPrototypeSerialized);
         cmnDeSerializer deserializer(argStream);
@@ -1362,16 +1538,8 @@ void mtsSocketProxyServer::AddSpecialCommands(void)
 
 mtsExecutionResult mtsSocketProxyServer::GetInitData(std::string &outputArgSerialized, mtsProxySerializer *serializer) const
 {
-    mtsSocketProxyInitData init(mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE,
-                                FunctionReadProxyMap.GetItem("GetInterfaceDescription"),
-                                FunctionQualifiedReadProxyMap.GetItem("GetHandleVoid"),
-                                FunctionQualifiedReadProxyMap.GetItem("GetHandleRead"),
-                                FunctionQualifiedReadProxyMap.GetItem("GetHandleWrite"),
-                                FunctionQualifiedReadProxyMap.GetItem("GetHandleQualifiedRead"),
-                                FunctionQualifiedReadProxyMap.GetItem("GetHandleVoidReturn"),
-                                FunctionQualifiedReadProxyMap.GetItem("GetHandleWriteReturn"),
-                                FunctionWriteProxyMap.GetItem("EventEnable"),
-                                FunctionWriteProxyMap.GetItem("EventDisable"));
+    mtsSocketProxyInitData init;
+    GetInitData(init);
 
     mtsExecutionResult ret = mtsExecutionResult::COMMAND_SUCCEEDED;
     // Reset serializer just in case client was previously connected
@@ -1383,6 +1551,33 @@ mtsExecutionResult mtsSocketProxyServer::GetInitData(std::string &outputArgSeria
     return ret;
 }
 
+mtsExecutionResult mtsSocketProxyServer::GetInitData(mtsSocketProxySendBuffer &outputArg) const
+{
+    mtsSocketProxyInitData init;
+    GetInitData(init);
+
+    mtsExecutionResult ret = mtsExecutionResult::COMMAND_SUCCEEDED;
+    if (!outputArg.Serialize(init)) {
+        CMN_LOG_CLASS_RUN_ERROR << "GetInitData: serialization failure: " << std::endl;
+        ret = mtsExecutionResult::SERIALIZATION_ERROR;
+    }
+    return ret;
+}
+
+void mtsSocketProxyServer::GetInitData(mtsSocketProxyInitData &init) const
+{
+    init = mtsSocketProxyInitData(Channel->GetPacketSize(),
+                                  FunctionReadProxyMap.GetItem("GetInterfaceDescription"),
+                                  FunctionQualifiedReadProxyMap.GetItem("GetHandleVoid"),
+                                  FunctionQualifiedReadProxyMap.GetItem("GetHandleRead"),
+                                  FunctionQualifiedReadProxyMap.GetItem("GetHandleWrite"),
+                                  FunctionQualifiedReadProxyMap.GetItem("GetHandleQualifiedRead"),
+                                  FunctionQualifiedReadProxyMap.GetItem("GetHandleVoidReturn"),
+                                  FunctionQualifiedReadProxyMap.GetItem("GetHandleWriteReturn"),
+                                  FunctionWriteProxyMap.GetItem("EventEnable"),
+                                  FunctionWriteProxyMap.GetItem("EventDisable"));
+}
+
 mtsProxySerializer *mtsSocketProxyServer::GetSerializerForClient(const osaIPandPort &ip_port) const
 {
     mtsProxySerializer *serializer;
@@ -1402,17 +1597,23 @@ mtsProxySerializer *mtsSocketProxyServer::GetSerializerForCurrentClient(void) co
 {
     // Get IP and Port
     osaIPandPort ip_port;
-    Socket.GetDestination(ip_port);
+    Channel->GetDestination(ip_port);
     return GetSerializerForClient(ip_port);
 }
 
-mtsCommandWriteBase *mtsSocketProxyServer::AllocateFinishedEvent(const std::string &eventHandle)
+mtsCommandWriteBase *mtsSocketProxyServer::AllocateFinishedEvent(const char *eventHandle, bool framed)
 {
     CMN_ASSERT(FinishedEvents);
     osaIPandPort ip_port;
-    Socket.GetDestination(ip_port);
-    mtsProxySerializer *serializer = GetSerializerForClient(ip_port);
-    return FinishedEvents->AllocateEntry(&Socket, ip_port, eventHandle, serializer);
+    Channel->GetDestination(ip_port);
+    // Serializer is only needed for the CommandString protocol
+    mtsProxySerializer *serializer = framed ? 0 : GetSerializerForClient(ip_port);
+    return FinishedEvents->AllocateEntry(Channel, ip_port, eventHandle, serializer, framed);
+}
+
+mtsSocketProxyDeSerializer & mtsSocketProxyServer::GetDeSerializer(void)
+{
+    return DeSerializer;
 }
 
 bool mtsSocketProxyServer::GetInterfaceDescription(mtsInterfaceProvidedDescription &desc) const
@@ -1494,9 +1695,8 @@ void mtsSocketProxyServer::EventEnable(const std::string &eventHandleAndName)
         eventSender = EventGeneratorWriteProxyMap.GetItem(eventName);
     if (eventSender) {
         osaIPandPort ip_port;
-        Socket.GetDestination(ip_port);
-        mtsProxySerializer *serializer = GetSerializerForClient(ip_port);
-        if (!eventSender->AddClient(ip_port, handle, serializer)) {
+        Channel->GetDestination(ip_port);
+        if (!eventSender->AddClient(ip_port, handle)) {
             CMN_LOG_CLASS_RUN_ERROR << "EventEnable " << eventName << " failed for "
                                     << ip_port.IP << ":" << ip_port.Port << std::endl;
         }
@@ -1519,7 +1719,7 @@ void mtsSocketProxyServer::EventDisable(const std::string &eventHandleAndName)
         eventSender = EventGeneratorWriteProxyMap.GetItem(eventName);
     if (eventSender) {
         osaIPandPort ip_port;
-        Socket.GetDestination(ip_port);
+        Channel->GetDestination(ip_port);
         if (!eventSender->RemoveClient(ip_port, handle)) {
             CMN_LOG_CLASS_RUN_ERROR << "EventDisable " << eventName << " failed for "
                                     << ip_port.IP << ":" << ip_port.Port << std::endl;
@@ -44,9 +44,11 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
     IndexDelayed(0),
     Delay(0.0),
     AutomaticAdvanceFlag(true),
+    ColumnarStorageFlag(false),
     StateVector(0),
     StateVectorDataNames(0),
     Ticks(size, mtsStateIndex::TimeTicksType(0)),
+    RowSequence(0),
     Tic(0.0),
     Toc(0.0),
     Period(0.0),
@@ -59,6 +61,8 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
         CMN_LOG_CLASS_INIT_VERBOSE << "constructor: history lenght sets to 3 (minimum required)" << std::endl;
         this->HistoryLength = 3;
     }
+    this->Ticks.resize(this->HistoryLength, mtsStateIndex::TimeTicksType(0));
+    this->RowSequence = new osaAtomic<size_t>[this->HistoryLength];
 
     // set the default number of elements for data collection batch
     this->DataCollection.BatchSize = this->HistoryLength / 3;
@@ -85,6 +89,7 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
 
 mtsStateTable::~mtsStateTable()
 {
+    delete[] this->RowSequence;
 }
 
 bool mtsStateTable::SetSize(const size_t size){
@@ -94,6 +99,10 @@ bool mtsStateTable::SetSize(const size_t size){
 
     this->HistoryLength = size;
 
+    this->Ticks.resize(this->HistoryLength, mtsStateIndex::TimeTicksType(0));
+    delete[] this->RowSequence;
+    this->RowSequence = new osaAtomic<size_t>[this->HistoryLength];
+
     for (unsigned int j = 0; j < StateVector.size(); j++)  {
         if (StateVector[j]) {
             StateVector[j]->SetSize(this->HistoryLength);
@@ -104,6 +113,25 @@ bool mtsStateTable::SetSize(const size_t size){
 }
 
 
+size_t mtsStateTable::SetColumnarStorage(bool columnarStorage)
+{
+    this->ColumnarStorageFlag = columnarStorage;
+    size_t columnar = 0;
+    for (size_t index = 0; index < StateVector.size(); index++) {
+        if (StateVector[index]) {
+            StateVector[index]->SetColumnar(columnarStorage);
+            if (StateVector[index]->IsColumnar()) {
+                columnar++;
+            }
+        }
+    }
+    CMN_LOG_CLASS_INIT_VERBOSE << "SetColumnarStorage: state table \"" << this->Name << "\" has "
+                               << columnar << " out of " << StateVector.size()
+                               << " element(s) stored in columns" << std::endl;
+    return columnar;
+}
+
+
 /* All the const methods that can be called from reader or writer */
 mtsStateIndex mtsStateTable::GetIndexReader(void) const {
     size_t tmp = IndexReader;
@@ -160,7 +188,12 @@ bool mtsStateTable::Write(mtsStateDataId id, const mtsGenericObject & object) {
         CMN_LOG_CLASS_INIT_ERROR << "Write: no state data array corresponding to given id: " << id << std::endl;
         return false;
     }
-    result = StateVector[id]->Set(IndexWriter, object);
+    // in columnar mode, object is the element registered with NewElement
+    if (StateVector[id]->IsColumnar()) {
+        result = StateVector[id]->Snapshot(IndexWriter, object);
+    } else {
+        result = StateVector[id]->Set(IndexWriter, object);
+    }
     if (!result) {
         CMN_LOG_CLASS_INIT_ERROR << "Write: error setting data array value in id: " << id << std::endl;
     }
@@ -168,6 +201,82 @@ bool mtsStateTable::Write(mtsStateDataId id, const mtsGenericObject & object) {
 }
 
 
+bool mtsStateTable::CopyRow(const mtsStateIndex & when,
+                            const std::vector<mtsStateDataId> & ids,
+                            const std::vector<mtsGenericObject *> & data,
+                            bool & torn) const
+{
+    torn = false;
+    if (ids.size() != data.size()) {
+        CMN_LOG_CLASS_RUN_ERROR << "CopyRow: number of ids (" << ids.size()
+                                << ") and data objects (" << data.size() << ") don't match" << std::endl;
+        return false;
+    }
+    const size_t row = static_cast<size_t>(when.Index());
+    if (row >= HistoryLength) {
+        CMN_LOG_CLASS_RUN_ERROR << "CopyRow: invalid row index " << row << std::endl;
+        return false;
+    }
+    const size_t sequence = RowSequence[row].Load();
+    if ((sequence & 1) || !ValidateReadIndex(when)) {
+        torn = true;
+        return false;
+    }
+    size_t index;
+    mtsStateDataId id;
+    for (index = 0; index < ids.size(); index++) {
+        id = ids[index];
+        if ((id < 0) || (static_cast<size_t>(id) >= StateVector.size())
+            || !StateVector[id] || !data[index]) {
+            CMN_LOG_CLASS_RUN_ERROR << "CopyRow: invalid id or data object at position " << index << std::endl;
+            return false;
+        }
+        if (!StateVector[id]->Get(row, *(data[index]))) {
+            CMN_LOG_CLASS_RUN_ERROR << "CopyRow: failed to copy element \"" << StateVectorDataNames[id]
+                                    << "\", check the type of data object" << std::endl;
+            return false;
+        }
+    }
+    // the copies must be complete before the sequence number is checked again
+    osaAtomicThreadFence();
+    if ((RowSequence[row].LoadRelaxed() != sequence) || !ValidateReadIndex(when)) {
+        torn = true;
+        return false;
+    }
+    return true;
+}
+
+
+bool mtsStateTable::GetConsistent(const mtsStateIndex & when,
+                                  const std::vector<mtsStateDataId> & ids,
+                                  const std::vector<mtsGenericObject *> & data) const
+{
+    bool torn;
+    return CopyRow(when, ids, data, torn);
+}
+
+
+bool mtsStateTable::GetLatestConsistent(const std::vector<mtsStateDataId> & ids,
+                                        const std::vector<mtsGenericObject *> & data,
+                                        mtsStateIndex & when,
+                                        size_t maxAttempts) const
+{
+    bool torn;
+    for (size_t attempt = 0; attempt < maxAttempts; attempt++) {
+        when = GetIndexReader();
+        if (CopyRow(when, ids, data, torn)) {
+            return true;
+        }
+        if (!torn) {
+            return false;
+        }
+        osaCPUPause();
+    }
+    CMN_LOG_CLASS_RUN_DEBUG << "GetLatestConsistent: no consistent row after " << maxAttempts << " attempt(s)" << std::endl;
+    return false;
+}
+
+
 void mtsStateTable::Start(void) {
     if (TimeServer) {
         Tic = TimeServer->GetRelativeTime(); // in seconds
@@ -220,6 +329,12 @@ void mtsStateTable::Advance(void) {
     */
     tmpIndex = IndexWriter;
 
+    // Mark the row as being written, the fence prevents the data
+    // writes from being reordered before the odd sequence number.
+    const size_t sequence = RowSequence[tmpIndex].LoadRelaxed();
+    RowSequence[tmpIndex].StoreRelaxed(sequence + 1);
+    osaAtomicThreadFence();
+
     // Write data in the state table from the different state data objects.
     // Note that we start at TicId, which should correspond to the second
     // element in the array (after Toc).
@@ -301,6 +416,8 @@ void mtsStateTable::Advance(void) {
     PeriodStats.AddComputeTime(this->Toc - this->Tic);
 
     Write(TocId, Toc);
+    // Row is complete, release the data before the even sequence number
+    RowSequence[tmpIndex].Store(sequence + 2);
     // now increment the IndexWriter and set its Tick value
     IndexWriter = newIndexWriter;
     Ticks[IndexWriter] = Ticks[tmpIndex] + 1;
@@ -361,9 +478,9 @@ void mtsStateTable::ToStream(std::ostream & outputStream) const {
         out << Ticks[i] << ": ";
         for (unsigned int j = 0; j < StateVector.size(); j++)  {
             if (StateVector[j]) {
-                out << " [" << j << "] "
-                    << (*StateVector[j])[i]
-                    << " : ";
+                out << " [" << j << "] ";
+                StateVector[j]->ElementToStream(i, out);
+                out << " : ";
             }
         }
         if (i == IndexReader)
@@ -393,8 +510,9 @@ void mtsStateTable::Debug(std::ostream & out, unsigned int * listColumn, unsigne
         out << Ticks[i] << " ";
         for (j = 0; j < number; j++) {
             if (listColumn[j] < StateVector.size() && StateVector[listColumn[j]]) {
-                out << " [" << listColumn[j] << "] "
-                    <<(*StateVector[listColumn[j]])[i] << " : ";
+                out << " [" << listColumn[j] << "] ";
+                StateVector[listColumn[j]]->ElementToStream(i, out);
+                out << " : ";
             }
         }
         if (i == IndexReader) {
@@ -421,7 +539,8 @@ void mtsStateTable::CSVWrite(std::ostream& out, bool nonZeroOnly) {
             out << i << " " << Ticks[i] << " ";
             for (unsigned int j = 0; j < StateVector.size(); j++)  {
                 if (StateVector[j]) {
-                    out << (*StateVector[j])[i] << " ";
+                    StateVector[j]->ElementToStream(i, out);
+                    out << " ";
                 }
             }
             out << std::endl;
@@ -439,7 +558,8 @@ void mtsStateTable::CSVWrite(std::ostream& out, unsigned int *listColumn, unsign
             out << i << " " << Ticks[i] << " ";
             for (j = 0; j < number; j++) {
                 if (listColumn[j] < StateVector.size() && StateVector[listColumn[j]]) {
-                    out << (*StateVector[listColumn[j]])[i] << " ";
+                    StateVector[listColumn[j]]->ElementToStream(i, out);
+                    out << " ";
                 }
             }
             out << std::endl;
@@ -50,6 +50,9 @@ void * mtsTaskPeriodic::RunInternal(void *data)
         }
         // Wait for remaining period also handles thread suspension
         ThreadBuddy.WaitForRemainingPeriod();
+        // Recorded in the state table at the next iteration
+        NumberOfOverruns = ThreadBuddy.GetNumberOfOverruns();
+        NumberOfSkippedPeriods = ThreadBuddy.GetNumberOfSkippedPeriods();
     }
 
     CMN_LOG_CLASS_RUN_WARNING << "End of task " << Name << std::endl;
@@ -112,6 +115,7 @@ mtsTaskPeriodic::mtsTaskPeriodic(const std::string & name, double periodicityInS
 {
     AbsoluteTimePeriod.FromSeconds(periodicityInSeconds);
     CMN_ASSERT(GetPeriodicity() > 0);
+    AddSchedulingCountersToStateTable();
 }
 
 mtsTaskPeriodic::mtsTaskPeriodic( const std::string & name,
@@ -126,6 +130,7 @@ mtsTaskPeriodic::mtsTaskPeriodic( const std::string & name,
     IsHardRealTime(isHardRealTime)
 {
     CMN_ASSERT(GetPeriodicity() > 0);
+    AddSchedulingCountersToStateTable();
 }
 
 mtsTaskPeriodic::mtsTaskPeriodic(const mtsTaskPeriodicConstructorArg &arg):
@@ -136,6 +141,15 @@ mtsTaskPeriodic::mtsTaskPeriodic(const mtsTaskPeriodicConstructorArg &arg):
 {
     AbsoluteTimePeriod.FromSeconds(arg.Period);
     CMN_ASSERT(GetPeriodicity() > 0);
+    AddSchedulingCountersToStateTable();
+}
+
+void mtsTaskPeriodic::AddSchedulingCountersToStateTable(void)
+{
+    NumberOfOverruns = 0;
+    NumberOfSkippedPeriods = 0;
+    StateTable.AddData(NumberOfOverruns, "NumberOfOverruns");
+    StateTable.AddData(NumberOfSkippedPeriods, "NumberOfSkippedPeriods");
 }
 
 mtsTaskPeriodic::~mtsTaskPeriodic() {
@@ -174,3 +188,8 @@ bool mtsTaskPeriodic::IsPeriodic(void) const
 {
     return Period > 0.0;
 }
+
+bool mtsTaskPeriodic::SetAbsoluteDeadlines(bool absoluteDeadlines, double spinTimeInSeconds)
+{
+    return ThreadBuddy.SetAbsoluteDeadlines(absoluteDeadlines, spinTimeInSeconds);
+}
@@ -0,0 +1,216 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Measures the time spent by mtsMailBox to queue and dispatch each
+// kind of queued command, without any thread or task involved.
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstMultiTask/mtsMailBox.h>
+#include <cisstMultiTask/mtsCallableVoidMethod.h>
+#include <cisstMultiTask/mtsCallableVoidReturnMethod.h>
+#include <cisstMultiTask/mtsCallableReadMethod.h>
+#include <cisstMultiTask/mtsCallableQualifiedReadMethod.h>
+#include <cisstMultiTask/mtsCallableWriteReturnMethod.h>
+#include <cisstMultiTask/mtsCommandWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedVoid.h>
+#include <cisstMultiTask/mtsCommandQueuedWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedVoidReturn.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteReturn.h>
+
+#include <iomanip>
+
+// size of mailbox, all commands are queued and then dequeued
+const size_t confQueueSize = 256;
+// number of times the mailbox is filled and emptied
+const size_t confNumberOfIterations = 2000;
+
+class benchmarkReceiver
+{
+public:
+    double Value;
+
+    benchmarkReceiver(void):
+        Value(0.0)
+    {}
+
+    void Void(void) {
+        Value += 1.0;
+    }
+
+    void Write(const mtsDouble & argument) {
+        Value += argument.Data;
+    }
+
+    bool Read(mtsDouble & result) const {
+        result.Data = Value;
+        return true;
+    }
+
+    bool QualifiedRead(const mtsDouble & argument, mtsDouble & result) const {
+        result.Data = Value + argument.Data;
+        return true;
+    }
+
+    void VoidReturn(mtsDouble & result) {
+        result.Data = Value;
+    }
+
+    void WriteReturn(const mtsDouble & argument, mtsDouble & result) {
+        result.Data = argument.Data * Value;
+    }
+};
+
+
+// fill the mailbox using queueCommand, then empty it; displays
+// separate times for queueing and dispatching in ns per command
+template <class _queueCommand>
+void benchmarkCommand(const std::string & name, mtsMailBox & mailBox, _queueCommand queueCommand)
+{
+    double queueTime = 0.0;
+    double executeTime = 0.0;
+    size_t numberOfCommands = 0;
+    double startTime;
+    size_t iteration, index;
+    for (iteration = 0; iteration < confNumberOfIterations; ++iteration) {
+        startTime = osaGetTime();
+        for (index = 0; index < confQueueSize - 1; ++index) {
+            queueCommand();
+        }
+        queueTime += osaGetTime() - startTime;
+        startTime = osaGetTime();
+        while (mailBox.ExecuteNext()) {
+            numberOfCommands++;
+        }
+        executeTime += osaGetTime() - startTime;
+    }
+    std::cout << std::setw(16) << name
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << (queueTime / numberOfCommands) * 1.0e9
+              << std::setw(12) << (executeTime / numberOfCommands) * 1.0e9
+              << std::endl;
+}
+
+
+// functors used to queue the commands
+class queueVoid {
+public:
+    mtsCommandQueuedVoid * Command;
+    void operator () (void) { Command->Execute(MTS_NOT_BLOCKING); }
+};
+
+class queueWrite {
+public:
+    mtsCommandQueuedWriteBase * Command;
+    mtsDouble * Argument;
+    void operator () (void) { Command->Execute(*Argument, MTS_NOT_BLOCKING); }
+};
+
+template <class _commandType>
+class queueReturn {
+public:
+    _commandType * Command;
+    mtsDouble * Result;
+    void operator () (void) { Command->Execute(*Result, 0); }
+};
+
+template <class _commandType>
+class queueWriteReturn {
+public:
+    _commandType * Command;
+    mtsDouble * Argument;
+    mtsDouble * Result;
+    void operator () (void) { Command->Execute(*Argument, *Result, 0); }
+};
+
+
+int main(int CMN_UNUSED(argc), char ** CMN_UNUSED(argv))
+{
+    // log configuration
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::AddChannel(std::cout, CMN_LOG_ALLOW_ERRORS_AND_WARNINGS);
+
+    benchmarkReceiver receiver;
+    mtsMailBox mailBox("Benchmark", confQueueSize);
+    mtsDouble argument(2.0), result;
+
+    // note that commands own the prototypes provided to constructors
+
+    mtsCommandQueuedVoid commandVoid(new mtsCallableVoidMethod<benchmarkReceiver>(&benchmarkReceiver::Void, &receiver),
+                                     "Void", &mailBox, confQueueSize);
+
+    mtsCommandWrite<benchmarkReceiver, mtsDouble> actualWrite(&benchmarkReceiver::Write, &receiver, "Write", argument);
+    mtsCommandQueuedWrite<mtsDouble> commandWrite(&mailBox, &actualWrite, confQueueSize);
+
+    mtsCommandQueuedRead commandRead(new mtsCallableReadMethod<benchmarkReceiver, mtsDouble>(&benchmarkReceiver::Read, &receiver),
+                                     "Read", new mtsDouble, &mailBox, confQueueSize);
+
+    mtsCommandQueuedQualifiedRead
+        commandQualifiedRead(new mtsCallableQualifiedReadMethod<benchmarkReceiver, mtsDouble, mtsDouble>(&benchmarkReceiver::QualifiedRead, &receiver),
+                             "QualifiedRead", new mtsDouble, new mtsDouble, &mailBox, confQueueSize);
+
+    mtsCommandQueuedVoidReturn
+        commandVoidReturn(new mtsCallableVoidReturnMethod<benchmarkReceiver, mtsDouble>(&benchmarkReceiver::VoidReturn, &receiver),
+                          "VoidReturn", new mtsDouble, &mailBox, confQueueSize);
+
+    mtsCommandQueuedWriteReturn
+        commandWriteReturn(new mtsCallableWriteReturnMethod<benchmarkReceiver, mtsDouble, mtsDouble>(&benchmarkReceiver::WriteReturn, &receiver),
+                           "WriteReturn", new mtsDouble, new mtsDouble, &mailBox, confQueueSize);
+
+    std::cout << "Mailbox benchmark, " << confNumberOfIterations * (confQueueSize - 1)
+              << " commands per kind" << std::endl
+              << std::setw(16) << "command"
+              << std::setw(12) << "queue (ns)"
+              << std::setw(12) << "exec (ns)" << std::endl;
+
+    queueVoid queueVoidFunctor;
+    queueVoidFunctor.Command = &commandVoid;
+    benchmarkCommand("Void", mailBox, queueVoidFunctor);
+
+    queueWrite queueWriteFunctor;
+    queueWriteFunctor.Command = &commandWrite;
+    queueWriteFunctor.Argument = &argument;
+    benchmarkCommand("Write", mailBox, queueWriteFunctor);
+
+    queueReturn<mtsCommandQueuedRead> queueReadFunctor;
+    queueReadFunctor.Command = &commandRead;
+    queueReadFunctor.Result = &result;
+    benchmarkCommand("Read", mailBox, queueReadFunctor);
+
+    queueWriteReturn<mtsCommandQueuedQualifiedRead> queueQualifiedReadFunctor;
+    queueQualifiedReadFunctor.Command = &commandQualifiedRead;
+    queueQualifiedReadFunctor.Argument = &argument;
+    queueQualifiedReadFunctor.Result = &result;
+    benchmarkCommand("QualifiedRead", mailBox, queueQualifiedReadFunctor);
+
+    queueReturn<mtsCommandQueuedVoidReturn> queueVoidReturnFunctor;
+    queueVoidReturnFunctor.Command = &commandVoidReturn;
+    queueVoidReturnFunctor.Result = &result;
+    benchmarkCommand("VoidReturn", mailBox, queueVoidReturnFunctor);
+
+    queueWriteReturn<mtsCommandQueuedWriteReturn> queueWriteReturnFunctor;
+    queueWriteReturnFunctor.Command = &commandWriteReturn;
+    queueWriteReturnFunctor.Argument = &argument;
+    queueWriteReturnFunctor.Result = &result;
+    benchmarkCommand("WriteReturn", mailBox, queueWriteReturnFunctor);
+
+    return 0;
+}
@@ -51,10 +51,13 @@ class CISST_EXPORT mtsCollectorBase: public mtsTaskFromSignal
 
     //-------------------- Auxiliary class definition -----------------------//
 public:
+    /*! File formats.  COLLECTOR_FILE_FORMAT_COLUMNAR is only
+      supported by mtsCollectorState, see mtsCollectorColumnar. */
     typedef enum {
         COLLECTOR_FILE_FORMAT_PLAIN_TEXT,
         COLLECTOR_FILE_FORMAT_BINARY,
         COLLECTOR_FILE_FORMAT_CSV,
+        COLLECTOR_FILE_FORMAT_COLUMNAR,
         COLLECTOR_FILE_FORMAT_UNDEFINED
     } CollectorFileFormat;
 
@@ -168,6 +171,11 @@ protected:
     /*! Setup the parameters for the collector output stream. */
     void SetOutputStreamParams(void);
 
+    /*! Called before the output is changed or closed.  Derived
+      classes writing from another thread must wait for all pending
+      writes to complete. */
+    virtual void FlushPendingOutput(void) {}
+
     /*! Default control interface and methods used for the provided commands. */
     mtsInterfaceProvided * ControlInterface;
 
@@ -239,7 +247,7 @@ public:
     void SetOutputToDefault(void);
 
     /*! Closes the output file stream */
-    void CloseOutput(void);
+    virtual void CloseOutput(void);
 
     /*! Get the name of log file currently being written. */
     inline const std::string & GetOutputFileName(void) const {
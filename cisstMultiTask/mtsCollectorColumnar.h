@@ -0,0 +1,361 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Columnar binary log format used by mtsCollectorState
+*/
+
+#ifndef _mtsCollectorColumnar_h
+#define _mtsCollectorColumnar_h
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstMultiTask/mtsGenericObject.h>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <string.h>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Definition of the columnar log file format, see
+  mtsCollectorBase::COLLECTOR_FILE_FORMAT_COLUMNAR.
+
+  A file starts with a FileHeader followed by a description string
+  and the description of each signal (name, type name, encoding and
+  payload size).  The header is padded to CHUNK_ALIGNMENT bytes.
+
+  The data is stored in chunks, one per batch collected.  Each chunk
+  starts with a ChunkHeader followed by the columns, each column
+  padded to ALIGNMENT bytes:
+  - Ticks of each row (unsigned long long)
+  - Time of each row, i.e. the state table Tic (double)
+  - For each signal: timestamps (double), valid flags (char) and
+    either the raw payloads (ENCODING_RAW, fixed size per row) or
+    the row offsets (rows + 1 unsigned long long) followed by the
+    serialized objects (ENCODING_SERIALIZED).
+
+  Chunks are padded to CHUNK_ALIGNMENT bytes.  All values are stored
+  with the byte order of the writer, ByteOrder is used to detect
+  mismatches.
+*/
+class CISST_EXPORT mtsCollectorColumnar
+{
+public:
+    enum {VERSION = 1, ALIGNMENT = 8, CHUNK_ALIGNMENT = 64};
+
+    typedef enum {
+        ENCODING_RAW = 0,
+        ENCODING_SERIALIZED = 1
+    } EncodingType;
+
+    struct FileHeader {
+        char Magic[8];
+        unsigned int Version;
+        unsigned int ByteOrder;
+        unsigned int NumberOfSignals;
+        unsigned int Reserved;
+        unsigned long long HeaderSize;
+        double TimeOrigin;
+    };
+
+    struct ChunkHeader {
+        char Magic[4];
+        unsigned int NumberOfRows;
+        unsigned long long ChunkSize;
+        double FirstTime;
+        double LastTime;
+    };
+
+    class SignalDescription {
+    public:
+        std::string Name;
+        std::string TypeName;
+        EncodingType Encoding;
+        size_t PayloadSize;
+    };
+    typedef std::vector<SignalDescription> SignalsType;
+
+    static const char FileMagic[8];
+    static const char ChunkMagic[4];
+    static const unsigned int ByteOrderMark;
+
+    /*! Round size up to a multiple of alignment (power of two). */
+    inline static size_t Align(size_t size, size_t alignment) {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    /*! Size of the columns of a signal for a given number of rows.
+      For serialized signals, serializedSize is the total size of the
+      serialized objects. */
+    static size_t SignalColumnsSize(const SignalDescription & signal,
+                                    size_t numberOfRows, size_t serializedSize);
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Writer for the columnar log format.  The caller builds each chunk
+  in a buffer provided by Reserve and hands it over with Commit.
+  Buffers are written to disk by a dedicated thread, using large
+  unbuffered writes from page aligned memory.  Reserve blocks if all
+  the buffers are waiting to be written.
+*/
+class CISST_EXPORT mtsCollectorColumnarWriter
+{
+protected:
+    class Buffer {
+    public:
+        char * Allocation;
+        char * Memory;
+        size_t Capacity;
+        size_t Size;
+    };
+
+    std::FILE * File;
+    std::string FileName;
+    std::vector<Buffer> Buffers;
+
+    /*! Indices of the next buffer to fill (producer) and to write
+      (writer thread), and number of buffers committed but not
+      written yet.  Protected by Mutex. */
+    //@{
+    size_t ProducerIndex;
+    size_t WriterIndex;
+    size_t Pending;
+    bool Stopping;
+    bool WriteError;
+    //@}
+
+    osaMutex Mutex;
+    osaThreadSignal DataSignal;
+    osaThreadSignal SpaceSignal;
+    osaThread Thread;
+    bool ThreadRunning;
+
+    /*! Thread body, writes committed buffers. */
+    void * Run(int);
+
+    /*! Make sure the buffer can hold size bytes. */
+    void Reallocate(Buffer & buffer, size_t size);
+
+    /*! Write the file header, padded to CHUNK_ALIGNMENT. */
+    bool WriteHeader(const std::string & description,
+                     const mtsCollectorColumnar::SignalsType & signals,
+                     double timeOrigin);
+
+public:
+    mtsCollectorColumnarWriter(void);
+    ~mtsCollectorColumnarWriter();
+
+    /*! Create the file, write the header and start the writer
+      thread. */
+    bool Open(const std::string & fileName,
+              const std::string & description,
+              const mtsCollectorColumnar::SignalsType & signals,
+              double timeOrigin,
+              size_t numberOfBuffers = 4,
+              size_t bufferSize = 1024 * 1024);
+
+    inline bool IsOpen(void) const {
+        return (this->File != 0);
+    }
+
+    /*! Write all pending buffers, stop the writer thread and close
+      the file. */
+    void Close(void);
+
+    /*! Get a buffer of at least size bytes for the next chunk.
+      Returns 0 if the file is not open. */
+    char * Reserve(size_t size);
+
+    /*! Hand over the buffer returned by the last Reserve to the
+      writer thread. */
+    void Commit(size_t size);
+
+    /*! True if a write to disk failed. */
+    bool HasWriteError(void);
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Reader for the columnar log format.  The file is memory mapped and
+  only the chunk headers are parsed when the file is opened, any row
+  of any signal can then be accessed directly.  Rows are numbered
+  from 0 across all chunks.
+*/
+class CISST_EXPORT mtsCollectorColumnarReader
+{
+protected:
+    class SignalColumns {
+    public:
+        const double * Timestamps;
+        const char * Valid;
+        const char * Payloads;
+        const unsigned long long * Offsets;
+    };
+
+    class Chunk {
+    public:
+        size_t FirstRow;
+        size_t NumberOfRows;
+        double FirstTime;
+        double LastTime;
+        const unsigned long long * Ticks;
+        const double * Time;
+        std::vector<SignalColumns> Signals;
+    };
+
+    const char * Data;
+    size_t DataSize;
+    void * MappingHandle;
+    std::string Description;
+    double TimeOrigin;
+    mtsCollectorColumnar::SignalsType Signals;
+    std::vector<Chunk> Chunks;
+    size_t NumberOfRows;
+
+    bool Map(const std::string & fileName);
+    void Unmap(void);
+    bool ParseHeader(size_t & offset);
+    bool ParseChunk(size_t & offset);
+    bool LocateRow(size_t row, const Chunk * & chunk, size_t & rowInChunk) const;
+
+public:
+    mtsCollectorColumnarReader(void);
+    ~mtsCollectorColumnarReader();
+
+    /*! Map the file and index the chunks.  A truncated last chunk
+      (e.g. file still being written) is ignored. */
+    bool Open(const std::string & fileName);
+    void Close(void);
+
+    inline const std::string & GetDescription(void) const {
+        return this->Description;
+    }
+
+    inline double GetTimeOrigin(void) const {
+        return this->TimeOrigin;
+    }
+
+    inline size_t GetNumberOfSignals(void) const {
+        return this->Signals.size();
+    }
+
+    inline const mtsCollectorColumnar::SignalDescription & GetSignal(size_t signal) const {
+        return this->Signals[signal];
+    }
+
+    /*! Index of the signal, -1 if not found. */
+    int GetSignalIndex(const std::string & name) const;
+
+    inline size_t GetNumberOfRows(void) const {
+        return this->NumberOfRows;
+    }
+
+    inline size_t GetNumberOfChunks(void) const {
+        return this->Chunks.size();
+    }
+
+    /*! Find the rows with a time (Tic) in [startTime, endTime].
+      Assumes the time is increasing.  Returns false if no row is in
+      the range. */
+    bool FindRows(double startTime, double endTime,
+                  size_t & firstRow, size_t & lastRow) const;
+
+    /*! Per row accessors.  The row must be lower than GetNumberOfRows. */
+    //@{
+    unsigned long long GetTicks(size_t row) const;
+    double GetTime(size_t row) const;
+    double GetTimestamp(size_t signal, size_t row) const;
+    bool GetValid(size_t signal, size_t row) const;
+    //@}
+
+    /*! Pointer on the payload of a signal for a given row, i.e. the
+      raw data or the serialized object depending on the signal
+      encoding. */
+    const char * GetPayload(size_t signal, size_t row, size_t & size) const;
+
+    /*! Deserialize an object.  Only for signals using
+      ENCODING_SERIALIZED, the object must be of the type used to
+      serialize. */
+    bool GetObject(size_t signal, size_t row, mtsGenericObject & object) const;
+
+    /*! Copy the payloads of a raw signal for all rows with a time in
+      [startTime, endTime], interpreting each payload as an array of
+      _scalarType.  Returns the number of rows copied. */
+    template <class _scalarType>
+    size_t GetValues(size_t signal, double startTime, double endTime,
+                     std::vector<double> & times,
+                     std::vector<_scalarType> & values) const;
+};
+
+
+template <class _scalarType>
+size_t mtsCollectorColumnarReader::GetValues(size_t signal, double startTime, double endTime,
+                                             std::vector<double> & times,
+                                             std::vector<_scalarType> & values) const
+{
+    times.clear();
+    values.clear();
+    if ((signal >= this->Signals.size())
+        || (this->Signals[signal].Encoding != mtsCollectorColumnar::ENCODING_RAW)
+        || ((this->Signals[signal].PayloadSize % sizeof(_scalarType)) != 0)) {
+        return 0;
+    }
+    size_t firstRow, lastRow;
+    if (!FindRows(startTime, endTime, firstRow, lastRow)) {
+        return 0;
+    }
+    const size_t payloadSize = this->Signals[signal].PayloadSize;
+    const size_t scalarsPerRow = payloadSize / sizeof(_scalarType);
+    const size_t numberOfRows = lastRow - firstRow + 1;
+    times.resize(numberOfRows);
+    values.resize(numberOfRows * scalarsPerRow);
+    const Chunk * chunk;
+    size_t rowInChunk, row = firstRow, copied = 0, count;
+    while (copied < numberOfRows) {
+        LocateRow(row, chunk, rowInChunk);
+        count = chunk->NumberOfRows - rowInChunk;
+        if (count > numberOfRows - copied) {
+            count = numberOfRows - copied;
+        }
+        // columns are contiguous within a chunk
+        memcpy(&(times[copied]), chunk->Time + rowInChunk, count * sizeof(double));
+        if (payloadSize != 0) {
+            memcpy(&(values[copied * scalarsPerRow]),
+                   chunk->Signals[signal].Payloads + rowInChunk * payloadSize,
+                   count * payloadSize);
+        }
+        copied += count;
+        row += count;
+    }
+    return numberOfRows;
+}
+
+#endif // _mtsCollectorColumnar_h
@@ -26,8 +26,15 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCollectorBase.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsCollectorColumnar.h>
+#include <cisstMultiTask/mtsVector.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
 
 #include <string>
+#include <sstream>
 
 // Always include last
 #include <cisstMultiTask/mtsExport.h>
@@ -37,9 +44,17 @@ http://www.cisst.org/cisst/license.txt.
 
   This class provides a way to collect data in the state table without
   loss and make a log file. The type of a log file can be plain text
-  (ascii), csv, or binary.  A state table of which data is to be
-  collected can be specified in the constructor.  This is intended for
-  future usage where a task can have more than two state tables.
+  (ascii), csv, binary or columnar (see mtsCollectorColumnar).  A
+  state table of which data is to be collected can be specified in
+  the constructor.  This is intended for future usage where a task
+  can have more than two state tables.
+
+  When a batch is ready, the collector task copies the rows in a
+  preallocated batch and a dedicated writer thread formats and writes
+  it.  If all the batches are still waiting to be written, the new
+  rows are dropped instead of blocking the collector.  Rows dropped,
+  maximum queue depth and write latency histogram are available
+  through the "Control" provided interface.
 */
 class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
 {
@@ -48,6 +63,14 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
 
     CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
 
+public:
+    /*! Number of bins of the write latency histogram.  Bin 0 counts
+      batches written in less than 0.1 ms, bin i the batches written in
+      [0.1 * 2^(i-1), 0.1 * 2^i) ms and the last bin all slower
+      writes. */
+    enum {WRITE_LATENCY_HISTOGRAM_SIZE = 16};
+
+private:
     /*! Structure and container definition to manage the list of signals to be
         collected by this collector. */
     typedef struct {
@@ -70,6 +93,61 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
     /*! A stride value for data collector to skip several records. */
     size_t SamplingInterval;
 
+    /*! Rows copied from the state table by the collector task,
+      written by the writer thread.  Tic is used for the columnar
+      format only. */
+    class Batch {
+    public:
+        std::vector<mtsStateIndex::TimeTicksType> Ticks;
+        mtsStateArrayBase * Tic;
+        std::vector<mtsStateArrayBase *> Signals;
+        size_t NumberOfRows;
+    };
+
+    /*! Ring of batches.  ProducerIndex, WriterIndex, Pending and
+      PipelineStopping are protected by PipelineMutex. */
+    //@{
+    std::vector<Batch> Batches;
+    size_t NumberOfBatches;
+    size_t ProducerIndex;
+    size_t WriterIndex;
+    size_t Pending;
+    bool PipelineStopping;
+    bool PipelineRunning;
+    osaMutex PipelineMutex;
+    osaThreadSignal PipelineDataSignal;
+    osaThreadSignal PipelineSpaceSignal;
+    osaThread PipelineThread;
+    //@}
+
+    /*! Batch being filled by the collector task, 0 if the rows are
+      dropped. */
+    Batch * FillingBatch;
+
+    /*! Pipeline statistics, updated without lock so they can be read
+      by commands from any thread. */
+    //@{
+    osaAtomic<size_t> RowsDropped;
+    osaAtomic<size_t> MaxQueueDepth;
+    osaAtomic<size_t> WriteLatencyHistogram[WRITE_LATENCY_HISTOGRAM_SIZE];
+    //@}
+
+    /*! Allocate the batches and start the writer thread. */
+    void StartPipeline(void);
+
+    /*! Write all pending batches, stop the writer thread and release
+      the batches. */
+    void StopPipeline(void);
+
+    /*! Writer thread body. */
+    void * PipelineRun(int);
+
+    /*! Format and write a batch, called by the writer thread. */
+    void WriteBatch(const Batch & batch);
+
+    // documented in base class
+    void FlushPendingOutput(void);
+
     /*! Pointers to the target component and the target state table. */
     mtsComponent * TargetComponent;
     mtsStateTable * TargetStateTable;
@@ -95,10 +173,30 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
     /*! Add a signal element. Called internally by mtsCollectorState::AddSignal(). */
     bool AddSignalElement(const std::string & signalName, const unsigned int signalID);
 
-    /*! Fetch state table data */
+    /*! Copy state table rows in the batch being filled.  Rows
+      overwritten by the state table before they could be copied are
+      counted as dropped. */
     bool FetchStateTableData(const mtsStateTable * table,
                              const size_t startIdx,
-                             const size_t endIdx);
+                             const size_t endIdx,
+                             const mtsStateIndex::TimeTicksType lastTicks);
+
+    /*! Writer used for COLLECTOR_FILE_FORMAT_COLUMNAR.  Signals stored
+      in columns by the state table are written raw, all other signals
+      are serialized. */
+    //@{
+    mtsCollectorColumnarWriter * ColumnarWriter;
+    mtsCollectorColumnar::SignalsType ColumnarSignals;
+    std::ostringstream ColumnarSerializationStream;
+    std::vector<std::string> ColumnarSerialized;
+    std::vector<std::vector<unsigned long long> > ColumnarOffsets;
+    //@}
+
+    /*! Create the columnar file and write its header. */
+    bool OpenColumnarWriter(double timeOrigin);
+
+    /*! Write a batch as one columnar chunk. */
+    bool WriteBatchColumnar(const Batch & batch);
 
     /*! Print out the signal names which are being collected. */
     void PrintHeader(const CollectorFileFormat & fileFormat);
@@ -159,6 +257,22 @@ public:
         SamplingInterval = (samplingInterval > 0 ? samplingInterval : 1);
     }
 
+    /*! Set the number of batches used to buffer data between the
+      collector task and the writer thread, at least 2.  Only used
+      when the collection starts. */
+    void SetNumberOfBatches(const unsigned int numberOfBatches) {
+        NumberOfBatches = (numberOfBatches > 2 ? numberOfBatches : 2);
+    }
+
+    /*! Pipeline statistics, also available as read commands of the
+      "Control" interface. */
+    //@{
+    void GetRowsDropped(mtsUInt & placeHolder) const;
+    void GetMaxQueueDepth(mtsUInt & placeHolder) const;
+    void GetWriteLatencyHistogram(mtsUIntVec & placeHolder) const;
+    void ResetPipelineStatistics(void);
+    //@}
+
     /*! Connect.  Once the state collector has been configured,
       i.e. the methods SetStateTable and SetOutput have been use,
       the collector should be added to the manager and then the
@@ -169,6 +283,10 @@ public:
       component. */
     bool Disconnect(void);
 
+    /*! Closes the output file, including the columnar writer if
+      used. */
+    void CloseOutput(void);
+
     /*! Convert a binary log file into a plain text one. */
     static bool ConvertBinaryToText(const std::string sourceBinaryLogFileName,
                                     const std::string targetPlainTextLogFileName,
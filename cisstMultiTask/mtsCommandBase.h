@@ -57,17 +57,23 @@ protected:
       owned by an object being deleted. */
     bool EnableFlag;
 
+    /*! Kind of queued command, set by the constructors of queued
+      commands.  See GetQueuedKind(). */
+    mtsCommandQueuedKind QueuedKind;
+
 public:
     /*! The constructor. Does nothing */
     inline mtsCommandBase(void):
         Name("??"),
-        EnableFlag(true)
+        EnableFlag(true),
+        QueuedKind(MTS_COMMAND_KIND_NOT_QUEUED)
     {}
 
     /*! Constructor with command name. */
     inline mtsCommandBase(const std::string & name):
         Name(name),
-        EnableFlag(true)
+        EnableFlag(true),
+        QueuedKind(MTS_COMMAND_KIND_NOT_QUEUED)
     {}
 
     /*! The destructor. Does nothing */
@@ -116,6 +122,13 @@ public:
     inline const std::string & GetName(void) const {
         return this->Name;
     }
+
+    /*! Get the kind of queued command.  This is used by mtsMailBox
+      to find the actual type of a dequeued command without
+      dynamic_cast. */
+    inline mtsCommandQueuedKind GetQueuedKind(void) const {
+        return this->QueuedKind;
+    }
 };
 
 
@@ -69,6 +69,17 @@ public:
     mtsExecutionResult Execute(const mtsGenericObject & argument,
                                mtsBlockingType blocking,
                                mtsCommandWriteBase *finishedEventHandler);
+
+    /*! Zero-copy queuing is not supported since the filter has to be
+      applied on the argument.  Always returns 0. */
+    inline virtual mtsGenericObject * ArgumentReserve(void) {
+        return 0;
+    }
+
+ protected:
+    inline virtual bool ArgumentCommit(void) {
+        return false;
+    }
 };
 
 
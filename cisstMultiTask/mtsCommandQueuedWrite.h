@@ -198,6 +198,16 @@ public:
     inline virtual mtsGenericObject * ArgumentGet(void) {
         return ArgumentsQueue.Get();
     }
+
+
+    inline virtual mtsGenericObject * ArgumentReserve(void) {
+        return ArgumentsQueue.Reserve();
+    }
+
+ protected:
+    inline virtual bool ArgumentCommit(void) {
+        return ArgumentsQueue.Commit();
+    }
 };
 
 
@@ -274,6 +284,16 @@ public:
     inline virtual mtsGenericObject * ArgumentGet(void) {
         return ArgumentsQueue.Get();
     }
+
+
+    inline virtual mtsGenericObject * ArgumentReserve(void) {
+        return ArgumentsQueue.Reserve();
+    }
+
+ protected:
+    inline virtual bool ArgumentCommit(void) {
+        return ArgumentsQueue.Commit();
+    }
 };
 
 #endif // _mtsCommandQueuedWrite_h
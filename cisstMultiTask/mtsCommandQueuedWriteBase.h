@@ -49,12 +49,21 @@ protected:
         (previously, this was a BlockingFlagQueue). */
     mtsQueue<mtsCommandWriteBase *> FinishedEventQueue;
 
+    /*! Publish the argument slot returned by ArgumentReserve, used by
+      ExecuteReserved.  Returns false if no argument slot has been
+      reserved since the last commit (e.g. the arguments queue was
+      full) or if zero-copy queuing is not supported. */
+    inline virtual bool ArgumentCommit(void) {
+        return false;
+    }
+
     inline mtsCommandQueuedWriteBase(void):
         BaseType("??"),
         MailBox(0),
         ActualCommand(0),
         BlockingFlagQueue(0, MTS_NOT_BLOCKING)
     {
+        this->QueuedKind = MTS_COMMAND_KIND_QUEUED_WRITE;
         mtsCommandWriteBase *cmd = 0;
         FinishedEventQueue.SetSize(0, cmd);
     }
@@ -66,6 +75,7 @@ public:
         ActualCommand(actualCommand),
         BlockingFlagQueue(size, MTS_NOT_BLOCKING)
     {
+        this->QueuedKind = MTS_COMMAND_KIND_QUEUED_WRITE;
         mtsCommandWriteBase *cmd = 0;
         FinishedEventQueue.SetSize(size, cmd);
         this->SetArgumentPrototype(ActualCommand->GetArgumentPrototype());
@@ -104,6 +114,27 @@ public:
 
     virtual mtsGenericObject * ArgumentGet(void) = 0;
 
+
+    /*! Zero-copy queuing.  ArgumentReserve returns a pointer to the
+      next free slot of the arguments queue so the caller can fill the
+      argument in place, then ExecuteReserved queues the command
+      using the reserved slot.  The handler receives a reference on
+      the queued slot, i.e. the argument is never copied.  Returns 0
+      if the arguments queue is full or if the command doesn't support
+      zero-copy queuing (e.g. filtered commands).  Must be used by the
+      same thread as Execute. */
+    inline virtual mtsGenericObject * ArgumentReserve(void) {
+        return 0;
+    }
+
+    /*! Queue the command using the argument slot returned by the
+      last call to ArgumentReserve.  See Execute for the possible
+      return values.  Returns COMMAND_ARGUMENT_QUEUE_FULL, without
+      queuing anything, if ArgumentReserve has not been called or
+      failed since the last call to ExecuteReserved. */
+    mtsExecutionResult ExecuteReserved(mtsBlockingType blocking,
+                                       mtsCommandWriteBase * finishedEventHandler = 0);
+
     mtsBlockingType BlockingFlagGet(void);
 
     mtsCommandWriteBase *FinishedEventGet(void);
@@ -495,6 +495,15 @@ class CISST_EXPORT mtsComponent: public cmnGenericObject
         return this->ProcessMailBoxes(InterfacesProvided);
     }
 
+    /*! Process queued commands until the deadline is reached.  The
+      deadline is expressed in the relative time of the component
+      manager's time server (see mtsManagerLocal::GetTimeServer).
+      This can be used by periodic tasks to bound the time spent
+      processing commands.  Returns the number of commands processed
+      and sets deferred to the number of commands left in the
+      mailboxes. */
+    size_t ProcessQueuedCommands(double deadline, size_t & deferred);
+
     /*! Process all queued events. Returns number of events processed.
       These are the commands queued following events currently observed
       via the required interfaces. */
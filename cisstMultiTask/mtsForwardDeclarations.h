@@ -54,6 +54,23 @@ typedef enum {MTS_OPTIONAL, MTS_REQUIRED} mtsRequiredType;
 /*! Type to define is a command is blocking or not */
 typedef enum {MTS_BLOCKING, MTS_NOT_BLOCKING} mtsBlockingType;
 
+/*! Producer policy for mailboxes.  A mailbox with a single producer
+  is used by a single required interface.  A mailbox with multiple
+  producers can be shared by all the required interfaces connected to
+  a provided interface. */
+typedef enum {MTS_MAILBOX_SINGLE_PRODUCER, MTS_MAILBOX_MULTIPLE_PRODUCERS} mtsMailBoxProducerPolicy;
+
+/*! Kind of queued command.  This is set by the constructor of each
+  queued command so that mtsMailBox can dispatch without RTTI.  Non
+  queued commands use MTS_COMMAND_KIND_NOT_QUEUED. */
+typedef enum {MTS_COMMAND_KIND_NOT_QUEUED,
+              MTS_COMMAND_KIND_QUEUED_VOID,
+              MTS_COMMAND_KIND_QUEUED_WRITE,
+              MTS_COMMAND_KIND_QUEUED_READ,
+              MTS_COMMAND_KIND_QUEUED_QUALIFIED_READ,
+              MTS_COMMAND_KIND_QUEUED_VOID_RETURN,
+              MTS_COMMAND_KIND_QUEUED_WRITE_RETURN} mtsCommandQueuedKind;
+
 // commands
 class mtsCommandBase;
 
@@ -107,6 +107,30 @@ public:
     }
 #endif
 
+    /*! Zero-copy execution for queued commands.  ArgumentReserve
+      returns a pointer to a free slot in the arguments queue of the
+      command.  The caller can fill the argument in place and then
+      call ExecuteReserved to queue the command.  The handler will
+      receive a reference on the same slot, so the argument is never
+      copied.  ArgumentReserve returns 0 if the command is not queued,
+      doesn't support zero-copy (e.g. filtered commands) or if the
+      arguments queue is full.  ExecuteReserved returns
+      COMMAND_ARGUMENT_QUEUE_FULL and doesn't queue anything if there
+      is no reserved argument, i.e. if ArgumentReserve hasn't been
+      called or failed since the last call to ExecuteReserved.  Only
+      non blocking calls are supported. */
+    //@{
+    mtsGenericObject * ArgumentReserve(void) const;
+    mtsExecutionResult ExecuteReserved(void) const;
+#ifndef SWIG
+    template <class _userType>
+    _userType * ArgumentReserve(void) const {
+        mtsGenericObject * slot = ArgumentReserve();
+        return slot ? mtsGenericTypes<_userType>::CastArg(*slot) : 0;
+    }
+#endif
+    //@}
+
     /*! Access to underlying command object. */
     CommandType * GetCommand(void) const;
 
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -202,6 +202,23 @@ class CISST_EXPORT mtsInterfaceProvided: public mtsInterface {
       queues.  See SetMailBoxSize and SetArgumentQueuesSize. */
     void SetMailBoxAndArgumentQueuesSize(size_t desiredSize);
 
+    /*! Set the producer policy for mailboxes.  By default
+      (MTS_MAILBOX_SINGLE_PRODUCER), a mailbox is created for each
+      connected required interface and ProcessMailBoxes has to poll
+      all of them.  When using MTS_MAILBOX_MULTIPLE_PRODUCERS, a
+      single lock-free mailbox is shared by all connected required
+      interfaces.  Each required interface still gets its own copy of
+      the queued commands and argument queues.  The shared mailbox is
+      created using the current mail box size (see SetMailBoxSize),
+      which should be large enough for all users.
+
+      The producer policy can't be changed once a required interface
+      is connected to the provided interface. */
+    void SetMailBoxProducerPolicy(mtsMailBoxProducerPolicy policy);
+
+    /*! Get the current mailbox producer policy. */
+    mtsMailBoxProducerPolicy GetMailBoxProducerPolicy(void) const { return MailBoxProducerPolicy; }
+
     /*! Get the names of commands provided by this interface. */
     //@{
     std::vector<std::string> GetNamesOfCommands(void) const;
@@ -556,6 +573,14 @@ class CISST_EXPORT mtsInterfaceProvided: public mtsInterface {
       interface for thread safety. */
     size_t ProcessMailBoxes(void);
 
+    /*! Method used to process commands queued in mailboxes until the
+      time server's relative time reaches the deadline.  Each mailbox
+      is drained in a single batch (see mtsMailBox::ExecuteBatch).
+      The number of commands left in the mailboxes is added to
+      deferred.  This method should only be used by the component
+      that owns the interface for thread safety. */
+    size_t ProcessMailBoxes(const osaTimeServer & timeServer, double deadline, size_t & deferred);
+
     /*! Send a human readable description of the interface. */
     void ToStream(std::ostream & outputStream) const;
 
@@ -640,6 +665,15 @@ protected: // PK TEMP
     /*! Size to be used for argument queues */
     size_t ArgumentQueuesSize;
 
+    /*! Producer policy for mailboxes, see SetMailBoxProducerPolicy */
+    mtsMailBoxProducerPolicy MailBoxProducerPolicy;
+
+    /*! Mailbox shared by all end user interfaces when the producer
+      policy is MTS_MAILBOX_MULTIPLE_PRODUCERS.  This is owned by
+      the original interface and created along the first end user
+      interface. */
+    mtsMailBox * SharedMailBox;
+
     /*! Command to trigger void event for blocking commands. */
     mtsCommandVoid * BlockingCommandExecuted;
 
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -26,6 +26,7 @@ http://www.cisst.org/cisst/license.txt.
 #ifndef _mtsMailBox_h
 #define _mtsMailBox_h
 
+#include <cisstOSAbstraction/osaForwardDeclarations.h>
 #include <cisstMultiTask/mtsQueue.h>
 
 // Always include last
@@ -35,8 +36,17 @@ class mtsExecutionResult;
 
 class CISST_EXPORT mtsMailBox
 {
+    /*! Queue of commands used when the mailbox has a single
+      producer, i.e. a single required interface. */
     mtsQueue<mtsCommandBase *> CommandQueue;
 
+    /*! Queue of commands used when the mailbox is shared between
+      multiple producers. */
+    mtsQueueMPSC<mtsCommandBase *> CommandQueueMPSC;
+
+    /*! Determines which queue is used */
+    mtsMailBoxProducerPolicy ProducerPolicy;
+
     /*! Name provided for logs */
     std::string Name;
 
@@ -66,16 +76,61 @@ class CISST_EXPORT mtsMailBox
     void TriggerFinishedEventIfNeeded(const std::string &commandName, mtsCommandWriteBase *finishedEvent,
                                       mtsGenericObject *resultPointer, const mtsExecutionResult &result) const;
 
+    /*! Peek and remove commands from the queue based on producer
+      policy.  PeekCommand(offset) returns the command queued after
+      the oldest one, RemoveCommands removes the count oldest
+      commands at once. */
+    //@{
+    inline mtsCommandBase ** PeekCommand(void) const {
+        return (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) ? CommandQueue.Peek() : CommandQueueMPSC.Peek();
+    }
+    inline mtsCommandBase ** PeekCommand(size_t offset) const {
+        return (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) ? CommandQueue.Peek(offset) : CommandQueueMPSC.Peek(offset);
+    }
+    inline void RemoveCommand(void) {
+        if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+            CommandQueue.Get();
+        } else {
+            CommandQueueMPSC.Get();
+        }
+    }
+    inline void RemoveCommands(size_t count) {
+        if (ProducerPolicy == MTS_MAILBOX_SINGLE_PRODUCER) {
+            CommandQueue.Remove(count);
+        } else {
+            CommandQueueMPSC.Remove(count);
+        }
+    }
+    //@}
+
+    /*! Execute a command found in the queue.  If removeCommand is
+      true, the command is removed from the queue before the finished
+      event is triggered (or the exception re-thrown).  Otherwise the
+      caller is responsible for removing the command.  Returns false
+      if the command kind is not supported. */
+    bool ExecuteCommand(mtsCommandBase * command, bool removeCommand);
+
 public:
+    /*! Constructor.  The producer policy determines if Write can be
+      called by multiple threads concurrently
+      (MTS_MAILBOX_MULTIPLE_PRODUCERS) or by a single thread
+      (MTS_MAILBOX_SINGLE_PRODUCER).  ExecuteNext must always be
+      called by a single thread. */
     mtsMailBox(const std::string & name,
                size_t size,
-               mtsCallableVoidBase * postCommandQueuedCallable = 0);
+               mtsCallableVoidBase * postCommandQueuedCallable = 0,
+               mtsMailBoxProducerPolicy producerPolicy = MTS_MAILBOX_SINGLE_PRODUCER);
 
     ~mtsMailBox(void);
 
     /*! Get the mailbox's name */
     const std::string & GetName(void) const;
 
+    /*! Get the producer policy set in constructor */
+    inline mtsMailBoxProducerPolicy GetProducerPolicy(void) const {
+        return ProducerPolicy;
+    }
+
     /*! Write a command to the mailbox.  If a post command queued
       command has been provided, the command is executed. */
     bool Write(mtsCommandBase * command);
@@ -83,6 +138,22 @@ public:
     /*! Execute the oldest command queued. */
     bool ExecuteNext(void);
 
+    /*! Execute up to maxCount queued commands in a single pass.
+      Commands are removed from the queue once, after the last command
+      executed, so producers see the freed slots at the end of the
+      batch.  If a time server is provided, the batch stops as soon as
+      the time server's relative time reaches deadline (at least one
+      command is always executed so the mailbox keeps making
+      progress).  The number of commands left in the mailbox is
+      returned in deferred.  Returns the number of commands
+      executed.  As for ExecuteNext, this method must be called by
+      the consumer thread only. */
+    size_t ExecuteBatch(size_t maxCount, const osaTimeServer * timeServer,
+                        double deadline, size_t & deferred);
+
+    /*! Returns the number of commands queued. */
+    size_t GetAvailable(void) const;
+
     /*! Resize the mailbox, i.e. resizes the underlying queue of
       commands.  This command is not thread safe and shouldn't be used
       if commands are already queued or can be queued.  The SetSize
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2010 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -27,14 +27,28 @@ http://www.cisst.org/cisst/license.txt.
 #ifndef _mtsQueue_h
 #define _mtsQueue_h
 
+#include <cisstOSAbstraction/osaAtomic.h>
 #include <cisstMultiTask/mtsGenericObjectProxy.h>
 
 /*!
   \ingroup cisstMultiTask
 
-  Defines a queue that can be accessed in a thread-safe manner,
-  assuming that there is only one reader and one writer and that
-  pointer updates are atomic.
+  Defines a lock-free queue that can be accessed in a thread-safe
+  manner, assuming that there is only one reader and one writer.
+
+  The head (written by the producer) and tail (written by the
+  consumer) are free running counters stored on separate cache lines.
+  The head is published with release semantic after the element has
+  been copied and read with acquire semantic by the consumer (and
+  vice versa for the tail) so the queue is correct under the C++
+  memory model.  Each side also keeps a cached copy of the other
+  side's counter so the shared cache line is only read when the queue
+  looks full (producer) or empty (consumer).
+
+  The number of slots allocated is rounded up to the next power of
+  two so the slot can be found by masking the counter.  The queue
+  still holds at most <code>size - 1</code> elements, where size is
+  the value passed to the constructor or SetSize.
 */
 template<class _elementType>
 class mtsQueue
@@ -49,38 +63,66 @@ public:
     typedef size_t index_type;
 
 protected:
+    // shared, only modified by constructor and SetSize
     pointer Data;
-    pointer Head;
-    pointer Tail;
-    pointer Sentinel;  // end marker
     size_type Size;
+    size_type Capacity;
+    index_type Mask;
+    char PaddingData[OSA_CACHE_LINE_SIZE];
+
+    // producer's cache line
+    osaAtomic<index_type> Head;
+    index_type TailCache;
+    bool Reserved;
+    char PaddingHead[OSA_CACHE_LINE_SIZE - sizeof(index_type)];
+
+    // consumer's cache line
+    osaAtomic<index_type> Tail;
+    mutable index_type HeadCache;
+    char PaddingTail[OSA_CACHE_LINE_SIZE - sizeof(index_type)];
 
     // private method, can only be used once by constructor.  Doesn't support resize!
     void Allocate(size_type size, const_reference value) {
         this->Size = size;
-        if (this->Size > 0) {
-            this->Data = new value_type[this->Size];
+        // head == tail implies empty queue, one slot less than size to
+        // remain compatible with the previous implementation
+        this->Capacity = (size > 0) ? (size - 1) : 0;
+        if (this->Capacity > 0) {
+            const size_type slots = osaAtomicNextPowerOfTwo(this->Capacity);
+            this->Data = new value_type[slots];
+            this->Mask = slots - 1;
             index_type index;
-            for (index = 0; index < this->Size; index++) {
+            for (index = 0; index < slots; index++) {
                 new(&this->Data[index]) value_type(value);
             }
         } else {
             this->Data = 0;
+            this->Mask = 0;
         }
-        // head == tail implies empty queue
-        this->Head = this->Data;
-        this->Tail = this->Data;
-        this->Sentinel = this->Data + this->Size;
+        this->Head.StoreRelaxed(0);
+        this->TailCache = 0;
+        this->Reserved = false;
+        this->Tail.StoreRelaxed(0);
+        this->HeadCache = 0;
     }
 
+private:
+    // non copyable
+    mtsQueue(const mtsQueue & CMN_UNUSED(other));
+    mtsQueue & operator = (const mtsQueue & CMN_UNUSED(other));
+
 public:
 
     inline mtsQueue(void):
         Data(0),
+        Size(0),
+        Capacity(0),
+        Mask(0),
         Head(0),
+        TailCache(0),
+        Reserved(false),
         Tail(0),
-        Sentinel(0),
-        Size(0)
+        HeadCache(0)
     {}
 
 
@@ -112,31 +154,26 @@ public:
       of slots used. */
     inline size_type GetAvailable(void) const
     {
-        ptrdiff_t available = Head - Tail;
-        if (available < 0) {
-            available += Size;
-        }
-        return available;
+        // load tail first, head can only move forward
+        const index_type tail = this->Tail.Load();
+        return this->Head.Load() - tail;
     }
 
 
     /*! Returns true if queue is full. */
     inline bool IsFull(void) const {
-        pointer oneAfterHead = this->Head + 1;
-        if (oneAfterHead >= this->Sentinel) {
-            oneAfterHead = this->Data;
-        }
-        return oneAfterHead == this->Tail;
+        return this->GetAvailable() >= this->Capacity;
     }
 
 
     /*! Returns true if queue is empty. */
     inline bool IsEmpty(void) const {
-        return Head == Tail;
+        return this->GetAvailable() == 0;
     }
 
 
-    /*! Copy an object to the queue.
+    /*! Copy an object to the queue.  Must only be called by the
+      producer thread.
       \param in reference to the object to be copied
       \result Pointer to element in queue (use iterator instead?)
     */
@@ -145,54 +182,361 @@ public:
     //then we use the ProxyBase instead, so that we can also accept ProxyRef objects.
     inline const_pointer Put(const typename mtsGenericTypesUnwrap<value_type>::BaseType &newObject)
     {
-        pointer newHead = this->Head + 1;
-        // test if end of buffer (same as IsFull method)
-        if (newHead >= this->Sentinel) {
-            newHead = this->Data;
-        }
-        // test if full
-        if (newHead == this->Tail) {
+        pointer slot = this->Reserve();
+        if (!slot) {
             return 0;    // queue full
         }
-        // queue new object and move head
-        *(this->Head) = newObject;
-        this->Head = newHead;
-        return this->Head;
+        // queue new object and publish head
+        *slot = newObject;
+        this->Commit();
+        return slot;
+    }
+
+
+    /*! Get a pointer to the next free slot without queuing it.  The
+      producer can fill the slot in place and then use Commit to make
+      it available to the consumer.  Calling Reserve again before
+      Commit returns the same slot.  Must only be called by the
+      producer thread.
+      \result Pointer to free slot, 0 if the queue is full
+    */
+    inline pointer Reserve(void)
+    {
+        const index_type head = this->Head.LoadRelaxed();
+        // test if full, only reload the consumer's tail if needed
+        if (head - this->TailCache >= this->Capacity) {
+            this->TailCache = this->Tail.Load();
+            if (head - this->TailCache >= this->Capacity) {
+                return 0;    // queue full
+            }
+        }
+        this->Reserved = true;
+        return this->Data + (head & this->Mask);
+    }
+
+
+    /*! Publish the slot returned by the last call to Reserve.  Must
+      only be called by the producer thread.
+      \result false if no slot has been reserved since the last
+      Commit, e.g. if Reserve failed because the queue was full
+    */
+    inline bool Commit(void)
+    {
+        if (!this->Reserved) {
+            return false;
+        }
+        this->Reserved = false;
+        this->Head.Store(this->Head.LoadRelaxed() + 1);
+        return true;
     }
 
 
     /*! Get a pointer to the next object to be read, but do not
-        remove the item from the queue.
+        remove the item from the queue.  Must only be called by the
+        consumer thread.
         \result Pointer to top element in queue (use iterator instead?)
      */
     inline pointer Peek(void) const {
-        if (this->IsEmpty()) {
-            return 0;
+        const index_type tail = this->Tail.LoadRelaxed();
+        // test if empty, only reload the producer's head if needed
+        if (tail == this->HeadCache) {
+            this->HeadCache = this->Head.Load();
+            if (tail == this->HeadCache) {
+                return 0;
+            }
         }
-        return this->Tail;
+        return this->Data + (tail & this->Mask);
     }
 
 
-    /*! Pop the next object to be read from the queue.
+    /*! Pop the next object to be read from the queue.  Must only be
+        called by the consumer thread.
         \result Pointer to element just popped (use iterator instead?)
      */
     inline pointer Get(void) {
-        if (this->IsEmpty()) {
+        pointer result = this->Peek();
+        if (result) {
+            this->Tail.Store(this->Tail.LoadRelaxed() + 1);
+        }
+        return result;
+    }
+
+
+    /*! Get a pointer to the object at position offset from the next
+        object to be read, without removing anything from the queue.
+        Peek(0) is equivalent to Peek().  Must only be called by the
+        consumer thread.  Returns 0 if fewer than offset + 1 objects
+        are queued. */
+    inline pointer Peek(size_type offset) const {
+        const index_type tail = this->Tail.LoadRelaxed();
+        if (this->HeadCache - tail <= offset) {
+            this->HeadCache = this->Head.Load();
+            if (this->HeadCache - tail <= offset) {
+                return 0;
+            }
+        }
+        return this->Data + ((tail + offset) & this->Mask);
+    }
+
+
+    /*! Remove count objects from the queue, publishing the new tail
+        only once.  This should be used after processing objects
+        found with Peek(offset).  Must only be called by the consumer
+        thread and count must not be greater than the number of
+        objects available. */
+    inline void Remove(size_type count) {
+        if (count > 0) {
+            this->Tail.Store(this->Tail.LoadRelaxed() + count);
+        }
+    }
+
+};
+
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Defines a bounded lock-free queue that can be written by multiple
+  producers and read by a single consumer.  This is based on the
+  bounded queue described by Dmitry Vyukov: each slot carries a
+  sequence number used to detect whether it is free for the producer
+  (sequence equal to head) or ready for the consumer (sequence equal
+  to tail + 1).  Producers reserve a slot using a compare and exchange
+  on the head and publish the element by storing the slot sequence
+  with release semantic.  The consumer never writes the head so it
+  doesn't contend with producers.
+
+  The capacity is rounded up to the next power of two.
+*/
+template<class _elementType>
+class mtsQueueMPSC
+{
+public:
+    typedef _elementType value_type;
+    typedef value_type * pointer;
+    typedef const value_type * const_pointer;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef size_t size_type;
+    typedef size_t index_type;
+
+protected:
+    class Slot {
+    public:
+        osaAtomic<index_type> Sequence;
+        value_type Value;
+    };
+
+    // shared, only modified by constructor and SetSize
+    Slot * Data;
+    size_type Size;
+    index_type Mask;
+    char PaddingData[OSA_CACHE_LINE_SIZE];
+
+    // producers' cache line
+    osaAtomic<index_type> Head;
+    char PaddingHead[OSA_CACHE_LINE_SIZE];
+
+    // consumer's cache line
+    osaAtomic<index_type> Tail;
+    char PaddingTail[OSA_CACHE_LINE_SIZE];
+
+    void Allocate(size_type size, const_reference value) {
+        this->Size = (size > 0) ? osaAtomicNextPowerOfTwo(size) : 0;
+        if (this->Size > 0) {
+            this->Data = new Slot[this->Size];
+            this->Mask = this->Size - 1;
+            index_type index;
+            for (index = 0; index < this->Size; index++) {
+                this->Data[index].Sequence.StoreRelaxed(index);
+                this->Data[index].Value = value;
+            }
+        } else {
+            this->Data = 0;
+            this->Mask = 0;
+        }
+        this->Head.StoreRelaxed(0);
+        this->Tail.StoreRelaxed(0);
+        osaAtomicThreadFence();
+    }
+
+private:
+    // non copyable
+    mtsQueueMPSC(const mtsQueueMPSC & CMN_UNUSED(other));
+    mtsQueueMPSC & operator = (const mtsQueueMPSC & CMN_UNUSED(other));
+
+public:
+    inline mtsQueueMPSC(void):
+        Data(0),
+        Size(0),
+        Mask(0),
+        Head(0),
+        Tail(0)
+    {}
+
+
+    inline mtsQueueMPSC(size_type size, const_reference value) {
+        Allocate(size, value);
+    }
+
+
+    inline ~mtsQueueMPSC() {
+        delete [] Data;
+    }
+
+
+    /*! Sets the size of the queue (destructive, i.e. won't preserve
+      previously queued elements).  Not thread safe. */
+    inline void SetSize(size_type size, const_reference value) {
+        delete [] Data;
+        this->Allocate(size, value);
+    }
+
+
+    /*! Returns size of queue, i.e. requested size rounded up to a
+      power of two. */
+    inline size_type GetSize(void) const {
+        return Size;
+    }
+
+
+    /*! Returns number of elements available in queue.  This includes
+      elements reserved by a producer but not yet published. */
+    inline size_type GetAvailable(void) const {
+        const index_type tail = this->Tail.Load();
+        return this->Head.Load() - tail;
+    }
+
+
+    /*! Returns true if queue is full. */
+    inline bool IsFull(void) const {
+        return this->GetAvailable() >= this->Size;
+    }
+
+
+    /*! Returns true if no element has been queued.  This is only
+      exact when called by the consumer thread. */
+    inline bool IsEmpty(void) const {
+        return this->GetAvailable() == 0;
+    }
+
+
+    /*! Copy an object to the queue.  Can be called concurrently by
+      any number of producers.
+      \result Pointer to element in queue, 0 if the queue is full
+    */
+    inline const_pointer Put(const typename mtsGenericTypesUnwrap<value_type>::BaseType & newObject) {
+        if (this->Size == 0) {
+            return 0;
+        }
+        Slot * slot;
+        index_type head = this->Head.LoadRelaxed();
+        for (;;) {
+            slot = this->Data + (head & this->Mask);
+            const index_type sequence = slot->Sequence.Load();
+            const ptrdiff_t difference =
+                static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(head);
+            if (difference == 0) {
+                // slot is free, try to reserve it
+                if (this->Head.CompareExchange(head, head + 1)) {
+                    break;
+                }
+                // head has been updated by CompareExchange
+            } else if (difference < 0) {
+                return 0; // queue full
+            } else {
+                // another producer reserved this slot, reload head
+                head = this->Head.LoadRelaxed();
+            }
+        }
+        slot->Value = newObject;
+        slot->Sequence.Store(head + 1);
+        return &(slot->Value);
+    }
+
+
+    /*! Get a pointer to the next object to be read, but do not
+        remove the item from the queue.  Must only be called by the
+        consumer thread.  Returns 0 if the queue is empty or if the
+        oldest reserved slot has not been published yet.
+     */
+    inline pointer Peek(void) const {
+        if (this->Size == 0) {
             return 0;
         }
-        pointer result = this->Tail;
-        this->Tail++;
-        if (this->Tail >= this->Sentinel) {
-            this->Tail = this->Data;
+        const index_type tail = this->Tail.LoadRelaxed();
+        Slot * slot = this->Data + (tail & this->Mask);
+        if (slot->Sequence.Load() != tail + 1) {
+            return 0;
+        }
+        return &(slot->Value);
+    }
+
+
+    /*! Pop the next object to be read from the queue.  Must only be
+        called by the consumer thread.  The slot is released to
+        producers, so the returned pointer should be used before the
+        next Put.  Use Peek, process and then Get otherwise.
+     */
+    inline pointer Get(void) {
+        pointer result = this->Peek();
+        if (result) {
+            const index_type tail = this->Tail.LoadRelaxed();
+            Slot * slot = this->Data + (tail & this->Mask);
+            this->Tail.Store(tail + 1);
+            slot->Sequence.Store(tail + this->Size);
         }
         return result;
     }
 
+
+    /*! Get a pointer to the object at position offset from the next
+        object to be read, without removing anything from the queue.
+        Must only be called by the consumer thread.  Returns 0 if the
+        slot has not been published yet. */
+    inline pointer Peek(size_type offset) const {
+        if (offset >= this->Size) {
+            return 0;
+        }
+        const index_type index = this->Tail.LoadRelaxed() + offset;
+        Slot * slot = this->Data + (index & this->Mask);
+        if (slot->Sequence.Load() != index + 1) {
+            return 0;
+        }
+        return &(slot->Value);
+    }
+
+
+    /*! Remove count objects from the queue.  Each slot is released to
+        producers and the tail is published once.  Must only be called
+        by the consumer thread and count must not be greater than the
+        number of objects found using Peek(offset). */
+    inline void Remove(size_type count) {
+        if (count > 0) {
+            const index_type tail = this->Tail.LoadRelaxed();
+            this->Tail.Store(tail + count);
+            index_type index;
+            for (index = tail; index < tail + count; ++index) {
+                this->Data[index & this->Mask].Sequence.Store(index + this->Size);
+            }
+        }
+    }
 };
 
 
 
+/*!
+  \ingroup cisstMultiTask
 
+  Defines a single reader, single writer lock-free queue of generic
+  objects.  The objects are created using the class services of the
+  element provided to the constructor or SetSize.  Since these
+  objects can be large (e.g. images), the number of slots is not
+  rounded up to a power of two, one extra slot is allocated to
+  differentiate a full queue from an empty one.  See mtsQueue for the
+  memory ordering.
+*/
 class mtsQueueGeneric
 {
 public:
@@ -205,12 +549,20 @@ public:
     typedef size_t index_type;
 
 protected:
+    // shared, only modified by constructor and SetSize
     const cmnClassServicesBase * ClassServices;
     pointer * Data;
-    pointer * Head;
-    pointer * Tail;
-    pointer * Sentinel;  // end marker
     size_type Size;
+    char PaddingData[OSA_CACHE_LINE_SIZE];
+
+    // producer's cache line, head is an index in [0, Size[
+    osaAtomic<index_type> Head;
+    bool Reserved;
+    char PaddingHead[OSA_CACHE_LINE_SIZE];
+
+    // consumer's cache line, tail is an index in [0, Size[
+    osaAtomic<index_type> Tail;
+    char PaddingTail[OSA_CACHE_LINE_SIZE];
 
     // private method, can only be used once by constructor.  Doesn't support resize!
     void Allocate(size_type size, const_reference value) {
@@ -233,29 +585,41 @@ protected:
             this->Data = 0;
         }
         // head == tail implies empty queue
-        this->Head = this->Data;
-        this->Tail = this->Data;
-        this->Sentinel = this->Data + this->Size;
+        this->Head.StoreRelaxed(0);
+        this->Reserved = false;
+        this->Tail.StoreRelaxed(0);
     }
 
     void Free(void) {
-        size_t index;
-        for (index = 0; index < this->Size; index++) {
-            delete this->Data[index];
+        if (this->Data) {
+            size_t index;
+            for (index = 0; index < this->Size; index++) {
+                delete this->Data[index];
+            }
+            delete [] this->Data;
+            this->Data = 0;
         }
-        delete [] this->Data;
-        this->Data = 0;
     }
 
+    inline index_type Next(const index_type index) const {
+        const index_type next = index + 1;
+        return (next >= this->Size) ? 0 : next;
+    }
+
+private:
+    // non copyable
+    mtsQueueGeneric(const mtsQueueGeneric & CMN_UNUSED(other));
+    mtsQueueGeneric & operator = (const mtsQueueGeneric & CMN_UNUSED(other));
+
 public:
 
     inline mtsQueueGeneric(void):
         ClassServices(0),
         Data(0),
+        Size(1),
         Head(0),
-        Tail(0),
-        Sentinel(0),
-        Size(1)
+        Reserved(false),
+        Tail(0)
     {}
 
 
@@ -303,7 +667,8 @@ public:
       of slots used. */
     inline size_type GetAvailable(void) const
     {
-        ptrdiff_t available = Head - Tail;
+        ptrdiff_t available =
+            static_cast<ptrdiff_t>(this->Head.Load()) - static_cast<ptrdiff_t>(this->Tail.Load());
         if (available < 0) {
             available += Size;
         }
@@ -313,69 +678,93 @@ public:
 
     /*! Returns true if queue is full. */
     inline bool IsFull(void) const {
-        pointer * oneAfterHead = this->Head + 1;
-        if (oneAfterHead >= this->Sentinel) {
-            oneAfterHead = this->Data;
-        }
-        return oneAfterHead == this->Tail;
+        return this->Next(this->Head.Load()) == this->Tail.Load();
     }
 
 
     /*! Returns true if queue is empty. */
     inline bool IsEmpty(void) const {
-        return Head == Tail;
+        return this->Head.Load() == this->Tail.Load();
     }
 
 
-    /*! Copy an object to the queue.
+    /*! Copy an object to the queue.  Must only be called by the
+      producer thread.
       \param in reference to the object to be copied
       \result Pointer to element in queue (use iterator instead?)
     */
     inline const_pointer Put(const_reference newObject) {
-        pointer * newHead = this->Head + 1;
-        // test if end of buffer (same as IsFull method)
-        if (newHead >= this->Sentinel) {
-            newHead = this->Data;
-        }
-        // test if full
-        if (newHead == this->Tail) {
+        pointer slot = this->Reserve();
+        if (!slot) {
             return 0;    // queue full
         }
         // queue new object and move head
         // using in place new to make sure copy constructor is used
-        if (!this->ClassServices->Create(*(this->Head), newObject)) {
+        if (!this->ClassServices->Create(slot, newObject)) {
             // if Create fails, it does not modify the input parameter (this->Head)
             CMN_LOG_RUN_ERROR << "mtsQueueGeneric::Put failed for " << newObject.Services()->GetName() << std::endl;
+            this->Reserved = false;
             return 0;
         }
-        this->Head = newHead;
-        return *(this->Head);
+        this->Commit();
+        return slot;
+    }
+
+
+    /*! Get a pointer to the next free slot without queuing it.  The
+      slot contains a valid object (previously queued object or copy
+      of the prototype) that the producer can modify in place before
+      calling Commit.  Must only be called by the producer thread.
+      \result Pointer to free slot, 0 if the queue is full
+    */
+    inline pointer Reserve(void) {
+        const index_type head = this->Head.LoadRelaxed();
+        // test if full
+        if (this->Next(head) == this->Tail.Load()) {
+            return 0;    // queue full
+        }
+        this->Reserved = true;
+        return this->Data[head];
+    }
+
+
+    /*! Publish the slot returned by the last call to Reserve.  Must
+      only be called by the producer thread.
+      \result false if no slot has been reserved since the last
+      Commit, e.g. if Reserve failed because the queue was full
+    */
+    inline bool Commit(void) {
+        if (!this->Reserved) {
+            return false;
+        }
+        this->Reserved = false;
+        this->Head.Store(this->Next(this->Head.LoadRelaxed()));
+        return true;
     }
 
 
     /*! Get a pointer to the next object to be read, but do not
-        remove the item from the queue.
+        remove the item from the queue.  Must only be called by the
+        consumer thread.
         \result Pointer to top element in queue (use iterator instead?)
      */
     inline pointer Peek(void) const {
-        if (this->IsEmpty()) {
+        const index_type tail = this->Tail.LoadRelaxed();
+        if (tail == this->Head.Load()) {
             return 0;
         }
-        return *(this->Tail);
+        return this->Data[tail];
     }
 
 
-    /*! Pop the next object to be read from the queue.
+    /*! Pop the next object to be read from the queue.  Must only be
+        called by the consumer thread.
         \result Pointer to element just popped (use iterator instead?)
      */
     inline pointer Get(void) {
-        if (this->IsEmpty()) {
-            return 0;
-        }
-        pointer result = *(this->Tail);
-        this->Tail++;
-        if (this->Tail >= this->Sentinel) {
-            this->Tail = this->Data;
+        pointer result = this->Peek();
+        if (result) {
+            this->Tail.Store(this->Next(this->Tail.LoadRelaxed()));
         }
         return result;
     }
@@ -384,4 +773,3 @@ public:
 
 
 #endif // _mtsQueue_h
-
@@ -75,8 +75,13 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
 
  protected:
 
-    osaSocket Socket;
-    mtsProxySerializer *Serializer;
+    /*! Channel to the server proxy, UDP socket or shared memory. */
+    mtsSocketProxyChannel *Channel;
+
+    /*! Buffer used to receive and reassemble the messages from the server,
+        and deserializer used for the responses and events. */
+    mtsSocketProxyReceiveBuffer ReceiveBuffer;
+    mtsSocketProxyDeSerializer DeSerializer;
 
     mtsSocketProxyInitData ServerData;
 
@@ -115,6 +120,12 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
     */
     mtsSocketProxyClient(const std::string &name, const std::string &ip, short port);
 
+    /*! Constructor for a server proxy on the same host
+        \param name Name of the client proxy component
+        \param sharedMemoryName Name of the shared memory channel created by the server proxy
+    */
+    mtsSocketProxyClient(const std::string &name, const std::string &sharedMemoryName);
+
     mtsSocketProxyClient(const mtsSocketProxyClientConstructorArg &arg);
 
 
@@ -131,9 +142,7 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
 
     // Following used by command wrappers
     bool CheckForEventsImmediate(double timeoutInSec);
-    bool Serialize(const mtsGenericObject & originalObject, std::string & serializedObject);
-    bool DeSerialize(const std::string & serializedObject, mtsGenericObject & originalObject);
-    mtsGenericObject * DeSerialize(const std::string & serializedObject);
+    bool DeSerialize(const char * serializedObject, size_t size, mtsGenericObject & originalObject);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsSocketProxyClient)
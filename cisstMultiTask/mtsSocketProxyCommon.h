@@ -28,7 +28,11 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsSocketProxyCommon_h
 
 #include <string>
+#include <vector>
+#include <iostream>
 
+#include <cisstOSAbstraction/osaSocket.h>
+#include <cisstOSAbstraction/osaSharedMemoryChannel.h>
 #include <cisstMultiTask/mtsGenericObject.h>
 
 #include <cisstMultiTask/mtsExport.h>
@@ -39,8 +43,22 @@ class mtsFunctionQualifiedRead;
 
 namespace mtsSocketProxy {
 
-    const unsigned int SOCKET_PROXY_VERSION = 0;
-    const unsigned int SOCKET_PROXY_PACKET_SIZE = 512;
+    const unsigned int SOCKET_PROXY_VERSION = 1;
+
+    // Maximum size of the datagrams sent, including the fragment header; larger
+    // messages are fragmented.  The default fits in an Ethernet frame.
+    const unsigned int SOCKET_PROXY_PACKET_SIZE = 1400;
+
+    // Size of the buffer used to receive one datagram (largest UDP payload)
+    const unsigned int SOCKET_PROXY_MAX_DATAGRAM_SIZE = 65536;
+
+    // Fragment header (see mtsSocketProxySendBuffer)
+    const char SOCKET_PROXY_FRAGMENT_MARKER = 0x01;
+    const unsigned int SOCKET_PROXY_FRAGMENT_HEADER_SIZE = 12;
+
+    // First byte of a response, after the receive handle
+    const char SOCKET_PROXY_RESPONSE_ARGUMENT = 'A';   // serialized argument (return value)
+    const char SOCKET_PROXY_RESPONSE_RESULT = 'E';     // serialized mtsExecutionResult
 
 };
 
@@ -128,4 +146,236 @@ public:
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsSocketProxyInitData);
 
+
+/*! Transport used by the socket proxies to exchange datagrams, either a
+  UDP socket or a shared memory channel for proxies on the same host.  As
+  for UDP sockets, the destination is updated to the source of the last
+  datagram received. */
+class CISST_EXPORT mtsSocketProxyChannel
+{
+public:
+    virtual ~mtsSocketProxyChannel() {}
+
+    /*! Size of the largest datagram sent, including the fragment header. */
+    virtual unsigned int GetPacketSize(void) const = 0;
+
+    virtual void SetDestination(const osaIPandPort & ip_port) = 0;
+    virtual bool GetDestination(osaIPandPort & ip_port) const = 0;
+
+    /*! Send one datagram.  Returns the number of bytes sent or -1 on error. */
+    virtual int Send(const char * data, unsigned int size, double timeoutSec) = 0;
+
+    /*! Receive one datagram.  As osaSocket::Receive, the datagram is null
+      terminated so the buffer must hold maxlen + 1 bytes.  Returns 0 on
+      timeout. */
+    virtual int Receive(char * buffer, unsigned int maxlen, double timeoutSec) = 0;
+
+    virtual bool Close(void) = 0;
+
+    /*! Send a message in several datagrams of GetPacketSize bytes without
+      fragment header, see osaSocket::SendAsPackets. */
+    int SendAsPackets(const std::string & message, double timeoutSec);
+};
+
+/*! Channel using a UDP socket. */
+class CISST_EXPORT mtsSocketProxyChannelUDP : public mtsSocketProxyChannel
+{
+    osaSocket Socket;
+
+public:
+    mtsSocketProxyChannelUDP() : Socket(osaSocket::UDP) {}
+    ~mtsSocketProxyChannelUDP() {}
+
+    bool AssignPort(unsigned short port) { return Socket.AssignPort(port); }
+    void SetDestination(const std::string & host, unsigned short port) { Socket.SetDestination(host, port); }
+
+    unsigned int GetPacketSize(void) const { return mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE; }
+    void SetDestination(const osaIPandPort & ip_port) { Socket.SetDestination(ip_port); }
+    bool GetDestination(osaIPandPort & ip_port) const { return Socket.GetDestination(ip_port); }
+    int Send(const char * data, unsigned int size, double timeoutSec) { return Socket.Send(data, size, timeoutSec); }
+    int Receive(char * buffer, unsigned int maxlen, double timeoutSec) { return Socket.Receive(buffer, maxlen, timeoutSec); }
+    bool Close(void) { return Socket.Close(); }
+};
+
+/*! Channel using osaSharedMemoryChannel, for a server and its clients
+  running on the same host.  There is no packet size limit such as the
+  Ethernet frame, so datagrams are as large as the receive buffer and
+  most messages are sent without fragmentation.  Clients are identified
+  by their slot in the shared memory segment, i.e. the destination IP is
+  always "shm" and the port is the slot index. */
+class CISST_EXPORT mtsSocketProxyChannelSharedMemory : public mtsSocketProxyChannel
+{
+    osaSharedMemoryChannel Channel;
+
+public:
+    mtsSocketProxyChannelSharedMemory() {}
+    ~mtsSocketProxyChannelSharedMemory() {}
+
+    bool Create(const std::string & name,
+                unsigned int numberOfClients = osaSharedMemoryChannel::DEFAULT_NUMBER_OF_CLIENTS) {
+        return Channel.Create(name, numberOfClients);
+    }
+    bool Connect(const std::string & name) { return Channel.Connect(name); }
+
+    unsigned int GetPacketSize(void) const;
+    void SetDestination(const osaIPandPort & ip_port);
+    bool GetDestination(osaIPandPort & ip_port) const;
+    int Send(const char * data, unsigned int size, double timeoutSec) { return Channel.Send(data, size, timeoutSec); }
+    int Receive(char * buffer, unsigned int maxlen, double timeoutSec);
+    bool Close(void) { return Channel.Close(); }
+};
+
+/*! Stream buffer used to serialize objects at the end of an existing
+  string, i.e. without the intermediate copy of std::stringstream.  The
+  string keeps its capacity from one message to the next so there is no
+  memory allocation once the largest message has been serialized. */
+class CISST_EXPORT mtsSocketProxyAppendBuffer : public std::streambuf
+{
+    std::string * Target;
+
+protected:
+    int_type overflow(int_type c);
+    std::streamsize xsputn(const char * data, std::streamsize size);
+
+public:
+    mtsSocketProxyAppendBuffer(std::string * target = 0) : Target(target) {}
+    ~mtsSocketProxyAppendBuffer() {}
+
+    void SetTarget(std::string * target) { Target = target; }
+};
+
+/*! Stream buffer used to deserialize objects directly from a received
+  datagram or reassembled message. */
+class CISST_EXPORT mtsSocketProxyReadBuffer : public std::streambuf
+{
+public:
+    mtsSocketProxyReadBuffer() {}
+    ~mtsSocketProxyReadBuffer() {}
+
+    void SetSource(const char * data, size_t size);
+};
+
+/*! Deserialize objects using DeSerializeRaw, i.e. without the class
+  services information used by cmnDeSerializer.  Both sides of the socket
+  proxy know the argument types from the interface description. */
+class CISST_EXPORT mtsSocketProxyDeSerializer
+{
+    mtsSocketProxyReadBuffer Buffer;
+    std::istream Stream;
+
+public:
+    mtsSocketProxyDeSerializer() : Stream(&Buffer) {}
+    ~mtsSocketProxyDeSerializer() {}
+
+    bool DeSerialize(const char * data, size_t size, mtsGenericObject & object);
+};
+
+/*! Message sent by the socket proxies.  The message is built directly in
+  a buffer that is reused from one message to the next, with space reserved
+  in front for the fragment header:
+
+  - marker (SOCKET_PROXY_FRAGMENT_MARKER, 1 byte) and flags (1 byte)
+  - fragment index and number of fragments (unsigned short)
+  - fragment payload size (unsigned short)
+  - message sequence number (unsigned int)
+
+  A message that fits in one packet is sent without any copy.  Larger
+  messages are sent as several fragments; the header of each fragment
+  temporarily overwrites the end of the previous fragment, which has
+  already been sent, so they don't need to be copied either.  Objects are
+  serialized with SerializeRaw.  Each buffer uses its own range of sequence
+  numbers, so the fragments of messages sent by different buffers (e.g. an
+  event and a command response) can't be mixed up by the receiver. */
+class CISST_EXPORT mtsSocketProxySendBuffer
+{
+    std::string Buffer;
+    mtsSocketProxyAppendBuffer StreamBuffer;
+    std::ostream Stream;
+    unsigned int Sequence;
+
+public:
+    mtsSocketProxySendBuffer(size_t capacity = mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE);
+    ~mtsSocketProxySendBuffer() {}
+
+    /*! Start a new, empty, message. */
+    void Reset(void);
+
+    void Append(const char * data, size_t size) { Buffer.append(data, size); }
+    void Append(char c) { Buffer.push_back(c); }
+
+    /*! Serialize the object at the end of the message.  Returns false
+      if the serialization failed, in which case the message is
+      truncated to its previous size. */
+    bool Serialize(const mtsGenericObject & object);
+
+    /*! Size of the message, excluding the fragment header. */
+    size_t GetSize(void) const { return Buffer.size() - mtsSocketProxy::SOCKET_PROXY_FRAGMENT_HEADER_SIZE; }
+
+    /*! Beginning of the message, e.g. to replace a command handle before
+      sending the same message to a different client. */
+    char * GetData(void) { return &Buffer[mtsSocketProxy::SOCKET_PROXY_FRAGMENT_HEADER_SIZE]; }
+
+    /*! Send the message to the current destination of the channel, in
+      datagrams of at most channel.GetPacketSize() bytes.  Returns the
+      number of bytes sent, including the fragment headers, or -1 if any
+      datagram could not be sent. */
+    int Send(mtsSocketProxyChannel & channel, double timeoutSec = 0.05);
+};
+
+/*! Receive messages sent by mtsSocketProxySendBuffer.  Datagrams are
+  received in a preallocated buffer and messages sent in a single
+  datagram are used in place.  Fragmented messages are reassembled in a
+  second buffer which grows to the largest message received.  Fragments
+  of different messages from the same source are not expected to be
+  interleaved; a fragment from a new message (or source) discards the
+  message being reassembled.
+
+  Datagrams without fragment header (e.g. from clients using the
+  CommandString protocol, see mtsSocketProxyServer::Run) are returned
+  as is, see IsFramed. */
+class CISST_EXPORT mtsSocketProxyReceiveBuffer
+{
+    std::vector<char> Packet;
+    std::vector<char> Message;
+    std::vector<char> FragmentReceived;
+
+    // State of the message being reassembled
+    osaIPandPort Source;
+    unsigned int Sequence;
+    unsigned short NumberOfFragments;
+    unsigned short FragmentSize;
+    size_t FragmentsPending;
+    size_t MessageSize;
+    bool Reassembling;
+
+    // Last message received
+    const char * Data;
+    size_t Size;
+    bool Framed;
+
+    size_t MessagesDropped;
+
+    // Process one datagram, returns true if a message is complete
+    bool ProcessDatagram(mtsSocketProxyChannel & channel, size_t length);
+
+public:
+    mtsSocketProxyReceiveBuffer();
+    ~mtsSocketProxyReceiveBuffer() {}
+
+    /*! Receive the next complete message.  Returns the size of the
+      message, 0 if no message was completed before the timeouts and -1
+      on channel error.  After the first datagram, timeoutNextSec is used
+      to wait for the remaining fragments. */
+    int Receive(mtsSocketProxyChannel & channel, double timeoutStartSec, double timeoutNextSec);
+
+    const char * GetData(void) const { return Data; }
+    size_t GetSize(void) const { return Size; }
+
+    /*! False if the last message was received without fragment header. */
+    bool IsFramed(void) const { return Framed; }
+
+    /*! Number of partially reassembled messages dropped. */
+    size_t GetMessagesDropped(void) const { return MessagesDropped; }
+};
+
 #endif // _mtsSocketProxyCommon_h
@@ -29,6 +29,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstOSAbstraction/osaSocket.h>
 #include <cisstMultiTask/mtsTaskContinuous.h>
+#include <cisstMultiTask/mtsSocketProxyCommon.h>
 
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 
@@ -84,12 +85,24 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
 
  protected:
 
-    osaSocket Socket;
+    /*! Channel to the client proxies, UDP socket or shared memory. */
+    mtsSocketProxyChannel *Channel;
     mtsInterfaceProvidedDescription InterfaceDescription;
 
-    /*! Typedef for client connections. The current design of the cisst serializer
-        only sends the class services the first time an instance of the class is
-        serialized; thus we need a separate serializer for each client. */
+    /*! Buffers used for the CommandHandle protocol. Messages are received and
+        responses built in place, the arguments are serialized without the class
+        services (SerializeRaw) since both sides know their types from the
+        interface description. */
+    //@{
+    mtsSocketProxyReceiveBuffer ReceiveBuffer;
+    mtsSocketProxySendBuffer SendBuffer;
+    mtsSocketProxyDeSerializer DeSerializer;
+    //@}
+
+    /*! Typedef for client connections, only used by the CommandString protocol.
+        The current design of the cisst serializer only sends the class services the
+        first time an instance of the class is serialized; thus we need a separate
+        serializer for each client. */
     typedef std::map<osaIPandPort, mtsProxySerializer *> ClientMapType;
 
     /*! Typedef for function proxies */
@@ -139,6 +152,15 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
 
     void AddSpecialCommands(void);
     mtsExecutionResult GetInitData(std::string &outputArgSerialized, mtsProxySerializer *serializer) const;
+    mtsExecutionResult GetInitData(mtsSocketProxySendBuffer &outputArg) const;
+    void GetInitData(mtsSocketProxyInitData &init) const;
+
+    /*! Process a message using the CommandHandle protocol (framed) or the
+        CommandString protocol, see Run. */
+    //@{
+    void ProcessCommandHandle(const char *data, size_t size);
+    void ProcessCommandString(const std::string &message);
+    //@}
 
  public:
     /*! Constructor
@@ -150,6 +172,15 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
     mtsSocketProxyServer(const std::string & name, const std::string & componentName,
                          const std::string & providedInterfaceName, unsigned short port);
 
+    /*! Constructor for client proxies on the same host
+        \param name Name of the proxy component
+        \param componentName Name of the component for which proxy is being created
+        \param providedInterfaceName Name of the provided interface (from componentName) for which proxy is being created
+        \param sharedMemoryName Name of the shared memory channel (see osaSharedMemoryChannel) used by the client proxies
+    */
+    mtsSocketProxyServer(const std::string & name, const std::string & componentName,
+                         const std::string & providedInterfaceName, const std::string & sharedMemoryName);
+
     mtsSocketProxyServer(const mtsSocketProxyServerConstructorArg & arg);
 
     /*! Destructor */
@@ -174,7 +205,14 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
     */
     mtsProxySerializer *GetSerializerForCurrentClient(void) const;
 
-    mtsCommandWriteBase *AllocateFinishedEvent(const std::string &eventHandle);
+    /*! Allocate the finished event used to send the response of a blocking command.
+        \param eventHandle Handle of the client's event receiver (COMMAND_HANDLE_STRING_SIZE characters)
+        \param framed True for the CommandHandle protocol, false for the CommandString protocol
+    */
+    mtsCommandWriteBase *AllocateFinishedEvent(const char *eventHandle, bool framed);
+
+    /*! Return the deserializer used for the arguments of the CommandHandle protocol. */
+    mtsSocketProxyDeSerializer & GetDeSerializer(void);
 
 };
 
@@ -28,8 +28,10 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnLogger.h>
 #include <cisstCommon/cmnClassRegister.h>
+#include <cisstCommon/cmnThrow.h>
 #include <cisstMultiTask/mtsGenericObjectProxy.h>
 #include <cisstMultiTask/mtsStateArrayBase.h>
+#include <cisstMultiTask/mtsStateArrayColumnTraits.h>
 
 #include <vector>
 #include <typeinfo>
@@ -41,6 +43,20 @@ http://www.cisst.org/cisst/license.txt.
   the following template, where _elementType represents the type of
   data used by the particular state element. It is assumed that
   _elementType is derived from mtsGenericObject.
+
+  For plain data types (see mtsStateArrayColumnTraits), the history
+  can be stored in columns instead of a vector of objects (see
+  SetColumnar).  In this mode, there is no object to refer to:
+
+  - the const methods returning a reference on an element (Element,
+    operator[]) throw an exception, readers have to copy the element
+    with CopyElement, Get or ElementToStream, which are safe for
+    concurrent readers.
+
+  - the non const methods (Element, operator[]) rebuild the element in
+    a scratch object owned by the array.  The reference is only valid
+    until the next call and these methods can only be used by the
+    thread writing in the array.
  */
 
 template <class _elementType>
@@ -52,12 +68,43 @@ public:
     typedef std::vector<value_type> VectorType;
     typedef typename VectorType::iterator iterator;
     typedef typename VectorType::const_iterator const_iterator;
+    typedef mtsStateArrayColumnTraits<value_type> ColumnTraits;
 
 protected:
 	/*! A vector to store the data. These element of the vector
-	  represents the cell of the state data table. */
+	  represents the cell of the state data table.  In columnar mode,
+	  the vector only contains two elements, the first one is used as
+	  example and never modified, the second one is the scratch used
+	  by the non const methods. */
 	VectorType Data;
 
+    enum {COLUMNAR_EXAMPLE = 0, COLUMNAR_SCRATCH = 1};
+
+    /*! Rebuild an element from the columns. */
+    inline void ColumnToElement(index_type index, value_type & object) const {
+        void * destination = ColumnTraits::Destination(object, this->ColumnPayloadSize);
+        if (destination && (this->ColumnPayloadSize != 0)) {
+            memcpy(destination, &(this->ColumnValues[index * this->ColumnPayloadSize]), this->ColumnPayloadSize);
+        }
+        object.SetTimestamp(this->ColumnTimestamps[index]);
+        object.SetValid(this->ColumnValid[index] != 0);
+    }
+
+    /*! Copy an element in the columns.  Returns false if the payload
+      doesn't have the expected size. */
+    inline bool ElementToColumn(index_type index, const void * source, size_t size,
+                                const mtsGenericObject & object) {
+        if (size != this->ColumnPayloadSize) {
+            return false;
+        }
+        if (size != 0) {
+            memcpy(&(this->ColumnValues[index * size]), source, size);
+        }
+        this->ColumnTimestamps[index] = object.Timestamp();
+        this->ColumnValid[index] = object.Valid();
+        return true;
+    }
+
 public:
 	/*! Default constructor. Does nothing */
 	inline mtsStateArray(const value_type & objectExample,
@@ -70,23 +117,59 @@ public:
 
 
     bool SetDataSize(const size_t size){
+        if (this->Columnar) {
+            this->ColumnValues.resize(size * this->ColumnPayloadSize, 0);
+            this->ColumnTimestamps.resize(size, 0.0);
+            this->ColumnValid.resize(size, 0);
+            return true;
+        }
         value_type objectExample = Data[0];
         //\todo add try catch for alloc exception
         Data.resize(size,objectExample);
         return true;
     }
 
+    bool SetColumnar(bool columnar);
 
     /*! Access element at index. This returns the data of the derived type
       (value_type) rather than the base type (mtsGenericObject), which is
-      returned by the overloaded operator []. */
-    const value_type & Element(index_type index) const { return Data[index]; }
-    value_type & Element(index_type index) { return Data[index]; }
+      returned by the overloaded operator [].  In columnar mode, the
+      const version throws an exception (use CopyElement) and the non
+      const version returns the scratch element. */
+    const value_type & Element(index_type index) const {
+        if (this->Columnar) {
+            cmnThrow("mtsStateArray::Element: no reference on elements stored in columns, use CopyElement");
+        }
+        return Data[index];
+    }
+    value_type & Element(index_type index) {
+        if (this->Columnar) {
+            ColumnToElement(index, Data[COLUMNAR_SCRATCH]);
+            return Data[COLUMNAR_SCRATCH];
+        }
+        return Data[index];
+    }
+
+    /*! Copy the element at index.  Unlike Element, this is safe for
+      concurrent readers in columnar mode. */
+    inline void CopyElement(index_type index, value_type & object) const {
+        if (this->Columnar) {
+            ColumnToElement(index, object);
+        } else {
+            object = Data[index];
+        }
+    }
+
+    void ElementToStream(index_type index, std::ostream & outputStream) const;
+
+    inline const cmnClassServicesBase * ElementServices(void) const {
+        return Data[0].Services();
+    }
 
 	/*! Overloaded [] operator. Returns data at index (of type mtsGenericObject).
         Currently used for data collection (mtsCollectorState). */
-	inline mtsGenericObject & operator[](index_type index){ return Data[index]; }
-	inline const mtsGenericObject & operator[](index_type index) const { return Data[index]; }
+	inline mtsGenericObject & operator[](index_type index){ return Element(index); }
+	inline const mtsGenericObject & operator[](index_type index) const { return Element(index); }
 
 	/* Create the array of data. This is currently unused. */
     inline mtsStateArrayBase * Create(const mtsGenericObject * objectExample,
@@ -110,10 +193,25 @@ public:
 
 	/*! Copy data from one index to another within the same array.  */
 	inline void Copy(index_type indexTo, index_type indexFrom) {
+        if (this->Columnar) {
+            if ((indexTo != indexFrom) && (this->ColumnPayloadSize != 0)) {
+                memcpy(&(this->ColumnValues[indexTo * this->ColumnPayloadSize]),
+                       &(this->ColumnValues[indexFrom * this->ColumnPayloadSize]),
+                       this->ColumnPayloadSize);
+            }
+            this->ColumnTimestamps[indexTo] = this->ColumnTimestamps[indexFrom];
+            this->ColumnValid[indexTo] = this->ColumnValid[indexFrom];
+            return;
+        }
         this->Data[indexTo] = this->Data[indexFrom];
     }
 
 
+    mtsStateArrayBase * Clone(size_type size) const;
+
+    bool CopyFrom(index_type indexTo, const mtsStateArrayBase & source, index_type indexFrom);
+
+
 	/*! Get and Set data from array.  The Get and Set member functions
 	  deserve special mention because they must overcome a limitation
 	  of C++ -- namely, that it does not fully support containers of
@@ -138,6 +236,11 @@ bool mtsStateArray<_elementType>::Set(index_type index,  const mtsGenericObject
     // Case 1: The state table entry was derived from mtsGenericObject
     const _elementType *pdata = dynamic_cast<const _elementType *>(&object);
     if (pdata) {
+        if (this->Columnar) {
+            size_t size;
+            const void * source = ColumnTraits::Source(*pdata, size);
+            return this->ElementToColumn(index, source, size, object);
+        }
 		Data[index] = *pdata;
 		return true;
     }
@@ -145,6 +248,11 @@ bool mtsStateArray<_elementType>::Set(index_type index,  const mtsGenericObject
     typedef typename mtsGenericTypesUnwrap<_elementType>::RefType RefType;
     const RefType* pref = dynamic_cast<const RefType*>(&object);
 	if (pref) {
+        if (this->Columnar) {
+            size_t size;
+            const void * source = mtsStateArrayColumnTraits<RefType>::Source(*pref, size);
+            return this->ElementToColumn(index, source, size, object);
+        }
 		Data[index] = *pref;
 		return true;
 	}
@@ -157,12 +265,122 @@ template <class _elementType>
 bool mtsStateArray<_elementType>::Get(index_type index, mtsGenericObject & object) const {
 	_elementType* pdata = dynamic_cast<_elementType*>(&object);
 	if (pdata) {
-		*pdata = Data[index];
+        CopyElement(index, *pdata);
 		return true;
     }
     CMN_LOG_RUN_ERROR << "mtsStateArray::Get -- type mismatch, expected " << typeid(_elementType).name() << std::endl;
 	return false;
 }
 
+template <class _elementType>
+void mtsStateArray<_elementType>::ElementToStream(index_type index, std::ostream & outputStream) const
+{
+    if (this->Columnar) {
+        // the example is never modified in columnar mode, copy it so
+        // the element has the expected size
+        value_type element(Data[COLUMNAR_EXAMPLE]);
+        ColumnToElement(index, element);
+        element.ToStream(outputStream);
+    } else {
+        Data[index].ToStream(outputStream);
+    }
+}
+
+template <class _elementType>
+mtsStateArrayBase * mtsStateArray<_elementType>::Clone(size_type size) const
+{
+    mtsStateArray<_elementType> * array = new mtsStateArray<_elementType>(Data[0], size);
+    array->DataClassServices = this->DataClassServices;
+    array->ColumnSource = this->ColumnSource;
+    if (this->Columnar) {
+        array->SetColumnar(true);
+    }
+    return array;
+}
+
+template <class _elementType>
+bool mtsStateArray<_elementType>::CopyFrom(index_type indexTo, const mtsStateArrayBase & source, index_type indexFrom)
+{
+    if (this->Columnar && source.IsColumnar()) {
+        const size_t size = this->ColumnPayloadSize;
+        if (size != source.GetColumnPayloadSize()) {
+            return false;
+        }
+        if (size != 0) {
+            memcpy(&(this->ColumnValues[indexTo * size]), source.GetColumnValues() + indexFrom * size, size);
+        }
+        this->ColumnTimestamps[indexTo] = source.GetColumnTimestamps()[indexFrom];
+        this->ColumnValid[indexTo] = source.GetColumnValid()[indexFrom];
+        return true;
+    }
+    const mtsStateArray<_elementType> * typedSource = dynamic_cast<const mtsStateArray<_elementType> *>(&source);
+    if (!typedSource) {
+        CMN_LOG_RUN_ERROR << "mtsStateArray::CopyFrom -- type mismatch, expected " << typeid(_elementType).name() << std::endl;
+        return false;
+    }
+    if (this->Columnar) {
+        // go through the scratch element
+        value_type & scratch = Data[COLUMNAR_SCRATCH];
+        typedSource->CopyElement(indexFrom, scratch);
+        size_t size;
+        const void * payload = ColumnTraits::Source(scratch, size);
+        return this->ElementToColumn(indexTo, payload, size, scratch);
+    }
+    typedSource->CopyElement(indexFrom, Data[indexTo]);
+    return true;
+}
+
+template <class _elementType>
+bool mtsStateArray<_elementType>::SetColumnar(bool columnar)
+{
+    if (columnar == this->Columnar) {
+        return true;
+    }
+    if (columnar) {
+        if (!ColumnTraits::SUPPORTED || Data.empty()) {
+            return false;
+        }
+        const size_t rows = Data.size();
+        size_t size;
+        ColumnTraits::Source(Data[0], size);
+        this->ColumnPayloadSize = size;
+        this->ColumnValues.resize(rows * size);
+        this->ColumnTimestamps.resize(rows);
+        this->ColumnValid.resize(rows);
+        size_t rowSize;
+        const void * source;
+        for (size_t row = 0; row < rows; row++) {
+            source = ColumnTraits::Source(Data[row], rowSize);
+            if (!this->ElementToColumn(row, source, rowSize, Data[row])) {
+                CMN_LOG_INIT_ERROR << "mtsStateArray::SetColumnar: payload size is not constant, can't use columnar storage for "
+                                   << typeid(_elementType).name() << std::endl;
+                std::vector<char>().swap(this->ColumnValues);
+                std::vector<double>().swap(this->ColumnTimestamps);
+                std::vector<char>().swap(this->ColumnValid);
+                this->ColumnPayloadSize = 0;
+                return false;
+            }
+        }
+        if (!this->ColumnSource) {
+            this->ColumnSource = &mtsStateArrayColumnSource<value_type>;
+        }
+        // keep an element as example and one as scratch
+        VectorType(2, Data[0]).swap(Data);
+        this->Columnar = true;
+    } else {
+        const size_t rows = this->ColumnTimestamps.size();
+        VectorType(rows, Data[0]).swap(Data);
+        for (size_t row = 0; row < rows; row++) {
+            ColumnToElement(row, Data[row]);
+        }
+        std::vector<char>().swap(this->ColumnValues);
+        std::vector<double>().swap(this->ColumnTimestamps);
+        std::vector<char>().swap(this->ColumnValid);
+        this->ColumnPayloadSize = 0;
+        this->Columnar = false;
+    }
+    return true;
+}
+
 #endif // _mtsStateArray_h
 
@@ -29,6 +29,9 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstMultiTask/mtsGenericObject.h>
 
+#include <vector>
+#include <string.h>
+
 /*!
   \ingroup cisstMultiTask
 
@@ -38,34 +41,80 @@ http://www.cisst.org/cisst/license.txt.
   in an homogenous container of pointers on different types of state
   arrays.
 
-  \sa mtsStateArray */
+  The base class also holds the columnar storage used for plain data
+  elements (see mtsStateArray::SetColumnar).  In this mode, the
+  payloads of all rows are stored in one contiguous buffer and the
+  timestamps and valid flags in separate buffers.  Snapshot can then
+  copy the working copy of an element without virtual call nor
+  dynamic cast.
+
+  \sa mtsStateArray mtsStateArrayColumnTraits */
 class mtsStateArrayBase {
+public:
+    typedef size_t index_type;
+    typedef size_t size_type;
+
+    /*! Type of function used to locate the payload of a state table
+      element, see mtsStateArrayColumnSource. */
+    typedef const void * (*ColumnSourceType)(const mtsGenericObject & element, size_t & size);
+
 protected:
     /*! Protected constructor. Does nothing. */
-    inline mtsStateArrayBase(void){};
+    inline mtsStateArrayBase(void):
+        DataClassServices(0),
+        Columnar(false),
+        ColumnPayloadSize(0),
+        ColumnSource(0)
+    {};
 
     /*! Class services associated to the element contained */
     const cmnClassServicesBase * DataClassServices;
 
-public:
-    typedef size_t index_type;
-    typedef size_t size_type;
+    /*! Columnar storage, used only if Columnar is true. */
+    //@{
+    bool Columnar;
+    size_t ColumnPayloadSize;
+    std::vector<char> ColumnValues;
+    std::vector<double> ColumnTimestamps;
+    std::vector<char> ColumnValid;
+    ColumnSourceType ColumnSource;
+    //@}
 
+public:
     /*! Default destructor. Does nothing. */
     inline virtual ~mtsStateArrayBase(void) {};
 
     /*! Overloaded subscript operator. */
     virtual mtsGenericObject & operator[](index_type index) = 0;
 
-	/*! Overloaded subscript operator. */
+	/*! Overloaded subscript operator.  Throws an exception if the
+	  history is stored in columns (see SetColumnar), use Get or
+	  ElementToStream instead. */
 	virtual const mtsGenericObject & operator[](index_type index) const = 0;
 
+    /*! Write the element at index to a stream (see
+      cmnGenericObject::ToStream).  Safe for concurrent readers,
+      including in columnar mode. */
+    virtual void ElementToStream(index_type index, std::ostream & outputStream) const = 0;
+
+    /*! Class services of the elements. */
+    virtual const cmnClassServicesBase * ElementServices(void) const = 0;
+
 	/*! Create the array of data.  This is currently unused. */
 	virtual mtsStateArrayBase * Create(const mtsGenericObject * objectExample, size_type size) = 0;
 
 	/*! Copy data from one index to another. */
 	virtual void Copy(index_type indexTo, index_type indexFrom) = 0;
 
+    /*! Create a new array of the same type and storage mode (see
+      SetColumnar) with size elements.  The caller owns the new
+      array. */
+    virtual mtsStateArrayBase * Clone(size_type size) const = 0;
+
+    /*! Copy an element from another array of the same type.  Uses
+      memcpy if both arrays are columnar. */
+    virtual bool CopyFrom(index_type indexTo, const mtsStateArrayBase & source, index_type indexFrom) = 0;
+
 	/*! Get data from array. */
 	virtual bool Get(index_type index, mtsGenericObject & data) const = 0;
 
@@ -78,6 +127,61 @@ public:
         return SetDataSize(size);
     }
 
+    /*! Switch between columnar and object storage.  Returns false if
+      the element type doesn't support columnar storage (see
+      mtsStateArrayColumnTraits). */
+    virtual bool SetColumnar(bool columnar) = 0;
+
+    /*! Indicates if the history is stored in columns. */
+    inline bool IsColumnar(void) const {
+        return Columnar;
+    }
+
+    /*! Set the function used by Snapshot to locate the payload of the
+      working copy.  The working copy registered in the state table
+      can be of a different type than the history (e.g. a proxy
+      reference). */
+    inline void SetColumnSource(ColumnSourceType source) {
+        ColumnSource = source;
+    }
+
+    /*! Copy the working copy of the element in the row index.  This
+      must only be used in columnar mode and with the element
+      registered in the state table.  Returns false if the payload
+      size has changed since the column has been created. */
+    inline bool Snapshot(index_type index, const mtsGenericObject & element) {
+        size_t size;
+        const void * source = ColumnSource(element, size);
+        if (size != ColumnPayloadSize) {
+            return false;
+        }
+        if (size != 0) {
+            memcpy(&(ColumnValues[index * size]), source, size);
+        }
+        ColumnTimestamps[index] = element.Timestamp();
+        ColumnValid[index] = element.Valid();
+        return true;
+    }
+
+    /*! Direct access to the columns, e.g. to scan the history of a
+      signal.  The payload of row i starts at GetColumnValues() + i *
+      GetColumnPayloadSize().  Pointers are null if the array is not
+      in columnar mode. */
+    //@{
+    inline size_t GetColumnPayloadSize(void) const {
+        return ColumnPayloadSize;
+    }
+    inline const char * GetColumnValues(void) const {
+        return ColumnValues.empty() ? 0 : &(ColumnValues[0]);
+    }
+    inline const double * GetColumnTimestamps(void) const {
+        return ColumnTimestamps.empty() ? 0 : &(ColumnTimestamps[0]);
+    }
+    inline const char * GetColumnValid(void) const {
+        return ColumnValid.empty() ? 0 : &(ColumnValid[0]);
+    }
+    //@}
+
 };
 
 
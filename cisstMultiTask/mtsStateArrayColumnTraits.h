@@ -0,0 +1,210 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Traits used by mtsStateArray to store plain data in columns.
+*/
+
+#ifndef _mtsStateArrayColumnTraits_h
+#define _mtsStateArrayColumnTraits_h
+
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstMultiTask/mtsVector.h>
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Indicates if a scalar type can be copied with memcpy.  Only the
+  numerical types used by cisstMultiTask are declared plain.
+*/
+template <class _scalarType>
+class mtsStateArrayColumnScalar {
+public:
+    enum {IS_PLAIN = false};
+};
+
+#define MTS_STATE_ARRAY_COLUMN_SCALAR(type) \
+template <> \
+class mtsStateArrayColumnScalar<type> { \
+public: \
+    enum {IS_PLAIN = true}; \
+};
+
+MTS_STATE_ARRAY_COLUMN_SCALAR(double)
+MTS_STATE_ARRAY_COLUMN_SCALAR(float)
+MTS_STATE_ARRAY_COLUMN_SCALAR(long long)
+MTS_STATE_ARRAY_COLUMN_SCALAR(long)
+MTS_STATE_ARRAY_COLUMN_SCALAR(unsigned long)
+MTS_STATE_ARRAY_COLUMN_SCALAR(int)
+MTS_STATE_ARRAY_COLUMN_SCALAR(unsigned int)
+MTS_STATE_ARRAY_COLUMN_SCALAR(short)
+MTS_STATE_ARRAY_COLUMN_SCALAR(unsigned short)
+MTS_STATE_ARRAY_COLUMN_SCALAR(char)
+MTS_STATE_ARRAY_COLUMN_SCALAR(unsigned char)
+MTS_STATE_ARRAY_COLUMN_SCALAR(bool)
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Traits used by mtsStateArray to decide if a state table element
+  can be stored in columns, i.e. one contiguous buffer for the
+  payloads of all rows and separate buffers for the timestamps and
+  valid flags (see mtsStateTable::SetColumnarStorage).
+
+  The default implementation doesn't support columnar storage.  To
+  store a new type in columns, one needs to specialize this class
+  and provide:
+
+  - SUPPORTED, true if the payload can be copied with memcpy.
+
+  - Source, returns a pointer on the payload and its size in bytes.
+
+  - Destination, returns a pointer on the payload after making sure
+    the object can hold size bytes (e.g. resize a dynamic vector).
+    Returns 0 if the object can't hold the payload.
+
+  The payload size must not change once the element has been added
+  to the state table.
+*/
+template <class _elementType>
+class mtsStateArrayColumnTraits {
+public:
+    enum {SUPPORTED = false};
+
+    static const void * Source(const _elementType & CMN_UNUSED(object), size_t & size) {
+        size = 0;
+        return 0;
+    }
+
+    static void * Destination(_elementType & CMN_UNUSED(object), size_t CMN_UNUSED(size)) {
+        return 0;
+    }
+};
+
+
+/*! Column traits for proxies of plain scalars (e.g. mtsDouble). */
+template <class _proxyType, class _scalarType>
+class mtsStateArrayColumnTraitsScalar {
+public:
+    enum {SUPPORTED = mtsStateArrayColumnScalar<_scalarType>::IS_PLAIN};
+
+    static const void * Source(const _proxyType & object, size_t & size) {
+        size = sizeof(_scalarType);
+        return &(object.GetData());
+    }
+
+    static void * Destination(_proxyType & object, size_t size) {
+        if (size != sizeof(_scalarType)) {
+            return 0;
+        }
+        return &(object.GetData());
+    }
+};
+
+
+/*! Column traits for proxies of fixed size vectors and matrices
+  (e.g. mtsVct3).  The payload is the contiguous array of elements. */
+template <class _proxyType, class _scalarType, size_t _size>
+class mtsStateArrayColumnTraitsFixedSize {
+public:
+    enum {SUPPORTED = mtsStateArrayColumnScalar<_scalarType>::IS_PLAIN};
+
+    static const void * Source(const _proxyType & object, size_t & size) {
+        size = _size * sizeof(_scalarType);
+        return object.GetData().Pointer();
+    }
+
+    static void * Destination(_proxyType & object, size_t size) {
+        if (size != _size * sizeof(_scalarType)) {
+            return 0;
+        }
+        return object.GetData().Pointer();
+    }
+};
+
+
+template <class _scalarType>
+class mtsStateArrayColumnTraits<mtsGenericObjectProxy<_scalarType> >:
+    public mtsStateArrayColumnTraitsScalar<mtsGenericObjectProxy<_scalarType>, _scalarType>
+{};
+
+template <class _scalarType>
+class mtsStateArrayColumnTraits<mtsGenericObjectProxyRef<_scalarType> >:
+    public mtsStateArrayColumnTraitsScalar<mtsGenericObjectProxyRef<_scalarType>, _scalarType>
+{};
+
+template <class _scalarType, vct::size_type _size>
+class mtsStateArrayColumnTraits<mtsGenericObjectProxy<vctFixedSizeVector<_scalarType, _size> > >:
+    public mtsStateArrayColumnTraitsFixedSize<mtsGenericObjectProxy<vctFixedSizeVector<_scalarType, _size> >,
+                                              _scalarType, _size>
+{};
+
+template <class _scalarType, vct::size_type _size>
+class mtsStateArrayColumnTraits<mtsGenericObjectProxyRef<vctFixedSizeVector<_scalarType, _size> > >:
+    public mtsStateArrayColumnTraitsFixedSize<mtsGenericObjectProxyRef<vctFixedSizeVector<_scalarType, _size> >,
+                                              _scalarType, _size>
+{};
+
+template <class _scalarType, vct::size_type _rows, vct::size_type _cols, bool _rowMajor>
+class mtsStateArrayColumnTraits<mtsGenericObjectProxy<vctFixedSizeMatrix<_scalarType, _rows, _cols, _rowMajor> > >:
+    public mtsStateArrayColumnTraitsFixedSize<mtsGenericObjectProxy<vctFixedSizeMatrix<_scalarType, _rows, _cols, _rowMajor> >,
+                                              _scalarType, _rows * _cols>
+{};
+
+template <class _scalarType, vct::size_type _rows, vct::size_type _cols, bool _rowMajor>
+class mtsStateArrayColumnTraits<mtsGenericObjectProxyRef<vctFixedSizeMatrix<_scalarType, _rows, _cols, _rowMajor> > >:
+    public mtsStateArrayColumnTraitsFixedSize<mtsGenericObjectProxyRef<vctFixedSizeMatrix<_scalarType, _rows, _cols, _rowMajor> >,
+                                              _scalarType, _rows * _cols>
+{};
+
+
+/*! Column traits for dynamic vectors (e.g. mtsDoubleVec).  The size
+  of the vector is captured when the column is created, the working
+  copy must not be resized afterwards. */
+template <class _scalarType>
+class mtsStateArrayColumnTraits<mtsVector<_scalarType> > {
+public:
+    enum {SUPPORTED = mtsStateArrayColumnScalar<_scalarType>::IS_PLAIN};
+
+    static const void * Source(const mtsVector<_scalarType> & object, size_t & size) {
+        size = object.size() * sizeof(_scalarType);
+        return object.Pointer();
+    }
+
+    static void * Destination(mtsVector<_scalarType> & object, size_t size) {
+        if ((size % sizeof(_scalarType)) != 0) {
+            return 0;
+        }
+        object.SetSize(size / sizeof(_scalarType));
+        return object.Pointer();
+    }
+};
+
+
+/*! Helper function used to locate the payload of a state table
+  element using its base type, see mtsStateArrayBase::Snapshot. */
+template <class _elementType>
+const void * mtsStateArrayColumnSource(const mtsGenericObject & element, size_t & size) {
+    return mtsStateArrayColumnTraits<_elementType>::Source(static_cast<const _elementType &>(element), size);
+}
+
+
+#endif // _mtsStateArrayColumnTraits_h
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnGenericObject.h>
 #include <cisstCommon/cmnClassRegisterMacros.h>
+#include <cisstOSAbstraction/osaAtomic.h>
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 #include <cisstMultiTask/mtsStateArrayBase.h>
 #include <cisstMultiTask/mtsStateArray.h>
@@ -63,6 +64,12 @@ typedef int mtsStateDataId;
   assumption here that there is only one writer, though there can be
   multiple readers. State Data Table is also refered as Data Table or
   State Table elsewhere in the documentation.
+
+  Each row also has a sequence counter which is odd while the writer
+  updates the row (seqlock).  Readers can use GetConsistent and
+  GetLatestConsistent to copy several elements from the same row and
+  detect if the writer overwrote the row during the copy.  The writer
+  is never blocked by readers.
  */
 class CISST_EXPORT mtsStateTable: public cmnGenericObject {
 
@@ -179,18 +186,19 @@ public:
             AccessorBase(table, id), History(*history), Current(data) {}
 
         void ToStream(std::ostream & outputStream, const mtsStateIndex & when) const {
-            History.Element(when.Index()).ToStream(outputStream);
+            History.ElementToStream(when.Index(), outputStream);
         }
 
         bool Get(const mtsStateIndex & when, value_type & data) const {
-            data = History.Element(when.Index());
+            History.CopyElement(when.Index(), data);
             return Table.ValidateReadIndex(when);
         }
 
         //This should be used with caution because
         //the state table mechanism could override the data that the pointer is pointing to.
+        //With columnar storage, there is no element to point to and this returns 0, use Get.
         const value_type * GetPointer(const mtsStateIndex & when) const {
-            if (!Table.ValidateReadIndex(when))
+            if (!Table.ValidateReadIndex(when) || History.IsColumnar())
                 return 0;
             else
                 return  &(History.Element(when.Index()));
@@ -253,6 +261,12 @@ public:
       default. */
     bool AutomaticAdvanceFlag;
 
+    /*! Columnar storage flag.  When set, the history of elements with
+      a plain data payload (see mtsStateArrayColumnTraits) is stored
+      in contiguous columns and Advance copies the working copies with
+      memcpy.  This flag is set to false by default. */
+    bool ColumnarStorageFlag;
+
 	/*! The vector contains pointers to individual columns. */
 	std::vector<mtsStateArrayBase *> StateVector;
 
@@ -274,6 +288,10 @@ public:
 	  period of the task that the state table is associated with. */
 	std::vector<mtsStateIndex::TimeTicksType> Ticks;
 
+    /*! Per row sequence counter, odd while the row is being written.
+      See GetConsistent. */
+    osaAtomic<size_t> * RowSequence;
+
     /*! The state table indices for Tic, Toc, and Period. */
     mtsStateDataId TicId, TocId;
     mtsStateDataId PeriodId;
@@ -311,6 +329,14 @@ public:
 	/*! Write specified data. */
 	bool Write(mtsStateDataId id, const mtsGenericObject & obj);
 
+    /*! Copy elements from a row, used by GetConsistent and
+      GetLatestConsistent.  The flag torn is set to true if the copy
+      failed because the row was being or has been overwritten. */
+    bool CopyRow(const mtsStateIndex & when,
+                 const std::vector<mtsStateDataId> & ids,
+                 const std::vector<mtsGenericObject *> & data,
+                 bool & torn) const;
+
 
  public:
     /*! Constructor. Constructs a state table with a default
@@ -344,6 +370,25 @@ public:
         return (Ticks[timeIndex.Index()] == timeIndex.Ticks());
     }
 
+    /*! Copy several elements from the row defined by the state index.
+      The objects in data must match the types of the elements
+      identified by ids.  Returns false if the row was being written
+      or has been overwritten during the copy, in which case the
+      content of data is undefined. */
+    bool GetConsistent(const mtsStateIndex & when,
+                       const std::vector<mtsStateDataId> & ids,
+                       const std::vector<mtsGenericObject *> & data) const;
+
+    /*! Copy several elements from the latest row.  If the writer
+      overwrites the row during the copy, the copy is attempted again
+      on the new latest row, up to maxAttempts times.  The index of the
+      row used is returned in when.  Returns false if no consistent
+      copy could be made. */
+    bool GetLatestConsistent(const std::vector<mtsStateDataId> & ids,
+                             const std::vector<mtsGenericObject *> & data,
+                             mtsStateIndex & when,
+                             size_t maxAttempts = 8) const;
+
     /*! Get method for auto advance flag. See AutomaticAdvanceFlag */
     inline const bool & AutomaticAdvance(void) const {
         return this->AutomaticAdvanceFlag;
@@ -354,6 +399,19 @@ public:
         this->AutomaticAdvanceFlag = automaticAdvance;
     }
 
+    /*! Get method for columnar storage flag.  See ColumnarStorageFlag. */
+    inline const bool & ColumnarStorage(void) const {
+        return this->ColumnarStorageFlag;
+    }
+
+    /*! Set method for columnar storage flag.  Elements already added
+      are converted and elements added later will use the selected
+      storage.  Elements with a type not supported by columnar storage
+      keep the default storage.  This method is not thread safe and
+      should be called before the task starts.  Returns the number of
+      elements stored in columns. */
+    size_t SetColumnarStorage(bool columnarStorage);
+
     /*! Check if the signal has been registered. */
     int GetStateVectorID(const std::string & dataName) const;
 
@@ -503,6 +561,10 @@ mtsStateDataId mtsStateTable::NewElement(const std::string & name, _elementType
     typedef typename mtsGenericTypes<_elementType>::FinalRefType FinalRefType;
     mtsStateArray<FinalType> * elementHistory =
         new mtsStateArray<FinalType>(*element, HistoryLength);
+    elementHistory->SetColumnSource(&mtsStateArrayColumnSource<FinalRefType>);
+    if (this->ColumnarStorageFlag) {
+        elementHistory->SetColumnar(true);
+    }
     StateVector.push_back(elementHistory);
     FinalRefType *pdata = mtsGenericTypes<_elementType>::ConditionalWrap(*element);
     StateVectorElements.push_back(pdata);
@@ -65,6 +65,17 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
 	  time systems. */
 	bool IsHardRealTime;
 
+    /*! Scheduling counters of the thread buddy, added to the state table
+      as "NumberOfOverruns" and "NumberOfSkippedPeriods". */
+    //@{
+    mtsULong NumberOfOverruns;
+    mtsULong NumberOfSkippedPeriods;
+    //@}
+
+    /*! Add the scheduling counters to the state table, called by the
+      constructors. */
+    void AddSchedulingCountersToStateTable(void);
+
     /********************* Methods that call user methods *****************/
 
 	/*! The member function that is passed as 'start routine' argument for
@@ -131,6 +142,24 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
       the thread was created with a period > 0. */
     bool IsPeriodic(void) const;
 
+    /*! Wait for absolute deadlines, advanced by exactly one period at
+      each iteration, to avoid the drift due to the scheduling latency.
+      See osaThreadBuddy::SetAbsoluteDeadlines.  Returns false if not
+      supported by the operating system. */
+    bool SetAbsoluteDeadlines(bool absoluteDeadlines, double spinTimeInSeconds = 0.0);
+
+    /*! Number of periods overrun and skipped since the task started, also
+      available in the state table. */
+    //@{
+    inline unsigned long GetNumberOfOverruns(void) const {
+        return ThreadBuddy.GetNumberOfOverruns();
+    }
+
+    inline unsigned long GetNumberOfSkippedPeriods(void) const {
+        return ThreadBuddy.GetNumberOfSkippedPeriods();
+    }
+    //@}
+
 };
 
 
@@ -22,6 +22,9 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsManagerGlobal.h>
 #include <cisstMultiTask/mtsManagerLocal.h>
 #include <cisstMultiTask/mtsCollectorState.h>
+#include <cisstMultiTask/mtsCollectorColumnar.h>
+
+#include <sstream>
 
 #include "mtsTestComponents.h"
 
@@ -288,4 +291,216 @@ void mtsCollectorStateTest::TestFromSignal_int(void) {
     mtsCollectorStateTest::TestFromSignal<int>();
 }
 
+
+void mtsCollectorStateTest::TestColumnarFile(void)
+{
+    const std::string fileName = "StateDataCollectionColumnarUnitTest.ccol";
+    mtsCollectorColumnar::SignalsType signals(2);
+    signals[0].Name = "Position";
+    signals[0].TypeName = "mtsDoubleVec";
+    signals[0].Encoding = mtsCollectorColumnar::ENCODING_RAW;
+    signals[0].PayloadSize = 3 * sizeof(double);
+    signals[1].Name = "Label";
+    signals[1].TypeName = mtsStdString::ClassServices()->GetName();
+    signals[1].Encoding = mtsCollectorColumnar::ENCODING_SERIALIZED;
+    signals[1].PayloadSize = 0;
+
+    // small buffers to force reallocation
+    mtsCollectorColumnarWriter writer;
+    CPPUNIT_ASSERT(writer.Open(fileName, "component/table", signals, 10.0, 2, 128));
+    CPPUNIT_ASSERT(writer.IsOpen());
+
+    const size_t numberOfChunks = 5;
+    const size_t rowsPerChunk = 7;
+    const size_t alignment = mtsCollectorColumnar::ALIGNMENT;
+    size_t row = 0;
+    for (size_t chunk = 0; chunk < numberOfChunks; chunk++) {
+        // serialize labels first
+        std::ostringstream serialized;
+        std::vector<unsigned long long> offsets(rowsPerChunk + 1, 0);
+        mtsStdString label;
+        size_t index;
+        for (index = 0; index < rowsPerChunk; index++) {
+            std::ostringstream name;
+            name << "row" << (row + index);
+            label.Data = name.str();
+            label.SerializeRaw(serialized);
+            offsets[index + 1] = static_cast<unsigned long long>(serialized.tellp());
+        }
+        const std::string blob = serialized.str();
+        size_t size = sizeof(mtsCollectorColumnar::ChunkHeader)
+            + mtsCollectorColumnar::Align(rowsPerChunk * sizeof(unsigned long long), alignment)
+            + mtsCollectorColumnar::Align(rowsPerChunk * sizeof(double), alignment)
+            + mtsCollectorColumnar::SignalColumnsSize(signals[0], rowsPerChunk, 0)
+            + mtsCollectorColumnar::SignalColumnsSize(signals[1], rowsPerChunk, blob.size());
+        size = mtsCollectorColumnar::Align(size, mtsCollectorColumnar::CHUNK_ALIGNMENT);
+        char * buffer = writer.Reserve(size);
+        CPPUNIT_ASSERT(buffer);
+        memset(buffer, 0, size);
+        mtsCollectorColumnar::ChunkHeader * header = reinterpret_cast<mtsCollectorColumnar::ChunkHeader *>(buffer);
+        memcpy(header->Magic, mtsCollectorColumnar::ChunkMagic, sizeof(header->Magic));
+        header->NumberOfRows = rowsPerChunk;
+        header->ChunkSize = size;
+        header->FirstTime = 0.1 * row;
+        header->LastTime = 0.1 * (row + rowsPerChunk - 1);
+        size_t position = sizeof(mtsCollectorColumnar::ChunkHeader);
+        unsigned long long * ticks = reinterpret_cast<unsigned long long *>(buffer + position);
+        position += mtsCollectorColumnar::Align(rowsPerChunk * sizeof(unsigned long long), alignment);
+        double * time = reinterpret_cast<double *>(buffer + position);
+        position += mtsCollectorColumnar::Align(rowsPerChunk * sizeof(double), alignment);
+        for (size_t signal = 0; signal < 2; signal++) {
+            double * timestamps = reinterpret_cast<double *>(buffer + position);
+            position += mtsCollectorColumnar::Align(rowsPerChunk * sizeof(double), alignment);
+            char * valid = buffer + position;
+            position += mtsCollectorColumnar::Align(rowsPerChunk, alignment);
+            for (index = 0; index < rowsPerChunk; index++) {
+                ticks[index] = row + index;
+                time[index] = 0.1 * (row + index);
+                timestamps[index] = 0.1 * (row + index) + 0.01 * signal;
+                valid[index] = ((row + index) % 2 == 0);
+            }
+            if (signal == 0) {
+                double * values = reinterpret_cast<double *>(buffer + position);
+                position += mtsCollectorColumnar::Align(rowsPerChunk * signals[0].PayloadSize, alignment);
+                for (index = 0; index < 3 * rowsPerChunk; index++) {
+                    values[index] = static_cast<double>(3 * row + index);
+                }
+            } else {
+                memcpy(buffer + position, &(offsets[0]), (rowsPerChunk + 1) * sizeof(unsigned long long));
+                position += mtsCollectorColumnar::Align((rowsPerChunk + 1) * sizeof(unsigned long long), alignment);
+                memcpy(buffer + position, blob.data(), blob.size());
+                position += mtsCollectorColumnar::Align(blob.size(), alignment);
+            }
+        }
+        CPPUNIT_ASSERT(position <= size);
+        writer.Commit(size);
+        row += rowsPerChunk;
+    }
+    writer.Close();
+    CPPUNIT_ASSERT(!writer.HasWriteError());
+    CPPUNIT_ASSERT(!writer.IsOpen());
+
+    // read back
+    mtsCollectorColumnarReader reader;
+    CPPUNIT_ASSERT(reader.Open(fileName));
+    CPPUNIT_ASSERT_EQUAL(std::string("component/table"), reader.GetDescription());
+    CPPUNIT_ASSERT_EQUAL(10.0, reader.GetTimeOrigin());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), reader.GetNumberOfSignals());
+    CPPUNIT_ASSERT_EQUAL(numberOfChunks, reader.GetNumberOfChunks());
+    CPPUNIT_ASSERT_EQUAL(numberOfChunks * rowsPerChunk, reader.GetNumberOfRows());
+    CPPUNIT_ASSERT_EQUAL(1, reader.GetSignalIndex("Label"));
+    CPPUNIT_ASSERT_EQUAL(-1, reader.GetSignalIndex("Dummy"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3 * sizeof(double)), reader.GetSignal(0).PayloadSize);
+
+    size_t index;
+    for (index = 0; index < reader.GetNumberOfRows(); index++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(index), reader.GetTicks(index));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1 * index + 0.01, reader.GetTimestamp(1, index), 1e-12);
+        CPPUNIT_ASSERT_EQUAL(index % 2 == 0, reader.GetValid(0, index));
+    }
+
+    // rows across chunks, 0.55 to 2.05 is rows 6 to 20
+    size_t firstRow, lastRow;
+    CPPUNIT_ASSERT(reader.FindRows(0.55, 2.05, firstRow, lastRow));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), firstRow);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(20), lastRow);
+    CPPUNIT_ASSERT(!reader.FindRows(100.0, 200.0, firstRow, lastRow));
+
+    std::vector<double> times, values;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(15), reader.GetValues(0, 0.55, 2.05, times, values));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(15), times.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(45), values.size());
+    for (index = 0; index < values.size(); index++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(3 * 6 + index), values[index]);
+    }
+    // serialized signals can't be read as values
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), reader.GetValues(1, 0.0, 10.0, times, values));
+
+    mtsStdString label;
+    CPPUNIT_ASSERT(reader.GetObject(1, 23, label));
+    CPPUNIT_ASSERT_EQUAL(std::string("row23"), label.Data);
+    // wrong type
+    mtsDouble wrongType;
+    CPPUNIT_ASSERT(!reader.GetObject(1, 23, wrongType));
+    // raw signals are not serialized
+    CPPUNIT_ASSERT(!reader.GetObject(0, 23, label));
+
+    reader.Close();
+    remove(fileName.c_str());
+}
+
+
+void mtsCollectorStateTest::TestPipeline(void)
+{
+    mtsComponentManager * manager = mtsComponentManager::GetInstance();
+    mtsComponent * component = new mtsComponent("CollectorPipelineComponent");
+    mtsStateTable * table = new mtsStateTable(64, "Pipeline");
+    component->AddStateTable(table);
+    CPPUNIT_ASSERT(manager->AddComponent(component));
+    mtsDouble value;
+    table->AddData(value, "Value");
+
+    std::stringstream output;
+    mtsCollectorState * collector = new mtsCollectorState("CollectorPipelineTest");
+    CPPUNIT_ASSERT(collector->SetStateTable(component->GetName(), table->GetName()));
+    collector->SetOutput(output, mtsCollectorBase::COLLECTOR_FILE_FORMAT_CSV);
+    CPPUNIT_ASSERT(collector->AddSignal("Value"));
+
+    size_t index;
+    for (index = 0; index < 40; index++) {
+        table->Start();
+        value = static_cast<double>(index);
+        table->Advance();
+    }
+    // collect rows 1 to 39, the writer thread formats the rows
+    mtsStateTable::IndexRange range;
+    range.First = mtsStateIndex(0.0, 1, 1, 64);
+    range.Last = table->GetIndexReader();
+    collector->BatchCollect(range);
+    collector->FlushPendingOutput();
+
+    mtsUInt rowsDropped, maxQueueDepth;
+    mtsUIntVec histogram;
+    collector->GetRowsDropped(rowsDropped);
+    collector->GetMaxQueueDepth(maxQueueDepth);
+    collector->GetWriteLatencyHistogram(histogram);
+    CPPUNIT_ASSERT_EQUAL(0u, rowsDropped.Data);
+    CPPUNIT_ASSERT_EQUAL(1u, maxQueueDepth.Data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(mtsCollectorState::WRITE_LATENCY_HISTOGRAM_SIZE), histogram.size());
+    CPPUNIT_ASSERT_EQUAL(1u, histogram.SumOfElements());
+
+    // count data lines, header lines start with #
+    std::string line;
+    size_t numberOfLines = 0;
+    while (std::getline(output, line)) {
+        if (!line.empty() && (line[0] != '#')) {
+            numberOfLines++;
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(39), numberOfLines);
+
+    // overwrite the table, rows of an old range are dropped
+    for (index = 0; index < 80; index++) {
+        table->Start();
+        table->Advance();
+    }
+    range.First = mtsStateIndex(0.0, 41, 41, 64);
+    range.Last = mtsStateIndex(0.0, 50, 50, 64);
+    collector->BatchCollect(range);
+    collector->FlushPendingOutput();
+    collector->GetRowsDropped(rowsDropped);
+    CPPUNIT_ASSERT_EQUAL(10u, rowsDropped.Data);
+
+    collector->ResetPipelineStatistics();
+    collector->GetRowsDropped(rowsDropped);
+    collector->GetWriteLatencyHistogram(histogram);
+    CPPUNIT_ASSERT_EQUAL(0u, rowsDropped.Data);
+    CPPUNIT_ASSERT_EQUAL(0u, histogram.SumOfElements());
+
+    delete collector;
+    CPPUNIT_ASSERT(manager->RemoveComponent(component));
+    delete component;
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsCollectorStateTest);
@@ -38,6 +38,8 @@ private:
         CPPUNIT_TEST(TestFromCallback_int);
         CPPUNIT_TEST(TestFromSignal_mtsInt);
         CPPUNIT_TEST(TestFromSignal_int);
+        CPPUNIT_TEST(TestColumnarFile);
+        CPPUNIT_TEST(TestPipeline);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -69,4 +71,7 @@ public:
     template <class _elementType> void TestFromSignal(void);
     void TestFromSignal_mtsInt(void);
     void TestFromSignal_int(void);
+
+    void TestColumnarFile(void);
+    void TestPipeline(void);
 };
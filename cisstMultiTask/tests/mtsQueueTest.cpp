@@ -20,7 +20,11 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "mtsQueueTest.h"
 #include "mtsMacrosTestClasses.h"
+#include <cisstMultiTask/mtsMailBox.h>
+#include <cisstMultiTask/mtsCommandWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedWrite.h>
 #include <cisstVector/vctRandom.h>
+#include <cisstOSAbstraction/osaThread.h>
 
 void mtsQueueTest::TestQueue_mtsDouble(void)
 {
@@ -147,3 +151,339 @@ void mtsQueueTest::TestConstructorDestructorCalls(void)
     CPPUNIT_ASSERT_EQUAL(mtsMacrosTestClassB::CopyConstructorCalls, static_cast<size_t>(0));
     CPPUNIT_ASSERT_EQUAL(mtsMacrosTestClassB::DestructorCalls, 2 * size + 1);
 }
+
+
+void mtsQueueTest::TestQueue_size_t(void)
+{
+    // default constructor, always full and empty
+    mtsQueue<size_t> queue;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), queue.GetSize());
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT(queue.IsFull());
+    CPPUNIT_ASSERT(!queue.Put(1));
+    CPPUNIT_ASSERT(!queue.Peek());
+    CPPUNIT_ASSERT(!queue.Get());
+
+    // size is not a power of two, queue holds size - 1 elements
+    const size_t size = 100;
+    queue.SetSize(size, 0);
+    CPPUNIT_ASSERT_EQUAL(size, queue.GetSize());
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT(!queue.IsFull());
+
+    size_t index, iteration;
+    size_t * element;
+    for (iteration = 0; iteration < 5; iteration++) {
+        for (index = 0; index < size - 1; index++) {
+            CPPUNIT_ASSERT(queue.Put(iteration * size + index));
+            CPPUNIT_ASSERT_EQUAL(index + 1, queue.GetAvailable());
+        }
+        CPPUNIT_ASSERT(queue.IsFull());
+        CPPUNIT_ASSERT(!queue.Put(0));
+        for (index = 0; index < size - 1; index++) {
+            element = queue.Peek();
+            CPPUNIT_ASSERT(element);
+            CPPUNIT_ASSERT_EQUAL(iteration * size + index, *element);
+            element = queue.Get();
+            CPPUNIT_ASSERT(element);
+            CPPUNIT_ASSERT_EQUAL(iteration * size + index, *element);
+        }
+        CPPUNIT_ASSERT(queue.IsEmpty());
+        CPPUNIT_ASSERT(!queue.Get());
+    }
+}
+
+
+void mtsQueueTest::TestQueueMPSC_size_t(void)
+{
+    mtsQueueMPSC<size_t> queue;
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), queue.GetSize());
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT(queue.IsFull());
+    CPPUNIT_ASSERT(!queue.Put(1));
+    CPPUNIT_ASSERT(!queue.Get());
+
+    // size is rounded up to a power of two
+    queue.SetSize(100, 0);
+    const size_t size = queue.GetSize();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(128), size);
+
+    size_t index, iteration;
+    size_t * element;
+    for (iteration = 0; iteration < 5; iteration++) {
+        for (index = 0; index < size; index++) {
+            CPPUNIT_ASSERT(queue.Put(iteration * size + index));
+            CPPUNIT_ASSERT_EQUAL(index + 1, queue.GetAvailable());
+        }
+        CPPUNIT_ASSERT(queue.IsFull());
+        CPPUNIT_ASSERT(!queue.Put(0));
+        for (index = 0; index < size; index++) {
+            element = queue.Peek();
+            CPPUNIT_ASSERT(element);
+            CPPUNIT_ASSERT_EQUAL(iteration * size + index, *element);
+            element = queue.Get();
+            CPPUNIT_ASSERT(element);
+            CPPUNIT_ASSERT_EQUAL(iteration * size + index, *element);
+        }
+        CPPUNIT_ASSERT(queue.IsEmpty());
+        CPPUNIT_ASSERT(!queue.Peek());
+    }
+}
+
+
+template <class _queueType>
+void mtsQueueTestPeekOffsetAndRemove(_queueType & queue)
+{
+    const size_t numberOfElements = 10;
+    size_t index, iteration;
+    size_t * element;
+    for (iteration = 0; iteration < 20; iteration++) {
+        for (index = 0; index < numberOfElements; index++) {
+            CPPUNIT_ASSERT(queue.Put(iteration * numberOfElements + index));
+        }
+        for (index = 0; index < numberOfElements; index++) {
+            element = queue.Peek(index);
+            CPPUNIT_ASSERT(element);
+            CPPUNIT_ASSERT_EQUAL(iteration * numberOfElements + index, *element);
+        }
+        CPPUNIT_ASSERT(!queue.Peek(numberOfElements));
+        // nothing has been removed yet
+        CPPUNIT_ASSERT_EQUAL(numberOfElements, queue.GetAvailable());
+        queue.Remove(numberOfElements - 1);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), queue.GetAvailable());
+        element = queue.Get();
+        CPPUNIT_ASSERT(element);
+        CPPUNIT_ASSERT_EQUAL(iteration * numberOfElements + numberOfElements - 1, *element);
+        CPPUNIT_ASSERT(queue.IsEmpty());
+    }
+}
+
+
+void mtsQueueTest::TestPeekOffsetAndRemove(void)
+{
+    mtsQueue<size_t> queue(16, 0);
+    mtsQueueTestPeekOffsetAndRemove(queue);
+    mtsQueueMPSC<size_t> queueMPSC(16, 0);
+    mtsQueueTestPeekOffsetAndRemove(queueMPSC);
+}
+
+
+void mtsQueueTest::TestReserveAndCommit(void)
+{
+    const size_t size = 10;
+    size_t index;
+    mtsQueue<size_t> queue(size, 0);
+    size_t * slot;
+    for (index = 0; index < size - 1; index++) {
+        slot = queue.Reserve();
+        CPPUNIT_ASSERT(slot);
+        // reserved but not committed, can't be seen by consumer
+        *slot = index;
+        CPPUNIT_ASSERT_EQUAL(index, queue.GetAvailable());
+        CPPUNIT_ASSERT(slot == queue.Reserve());
+        CPPUNIT_ASSERT(queue.Commit());
+        CPPUNIT_ASSERT_EQUAL(index + 1, queue.GetAvailable());
+        // nothing reserved, commit fails
+        CPPUNIT_ASSERT(!queue.Commit());
+        CPPUNIT_ASSERT_EQUAL(index + 1, queue.GetAvailable());
+    }
+    CPPUNIT_ASSERT(!queue.Reserve());
+    CPPUNIT_ASSERT(!queue.Commit());
+    CPPUNIT_ASSERT_EQUAL(size - 1, queue.GetAvailable());
+    for (index = 0; index < size - 1; index++) {
+        CPPUNIT_ASSERT_EQUAL(index, *(queue.Get()));
+    }
+
+    // generic queue, the slot and the element seen by the consumer are the same object
+    mtsDouble prototype(0.0);
+    mtsQueueGeneric queueGeneric(size, prototype);
+    mtsGenericObject * genericSlot;
+    mtsDouble * element;
+    for (index = 0; index < size; index++) {
+        genericSlot = queueGeneric.Reserve();
+        CPPUNIT_ASSERT(genericSlot);
+        element = dynamic_cast<mtsDouble *>(genericSlot);
+        CPPUNIT_ASSERT(element);
+        element->Data = static_cast<double>(index);
+        CPPUNIT_ASSERT(queueGeneric.Commit());
+        CPPUNIT_ASSERT(!queueGeneric.Commit());
+    }
+    CPPUNIT_ASSERT(!queueGeneric.Reserve());
+    CPPUNIT_ASSERT(!queueGeneric.Commit());
+    CPPUNIT_ASSERT_EQUAL(size, queueGeneric.GetAvailable());
+    for (index = 0; index < size; index++) {
+        genericSlot = queueGeneric.Get();
+        CPPUNIT_ASSERT(genericSlot);
+        element = dynamic_cast<mtsDouble *>(genericSlot);
+        CPPUNIT_ASSERT(element);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), element->Data);
+    }
+}
+
+
+namespace {
+    class mtsQueueTestReceiver {
+    public:
+        mtsQueueTestReceiver(void):
+            NumberOfCalls(0),
+            Last(0.0)
+        {}
+        void Write(const mtsDouble & value) {
+            NumberOfCalls++;
+            Last = value.Data;
+        }
+        size_t NumberOfCalls;
+        double Last;
+    };
+}
+
+
+void mtsQueueTest::TestExecuteReservedQueueFull(void)
+{
+    const size_t size = 4;
+    mtsQueueTestReceiver receiver;
+    mtsMailBox mailBox("mailBox", 2 * size);
+    mtsCommandWrite<mtsQueueTestReceiver, mtsDouble> actualCommand(&mtsQueueTestReceiver::Write, &receiver,
+                                                                   "Write", mtsDouble(0.0));
+    mtsCommandQueuedWrite<mtsDouble> command(&mailBox, &actualCommand, size);
+
+    // nothing reserved
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL,
+                         command.ExecuteReserved(MTS_NOT_BLOCKING).GetResult());
+    CPPUNIT_ASSERT(mailBox.IsEmpty());
+
+    // fill the arguments queue, executing twice doesn't queue twice
+    size_t index = 0;
+    mtsGenericObject * slot = command.ArgumentReserve();
+    while (slot) {
+        mtsDouble * argument = dynamic_cast<mtsDouble *>(slot);
+        CPPUNIT_ASSERT(argument);
+        argument->Data = static_cast<double>(index);
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED,
+                             command.ExecuteReserved(MTS_NOT_BLOCKING).GetResult());
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL,
+                             command.ExecuteReserved(MTS_NOT_BLOCKING).GetResult());
+        index++;
+        slot = command.ArgumentReserve();
+    }
+    const size_t numberOfQueued = index;
+    CPPUNIT_ASSERT(numberOfQueued > 0);
+    CPPUNIT_ASSERT(numberOfQueued < size);
+
+    // queue full
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL,
+                         command.ExecuteReserved(MTS_NOT_BLOCKING).GetResult());
+
+    // the queued arguments are intact and in order
+    for (index = 0; index < numberOfQueued; index++) {
+        CPPUNIT_ASSERT(mailBox.ExecuteNext());
+        CPPUNIT_ASSERT_EQUAL(index + 1, receiver.NumberOfCalls);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), receiver.Last);
+    }
+    CPPUNIT_ASSERT(mailBox.IsEmpty());
+    CPPUNIT_ASSERT(!mailBox.ExecuteNext());
+    CPPUNIT_ASSERT_EQUAL(numberOfQueued, receiver.NumberOfCalls);
+
+    // space available again
+    CPPUNIT_ASSERT(command.ArgumentReserve());
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED,
+                         command.ExecuteReserved(MTS_NOT_BLOCKING).GetResult());
+    CPPUNIT_ASSERT(mailBox.ExecuteNext());
+    CPPUNIT_ASSERT_EQUAL(numberOfQueued + 1, receiver.NumberOfCalls);
+}
+
+
+namespace {
+    const size_t QueueTestNumberOfElements = 100 * 1000;
+    const size_t QueueTestNumberOfProducers = 4;
+
+    void * mtsQueueTestProducer(mtsQueue<size_t> * queue)
+    {
+        for (size_t index = 0; index < QueueTestNumberOfElements; index++) {
+            while (!queue->Put(index)) {
+                osaCurrentThreadYield();
+            }
+        }
+        return 0;
+    }
+
+    struct mtsQueueTestProducerData {
+        mtsQueueMPSC<size_t> * Queue;
+        size_t Identifier;
+    };
+
+    void * mtsQueueTestProducerMPSC(mtsQueueTestProducerData * producer)
+    {
+        // encode producer identifier in lower bits
+        for (size_t index = 0; index < QueueTestNumberOfElements; index++) {
+            while (!producer->Queue->Put(index * QueueTestNumberOfProducers + producer->Identifier)) {
+                osaCurrentThreadYield();
+            }
+        }
+        return 0;
+    }
+}
+
+
+void mtsQueueTest::TestMultiThreading(void)
+{
+    mtsQueue<size_t> queue(64, 0);
+    osaThread producerThread;
+    producerThread.Create(mtsQueueTestProducer, &queue);
+
+    size_t expected = 0;
+    bool error = false;
+    size_t * element;
+    while (expected < QueueTestNumberOfElements) {
+        element = queue.Peek();
+        if (element) {
+            error = error || (*element != expected);
+            queue.Get();
+            expected++;
+        } else {
+            osaCurrentThreadYield();
+        }
+    }
+    producerThread.Wait();
+    CPPUNIT_ASSERT(!error);
+    CPPUNIT_ASSERT(queue.IsEmpty());
+}
+
+
+void mtsQueueTest::TestMultiThreadingMPSC(void)
+{
+    mtsQueueMPSC<size_t> queue(64, 0);
+    mtsQueueTestProducerData producers[QueueTestNumberOfProducers];
+    osaThread producerThreads[QueueTestNumberOfProducers];
+    size_t expected[QueueTestNumberOfProducers];
+    size_t index;
+    for (index = 0; index < QueueTestNumberOfProducers; index++) {
+        producers[index].Queue = &queue;
+        producers[index].Identifier = index;
+        expected[index] = 0;
+        producerThreads[index].Create(mtsQueueTestProducerMPSC, &(producers[index]));
+    }
+
+    // elements from each producer must be received in order
+    size_t received = 0;
+    bool error = false;
+    size_t * element;
+    while (received < QueueTestNumberOfProducers * QueueTestNumberOfElements) {
+        element = queue.Peek();
+        if (element) {
+            const size_t identifier = *element % QueueTestNumberOfProducers;
+            const size_t value = *element / QueueTestNumberOfProducers;
+            error = error || (value != expected[identifier]);
+            queue.Get();
+            expected[identifier]++;
+            received++;
+        } else {
+            osaCurrentThreadYield();
+        }
+    }
+    for (index = 0; index < QueueTestNumberOfProducers; index++) {
+        producerThreads[index].Wait();
+    }
+    CPPUNIT_ASSERT(!error);
+    CPPUNIT_ASSERT(queue.IsEmpty());
+}
@@ -31,6 +31,13 @@ class mtsQueueTest: public CppUnit::TestFixture
 
     CPPUNIT_TEST(TestQueue_mtsDouble);
     CPPUNIT_TEST(TestConstructorDestructorCalls);
+    CPPUNIT_TEST(TestQueue_size_t);
+    CPPUNIT_TEST(TestQueueMPSC_size_t);
+    CPPUNIT_TEST(TestPeekOffsetAndRemove);
+    CPPUNIT_TEST(TestReserveAndCommit);
+    CPPUNIT_TEST(TestExecuteReservedQueueFull);
+    CPPUNIT_TEST(TestMultiThreading);
+    CPPUNIT_TEST(TestMultiThreadingMPSC);
 
     CPPUNIT_TEST_SUITE_END();
     
@@ -44,6 +51,27 @@ public:
 
     /*! Tests calls to constructors and detructors */
     void TestConstructorDestructorCalls(void);
+
+    /*! Single producer queue of basic type */
+    void TestQueue_size_t(void);
+
+    /*! Multiple producers queue of basic type */
+    void TestQueueMPSC_size_t(void);
+
+    /*! Peek with offset and remove multiple elements at once */
+    void TestPeekOffsetAndRemove(void);
+
+    /*! Fill elements in place using Reserve and Commit */
+    void TestReserveAndCommit(void);
+
+    /*! ExecuteReserved without reserved argument, e.g. queue full */
+    void TestExecuteReservedQueueFull(void);
+
+    /*! One producer and one consumer in different threads */
+    void TestMultiThreading(void);
+
+    /*! Multiple producers and one consumer in different threads */
+    void TestMultiThreadingMPSC(void);
 };
 
 
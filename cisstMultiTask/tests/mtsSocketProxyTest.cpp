@@ -19,6 +19,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "mtsSocketProxyTest.h"
 #include <cisstMultiTask/mtsSocketProxyCommon.h>
+#include <cisstMultiTask/mtsVector.h>
+#include <string.h>
 
 void mtsSocketProxyTest::TestCommandHandle(void)
 {
@@ -47,3 +49,89 @@ void mtsSocketProxyTest::TestCommandHandle(void)
     CPPUNIT_ASSERT(handle == testHandle);
 }
 
+
+// Send messages of the given sizes (number of doubles) and check that they are received
+// and deserialized correctly
+static void mtsSocketProxyTestSendReceive(mtsSocketProxyChannel & sender, mtsSocketProxyChannel & receiver,
+                                          const size_t * sizes, size_t numberOfSizes)
+{
+    mtsSocketProxySendBuffer sendBuffer;
+    mtsSocketProxyReceiveBuffer receiveBuffer;
+    mtsSocketProxyDeSerializer deSerializer;
+    const char handle[CommandHandle::COMMAND_HANDLE_STRING_SIZE + 1] = " W12345678";
+
+    for (size_t test = 0; test < numberOfSizes; test++) {
+        mtsDoubleVec sent(sizes[test]);
+        for (size_t i = 0; i < sent.size(); i++) {
+            sent[i] = 0.5 * i + test;
+        }
+        sendBuffer.Reset();
+        sendBuffer.Append(handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        CPPUNIT_ASSERT(sendBuffer.Serialize(sent));
+        const size_t messageSize = sendBuffer.GetSize();
+        CPPUNIT_ASSERT(sendBuffer.Send(sender) > 0);
+
+        int bytesRead = receiveBuffer.Receive(receiver, 1.0, 0.5);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(messageSize), bytesRead);
+        CPPUNIT_ASSERT(receiveBuffer.IsFramed());
+        CPPUNIT_ASSERT(memcmp(receiveBuffer.GetData(), handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE) == 0);
+
+        mtsDoubleVec received;
+        CPPUNIT_ASSERT(deSerializer.DeSerialize(receiveBuffer.GetData() + CommandHandle::COMMAND_HANDLE_STRING_SIZE,
+                                                receiveBuffer.GetSize() - CommandHandle::COMMAND_HANDLE_STRING_SIZE,
+                                                received));
+        CPPUNIT_ASSERT_EQUAL(sent.size(), received.size());
+        CPPUNIT_ASSERT(sent.Equal(received));
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(0), static_cast<unsigned int>(receiveBuffer.GetMessagesDropped()));
+}
+
+
+void mtsSocketProxyTest::TestFragmentation(void)
+{
+    const unsigned short port = 10987;
+    mtsSocketProxyChannelUDP server;
+    CPPUNIT_ASSERT(server.AssignPort(port));
+    mtsSocketProxyChannelUDP client;
+    client.SetDestination("127.0.0.1", port);
+
+    // Small message, sent in a single datagram, then large message split in
+    // fragments (about 16 kB)
+    const size_t sizes[2] = {5, 2000};
+    mtsSocketProxyTestSendReceive(client, server, sizes, 2);
+
+    // Corrupted message, the deserializer should fail and not throw
+    mtsSocketProxyDeSerializer deSerializer;
+    mtsDoubleVec received;
+    const char garbage[3] = {1, 2, 3};
+    CPPUNIT_ASSERT(!deSerializer.DeSerialize(garbage, sizeof(garbage), received));
+
+    server.Close();
+    client.Close();
+}
+
+
+void mtsSocketProxyTest::TestSharedMemory(void)
+{
+#if (CISST_OS != CISST_WINDOWS)
+    mtsSocketProxyChannelSharedMemory server;
+    CPPUNIT_ASSERT(server.Create("mtsSocketProxyTest"));
+    mtsSocketProxyChannelSharedMemory client;
+    CPPUNIT_ASSERT(client.Connect("mtsSocketProxyTest"));
+    CPPUNIT_ASSERT(client.GetPacketSize() > mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE);
+
+    // 16 kB fits in one datagram, 160 kB is fragmented
+    const size_t sizes[3] = {5, 2000, 20000};
+    mtsSocketProxyTestSendReceive(client, server, sizes, 3);
+
+    // Server replies to the client it received from
+    osaIPandPort serverDestination, clientDestination;
+    CPPUNIT_ASSERT(server.GetDestination(serverDestination));
+    CPPUNIT_ASSERT(client.GetDestination(clientDestination));
+    CPPUNIT_ASSERT(serverDestination == clientDestination);
+    mtsSocketProxyTestSendReceive(server, client, sizes, 3);
+
+    client.Close();
+    server.Close();
+#endif
+}
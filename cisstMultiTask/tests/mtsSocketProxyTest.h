@@ -25,6 +25,8 @@ class mtsSocketProxyTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsSocketProxyTest);
 
     CPPUNIT_TEST(TestCommandHandle);
+    CPPUNIT_TEST(TestFragmentation);
+    CPPUNIT_TEST(TestSharedMemory);
 
     CPPUNIT_TEST_SUITE_END();
     
@@ -35,6 +37,10 @@ public:
     
     void TestCommandHandle(void);
 
+    void TestFragmentation(void);
+
+    void TestSharedMemory(void);
+
 };
 
 
@@ -18,11 +18,14 @@ http://www.cisst.org/cisst/license.txt.
 --- end cisst license ---
 */
 
+#include <cisstOSAbstraction/osaThread.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsVector.h>
 
 #include "mtsStateTableTest.h"
 
 #include <string>
+#include <sstream>
 
 void mtsStateTableTest::setUp(void)
 {
@@ -64,4 +67,198 @@ void mtsStateTableTest::TestGetStateVectorID(void)
     }
 }
 
+
+void mtsStateTableTest::TestColumnarStorage(void)
+{
+    mtsStateTable StateTable(10, "Test");
+
+    // Toc, Tic and Period are plain, PeriodStatistics is not
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), StateTable.SetColumnarStorage(true));
+    CPPUNIT_ASSERT(StateTable.ColumnarStorage());
+
+    mtsDouble scalar;
+    double nativeScalar = 0.0;
+    mtsDoubleVec vector(3);
+    vector.SetAll(0.0);
+    mtsVct3 fixedVector;
+    mtsStdString text;
+    const mtsStateDataId scalarId = StateTable.NewElement("Scalar", &scalar);
+    const mtsStateDataId nativeScalarId = StateTable.NewElement("NativeScalar", &nativeScalar);
+    const mtsStateDataId vectorId = StateTable.NewElement("Vector", &vector);
+    const mtsStateDataId fixedVectorId = StateTable.NewElement("FixedVector", &fixedVector);
+    const mtsStateDataId textId = StateTable.NewElement("Text", &text);
+
+    CPPUNIT_ASSERT(StateTable.StateVector[scalarId]->IsColumnar());
+    CPPUNIT_ASSERT(StateTable.StateVector[nativeScalarId]->IsColumnar());
+    CPPUNIT_ASSERT(StateTable.StateVector[vectorId]->IsColumnar());
+    CPPUNIT_ASSERT(StateTable.StateVector[fixedVectorId]->IsColumnar());
+    CPPUNIT_ASSERT(!StateTable.StateVector[textId]->IsColumnar());
+    CPPUNIT_ASSERT_EQUAL(3 * sizeof(double), StateTable.StateVector[vectorId]->GetColumnPayloadSize());
+
+    typedef mtsStateTable::Accessor<mtsDouble> ScalarAccessor;
+    typedef mtsStateTable::Accessor<double> NativeScalarAccessor;
+    typedef mtsStateTable::Accessor<mtsDoubleVec> VectorAccessor;
+    const ScalarAccessor * scalarAccessor =
+        dynamic_cast<const ScalarAccessor *>(StateTable.GetAccessor("Scalar"));
+    const NativeScalarAccessor * nativeScalarAccessor =
+        dynamic_cast<const NativeScalarAccessor *>(StateTable.GetAccessor("NativeScalar"));
+    const VectorAccessor * vectorAccessor =
+        dynamic_cast<const VectorAccessor *>(StateTable.GetAccessor("Vector"));
+    CPPUNIT_ASSERT(scalarAccessor);
+    CPPUNIT_ASSERT(nativeScalarAccessor);
+    CPPUNIT_ASSERT(vectorAccessor);
+
+    mtsDouble scalarRead;
+    mtsDouble nativeScalarRead;
+    mtsDoubleVec vectorRead;
+    mtsVct3 fixedVectorRead;
+    for (size_t i = 1; i < 25; i++) {
+        StateTable.Start();
+        scalar = static_cast<double>(i);
+        scalar.SetValid(true);
+        nativeScalar = -static_cast<double>(i);
+        vector.SetAll(static_cast<double>(i));
+        vector.Element(2) = 0.5;
+        vector.SetValid(true);
+        fixedVector.Data.Assign(1.0, 2.0, static_cast<double>(i));
+        text = "text";
+        StateTable.Advance();
+
+        CPPUNIT_ASSERT(scalarAccessor->GetLatest(scalarRead));
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), scalarRead.Data);
+        CPPUNIT_ASSERT(scalarRead.Valid());
+        CPPUNIT_ASSERT_EQUAL(StateTable.GetTic(), scalarRead.Timestamp());
+        CPPUNIT_ASSERT(nativeScalarAccessor->GetLatest(nativeScalarRead));
+        CPPUNIT_ASSERT_EQUAL(-static_cast<double>(i), nativeScalarRead.Data);
+        CPPUNIT_ASSERT(vectorAccessor->GetLatest(vectorRead));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), vectorRead.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), vectorRead.Element(0));
+        CPPUNIT_ASSERT_EQUAL(0.5, vectorRead.Element(2));
+        // generic access, as used by the state collector
+        CPPUNIT_ASSERT(StateTable.StateVector[fixedVectorId]->Get(StateTable.GetIndexReader().Index(), fixedVectorRead));
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), fixedVectorRead.Data.Z());
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i),
+                             dynamic_cast<const mtsDouble &>((*StateTable.StateVector[scalarId])[StateTable.GetIndexReader().Index()]).Data);
+    }
+
+    // no reference on elements stored in columns for readers
+    const mtsStateIndex index = StateTable.GetIndexReader();
+    const mtsStateArrayBase & scalarHistory = *(StateTable.StateVector[scalarId]);
+    CPPUNIT_ASSERT_THROW(scalarHistory[index.Index()], std::runtime_error);
+    CPPUNIT_ASSERT(!scalarAccessor->GetPointer(index));
+    std::stringstream expected, actual;
+    CPPUNIT_ASSERT(scalarAccessor->Get(index, scalarRead));
+    scalarRead.ToStream(expected);
+    scalarHistory.ElementToStream(index.Index(), actual);
+    CPPUNIT_ASSERT_EQUAL(expected.str(), actual.str());
+    CPPUNIT_ASSERT(scalarRead.Services() == scalarHistory.ElementServices());
+
+    // history is preserved when switching back to object storage
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), StateTable.SetColumnarStorage(false));
+    CPPUNIT_ASSERT(!StateTable.StateVector[vectorId]->IsColumnar());
+    CPPUNIT_ASSERT(vectorAccessor->Get(index, vectorRead));
+    CPPUNIT_ASSERT_EQUAL(24.0, vectorRead.Element(0));
+    CPPUNIT_ASSERT(scalarAccessor->Get(index, scalarRead));
+    CPPUNIT_ASSERT_EQUAL(24.0, scalarRead.Data);
+    CPPUNIT_ASSERT(scalarAccessor->GetPointer(index));
+}
+
+
+void mtsStateTableTest::TestConsistentRead(void)
+{
+    mtsStateTable StateTable(5, "Test");
+    mtsDouble first, second;
+    std::vector<mtsStateDataId> ids;
+    ids.push_back(StateTable.NewElement("First", &first));
+    ids.push_back(StateTable.NewElement("Second", &second));
+
+    mtsDouble firstRead, secondRead;
+    std::vector<mtsGenericObject *> data;
+    data.push_back(&firstRead);
+    data.push_back(&secondRead);
+
+    mtsStateIndex when;
+    mtsStateIndex oldest;
+    for (size_t i = 1; i < 12; i++) {
+        first = static_cast<double>(i);
+        second = -static_cast<double>(i);
+        StateTable.Advance();
+        CPPUNIT_ASSERT(StateTable.GetLatestConsistent(ids, data, when));
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), firstRead.Data);
+        CPPUNIT_ASSERT_EQUAL(-static_cast<double>(i), secondRead.Data);
+        CPPUNIT_ASSERT(StateTable.GetConsistent(when, ids, data));
+        if (i == 1) {
+            oldest = when;
+        }
+    }
+    // the row of the oldest index has been overwritten
+    CPPUNIT_ASSERT(!StateTable.GetConsistent(oldest, ids, data));
+
+    // type mismatch is reported without retry
+    mtsInt wrongType;
+    data[1] = &wrongType;
+    CPPUNIT_ASSERT(!StateTable.GetLatestConsistent(ids, data, when));
+}
+
+
+namespace {
+    const size_t StateTableTestNumberOfAdvances = 20 * 1000;
+
+    struct mtsStateTableTestWriterData {
+        mtsStateTable * Table;
+        mtsDouble * First;
+        mtsDouble * Second;
+    };
+
+    void * mtsStateTableTestWriter(mtsStateTableTestWriterData * writer)
+    {
+        for (size_t index = 1; index <= StateTableTestNumberOfAdvances; index++) {
+            writer->First->Data = static_cast<double>(index);
+            writer->Second->Data = -static_cast<double>(index);
+            writer->Table->Advance();
+            if ((index % 64) == 0) {
+                osaCurrentThreadYield();
+            }
+        }
+        return 0;
+    }
+}
+
+
+void mtsStateTableTest::TestConsistentReadMultiThreading(void)
+{
+    // short history so the writer wraps often
+    mtsStateTable StateTable(3, "Test");
+    mtsDouble first, second;
+    std::vector<mtsStateDataId> ids;
+    ids.push_back(StateTable.NewElement("First", &first));
+    ids.push_back(StateTable.NewElement("Second", &second));
+
+    mtsDouble firstRead, secondRead;
+    std::vector<mtsGenericObject *> data;
+    data.push_back(&firstRead);
+    data.push_back(&secondRead);
+
+    mtsStateTableTestWriterData writer;
+    writer.Table = &StateTable;
+    writer.First = &first;
+    writer.Second = &second;
+    osaThread writerThread;
+    writerThread.Create(mtsStateTableTestWriter, &writer);
+
+    mtsStateIndex when;
+    bool error = false;
+    size_t consistent = 0;
+    while (firstRead.Data < static_cast<double>(StateTableTestNumberOfAdvances)) {
+        if (StateTable.GetLatestConsistent(ids, data, when)) {
+            error = error || (firstRead.Data != -secondRead.Data);
+            consistent++;
+        }
+        osaCurrentThreadYield();
+    }
+    writerThread.Wait();
+    CPPUNIT_ASSERT(!error);
+    CPPUNIT_ASSERT(consistent > 0);
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsStateTableTest);
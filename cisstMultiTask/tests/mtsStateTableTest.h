@@ -30,6 +30,9 @@ class mtsStateTableTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsStateTableTest);
     {
         CPPUNIT_TEST(TestGetStateVectorID);
+        CPPUNIT_TEST(TestColumnarStorage);
+        CPPUNIT_TEST(TestConsistentRead);
+        CPPUNIT_TEST(TestConsistentReadMultiThreading);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -39,4 +42,10 @@ public:
     void tearDown(void);
 
     void TestGetStateVectorID(void);
+
+    void TestColumnarStorage(void);
+
+    void TestConsistentRead(void);
+
+    void TestConsistentReadMultiThreading(void);
 };
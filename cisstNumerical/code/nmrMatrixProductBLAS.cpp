@@ -0,0 +1,64 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstNumerical/nmrMatrixProductBLAS.h>
+
+extern "C" {
+    void dgemm_(char * TRANSA, char * TRANSB,
+                CISSTNETLIB_INTEGER * M, CISSTNETLIB_INTEGER * N, CISSTNETLIB_INTEGER * K,
+                CISSTNETLIB_DOUBLE * ALPHA,
+                CISSTNETLIB_DOUBLE * A, CISSTNETLIB_INTEGER * LDA,
+                CISSTNETLIB_DOUBLE * B, CISSTNETLIB_INTEGER * LDB,
+                CISSTNETLIB_DOUBLE * BETA,
+                CISSTNETLIB_DOUBLE * C, CISSTNETLIB_INTEGER * LDC);
+}
+
+
+void nmrMatrixProductBLAS(bool transposeA, bool transposeB,
+                          size_t m, size_t n, size_t k,
+                          const double * A, size_t lda,
+                          const double * B, size_t ldb,
+                          double * C, size_t ldc)
+{
+    char transA = transposeA ? 'T' : 'N';
+    char transB = transposeB ? 'T' : 'N';
+    CISSTNETLIB_INTEGER M = static_cast<CISSTNETLIB_INTEGER>(m);
+    CISSTNETLIB_INTEGER N = static_cast<CISSTNETLIB_INTEGER>(n);
+    CISSTNETLIB_INTEGER K = static_cast<CISSTNETLIB_INTEGER>(k);
+    CISSTNETLIB_INTEGER LDA = static_cast<CISSTNETLIB_INTEGER>(lda);
+    CISSTNETLIB_INTEGER LDB = static_cast<CISSTNETLIB_INTEGER>(ldb);
+    CISSTNETLIB_INTEGER LDC = static_cast<CISSTNETLIB_INTEGER>(ldc);
+    CISSTNETLIB_DOUBLE alpha = 1.0;
+    CISSTNETLIB_DOUBLE beta = 0.0;
+    // dgemm doesn't modify A and B, the Fortran interface has no const
+    dgemm_(&transA, &transB, &M, &N, &K, &alpha,
+           const_cast<double *>(A), &LDA,
+           const_cast<double *>(B), &LDB,
+           &beta, C, &LDC);
+}
+
+
+void nmrUseBLASForMatrixProduct(bool useBLAS, size_t minimumSize)
+{
+    if (useBLAS) {
+        vctDynamicMatrixProductBackend::SetDoubleFunction(nmrMatrixProductBLAS, minimumSize);
+    } else {
+        vctDynamicMatrixProductBackend::SetDoubleFunction(0, minimumSize);
+    }
+}
@@ -0,0 +1,73 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Declaration of nmrUseBLASForMatrixProduct
+*/
+
+
+#ifndef _nmrMatrixProductBLAS_h
+#define _nmrMatrixProductBLAS_h
+
+#include <cisstVector/vctDynamicMatrixProductBackend.h>
+#include <cisstNumerical/nmrNetlib.h>
+
+// Always include last
+#include <cisstNumerical/nmrExport.h>
+
+/*!
+  \ingroup cisstNumerical
+
+  Compute the product of two double precision matrices in column
+  major storage order with the BLAS function dgemm provided by
+  cisstNetlib, i.e. C = op(A) * op(B).  This function has the
+  signature expected by vctDynamicMatrixProductBackend and should
+  usually not be called directly.
+*/
+CISST_EXPORT void nmrMatrixProductBLAS(bool transposeA, bool transposeB,
+                                       size_t m, size_t n, size_t k,
+                                       const double * A, size_t lda,
+                                       const double * B, size_t ldb,
+                                       double * C, size_t ldc);
+
+/*!
+  \ingroup cisstNumerical
+
+  Use (or stop using) dgemm for the products of compact double
+  precision dynamic matrices computed by
+  vctDynamicMatrixBase::ProductOf (and the operator *) when all the
+  dimensions are greater or equal to minimumSize.  Smaller products
+  are faster with the engines of cisstVector.  This function is not
+  thread safe and should be called during the initialization of the
+  application, for example:
+
+  \code
+  int main(void) {
+      nmrUseBLASForMatrixProduct(true);
+      ...
+  }
+  \endcode
+
+  \sa vctDynamicMatrixProductBackend
+*/
+CISST_EXPORT void nmrUseBLASForMatrixProduct(bool useBLAS, size_t minimumSize = 64);
+
+#endif // _nmrMatrixProductBLAS_h
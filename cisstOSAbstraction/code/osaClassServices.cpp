@@ -23,6 +23,9 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaSerialPort.h>
 CMN_IMPLEMENT_SERVICES(osaSerialPort);
 
+#include <cisstOSAbstraction/osaSharedMemoryChannel.h>
+CMN_IMPLEMENT_SERVICES(osaSharedMemoryChannel);
+
 #include <cisstOSAbstraction/osaSocket.h>
 CMN_IMPLEMENT_SERVICES(osaSocket);
 
@@ -0,0 +1,628 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaSharedMemoryChannel.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+#include <string.h>
+#include <math.h>
+#include <new>
+
+#if (CISST_OS != CISST_WINDOWS)
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX_XENOMAI)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#define OSA_SHARED_MEMORY_HAS_FUTEX 1
+#else
+#define OSA_SHARED_MEMORY_HAS_FUTEX 0
+#endif
+
+// Layout of the shared memory segment:
+//   - osaSharedMemoryHeader
+//   - osaSharedMemorySlot for each client
+//   - ring buffers, client to server then server to client for each client
+// Each ring contains records made of a header (message size and commit flag)
+// followed by the message, padded to 8 bytes.  A record never wraps around the
+// end of the ring; if there is not enough space at the end, a wrap marker is
+// written and the record starts at the beginning of the ring.  Head and Tail
+// are byte counters that wrap around at 2^32, the ring size is a power of two.
+// Senders reserve a record by moving Head with a compare and swap, copy the
+// message and then set the commit flag.  The receiver stops at the first
+// record not committed yet and zeroes the records it reads before moving Tail,
+// so the free part of the ring is always zero.
+
+namespace {
+
+    const unsigned int SegmentMagic = 0x4d61736f;
+    const unsigned int SegmentVersion = 2;
+    const unsigned int RecordWrap = 0xFFFFFFFF;
+    const unsigned int RecordHeaderSize = 8;
+    const unsigned int MinimumRingSize = 4096;
+    const unsigned int MaximumRingSize = 1 << 30;
+    const unsigned int SpinCount = 2000;
+    const unsigned int SlotFree = 0;
+    const unsigned int SlotUsed = 1;
+
+    inline size_t AlignSize(size_t size, size_t alignment) {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Used to wake up the receiver, Sequence is incremented for each message
+    struct osaSharedMemoryDoorbell {
+        osaAtomic<unsigned int> Sequence;
+        osaAtomic<unsigned int> Waiting;
+        char Padding[OSA_CACHE_LINE_SIZE - 2 * sizeof(osaAtomic<unsigned int>)];
+    };
+
+    // Head is reserved by the producers, Tail is written by the consumer.  Reset is
+    // set when a client replaces a dead one, the consumer then drops all the records
+    struct osaSharedMemoryRing {
+        osaAtomic<unsigned int> Head;
+        char Padding0[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>)];
+        osaAtomic<unsigned int> Tail;
+        char Padding1[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>)];
+        osaAtomic<unsigned int> Reset;
+        char Padding2[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>)];
+    };
+
+    // Header of each record, RecordHeaderSize bytes
+    struct osaSharedMemoryRecord {
+        unsigned int Size;
+        osaAtomic<unsigned int> Committed;
+    };
+
+    struct osaSharedMemoryHeader {
+        osaAtomic<unsigned int> Magic;
+        unsigned int Version;
+        unsigned int NumberOfClients;
+        unsigned int RingSize;
+        char Padding[OSA_CACHE_LINE_SIZE - 4 * sizeof(unsigned int)];
+        osaSharedMemoryDoorbell ServerDoorbell;
+    };
+
+    struct osaSharedMemorySlot {
+        osaAtomic<unsigned int> State;
+        osaAtomic<int> ProcessId;
+        char Padding[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>) - sizeof(osaAtomic<int>)];
+        osaSharedMemoryDoorbell ClientDoorbell;
+        osaSharedMemoryRing ToServer;
+        osaSharedMemoryRing ToClient;
+    };
+
+    inline osaSharedMemoryHeader * GetHeader(void * segment) {
+        return reinterpret_cast<osaSharedMemoryHeader *>(segment);
+    }
+
+    inline osaSharedMemorySlot * GetSlot(void * segment, unsigned int client) {
+        return reinterpret_cast<osaSharedMemorySlot *>(reinterpret_cast<char *>(segment)
+                                                       + sizeof(osaSharedMemoryHeader))
+            + client;
+    }
+
+    inline size_t RingsOffset(unsigned int numberOfClients) {
+        return AlignSize(sizeof(osaSharedMemoryHeader) + numberOfClients * sizeof(osaSharedMemorySlot),
+                         OSA_CACHE_LINE_SIZE);
+    }
+
+    inline size_t SegmentSizeFor(unsigned int numberOfClients, unsigned int ringSize) {
+        return RingsOffset(numberOfClients) + 2 * static_cast<size_t>(numberOfClients) * ringSize;
+    }
+
+    inline char * GetRingData(void * segment, unsigned int numberOfClients, unsigned int ringSize,
+                              unsigned int client, bool toServer) {
+        return reinterpret_cast<char *>(segment) + RingsOffset(numberOfClients)
+            + (2 * static_cast<size_t>(client) + (toServer ? 0 : 1)) * ringSize;
+    }
+
+    inline osaSharedMemoryRecord * GetRecord(char * ringData, unsigned int offset) {
+        return reinterpret_cast<osaSharedMemoryRecord *>(ringData + offset);
+    }
+
+    // Zero the bytes from one position to another, wrapping around the end of the ring
+    void ClearRing(char * ringData, unsigned int ringSize, unsigned int from, unsigned int to)
+    {
+        while (from != to) {
+            const unsigned int offset = from & (ringSize - 1);
+            unsigned int length = to - from;
+            if (length > ringSize - offset) {
+                length = ringSize - offset;
+            }
+            memset(ringData + offset, 0, length);
+            from += length;
+        }
+    }
+
+    void DoorbellWait(osaSharedMemoryDoorbell & doorbell, unsigned int sequence, double timeoutSec)
+    {
+#if OSA_SHARED_MEMORY_HAS_FUTEX
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(floor(timeoutSec));
+        timeout.tv_nsec = static_cast<long>((timeoutSec - timeout.tv_sec) * 1e9);
+        // The segment is shared between processes, can't use FUTEX_PRIVATE_FLAG
+        syscall(SYS_futex, const_cast<unsigned int *>(doorbell.Sequence.Pointer()),
+                FUTEX_WAIT, sequence, &timeout, 0, 0);
+#else
+        const double pollingPeriod = 50.0 * cmn_us;
+        const double endTime = osaGetTime() + timeoutSec;
+        while ((doorbell.Sequence.Load() == sequence) && (osaGetTime() < endTime)) {
+            osaSleep(pollingPeriod);
+        }
+#endif
+    }
+
+    void DoorbellRing(osaSharedMemoryDoorbell & doorbell)
+    {
+        doorbell.Sequence.FetchAdd(1);
+        if (doorbell.Waiting.Load() != 0) {
+#if OSA_SHARED_MEMORY_HAS_FUTEX
+            syscall(SYS_futex, const_cast<unsigned int *>(doorbell.Sequence.Pointer()),
+                    FUTEX_WAKE, INT_MAX, 0, 0, 0);
+#endif
+        }
+    }
+}
+
+
+osaSharedMemoryChannel::osaSharedMemoryChannel(void):
+    Segment(0),
+    SegmentSize(0),
+    Server(false),
+    NumberOfClients(0),
+    RingSize(0),
+    Destination(0),
+    NextClient(0)
+{
+}
+
+
+osaSharedMemoryChannel::~osaSharedMemoryChannel()
+{
+    Close();
+}
+
+
+#if (CISST_OS == CISST_WINDOWS)
+
+bool osaSharedMemoryChannel::Map(int CMN_UNUSED(fileDescriptor), size_t CMN_UNUSED(size))
+{
+    return false;
+}
+
+bool osaSharedMemoryChannel::Create(const std::string & CMN_UNUSED(name),
+                                    unsigned int CMN_UNUSED(numberOfClients),
+                                    unsigned int CMN_UNUSED(ringSize))
+{
+    CMN_LOG_CLASS_INIT_ERROR << "Create: shared memory channels are not supported on Windows" << std::endl;
+    return false;
+}
+
+bool osaSharedMemoryChannel::Connect(const std::string & CMN_UNUSED(name))
+{
+    CMN_LOG_CLASS_INIT_ERROR << "Connect: shared memory channels are not supported on Windows" << std::endl;
+    return false;
+}
+
+bool osaSharedMemoryChannel::Close(void)
+{
+    return true;
+}
+
+#else
+
+bool osaSharedMemoryChannel::Map(int fileDescriptor, size_t size)
+{
+    void * memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (memory == MAP_FAILED) {
+        CMN_LOG_CLASS_INIT_ERROR << "Map: failed to map \"" << Name << "\": " << strerror(errno) << std::endl;
+        return false;
+    }
+    Segment = memory;
+    SegmentSize = size;
+    return true;
+}
+
+
+bool osaSharedMemoryChannel::Create(const std::string & name,
+                                    unsigned int numberOfClients,
+                                    unsigned int ringSize)
+{
+    Close();
+    if (numberOfClients == 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Create: number of clients must be at least 1" << std::endl;
+        return false;
+    }
+    if (ringSize > MaximumRingSize) {
+        CMN_LOG_CLASS_INIT_ERROR << "Create: ring size " << ringSize << " is too large" << std::endl;
+        return false;
+    }
+    ringSize = static_cast<unsigned int>(osaAtomicNextPowerOfTwo(ringSize));
+    if (ringSize < MinimumRingSize) {
+        ringSize = MinimumRingSize;
+    }
+    Name = ((!name.empty()) && (name[0] == '/')) ? name : ("/" + name);
+    const size_t size = SegmentSizeFor(numberOfClients, ringSize);
+
+    // Remove the segment left by a previous server, clients still connected to it won't get any response
+    shm_unlink(Name.c_str());
+    int fileDescriptor = shm_open(Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fileDescriptor < 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Create: failed to create \"" << Name << "\": " << strerror(errno) << std::endl;
+        return false;
+    }
+    // The new segment is filled with zeros
+    if (ftruncate(fileDescriptor, static_cast<off_t>(size)) != 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Create: failed to resize \"" << Name << "\": " << strerror(errno) << std::endl;
+        close(fileDescriptor);
+        shm_unlink(Name.c_str());
+        return false;
+    }
+    if (!Map(fileDescriptor, size)) {
+        shm_unlink(Name.c_str());
+        return false;
+    }
+
+    osaSharedMemoryHeader * header = new (Segment) osaSharedMemoryHeader;
+    header->Version = SegmentVersion;
+    header->NumberOfClients = numberOfClients;
+    header->RingSize = ringSize;
+    for (unsigned int client = 0; client < numberOfClients; client++) {
+        new (GetSlot(Segment, client)) osaSharedMemorySlot;
+    }
+    // Clients check the magic number last
+    header->Magic.Store(SegmentMagic);
+
+    Server = true;
+    NumberOfClients = numberOfClients;
+    RingSize = ringSize;
+    Destination = 0;
+    NextClient = 0;
+    CMN_LOG_CLASS_INIT_VERBOSE << "Create: created \"" << Name << "\" for " << numberOfClients
+                               << " clients, ring size " << ringSize << std::endl;
+    return true;
+}
+
+
+bool osaSharedMemoryChannel::Connect(const std::string & name)
+{
+    Close();
+    Name = ((!name.empty()) && (name[0] == '/')) ? name : ("/" + name);
+    int fileDescriptor = shm_open(Name.c_str(), O_RDWR, 0);
+    if (fileDescriptor < 0) {
+        CMN_LOG_CLASS_INIT_ERROR << "Connect: failed to open \"" << Name << "\": " << strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat status;
+    if ((fstat(fileDescriptor, &status) != 0)
+        || (static_cast<size_t>(status.st_size) < sizeof(osaSharedMemoryHeader))) {
+        CMN_LOG_CLASS_INIT_ERROR << "Connect: invalid segment \"" << Name << "\"" << std::endl;
+        close(fileDescriptor);
+        return false;
+    }
+    if (!Map(fileDescriptor, static_cast<size_t>(status.st_size))) {
+        return false;
+    }
+
+    osaSharedMemoryHeader * header = GetHeader(Segment);
+    if ((header->Magic.Load() != SegmentMagic)
+        || (header->Version != SegmentVersion)
+        || (SegmentSizeFor(header->NumberOfClients, header->RingSize) != SegmentSize)) {
+        CMN_LOG_CLASS_INIT_ERROR << "Connect: segment \"" << Name << "\" is not initialized or has a different version"
+                                 << std::endl;
+        munmap(Segment, SegmentSize);
+        Segment = 0;
+        return false;
+    }
+    NumberOfClients = header->NumberOfClients;
+    RingSize = header->RingSize;
+
+    // Claim a free slot, or the slot of a client process that no longer exists
+    const int processId = static_cast<int>(getpid());
+    unsigned int client = 0;
+    bool claimed = false;
+    bool reclaimed = false;
+    while (!claimed && (client < NumberOfClients)) {
+        unsigned int expected = SlotFree;
+        claimed = GetSlot(Segment, client)->State.CompareExchange(expected, SlotUsed);
+        if (!claimed) {
+            client++;
+        }
+    }
+    if (!claimed) {
+        client = 0;
+    }
+    while (!claimed && (client < NumberOfClients)) {
+        int owner = GetSlot(Segment, client)->ProcessId.Load();
+        if ((owner != 0) && (kill(owner, 0) != 0) && (errno == ESRCH)) {
+            claimed = GetSlot(Segment, client)->ProcessId.CompareExchange(owner, processId);
+            reclaimed = claimed;
+        }
+        if (!claimed) {
+            client++;
+        }
+    }
+    if (!claimed) {
+        CMN_LOG_CLASS_INIT_ERROR << "Connect: no client slot available in \"" << Name << "\"" << std::endl;
+        munmap(Segment, SegmentSize);
+        Segment = 0;
+        return false;
+    }
+    osaSharedMemorySlot * slot = GetSlot(Segment, client);
+    slot->ProcessId.Store(processId);
+    Server = false;
+    Destination = client;
+
+    // Drop the messages the previous client didn't receive, a reply still being
+    // written by the server will be received
+    while (Pop(client, false, 0, 0) >= 0) {
+    }
+    if (reclaimed) {
+        // The dead client might have reserved space without committing it,
+        // the server resets the ring on its next receive
+        slot->ToServer.Reset.Store(1);
+        DoorbellRing(header->ServerDoorbell);
+    }
+    CMN_LOG_CLASS_INIT_VERBOSE << "Connect: connected to \"" << Name << "\" as client " << client << std::endl;
+    return true;
+}
+
+
+bool osaSharedMemoryChannel::Close(void)
+{
+    if (!Segment) {
+        return true;
+    }
+    if (Server) {
+        GetHeader(Segment)->Magic.Store(0);
+        munmap(Segment, SegmentSize);
+        shm_unlink(Name.c_str());
+    } else {
+        osaSharedMemorySlot * slot = GetSlot(Segment, Destination);
+        slot->ProcessId.Store(0);
+        slot->State.Store(SlotFree);
+        munmap(Segment, SegmentSize);
+    }
+    Segment = 0;
+    SegmentSize = 0;
+    return true;
+}
+
+#endif // CISST_WINDOWS
+
+
+void osaSharedMemoryChannel::SetDestination(unsigned int client)
+{
+    if (!Server) {
+        CMN_LOG_CLASS_RUN_WARNING << "SetDestination: clients always send to the server" << std::endl;
+        return;
+    }
+    Destination = client;
+}
+
+
+unsigned int osaSharedMemoryChannel::GetMaximumMessageSize(void) const
+{
+    // Guarantees that a record fits in an empty ring, even if it has to wrap around
+    return (RingSize == 0) ? 0 : (RingSize / 2 - RecordHeaderSize);
+}
+
+
+bool osaSharedMemoryChannel::Push(unsigned int client, bool toServer, const char * data, unsigned int size)
+{
+    osaSharedMemorySlot * slot = GetSlot(Segment, client);
+    osaSharedMemoryRing & ring = toServer ? slot->ToServer : slot->ToClient;
+    char * base = GetRingData(Segment, NumberOfClients, RingSize, client, toServer);
+    const unsigned int mask = RingSize - 1;
+    const unsigned int recordSize = static_cast<unsigned int>(AlignSize(RecordHeaderSize + size, RecordHeaderSize));
+
+    // Wait for the server to drop the records of the previous client
+    if (ring.Reset.Load() != 0) {
+        return false;
+    }
+
+    // Reserve the record, sending threads never wait for each other
+    unsigned int head, used, contiguous, needed;
+    do {
+        head = ring.Head.Load();
+        used = head - ring.Tail.Load();
+        contiguous = RingSize - (head & mask);
+        needed = (contiguous < recordSize) ? (contiguous + recordSize) : recordSize;
+        // If other senders and the receiver went past head, used is meaningless
+        if ((used <= RingSize) && (RingSize - used < needed)) {
+            return false;
+        }
+    } while ((used > RingSize) || !ring.Head.CompareExchange(head, head + needed));
+
+    unsigned int position = head;
+    osaSharedMemoryRecord * record;
+    if (contiguous < recordSize) {
+        record = GetRecord(base, position & mask);
+        record->Size = RecordWrap;
+        record->Committed.Store(1);
+        position += contiguous;
+    }
+    record = GetRecord(base, position & mask);
+    record->Size = size;
+    memcpy(base + (position & mask) + RecordHeaderSize, data, size);
+    record->Committed.Store(1);
+    return true;
+}
+
+
+int osaSharedMemoryChannel::Pop(unsigned int client, bool toServer, char * buffer, unsigned int maxlen)
+{
+    osaSharedMemorySlot * slot = GetSlot(Segment, client);
+    osaSharedMemoryRing & ring = toServer ? slot->ToServer : slot->ToClient;
+    char * base = GetRingData(Segment, NumberOfClients, RingSize, client, toServer);
+    const unsigned int mask = RingSize - 1;
+    const unsigned int tail = ring.Tail.LoadRelaxed();
+    if (ring.Reset.Load() != 0) {
+        // The previous client won't send anymore
+        const unsigned int head = ring.Head.Load();
+        ClearRing(base, RingSize, tail, head);
+        ring.Tail.Store(head);
+        ring.Reset.Store(0);
+        return -1;
+    }
+    if (ring.Head.Load() == tail) {
+        return -1;
+    }
+    // Reserved records are committed in any order, wait for the oldest one
+    unsigned int position = tail;
+    osaSharedMemoryRecord * record = GetRecord(base, position & mask);
+    if (record->Committed.Load() == 0) {
+        return -1;
+    }
+    if (record->Size == RecordWrap) {
+        position += RingSize - (position & mask);
+        record = GetRecord(base, position & mask);
+        if (record->Committed.Load() == 0) {
+            return -1;
+        }
+    }
+    const unsigned int size = record->Size;
+    if (size > GetMaximumMessageSize()) {
+        CMN_LOG_CLASS_RUN_ERROR << "Pop: corrupted message of size " << size << " from client "
+                                << client << ", dropping all pending messages" << std::endl;
+        const unsigned int head = ring.Head.Load();
+        ClearRing(base, RingSize, tail, head);
+        ring.Tail.Store(head);
+        return -1;
+    }
+    const unsigned int length = (size < maxlen) ? size : maxlen;
+    if (buffer) {
+        memcpy(buffer, base + (position & mask) + RecordHeaderSize, length);
+    }
+    // Senders can reuse the space once it is zero again
+    position += static_cast<unsigned int>(AlignSize(RecordHeaderSize + size, RecordHeaderSize));
+    ClearRing(base, RingSize, tail, position);
+    ring.Tail.Store(position);
+    if (buffer && (length < size)) {
+        CMN_LOG_CLASS_RUN_ERROR << "Pop: message of size " << size << " truncated to " << maxlen << std::endl;
+    }
+    return static_cast<int>(length);
+}
+
+
+int osaSharedMemoryChannel::TryReceive(char * buffer, unsigned int maxlen)
+{
+    if (!Server) {
+        return Pop(Destination, false, buffer, maxlen);
+    }
+    for (unsigned int index = 0; index < NumberOfClients; index++) {
+        const unsigned int client = (NextClient + index) % NumberOfClients;
+        const int length = Pop(client, true, buffer, maxlen);
+        if (length >= 0) {
+            Destination = client;
+            NextClient = (client + 1) % NumberOfClients;
+            return length;
+        }
+    }
+    return -1;
+}
+
+
+int osaSharedMemoryChannel::Send(const char * data, unsigned int size, double timeoutSec)
+{
+    if (!Segment) {
+        CMN_LOG_CLASS_RUN_ERROR << "Send: channel is not open" << std::endl;
+        return -1;
+    }
+    if (size > GetMaximumMessageSize()) {
+        CMN_LOG_CLASS_RUN_ERROR << "Send: message of size " << size << " is larger than "
+                                << GetMaximumMessageSize() << std::endl;
+        return -1;
+    }
+    const unsigned int client = Destination;
+    if (client >= NumberOfClients) {
+        CMN_LOG_CLASS_RUN_ERROR << "Send: invalid destination " << client << std::endl;
+        return -1;
+    }
+    osaSharedMemorySlot * slot = GetSlot(Segment, client);
+    if (Server && (slot->State.LoadRelaxed() != SlotUsed)) {
+        // Client is gone, behave like UDP and drop the message
+        CMN_LOG_CLASS_RUN_DEBUG << "Send: client " << client << " is not connected" << std::endl;
+        return -1;
+    }
+    const bool toServer = !Server;
+    osaSharedMemoryDoorbell & doorbell = toServer ? GetHeader(Segment)->ServerDoorbell : slot->ClientDoorbell;
+    if (!Push(client, toServer, data, size)) {
+        // Ring is full, wait for the receiver
+        const double endTime = osaGetTime() + timeoutSec;
+        bool pushed = false;
+        while (!pushed && (osaGetTime() < endTime)) {
+            osaSleep(10.0 * cmn_us);
+            pushed = Push(client, toServer, data, size);
+        }
+        if (!pushed) {
+            CMN_LOG_CLASS_RUN_WARNING << "Send: ring buffer full for client " << client << std::endl;
+            return -1;
+        }
+    }
+    DoorbellRing(doorbell);
+    return static_cast<int>(size);
+}
+
+
+int osaSharedMemoryChannel::Receive(char * buffer, unsigned int maxlen, double timeoutSec)
+{
+    if (!Segment) {
+        CMN_LOG_CLASS_RUN_ERROR << "Receive: channel is not open" << std::endl;
+        return -1;
+    }
+    int length = TryReceive(buffer, maxlen);
+    if ((length >= 0) || (timeoutSec <= 0.0)) {
+        return (length >= 0) ? length : 0;
+    }
+    // Messages usually come quickly when waiting for a response, spin before sleeping
+    unsigned int spin;
+    for (spin = 0; spin < SpinCount; spin++) {
+        osaCPUPause();
+        length = TryReceive(buffer, maxlen);
+        if (length >= 0) {
+            return length;
+        }
+    }
+    osaSharedMemoryDoorbell & doorbell = Server ? GetHeader(Segment)->ServerDoorbell
+                                                : GetSlot(Segment, Destination)->ClientDoorbell;
+    const double endTime = osaGetTime() + timeoutSec;
+    while (true) {
+        // Senders check Waiting after publishing the message, so either the message is
+        // found below or the sequence has changed and the wait returns immediately
+        const unsigned int sequence = doorbell.Sequence.Load();
+        doorbell.Waiting.Exchange(1);
+        length = TryReceive(buffer, maxlen);
+        const double remaining = endTime - osaGetTime();
+        if ((length >= 0) || (remaining <= 0.0)) {
+            doorbell.Waiting.Store(0);
+            return (length >= 0) ? length : 0;
+        }
+        DoorbellWait(doorbell, sequence, remaining);
+    }
+}
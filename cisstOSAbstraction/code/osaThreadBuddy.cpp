@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaTimeServer.h>
 #include <cisstCommon/cmnUnits.h>
 #include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaAtomic.h>
 
 #if (CISST_OS == CISST_LINUX_RTAI)
     #include <sys/mman.h> // for mlockall
@@ -54,6 +55,34 @@ http://www.cisst.org/cisst/license.txt.
     #include <sys/time.h>
     #include <sys/select.h>
     #include <unistd.h>
+#if (CISST_OS == CISST_LINUX)
+    #include <errno.h>
+    #include <time.h>
+    #define OSA_THREAD_BUDDY_ABSOLUTE_DEADLINES 1
+#endif
+#endif
+
+#ifdef OSA_THREAD_BUDDY_ABSOLUTE_DEADLINES
+namespace {
+    const long long NanoSecondsPerSecond = 1000000000LL;
+
+    inline void AddNanoSeconds(struct timespec & time, long long nanoSeconds) {
+        long long total = time.tv_nsec + nanoSeconds;
+        time.tv_sec += static_cast<time_t>(total / NanoSecondsPerSecond);
+        total %= NanoSecondsPerSecond;
+        if (total < 0) {
+            total += NanoSecondsPerSecond;
+            time.tv_sec--;
+        }
+        time.tv_nsec = static_cast<long>(total);
+    }
+
+    // Returns later - earlier, in nanoseconds
+    inline long long DifferenceNanoSeconds(const struct timespec & later, const struct timespec & earlier) {
+        return (static_cast<long long>(later.tv_sec) - static_cast<long long>(earlier.tv_sec)) * NanoSecondsPerSecond
+            + (later.tv_nsec - earlier.tv_nsec);
+    }
+}
 #endif
 
 #if (CISST_OS == CISST_LINUX_RTAI)
@@ -256,11 +285,22 @@ struct osaThreadBuddyInternals {
 #else
     struct timeval DueTime;
     char Name[6];
+#ifdef OSA_THREAD_BUDDY_ABSOLUTE_DEADLINES
+    // Start of the next period when using absolute deadlines (CLOCK_MONOTONIC)
+    struct timespec Deadline;
+    bool DeadlineSet;
+#endif
 #endif // end of others
 };
 
 // Constructor. Allocates memory for thread buddy internal data.
-osaThreadBuddy::osaThreadBuddy() {
+osaThreadBuddy::osaThreadBuddy():
+    Period(0.0),
+    AbsoluteDeadlines(false),
+    SpinTime(0.0),
+    NumberOfOverruns(0),
+    NumberOfSkippedPeriods(0)
+{
     Data = new osaThreadBuddyInternals;
 }
 
@@ -294,6 +334,8 @@ void osaThreadBuddy::Create(const char *name, const osaAbsoluteTime& tv, int CMN
    
     Period = tv.sec*1000000000 + tv.nsec;
     Data->IsSuspended = false;
+    NumberOfOverruns = 0;
+    NumberOfSkippedPeriods = 0;
 
 #if (CISST_OS == CISST_LINUX_RTAI)
     // nam2num converts the character string 'name' to a long, using just the first
@@ -388,6 +430,9 @@ void osaThreadBuddy::Create(const char *name, const osaAbsoluteTime& tv, int CMN
 #else // default unix
     Data->DueTime.tv_sec = 0;
     Data->DueTime.tv_usec = 0;
+#ifdef OSA_THREAD_BUDDY_ABSOLUTE_DEADLINES
+    Data->DeadlineSet = false;
+#endif
     for (unsigned int i = 0; i < sizeof(Data->Name); i++) Data->Name[i] = name[i];
     Data->Name[sizeof(Data->Name)-1] = 0;
 #endif    
@@ -480,6 +525,10 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
         unsigned long overruns=0;
         int retval = 0;
         retval = rt_task_wait_period( &overruns );
+        if( overruns > 0 ){
+            NumberOfOverruns++;
+            NumberOfSkippedPeriods += overruns;
+        }
 
         if( retval != 0 ){            
             std::string errstr;
@@ -570,6 +619,47 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
     if (!IsPeriodic()) {
         return;
     }
+#ifdef OSA_THREAD_BUDDY_ABSOLUTE_DEADLINES
+    if (AbsoluteDeadlines) {
+        const long long period = static_cast<long long>(Period);
+        const long long spinTime = static_cast<long long>(SpinTime * NanoSecondsPerSecond);
+        struct timespec timeNow, timeWakeUp;
+        do {
+            clock_gettime(CLOCK_MONOTONIC, &timeNow);
+            if (!Data->DeadlineSet) {
+                // this is the first time this is being called
+                Data->Deadline = timeNow;
+                Data->DeadlineSet = true;
+            }
+            AddNanoSeconds(Data->Deadline, period);
+            const long long late = DifferenceNanoSeconds(timeNow, Data->Deadline);
+            if (late >= 0) {
+                // start the next period right away, skip the periods missed entirely
+                NumberOfOverruns++;
+                const long long skipped = late / period;
+                if (skipped > 0) {
+                    NumberOfSkippedPeriods += static_cast<unsigned long>(skipped);
+                    AddNanoSeconds(Data->Deadline, skipped * period);
+                }
+                continue;
+            }
+            timeWakeUp = Data->Deadline;
+            if (spinTime > 0) {
+                AddNanoSeconds(timeWakeUp, -spinTime);
+            }
+            if (DifferenceNanoSeconds(timeWakeUp, timeNow) > 0) {
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &timeWakeUp, NULL) == EINTR) {}
+            }
+            if (spinTime > 0) {
+                do {
+                    osaCPUPause();
+                    clock_gettime(CLOCK_MONOTONIC, &timeNow);
+                } while (DifferenceNanoSeconds(Data->Deadline, timeNow) > 0);
+            }
+        } while (Data->IsSuspended);
+        return;
+    }
+#endif
     double elapsedTimeMicroSec, timeRemainingNanoSec;
     struct timeval timeNow, timeLater;
     struct timespec timeSleep;
@@ -582,6 +672,10 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
         elapsedTimeMicroSec = static_cast<double>(1000 * 1000 * (timeNow.tv_sec - Data->DueTime.tv_sec)
                                                   + (timeNow.tv_usec - Data->DueTime.tv_usec)); // in usec
         timeRemainingNanoSec = Period - elapsedTimeMicroSec * 1000.0; // floating point
+        if (timeRemainingNanoSec <= 0.0) {
+            NumberOfOverruns++;
+            NumberOfSkippedPeriods += static_cast<unsigned long>(-timeRemainingNanoSec / Period);
+        }
         timeSleep.tv_sec = 0;
         timeSleep.tv_nsec = static_cast<long>(timeRemainingNanoSec);
         // this is required, at least for Mac OS X
@@ -597,6 +691,28 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
 #endif
 }
 
+bool osaThreadBuddy::SetAbsoluteDeadlines(bool absoluteDeadlines, double spinTimeInSeconds)
+{
+#ifdef OSA_THREAD_BUDDY_ABSOLUTE_DEADLINES
+    if (AbsoluteDeadlines != absoluteDeadlines) {
+        // restart from the current time
+        Data->DueTime.tv_sec = 0;
+        Data->DueTime.tv_usec = 0;
+        Data->DeadlineSet = false;
+    }
+    AbsoluteDeadlines = absoluteDeadlines;
+    SpinTime = (spinTimeInSeconds > 0.0) ? spinTimeInSeconds : 0.0;
+    return true;
+#else
+    if (absoluteDeadlines) {
+        CMN_LOG_INIT_WARNING << "osaThreadBuddy::SetAbsoluteDeadlines: not supported on this operating system" << std::endl;
+        return false;
+    }
+    SpinTime = spinTimeInSeconds;
+    return true;
+#endif
+}
+
 void osaThreadBuddy::MakeHardRealTime(void) 
 {
 #if (CISST_OS == CISST_LINUX_RTAI)
@@ -0,0 +1,114 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaThreadPool.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+
+
+osaThreadPool::osaThreadPool(size_t numberOfThreads):
+    Task(0),
+    TaskData(0),
+    NumberOfTasks(0),
+    NextTask(0),
+    RunningWorkers(0),
+    Busy(0),
+    Stopping(0)
+{
+    if (numberOfThreads == 0) {
+        const int numberOfCPUs = osaCPUGetCount();
+        numberOfThreads = (numberOfCPUs > 0) ? static_cast<size_t>(numberOfCPUs) : 1;
+    }
+    Workers.resize(numberOfThreads - 1);
+    for (size_t index = 0; index < Workers.size(); ++index) {
+        Workers[index] = new osaThread;
+        Workers[index]->Create<osaThreadPool, size_t>(this, &osaThreadPool::WorkerLoop, index, "PoolWorker");
+    }
+}
+
+
+osaThreadPool::~osaThreadPool()
+{
+    Stopping.Store(1);
+    for (size_t index = 0; index < Workers.size(); ++index) {
+        Workers[index]->Wakeup();
+    }
+    for (size_t index = 0; index < Workers.size(); ++index) {
+        Workers[index]->Wait();
+        delete Workers[index];
+    }
+}
+
+
+void osaThreadPool::Run(TaskFunctionType task, void * taskData, size_t numberOfTasks)
+{
+    int idle = 0;
+    if (Workers.empty() || (numberOfTasks < 2) || !Busy.CompareExchange(idle, 1)) {
+        for (size_t index = 0; index < numberOfTasks; ++index) {
+            task(taskData, index);
+        }
+        return;
+    }
+
+    // the calling thread runs tasks too, wake up at most one worker per other task
+    const size_t numberOfWorkers = (numberOfTasks - 1 < Workers.size()) ? (numberOfTasks - 1) : Workers.size();
+    Task = task;
+    TaskData = taskData;
+    NumberOfTasks = numberOfTasks;
+    NextTask.Store(0);
+    RunningWorkers.Store(numberOfWorkers);
+    for (size_t index = 0; index < numberOfWorkers; ++index) {
+        Workers[index]->Wakeup();
+    }
+
+    RunTasks();
+    Done.Wait();
+    Busy.Store(0);
+}
+
+
+void osaThreadPool::Execute(void * pool, TaskFunctionType task, void * taskData, size_t numberOfTasks)
+{
+    static_cast<osaThreadPool *>(pool)->Run(task, taskData, numberOfTasks);
+}
+
+
+void * osaThreadPool::WorkerLoop(size_t workerIndex)
+{
+    while (true) {
+        Workers[workerIndex]->WaitForWakeup();
+        if (Stopping.Load()) {
+            break;
+        }
+        RunTasks();
+        if (RunningWorkers.FetchSub(1) == 1) {
+            Done.Raise();
+        }
+    }
+    return 0;
+}
+
+
+void osaThreadPool::RunTasks(void)
+{
+    size_t index;
+    while ((index = NextTask.FetchAdd(1)) < NumberOfTasks) {
+        Task(TaskData, index);
+    }
+}
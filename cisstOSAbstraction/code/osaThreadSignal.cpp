@@ -36,6 +36,15 @@ http://www.cisst.org/cisst/license.txt.
 #endif // USE_POSIX_SEMAPHORES
 #endif // CISST_LINUX_RTAI || CISST_LINUX || CISST_DARWIN || CISST_SOLARIS || CISST_QNX
 
+#if (CISST_OS == CISST_LINUX)
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 #if (CISST_OS == CISST_LINUX_XENOMAI)
 #include <native/task.h>
 #include <native/mutex.h>
@@ -224,7 +233,15 @@ struct osaThreadSignalInternals
     HANDLE hEvent;
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if (CISST_OS == CISST_LINUX)
+    // State word used for futex wait/wake, see RAISED, PARKED and GENERATION
+    osaAtomic<unsigned int> State;
+    unsigned int MaximumSpinCount;
+    // Adapted after each wait, based on how long the spin phase took
+    osaAtomic<unsigned int> SpinCount;
+#endif
+
+#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     pthread_mutex_t gnuMutex;
     pthread_cond_t gnuCondition;
     int ConditionState;
@@ -243,6 +260,115 @@ struct osaThreadSignalInternals
 
 static osaThreadId CallbackThreadId;
 
+#if (CISST_OS == CISST_LINUX)
+namespace {
+    // Bits of osaThreadSignalInternals::State.  The generation is
+    // incremented by each Raise so that all threads parked at the time
+    // are released, even if one of them already reset the raised bit.
+    const unsigned int RAISED = 1;
+    const unsigned int PARKED = 2;
+    const unsigned int GENERATION = 4;
+    const unsigned int FLAGS = RAISED | PARKED;
+
+    const unsigned int DEFAULT_MAXIMUM_SPIN_COUNT = 1000;
+    const unsigned int MINIMUM_SPIN_COUNT = 16;
+
+    // Reset the raised bit, returns true if it was set
+    inline bool TryConsume(osaAtomic<unsigned int> & state) {
+        unsigned int current = state.LoadRelaxed();
+        while (current & RAISED) {
+            if (state.CompareExchange(current, current & ~RAISED)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Spin for a while before parking, the number of iterations follows
+    // the number needed by the recent waits that succeeded while spinning
+    bool SpinWait(osaThreadSignalInternals & internals) {
+        const unsigned int maximum = internals.MaximumSpinCount;
+        if (maximum == 0) {
+            return false;
+        }
+        unsigned int limit = internals.SpinCount.LoadRelaxed();
+        if (limit < MINIMUM_SPIN_COUNT) {
+            limit = MINIMUM_SPIN_COUNT;
+        }
+        if (limit > maximum) {
+            limit = maximum;
+        }
+        for (unsigned int iteration = 0; iteration < limit; ++iteration) {
+            if (TryConsume(internals.State)) {
+                const unsigned int count = internals.SpinCount.LoadRelaxed();
+                internals.SpinCount.StoreRelaxed((7 * count + 2 * iteration + MINIMUM_SPIN_COUNT) / 8);
+                return true;
+            }
+            osaCPUPause();
+        }
+        // spinning didn't pay off, spin less next time
+        internals.SpinCount.StoreRelaxed(limit / 2);
+        return false;
+    }
+
+    // Returns false if timeout happened
+    bool FutexWait(osaThreadSignalInternals & internals, double timeoutInSec) {
+        if (SpinWait(internals)) {
+            return true;
+        }
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        double seconds;
+        const double fraction = modf(timeoutInSec, &seconds);
+        deadline.tv_sec += static_cast<time_t>(seconds);
+        deadline.tv_nsec += static_cast<long>(fraction * 1e9);
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        osaAtomic<unsigned int> & state = internals.State;
+        unsigned int current = state.Load();
+        while (true) {
+            if (current & RAISED) {
+                if (state.CompareExchange(current, current & ~RAISED)) {
+                    return true;
+                }
+                continue;
+            }
+            // let Raise know it has to wake us up
+            if (!(current & PARKED)) {
+                if (!state.CompareExchange(current, current | PARKED)) {
+                    continue;
+                }
+                current |= PARKED;
+            }
+            timespec now, remaining;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            remaining.tv_sec = deadline.tv_sec - now.tv_sec;
+            remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+            if (remaining.tv_nsec < 0) {
+                remaining.tv_sec--;
+                remaining.tv_nsec += 1000000000L;
+            }
+            if (remaining.tv_sec < 0) {
+                return false;
+            }
+            // returns right away if the state changed since it was read
+            syscall(SYS_futex, const_cast<unsigned int *>(state.Pointer()),
+                    FUTEX_WAIT_PRIVATE, current, &remaining, 0, 0);
+            const unsigned int after = state.Load();
+            if ((after & ~FLAGS) != (current & ~FLAGS)) {
+                // raised while parked
+                TryConsume(state);
+                return true;
+            }
+            current = after;
+        }
+    }
+}
+#endif
+
 void (*osaThreadSignal::PreCallback)(void) = 0;
 void (*osaThreadSignal::PostCallback)(void) = 0;
 
@@ -252,14 +378,19 @@ void (*osaThreadSignal::PostCallback)(void) = 0;
 
 osaThreadSignal::osaThreadSignal()
 {
-    this->Internals = new osaThreadSignalInternals;
-    memset(Internals, 0, sizeof(*Internals));
+    this->Internals = new osaThreadSignalInternals();
+
+#if (CISST_OS == CISST_LINUX)
+    // spinning can't help if there is no other processor to raise the signal
+    Internals->MaximumSpinCount = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? DEFAULT_MAXIMUM_SPIN_COUNT : 0;
+    Internals->SpinCount.StoreRelaxed(Internals->MaximumSpinCount);
+#endif
 
 #if (CISST_OS == CISST_WINDOWS)
 	Internals->hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_mutex_init(&(Internals->gnuMutex), 0);
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -331,7 +462,7 @@ osaThreadSignal::~osaThreadSignal()
 	CloseHandle(Internals->hEvent);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_cond_destroy(&(Internals->gnuCondition));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -399,7 +530,18 @@ void osaThreadSignal::Raise(void)
     ::SetEvent(Internals->hEvent);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if (CISST_OS == CISST_LINUX)
+    unsigned int current = Internals->State.LoadRelaxed();
+    while (!Internals->State.CompareExchange(current, ((current & ~FLAGS) + GENERATION) | RAISED)) {
+    }
+    // no system call unless a thread is parked
+    if (current & PARKED) {
+        syscall(SYS_futex, const_cast<unsigned int *>(Internals->State.Pointer()),
+                FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+    }
+#endif
+
+#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_mutex_lock(&(Internals->gnuMutex));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -531,8 +673,8 @@ bool osaThreadSignal::Wait(double timeoutInSec)
     if (do_callback) {
         PreCallback();
     }
-    unsigned int millisec = (unsigned int)(timeoutInSec * 1000);
 #if (CISST_OS == CISST_WINDOWS)
+    unsigned int millisec = (unsigned int)(timeoutInSec * 1000);
     if (WaitForSingleObject(Internals->hEvent, millisec) == WAIT_TIMEOUT) {
         if (do_callback) {
             PostCallback();
@@ -541,7 +683,16 @@ bool osaThreadSignal::Wait(double timeoutInSec)
     }
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if (CISST_OS == CISST_LINUX)
+    const bool raised = FutexWait(*Internals, timeoutInSec);
+    if (do_callback) {
+        PostCallback();
+    }
+    return raised;
+#endif
+
+#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+    unsigned int millisec = (unsigned int)(timeoutInSec * 1000);
     int retval = pthread_mutex_lock(&(Internals->gnuMutex));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -688,6 +839,7 @@ bool osaThreadSignal::Wait(double timeoutInSec)
     }
     else{
     */
+    unsigned int millisec = (unsigned int)(timeoutInSec * 1000);
     int retval = pthread_mutex_lock(&(Internals->gnuMutex));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -773,7 +925,10 @@ void osaThreadSignal::ToStream(std::ostream & outputStream) const
 #if (CISST_OS == CISST_WINDOWS)
     outputStream << "handle = " << Internals->hEvent << std::endl;
 #endif
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if (CISST_OS == CISST_LINUX)
+    outputStream << "state = " << Internals->State.Load() << std::endl;
+#endif
+#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     outputStream << "condition_state = " << Internals->ConditionState << std::endl;
 #endif
 #if (CISST_OS == CISST_LINUX_XENOMAI)
@@ -788,3 +943,12 @@ void osaThreadSignal::SetWaitCallbacks(const osaThreadId &threadId, void (*pre)(
     PreCallback = pre;
     PostCallback = post;
 }
+
+
+void osaThreadSignal::SetMaximumSpinCount(unsigned int maximumSpinCount)
+{
+#if (CISST_OS == CISST_LINUX)
+    Internals->MaximumSpinCount = maximumSpinCount;
+    Internals->SpinCount.StoreRelaxed(maximumSpinCount);
+#endif
+}
@@ -0,0 +1,176 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Measures the time spent by the writer and the reader of a triple
+// buffer, comparing osaTripleBuffer with the previous implementation
+// based on a mutex (reproduced below as mutexTripleBuffer).
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstOSAbstraction/osaTripleBuffer.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// number of doubles in the element, e.g. state of a robot
+const size_t confElementSize = 64;
+// number of writes measured
+const size_t confNumberOfWrites = 1000 * 1000;
+
+// relative time has a better resolution than osaGetTime
+osaTimeServer TimeServer;
+
+class benchmarkElement {
+public:
+    double Data[confElementSize];
+};
+
+// previous implementation, circular list of nodes protected by a mutex
+class mutexTripleBuffer
+{
+    class Node {
+    public:
+        benchmarkElement Element;
+        Node * Next;
+    };
+    Node Nodes[3];
+    Node * volatile LastWriteNode;
+    Node * volatile WriteNode;
+    Node * volatile ReadNode;
+    osaMutex Mutex;
+
+public:
+    mutexTripleBuffer(void):
+        WriteNode(0),
+        ReadNode(0)
+    {
+        Nodes[0].Next = &Nodes[1];
+        Nodes[1].Next = &Nodes[2];
+        Nodes[2].Next = &Nodes[0];
+        LastWriteNode = &Nodes[0];
+    }
+
+    void Read(benchmarkElement & element) {
+        Mutex.Lock(); {
+            ReadNode = LastWriteNode;
+        } Mutex.Unlock();
+        element = ReadNode->Element;
+        Mutex.Lock(); {
+            ReadNode = 0;
+        } Mutex.Unlock();
+    }
+
+    void Write(const benchmarkElement & element) {
+        WriteNode = LastWriteNode->Next;
+        Mutex.Lock(); {
+            if (WriteNode == ReadNode) {
+                WriteNode = WriteNode->Next;
+            }
+        } Mutex.Unlock();
+        WriteNode->Element = element;
+        LastWriteNode = WriteNode;
+    }
+};
+
+// time spent in each operation
+class benchmarkTimes {
+public:
+    std::vector<double> Times;
+
+    void Print(const std::string & name) {
+        std::sort(Times.begin(), Times.end());
+        const size_t size = Times.size();
+        double sum = 0.0;
+        for (size_t index = 0; index < size; ++index) {
+            sum += Times[index];
+        }
+        std::cout << "  " << std::setw(7) << name
+                  << " count: " << std::setw(9) << size
+                  << "  mean: " << std::setw(8) << (sum / size) / cmn_us
+                  << "  99.9%: " << std::setw(8) << Times[(size * 999) / 1000] / cmn_us
+                  << "  max: " << std::setw(8) << Times[size - 1] / cmn_us
+                  << " (us)" << std::endl;
+    }
+};
+
+template <class _bufferType>
+class benchmarkReader {
+public:
+    _bufferType * Buffer;
+    benchmarkTimes Times;
+    volatile bool Stop;
+
+    void * Run(int) {
+        benchmarkElement element;
+        while (!Stop) {
+            const double start = TimeServer.GetRelativeTime();
+            Buffer->Read(element);
+            Times.Times.push_back(TimeServer.GetRelativeTime() - start);
+        }
+        return 0;
+    }
+};
+
+template <class _bufferType>
+void benchmarkRun(_bufferType & buffer, const std::string & name)
+{
+    benchmarkReader<_bufferType> reader;
+    reader.Buffer = &buffer;
+    reader.Stop = false;
+    reader.Times.Times.reserve(10 * confNumberOfWrites);
+    osaThread thread;
+    thread.Create<benchmarkReader<_bufferType>, int>(&reader, &benchmarkReader<_bufferType>::Run, 0, "reader");
+
+    benchmarkTimes writeTimes;
+    writeTimes.Times.reserve(confNumberOfWrites);
+    benchmarkElement element;
+    for (size_t iteration = 0; iteration < confNumberOfWrites; ++iteration) {
+        std::fill(element.Data, element.Data + confElementSize, static_cast<double>(iteration));
+        const double start = TimeServer.GetRelativeTime();
+        buffer.Write(element);
+        writeTimes.Times.push_back(TimeServer.GetRelativeTime() - start);
+    }
+    reader.Stop = true;
+    thread.Wait();
+
+    std::cout << name << std::endl;
+    writeTimes.Print("write");
+    reader.Times.Print("read");
+}
+
+int main(void)
+{
+    TimeServer.SetTimeOrigin();
+    std::cout << std::fixed << std::setprecision(3)
+              << "Element of " << confElementSize << " doubles, "
+              << confNumberOfWrites << " writes" << std::endl;
+
+    mutexTripleBuffer withMutex;
+    benchmarkRun(withMutex, "mutex");
+
+    osaTripleBuffer<benchmarkElement> waitFree;
+    benchmarkRun(waitFree, "osaTripleBuffer");
+
+    return 0;
+}
@@ -0,0 +1,278 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Declaration of osaAtomic
+  \ingroup cisstOSAbstraction
+ */
+
+#ifndef _osaAtomic_h
+#define _osaAtomic_h
+
+#include <cisstCommon/cmnPortability.h>
+
+#include <cstddef>
+
+#if (CISST_OS == CISST_WINDOWS)
+#include <intrin.h>
+#endif
+
+/*! Size of a cache line in bytes.  Data written by different threads
+  should be at least this far apart to avoid false sharing. */
+const size_t OSA_CACHE_LINE_SIZE = 64;
+
+/*! Hint for the CPU that we are in a spin-wait loop.  On x86 this
+  emits a PAUSE instruction which reduces power and avoids memory
+  order violations when the loop exits. */
+inline void osaCPUPause(void)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    _mm_pause();
+#elif (defined(__i386__) || defined(__x86_64__))
+    __asm__ __volatile__("pause" ::: "memory");
+#elif (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+
+#ifndef DOXYGEN
+#if (CISST_OS == CISST_WINDOWS)
+// Visual Studio only provides 32 and 64 bits interlocked primitives,
+// dispatch based on the size of the element type.
+template <size_t _size> class osaAtomicInterlocked;
+
+template <>
+class osaAtomicInterlocked<4> {
+public:
+    typedef long value_type;
+    inline static value_type Exchange(volatile void * pointer, value_type value) {
+        return _InterlockedExchange(reinterpret_cast<volatile long *>(pointer), value);
+    }
+    inline static value_type CompareExchange(volatile void * pointer, value_type desired, value_type expected) {
+        return _InterlockedCompareExchange(reinterpret_cast<volatile long *>(pointer), desired, expected);
+    }
+    inline static value_type FetchAdd(volatile void * pointer, value_type value) {
+        return _InterlockedExchangeAdd(reinterpret_cast<volatile long *>(pointer), value);
+    }
+};
+
+template <>
+class osaAtomicInterlocked<8> {
+public:
+    typedef __int64 value_type;
+    inline static value_type Exchange(volatile void * pointer, value_type value) {
+        return _InterlockedExchange64(reinterpret_cast<volatile __int64 *>(pointer), value);
+    }
+    inline static value_type CompareExchange(volatile void * pointer, value_type desired, value_type expected) {
+        return _InterlockedCompareExchange64(reinterpret_cast<volatile __int64 *>(pointer), desired, expected);
+    }
+    inline static value_type FetchAdd(volatile void * pointer, value_type value) {
+        return _InterlockedExchangeAdd64(reinterpret_cast<volatile __int64 *>(pointer), value);
+    }
+};
+#endif
+#endif // DOXYGEN
+
+
+/*!
+  \brief Atomic integer or pointer
+
+  Minimal atomic type to implement lock-free data structures while
+  remaining compatible with C++98 compilers.  It relies on the GCC and
+  Clang <code>__atomic</code> builtins (or the older
+  <code>__sync</code> builtins) and on the interlocked intrinsics for
+  Visual Studio.  The element type must be an integer or a pointer of
+  4 or 8 bytes.
+
+  The memory ordering follows the C++11 memory model.  Load has
+  acquire semantic, Store has release semantic and all
+  read-modify-write operations (Exchange, CompareExchange, FetchAdd,
+  FetchSub) are sequentially consistent.  The LoadRelaxed and
+  StoreRelaxed methods should only be used for data owned by the
+  calling thread or when ordering is provided by another atomic.
+*/
+template <class _elementType>
+class osaAtomic
+{
+public:
+    typedef _elementType value_type;
+
+protected:
+    volatile value_type Value;
+
+private:
+    // non copyable
+    osaAtomic(const osaAtomic & CMN_UNUSED(other));
+    osaAtomic & operator = (const osaAtomic & CMN_UNUSED(other));
+
+public:
+    inline osaAtomic(void):
+        Value(value_type())
+    {}
+
+    inline explicit osaAtomic(const value_type value):
+        Value(value)
+    {}
+
+    /*! Load the value with acquire semantic, i.e. no read or write
+      after the load can be reordered before it. */
+    inline value_type Load(void) const {
+#if defined(__ATOMIC_ACQUIRE)
+        return __atomic_load_n(&Value, __ATOMIC_ACQUIRE);
+#elif (CISST_OS == CISST_WINDOWS)
+        const value_type result = Value;
+        _ReadWriteBarrier();
+        return result;
+#else
+        const value_type result = Value;
+        __sync_synchronize();
+        return result;
+#endif
+    }
+
+    /*! Load the value without ordering constraints. */
+    inline value_type LoadRelaxed(void) const {
+#if defined(__ATOMIC_RELAXED)
+        return __atomic_load_n(&Value, __ATOMIC_RELAXED);
+#else
+        return Value;
+#endif
+    }
+
+    /*! Store the value with release semantic, i.e. no read or write
+      before the store can be reordered after it. */
+    inline void Store(const value_type value) {
+#if defined(__ATOMIC_RELEASE)
+        __atomic_store_n(&Value, value, __ATOMIC_RELEASE);
+#elif (CISST_OS == CISST_WINDOWS)
+        _ReadWriteBarrier();
+        Value = value;
+#else
+        __sync_synchronize();
+        Value = value;
+#endif
+    }
+
+    /*! Store the value without ordering constraints. */
+    inline void StoreRelaxed(const value_type value) {
+#if defined(__ATOMIC_RELAXED)
+        __atomic_store_n(&Value, value, __ATOMIC_RELAXED);
+#else
+        Value = value;
+#endif
+    }
+
+    /*! Replace the value and return the previous one. */
+    inline value_type Exchange(const value_type value) {
+#if defined(__ATOMIC_SEQ_CST)
+        return __atomic_exchange_n(&Value, value, __ATOMIC_SEQ_CST);
+#elif (CISST_OS == CISST_WINDOWS)
+        typedef osaAtomicInterlocked<sizeof(value_type)> Interlocked;
+        return (value_type)(Interlocked::Exchange(&Value, (typename Interlocked::value_type)(value)));
+#else
+        value_type expected = Value;
+        while (!this->CompareExchange(expected, value)) {}
+        return expected;
+#endif
+    }
+
+    /*! Replace the value by desired if it is equal to expected.
+      Returns true on success.  On failure, expected is updated with
+      the current value. */
+    inline bool CompareExchange(value_type & expected, const value_type desired) {
+#if defined(__ATOMIC_SEQ_CST)
+        return __atomic_compare_exchange_n(&Value, &expected, desired, false,
+                                           __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif (CISST_OS == CISST_WINDOWS)
+        typedef osaAtomicInterlocked<sizeof(value_type)> Interlocked;
+        const value_type previous =
+            (value_type)(Interlocked::CompareExchange(&Value,
+                                                      (typename Interlocked::value_type)(desired),
+                                                      (typename Interlocked::value_type)(expected)));
+        if (previous == expected) {
+            return true;
+        }
+        expected = previous;
+        return false;
+#else
+        const value_type previous = __sync_val_compare_and_swap(&Value, expected, desired);
+        if (previous == expected) {
+            return true;
+        }
+        expected = previous;
+        return false;
+#endif
+    }
+
+    /*! Add to the value and return the previous value.  Only valid
+      for integer types. */
+    inline value_type FetchAdd(const value_type value) {
+#if defined(__ATOMIC_SEQ_CST)
+        return __atomic_fetch_add(&Value, value, __ATOMIC_SEQ_CST);
+#elif (CISST_OS == CISST_WINDOWS)
+        typedef osaAtomicInterlocked<sizeof(value_type)> Interlocked;
+        return (value_type)(Interlocked::FetchAdd(&Value, (typename Interlocked::value_type)(value)));
+#else
+        return __sync_fetch_and_add(&Value, value);
+#endif
+    }
+
+    /*! Subtract from the value and return the previous value.  Only
+      valid for integer types. */
+    inline value_type FetchSub(const value_type value) {
+        return this->FetchAdd(static_cast<value_type>(0) - value);
+    }
+
+    /*! Address of the value, e.g. to wait for a change using a
+      futex.  The value itself should only be accessed using the
+      methods above. */
+    inline volatile value_type * Pointer(void) {
+        return &Value;
+    }
+};
+
+
+/*! Full memory barrier (sequentially consistent fence). */
+inline void osaAtomicThreadFence(void)
+{
+#if defined(__ATOMIC_SEQ_CST)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#elif (CISST_OS == CISST_WINDOWS)
+    _mm_mfence();
+#else
+    __sync_synchronize();
+#endif
+}
+
+
+/*! Round up to the next power of two, returns 1 for 0. */
+inline size_t osaAtomicNextPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+
+#endif // _osaAtomic_h
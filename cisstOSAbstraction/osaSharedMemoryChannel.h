@@ -0,0 +1,167 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Declaration of osaSharedMemoryChannel
+  \ingroup cisstOSAbstraction
+*/
+
+#ifndef _osaSharedMemoryChannel_h
+#define _osaSharedMemoryChannel_h
+
+#include <cisstCommon/cmnGenericObject.h>
+#include <cisstCommon/cmnClassRegister.h>
+
+#include <string>
+
+// Always include last
+#include <cisstOSAbstraction/osaExport.h>
+
+/*!
+  \brief Message channel between processes on the same host
+
+  \ingroup cisstOSAbstraction
+
+  This class provides datagram-like messaging, similar to a UDP
+  osaSocket, using a POSIX shared memory segment.  One process creates
+  the channel (server) and up to a fixed number of processes connect
+  to it (clients):
+    \code
+    server.Create("/myChannel");
+    client.Connect("/myChannel");
+    client.Send(data, size);
+    server.Receive(buffer, sizeof(buffer), timeout);
+    server.Send(reply, replySize);  // to the last client received from
+    \endcode
+
+  Each client has a pair of lock-free ring buffers in the segment, one
+  per direction.  Messages are copied into the ring by the sender and
+  out of it by the receiver; there is no system call on the data path.
+  A sender reserves space with a compare and swap and then commits the
+  message, so a sending thread never waits for another one.
+  A receiver that finds the ring empty spins briefly and then sleeps
+  on a futex (Linux) until a sender wakes it up or the timeout
+  expires.  On other POSIX systems the receiver polls.
+
+  As for UDP sockets, the server's destination is updated to the
+  client of the last message received, see SetDestination and
+  GetDestination.  A client's slot is released when it closes the
+  channel or, if the client process died, when another client needs a
+  slot.  In the latter case, the new client can only send once the
+  server has dropped the messages of the dead one, i.e. after the
+  server's next Receive.
+
+  Several threads can send on the same channel, but only one thread
+  should receive at a time.
+
+  \note Not available on Windows, Create and Connect return false.
+*/
+class CISST_EXPORT osaSharedMemoryChannel: public cmnGenericObject
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+ public:
+    enum {DEFAULT_NUMBER_OF_CLIENTS = 4};
+    enum {DEFAULT_RING_SIZE = 1024 * 1024};
+
+ protected:
+    std::string Name;
+    void * Segment;
+    size_t SegmentSize;
+    bool Server;
+    unsigned int NumberOfClients;
+    unsigned int RingSize;
+    /*! Client slot used by this client, or client to send to (server). */
+    unsigned int Destination;
+    /*! First client checked by the next server Receive, for fairness. */
+    unsigned int NextClient;
+
+    /*! Map the segment, closes the file descriptor. */
+    bool Map(int fileDescriptor, size_t size);
+
+    /*! Copy a message into the ring, returns false if there is not
+      enough space or if the ring is being reset. */
+    bool Push(unsigned int client, bool toServer, const char * data, unsigned int size);
+
+    /*! Copy the next message out of the ring, returns -1 if the ring
+      is empty or if the next message is not committed yet.  The
+      message is dropped if buffer is 0. */
+    int Pop(unsigned int client, bool toServer, char * buffer, unsigned int maxlen);
+
+    /*! Try to get a message for this side of the channel, from any
+      client for the server. */
+    int TryReceive(char * buffer, unsigned int maxlen);
+
+ public:
+    osaSharedMemoryChannel(void);
+
+    /*! Closes the channel. */
+    ~osaSharedMemoryChannel();
+
+    /*! Create the shared memory segment, replacing any segment with
+      the same name.
+      \param name Name of the segment; a leading '/' is added if needed
+      \param numberOfClients Maximum number of clients connected at the same time
+      \param ringSize Size in bytes of each ring buffer, rounded up to a power of two
+      \return true if the segment was created */
+    bool Create(const std::string & name,
+                unsigned int numberOfClients = DEFAULT_NUMBER_OF_CLIENTS,
+                unsigned int ringSize = DEFAULT_RING_SIZE);
+
+    /*! Connect to a segment created by another process and claim a
+      client slot.
+      \return false if the segment doesn't exist or no slot is available */
+    bool Connect(const std::string & name);
+
+    /*! Release the client slot (client) or remove the segment (server). */
+    bool Close(void);
+
+    inline bool IsOpen(void) const {
+        return (Segment != 0);
+    }
+
+    inline bool IsServer(void) const {
+        return Server;
+    }
+
+    /*! Client to send to, only used by the server. */
+    void SetDestination(unsigned int client);
+
+    /*! Client of the last message received (server) or slot used by
+      this client. */
+    inline unsigned int GetDestination(void) const {
+        return Destination;
+    }
+
+    /*! Largest message that can be sent. */
+    unsigned int GetMaximumMessageSize(void) const;
+
+    /*! Send a message, waiting up to timeoutSec if the ring is full.
+      \return size sent or -1 on error */
+    int Send(const char * data, unsigned int size, double timeoutSec = 0.0);
+
+    /*! Receive a message, waiting up to timeoutSec for it.  If the
+      message is larger than maxlen, it is truncated.
+      \return size received, 0 on timeout or -1 on error */
+    int Receive(char * buffer, unsigned int maxlen, double timeoutSec = 0.0);
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(osaSharedMemoryChannel);
+
+#endif // _osaSharedMemoryChannel_h
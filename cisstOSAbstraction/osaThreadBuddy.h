@@ -67,6 +67,14 @@ class CISST_EXPORT osaThreadBuddy {
     /*! Thread period (if > 0) */
     double Period;
 
+    /*! Scheduling mode and counters, see SetAbsoluteDeadlines. */
+    //@{
+    bool AbsoluteDeadlines;
+    double SpinTime;
+    unsigned long NumberOfOverruns;
+    unsigned long NumberOfSkippedPeriods;
+    //@}
+
 public:
     /*! Constructor. Allocates internal data. */
     osaThreadBuddy();
@@ -100,6 +108,38 @@ public:
     /*! Suspend the execution of the real time thread for the
       remainder of the current period. */
     void WaitForRemainingPeriod(void);
+
+    /*! Use absolute deadlines in WaitForRemainingPeriod.  By default,
+      the remaining time is computed from the time the thread woke up
+      at the end of the previous period, so the scheduling latency
+      accumulates as drift.  With absolute deadlines, the deadline is
+      advanced by exactly one period each time and the thread sleeps
+      until the deadline (clock_nanosleep with CLOCK_MONOTONIC).  If
+      the deadline has already passed, the thread doesn't sleep and an
+      overrun is counted; whole periods missed are skipped to keep the
+      phase.  To reduce the wake up latency, the thread can wake up
+      spinTimeInSeconds before the deadline and busy wait for the
+      remaining time (e.g. 20 to 50 microseconds).
+
+      Only supported on Linux (without RTAI or Xenomai, which provide
+      their own periodic scheduling), returns false otherwise. */
+    bool SetAbsoluteDeadlines(bool absoluteDeadlines, double spinTimeInSeconds = 0.0);
+
+    /*! Return true if absolute deadlines are used. */
+    inline bool GetAbsoluteDeadlines(void) const {
+        return AbsoluteDeadlines;
+    }
+
+    /*! Number of times the end of the period was reached after the
+      deadline, since the thread buddy was created. */
+    inline unsigned long GetNumberOfOverruns(void) const {
+        return NumberOfOverruns;
+    }
+
+    /*! Number of whole periods skipped because of overruns. */
+    inline unsigned long GetNumberOfSkippedPeriods(void) const {
+        return NumberOfSkippedPeriods;
+    }
     
     /*! Make a thread hard real time. */
     void MakeHardRealTime(void);
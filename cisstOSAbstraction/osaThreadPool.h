@@ -0,0 +1,121 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+/*!
+  \file
+  \brief Declaration of osaThreadPool
+  \ingroup cisstOSAbstraction
+ */
+
+#ifndef _osaThreadPool_h
+#define _osaThreadPool_h
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+
+#include <vector>
+
+// Always include last
+#include <cisstOSAbstraction/osaExport.h>
+
+class osaThread;
+
+/*!
+  \brief Persistent pool of worker threads
+
+  The pool creates its threads once and runs batches of tasks with
+  Run.  The calling thread processes tasks as well, so a pool of N
+  threads creates N - 1 worker threads.  Tasks are handed out one
+  index at a time, in increasing order, to the first thread
+  available.
+
+  Run can be called from any thread.  If the pool is already running
+  tasks, e.g. when Run is called from a task or from two threads at
+  the same time, the new tasks are run in the calling thread.
+
+  The static method Execute has the signature expected by
+  vctParallel, so a pool can be used as executor for the parallel
+  cisstVector engines:
+  \code
+  osaThreadPool pool;
+  vctParallel parallel(pool);
+  \endcode
+
+  Tasks must not throw exceptions.
+*/
+class CISST_EXPORT osaThreadPool
+{
+public:
+    /*! Type of a task, called once per task index with the task
+      data given to Run. */
+    typedef void (*TaskFunctionType)(void * taskData, size_t taskIndex);
+
+    /*! Constructor, creates numberOfThreads - 1 worker threads.  Use 0
+      to use as many threads as processors (see osaCPUGetCount). */
+    osaThreadPool(size_t numberOfThreads = 0);
+
+    /*! Destructor, stops and waits for all the worker threads. */
+    ~osaThreadPool();
+
+    /*! Number of threads running tasks, including the calling
+      thread. */
+    inline size_t NumberOfThreads(void) const {
+        return Workers.size() + 1;
+    }
+
+    /*! Call task(taskData, index) for all indices from 0 to
+      numberOfTasks - 1 and return once all the tasks are completed. */
+    void Run(TaskFunctionType task, void * taskData, size_t numberOfTasks);
+
+    /*! Same as Run, for a pool given as void pointer.  This is the
+      executor function used by vctParallel. */
+    static void Execute(void * pool, TaskFunctionType task, void * taskData, size_t numberOfTasks);
+
+protected:
+    /*! Main loop of the worker threads. */
+    void * WorkerLoop(size_t workerIndex);
+
+    /*! Run tasks until all the tasks of the current batch have been
+      handed out. */
+    void RunTasks(void);
+
+    std::vector<osaThread *> Workers;
+
+    /*! Current batch */
+    TaskFunctionType Task;
+    void * TaskData;
+    size_t NumberOfTasks;
+    osaAtomic<size_t> NextTask;
+
+    /*! Number of workers still running tasks of the current batch,
+      the last one raises Done. */
+    osaAtomic<size_t> RunningWorkers;
+    osaThreadSignal Done;
+
+    osaAtomic<int> Busy;
+    osaAtomic<int> Stopping;
+
+private:
+    // non copyable
+    osaThreadPool(const osaThreadPool & CMN_UNUSED(other));
+    osaThreadPool & operator = (const osaThreadPool & CMN_UNUSED(other));
+};
+
+#endif // _osaThreadPool_h
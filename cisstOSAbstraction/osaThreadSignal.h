@@ -49,6 +49,14 @@ public:
 
     static void SetWaitCallbacks(const osaThreadId &threadId, void (*pre)(void), void (*post)(void));
 
+    /*! On Linux, Wait spins for a short time before putting the thread
+      to sleep on a futex, which avoids the system calls when the signal
+      is raised soon after.  The number of iterations adapts to the
+      recent waits, up to maximumSpinCount.  Use 0 to disable spinning,
+      which is the default on single processor systems.  Ignored on
+      other operating systems. */
+    void SetMaximumSpinCount(unsigned int maximumSpinCount);
+
     /*! Print to stream */
     void ToStream(std::ostream & outputStream) const;
 
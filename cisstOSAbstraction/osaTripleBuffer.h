@@ -19,15 +19,20 @@ http://www.cisst.org/cisst/license.txt.
 
 */
 
+#ifndef _osaTripleBuffer_h
+#define _osaTripleBuffer_h
+
 #include <cisstConfig.h> // to define CISST_OS and CISST_COMPILER
 
 #include <cisstCommon/cmnAssert.h>
-#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+
+#include <new>
+#include <iostream>
 
-/*!  Triple buffer to implement a thread safe, lock free, single
-  reader single writer container.  This relies on a LIFO circular
-  buffer with only three slots, one to read the latest value and two
-  to write (assuming the reading thread can be slow to read).
+/*!  Triple buffer to implement a thread safe, wait free, single
+  reader single writer container.  The reader always gets the latest
+  value written, without ever waiting for the writer and vice versa.
 
   This class assumes read and write operations are performed in two
   different threads.  The reader must trigger the following calls to
@@ -38,12 +43,19 @@ http://www.cisst.org/cisst/license.txt.
 
   The triple buffer can be constructed using three existing pointers
   on valid memory slots or allocate the memory itself (see
-  constructors).
-
-  The implementation relies on a mutex (using osaMutex) to make sure
-  the BeginRead, EndRead, BeginWrite and EndWrite methods are thread
-  safe.  The mutex is used for very brief
-  operations so there shouldn't be any long wait times.
+  constructors).  When the buffer allocates the memory, each element
+  starts on its own cache line so that the reader and writer don't
+  share cache lines while working on different slots.
+
+  The implementation relies on a single atomic word that holds the
+  index of the slot between the writer and the reader, along with a
+  "fresh" bit set when this slot contains a value not read yet.  The
+  writer and the reader each own one of the two other slots.  EndWrite
+  publishes the write slot by exchanging it with the middle one, and
+  BeginRead, if a fresh value is available, exchanges the read slot
+  with the middle one.  Both are a single atomic exchange, there is no
+  lock and no loop, so a preempted reader can't block a real time
+  writer.
  */
 template <class _elementType>
 class osaTripleBuffer
@@ -59,32 +71,37 @@ class osaTripleBuffer
     typedef value_type & reference;
     typedef const value_type & const_reference;
 
+    // bits of the middle slot word
+    enum {INDEX_MASK = 3, FRESH = 4};
+
     // did the buffer allocate memory or used existing pointers
     bool OwnMemory;
-    pointer Memory;
-
-    // circular buffer node
-    class Node {
-    public:
-        Node(const pointer data):
-            Pointer(data) {}
-        pointer Pointer;
-        Node * Next;
-    };
-
-    typedef Node * NodePointer;
-
-    // last write node (behaves like a head in our lifo circular buffer
-    volatile NodePointer LastWriteNode;
-    volatile NodePointer WriteNode;
-    volatile NodePointer ReadNode;
-
-    // bool for debug
-    bool LastCompare;
-
-    // to make sure the ReadNode is thread safe
-    osaMutex Mutex;
-
+    char * Memory;
+    pointer Slots[3];
+    char PaddingSlots[OSA_CACHE_LINE_SIZE];
+
+    // shared, index of the middle slot and fresh bit
+    osaAtomic<unsigned int> Middle;
+    char PaddingMiddle[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>)];
+
+    // writer's cache line
+    unsigned int WriteIndex;
+    char PaddingWrite[OSA_CACHE_LINE_SIZE - sizeof(unsigned int)];
+
+    // reader's cache line
+    unsigned int ReadIndex;
+    char PaddingRead[OSA_CACHE_LINE_SIZE - sizeof(unsigned int)];
+
+    // allocate memory for 3 elements, each aligned on a cache line
+    inline pointer * Allocate(void) {
+        const size_t stride = ((sizeof(value_type) + OSA_CACHE_LINE_SIZE - 1) / OSA_CACHE_LINE_SIZE) * OSA_CACHE_LINE_SIZE;
+        this->Memory = new char[3 * stride + OSA_CACHE_LINE_SIZE];
+        char * aligned = this->Memory + (OSA_CACHE_LINE_SIZE - reinterpret_cast<size_t>(this->Memory) % OSA_CACHE_LINE_SIZE) % OSA_CACHE_LINE_SIZE;
+        for (size_t index = 0; index < 3; ++index) {
+            this->Slots[index] = reinterpret_cast<pointer>(aligned + index * stride);
+        }
+        return this->Slots;
+    }
 
 public:
     /*! Constructor that allocates memory for the triple buffer using
@@ -92,22 +109,22 @@ public:
     inline osaTripleBuffer(void):
         OwnMemory(true)
     {
-        this->Memory = new value_type[3];
-        SetupNodes(this->Memory,
-                   this->Memory + 1,
-                   this->Memory + 2);
+        pointer * slots = Allocate();
+        SetupNodes(new(slots[0]) value_type,
+                   new(slots[1]) value_type,
+                   new(slots[2]) value_type);
     }
 
     /*! Constructor that allocates memory for the triple buffer using
       the copy constructor for each element.  User has to provide an
       value which will be used to initialize the buffer elements. */
     inline osaTripleBuffer(const_reference initialValue):
-        OwnMemory(true),
-        Memory(0)
+        OwnMemory(true)
     {
-        SetupNodes(new value_type(initialValue),
-                   new value_type(initialValue),
-                   new value_type(initialValue));
+        pointer * slots = Allocate();
+        SetupNodes(new(slots[0]) value_type(initialValue),
+                   new(slots[1]) value_type(initialValue),
+                   new(slots[2]) value_type(initialValue));
     }
 
     /*! Constructor that doesn't allocate any memory, user has to
@@ -121,45 +138,38 @@ public:
         SetupNodes(pointer1, pointer2, pointer3);
     }
 
-    /*! Internal method to setup all nodes of the circular buffer.  It
-      requires 3 valid pointers. */
+    /*! Internal method to setup the slots.  It requires 3 valid
+      pointers.  The reader starts with the first slot, the writer
+      with the second one. */
     inline void SetupNodes(pointer pointer1, pointer pointer2, pointer pointer3) {
         CMN_ASSERT(pointer1);
         CMN_ASSERT(pointer2);
         CMN_ASSERT(pointer3);
-        this->ReadNode = 0;
-        this->WriteNode = 0;
-        this->LastWriteNode = new Node(pointer1);
-        this->LastWriteNode->Next = new Node(pointer2);
-        this->LastWriteNode->Next->Next = new Node(pointer3);
-        this->LastWriteNode->Next->Next->Next = this->LastWriteNode;
+        this->Slots[0] = pointer1;
+        this->Slots[1] = pointer2;
+        this->Slots[2] = pointer3;
+        this->ReadIndex = 0;
+        this->WriteIndex = 1;
+        this->Middle.Store(2);
     }
 
-    /*! Destructor.  If the memory is owned, it will delete the 3
-      objects allocated.  All nodes get deleted. */
+    /*! Destructor.  If the memory is owned, it will destroy the 3
+      objects allocated. */
     inline ~osaTripleBuffer() {
         // free memory if we own it
         if (this->OwnMemory) {
-            // can be an array or three different pointers
-            if (this->Memory) {
-                delete[] this->Memory;
-            } else {
-                delete this->LastWriteNode->Next->Next->Pointer;
-                delete this->LastWriteNode->Next->Pointer;
-                delete this->LastWriteNode->Pointer;
+            for (size_t index = 0; index < 3; ++index) {
+                this->Slots[index]->~value_type();
             }
+            delete[] this->Memory;
         }
-        // free nodes
-        delete this->LastWriteNode->Next->Next;
-        delete this->LastWriteNode->Next;
-        delete this->LastWriteNode;
     }
 
     /*! Calls BeginRead, assign the last written value using the
       operator = and then calls EndRead. */
     inline void Read(reference placeHolder) {
         this->BeginRead();
-        placeHolder = *(ReadNode->Pointer);
+        placeHolder = *(this->GetReadPointer());
         this->EndRead();
     }
 
@@ -167,69 +177,64 @@ public:
       location using the operator = and then calls EndWrite. */
     inline void Write(const_reference newValue) {
         this->BeginWrite();
-        *(WriteNode->Pointer) = newValue;
+        *(this->GetWritePointer()) = newValue;
         this->EndWrite();
     }
 
     /*! Function to access the memory to read safely.  This method
       call must be preceeded by a call to BeginRead and followed by
       a call to EndRead.  All three calls must be performed in the
-      same thread space. */ 
+      same thread space. */
     inline const_pointer GetReadPointer(void) const {
-        return this->ReadNode->Pointer;
+        return this->Slots[this->ReadIndex];
     }
 
     /*! Function to access the memory to write safely.  This method
       call must be preceeded by a call to BeginWrite and followed by
       a call to EndWrite.  All three calls must be performed in the
-      same thread space. */ 
+      same thread space. */
     inline pointer GetWritePointer(void) const {
-        return this->WriteNode->Pointer;
+        return this->Slots[this->WriteIndex];
     }
 
-    /*! Method used to find and lock the read node in the triple
-      buffer.  To access the actual memory, use GetReadPointer. */
+    /*! Method used to get the latest value written.  If a value was
+      written since the last read, the read slot is exchanged with the
+      middle slot.  Otherwise the read slot already contains the latest
+      value.  To access the actual memory, use GetReadPointer. */
     inline void BeginRead(void) {
-        Mutex.Lock(); {
-            this->ReadNode = this->LastWriteNode;
-        } Mutex.Unlock();
+        if (this->Middle.LoadRelaxed() & FRESH) {
+            this->ReadIndex = this->Middle.Exchange(this->ReadIndex) & INDEX_MASK;
+        }
     }
 
-    /*! Method to unlock the read node. */
+    /*! Method to release the read slot.  The slot is owned by the
+      reader until the next BeginRead so there is nothing to do. */
     inline void EndRead(void) {
-        Mutex.Lock(); {
-            this->ReadNode = 0;
-        } Mutex.Unlock();
     }
 
-
-    /*! Method used to find and lock the write node in the triple
-      buffer.  To access the actual memory, use GetReadPointer. */
+    /*! Method used to get the write slot.  The slot is owned by the
+      writer so there is nothing to do.  To access the actual memory,
+      use GetWritePointer. */
     inline void BeginWrite(void) {
-        this->WriteNode = this->LastWriteNode->Next;
-        Mutex.Lock(); {
-            LastCompare = (this->WriteNode == this->ReadNode);
-            if (LastCompare) {
-                this->WriteNode = this->WriteNode->Next;
-            }
-        } Mutex.Unlock();
     }
 
-
-    /*! Method to unlock the write node. */
+    /*! Method to publish the write slot.  The write slot becomes the
+      middle slot, marked as fresh, and the writer gets the previous
+      middle slot. */
     inline void EndWrite(void) {
-        this->LastWriteNode = this->WriteNode;
+        this->WriteIndex = this->Middle.Exchange(this->WriteIndex | FRESH) & INDEX_MASK;
     }
 
-
     /*! Method to display current state of triple buffer */
     void ToStream(std::ostream & outputStream) const {
-        outputStream << "Node addresses from LastWriteNode: "
-                     << this->LastWriteNode << "[" << this->LastWriteNode->Pointer << "] "
-                     << this->LastWriteNode->Next << "[" << this->LastWriteNode->Next->Pointer << "] "
-                     << this->LastWriteNode->Next->Next << "[" << this->LastWriteNode->Next->Next->Pointer << "]" << std::endl
-                     << "LastCompare of read/write: " << ((this->LastCompare) ? "equal" : "different") << std::endl
-                     << "ReadNode address: " << this->ReadNode << std::endl
-                     << "WriteNode address: " << this->WriteNode << std::endl;
+        const unsigned int middle = this->Middle.Load();
+        outputStream << "Slot addresses: "
+                     << this->Slots[0] << " " << this->Slots[1] << " " << this->Slots[2] << std::endl
+                     << "Read slot: " << this->ReadIndex
+                     << ", write slot: " << this->WriteIndex
+                     << ", middle slot: " << (middle & INDEX_MASK)
+                     << ((middle & FRESH) ? " (fresh)" : " (already read)") << std::endl;
     }
 };
+
+#endif // _osaTripleBuffer_h
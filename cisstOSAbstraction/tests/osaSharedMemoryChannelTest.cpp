@@ -0,0 +1,318 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <string.h>
+#include <vector>
+
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSharedMemoryChannel.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
+
+#include "osaSharedMemoryChannelTest.h"
+
+#if (CISST_OS != CISST_WINDOWS)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if (CISST_OS != CISST_WINDOWS)
+
+void osaSharedMemoryChannelTest::TestRoundTrip(void)
+{
+    osaSharedMemoryChannel server, client;
+    char buffer[512];
+    int bytes;
+
+    CPPUNIT_ASSERT(!client.Connect("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT(server.Create("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT(server.IsServer());
+    CPPUNIT_ASSERT(client.Connect("/osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT(!client.IsServer());
+
+    // nothing to receive
+    bytes = server.Receive(buffer, sizeof(buffer));
+    CPPUNIT_ASSERT_EQUAL(0, bytes);
+    const double startTime = osaGetTime();
+    bytes = client.Receive(buffer, sizeof(buffer), 20.0 * cmn_ms);
+    CPPUNIT_ASSERT_EQUAL(0, bytes);
+    CPPUNIT_ASSERT(osaGetTime() - startTime >= 15.0 * cmn_ms);
+
+    bytes = client.Send("testing", 8);
+    CPPUNIT_ASSERT_EQUAL(8, bytes);
+    bytes = server.Receive(buffer, sizeof(buffer), 1.0);
+    CPPUNIT_ASSERT_EQUAL(8, bytes);
+    CPPUNIT_ASSERT(strcmp("testing", buffer) == 0);
+    CPPUNIT_ASSERT_EQUAL(client.GetDestination(), server.GetDestination());
+
+    bytes = server.Send("reply", 6);
+    CPPUNIT_ASSERT_EQUAL(6, bytes);
+    bytes = client.Receive(buffer, sizeof(buffer), 1.0);
+    CPPUNIT_ASSERT_EQUAL(6, bytes);
+    CPPUNIT_ASSERT(strcmp("reply", buffer) == 0);
+
+    // truncated message
+    bytes = client.Send("testing", 8);
+    bytes = server.Receive(buffer, 4);
+    CPPUNIT_ASSERT_EQUAL(4, bytes);
+    CPPUNIT_ASSERT(strncmp("test", buffer, 4) == 0);
+
+    // too large
+    std::vector<char> large(client.GetMaximumMessageSize() + 1);
+    bytes = client.Send(&(large[0]), static_cast<unsigned int>(large.size()));
+    CPPUNIT_ASSERT_EQUAL(-1, bytes);
+
+    CPPUNIT_ASSERT(client.Close());
+    CPPUNIT_ASSERT(server.Close());
+    CPPUNIT_ASSERT(!client.IsOpen());
+    CPPUNIT_ASSERT(!client.Connect("osaSharedMemoryChannelTest"));
+}
+
+
+void osaSharedMemoryChannelTest::TestWrapAround(void)
+{
+    osaSharedMemoryChannel server, client;
+    CPPUNIT_ASSERT(server.Create("osaSharedMemoryChannelTest", 1, 4096));
+    CPPUNIT_ASSERT(client.Connect("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT_EQUAL(2048u - 8u, client.GetMaximumMessageSize());
+
+    std::vector<char> message(client.GetMaximumMessageSize());
+    std::vector<char> buffer(client.GetMaximumMessageSize());
+    unsigned int size, index, count;
+    int bytes;
+    for (count = 0; count < 200; count++) {
+        size = (count * 97) % client.GetMaximumMessageSize() + 1;
+        for (index = 0; index < size; index++) {
+            message[index] = static_cast<char>(count + index);
+        }
+        bytes = client.Send(&(message[0]), size);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(size), bytes);
+        bytes = server.Receive(&(buffer[0]), static_cast<unsigned int>(buffer.size()));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(size), bytes);
+        CPPUNIT_ASSERT(memcmp(&(message[0]), &(buffer[0]), size) == 0);
+    }
+
+    // fill the ring, sender gives up once timeout expires
+    count = 0;
+    while (client.Send(&(message[0]), 1000) > 0) {
+        count++;
+    }
+    CPPUNIT_ASSERT(count >= 3);
+    CPPUNIT_ASSERT(count <= 4);
+    for (index = 0; index < count; index++) {
+        bytes = server.Receive(&(buffer[0]), static_cast<unsigned int>(buffer.size()));
+        CPPUNIT_ASSERT_EQUAL(1000, bytes);
+    }
+    CPPUNIT_ASSERT_EQUAL(0, server.Receive(&(buffer[0]), static_cast<unsigned int>(buffer.size())));
+}
+
+
+void osaSharedMemoryChannelTest::TestClientSlots(void)
+{
+    osaSharedMemoryChannel server, client1, client2, client3;
+    char buffer[16];
+    CPPUNIT_ASSERT(server.Create("osaSharedMemoryChannelTest", 2, 4096));
+    CPPUNIT_ASSERT(client1.Connect("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT(client2.Connect("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT(client1.GetDestination() != client2.GetDestination());
+    // no more slots, the process owning the others is alive
+    CPPUNIT_ASSERT(!client3.Connect("osaSharedMemoryChannelTest"));
+
+    // server replies to the client it received from
+    client2.Send("2", 2);
+    client1.Send("1", 2);
+    CPPUNIT_ASSERT_EQUAL(2, server.Receive(buffer, sizeof(buffer)));
+    server.Send(buffer, 2);
+    CPPUNIT_ASSERT_EQUAL(2, server.Receive(buffer, sizeof(buffer)));
+    server.Send(buffer, 2);
+    CPPUNIT_ASSERT_EQUAL(2, client1.Receive(buffer, sizeof(buffer)));
+    CPPUNIT_ASSERT(strcmp("1", buffer) == 0);
+    CPPUNIT_ASSERT_EQUAL(2, client2.Receive(buffer, sizeof(buffer)));
+    CPPUNIT_ASSERT(strcmp("2", buffer) == 0);
+
+    // messages to a client that left are dropped
+    const unsigned int slot = client1.GetDestination();
+    client1.Close();
+    server.SetDestination(slot);
+    CPPUNIT_ASSERT_EQUAL(-1, server.Send("lost", 5));
+    CPPUNIT_ASSERT(client3.Connect("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT_EQUAL(slot, client3.GetDestination());
+    CPPUNIT_ASSERT_EQUAL(0, client3.Receive(buffer, sizeof(buffer)));
+}
+
+
+static void * osaSharedMemoryChannelTestSend(osaSharedMemoryChannel * channel)
+{
+    osaSleep(20.0 * cmn_ms);
+    channel->Send("wake up", 8);
+    return 0;
+}
+
+
+void osaSharedMemoryChannelTest::TestWakeUp(void)
+{
+    osaSharedMemoryChannel server, client;
+    char buffer[16];
+    CPPUNIT_ASSERT(server.Create("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT(client.Connect("osaSharedMemoryChannelTest"));
+
+    for (unsigned int count = 0; count < 10; count++) {
+        osaThread thread;
+        thread.Create(osaSharedMemoryChannelTestSend, &client);
+        const double startTime = osaGetTime();
+        const int bytes = server.Receive(buffer, sizeof(buffer), 5.0);
+        const double elapsed = osaGetTime() - startTime;
+        thread.Wait();
+        CPPUNIT_ASSERT_EQUAL(8, bytes);
+        CPPUNIT_ASSERT(strcmp("wake up", buffer) == 0);
+        CPPUNIT_ASSERT(elapsed < 1.0);
+    }
+}
+
+
+namespace {
+    const unsigned int ConcurrentSenders = 4;
+    const unsigned int ConcurrentMessages = 2000;
+
+    struct osaSharedMemoryChannelTestSender {
+        osaSharedMemoryChannel * Channel;
+        unsigned int Sender;
+        unsigned int Errors;
+    };
+}
+
+
+static void * osaSharedMemoryChannelTestSendMany(osaSharedMemoryChannelTestSender * sender)
+{
+    // sender, index and a size depending on both
+    unsigned int message[64];
+    for (unsigned int index = 0; index < ConcurrentMessages; index++) {
+        const unsigned int size = 2 + (sender->Sender + index) % 62;
+        message[0] = sender->Sender;
+        message[1] = index;
+        for (unsigned int word = 2; word < size; word++) {
+            message[word] = sender->Sender * index + word;
+        }
+        const unsigned int bytes = size * sizeof(unsigned int);
+        if (sender->Channel->Send(reinterpret_cast<char *>(message), bytes, 5.0) != static_cast<int>(bytes)) {
+            sender->Errors++;
+        }
+    }
+    return 0;
+}
+
+
+void osaSharedMemoryChannelTest::TestConcurrentSenders(void)
+{
+    osaSharedMemoryChannel server, client;
+    CPPUNIT_ASSERT(server.Create("osaSharedMemoryChannelTest", 1, 4096));
+    CPPUNIT_ASSERT(client.Connect("osaSharedMemoryChannelTest"));
+
+    osaSharedMemoryChannelTestSender senders[ConcurrentSenders];
+    osaThread threads[ConcurrentSenders];
+    unsigned int sender;
+    for (sender = 0; sender < ConcurrentSenders; sender++) {
+        senders[sender].Channel = &client;
+        senders[sender].Sender = sender;
+        senders[sender].Errors = 0;
+        threads[sender].Create(osaSharedMemoryChannelTestSendMany, &(senders[sender]));
+    }
+
+    // messages of each sender are received once, in order and intact
+    std::vector<unsigned int> next(ConcurrentSenders, 0);
+    unsigned int message[64];
+    unsigned int received = 0, errors = 0;
+    int bytes;
+    while (received < ConcurrentSenders * ConcurrentMessages) {
+        bytes = server.Receive(reinterpret_cast<char *>(message), sizeof(message), 5.0);
+        if (bytes <= 0) {
+            break;
+        }
+        received++;
+        const unsigned int size = bytes / sizeof(unsigned int);
+        sender = message[0];
+        if ((sender >= ConcurrentSenders) || (message[1] != next[sender])
+            || (size != 2 + (sender + message[1]) % 62)) {
+            errors++;
+            continue;
+        }
+        for (unsigned int word = 2; word < size; word++) {
+            if (message[word] != sender * message[1] + word) {
+                errors++;
+            }
+        }
+        next[sender]++;
+    }
+    for (sender = 0; sender < ConcurrentSenders; sender++) {
+        threads[sender].Wait();
+        CPPUNIT_ASSERT_EQUAL(0u, senders[sender].Errors);
+        CPPUNIT_ASSERT_EQUAL(ConcurrentMessages, next[sender]);
+    }
+    CPPUNIT_ASSERT_EQUAL(0u, errors);
+    CPPUNIT_ASSERT_EQUAL(ConcurrentSenders * ConcurrentMessages, received);
+    CPPUNIT_ASSERT_EQUAL(0, server.Receive(reinterpret_cast<char *>(message), sizeof(message)));
+}
+
+
+void osaSharedMemoryChannelTest::TestDeadClient(void)
+{
+    osaSharedMemoryChannel server, client;
+    char buffer[16];
+    CPPUNIT_ASSERT(server.Create("osaSharedMemoryChannelTest", 1, 4096));
+
+    // a client process sends a message and dies without closing the channel
+    const pid_t child = fork();
+    CPPUNIT_ASSERT(child >= 0);
+    if (child == 0) {
+        osaSharedMemoryChannel dead;
+        if (dead.Connect("osaSharedMemoryChannelTest")) {
+            dead.Send("dead", 5);
+        }
+        _exit(0);
+    }
+    int status;
+    CPPUNIT_ASSERT_EQUAL(child, waitpid(child, &status, 0));
+
+    // the new client waits for the server to drop the messages of the dead one
+    CPPUNIT_ASSERT(client.Connect("osaSharedMemoryChannelTest"));
+    CPPUNIT_ASSERT_EQUAL(-1, client.Send("alive", 6));
+    CPPUNIT_ASSERT_EQUAL(0, server.Receive(buffer, sizeof(buffer), 0.1));
+    CPPUNIT_ASSERT_EQUAL(6, client.Send("alive", 6));
+    CPPUNIT_ASSERT_EQUAL(6, server.Receive(buffer, sizeof(buffer), 1.0));
+    CPPUNIT_ASSERT(strcmp("alive", buffer) == 0);
+    CPPUNIT_ASSERT_EQUAL(0, server.Receive(buffer, sizeof(buffer)));
+}
+
+#else
+
+void osaSharedMemoryChannelTest::TestRoundTrip(void)
+{
+    osaSharedMemoryChannel server;
+    CPPUNIT_ASSERT(!server.Create("osaSharedMemoryChannelTest"));
+}
+
+void osaSharedMemoryChannelTest::TestWrapAround(void) {}
+void osaSharedMemoryChannelTest::TestClientSlots(void) {}
+void osaSharedMemoryChannelTest::TestWakeUp(void) {}
+void osaSharedMemoryChannelTest::TestConcurrentSenders(void) {}
+void osaSharedMemoryChannelTest::TestDeadClient(void) {}
+
+#endif
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(osaSharedMemoryChannelTest);
@@ -0,0 +1,61 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _osaSharedMemoryChannelTest_h
+#define _osaSharedMemoryChannelTest_h
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class osaSharedMemoryChannelTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(osaSharedMemoryChannelTest);
+    {
+        CPPUNIT_TEST(TestRoundTrip);
+        CPPUNIT_TEST(TestWrapAround);
+        CPPUNIT_TEST(TestClientSlots);
+        CPPUNIT_TEST(TestWakeUp);
+        CPPUNIT_TEST(TestConcurrentSenders);
+        CPPUNIT_TEST(TestDeadClient);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {}
+    void tearDown(void) {}
+
+    /*! Test messages in both directions and receive timeout */
+    void TestRoundTrip(void);
+
+    /*! Test many messages of varying size going around the ring */
+    void TestWrapAround(void);
+
+    /*! Test client slot allocation and server destination */
+    void TestClientSlots(void);
+
+    /*! Test a receiver blocked while another thread sends */
+    void TestWakeUp(void);
+
+    /*! Test several threads sending on a small ring at the same time */
+    void TestConcurrentSenders(void);
+
+    /*! Test a client taking over the slot of a process that died */
+    void TestDeadClient(void);
+};
+
+#endif // _osaSharedMemoryChannelTest_h
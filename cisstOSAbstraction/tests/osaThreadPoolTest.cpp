@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaThreadPool.h>
+
+#include "osaThreadPoolTest.h"
+
+#include <vector>
+
+const size_t MaximumNumberOfTasks = 100;
+
+struct osaThreadPoolTestCounters {
+    osaAtomic<size_t> Counters[MaximumNumberOfTasks];
+    osaThreadPool * Pool;
+};
+
+void osaThreadPoolTestIncrement(void * data, size_t taskIndex)
+{
+    osaThreadPoolTestCounters * counters = static_cast<osaThreadPoolTestCounters *>(data);
+    counters->Counters[taskIndex].FetchAdd(1);
+}
+
+void osaThreadPoolTestNested(void * data, size_t taskIndex)
+{
+    osaThreadPoolTestCounters * counters = static_cast<osaThreadPoolTestCounters *>(data);
+    counters->Counters[taskIndex].FetchAdd(1);
+    // each task runs a batch incrementing all the counters
+    counters->Pool->Run(osaThreadPoolTestIncrement, data, MaximumNumberOfTasks);
+}
+
+
+void osaThreadPoolTest::TestAllTasksRunOnce(void)
+{
+    const size_t numberOfIterations = 200;
+    for (size_t numberOfThreads = 1; numberOfThreads <= 5; ++numberOfThreads) {
+        osaThreadPool pool(numberOfThreads);
+        CPPUNIT_ASSERT_EQUAL(numberOfThreads, pool.NumberOfThreads());
+        for (size_t numberOfTasks = 0; numberOfTasks <= 10; ++numberOfTasks) {
+            osaThreadPoolTestCounters counters;
+            for (size_t iteration = 0; iteration < numberOfIterations; ++iteration) {
+                pool.Run(osaThreadPoolTestIncrement, &counters, numberOfTasks);
+            }
+            for (size_t index = 0; index < MaximumNumberOfTasks; ++index) {
+                CPPUNIT_ASSERT_EQUAL((index < numberOfTasks) ? numberOfIterations : 0,
+                                     counters.Counters[index].Load());
+            }
+        }
+    }
+}
+
+
+void osaThreadPoolTest::TestNestedRun(void)
+{
+    osaThreadPool pool(4);
+    osaThreadPoolTestCounters counters;
+    counters.Pool = &pool;
+    const size_t numberOfTasks = 10;
+    pool.Run(osaThreadPoolTestNested, &counters, numberOfTasks);
+    for (size_t index = 0; index < MaximumNumberOfTasks; ++index) {
+        CPPUNIT_ASSERT_EQUAL(numberOfTasks + ((index < numberOfTasks) ? 1 : 0),
+                             counters.Counters[index].Load());
+    }
+}
+
+
+void osaThreadPoolTest::TestExecute(void)
+{
+    osaThreadPool pool(3);
+    void (*executor)(void *, osaThreadPool::TaskFunctionType, void *, size_t) = osaThreadPool::Execute;
+    osaThreadPoolTestCounters counters;
+    executor(&pool, osaThreadPoolTestIncrement, &counters, MaximumNumberOfTasks);
+    for (size_t index = 0; index < MaximumNumberOfTasks; ++index) {
+        CPPUNIT_ASSERT_EQUAL(size_t(1), counters.Counters[index].Load());
+    }
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(osaThreadPoolTest);
@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _osaThreadPoolTest_h
+#define _osaThreadPoolTest_h
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class osaThreadPoolTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(osaThreadPoolTest);
+    {
+        CPPUNIT_TEST(TestAllTasksRunOnce);
+        CPPUNIT_TEST(TestNestedRun);
+        CPPUNIT_TEST(TestExecute);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    /*! Test that each task of many batches is run exactly once, for
+      different numbers of threads and tasks */
+    void TestAllTasksRunOnce(void);
+
+    /*! Test that a task can use the pool it is running on, the nested
+      tasks are run by the calling thread */
+    void TestNestedRun(void);
+
+    /*! Test the executor function used by vctParallel */
+    void TestExecute(void);
+};
+
+#endif // _osaThreadPoolTest_h
@@ -126,4 +126,81 @@ void osaThreadSignalTest::TestWaitBlocks(void) {
 }
 
 
+
+void osaThreadSignalTest::TestWaitTimeout(void) {
+    osaThreadSignal threadSignal;
+    osaStopwatch timer;
+
+    // raised before waiting, wait returns right away
+    threadSignal.Raise();
+    threadSignal.Raise();
+    timer.Reset();
+    timer.Start();
+    CPPUNIT_ASSERT(threadSignal.Wait(1.0));
+    timer.Stop();
+    CPPUNIT_ASSERT(timer.GetElapsedTime() < 0.5);
+
+    // raise is not counted, next wait times out
+    const double timeout = 50.0 * cmn_ms;
+    timer.Reset();
+    timer.Start();
+    CPPUNIT_ASSERT(!threadSignal.Wait(timeout));
+    timer.Stop();
+    CPPUNIT_ASSERT(timer.GetElapsedTime() > 0.8 * timeout);
+    CPPUNIT_ASSERT(timer.GetElapsedTime() < 10.0 * timeout);
+}
+
+
+class ThreadSignalPingPongArguments {
+public:
+    osaThreadSignal * Ping;
+    osaThreadSignal * Pong;
+    unsigned int NumberOfIterations;
+    unsigned int NumberOfTimeouts;
+};
+
+class ThreadSignalPingPongHolder {
+public:
+    void * Method(ThreadSignalPingPongArguments * argument) {
+        for (unsigned int index = 0; index < argument->NumberOfIterations; index++) {
+            if (!argument->Ping->Wait(1.0)) {
+                argument->NumberOfTimeouts++;
+            }
+            argument->Pong->Raise();
+        }
+        return 0;
+    }
+};
+
+
+void osaThreadSignalTest::TestPingPong(void) {
+    for (unsigned int spin = 0; spin < 2; spin++) {
+        osaThreadSignal ping, pong;
+        if (spin == 0) {
+            ping.SetMaximumSpinCount(0);
+            pong.SetMaximumSpinCount(0);
+        }
+        ThreadSignalPingPongArguments arguments;
+        arguments.Ping = &ping;
+        arguments.Pong = &pong;
+        arguments.NumberOfIterations = 10000;
+        arguments.NumberOfTimeouts = 0;
+        ThreadSignalPingPongHolder holder;
+        osaThread thread;
+        thread.Create<ThreadSignalPingPongHolder, ThreadSignalPingPongArguments *>(&holder, &ThreadSignalPingPongHolder::Method, &arguments, "PingPong");
+
+        unsigned int numberOfTimeouts = 0;
+        for (unsigned int index = 0; index < arguments.NumberOfIterations; index++) {
+            ping.Raise();
+            if (!pong.Wait(1.0)) {
+                numberOfTimeouts++;
+            }
+        }
+        thread.Wait();
+        CPPUNIT_ASSERT_EQUAL(0u, numberOfTimeouts);
+        CPPUNIT_ASSERT_EQUAL(0u, arguments.NumberOfTimeouts);
+    }
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(osaThreadSignalTest);
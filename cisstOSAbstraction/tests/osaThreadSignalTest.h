@@ -26,6 +26,8 @@ class osaThreadSignalTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(osaThreadSignalTest);
     {
         CPPUNIT_TEST(TestWaitBlocks);
+        CPPUNIT_TEST(TestWaitTimeout);
+        CPPUNIT_TEST(TestPingPong);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -38,4 +40,11 @@ public:
 
     /*! Check that waits do block */
     void TestWaitBlocks(void);
+
+    /*! Check that a raise before wait is kept once and that wait times out */
+    void TestWaitTimeout(void);
+
+    /*! Check that no raise is lost between two threads, with and
+      without spinning before waiting */
+    void TestPingPong(void);
 };
@@ -22,6 +22,10 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "osaThreadTest.h"
 
+#include <cisstOSAbstraction/osaThreadBuddy.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
 #include <string.h>
 
 void osaThreadTest::TestThreadInternalsSize(void) {
@@ -34,6 +38,42 @@ void osaThreadTest::TestThreadIdInternalsSize(void) {
 }
 
 
+void osaThreadTest::TestThreadBuddyAbsoluteDeadlines(void) {
+    osaThreadBuddy buddy;
+    osaAbsoluteTime period;
+    period.FromSeconds(2.0 * cmn_ms);
+    buddy.Create("Test", period);
+    if (!buddy.SetAbsoluteDeadlines(true, 20.0 * cmn_us)) {
+        // not supported on this OS
+        buddy.Delete();
+        return;
+    }
+    CPPUNIT_ASSERT(buddy.GetAbsoluteDeadlines());
+
+    // first call sets the phase
+    buddy.WaitForRemainingPeriod();
+    const double start = osaGetTime();
+    const unsigned int numberOfPeriods = 100;
+    for (unsigned int i = 0; i < numberOfPeriods; i++) {
+        buddy.WaitForRemainingPeriod();
+    }
+    // elapsed time is a multiple of the period, allow for overruns on a loaded host
+    const double elapsed = osaGetTime() - start;
+    const unsigned long skipped = buddy.GetNumberOfSkippedPeriods();
+    CPPUNIT_ASSERT(elapsed > (numberOfPeriods - 1) * 2.0 * cmn_ms);
+    CPPUNIT_ASSERT(elapsed < (numberOfPeriods + skipped + 5) * 2.0 * cmn_ms);
+
+    // miss 5 periods, next wait returns right away and skips the periods missed
+    const unsigned long overruns = buddy.GetNumberOfOverruns();
+    osaSleep(11.0 * cmn_ms);
+    buddy.WaitForRemainingPeriod();
+    CPPUNIT_ASSERT(buddy.GetNumberOfOverruns() > overruns);
+    CPPUNIT_ASSERT(buddy.GetNumberOfSkippedPeriods() >= skipped + 4);
+
+    buddy.Delete();
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(osaThreadTest);
 
 
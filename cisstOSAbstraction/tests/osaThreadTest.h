@@ -30,6 +30,7 @@ class osaThreadTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(osaThreadTest);
     CPPUNIT_TEST(TestThreadInternalsSize);
     CPPUNIT_TEST(TestThreadIdInternalsSize);
+    CPPUNIT_TEST(TestThreadBuddyAbsoluteDeadlines);
     CPPUNIT_TEST_SUITE_END();
     
  public:
@@ -43,6 +44,10 @@ class osaThreadTest: public CppUnit::TestFixture
     void TestThreadInternalsSize(void);
     void TestThreadIdInternalsSize(void);
 
+    /*! Check that absolute deadlines don't drift and that overruns
+      are counted */
+    void TestThreadBuddyAbsoluteDeadlines(void);
+
 };
 
 
@@ -115,9 +115,14 @@ void osaTripleBufferTest::TestMultiThreading(void)
     referenceVector.SetAll(0);
 
     osaTripleBuffer<value_type > tripleBuffer(referenceVector);
-    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.LastWriteNode->Pointer->size());
-    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.LastWriteNode->Next->Pointer->size());
-    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.LastWriteNode->Next->Next->Pointer->size());
+    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.Slots[0]->size());
+    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.Slots[1]->size());
+    CPPUNIT_ASSERT_EQUAL(TestVectorSize, tripleBuffer.Slots[2]->size());
+    // slots allocated by the buffer are on different cache lines
+    for (size_t index = 0; index < 3; ++index) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0),
+                             reinterpret_cast<size_t>(tripleBuffer.Slots[index]) % OSA_CACHE_LINE_SIZE);
+    }
 
     osaThread readThread;
     readThread.Create(osaTripleBufferTestReadThread, &tripleBuffer);
@@ -143,9 +148,11 @@ void osaTripleBufferTest::TestLogic(void)
     osaTripleBuffer<int> tripleBuffer(slot1, slot2, slot3);
 
     // test initial configuration
-    CPPUNIT_ASSERT_EQUAL(tripleBuffer.LastWriteNode->Pointer, slot1);
-    CPPUNIT_ASSERT_EQUAL(tripleBuffer.LastWriteNode->Next->Pointer, slot2);
-    CPPUNIT_ASSERT_EQUAL(tripleBuffer.LastWriteNode->Next->Next->Pointer, slot3);
+    CPPUNIT_ASSERT_EQUAL(tripleBuffer.Slots[0], slot1);
+    CPPUNIT_ASSERT_EQUAL(tripleBuffer.Slots[1], slot2);
+    CPPUNIT_ASSERT_EQUAL(tripleBuffer.Slots[2], slot3);
+    CPPUNIT_ASSERT_EQUAL(const_cast<const int *>(slot1), tripleBuffer.GetReadPointer());
+    CPPUNIT_ASSERT_EQUAL(slot2, tripleBuffer.GetWritePointer());
 
 
     // write while nobody's reading
@@ -201,4 +208,78 @@ void osaTripleBufferTest::TestLogic(void)
 }
 
 
+// small element so that slots are exchanged as often as possible
+class osaTripleBufferTestPair {
+public:
+    size_t Value;
+    size_t Complement;
+};
+
+typedef osaTripleBuffer<osaTripleBufferTestPair> pair_buffer_type;
+
+const size_t NumberOfPairIterations = 2 * 1000 * 1000;
+
+
+void * osaTripleBufferTestPairWriteThread(pair_buffer_type * buffer)
+{
+    osaTripleBufferTestPair pair;
+    for (size_t iteration = 1;
+         iteration <= NumberOfPairIterations;
+         ++iteration) {
+        pair.Value = iteration;
+        pair.Complement = ~iteration;
+        buffer->Write(pair);
+    }
+    WriteThreadDone = true;
+    return 0;
+}
+
+
+void * osaTripleBufferTestPairReadThread(pair_buffer_type * buffer)
+{
+    ErrorFoundInRead = false;
+    osaTripleBufferTestPair pair;
+    size_t lastValue = 0;
+    while (lastValue != NumberOfPairIterations) {
+        buffer->Read(pair);
+        if ((pair.Complement != ~pair.Value) || (pair.Value < lastValue)) {
+            buffer->ToStream(std::cerr);
+            std::cerr << "osaTripleBufferTestPairReadThread: read " << pair.Value
+                      << " after " << lastValue << std::endl;
+            ErrorFoundInRead = true;
+            break;
+        }
+        lastValue = pair.Value;
+    }
+    ReadThreadDone = true;
+    return 0;
+}
+
+
+void osaTripleBufferTest::TestStress(void)
+{
+    osaTripleBufferTestPair initialValue;
+    initialValue.Value = 0;
+    initialValue.Complement = ~static_cast<size_t>(0);
+    pair_buffer_type tripleBuffer(initialValue);
+
+    // flags are also set by the previous tests
+    WriteThreadDone = false;
+    ReadThreadDone = false;
+    ErrorFoundInRead = false;
+
+    osaThread readThread;
+    readThread.Create(osaTripleBufferTestPairReadThread, &tripleBuffer);
+
+    osaThread writeThread;
+    writeThread.Create(osaTripleBufferTestPairWriteThread, &tripleBuffer);
+
+    readThread.Wait();
+    writeThread.Wait();
+    CPPUNIT_ASSERT(!ErrorFoundInRead);
+    CPPUNIT_ASSERT(WriteThreadDone);
+    CPPUNIT_ASSERT(ReadThreadDone);
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(osaTripleBufferTest);
@@ -30,6 +30,7 @@ class osaTripleBufferTest : public CppUnit::TestFixture
     {
         CPPUNIT_TEST(TestLogic);
         CPPUNIT_TEST(TestMultiThreading);
+        CPPUNIT_TEST(TestStress);
 	}
     CPPUNIT_TEST_SUITE_END();
 
@@ -41,6 +42,10 @@ public:
 
     /*! Test multi threading */
     void TestMultiThreading(void);
+
+    /*! Test multi threading with a small element and many writes, the
+      reader must never see a partially written or older element */
+    void TestStress(void);
 };
 
 #endif // _osaTripleBufferTest_h
@@ -25,6 +25,7 @@ http://www.cisst.org/cisst/license.txt.
 
 //#include <cisstNumerical/nmrNetlib.h>
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 
@@ -135,13 +136,21 @@ void free_rmatrix(double** m, long nrl, long ncl){
   free((FREE_ARG) (m+nrl-NR_END));
 }
 
+robManipulator::IKOptions::IKOptions()
+  : tolerance(1e-10),
+    Niterations(100),
+    lambda(0.001),
+    adaptivedamping(false),
+    jointlimits(false),
+    warmstart(false){}
+
 robManipulator::robManipulator( const vctFrame4x4<double>& Rtw0 )
-  : Jn(NULL),Js(NULL)
+  : ikqvalid(false),ikiterations(0),ikerror(0.0),Jn(NULL),Js(NULL)
 {  this->Rtw0 = Rtw0;  }
 
 robManipulator::robManipulator( const std::string& linkfile,
                                 const vctFrame4x4<double>& Rtw0 )
-  : Jn(NULL),Js(NULL){
+  : ikqvalid(false),ikiterations(0),ikerror(0.0),Jn(NULL),Js(NULL){
 
   this->Rtw0 = Rtw0;
 
@@ -154,7 +163,7 @@ robManipulator::robManipulator( const std::string& linkfile,
 
 robManipulator::robManipulator( const std::vector<robKinematics *> linkParms,
                                 const vctFrame4x4<double>& Rtw0 )
-  : Jn(NULL),Js(NULL){
+  : ikqvalid(false),ikiterations(0),ikerror(0.0),Jn(NULL),Js(NULL){
 
   this->Rtw0 = Rtw0;
 
@@ -514,6 +523,249 @@ void robManipulator::NormalizeAngles( vctDynamicVector<double> &q )
   }
 }
 
+// Solve A x = b in place (x is returned in b) for a symmetric positive
+// definite A. Only the lower triangle of A is used and it is overwritten by
+// its Cholesky factor. Return false if A is not positive definite.
+static bool CholeskySolve6( vctFixedSizeMatrix<double,6,6>& A,
+                            vctFixedSizeVector<double,6>& b ){
+
+  for( size_t j=0; j<6; j++ ){
+    double d = A[j][j];
+    for( size_t k=0; k<j; k++ ) { d -= A[j][k]*A[j][k]; }
+    if( d <= 0.0 ) { return false; }
+    d = sqrt( d );
+    A[j][j] = d;
+    for( size_t i=j+1; i<6; i++ ){
+      double v = A[i][j];
+      for( size_t k=0; k<j; k++ ) { v -= A[i][k]*A[j][k]; }
+      A[i][j] = v / d;
+    }
+  }
+
+  // forward substitution L y = b
+  for( size_t i=0; i<6; i++ ){
+    double v = b[i];
+    for( size_t k=0; k<i; k++ ) { v -= A[i][k]*b[k]; }
+    b[i] = v / A[i][i];
+  }
+  // backward substitution L' x = y
+  for( size_t i=6; 0<i--; ){
+    double v = b[i];
+    for( size_t k=i+1; k<6; k++ ) { v -= A[k][i]*b[k]; }
+    b[i] = v / A[i][i];
+  }
+
+  return true;
+}
+
+robManipulator::Errno
+robManipulator::InverseKinematicsDLS( vctDynamicVector<double>& q,
+                                      const vctFrame4x4<double>& Rts,
+                                      const robManipulator::IKOptions& options ){
+
+  ikiterations = 0;
+
+  if( q.size() != links.size() ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": Expected " << links.size() << " joints values. "
+                      << " Got " << q.size()
+                      << std::endl;
+    return robManipulator::EFAILURE;
+  }
+
+  if( links.size() == 0 ){
+    CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                      << ": The manipulator has no links."
+                      << std::endl;
+    return robManipulator::EFAILURE;
+  }
+
+  const size_t N = links.size();
+
+  // only allocate if the number of links changed
+  ikJt.SetSize( N, 6 );
+  ikW.SetSize( N );
+  ikdq.SetSize( N );
+  ikq.SetSize( N );
+
+  if( options.warmstart && ikqvalid )
+    { q.Assign( ikq ); }
+  ikqvalid = false;
+
+  if( options.jointlimits ){
+    for( size_t j=0; j<N; j++ ){
+      const double qmin = links[j].PositionMin();
+      const double qmax = links[j].PositionMax();
+      if( qmin < qmax ){
+        if( q[j] < qmin ) { q[j] = qmin; }
+        if( qmax < q[j] ) { q[j] = qmax; }
+      }
+    }
+  }
+
+  ikW.SetAll( 1.0 );
+  ikdq.SetAll( 0.0 );
+
+  // bounds of the adaptive damping
+  const double lambdamin = 1e-12;
+  const double lambdamax = 1.0;
+  double lambda = options.lambda;
+  double e2previous = 0.0;
+
+  vctFixedSizeVector<double,3> n2( Rts[0][0], Rts[1][0], Rts[2][0] );
+  vctFixedSizeVector<double,3> o2( Rts[0][1], Rts[1][1], Rts[2][1] );
+  vctFixedSizeVector<double,3> a2( Rts[0][2], Rts[1][2], Rts[2][2] );
+
+  for( ;; ){
+
+    // Evaluate the forward kinematics. The axis of each joint (in the world
+    // frame) is the z axis of the frame preceding the link (standard DH and
+    // Hayati) or following it (modified DH and modified Hayati). The axis is
+    // stored in the last 3 columns of ikJt and a point on it in the first 3
+    // until the position of the tool control point is known.
+    vctFrame4x4<double> Rt( Rtw0 );
+    for( size_t j=0; j<N; j++ ){
+
+      const robKinematics::Convention convention = links[j].GetConvention();
+      double* Jj = ikJt.Pointer( j, 0 );
+
+      if( convention == robKinematics::STANDARD_DH ||
+          convention == robKinematics::HAYATI ){
+        Jj[0] = Rt[0][3];   Jj[1] = Rt[1][3];   Jj[2] = Rt[2][3];
+        Jj[3] = Rt[0][2];   Jj[4] = Rt[1][2];   Jj[5] = Rt[2][2];
+      }
+
+      Rt = Rt * links[j].ForwardKinematics( q[j] );
+
+      if( convention == robKinematics::MODIFIED_DH ||
+          convention == robKinematics::MODIFIED_HAYATI ){
+        Jj[0] = Rt[0][3];   Jj[1] = Rt[1][3];   Jj[2] = Rt[2][3];
+        Jj[3] = Rt[0][2];   Jj[4] = Rt[1][2];   Jj[5] = Rt[2][2];
+      }
+    }
+
+    if( tools.size() == 1 ){
+      if( tools[0] != NULL )
+        { Rt = Rt * tools[0]->ForwardKinematics( q, 0 ); }
+    }
+
+    // Geometric Jacobian of the tool control point in the world frame
+    const double px = Rt[0][3], py = Rt[1][3], pz = Rt[2][3];
+    for( size_t j=0; j<N; j++ ){
+      double* Jj = ikJt.Pointer( j, 0 );
+      switch( links[j].GetType() ){
+      case robJoint::HINGE:
+        {
+          // z x ( p - o )
+          const double rx = px - Jj[0], ry = py - Jj[1], rz = pz - Jj[2];
+          Jj[0] = Jj[4]*rz - Jj[5]*ry;
+          Jj[1] = Jj[5]*rx - Jj[3]*rz;
+          Jj[2] = Jj[3]*ry - Jj[4]*rx;
+        }
+        break;
+      case robJoint::SLIDER:
+        Jj[0] = Jj[3];      Jj[1] = Jj[4];      Jj[2] = Jj[5];
+        Jj[3] = 0.0;        Jj[4] = 0.0;        Jj[5] = 0.0;
+        break;
+      default:
+        Jj[0] = Jj[1] = Jj[2] = Jj[3] = Jj[4] = Jj[5] = 0.0;
+      }
+    }
+
+    // Pose error, same as InverseKinematics
+    vctFixedSizeVector<double,3> n1( Rt[0][0], Rt[1][0], Rt[2][0] );
+    vctFixedSizeVector<double,3> o1( Rt[0][1], Rt[1][1], Rt[2][1] );
+    vctFixedSizeVector<double,3> a1( Rt[0][2], Rt[1][2], Rt[2][2] );
+    vctFixedSizeVector<double,3> dr = 0.5*( (n1%n2) + (o1%o2) + (a1%a2) );
+
+    vctFixedSizeVector<double,6> e( Rts[0][3]-px, Rts[1][3]-py, Rts[2][3]-pz,
+                                    dr[0], dr[1], dr[2] );
+    const double e2 = e.NormSquare();
+    ikerror = sqrt( e2 );
+
+    // Levenberg-Marquardt like damping: decrease lambda after a step that
+    // reduced the error, increase it otherwise. The steps are never undone
+    // since far from the solution the orientation error is not monotonic
+    // along the path to the solution.
+    if( options.adaptivedamping && 0 < ikiterations ){
+      if( e2 < e2previous ) { lambda = std::max( 0.1*lambda, lambdamin ); }
+      else                  { lambda = std::min( 10.0*lambda, lambdamax ); }
+    }
+    e2previous = e2;
+
+    if( ikerror < options.tolerance ){
+      ikq.Assign( q );
+      ikqvalid = true;
+      return robManipulator::ESUCCESS;
+    }
+    if( options.Niterations <= ikiterations )
+      { return robManipulator::EFAILURE; }
+    ikiterations++;
+
+    // Weights of the joints moving towards a limit (Chan and Dubey): the
+    // inverse of 1 + |dH/dq| where H is the joint limit performance
+    // criterion, written without the division to remain finite at the limit
+    if( options.jointlimits ){
+      for( size_t j=0; j<N; j++ ){
+        const double qmin = links[j].PositionMin();
+        const double qmax = links[j].PositionMax();
+        ikW[j] = 1.0;
+        if( qmin < qmax ){
+          const double mid = 2.0*q[j] - qmax - qmin;
+          if( ( 0.0 < ikdq[j] && 0.0 < mid ) || ( ikdq[j] < 0.0 && mid < 0.0 ) ){
+            const double d = 2.0*( qmax - q[j] )*( q[j] - qmin );
+            const double range = qmax - qmin;
+            ikW[j] = d*d / ( d*d + range*range*fabs( mid ) );
+          }
+        }
+      }
+    }
+
+    // A = J W J' + lambda I
+    vctFixedSizeMatrix<double,6,6> A( 0.0 );
+    for( size_t j=0; j<N; j++ ){
+      const double* Jj = ikJt.Pointer( j, 0 );
+      const double w = ikW[j];
+      for( size_t r=0; r<6; r++ ){
+        const double wJr = w*Jj[r];
+        for( size_t c=0; c<=r; c++ ) { A[r][c] += wJr*Jj[c]; }
+      }
+    }
+    for( size_t r=0; r<6; r++ ) { A[r][r] += lambda; }
+
+    // e = A^-1 e
+    if( !CholeskySolve6( A, e ) ){
+      CMN_LOG_RUN_VERBOSE << CMN_LOG_DETAILS
+                          << ": Singular system, increase the damping."
+                          << std::endl;
+      return robManipulator::EFAILURE;
+    }
+
+    // dq = W J' e. The direction of each joint is kept before weighting
+    // and clamping, so that a joint stopped at a limit remains weighted.
+    for( size_t j=0; j<N; j++ ){
+      const double* Jj = ikJt.Pointer( j, 0 );
+      ikdq[j] = ( Jj[0]*e[0] + Jj[1]*e[1] + Jj[2]*e[2] +
+                  Jj[3]*e[3] + Jj[4]*e[4] + Jj[5]*e[5] );
+      q[j] += ikW[j]*ikdq[j];
+      if( options.jointlimits ){
+        const double qmin = links[j].PositionMin();
+        const double qmax = links[j].PositionMax();
+        if( qmin < qmax ){
+          if( q[j] < qmin ) { q[j] = qmin; }
+          if( qmax < q[j] ) { q[j] = qmax; }
+        }
+      }
+    }
+  }
+}
+
+size_t robManipulator::IKIterations() const
+{ return ikiterations; }
+
+double robManipulator::IKError() const
+{ return ikerror; }
+
 #if 0
 robManipulator::Errno
 robManipulator::InverseKinematics( vctDynamicVector<double>& q,
@@ -0,0 +1,217 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Compare robManipulator::InverseKinematics and InverseKinematicsDLS on
+// random reachable poses of a 7 DOF arm (Barrett WAM kinematics) and on a
+// trajectory sampled at 1 kHz
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cisstCommon/cmnConstants.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstRobot/robManipulator.h>
+#include <cisstRobot/robDH.h>
+
+const size_t NumberOfJoints = 7;
+const double JointMin[NumberOfJoints] = { -2.60, -2.00, -2.80, -0.90, -4.76, -1.60, -3.00 };
+const double JointMax[NumberOfJoints] = {  2.60,  2.00,  2.80,  3.10,  1.24,  1.60,  3.00 };
+
+double Random(double min, double max)
+{
+    return min + (max - min) * static_cast<double>(rand()) / static_cast<double>(RAND_MAX);
+}
+
+vctDoubleVec RandomJoints(void)
+{
+    vctDoubleVec q(NumberOfJoints);
+    for (size_t i = 0; i < NumberOfJoints; i++) {
+        q[i] = Random(JointMin[i], JointMax[i]);
+    }
+    return q;
+}
+
+// Norm of the position and orientation errors, as minimized by the solvers
+double PoseError(const vctFrame4x4<double> & Rt, const vctFrame4x4<double> & Rts)
+{
+    vctFixedSizeVector<double, 3> dt(Rts[0][3] - Rt[0][3], Rts[1][3] - Rt[1][3], Rts[2][3] - Rt[2][3]);
+    vctFixedSizeVector<double, 3> dr(0.0);
+    for (size_t c = 0; c < 3; c++) {
+        vctFixedSizeVector<double, 3> v1(Rt[0][c], Rt[1][c], Rt[2][c]);
+        vctFixedSizeVector<double, 3> v2(Rts[0][c], Rts[1][c], Rts[2][c]);
+        dr += 0.5 * (v1 % v2);
+    }
+    return sqrt(dt.NormSquare() + dr.NormSquare());
+}
+
+class Solver
+{
+public:
+    std::string Name;
+    bool Legacy;
+    robManipulator::IKOptions Options;
+
+    Solver(const std::string & name, bool legacy):
+        Name(name),
+        Legacy(legacy)
+    {}
+
+    robManipulator::Errno Solve(robManipulator & robot, vctDoubleVec & q, const vctFrame4x4<double> & Rts, size_t & iterations) const
+    {
+        if (Legacy) {
+            iterations = 0;
+            return robot.InverseKinematics(q, Rts);
+        }
+        robManipulator::Errno result = robot.InverseKinematicsDLS(q, Rts, Options);
+        iterations = robot.IKIterations();
+        return result;
+    }
+};
+
+void PrintHeader(const std::string & title)
+{
+    std::cout << std::endl << title << std::endl
+              << std::setw(28) << std::left << "solver" << std::right
+              << std::setw(14) << "converged %"
+              << std::setw(14) << "iterations"
+              << std::setw(14) << "us/solve" << std::endl;
+}
+
+void PrintResult(const Solver & solver, size_t converged, size_t total, size_t iterations, double seconds)
+{
+    std::cout << std::setw(28) << std::left << solver.Name << std::right << std::fixed
+              << std::setw(14) << std::setprecision(1) << 100.0 * converged / total;
+    if (solver.Legacy) {
+        std::cout << std::setw(14) << "-";
+    } else {
+        std::cout << std::setw(14) << std::setprecision(2) << static_cast<double>(iterations) / total;
+    }
+    std::cout << std::setw(14) << std::setprecision(2) << seconds * 1e6 / total << std::endl;
+}
+
+// Solve from a perturbation of the solution (or from random joints if
+// perturbation is negative)
+void RandomPoses(robManipulator & robot, const Solver & solver, size_t count, double perturbation)
+{
+    srand(1);
+    osaStopwatch stopwatch;
+    size_t converged = 0, iterations = 0, it;
+    for (size_t n = 0; n < count; n++) {
+        vctDoubleVec qs = RandomJoints();
+        vctFrame4x4<double> Rts = robot.ForwardKinematics(qs);
+        vctDoubleVec q(qs);
+        if (perturbation < 0.0) {
+            q = RandomJoints();
+        } else {
+            for (size_t i = 0; i < NumberOfJoints; i++) {
+                q[i] += Random(-perturbation, perturbation);
+            }
+        }
+        stopwatch.Start();
+        robManipulator::Errno result = solver.Solve(robot, q, Rts, it);
+        stopwatch.Stop();
+        iterations += it;
+        if (result == robManipulator::ESUCCESS && PoseError(robot.ForwardKinematics(q), Rts) < 1e-8) {
+            converged++;
+        }
+    }
+    PrintResult(solver, converged, count, iterations, stopwatch.GetElapsedTime());
+}
+
+// Follow a smooth trajectory at 1 kHz, starting from joint positions
+// measured 10 ms before (as a controller lagging behind the commands)
+void Trajectory(robManipulator & robot, const Solver & solver, size_t count)
+{
+    const size_t lag = 10;
+    std::vector<vctDoubleVec> trajectory(count);
+    for (size_t n = 0; n < count; n++) {
+        const double t = 0.001 * n;
+        trajectory[n].SetSize(NumberOfJoints);
+        for (size_t i = 0; i < NumberOfJoints; i++) {
+            const double mid = 0.5 * (JointMin[i] + JointMax[i]);
+            const double amplitude = 0.3 * (JointMax[i] - JointMin[i]);
+            trajectory[n][i] = mid + amplitude * sin(0.5 * (i + 1) * t);
+        }
+    }
+    osaStopwatch stopwatch;
+    size_t converged = 0, iterations = 0, it;
+    vctDoubleVec q;
+    for (size_t n = lag; n < count; n++) {
+        vctFrame4x4<double> Rts = robot.ForwardKinematics(trajectory[n]);
+        q = trajectory[n - lag];
+        stopwatch.Start();
+        robManipulator::Errno result = solver.Solve(robot, q, Rts, it);
+        stopwatch.Stop();
+        iterations += it;
+        if (result == robManipulator::ESUCCESS && PoseError(robot.ForwardKinematics(q), Rts) < 1e-8) {
+            converged++;
+        }
+    }
+    PrintResult(solver, converged, count - lag, iterations, stopwatch.GetElapsedTime());
+}
+
+int main(void)
+{
+    // Barrett WAM, standard DH
+    const double DH[NumberOfJoints][3] = { {  0.0,   -cmnPI_2, 0.346 },  // a, alpha, d
+                                           {  0.0,    cmnPI_2, 0.0   },
+                                           {  0.045, -cmnPI_2, 0.55  },
+                                           { -0.045,  cmnPI_2, 0.0   },
+                                           {  0.0,   -cmnPI_2, 0.3   },
+                                           {  0.0,    cmnPI_2, 0.0   },
+                                           {  0.0,    0.0,     0.062 } };
+    std::vector<robKinematics *> kinematics;
+    for (size_t i = 0; i < NumberOfJoints; i++) {
+        robJoint joint(robJoint::HINGE, robJoint::ACTIVE, 0.0, JointMin[i], JointMax[i], 0.0);
+        kinematics.push_back(new robDH(DH[i][1], DH[i][0], 0.0, DH[i][2], joint));
+    }
+    robManipulator robot(kinematics);
+
+    std::vector<Solver> solvers;
+    solvers.push_back(Solver("InverseKinematics", true));
+    solvers.push_back(Solver("DLS", false));
+    solvers.push_back(Solver("DLS adaptive", false));
+    solvers.back().Options.adaptivedamping = true;
+    solvers.push_back(Solver("DLS adaptive, joint limits", false));
+    solvers.back().Options.adaptivedamping = true;
+    solvers.back().Options.jointlimits = true;
+
+    const size_t count = 2000;
+
+    PrintHeader("Random poses, initial guess within 0.2 rad of a solution");
+    for (size_t s = 0; s < solvers.size(); s++) {
+        RandomPoses(robot, solvers[s], count, 0.2);
+    }
+
+    PrintHeader("Random poses, random initial guess");
+    for (size_t s = 0; s < solvers.size(); s++) {
+        RandomPoses(robot, solvers[s], count, -1.0);
+    }
+
+    PrintHeader("1 kHz trajectory, initial guess 10 ms late");
+    for (size_t s = 0; s < solvers.size(); s++) {
+        Trajectory(robot, solvers[s], count);
+    }
+    Solver warm("DLS adaptive, warm start", false);
+    warm.Options.adaptivedamping = true;
+    warm.Options.warmstart = true;
+    Trajectory(robot, warm, count);
+
+    return 0;
+}
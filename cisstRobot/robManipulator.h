@@ -38,10 +38,52 @@ class CISST_EXPORT robManipulator{
   //! A vector of tools
   std::vector<robManipulator*> tools;
 
+  //! Work space of InverseKinematicsDLS
+  /**
+     ikJt is the transposed geometric Jacobian (one row per joint), ikW the
+     joint weights, ikdq the unweighted last step, ikq the last converged
+     solution used for warm starts. They are only resized when the number of links changes.
+  */
+  vctDynamicMatrix<double> ikJt;
+  vctDynamicVector<double> ikW;
+  vctDynamicVector<double> ikdq;
+  vctDynamicVector<double> ikq;
+  bool ikqvalid;
+  size_t ikiterations;
+  double ikerror;
+
  public:
 
   enum Errno{ ESUCCESS, EFAILURE };
 
+  //! Options of the damped least squares inverse kinematics
+  /**
+     \sa InverseKinematicsDLS
+  */
+  struct CISST_EXPORT IKOptions{
+
+    //! Default options: constant damping, no joint limits, no warm start
+    IKOptions();
+
+    //! Stop once the norm of the pose error is below this value
+    double tolerance;
+
+    //! The maximum number of iterations
+    size_t Niterations;
+
+    //! The damping factor (lambda) of the least squares
+    double lambda;
+
+    //! Adjust lambda at each iteration (Levenberg-Marquardt)
+    bool adaptivedamping;
+
+    //! Clamp the joints to their limits and slow down those moving to them
+    bool jointlimits;
+
+    //! Start from the previous converged solution instead of the given guess
+    bool warmstart;
+  };
+
   //! Position and orientation of the first link
   /**
      Simply put, this is the position and orientation of the base of the first
@@ -222,6 +264,7 @@ public:
      \param Niteration The maximum number of iterations allowed to find a solution
      \return SUCCESS if a solution was found within the given tolerance and
                      number of iterations. ERROR otherwise.
+     \sa InverseKinematicsDLS for a faster solver
   */
   virtual
     robManipulator::Errno
@@ -239,6 +282,43 @@ public:
                        double tolerance=1e-12,
                        size_t Niteration=1000 );
 
+  //! Evaluate the inverse kinematics with damped least squares
+  /**
+     Faster alternative to InverseKinematics, meant for control loops. Each
+     iteration evaluates the pose of the tool control point and its geometric
+     Jacobian in the world frame in a single pass over the links, and solves
+     dq = W J' ( J W J' + lambda I )^-1 e with a 6x6 Cholesky factorization.
+     Memory is only allocated by the first call, or after the number of links
+     changed. The solution is not normalized (see NormalizeAngles).
+     With adaptive damping, lambda is divided by 10 after a step that reduced
+     the pose error and multiplied by 10 otherwise, within [1e-12, 1]
+     (Levenberg-Marquardt): the steps remain short far from the solution and
+     near singularities, and the convergence is quadratic close to the
+     solution. With joint limits, W holds the weights of Chan and
+     Dubey (IEEE TRA 1995) for the joints moving towards a limit and the
+     joints are clamped to their limits; a joint is unlimited if its minimum
+     is not below its maximum. With warm start, the iterations start from the
+     solution of the previous call if it converged.
+     \param[input] q An initial guess of the solution
+     \param[output] q The inverse kinematics solution
+     \param Rts The desired position and orientation of the tool control point
+     \param options The tolerance, damping and constraints of the solver
+     \return ESUCCESS if the pose error is below the tolerance within the
+             maximum number of iterations. EFAILURE otherwise.
+  */
+  virtual
+    robManipulator::Errno
+    InverseKinematicsDLS( vctDynamicVector<double>& q,
+                          const vctFrame4x4<double>& Rts,
+                          const robManipulator::IKOptions& options =
+                          robManipulator::IKOptions() );
+
+  //! The number of iterations of the last call to InverseKinematicsDLS
+  size_t IKIterations() const;
+
+  //! The norm of the pose error at the end of the last InverseKinematicsDLS
+  double IKError() const;
+
   //! Normalize angles to -pi to pi
   virtual void NormalizeAngles( vctDynamicVector<double>& q );
 
@@ -66,6 +66,52 @@ void robManipulatorTest::TestInverseKinematics(){
 
 }
 
+void robManipulatorTest::TestInverseKinematicsDLS(){
+    cmnPath path;
+    path.AddRelativeToCisstShare("/models/WAM");
+    std::string fname = path.Find("wam7.rob", cmnPath::READ);
+
+    robManipulator WAM7( fname );
+
+    robManipulator::IKOptions options;
+    options.adaptivedamping = true;
+
+  for( size_t i=0; i<10; i++ ){
+
+    vctDynamicVector<double> q = RandomWAMVector();
+    vctFrame4x4<double> Rtq =  WAM7.ForwardKinematics( q );
+
+    vctDynamicVector<double> qs( q );
+    for( size_t i=0; i<7; i++ ) { qs[i] += 0.2; }
+    CPPUNIT_ASSERT( WAM7.InverseKinematicsDLS( qs, Rtq, options ) == robManipulator::ESUCCESS );
+    CPPUNIT_ASSERT( WAM7.IKError() < options.tolerance );
+    CPPUNIT_ASSERT( Rtq.AlmostEqual( WAM7.ForwardKinematics( qs ) ) );
+
+    // warm start from the previous solution, the guess is ignored
+    options.warmstart = true;
+    vctDynamicVector<double> qw( 7, 0.0 );
+    CPPUNIT_ASSERT( WAM7.InverseKinematicsDLS( qw, Rtq, options ) == robManipulator::ESUCCESS );
+    CPPUNIT_ASSERT( WAM7.IKIterations() == 0 );
+    CPPUNIT_ASSERT( qw.Equal( qs ) );
+    options.warmstart = false;
+
+    // the solution remains within the joint limits
+    options.jointlimits = true;
+    qs = q;
+    for( size_t i=0; i<7; i++ ) { qs[i] += 0.2; }
+    if( WAM7.InverseKinematicsDLS( qs, Rtq, options ) == robManipulator::ESUCCESS )
+      { CPPUNIT_ASSERT( Rtq.AlmostEqual( WAM7.ForwardKinematics( qs ) ) ); }
+    for( size_t i=0; i<7; i++ ){
+      if( WAM7.links[i].PositionMin() < WAM7.links[i].PositionMax() ){
+        CPPUNIT_ASSERT( WAM7.links[i].PositionMin() <= qs[i] );
+        CPPUNIT_ASSERT( qs[i] <= WAM7.links[i].PositionMax() );
+      }
+    }
+    options.jointlimits = false;
+  }
+
+}
+
 void robManipulatorTest::TestInverseDynamics(){
     cmnPath path;
     path.AddRelativeToCisstShare("/models/WAM");
@@ -12,6 +12,7 @@ private:
 
   CPPUNIT_TEST(TestForwardKinematics);
   CPPUNIT_TEST(TestInverseKinematics);
+  CPPUNIT_TEST(TestInverseKinematicsDLS);
 
   //CPPUNIT_TEST(TestInverseDynamics);
 
@@ -23,6 +24,7 @@ public:
 
   void TestForwardKinematics();
   void TestInverseKinematics();
+  void TestInverseKinematicsDLS();
   
   void TestInverseDynamics();
 
@@ -66,7 +66,8 @@ svlStreamType svlBufferSample::GetType() const
 
 int svlBufferSample::Push(const svlSample* sample)
 {
-    int ret = Buffer[Next]->CopyOf(sample);
+    // Shares the image data with the pushed sample until either is modified
+    int ret = Buffer[Next]->ShareOf(sample);
 
     // Atomic exchange of values
 #if (CISST_OS == CISST_WINDOWS)
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlConverters.h>
+#include "svlImageProcessingSIMD.h"
 
 #define ACCURATE_COLOR_TO_GRAYSCALE     false
 
@@ -765,7 +766,11 @@ void svlConverter::RGB24toYUV444(unsigned char* input, unsigned char* output, co
 {
     int r, g, b, y, u, v;
 
-    for (unsigned int i = 0; i < pixelcount; i ++) {
+    unsigned int i = svlImageProcessingSIMD::RGB24toYUV444(input, output, pixelcount, ch1, ch2, ch3);
+    input += i * 3;
+    output += i * 3;
+
+    for (; i < pixelcount; i ++) {
         r = *input; input ++;
         g = *input; input ++;
         b = *input; input ++;
@@ -1270,7 +1275,11 @@ void svlConverter::YUV444toRGB24(unsigned char* input, unsigned char* output, co
 {
     int y, u, v, r, g, b;
 
-    for (unsigned int i = 0; i < pixelcount; i ++) {
+    unsigned int i = svlImageProcessingSIMD::YUV444toRGB24(input, output, pixelcount, ch1, ch2, ch3);
+    input += i * 3;
+    output += i * 3;
+
+    for (; i < pixelcount; i ++) {
         y = *input; input ++;
         u = *input; input ++;
         v = *input; input ++;
@@ -26,6 +26,19 @@ http://www.cisst.org/cisst/license.txt.
 #include "svlStereoDPMono.h"
 
 
+/*******************************************/
+/*** svlComputationalStereoMethodBase class */
+/*******************************************/
+
+int svlComputationalStereoMethodBase::Process(svlProcInfo* procInfo, svlSampleImage* images, int* depthmap)
+{
+    int ret = SVL_OK;
+    _OnSingleThread(procInfo) ret = Process(images, depthmap);
+    _SynchronizeThreads(procInfo);
+    return ret;
+}
+
+
 /*******************************************/
 /*** svlFilterComputationalStereo class ****/
 /*******************************************/
@@ -202,13 +215,13 @@ int svlFilterComputationalStereo::Process(svlProcInfo* procInfo, svlSample* sync
     _SkipIfAlreadyProcessed(syncInput, syncOutput);
 
     svlSampleImage* stimg = dynamic_cast<svlSampleImage*>(syncInput);
+    unsigned int from, to;
 
     // Process data
-    if (procInfo->count == 1 || procInfo->ID == 1) {
-        if (XCheckEnabled) {
-            svlStreamType inputtype = GetInput()->GetType();
+    if (XCheckEnabled) {
+        svlStreamType inputtype = GetInput()->GetType();
 
-            // Process data
+        _OnSingleThread(procInfo) {
             if (inputtype == svlTypeImageRGBStereo) {
                 CreateXCheckImageColor(stimg->GetUCharPointer(SVL_LEFT),
                                        XCheckImage->GetUCharPointer(SVL_RIGHT),
@@ -239,43 +252,41 @@ int svlFilterComputationalStereo::Process(svlProcInfo* procInfo, svlSample* sync
                                                       stimg->GetWidth(SVL_RIGHT),
                                                       stimg->GetHeight(SVL_RIGHT));
             }
-            else return SVL_FAIL;
-
-            // Stereo: computing disparity map
-            XCheckStereoAlgorithm->Process(XCheckImage, XCheckDisparityBuffer.Pointer());
-
-            if (procInfo->ID == 1) {
-                _SynchronizeThreads(procInfo);
-                return SVL_OK;
-            }
         }
-    }
 
-    if (procInfo->ID == 0) {
+        _SynchronizeThreads(procInfo);
 
-        // Stereo: computing disparity map
-        StereoAlgorithm->Process(stimg, DisparityBuffer.Pointer());
+        // Stereo: computing cross check disparity map on all threads
+        XCheckStereoAlgorithm->Process(procInfo, XCheckImage, XCheckDisparityBuffer.Pointer());
+    }
 
-        if (XCheckEnabled) {
-            _SynchronizeThreads(procInfo);
+    // Stereo: computing disparity map on all threads
+    StereoAlgorithm->Process(procInfo, stimg, DisparityBuffer.Pointer());
 
-            // Compare results with the cross checked results and update final disparity map
-            PerformXCheck();
-        }
+    // Compare results with the cross checked results and update final disparity map
+    if (XCheckEnabled) PerformXCheck(procInfo);
 
-        // Store disparity map
-        ConvertDisparitiesToFloat(DisparityBuffer.Pointer(),
-                                  OutputMatrix->GetPointer(),
+    // Store disparity map
+    //   (each thread converts the rows it cross checked)
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(OutputMatrix->GetRows()), from, to);
+    if (from < to) {
+        ConvertDisparitiesToFloat(DisparityBuffer.Pointer(from, 0),
+                                  OutputMatrix->GetPointer(0, from),
                                   static_cast<int>(OutputMatrix->GetCols()),
-                                  static_cast<int>(OutputMatrix->GetRows()));
-
-        // Apply spatial filter if enabled
-        if (SpatialFilterRadius > 0) ApplySpatialFilter(SpatialFilterRadius,
-                                                        OutputMatrix->GetPointer(ROI.left, ROI.top),
-                                                        SpatialFilterBuffer.Pointer(ROI.top, ROI.left),
-                                                        ROI.right - ROI.left,
-                                                        ROI.bottom - ROI.top,
-                                                        static_cast<int>(OutputMatrix->GetCols()));
+                                  static_cast<int>(to - from));
+    }
+
+    // Apply spatial filter if enabled
+    if (SpatialFilterRadius > 0) {
+        _SynchronizeThreads(procInfo);
+
+        return ApplySpatialFilter(procInfo,
+                                  SpatialFilterRadius,
+                                  OutputMatrix->GetPointer(ROI.left, ROI.top),
+                                  SpatialFilterBuffer.Pointer(ROI.top, ROI.left),
+                                  ROI.right - ROI.left,
+                                  ROI.bottom - ROI.top,
+                                  static_cast<int>(OutputMatrix->GetCols()));
     }
 
     return SVL_OK;
@@ -447,15 +458,21 @@ void svlFilterComputationalStereo::CreateXCheckImageColor(unsigned char* source,
     }
 }
 
-void svlFilterComputationalStereo::PerformXCheck()
+void svlFilterComputationalStereo::PerformXCheck(svlProcInfo* procInfo)
 {
     const int width = static_cast<int>(DisparityBuffer.width()) - 1;
     const int height = static_cast<int>(DisparityBuffer.height()) - 1;
     int i, j, k, r, l, from, to, dispmin, disp, prevdisp;
+    unsigned int rowfrom, rowto;
+
+    // Rows are independent, each thread checks a band of rows
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(height + 1), rowfrom, rowto);
+    const int firstrow = std::max(static_cast<int>(rowfrom), 1);
+    const int lastrow = std::min(static_cast<int>(rowto), height);
 
     // find occlusions and inconsistencies
     if (SubpixelPrecision) {
-        for (j = 1; j < height; j ++) {
+        for (j = firstrow; j < lastrow; j ++) {
             for (i = 0; i <= width; i ++) {
                 r = DisparityBuffer.Element(j, i);
                 l = XCheckDisparityBuffer.Element(height - j, width - (i + ((r + 2) >> 2)));
@@ -464,7 +481,7 @@ void svlFilterComputationalStereo::PerformXCheck()
         }
     }
     else {
-        for (j = 1; j < height; j ++) {
+        for (j = firstrow; j < lastrow; j ++) {
             for (i = 0; i <= width; i ++) {
                 r = DisparityBuffer.Element(j, i);
                 l = XCheckDisparityBuffer.Element(height - j, width - (i + r));
@@ -473,7 +490,7 @@ void svlFilterComputationalStereo::PerformXCheck()
         }
     }
     // fill holes
-    for (j = ROI.top - 1; j <= ROI.bottom; j ++) {
+    for (j = std::max(ROI.top - 1, static_cast<int>(rowfrom)); j <= ROI.bottom && j < static_cast<int>(rowto); j ++) {
         from = 0x7FFFFFFF;
         to = -1;
         prevdisp = 0x7FFFFFFF;
@@ -539,16 +556,22 @@ void svlFilterComputationalStereo::ConvertDisparitiesToFloat(int* input, float*
     }
 }
 
-void svlFilterComputationalStereo::ApplySpatialFilter(const int radius,
-                                                      float* disparitymap, float* tempbuffer,
-                                                      const int mapwidth, const int mapheight, const int linestride)
+int svlFilterComputationalStereo::ApplySpatialFilter(svlProcInfo* procInfo, const int radius,
+                                                     float* disparitymap, float* tempbuffer,
+                                                     const int mapwidth, const int mapheight, const int linestride)
 {
     int i, j, k, l, divider;
     int xstart, xend, ystart, yend;
+    unsigned int from, to;
     float sum;
     float *input, *output;
 
-    for (j = 0; j < mapheight; j ++) {
+    if (mapheight <= 0) return SVL_OK;
+
+    // Each thread filters a band of rows
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(mapheight), from, to);
+
+    for (j = from; j < static_cast<int>(to); j ++) {
 
         sum = 0.0f;
         divider = 0;
@@ -607,13 +630,17 @@ void svlFilterComputationalStereo::ApplySpatialFilter(const int radius,
         }
     }
 
+    _SynchronizeThreads(procInfo);
+
     // copy temp buffer back to input buffer
-    input = tempbuffer;
-    output = disparitymap;
-    for (j = 0; j < mapheight; j ++) {
+    input = tempbuffer + from * linestride;
+    output = disparitymap + from * linestride;
+    for (j = from; j < static_cast<int>(to); j ++) {
         memcpy(output, input, mapwidth * sizeof(float));
         input += linestride;
         output += linestride;
     }
+
+    return SVL_OK;
 }
 
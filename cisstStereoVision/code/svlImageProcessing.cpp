@@ -188,7 +188,7 @@ int svlImageProcessing::UnsharpMask(const svlSampleImage* src_img,
     }
 
     unsigned int width = src_img->GetWidth(src_videoch);
-    unsigned int height = src_img->GetWidth(src_videoch);
+    unsigned int height = src_img->GetHeight(src_videoch);
     if (width == 0 || height == 0 ||
         dst_img->GetWidth(dst_videoch) != width ||
         dst_img->GetHeight(dst_videoch) != height) {
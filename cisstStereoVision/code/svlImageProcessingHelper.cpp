@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include "svlImageProcessingHelper.h"
+#include "svlImageProcessingSIMD.h"
 #include "cisstCommon/cmnPortability.h"
 #include <fstream>
 #include <cmath>
@@ -54,6 +55,11 @@ void svlImageProcessingHelper::ConvolutionRGB(unsigned char* input, unsigned cha
 {
     if (!input || !output || kernel.size() < 1) return;
 
+    if (svlImageProcessingSIMD::ConvolutionUChar(input, output, width, height, 3, kernel.Pointer(),
+                                                 horizontal ? static_cast<int>(kernel.size()) : 1,
+                                                 horizontal ? 1 : static_cast<int>(kernel.size()),
+                                                 absres)) return;
+
     const int kernel_size = static_cast<int>(kernel.size());
     const int kernel_rad = kernel_size / 2;
     const int rowstride = width * 3;
@@ -188,6 +194,11 @@ void svlImageProcessingHelper::ConvolutionRGBA(unsigned char* input, unsigned ch
 {
     if (!input || !output || kernel.size() < 1) return;
 
+    if (svlImageProcessingSIMD::ConvolutionUChar(input, output, width, height, 4, kernel.Pointer(),
+                                                 horizontal ? static_cast<int>(kernel.size()) : 1,
+                                                 horizontal ? 1 : static_cast<int>(kernel.size()),
+                                                 absres)) return;
+
     const int kernel_size = static_cast<int>(kernel.size());
     const int kernel_rad = kernel_size / 2;
     const int rowstride = width * 4;
@@ -332,6 +343,11 @@ void svlImageProcessingHelper::ConvolutionMono8(unsigned char* input, unsigned c
 {
     if (!input || !output || kernel.size() < 1) return;
 
+    if (svlImageProcessingSIMD::ConvolutionUChar(input, output, width, height, 1, kernel.Pointer(),
+                                                 horizontal ? static_cast<int>(kernel.size()) : 1,
+                                                 horizontal ? 1 : static_cast<int>(kernel.size()),
+                                                 absres)) return;
+
     const int kernel_size = static_cast<int>(kernel.size());
     const int kernel_rad = kernel_size / 2;
     unsigned char *input2;
@@ -668,6 +684,10 @@ void svlImageProcessingHelper::ConvolutionRGB(unsigned char* input, unsigned cha
 {
     if (!input || !output || kernel.rows() < 1 || kernel.cols() < 1) return;
 
+    if (svlImageProcessingSIMD::ConvolutionUChar(input, output, width, height, 3, kernel.Pointer(),
+                                                 static_cast<int>(kernel.cols()), static_cast<int>(kernel.rows()),
+                                                 absres)) return;
+
     const int kernel_width  = static_cast<int>(kernel.cols());
     const int kernel_height = static_cast<int>(kernel.rows());
     const int kernel_h_rad = kernel_width  / 2;
@@ -767,6 +787,10 @@ void svlImageProcessingHelper::ConvolutionRGBA(unsigned char* input, unsigned ch
 {
     if (!input || !output || kernel.rows() < 1 || kernel.cols() < 1) return;
 
+    if (svlImageProcessingSIMD::ConvolutionUChar(input, output, width, height, 4, kernel.Pointer(),
+                                                 static_cast<int>(kernel.cols()), static_cast<int>(kernel.rows()),
+                                                 absres)) return;
+
     const int kernel_width  = static_cast<int>(kernel.cols());
     const int kernel_height = static_cast<int>(kernel.rows());
     const int kernel_h_rad = kernel_width  / 2;
@@ -871,6 +895,10 @@ void svlImageProcessingHelper::ConvolutionMono8(unsigned char* input, unsigned c
 {
     if (!input || !output || kernel.rows() < 1 || kernel.cols() < 1) return;
 
+    if (svlImageProcessingSIMD::ConvolutionUChar(input, output, width, height, 1, kernel.Pointer(),
+                                                 static_cast<int>(kernel.cols()), static_cast<int>(kernel.rows()),
+                                                 absres)) return;
+
     const int kernel_width  = static_cast<int>(kernel.cols());
     const int kernel_height = static_cast<int>(kernel.rows());
     const int kernel_h_rad = kernel_width  / 2;
@@ -1129,6 +1157,8 @@ void svlImageProcessingHelper::ConvolutionMono32(unsigned int* input, unsigned i
 
 void svlImageProcessingHelper::UnsharpMaskBlurRGB(const unsigned char* img_in, unsigned char* img_out, const int width, const int height, int radius)
 {
+    if (svlImageProcessingSIMD::UnsharpMaskBlurRGB(img_in, img_out, width, height, radius)) return;
+
     const int rowstride = width * 3;
     const int rs_minus2 = rowstride - 2;
 
@@ -1353,6 +1383,8 @@ void svlImageProcessingHelper::ResampleAndInterpolateVMono8(unsigned char* src,
                                                             unsigned char* dst, const unsigned int dstheight,
                                                             const unsigned int width)
 {
+    if (svlImageProcessingSIMD::ResampleAndInterpolateV(src, srcheight, dst, dstheight, width)) return;
+
     unsigned int i, j;
     unsigned int y1, y2;
     int wy1, wy2;
@@ -1489,6 +1521,8 @@ void svlImageProcessingHelper::ResampleAndInterpolateVRGB24(unsigned char* src,
                                                             unsigned char* dst, const unsigned int dstheight,
                                                             const unsigned int width)
 {
+    if (svlImageProcessingSIMD::ResampleAndInterpolateV(src, srcheight, dst, dstheight, width * 3)) return;
+
     unsigned int i, j;
     unsigned int y1, y2;
     int wy1, wy2;
@@ -1541,6 +1575,8 @@ void svlImageProcessingHelper::ResampleAndInterpolateVRGB24(unsigned char* src,
 
 void svlImageProcessingHelper::DeinterlaceBlending(unsigned char* buffer, const unsigned int width, const unsigned int height)
 {
+    if (svlImageProcessingSIMD::DeinterlaceBlending(buffer, width, height)) return;
+
     unsigned int i, j;
     int ar, ag, ab;
     unsigned char *r0, *g0, *b0;
@@ -1555,7 +1591,7 @@ void svlImageProcessingHelper::DeinterlaceBlending(unsigned char* buffer, const
     g1 = r1 + 1;
     b1 = g1 + 1;
     
-    for (j = 0; j < height; j += 2) {
+    for (j = 0; j + 1 < height; j += 2) {
         for (i = 0; i < width; i ++) {
             ar = (*r0 + *r1) >> 1; ag = (*g0 + *g1) >> 1; ab = (*b0 + *b1) >> 1;
             *r0 = ar; *g0 = ag; *b0 = ab;
@@ -1598,6 +1634,8 @@ void svlImageProcessingHelper::DeinterlaceDiscarding(unsigned char* buffer, cons
 
 void svlImageProcessingHelper::DeinterlaceAdaptiveBlending(unsigned char* buffer, const unsigned int width, const unsigned int height)
 {
+    if (svlImageProcessingSIMD::DeinterlaceAdaptiveBlending(buffer, width, height)) return;
+
     unsigned int i, j;
     int ar, ag, ab;
     unsigned int diff, diffinv;
@@ -1618,7 +1656,11 @@ void svlImageProcessingHelper::DeinterlaceAdaptiveBlending(unsigned char* buffer
     g2 = r2 + 1;
     b2 = g2 + 1;
     
-    for (j = 0; j < height; j += 2) {
+    for (j = 0; j + 1 < height; j += 2) {
+        // The last odd row has no even row below it: use the one above
+        if (j + 2 >= height) {
+            r2 = r0; g2 = g0; b2 = b0;
+        }
         for (i = 0; i < width; i ++) {
             ar = (*r0 + *r2) >> 1; ag = (*g0 + *g2) >> 1; ab = (*b0 + *b2) >> 1;
             
@@ -0,0 +1,1349 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include "svlImageProcessingSIMD.h"
+#include <string.h>
+#include <vector>
+
+// SSE2 is part of every x86-64 processor; on 32 bits x86 it is only
+// used when the compiler is allowed to emit it.  AVX2 functions are
+// compiled for their own target and only called after a CPUID check.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SVL_SIMD_HAS_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))))
+        #define SVL_SIMD_HAS_AVX2 1
+        #define SVL_SIMD_AVX2_FUNCTION __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #elif defined(_MSC_VER) && (_MSC_VER >= 1800)
+        #define SVL_SIMD_HAS_AVX2 1
+        #define SVL_SIMD_AVX2_FUNCTION
+        #include <immintrin.h>
+        #include <intrin.h>
+    #endif
+#endif
+
+
+/***************************************/
+/*** Instruction set detection       ***/
+/***************************************/
+
+static svlImageProcessing::SIMD_Level svlImageProcessingSIMDDetect()
+{
+#if SVL_SIMD_HAS_AVX2
+  #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        // AVX registers have to be enabled by the operating system (OSXSAVE)
+        if ((info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6)) {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5)) return svlImageProcessing::SIMD_AVX2;
+        }
+    }
+  #else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return svlImageProcessing::SIMD_AVX2;
+  #endif
+#endif
+#if SVL_SIMD_HAS_SSE2
+    return svlImageProcessing::SIMD_SSE2;
+#else
+    return svlImageProcessing::SIMD_None;
+#endif
+}
+
+static const svlImageProcessing::SIMD_Level svlImageProcessingSIMDSupported = svlImageProcessingSIMDDetect();
+static svlImageProcessing::SIMD_Level svlImageProcessingSIMDActive = svlImageProcessingSIMDSupported;
+
+
+svlImageProcessing::SIMD_Level svlImageProcessing::GetSupportedSIMDLevel()
+{
+    return svlImageProcessingSIMDSupported;
+}
+
+svlImageProcessing::SIMD_Level svlImageProcessing::GetSIMDLevel()
+{
+    return svlImageProcessingSIMDActive;
+}
+
+svlImageProcessing::SIMD_Level svlImageProcessing::SetSIMDLevel(SIMD_Level level)
+{
+    if (level > svlImageProcessingSIMDSupported) level = svlImageProcessingSIMDSupported;
+    svlImageProcessingSIMDActive = level;
+    return level;
+}
+
+svlImageProcessing::SIMD_Level svlImageProcessingSIMD::Level()
+{
+    return svlImageProcessingSIMDActive;
+}
+
+
+#if SVL_SIMD_HAS_SSE2
+
+/***************************************/
+/*** Convolution                     ***/
+/***************************************/
+
+// Two 16 bits kernel values packed for _mm_madd_epi16
+static inline int svlSIMDPair(const int low, const int high)
+{
+    return static_cast<int>((static_cast<unsigned int>(low) & 0xFFFFu) | (static_cast<unsigned int>(high) << 16));
+}
+
+static inline unsigned char svlSIMDConvolutionClamp(int sum, bool absres)
+{
+    sum >>= 10;
+    if (absres) {
+        if (sum < 0) sum = -sum;
+        if (sum > 255) sum = 255;
+    }
+    else {
+        if (sum < 0) sum = 0; else if (sum > 255) sum = 255;
+    }
+    return static_cast<unsigned char>(sum);
+}
+
+// Scalar convolution of a single pixel with the kernel clipped at the
+// image borders, same as the reference implementation
+static void svlSIMDConvolutionPixel(const unsigned char* input, unsigned char* output,
+                                    const int width, const int height, const int channels,
+                                    const int* kernel, const int kernel_width, const int kernel_height,
+                                    const int i, const int j, bool absres)
+{
+    const int rowstride = width * channels;
+    const int k_base = i - kernel_width / 2;
+    const int l_base = j - kernel_height / 2;
+    const int k_from = (k_base < 0) ? 0 : k_base;
+    const int l_from = (l_base < 0) ? 0 : l_base;
+    const int k_to = (k_base + kernel_width > width) ? width : k_base + kernel_width;
+    const int l_to = (l_base + kernel_height > height) ? height : l_base + kernel_height;
+    int c, k, l, sum;
+
+    for (c = 0; c < channels; c ++) {
+        sum = 0;
+        for (l = l_from; l < l_to; l ++) {
+            const int* kernelrow = kernel + (l - l_base) * kernel_width - k_base;
+            const unsigned char* inputrow = input + l * rowstride + c;
+            for (k = k_from; k < k_to; k ++) {
+                sum += kernelrow[k] * inputrow[k * channels];
+            }
+        }
+        output[j * rowstride + i * channels + c] = svlSIMDConvolutionClamp(sum, absres);
+    }
+}
+
+// Shift, absolute value or clamping and saturation of 16 results
+static inline __m128i svlSIMDConvolutionPackSSE2(__m128i acc0, __m128i acc1, __m128i acc2, __m128i acc3, bool absres)
+{
+    acc0 = _mm_srai_epi32(acc0, 10);
+    acc1 = _mm_srai_epi32(acc1, 10);
+    acc2 = _mm_srai_epi32(acc2, 10);
+    acc3 = _mm_srai_epi32(acc3, 10);
+    if (absres) {
+        __m128i sign;
+        sign = _mm_srai_epi32(acc0, 31); acc0 = _mm_sub_epi32(_mm_xor_si128(acc0, sign), sign);
+        sign = _mm_srai_epi32(acc1, 31); acc1 = _mm_sub_epi32(_mm_xor_si128(acc1, sign), sign);
+        sign = _mm_srai_epi32(acc2, 31); acc2 = _mm_sub_epi32(_mm_xor_si128(acc2, sign), sign);
+        sign = _mm_srai_epi32(acc3, 31); acc3 = _mm_sub_epi32(_mm_xor_si128(acc3, sign), sign);
+    }
+    // Signed saturation to 16 bits followed by unsigned saturation to
+    // 8 bits clamps to [0, 255]
+    return _mm_packus_epi16(_mm_packs_epi32(acc0, acc1), _mm_packs_epi32(acc2, acc3));
+}
+
+// output[x] = sum(kernel[t] * taps[t][x]), taps grouped in pairs
+static void svlSIMDSumOfProductsSSE2(const unsigned char* const* taps, const int* pairs, const int paircount,
+                                     unsigned char* output, const int length, bool absres)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0, acc1, acc2, acc3, k, a, b, lo, hi;
+    int x = 0, p;
+
+    while (x < length) {
+        // The last block overlaps the previous one
+        if (x > length - 16) x = length - 16;
+
+        acc0 = acc1 = acc2 = acc3 = zero;
+        for (p = 0; p < paircount; p ++) {
+            k = _mm_set1_epi32(pairs[p]);
+            a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps[p * 2] + x));
+            b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps[p * 2 + 1] + x));
+            lo = _mm_unpacklo_epi8(a, b);
+            hi = _mm_unpackhi_epi8(a, b);
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), k));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), k));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), k));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), k));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x),
+                         svlSIMDConvolutionPackSSE2(acc0, acc1, acc2, acc3, absres));
+        x += 16;
+    }
+}
+
+#if SVL_SIMD_HAS_AVX2
+
+SVL_SIMD_AVX2_FUNCTION
+static void svlSIMDSumOfProductsAVX2(const unsigned char* const* taps, const int* pairs, const int paircount,
+                                     unsigned char* output, const int length, bool absres)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0, acc1, acc2, acc3, k, a, b, lo, hi, sign;
+    int x = 0, p;
+
+    while (x < length) {
+        if (x > length - 32) x = length - 32;
+
+        acc0 = acc1 = acc2 = acc3 = zero;
+        for (p = 0; p < paircount; p ++) {
+            k = _mm256_set1_epi32(pairs[p]);
+            a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(taps[p * 2] + x));
+            b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(taps[p * 2 + 1] + x));
+            lo = _mm256_unpacklo_epi8(a, b);
+            hi = _mm256_unpackhi_epi8(a, b);
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), k));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), k));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), k));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), k));
+        }
+
+        acc0 = _mm256_srai_epi32(acc0, 10);
+        acc1 = _mm256_srai_epi32(acc1, 10);
+        acc2 = _mm256_srai_epi32(acc2, 10);
+        acc3 = _mm256_srai_epi32(acc3, 10);
+        if (absres) {
+            sign = _mm256_srai_epi32(acc0, 31); acc0 = _mm256_sub_epi32(_mm256_xor_si256(acc0, sign), sign);
+            sign = _mm256_srai_epi32(acc1, 31); acc1 = _mm256_sub_epi32(_mm256_xor_si256(acc1, sign), sign);
+            sign = _mm256_srai_epi32(acc2, 31); acc2 = _mm256_sub_epi32(_mm256_xor_si256(acc2, sign), sign);
+            sign = _mm256_srai_epi32(acc3, 31); acc3 = _mm256_sub_epi32(_mm256_xor_si256(acc3, sign), sign);
+        }
+        // Unpacking and packing both work within 128 bits lanes, so
+        // the results come back in order without a permutation
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + x),
+                            _mm256_packus_epi16(_mm256_packs_epi32(acc0, acc1), _mm256_packs_epi32(acc2, acc3)));
+        x += 32;
+    }
+}
+
+#endif // SVL_SIMD_HAS_AVX2
+
+bool svlImageProcessingSIMD::ConvolutionUChar(const unsigned char* input, unsigned char* output,
+                                              const int width, const int height, const int channels,
+                                              const int* kernel, const int kernel_width, const int kernel_height,
+                                              bool absres)
+{
+    const svlImageProcessing::SIMD_Level level = Level();
+    if (level == svlImageProcessing::SIMD_None ||
+        !input || !output || input == output || !kernel || kernel_width < 1 || kernel_height < 1) return false;
+
+    // Interior pixels are the ones whose kernel is not clipped horizontally
+    const int blocksize = (level == svlImageProcessing::SIMD_AVX2) ? 32 : 16;
+    const int kernel_h_rad = kernel_width / 2;
+    const int kernel_v_rad = kernel_height / 2;
+    const int first = kernel_h_rad;
+    const int last = width - kernel_width + kernel_h_rad;
+    const int length = (last - first + 1) * channels;
+    const int rowstride = width * channels;
+    if (length < blocksize) return false;
+
+    const int kernel_size = kernel_width * kernel_height;
+    int i, j, k, l, l_from, l_to, count;
+    for (k = 0; k < kernel_size; k ++) {
+        if (kernel[k] < -32768 || kernel[k] > 32767) return false;
+    }
+
+    std::vector<const unsigned char*> taps(kernel_size + 1);
+    std::vector<int> weights(kernel_size + 1);
+    std::vector<int> pairs(kernel_size / 2 + 1);
+
+    for (j = 0; j < height; j ++) {
+
+        // Kernel rows are clipped at the top and bottom of the image
+        l_from = j - kernel_v_rad;
+        l_to = l_from + kernel_height;
+        if (l_from < 0) l_from = 0;
+        if (l_to > height) l_to = height;
+
+        count = 0;
+        for (l = l_from; l < l_to; l ++) {
+            const int* kernelrow = kernel + (l - j + kernel_v_rad) * kernel_width;
+            const unsigned char* inputrow = input + l * rowstride;
+            for (k = 0; k < kernel_width; k ++) {
+                taps[count] = inputrow + k * channels;
+                weights[count] = kernelrow[k];
+                count ++;
+            }
+        }
+        if (count & 1) {
+            taps[count] = taps[0];
+            weights[count] = 0;
+            count ++;
+        }
+        for (k = 0; k < count; k += 2) {
+            pairs[k / 2] = svlSIMDPair(weights[k], weights[k + 1]);
+        }
+
+#if SVL_SIMD_HAS_AVX2
+        if (level == svlImageProcessing::SIMD_AVX2) {
+            svlSIMDSumOfProductsAVX2(&(taps[0]), &(pairs[0]), count / 2,
+                                     output + j * rowstride + first * channels, length, absres);
+        }
+        else
+#endif
+        {
+            svlSIMDSumOfProductsSSE2(&(taps[0]), &(pairs[0]), count / 2,
+                                     output + j * rowstride + first * channels, length, absres);
+        }
+
+        for (i = 0; i < first; i ++) {
+            svlSIMDConvolutionPixel(input, output, width, height, channels,
+                                    kernel, kernel_width, kernel_height, i, j, absres);
+        }
+        for (i = last + 1; i < width; i ++) {
+            svlSIMDConvolutionPixel(input, output, width, height, channels,
+                                    kernel, kernel_width, kernel_height, i, j, absres);
+        }
+    }
+
+    return true;
+}
+
+
+/***************************************/
+/*** Resampling                      ***/
+/***************************************/
+
+// dst[x] = (w1 * prev[x] + w2 * curr[x]) >> 8, with w1 + w2 == 256;
+// the weighted sum fits in 16 bits unsigned.
+static void svlSIMDBlendRowsSSE2(const unsigned char* prev, const unsigned char* curr, unsigned char* dst,
+                                 const int w1, const int w2, const unsigned int length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weight1 = _mm_set1_epi16(static_cast<short>(w1));
+    const __m128i weight2 = _mm_set1_epi16(static_cast<short>(w2));
+    __m128i a, b, lo, hi;
+    unsigned int x = 0;
+
+    while (x < length) {
+        if (x > length - 16) x = length - 16;
+
+        a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + x));
+        b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(curr + x));
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), weight1),
+                           _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weight2));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), weight1),
+                           _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weight2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),
+                         _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+        x += 16;
+    }
+}
+
+bool svlImageProcessingSIMD::ResampleAndInterpolateV(const unsigned char* src, const unsigned int srcheight,
+                                                     unsigned char* dst, const unsigned int dstheight,
+                                                     const unsigned int rowsize)
+{
+    if (Level() == svlImageProcessing::SIMD_None ||
+        !src || !dst || src == dst || dstheight < 1 || rowsize < 16) return false;
+
+    // The reference walks each column separately, but the source rows
+    // and the weights only depend on the destination row
+    const unsigned int fast_dstheight = 256;   // 2^8
+    const unsigned int fast_srcheight = fast_dstheight * srcheight / dstheight;
+    unsigned int i, y1 = 0, y2 = 128;
+    unsigned int prev = 0, curr = 0, next = 0;
+    int wy1 = 0, wy2 = fast_dstheight;
+
+    for (i = 0; i < dstheight; i ++) {
+        svlSIMDBlendRowsSSE2(src + prev * rowsize, src + curr * rowsize, dst + i * rowsize, wy1, wy2, rowsize);
+
+        y1 += fast_srcheight;
+        while (y1 > y2) {
+            y2 += fast_dstheight;
+            prev = curr;
+            curr = next;
+            next ++;
+        }
+
+        wy1 = y2 - y1;
+        wy2 = fast_dstheight - wy1;
+    }
+
+    return true;
+}
+
+
+/***************************************/
+/*** Unsharp masking                 ***/
+/***************************************/
+
+// sums[x] += row[x] (add) or sums[x] -= row[x]
+static void svlSIMDAccumulateRowSSE2(unsigned short* sums, const unsigned char* row, const int length, bool add)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a, lo, hi;
+    int x;
+
+    for (x = 0; x + 16 <= length; x += 16) {
+        a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + x));
+        hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + x + 8));
+        if (add) {
+            lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(a, zero));
+            hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(a, zero));
+        }
+        else {
+            lo = _mm_sub_epi16(lo, _mm_unpacklo_epi8(a, zero));
+            hi = _mm_sub_epi16(hi, _mm_unpackhi_epi8(a, zero));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + x), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + x + 8), hi);
+    }
+    for (; x < length; x ++) {
+        if (add) sums[x] = static_cast<unsigned short>(sums[x] + row[x]);
+        else sums[x] = static_cast<unsigned short>(sums[x] - row[x]);
+    }
+}
+
+bool svlImageProcessingSIMD::UnsharpMaskBlurRGB(const unsigned char* img_in, unsigned char* img_out,
+                                                const int width, const int height, int radius)
+{
+    // Column sums of up to 257 rows fit in 16 bits
+    if (Level() == svlImageProcessing::SIMD_None ||
+        !img_in || !img_out || img_in == img_out ||
+        radius < 0 || radius > 128 || radius >= width || height < 1) return false;
+
+    // The box filter is separable: the vector part keeps the sums of
+    // each column over the rows of the window up to date, the scalar
+    // part slides the window horizontally over these column sums.  The
+    // divider is still the number of pixels in the clipped window.
+    const int rowstride = width * 3;
+    std::vector<unsigned short> colsums(rowstride, 0);
+    const unsigned short* colsum = &(colsums[0]);
+    int i, j, l, rows, cols, divider;
+    int sum_r, sum_g, sum_b;
+    unsigned char* output;
+
+    for (l = 0; l <= radius && l < height; l ++) {
+        svlSIMDAccumulateRowSSE2(&(colsums[0]), img_in + l * rowstride, rowstride, true);
+    }
+
+    for (j = 0; j < height; j ++) {
+
+        if (j > 0) {
+            if (j + radius < height) {
+                svlSIMDAccumulateRowSSE2(&(colsums[0]), img_in + (j + radius) * rowstride, rowstride, true);
+            }
+            if (j - radius - 1 >= 0) {
+                svlSIMDAccumulateRowSSE2(&(colsums[0]), img_in + (j - radius - 1) * rowstride, rowstride, false);
+            }
+        }
+        rows = ((j + radius < height) ? (j + radius) : (height - 1)) - ((j - radius > 0) ? (j - radius) : 0) + 1;
+
+        sum_r = sum_g = sum_b = 0;
+        for (i = 0; i <= radius; i ++) {
+            sum_r += colsum[i * 3];
+            sum_g += colsum[i * 3 + 1];
+            sum_b += colsum[i * 3 + 2];
+        }
+        cols = radius + 1;
+
+        output = img_out + j * rowstride;
+        divider = rows * cols;
+        output[0] = static_cast<unsigned char>(sum_r / divider);
+        output[1] = static_cast<unsigned char>(sum_g / divider);
+        output[2] = static_cast<unsigned char>(sum_b / divider);
+        output += 3;
+
+        for (i = 1; i < width; i ++) {
+            l = i - radius - 1;
+            if (l >= 0) {
+                sum_r -= colsum[l * 3];
+                sum_g -= colsum[l * 3 + 1];
+                sum_b -= colsum[l * 3 + 2];
+                cols --;
+            }
+            l = i + radius;
+            if (l < width) {
+                sum_r += colsum[l * 3];
+                sum_g += colsum[l * 3 + 1];
+                sum_b += colsum[l * 3 + 2];
+                cols ++;
+            }
+
+            divider = rows * cols;
+            output[0] = static_cast<unsigned char>(sum_r / divider);
+            output[1] = static_cast<unsigned char>(sum_g / divider);
+            output[2] = static_cast<unsigned char>(sum_b / divider);
+            output += 3;
+        }
+    }
+
+    return true;
+}
+
+
+/***************************************/
+/*** Deinterlacing                   ***/
+/***************************************/
+
+bool svlImageProcessingSIMD::DeinterlaceBlending(unsigned char* buffer, const unsigned int width, const unsigned int height)
+{
+    const unsigned int rowsize = width * 3;
+    if (Level() == svlImageProcessing::SIMD_None || !buffer || rowsize < 16) return false;
+
+    const __m128i one = _mm_set1_epi8(1);
+    unsigned char *row0, *row1;
+    unsigned int j, x;
+    __m128i a, b, avg;
+
+    for (j = 0; j + 1 < height; j += 2) {
+        row0 = buffer + j * rowsize;
+        row1 = row0 + rowsize;
+        x = 0;
+        while (x < rowsize) {
+            // Both rows hold the average after the first pass, so
+            // processing the overlapping last block again is harmless
+            if (x > rowsize - 16) x = rowsize - 16;
+            a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x));
+            b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x));
+            // _mm_avg_epu8 rounds up, (a + b) >> 1 rounds down
+            avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row0 + x), avg);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row1 + x), avg);
+            x += 16;
+        }
+    }
+
+    return true;
+}
+
+static inline void svlSIMDDeinterlaceAdaptivePixel(const unsigned char* p0, unsigned char* p1, const unsigned char* p2)
+{
+    int ar, ag, ab;
+    unsigned int diff, diffinv;
+
+    ar = (p0[0] + p2[0]) >> 1; ag = (p0[1] + p2[1]) >> 1; ab = (p0[2] + p2[2]) >> 1;
+    ar -= p1[0]; if (ar < 0) ar = -ar;
+    ag -= p1[1]; if (ag < 0) ag = -ag;
+    ab -= p1[2]; if (ab < 0) ab = -ab;
+    diff = (ar + ag + ab) << 2;
+    if (diff > 765) diff = 765;
+    diffinv = 765 - diff;
+    p1[0] = static_cast<unsigned char>((diff * ar + diffinv * p1[0]) / 765);
+    p1[1] = static_cast<unsigned char>((diff * ag + diffinv * p1[1]) / 765);
+    p1[2] = static_cast<unsigned char>((diff * ab + diffinv * p1[2]) / 765);
+}
+
+// Lanes of the 24 lanes vector (prev, curr, next) moved by one or two
+// lanes towards the end (value at x is taken from x - n) or towards
+// the beginning (value at x is taken from x + n) of curr
+#define SVL_SIMD_LANES_FROM_PREV(prev, curr, n) _mm_or_si128(_mm_slli_si128(curr, 2 * n), _mm_srli_si128(prev, 16 - 2 * n))
+#define SVL_SIMD_LANES_FROM_NEXT(curr, next, n) _mm_or_si128(_mm_srli_si128(curr, 2 * n), _mm_slli_si128(next, 16 - 2 * n))
+
+// Adaptive blending of 8 RGB pixels (24 bytes) held in three vectors
+// of 16 bits lanes.  Lane x belongs to the color channel x % 3.
+static void svlSIMDDeinterlaceAdaptive8SSE2(const unsigned char* p0, unsigned char* p1, const unsigned char* p2,
+                                            const __m128i* phasemasks)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i limit = _mm_set1_epi16(765);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 scale = _mm_set1_ps(1.0f / 765.0f);
+    __m128i a0[3], a1[3], a2[3], d[5], res[3];
+    __m128i v0, v1, v2, prev1, prev2, next1, next2, left, center, right, sum, diff, diffinv, num_lo, num_hi;
+    int r;
+
+    v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p0));
+    v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p1));
+    v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p2));
+    a0[0] = _mm_unpacklo_epi8(v0, zero); a0[1] = _mm_unpackhi_epi8(v0, zero);
+    a1[0] = _mm_unpacklo_epi8(v1, zero); a1[1] = _mm_unpackhi_epi8(v1, zero);
+    a2[0] = _mm_unpacklo_epi8(v2, zero); a2[1] = _mm_unpackhi_epi8(v2, zero);
+    a0[2] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p0 + 16)), zero);
+    a1[2] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p1 + 16)), zero);
+    a2[2] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p2 + 16)), zero);
+
+    // |(a0 + a2) / 2 - a1| for each channel, d[0] and d[4] are padding
+    d[0] = d[4] = zero;
+    for (r = 0; r < 3; r ++) {
+        d[r + 1] = _mm_sub_epi16(_mm_srli_epi16(_mm_add_epi16(a0[r], a2[r]), 1), a1[r]);
+        d[r + 1] = _mm_max_epi16(d[r + 1], _mm_sub_epi16(zero, d[r + 1]));
+    }
+
+    for (r = 0; r < 3; r ++) {
+        // The sum over the three channels of a pixel starts at lane x
+        // for the red channel, x - 1 for green and x - 2 for blue
+        prev1 = SVL_SIMD_LANES_FROM_PREV(d[r], d[r + 1], 1);
+        prev2 = SVL_SIMD_LANES_FROM_PREV(d[r], d[r + 1], 2);
+        next1 = SVL_SIMD_LANES_FROM_NEXT(d[r + 1], d[r + 2], 1);
+        next2 = SVL_SIMD_LANES_FROM_NEXT(d[r + 1], d[r + 2], 2);
+        center = _mm_add_epi16(_mm_add_epi16(prev1, d[r + 1]), next1);
+        left = _mm_add_epi16(_mm_add_epi16(prev2, prev1), d[r + 1]);
+        right = _mm_add_epi16(_mm_add_epi16(d[r + 1], next1), next2);
+        sum = _mm_or_si128(_mm_or_si128(_mm_and_si128(right, phasemasks[r * 3]),
+                                        _mm_and_si128(center, phasemasks[r * 3 + 1])),
+                           _mm_and_si128(left, phasemasks[r * 3 + 2]));
+
+        diff = _mm_min_epi16(_mm_slli_epi16(sum, 2), limit);
+        diffinv = _mm_sub_epi16(limit, diff);
+        num_lo = _mm_madd_epi16(_mm_unpacklo_epi16(diff, diffinv), _mm_unpacklo_epi16(d[r + 1], a1[r]));
+        num_hi = _mm_madd_epi16(_mm_unpackhi_epi16(diff, diffinv), _mm_unpackhi_epi16(d[r + 1], a1[r]));
+
+        // Numerators are below 2^18: in single precision, adding one
+        // half before scaling yields floor(num / 765) exactly
+        num_lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(num_lo), half), scale));
+        num_hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(num_hi), half), scale));
+        res[r] = _mm_packs_epi32(num_lo, num_hi);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p1), _mm_packus_epi16(res[0], res[1]));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p1 + 16), _mm_packus_epi16(res[2], res[2]));
+}
+
+bool svlImageProcessingSIMD::DeinterlaceAdaptiveBlending(unsigned char* buffer, const unsigned int width, const unsigned int height)
+{
+    if (Level() == svlImageProcessing::SIMD_None || !buffer || width < 8) return false;
+
+    const unsigned int rowsize = width * 3;
+    const unsigned int blocks = width / 8;
+    unsigned char *row0, *row1, *row2;
+    unsigned int i, j, r, lane;
+
+    short phases[72];
+    __m128i phasemasks[9];
+    for (r = 0; r < 3; r ++) {
+        for (lane = 0; lane < 8; lane ++) {
+            for (i = 0; i < 3; i ++) {
+                phases[(r * 3 + i) * 8 + lane] = ((r * 8 + lane) % 3 == i) ? -1 : 0;
+            }
+        }
+    }
+    for (i = 0; i < 9; i ++) {
+        phasemasks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(phases + i * 8));
+    }
+
+    for (j = 0; j + 1 < height; j += 2) {
+        row0 = buffer + j * rowsize;
+        row1 = row0 + rowsize;
+        row2 = (j + 2 < height) ? row1 + rowsize : row0;
+
+        for (i = 0; i < blocks; i ++) {
+            svlSIMDDeinterlaceAdaptive8SSE2(row0 + i * 24, row1 + i * 24, row2 + i * 24, phasemasks);
+        }
+        for (i = blocks * 8; i < width; i ++) {
+            svlSIMDDeinterlaceAdaptivePixel(row0 + i * 3, row1 + i * 3, row2 + i * 3);
+        }
+    }
+
+    return true;
+}
+
+
+/***************************************/
+/*** Color space conversion          ***/
+/***************************************/
+
+// Loads 4 RGB pixels (12 bytes) as 4 32 bits lanes: c0 | c1 << 8 | c2 << 16
+static inline __m128i svlSIMDLoadPixels4(const unsigned char* input)
+{
+    int tail;
+    memcpy(&tail, input + 8, 4);
+    const __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)),
+                                         _mm_cvtsi32_si128(tail));
+    const __m128i mask = _mm_set1_epi32(0x00FFFFFF);
+    return _mm_and_si128(_mm_unpacklo_epi64(_mm_unpacklo_epi32(v, _mm_srli_si128(v, 3)),
+                                            _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9))),
+                         mask);
+}
+
+// Stores 4 pixels given as bytes c0[0..3], c1[0..3], c2[0..3]
+static inline void svlSIMDStorePixels4(unsigned char* output, const __m128i planar)
+{
+    const __m128i c01 = _mm_unpacklo_epi8(planar, _mm_srli_si128(planar, 4));
+    const __m128i c2 = _mm_unpacklo_epi8(_mm_srli_si128(planar, 8), _mm_setzero_si128());
+    // One pixel per 32 bits lane, then two pixels (6 bytes) per 64 bits
+    // lane and finally 12 contiguous bytes
+    const __m128i words = _mm_unpacklo_epi16(c01, c2);
+    const __m128i pairs = _mm_or_si128(_mm_and_si128(words, _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF)),
+                                       _mm_srli_epi64(_mm_and_si128(words, _mm_set_epi32(0x00FFFFFF, 0, 0x00FFFFFF, 0)), 8));
+    const __m128i packed = _mm_or_si128(_mm_and_si128(pairs, _mm_set_epi32(0, 0, 0x0000FFFF, -1)),
+                                        _mm_and_si128(_mm_srli_si128(pairs, 2), _mm_set_epi32(0, -1, static_cast<int>(0xFFFF0000), 0)));
+    // Only 12 bytes are written: output may alias the next input pixels
+    const int tail = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output), packed);
+    memcpy(output + 8, &tail, 4);
+}
+
+unsigned int svlImageProcessingSIMD::RGB24toYUV444(const unsigned char* input, unsigned char* output, const unsigned int pixelcount,
+                                                   bool ch1, bool ch2, bool ch3)
+{
+    if (Level() == svlImageProcessing::SIMD_None || !input || !output) return 0;
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i y_rg = _mm_set1_epi32(svlSIMDPair(2104, 4130));
+    const __m128i u_rg = _mm_set1_epi32(svlSIMDPair(-1214, -2384));
+    const __m128i v_rg = _mm_set1_epi32(svlSIMDPair(3598, -3013));
+    const __m128i y_b = _mm_set1_epi32(802);
+    const __m128i u_b = _mm_set1_epi32(3598);
+    const __m128i v_b = _mm_set1_epi32(svlSIMDPair(-585, 0));
+    const __m128i y_offset = _mm_set1_epi32(4096 + 131072);
+    const __m128i uv_offset = _mm_set1_epi32(4096 + 1048576);
+    const __m128i yu_limit = _mm_setr_epi16(235, 235, 235, 235, 240, 240, 240, 240);
+    const __m128i v_limit = _mm_set1_epi16(240);
+    const __m128i channels = _mm_setr_epi32(ch1 ? -1 : 0, ch2 ? -1 : 0, ch3 ? -1 : 0, 0);
+    __m128i w, r, g, b, rg, y, u, v;
+    unsigned int i;
+
+    for (i = 0; i + 4 <= pixelcount; i += 4) {
+        w = svlSIMDLoadPixels4(input);
+        r = _mm_and_si128(w, mask);
+        g = _mm_and_si128(_mm_srli_epi32(w, 8), mask);
+        b = _mm_srli_epi32(w, 16);
+        rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+
+        // The sums are positive for any 8 bits input, the absolute
+        // values taken by the reference have no effect
+        y = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, y_rg), _mm_madd_epi16(b, y_b)), y_offset), 13);
+        u = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, u_rg), _mm_madd_epi16(b, u_b)), uv_offset), 13);
+        v = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rg, v_rg), _mm_madd_epi16(b, v_b)), uv_offset), 13);
+
+        svlSIMDStorePixels4(output,
+                            _mm_and_si128(_mm_packus_epi16(_mm_min_epi16(_mm_packs_epi32(y, u), yu_limit),
+                                                           _mm_min_epi16(_mm_packs_epi32(v, zero), v_limit)),
+                                          channels));
+        input += 12;
+        output += 12;
+    }
+
+    return i;
+}
+
+unsigned int svlImageProcessingSIMD::YUV444toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount,
+                                                   bool ch1, bool ch2, bool ch3)
+{
+    // Disabled channels are left untouched by the reference
+    if (Level() == svlImageProcessing::SIMD_None || !input || !output || !ch1 || !ch2 || !ch3) return 0;
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i low = _mm_set1_epi32(0xFFFF);
+    const __m128i y_offset = _mm_set1_epi32(16);
+    const __m128i uv_offset = _mm_set1_epi32(128);
+    const __m128i r_yv = _mm_set1_epi32(svlSIMDPair(9535, 13074));
+    const __m128i g_yv = _mm_set1_epi32(svlSIMDPair(9535, -6660));
+    const __m128i g_u = _mm_set1_epi32(svlSIMDPair(-3203, 0));
+    const __m128i b_yu = _mm_set1_epi32(svlSIMDPair(9535, 16531));
+    __m128i w, y, u, v, yv, yu, r, g, b;
+    unsigned int i;
+
+    for (i = 0; i + 4 <= pixelcount; i += 4) {
+        w = svlSIMDLoadPixels4(input);
+        y = _mm_and_si128(_mm_sub_epi32(_mm_and_si128(w, mask), y_offset), low);
+        u = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(w, 8), mask), uv_offset);
+        v = _mm_sub_epi32(_mm_srli_epi32(w, 16), uv_offset);
+        yv = _mm_or_si128(y, _mm_slli_epi32(v, 16));
+        yu = _mm_or_si128(y, _mm_slli_epi32(u, 16));
+
+        r = _mm_srai_epi32(_mm_madd_epi16(yv, r_yv), 13);
+        g = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(yv, g_yv), _mm_madd_epi16(_mm_and_si128(u, low), g_u)), 13);
+        b = _mm_srai_epi32(_mm_madd_epi16(yu, b_yu), 13);
+
+        svlSIMDStorePixels4(output, _mm_packus_epi16(_mm_packs_epi32(r, g), _mm_packs_epi32(b, zero)));
+        input += 12;
+        output += 12;
+    }
+
+    return i;
+}
+
+
+/***************************************/
+/*** Stereo block matching scores    ***/
+/***************************************/
+
+// The scores are sums of absolute differences divided by the block
+// size and truncated: min(sad, truncation * blocksize) fits in 15 bits
+// and, for 2 <= blocksize <= 16, its quotient is exactly
+// (value * ceil(2^16 / blocksize)) >> 16, i.e. a single _mm_mulhi_epu16.
+#define SVL_SIMD_STEREO_MAX_BLOCKSIZE   16
+
+static inline bool svlSIMDStereoScoreParams(const int blocksize, const int truncation, int& limit, int& multiplier)
+{
+    if (blocksize < 1 || blocksize > SVL_SIMD_STEREO_MAX_BLOCKSIZE ||
+        truncation < 0 || truncation > 255) return false;
+    limit = truncation * blocksize;
+    multiplier = (65536 + blocksize - 1) / blocksize;
+    return true;
+}
+
+// Scores of 16 consecutive disparities, as 16 bits sums in acc0 and acc1
+static inline void svlSIMDStereoStoreScoresSSE2(__m128i acc0, __m128i acc1, const __m128i limit, const __m128i multiplier,
+                                                const bool divide, int* scores)
+{
+    const __m128i zero = _mm_setzero_si128();
+    acc0 = _mm_min_epi16(acc0, limit);
+    acc1 = _mm_min_epi16(acc1, limit);
+    if (divide) {
+        acc0 = _mm_mulhi_epu16(acc0, multiplier);
+        acc1 = _mm_mulhi_epu16(acc1, multiplier);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(scores),      _mm_unpacklo_epi16(acc0, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(scores + 4),  _mm_unpackhi_epi16(acc0, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(scores + 8),  _mm_unpacklo_epi16(acc1, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(scores + 12), _mm_unpackhi_epi16(acc1, zero));
+}
+
+static void svlSIMDStereoScoresRGBSSE2(const unsigned char* right, const unsigned char* const* taps, const int blockbytes,
+                                       const int from, const int to, const int limit, const int multiplier, const bool divide,
+                                       int* scores)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lim = _mm_set1_epi16(static_cast<short>(limit));
+    const __m128i mul = _mm_set1_epi16(static_cast<short>(multiplier));
+    __m128i acc0, acc1, r, l, ad;
+    int d = from, m;
+
+    while (d < to) {
+        if (d > to - 16) d = to - 16;
+
+        acc0 = acc1 = zero;
+        for (m = 0; m < blockbytes; m ++) {
+            r = _mm_set1_epi8(static_cast<char>(right[m]));
+            l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps[m] + d));
+            ad = _mm_or_si128(_mm_subs_epu8(l, r), _mm_subs_epu8(r, l));
+            acc0 = _mm_add_epi16(acc0, _mm_unpacklo_epi8(ad, zero));
+            acc1 = _mm_add_epi16(acc1, _mm_unpackhi_epi8(ad, zero));
+        }
+        svlSIMDStereoStoreScoresSSE2(acc0, acc1, lim, mul, divide, scores + d);
+        d += 16;
+    }
+}
+
+// Scores of 8 consecutive disparities, as 32 bits sums in acc0 and acc1
+static void svlSIMDStereoScoresMonoSSE2(const int* right, const int* left, const int blocksize,
+                                        const int from, const int to, const int limit, const int multiplier, const bool divide,
+                                        int* scores)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lim = _mm_set1_epi16(static_cast<short>(limit));
+    const __m128i mul = _mm_set1_epi16(static_cast<short>(multiplier));
+    __m128i acc0, acc1, r, diff, sign, sums;
+    int d = from, m;
+
+    while (d < to) {
+        if (d > to - 8) d = to - 8;
+
+        acc0 = acc1 = zero;
+        for (m = 0; m < blocksize; m ++) {
+            r = _mm_set1_epi32(right[m]);
+            diff = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + m + d)), r);
+            sign = _mm_srai_epi32(diff, 31);
+            acc0 = _mm_add_epi32(acc0, _mm_sub_epi32(_mm_xor_si128(diff, sign), sign));
+            diff = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + m + d + 4)), r);
+            sign = _mm_srai_epi32(diff, 31);
+            acc1 = _mm_add_epi32(acc1, _mm_sub_epi32(_mm_xor_si128(diff, sign), sign));
+        }
+        // Saturating to 16 bits does not change the result of the
+        // truncation since the limit fits in 15 bits
+        sums = _mm_min_epi16(_mm_packs_epi32(acc0, acc1), lim);
+        if (divide) sums = _mm_mulhi_epu16(sums, mul);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(scores + d),     _mm_unpacklo_epi16(sums, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(scores + d + 4), _mm_unpackhi_epi16(sums, zero));
+        d += 8;
+    }
+}
+
+// Padded previous costs make every candidate readable; the candidates
+// outside of the disparity range never win against the ones inside.
+static void svlSIMDStereoMinimizeCostsSSE2(const int* prevcosts, const int* distancecosts, const int* scores, const int truncation,
+                                           const int from, const int to, const int maxdiff, int* mincosts, int* minpositions)
+{
+    const __m128i trunc = _mm_set1_epi32(truncation);
+    const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+    __m128i best, pos, cost, lt, score;
+    int d = from, o;
+
+    while (d < to) {
+        if (d > to - 4) d = to - 4;
+
+        best = _mm_set1_epi32(0x7FFFFFFF);
+        pos = _mm_setzero_si128();
+        for (o = -maxdiff; o < maxdiff; o ++) {
+            cost = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(prevcosts + d + o)),
+                                 _mm_set1_epi32(distancecosts[o < 0 ? -o : o]));
+            // strictly lower: the first of the equal costs is kept
+            lt = _mm_cmpgt_epi32(best, cost);
+            best = _mm_or_si128(_mm_and_si128(lt, cost), _mm_andnot_si128(lt, best));
+            pos = _mm_or_si128(_mm_and_si128(lt, _mm_add_epi32(lanes, _mm_set1_epi32(d + o))), _mm_andnot_si128(lt, pos));
+        }
+        score = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scores + d));
+        lt = _mm_cmpgt_epi32(score, trunc);
+        score = _mm_or_si128(_mm_and_si128(lt, trunc), _mm_andnot_si128(lt, score));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(mincosts + d), _mm_add_epi32(best, score));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(minpositions + d), pos);
+        d += 4;
+    }
+}
+
+// Template matching: rows of the template are processed in 16 bytes
+// (SAD, SSD) or 8 bytes (correlation) chunks.  The last chunk of a row
+// ends at the end of the row and overlaps the previous one; the lanes
+// already processed are masked out.  Rows shorter than 16 bytes are
+// read as two 8 bytes halves.
+static inline __m128i svlSIMDTemplateTailSSE2(const unsigned char* row, const int width)
+{
+    if (width >= 16) return _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + width - 16));
+    return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row)),
+                              _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + width - 8)));
+}
+
+static inline bool svlSIMDTemplateTailMaskSSE2(const int width, __m128i& mask)
+{
+    unsigned char bytes[16];
+    int i, first, count;
+
+    if (width >= 16) {
+        if ((width & 15) == 0) return false;
+        first = 0;
+        count = 16 - (width & 15);
+    }
+    else {
+        first = 8;
+        count = 16 - width;
+    }
+    for (i = 0; i < 16; i ++) bytes[i] = (i >= first && i < first + count) ? 0 : 0xFF;
+    mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    return true;
+}
+
+static inline int svlSIMDHorizontalSumSSE2(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+    v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+    return _mm_cvtsi128_si32(v);
+}
+
+static inline __m128i svlSIMDSquaredDifferencesSSE2(const __m128i a, const __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    const __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+    return _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi));
+}
+
+static void svlSIMDTemplateSADSSE2(const unsigned char* img, const int imgstride,
+                                   const unsigned char* tmp, const int tmpwidth, const int tmpheight,
+                                   const int columns, const int rows, int* sums)
+{
+    const int chunks = tmpwidth >> 4;
+    __m128i mask, acc;
+    const bool tail = svlSIMDTemplateTailMaskSSE2(tmpwidth, mask);
+    const unsigned char *timg, *ttmp;
+    int r, c, j, k;
+
+    for (r = 0; r < rows; r ++) {
+        for (c = 0; c < columns; c ++) {
+            timg = img + r * imgstride + c * 3;
+            ttmp = tmp;
+            acc = _mm_setzero_si128();
+            for (j = 0; j < tmpheight; j ++) {
+                for (k = 0; k < chunks; k ++) {
+                    acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(timg + (k << 4))),
+                                                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(ttmp + (k << 4)))));
+                }
+                if (tail) {
+                    acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_and_si128(svlSIMDTemplateTailSSE2(timg, tmpwidth), mask),
+                                                          _mm_and_si128(svlSIMDTemplateTailSSE2(ttmp, tmpwidth), mask)));
+                }
+                timg += imgstride;
+                ttmp += tmpwidth;
+            }
+            *sums = _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8)); sums ++;
+        }
+    }
+}
+
+static void svlSIMDTemplateSSDSSE2(const unsigned char* img, const int imgstride,
+                                   const unsigned char* tmp, const int tmpwidth, const int tmpheight,
+                                   const int columns, const int rows, int* sums)
+{
+    const int chunks = tmpwidth >> 4;
+    __m128i mask, acc;
+    const bool tail = svlSIMDTemplateTailMaskSSE2(tmpwidth, mask);
+    const unsigned char *timg, *ttmp;
+    int r, c, j, k;
+
+    for (r = 0; r < rows; r ++) {
+        for (c = 0; c < columns; c ++) {
+            timg = img + r * imgstride + c * 3;
+            ttmp = tmp;
+            acc = _mm_setzero_si128();
+            for (j = 0; j < tmpheight; j ++) {
+                for (k = 0; k < chunks; k ++) {
+                    acc = _mm_add_epi32(acc, svlSIMDSquaredDifferencesSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(timg + (k << 4))),
+                                                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(ttmp + (k << 4)))));
+                }
+                if (tail) {
+                    acc = _mm_add_epi32(acc, svlSIMDSquaredDifferencesSSE2(_mm_and_si128(svlSIMDTemplateTailSSE2(timg, tmpwidth), mask),
+                                                                           _mm_and_si128(svlSIMDTemplateTailSSE2(ttmp, tmpwidth), mask)));
+                }
+                timg += imgstride;
+                ttmp += tmpwidth;
+            }
+            *sums = svlSIMDHorizontalSumSSE2(acc); sums ++;
+        }
+    }
+}
+
+// 'prepared' holds, for each 8 bytes chunk of each template row, three
+// vectors of 16 bits template values: one for each color channel, with
+// the lanes of the other channels (and the overlapping lanes) zeroed.
+// _mm_madd_epi16 then only sums products of the same channel.
+static void svlSIMDTemplateCorrelationRGBSSE2(const unsigned char* img, const int imgstride,
+                                              const short* prepared, const int* offsets, const int chunks, const int tmpheight,
+                                              const int columns, const int rows, int* correlations)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0, acc1, acc2, pixels;
+    const unsigned char *timg;
+    const short* ttmp;
+    int r, c, j, k;
+
+    for (r = 0; r < rows; r ++) {
+        for (c = 0; c < columns; c ++) {
+            timg = img + r * imgstride + c * 3;
+            ttmp = prepared;
+            acc0 = acc1 = acc2 = zero;
+            for (j = 0; j < tmpheight; j ++) {
+                for (k = 0; k < chunks; k ++) {
+                    pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(timg + offsets[k])), zero);
+                    acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(pixels, _mm_loadu_si128(reinterpret_cast<const __m128i*>(ttmp))));
+                    acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(pixels, _mm_loadu_si128(reinterpret_cast<const __m128i*>(ttmp + 8))));
+                    acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(pixels, _mm_loadu_si128(reinterpret_cast<const __m128i*>(ttmp + 16))));
+                    ttmp += 24;
+                }
+                timg += imgstride;
+            }
+            correlations[0] = svlSIMDHorizontalSumSSE2(acc0);
+            correlations[1] = svlSIMDHorizontalSumSSE2(acc1);
+            correlations[2] = svlSIMDHorizontalSumSSE2(acc2);
+            correlations += 3;
+        }
+    }
+}
+
+#if SVL_SIMD_HAS_AVX2
+
+SVL_SIMD_AVX2_FUNCTION
+static void svlSIMDStereoScoresRGBAVX2(const unsigned char* right, const unsigned char* const* taps, const int blockbytes,
+                                       const int from, const int to, const int limit, const int multiplier, const bool divide,
+                                       int* scores)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lim = _mm256_set1_epi16(static_cast<short>(limit));
+    const __m256i mul = _mm256_set1_epi16(static_cast<short>(multiplier));
+    __m256i acc0, acc1, r, l, ad;
+    int d = from, m;
+
+    while (d < to) {
+        if (d > to - 32) d = to - 32;
+
+        acc0 = acc1 = zero;
+        for (m = 0; m < blockbytes; m ++) {
+            r = _mm256_set1_epi8(static_cast<char>(right[m]));
+            l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(taps[m] + d));
+            ad = _mm256_or_si256(_mm256_subs_epu8(l, r), _mm256_subs_epu8(r, l));
+            acc0 = _mm256_add_epi16(acc0, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(ad)));
+            acc1 = _mm256_add_epi16(acc1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(ad, 1)));
+        }
+        acc0 = _mm256_min_epi16(acc0, lim);
+        acc1 = _mm256_min_epi16(acc1, lim);
+        if (divide) {
+            acc0 = _mm256_mulhi_epu16(acc0, mul);
+            acc1 = _mm256_mulhi_epu16(acc1, mul);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores + d),      _mm256_cvtepu16_epi32(_mm256_castsi256_si128(acc0)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores + d + 8),  _mm256_cvtepu16_epi32(_mm256_extracti128_si256(acc0, 1)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores + d + 16), _mm256_cvtepu16_epi32(_mm256_castsi256_si128(acc1)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores + d + 24), _mm256_cvtepu16_epi32(_mm256_extracti128_si256(acc1, 1)));
+        d += 32;
+    }
+}
+
+SVL_SIMD_AVX2_FUNCTION
+static void svlSIMDStereoScoresMonoAVX2(const int* right, const int* left, const int blocksize,
+                                        const int from, const int to, const int limit, const int multiplier, const bool divide,
+                                        int* scores)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lim = _mm256_set1_epi16(static_cast<short>(limit));
+    const __m256i mul = _mm256_set1_epi16(static_cast<short>(multiplier));
+    __m256i acc0, acc1, r, sums;
+    int d = from, m;
+
+    while (d < to) {
+        if (d > to - 16) d = to - 16;
+
+        acc0 = acc1 = zero;
+        for (m = 0; m < blocksize; m ++) {
+            r = _mm256_set1_epi32(right[m]);
+            acc0 = _mm256_add_epi32(acc0, _mm256_abs_epi32(_mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + m + d)), r)));
+            acc1 = _mm256_add_epi32(acc1, _mm256_abs_epi32(_mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + m + d + 8)), r)));
+        }
+        // Packing and unpacking both work within 128 bits lanes, so
+        // the scores come back in order without a permutation
+        sums = _mm256_min_epi16(_mm256_packs_epi32(acc0, acc1), lim);
+        if (divide) sums = _mm256_mulhi_epu16(sums, mul);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores + d),     _mm256_unpacklo_epi16(sums, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(scores + d + 8), _mm256_unpackhi_epi16(sums, zero));
+        d += 16;
+    }
+}
+
+SVL_SIMD_AVX2_FUNCTION
+static void svlSIMDStereoMinimizeCostsAVX2(const int* prevcosts, const int* distancecosts, const int* scores, const int truncation,
+                                           const int from, const int to, const int maxdiff, int* mincosts, int* minpositions)
+{
+    const __m256i trunc = _mm256_set1_epi32(truncation);
+    const __m256i lanes = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i best, pos, cost, lt;
+    int d = from, o;
+
+    while (d < to) {
+        if (d > to - 8) d = to - 8;
+
+        best = _mm256_set1_epi32(0x7FFFFFFF);
+        pos = _mm256_setzero_si256();
+        for (o = -maxdiff; o < maxdiff; o ++) {
+            cost = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(prevcosts + d + o)),
+                                    _mm256_set1_epi32(distancecosts[o < 0 ? -o : o]));
+            lt = _mm256_cmpgt_epi32(best, cost);
+            best = _mm256_blendv_epi8(best, cost, lt);
+            pos = _mm256_blendv_epi8(pos, _mm256_add_epi32(lanes, _mm256_set1_epi32(d + o)), lt);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(mincosts + d),
+                            _mm256_add_epi32(best, _mm256_min_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(scores + d)), trunc)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(minpositions + d), pos);
+        d += 8;
+    }
+}
+
+#endif // SVL_SIMD_HAS_AVX2
+
+bool svlImageProcessingSIMD::StereoScoresRGB(const unsigned char* right, const unsigned char* const* leftplanes,
+                                             const int firstbyte, const int blocksize,
+                                             const int from, const int to, const int truncation, int* scores)
+{
+    const svlImageProcessing::SIMD_Level level = Level();
+    int limit, multiplier;
+    if (level == svlImageProcessing::SIMD_None || to - from < 16 ||
+        !svlSIMDStereoScoreParams(blocksize, truncation, limit, multiplier)) return false;
+
+    // Byte m of the block belongs to color plane (firstbyte + m) mod 3,
+    // (firstbyte + m) div 3 pixels away from the first pixel
+    const unsigned char* taps[SVL_SIMD_STEREO_MAX_BLOCKSIZE * 3];
+    const int blockbytes = blocksize * 3;
+    int m, t, pixel;
+    for (m = 0; m < blockbytes; m ++) {
+        t = firstbyte + m;
+        pixel = (t >= 0) ? t / 3 : -((2 - t) / 3);
+        taps[m] = leftplanes[t - pixel * 3] + pixel;
+    }
+
+#if SVL_SIMD_HAS_AVX2
+    if (level == svlImageProcessing::SIMD_AVX2 && to - from >= 32) {
+        svlSIMDStereoScoresRGBAVX2(right, taps, blockbytes, from, to, limit, multiplier, blocksize > 1, scores);
+        return true;
+    }
+#endif
+    svlSIMDStereoScoresRGBSSE2(right, taps, blockbytes, from, to, limit, multiplier, blocksize > 1, scores);
+    return true;
+}
+
+bool svlImageProcessingSIMD::StereoScoresMono(const int* right, const int* left, const int blocksize,
+                                              const int from, const int to, const int truncation, int* scores)
+{
+    const svlImageProcessing::SIMD_Level level = Level();
+    int limit, multiplier;
+    if (level == svlImageProcessing::SIMD_None || to - from < 8 ||
+        !svlSIMDStereoScoreParams(blocksize, truncation, limit, multiplier)) return false;
+
+#if SVL_SIMD_HAS_AVX2
+    if (level == svlImageProcessing::SIMD_AVX2 && to - from >= 16) {
+        svlSIMDStereoScoresMonoAVX2(right, left, blocksize, from, to, limit, multiplier, blocksize > 1, scores);
+        return true;
+    }
+#endif
+    svlSIMDStereoScoresMonoSSE2(right, left, blocksize, from, to, limit, multiplier, blocksize > 1, scores);
+    return true;
+}
+
+bool svlImageProcessingSIMD::StereoMinimizeCosts(const int* prevcosts, const int* distancecosts,
+                                                 const int* scores, const int truncation,
+                                                 const int from, const int to, const int maxdiff,
+                                                 int* mincosts, int* minpositions)
+{
+    const svlImageProcessing::SIMD_Level level = Level();
+    if (level == svlImageProcessing::SIMD_None || to - from < 4 || maxdiff < 1) return false;
+
+#if SVL_SIMD_HAS_AVX2
+    if (level == svlImageProcessing::SIMD_AVX2 && to - from >= 8) {
+        svlSIMDStereoMinimizeCostsAVX2(prevcosts, distancecosts, scores, truncation, from, to, maxdiff, mincosts, minpositions);
+        return true;
+    }
+#endif
+    svlSIMDStereoMinimizeCostsSSE2(prevcosts, distancecosts, scores, truncation, from, to, maxdiff, mincosts, minpositions);
+    return true;
+}
+
+bool svlImageProcessingSIMD::TemplateSAD(const unsigned char* img, const int imgstride,
+                                         const unsigned char* tmp, const int tmpwidth, const int tmpheight,
+                                         const int columns, const int rows, int* sums)
+{
+    if (Level() == svlImageProcessing::SIMD_None || tmpwidth < 8 || tmpheight < 1) return false;
+
+    svlSIMDTemplateSADSSE2(img, imgstride, tmp, tmpwidth, tmpheight, columns, rows, sums);
+    return true;
+}
+
+bool svlImageProcessingSIMD::TemplateSSD(const unsigned char* img, const int imgstride,
+                                         const unsigned char* tmp, const int tmpwidth, const int tmpheight,
+                                         const int columns, const int rows, int* sums)
+{
+    if (Level() == svlImageProcessing::SIMD_None || tmpwidth < 8 || tmpheight < 1) return false;
+
+    svlSIMDTemplateSSDSSE2(img, imgstride, tmp, tmpwidth, tmpheight, columns, rows, sums);
+    return true;
+}
+
+bool svlImageProcessingSIMD::TemplateCorrelationRGB(const unsigned char* img, const int imgstride,
+                                                    const int* tmp, const int tmpwidth, const int tmpheight,
+                                                    const int columns, const int rows, int* correlations)
+{
+    if (Level() == svlImageProcessing::SIMD_None || tmpwidth < 8 || tmpheight < 1 || (tmpwidth % 3) != 0) return false;
+
+    // Chunk offsets within a template row; the last one ends at the end
+    // of the row and its leading 'overlap' lanes are processed already
+    const int chunks = (tmpwidth + 7) >> 3;
+    const int overlap = (chunks << 3) - tmpwidth;
+    std::vector<int> offsets(chunks);
+    int j, k, i, b, value;
+    for (k = 0; k < chunks; k ++) offsets[k] = k << 3;
+    offsets[chunks - 1] = tmpwidth - 8;
+
+    std::vector<short> prepared(tmpheight * chunks * 24, 0);
+    short* ptr = &(prepared[0]);
+    for (j = 0; j < tmpheight; j ++) {
+        for (k = 0; k < chunks; k ++) {
+            for (i = (k == chunks - 1) ? overlap : 0; i < 8; i ++) {
+                b = offsets[k] + i;
+                value = tmp[j * tmpwidth + b];
+                if (value < -32768 || value > 32767) return false;
+                ptr[(b % 3) * 8 + i] = static_cast<short>(value);
+            }
+            ptr += 24;
+        }
+    }
+
+    svlSIMDTemplateCorrelationRGBSSE2(img, imgstride, &(prepared[0]), &(offsets[0]), chunks, tmpheight,
+                                      columns, rows, correlations);
+    return true;
+}
+
+#else // SVL_SIMD_HAS_SSE2
+
+bool svlImageProcessingSIMD::ConvolutionUChar(const unsigned char*, unsigned char*, const int, const int, const int,
+                                              const int*, const int, const int, bool)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::ResampleAndInterpolateV(const unsigned char*, const unsigned int,
+                                                     unsigned char*, const unsigned int, const unsigned int)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::UnsharpMaskBlurRGB(const unsigned char*, unsigned char*, const int, const int, int)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::DeinterlaceBlending(unsigned char*, const unsigned int, const unsigned int)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::DeinterlaceAdaptiveBlending(unsigned char*, const unsigned int, const unsigned int)
+{
+    return false;
+}
+
+unsigned int svlImageProcessingSIMD::RGB24toYUV444(const unsigned char*, unsigned char*, const unsigned int, bool, bool, bool)
+{
+    return 0;
+}
+
+unsigned int svlImageProcessingSIMD::YUV444toRGB24(const unsigned char*, unsigned char*, const unsigned int, bool, bool, bool)
+{
+    return 0;
+}
+
+bool svlImageProcessingSIMD::StereoScoresRGB(const unsigned char*, const unsigned char* const*, const int, const int,
+                                             const int, const int, const int, int*)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::StereoScoresMono(const int*, const int*, const int, const int, const int, const int, int*)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::StereoMinimizeCosts(const int*, const int*, const int*, const int,
+                                                 const int, const int, const int, int*, int*)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::TemplateSAD(const unsigned char*, const int, const unsigned char*, const int, const int,
+                                         const int, const int, int*)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::TemplateSSD(const unsigned char*, const int, const unsigned char*, const int, const int,
+                                         const int, const int, int*)
+{
+    return false;
+}
+
+bool svlImageProcessingSIMD::TemplateCorrelationRGB(const unsigned char*, const int, const int*, const int, const int,
+                                                    const int, const int, int*)
+{
+    return false;
+}
+
+#endif // SVL_SIMD_HAS_SSE2
@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#ifndef _svlImageProcessingSIMD_h
+#define _svlImageProcessingSIMD_h
+
+#include <cisstStereoVision/svlImageProcessing.h>
+
+
+// Vectorized versions of the hot loops in svlImageProcessingHelper,
+// svlConverter, the stereo matchers and the template matching tracker.
+// The scalar functions remain the reference: each of them calls its
+// counterpart below first and only runs its own loop if the
+// counterpart returns false (or, for the converters, continues after
+// the pixels already processed).  Every function below produces
+// bit-exact results with respect to the scalar code and gives up when
+// the active SIMD level is SIMD_None, when the image is too small or
+// when an argument falls out of the range the vector arithmetic can
+// represent exactly.
+
+namespace svlImageProcessingSIMD
+{
+    // Returns the level selected by svlImageProcessing::SetSIMDLevel
+    svlImageProcessing::SIMD_Level Level();
+
+    // Convolution of 8 bits per channel images (Mono8, RGB, RGBA) with
+    // a kernel_width x kernel_height kernel in 22.10 fixed point,
+    // row-major.  Horizontal and vertical 1D kernels are handled as
+    // 1 x N and N x 1 kernels.
+    bool ConvolutionUChar(const unsigned char* input, unsigned char* output,
+                          const int width, const int height, const int channels,
+                          const int* kernel, const int kernel_width, const int kernel_height,
+                          bool absres);
+
+    // Vertical linear resampling of rows of rowsize bytes, used by
+    // both ResampleAndInterpolateVRGB24 and ResampleAndInterpolateVMono8
+    bool ResampleAndInterpolateV(const unsigned char* src, const unsigned int srcheight,
+                                 unsigned char* dst, const unsigned int dstheight,
+                                 const unsigned int rowsize);
+
+    bool UnsharpMaskBlurRGB(const unsigned char* img_in, unsigned char* img_out,
+                            const int width, const int height, int radius);
+
+    bool DeinterlaceBlending(unsigned char* buffer, const unsigned int width, const unsigned int height);
+    bool DeinterlaceAdaptiveBlending(unsigned char* buffer, const unsigned int width, const unsigned int height);
+
+    // Return the number of leading pixels converted
+    unsigned int RGB24toYUV444(const unsigned char* input, unsigned char* output, const unsigned int pixelcount,
+                               bool ch1, bool ch2, bool ch3);
+    unsigned int YUV444toRGB24(const unsigned char* input, unsigned char* output, const unsigned int pixelcount,
+                               bool ch1, bool ch2, bool ch3);
+
+    // Block matching scores of svlStereoDP and svlStereoDPMono for the
+    // disparities from..to-1: scores[d] = min(SAD(d) / blocksize, truncation),
+    // where SAD(d) is the sum of absolute differences between the block
+    // of the right image and the block of the left image shifted by d
+    // pixels.  The RGB version reads the left image from color planes,
+    // leftplanes[c] pointing at the pixel of disparity 0, and the block
+    // starts at byte 'firstbyte' of that pixel (may be negative).
+    bool StereoScoresRGB(const unsigned char* right, const unsigned char* const* leftplanes,
+                         const int firstbyte, const int blocksize,
+                         const int from, const int to, const int truncation, int* scores);
+    bool StereoScoresMono(const int* right, const int* left, const int blocksize,
+                          const int from, const int to, const int truncation, int* scores);
+
+    // Dynamic programming step of the stereo matchers for the disparities
+    // from..to-1: the lowest prevcosts[l] + distancecosts[|l - d|] for
+    // d - maxdiff <= l < d + maxdiff, plus min(scores[d], truncation), and
+    // the first l where it is reached.  prevcosts has to be readable on
+    // the whole [from - maxdiff, to + maxdiff) range, padded with costs
+    // that cannot win outside of the disparity range.
+    bool StereoMinimizeCosts(const int* prevcosts, const int* distancecosts,
+                             const int* scores, const int truncation,
+                             const int from, const int to, const int maxdiff,
+                             int* mincosts, int* minpositions);
+
+    // Template matching of svlTrackerMSBruteForce on RGB images: the
+    // tmpwidth bytes x tmpheight rows template is compared to the image
+    // block of each of the columns x rows candidate positions, one pixel
+    // apart, the first one at 'img'.  Results are stored row by row: sum
+    // of absolute or squared differences, or the three per-channel sums
+    // of products with a template of 16 bits integers.
+    bool TemplateSAD(const unsigned char* img, const int imgstride,
+                     const unsigned char* tmp, const int tmpwidth, const int tmpheight,
+                     const int columns, const int rows, int* sums);
+    bool TemplateSSD(const unsigned char* img, const int imgstride,
+                     const unsigned char* tmp, const int tmpwidth, const int tmpheight,
+                     const int columns, const int rows, int* sums);
+    bool TemplateCorrelationRGB(const unsigned char* img, const int imgstride,
+                                const int* tmp, const int tmpwidth, const int tmpheight,
+                                const int columns, const int rows, int* correlations);
+};
+
+#endif // _svlImageProcessingSIMD_h
@@ -50,6 +50,11 @@ svlSample & svlSample::operator= (const svlSample & other)
     return *this;
 }
 
+int svlSample::ShareOf(const svlSample* sample)
+{
+    return CopyOf(sample);
+}
+
 bool svlSample::IsInitialized() const
 {
     return false;
@@ -0,0 +1,166 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstStereoVision/svlSampleBufferPool.h>
+
+
+/*******************************/
+/*** svlSampleBuffer class *****/
+/*******************************/
+
+svlSampleBuffer::svlSampleBuffer(size_t size) :
+    Size(size)
+{
+    // Over-allocate to align the data on a cache line
+    Memory = new unsigned char[Size + OSA_CACHE_LINE_SIZE];
+    const size_t offset = reinterpret_cast<size_t>(Memory) % OSA_CACHE_LINE_SIZE;
+    Data = Memory + (offset ? OSA_CACHE_LINE_SIZE - offset : 0);
+    ReferenceCount.Store(1);
+}
+
+svlSampleBuffer::~svlSampleBuffer()
+{
+    delete [] Memory;
+}
+
+unsigned char* svlSampleBuffer::GetPointer() const
+{
+    return Data;
+}
+
+size_t svlSampleBuffer::GetSize() const
+{
+    return Size;
+}
+
+void svlSampleBuffer::AddReference()
+{
+    ReferenceCount.FetchAdd(1);
+}
+
+void svlSampleBuffer::Release()
+{
+    if (ReferenceCount.FetchSub(1) == 1) {
+        svlSampleBufferPool::GetInstance()->Recycle(this);
+    }
+}
+
+bool svlSampleBuffer::IsShared() const
+{
+    return ReferenceCount.Load() > 1;
+}
+
+
+/***********************************/
+/*** svlSampleBufferPool class *****/
+/***********************************/
+
+svlSampleBufferPool::svlSampleBufferPool() :
+    MaximumFreeBuffers(8),
+    AllocationCount(0),
+    ReuseCount(0)
+{
+}
+
+svlSampleBufferPool::~svlSampleBufferPool()
+{
+    Clear();
+}
+
+svlSampleBufferPool* svlSampleBufferPool::GetInstance()
+{
+    // Never deleted since samples can be released during static destruction
+    static svlSampleBufferPool* instance = new svlSampleBufferPool;
+    return instance;
+}
+
+svlSampleBuffer* svlSampleBufferPool::Acquire(size_t size)
+{
+    CS.Enter();
+        FreeBuffersType::iterator iter = FreeBuffers.find(size);
+        if (iter != FreeBuffers.end() && !iter->second.empty()) {
+            svlSampleBuffer* buffer = iter->second.back();
+            iter->second.pop_back();
+            ReuseCount ++;
+            CS.Leave();
+            buffer->ReferenceCount.Store(1);
+            return buffer;
+        }
+        AllocationCount ++;
+    CS.Leave();
+
+    return new svlSampleBuffer(size);
+}
+
+void svlSampleBufferPool::Recycle(svlSampleBuffer* buffer)
+{
+    CS.Enter();
+        std::vector<svlSampleBuffer*> & freebuffers = FreeBuffers[buffer->Size];
+        if (freebuffers.size() < MaximumFreeBuffers) {
+            freebuffers.push_back(buffer);
+            buffer = 0;
+        }
+    CS.Leave();
+
+    if (buffer) delete buffer;
+}
+
+void svlSampleBufferPool::SetMaximumFreeBuffers(unsigned int count)
+{
+    std::vector<svlSampleBuffer*> extrabuffers;
+
+    CS.Enter();
+        MaximumFreeBuffers = count;
+        for (FreeBuffersType::iterator iter = FreeBuffers.begin(); iter != FreeBuffers.end(); ++ iter) {
+            while (iter->second.size() > MaximumFreeBuffers) {
+                extrabuffers.push_back(iter->second.back());
+                iter->second.pop_back();
+            }
+        }
+    CS.Leave();
+
+    for (size_t i = 0; i < extrabuffers.size(); i ++) delete extrabuffers[i];
+}
+
+unsigned int svlSampleBufferPool::GetMaximumFreeBuffers() const
+{
+    return MaximumFreeBuffers;
+}
+
+void svlSampleBufferPool::Clear()
+{
+    FreeBuffersType freebuffers;
+
+    CS.Enter();
+        freebuffers.swap(FreeBuffers);
+    CS.Leave();
+
+    for (FreeBuffersType::iterator iter = freebuffers.begin(); iter != freebuffers.end(); ++ iter) {
+        for (size_t i = 0; i < iter->second.size(); i ++) delete iter->second[i];
+    }
+}
+
+unsigned int svlSampleBufferPool::GetAllocationCount() const
+{
+    return AllocationCount;
+}
+
+unsigned int svlSampleBufferPool::GetReuseCount() const
+{
+    return ReuseCount;
+}
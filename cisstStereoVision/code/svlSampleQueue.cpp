@@ -68,7 +68,8 @@ bool svlSampleQueue::Push(const svlSample* sample)
         }
     CS.Leave();
 
-    push_item->CopyOf(sample);
+    // Shares the image data with the pushed sample until either is modified
+    push_item->ShareOf(sample);
 
     CS.Enter();
         BufferedItems.push_front(push_item);
@@ -45,6 +45,7 @@ public:
 
     virtual int Initialize();
     virtual int Process(svlSampleImage *images, int *disparitymap);
+    virtual int Process(svlProcInfo *procInfo, svlSampleImage *images, int *disparitymap);
     virtual void Free();
 
 private:
@@ -81,7 +82,7 @@ private:
 
     svlRGB *LeftImage;
     svlRGB *RightImage;
-    int *RightLineBuffer;
+    unsigned char *LeftPlanes;
     unsigned short *DisparityMap;
     unsigned short *DisparityGraph;
     unsigned short *DisparityCost;
@@ -89,18 +90,21 @@ private:
     unsigned short *DisparityMapTemp;
 
     int DispDiffLUT[256][256];
-    int ScoreCache[ST_DP_TEMP_BUFF_SIZE];
-    int PrevCostCache[ST_DP_TEMP_BUFF_SIZE];
-    unsigned short PrevLineDispMin[ST_DP_TEMP_BUFF_SIZE];
-    unsigned short PrevLineDispMax[ST_DP_TEMP_BUFF_SIZE];
+    // Per diagonal of the graph, alternating between two buffers
+    unsigned short PrevLineDispMin[2][ST_DP_TEMP_BUFF_SIZE];
+    unsigned short PrevLineDispMax[2][ST_DP_TEMP_BUFF_SIZE];
 
     //////////////////////////
     // Functions
 
-    void CreateScale(svlRGB* src_img, svlRGB* dest_img);
-    void DisparityOptimization();
-    void FilterDisparityMap();
-    void RenderDisparityMap(int *disparitymap);
+    void CreateScale(svlProcInfo* procInfo, svlRGB* src_img, svlRGB* dest_img, unsigned char* dest_planes);
+    void ComputeScores(const int inputoffset, const int from, const int to, int* scores);
+    void ComputeNodeCosts(const int from, const int to, const int* scores, const int* prevcosts,
+                          unsigned short* dispcost, unsigned short* dispgraph);
+    int  DisparityOptimization(svlProcInfo* procInfo);
+    int  TraceDisparity(const int ijoffset);
+    int  FilterDisparityMap(svlProcInfo* procInfo);
+    void RenderDisparityMap(svlProcInfo* procInfo, int *disparitymap);
 };
 
 #endif // _svlStereoDP_h
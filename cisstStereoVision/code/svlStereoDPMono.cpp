@@ -20,7 +20,9 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include "svlStereoDPMono.h"
+#include "svlImageProcessingSIMD.h"
 #include <math.h>
+#include <algorithm>
 
 
 /******************************************/
@@ -102,7 +104,6 @@ svlStereoDPMono::svlStereoDPMono(int width, int height,
     // Zeroing pointers
     LeftImage = 0;
     RightImage = 0;
-    RightLineBuffer = 0;
     DisparityMap = 0;
     DisparityMapTemp = 0;
     DisparityCost = 0;
@@ -134,13 +135,21 @@ int svlStereoDPMono::Initialize()
     Free();
 
     // Allocate buffers
-    DisparityCost = new unsigned short[DisparityRange * ST_DP_TEMP_BUFF_SIZE];
+    //   (two sets of costs: one for the previous and one for the current diagonal)
+    DisparityCost = new unsigned short[2 * DisparityRange * ST_DP_TEMP_BUFF_SIZE];
     DisparityGraph = new unsigned short[DisparityRange * SurfaceWidth * SurfaceHeight];
     DisparityMap = new unsigned short[SurfaceWidth * SurfaceHeight];
     DisparityMapTemp = new unsigned short[SurfaceWidth * SurfaceHeight];
     LeftImage = new int[ScaleWidth * ScaleHeight];
     RightImage = new int[ScaleWidth * ScaleHeight];
-    RightLineBuffer = new int[BlockSize * 3];
+
+    // The disparities outside of the valid area are never computed
+    memset(DisparityCost, 0, 2 * DisparityRange * ST_DP_TEMP_BUFF_SIZE * sizeof(unsigned short));
+    memset(DisparityGraph, 0, DisparityRange * SurfaceWidth * SurfaceHeight * sizeof(unsigned short));
+    memset(DisparityMap, 0, SurfaceWidth * SurfaceHeight * sizeof(unsigned short));
+    memset(DisparityMapTemp, 0, SurfaceWidth * SurfaceHeight * sizeof(unsigned short));
+    memset(LeftImage, 0, ScaleWidth * ScaleHeight * sizeof(int));
+    memset(RightImage, 0, ScaleWidth * ScaleHeight * sizeof(int));
 
     // building look up tables for optimization
     int i, j, diff, absdiff;
@@ -170,6 +179,27 @@ int svlStereoDPMono::Initialize()
 //    Computes disparity map from the input image pair
 // *******************************************************************
 int svlStereoDPMono::Process(svlSampleImage *images, int *disparitymap)
+{
+    svlProcInfo procInfo;
+    procInfo.count = 1;
+    procInfo.ID = 0;
+    procInfo.sync = 0;
+    procInfo.cs = 0;
+
+    return Process(&procInfo, images, disparitymap);
+}
+
+// *******************************************************************
+// svlStereoDPMono::Process method
+// arguments:
+//           procInfo       - thread information
+//           images         - input image pair (non-padded, 1 color channel)
+//           disparitymap   - output image pointer (non-padded, int32)
+// function:
+//    To be called once for each frame on every thread of the stream.
+//    Computes disparity map from the input image pair
+// *******************************************************************
+int svlStereoDPMono::Process(svlProcInfo *procInfo, svlSampleImage *images, int *disparitymap)
 {
     if (images->GetVideoChannels() != 2 ||      // stereo ?
         images->GetDataChannels() != 1)         // 1 color channel ?
@@ -180,29 +210,33 @@ int svlStereoDPMono::Process(svlSampleImage *images, int *disparitymap)
     void* leftinput = images->GetUCharPointer(SVL_LEFT);
     void* rightinput = images->GetUCharPointer(SVL_RIGHT);
     if (bpp == 1) {
-        CreateScale<unsigned char>(reinterpret_cast<unsigned char*>(leftinput), LeftImage);
-        CreateScale<unsigned char>(reinterpret_cast<unsigned char*>(rightinput), RightImage);
+        CreateScale<unsigned char>(procInfo, reinterpret_cast<unsigned char*>(leftinput), LeftImage);
+        CreateScale<unsigned char>(procInfo, reinterpret_cast<unsigned char*>(rightinput), RightImage);
     }
     else if (bpp == 2) {
-        CreateScale<unsigned short>(reinterpret_cast<unsigned short*>(leftinput), LeftImage);
-        CreateScale<unsigned short>(reinterpret_cast<unsigned short*>(rightinput), RightImage);
+        CreateScale<unsigned short>(procInfo, reinterpret_cast<unsigned short*>(leftinput), LeftImage);
+        CreateScale<unsigned short>(procInfo, reinterpret_cast<unsigned short*>(rightinput), RightImage);
     }
     else if (bpp == 4) {
-        CreateScale<unsigned int>(reinterpret_cast<unsigned int*>(leftinput), LeftImage);
-        CreateScale<unsigned int>(reinterpret_cast<unsigned int*>(rightinput), RightImage);
+        CreateScale<unsigned int>(procInfo, reinterpret_cast<unsigned int*>(leftinput), LeftImage);
+        CreateScale<unsigned int>(procInfo, reinterpret_cast<unsigned int*>(rightinput), RightImage);
     }
     else return -2;
 
+    _SynchronizeThreads(procInfo);
+
     // Running optimization
-    DisparityOptimization();
+    if (DisparityOptimization(procInfo) != SVL_OK) return SVL_FAIL;
 
     // Filtering result
-    FilterDisparityMap();
+    if (FilterDisparityMap(procInfo) != SVL_OK) return SVL_FAIL;
+
+    _OnSingleThread(procInfo) FrameCounter ++;
 
     // Rendering output
-    RenderDisparityMap(disparitymap);
+    RenderDisparityMap(procInfo, disparitymap);
 
-    FrameCounter ++;
+    _SynchronizeThreads(procInfo);
 
     return 0;
 }
@@ -240,44 +274,110 @@ void svlStereoDPMono::Free()
         delete [] RightImage;
         RightImage = 0;
     }
-    if (RightLineBuffer) {
-        delete [] RightLineBuffer;
-        RightLineBuffer = 0;
+}
+
+// *******************************************************************
+// svlStereoDPMono::ComputeScores PRIVATE method
+// arguments:
+//           inputoffset    - position of the node on the scaled images
+//           from, to       - disparity range
+//           scores         - output buffer indexed by disparity
+// function:
+//    Block matching: sum of absolute differences between the block around
+//    the node on the right image and the blocks shifted by the disparities
+//    on the left image. Values above ScoreTruncationLevel may be truncated.
+// *******************************************************************
+void svlStereoDPMono::ComputeScores(const int inputoffset, const int from, const int to, int* scores)
+{
+    const int halfblocksize = (BlockSize - 1) >> 1;
+    int *left, *right;
+    int d, d2, diff, error, rightval;
+
+    right = RightImage + inputoffset;
+    left = LeftImage + inputoffset + MinDisparity + PrincipalPointOffset;
+
+    if (svlImageProcessingSIMD::StereoScoresMono(right - halfblocksize, left - halfblocksize, BlockSize,
+                                                 from, to, ScoreTruncationLevel, scores)) return;
+
+    if (BlockSize > 1) {
+        right -= halfblocksize;
+
+        for (d = from; d < to; d ++) {
+            left = LeftImage + inputoffset + MinDisparity + PrincipalPointOffset + d - halfblocksize;
+
+            // computing error
+            error = 0;
+            for (d2 = 0; d2 < BlockSize; d2 ++) {
+                diff = right[d2] - *left;
+                left ++;
+                if (diff < 0) error -= diff;
+                else error += diff;
+            }
+            // scoring
+            scores[d] = error / BlockSize;
+        }
+    }
+    else {
+        rightval = *right;
+        left += from;
+
+        for (d = from; d < to; d ++) {
+            // computing error
+            diff = rightval - *left;
+            left ++;
+            if (diff < 0) error = -diff;
+            else error = diff;
+            // scoring
+            scores[d] = error;
+        }
     }
 }
 
 // *******************************************************************
 // svlStereoDPMono::DisparityOptimization PRIVATE method
 // arguments:
+//           procInfo       - thread information
 // function:
 //    2D Dynamic Programming in a single step
 //    Carried out on the scaled down input images
 //    It performs a full search on the first frame, then a narrowed
 //    search on the following frames. Search area size defined in the
 //    constructor as an argument.
+//    The graph is processed one diagonal line at a time. Nodes of a
+//    diagonal depend only on the previous diagonal, therefore each
+//    diagonal is split among the threads.
 //    Image buffer overflow is not checked! Make sure the valid image
 //    area is set properly and the disparity search range is within the
 //    valid area borders when calling the constructor.
 // *******************************************************************
-void svlStereoDPMono::DisparityOptimization()
+int svlStereoDPMono::DisparityOptimization(svlProcInfo* procInfo)
 {
     const int rowstride = SurfaceWidth;
     const int inputrowstride = ScaleWidth;
     const int disparitystride = SurfaceWidth * SurfaceHeight;
-    const int halfblocksize = (BlockSize - 1) >> 1;
-    unsigned short *dispgraph, *dispcost1, *dispcost2;
-    int *left, *right, *iptr1, *iptr2, *tmpintbuff;
-
-    bool processed;
-    int i, j, d, l, d1, d2, rightval;
-    int cost, min_cost, min_cost_pos, disp, disp2, score;
-    int min_prev_cost, min_next_cost;
-    int cost_array[1024];
-    int from1, to1, from2, to2, diff, error;
-    int pb_min_cost_pos, pb_h21, pb_p1, pb_p2, weight1, weight2, pb_t1, pb_t2;
+    const int costbuffersize = DisparityRange * ST_DP_TEMP_BUFF_SIZE;
+    const int diagonals = (ValidAreaRight - ValidAreaLeft) + (ValidAreaBottom - ValidAreaTop) - 1;
+    unsigned short *dispgraph, *dispcost1, *dispcost2, *dispcostin, *dispcostout;
+    unsigned short *prevlinedispmin, *prevlinedispmax;
+
+    unsigned int k, count, from, to;
+    int i, j, d, d1, d2, first_i, first_j, pos;
+    int cost, min_cost, min_cost_pos, disp;
+    int score_cache[ST_DP_TEMP_BUFF_SIZE];
+    int prev_cost_buffer[ST_DP_TEMP_BUFF_SIZE];
+    int *prev_cost_cache = prev_cost_buffer + MaxDisparityDifference;
+    int from1, to1, from2, to2;
     int pdispmin1, pdispmin2, pdispmax1, pdispmax2;
     int offset, ijoffset, inputoffset;
-    int pos = 1;
+
+    if (diagonals < 1) return SVL_OK;
+
+    // padding around prev_cost_cache: neighbors out of the disparity range
+    // are never selected (see ComputeNodeCosts)
+    for (d = 1; d <= MaxDisparityDifference; d ++) {
+        prev_cost_cache[-d] = ST_DP_PADDING_COST;
+        prev_cost_cache[DisparityRange - 1 + d] = ST_DP_PADDING_COST;
+    }
 
 
     ///////////////////////////////////////////////////////
@@ -286,35 +386,50 @@ void svlStereoDPMono::DisparityOptimization()
     //     C[j+1] = C[j] + D[j,j+1] + Score[j+1]
 
     // initializing the upper left corner of the graph
-    PrevLineDispMin[ValidAreaTop] = 0;
-    PrevLineDispMax[ValidAreaTop] = DisparityRange;
-    offset = ValidAreaTop * rowstride + ValidAreaLeft;
-    dispcost1 = DisparityCost + ValidAreaTop; // DisparityCost(0, ValidAreaTop, ValidAreaLeft)
-    dispgraph = DisparityGraph + offset; // DisparityGraph(0, ValidAreaTop, ValidAreaLeft)
-    for (i = 0; i < DisparityRange; i ++) {
-        *dispcost1 = 0;
-        *dispgraph = 0;
-        dispcost1 += ST_DP_TEMP_BUFF_SIZE;
-        dispgraph += disparitystride;
+    _OnSingleThread(procInfo) {
+        PrevLineDispMin[0][ValidAreaTop] = 0;
+        PrevLineDispMax[0][ValidAreaTop] = DisparityRange;
+        offset = ValidAreaTop * rowstride + ValidAreaLeft;
+        dispcost1 = DisparityCost + ValidAreaTop; // DisparityCost(0, ValidAreaTop, ValidAreaLeft)
+        dispgraph = DisparityGraph + offset; // DisparityGraph(0, ValidAreaTop, ValidAreaLeft)
+        for (i = 0; i < DisparityRange; i ++) {
+            *dispcost1 = 0;
+            *dispgraph = 0;
+            dispcost1 += ST_DP_TEMP_BUFF_SIZE;
+            dispgraph += disparitystride;
+        }
     }
 
-    // "recursive" walkthrough to process the whole graph
+    _SynchronizeThreads(procInfo);
+
+    // walkthrough to process the whole graph
     // processing a single diagonal line in each step
-    do {
-        processed = false;
-
-        i = ValidAreaLeft;
-        j = ValidAreaTop + pos;
-        if (j >= ValidAreaBottom) {
-            i = ValidAreaLeft + j - ValidAreaBottom + 1;
-            j = ValidAreaBottom - 1;
+    for (pos = 1; pos < diagonals; pos ++) {
+
+        // costs and local disparity ranges of the previous diagonal are
+        // read from one buffer and the ones of this diagonal written to
+        // the other
+        dispcostin = DisparityCost + ((pos - 1) & 1) * costbuffersize;
+        dispcostout = DisparityCost + (pos & 1) * costbuffersize;
+        prevlinedispmin = PrevLineDispMin[(pos - 1) & 1];
+        prevlinedispmax = PrevLineDispMax[(pos - 1) & 1];
+
+        first_i = ValidAreaLeft;
+        first_j = ValidAreaTop + pos;
+        if (first_j >= ValidAreaBottom) {
+            first_i = ValidAreaLeft + first_j - ValidAreaBottom + 1;
+            first_j = ValidAreaBottom - 1;
         }
-        pos ++;
+        count = static_cast<unsigned int>(std::min(ValidAreaRight - first_i, first_j - ValidAreaTop + 1));
 
-        // processing next diagonal line
-        while (i < ValidAreaRight && j >= ValidAreaTop) {
+        // processing this thread's part of the diagonal line
+        _GetParallelSubRange(procInfo, count, from, to);
+        for (k = from; k < to; k ++) {
 
+            i = first_i + k;
+            j = first_j - k;
             ijoffset = j * rowstride + i;
+            inputoffset = j * inputrowstride + (i << ScaleFactor);
 
         /////////////////////////////////////////////
         // processing single node at position (i, j)
@@ -323,10 +438,10 @@ void svlStereoDPMono::DisparityOptimization()
             // if not the first frame:
             //    perform narrowed search
 
-                pdispmin1 = PrevLineDispMin[j];
-                pdispmin2 = PrevLineDispMin[j - 1];
-                pdispmax1 = PrevLineDispMax[j];
-                pdispmax2 = PrevLineDispMax[j - 1];
+                pdispmin1 = prevlinedispmin[j];
+                pdispmin2 = prevlinedispmin[j - 1];
+                pdispmax1 = prevlinedispmax[j];
+                pdispmax2 = prevlinedispmax[j - 1];
 
                 // compute range for narrowed search
                 disp = DisparityMap[ijoffset];
@@ -336,59 +451,17 @@ void svlStereoDPMono::DisparityOptimization()
                 to1 = disp + NarrowedSearchRadius;
                 if (to1 > DisparityRange) to1 = DisparityRange;
 
-                // compute ScoreCache (costs from previous diagonal)
-                inputoffset = j * inputrowstride + (i << ScaleFactor);
-                right = RightImage + inputoffset;
-                left = LeftImage + inputoffset + from1 + MinDisparity + PrincipalPointOffset;
-
-                if (BlockSize > 1) {
-                    right -= halfblocksize;
-                    tmpintbuff = RightLineBuffer;
-                    for (d = 0; d < BlockSize; d ++) {
-                        *tmpintbuff = *right;
-                        tmpintbuff ++; right ++;
-                    }
+                // compute score_cache (costs from previous diagonal)
+                ComputeScores(inputoffset, from1, to1, score_cache);
 
-                    for (d = from1; d < to1; d ++) {
-                        left -= halfblocksize;
-
-                        // computing error
-                        tmpintbuff = RightLineBuffer;
-                        error = 0;
-                        for (d2 = 0; d2 < BlockSize; d2 ++) {
-                            diff = *tmpintbuff - *left;
-                            left ++; tmpintbuff ++;
-                            if (diff < 0) error -= diff;
-                            else error += diff;
-                        }
-                        // scoring
-                        ScoreCache[d] = error / BlockSize;
-
-                        left -= halfblocksize;
-                    }
-                }
-                else {
-                    rightval = *right;
-
-                    for (d = from1; d < to1; d ++) {
-                        // computing error
-                        diff = rightval - *left;
-                        left ++;
-                        if (diff < 0) error = -diff;
-                        else error = diff;
-                        // scoring
-                        ScoreCache[d] = error;
-                    }
-                }
-
-                // compute range for PrevCostCache
+                // compute range for prev_cost_cache
                 from2 = from1 - MaxDisparityDifference;
                 if (from2 < 0) from2 = 0;
                 to2 = to1 + MaxDisparityDifference;
                 if (to2 > DisparityRange) to2 = DisparityRange;
 
-                // compute PrevCostCache
-                dispcost1 = DisparityCost + from2 * ST_DP_TEMP_BUFF_SIZE + j; // DisparityCost(from2, j, i - 1)
+                // compute prev_cost_cache
+                dispcost1 = dispcostin + from2 * ST_DP_TEMP_BUFF_SIZE + j; // DisparityCost(from2, j, i - 1)
                 dispcost2 = dispcost1 - 1; // DisparityCost(from2, j - 1, i)
                 if (i > ValidAreaLeft) {
                     if (j > ValidAreaTop) {
@@ -397,7 +470,7 @@ void svlStereoDPMono::DisparityOptimization()
                             else d1 = *dispcost1;
                             if (d < pdispmin2 || d >= pdispmax2) d2 = BIG_I32_VAL;
                             else d2 = *dispcost2;
-                            PrevCostCache[d] = (d1 + d2 + 1) >> 1;
+                            prev_cost_cache[d] = (d1 + d2 + 1) >> 1;
                             dispcost1 += ST_DP_TEMP_BUFF_SIZE;
                             dispcost2 += ST_DP_TEMP_BUFF_SIZE;
                         }
@@ -406,7 +479,7 @@ void svlStereoDPMono::DisparityOptimization()
                         for (d = from2; d < to2; d ++) {
                             if (d < pdispmin1 || d >= pdispmax1) d1 = BIG_I32_VAL;
                             else d1 = *dispcost1;
-                            PrevCostCache[d] = d1;
+                            prev_cost_cache[d] = d1;
                             dispcost1 += ST_DP_TEMP_BUFF_SIZE;
                         }
                     }
@@ -415,7 +488,7 @@ void svlStereoDPMono::DisparityOptimization()
                     for (d = from2; d < to2; d ++) {
                         if (d < pdispmin2 || d >= pdispmax2) d2 = BIG_I32_VAL;
                         else d2 = *dispcost2;
-                        PrevCostCache[d] = d2;
+                        prev_cost_cache[d] = d2;
                         dispcost2 += ST_DP_TEMP_BUFF_SIZE;
                     }
                 }
@@ -426,14 +499,14 @@ void svlStereoDPMono::DisparityOptimization()
                 // only for the lower right corner:
                 if ((i == ValidAreaRight - 1) && (j == ValidAreaBottom - 1)) {
                     // below narrowed search range: maximal cost
-                    dispcost1 = DisparityCost + j; // DisparityCost(0, j, i)
+                    dispcost1 = dispcostout + j; // DisparityCost(0, j, i)
                     for (d = 0; d < from1; d ++) {
                         *dispcost1 = MAX_UI16_VAL;
                         dispcost1 += ST_DP_TEMP_BUFF_SIZE;
                     }
 
                     // above narrowed search range: maximal cost
-                    dispcost1 = DisparityCost + to1 * ST_DP_TEMP_BUFF_SIZE + j; // DisparityCost(to1, j, i)
+                    dispcost1 = dispcostout + to1 * ST_DP_TEMP_BUFF_SIZE + j; // DisparityCost(to1, j, i)
                     for (d = to1; d < DisparityRange; d ++) {
                         *dispcost1 = MAX_UI16_VAL;
                         dispcost1 += ST_DP_TEMP_BUFF_SIZE;
@@ -441,142 +514,42 @@ void svlStereoDPMono::DisparityOptimization()
                 }
 
                 offset = from1 * disparitystride + ijoffset;
-                dispcost1 = DisparityCost + from1 * ST_DP_TEMP_BUFF_SIZE + j; // DisparityCost(from1, j, i)
+                dispcost1 = dispcostout + from1 * ST_DP_TEMP_BUFF_SIZE + j; // DisparityCost(from1, j, i)
                 dispgraph = DisparityGraph + offset; // DisparityCost(from1, j, i)
-                for (d = from1; d < to1; d ++) {
-
-                    // compute neighborhood range
-                    from2 = d - MaxDisparityDifference;
-                    if (from2 < 0) from2 = 0;
-                    to2 = d + MaxDisparityDifference;
-                    if (to2 > DisparityRange) to2 = DisparityRange;
-
-                    score = ScoreCache[d];
-                    if (score > ScoreTruncationLevel) score = ScoreTruncationLevel;
-                    iptr1 = PrevCostCache + from2;
-                    iptr2 = DispDiffLUT[d] + from2;
-
-                    min_cost = MAX_I32_VAL;
-					min_cost_pos = 0;
-                    for (l = from2; l < to2; l ++) {
-
-                        cost_array[l] = cost = *iptr1 + *iptr2 + score;
-
-                        iptr1 ++;
-                        iptr2 ++;
-
-                        if (cost < min_cost) {
-                            min_cost = cost;
-                            min_cost_pos = l;
-                        }
-                    }
-
-                    *dispcost1 = min_cost;
-
-                    if (!DisparityInterpolation) {
-                        *dispgraph = static_cast<unsigned short>(min_cost_pos);
-                    }
-                    else {
-                        if (min_cost_pos == from2) min_prev_cost = min_cost + 10000;
-                        else min_prev_cost = cost_array[min_cost_pos - 1];
-                        if (min_cost_pos == (to2 - 1)) min_next_cost = min_cost + 10000;
-                        else min_next_cost = cost_array[min_cost_pos + 1];
-
-                        // parabole fitting
-                        pb_min_cost_pos = ((min_cost_pos - 1) << 2);
-                        pb_h21 = (min_cost - min_prev_cost) << 1;
-                        pb_p1 = min_next_cost - min_prev_cost - pb_h21;
-                        if (pb_p1 > 0) {
-                            pb_p2 = (pb_p1 * (pb_min_cost_pos << 1)) - (pb_h21 << 3);
-                            pb_t1 = (pb_p2 / pb_p1) >> 1;
-                            pb_t2 = pb_min_cost_pos + 8;
-                            if (pb_t1 < pb_min_cost_pos) pb_t1 = pb_min_cost_pos;
-                            else if (pb_t1 > pb_t2) pb_t1 = pb_t2;
-                            *dispgraph = static_cast<unsigned short>(pb_t1);
-                        }
-                        else {
-                            *dispgraph = static_cast<unsigned short>(pb_min_cost_pos + 4);
-                        }
-                    }
-
-                    dispcost1 += ST_DP_TEMP_BUFF_SIZE;
-                    dispgraph += disparitystride;
-                }
+                ComputeNodeCosts(from1, to1, score_cache, prev_cost_cache, dispcost1, dispgraph);
 
                 // store local disparity range
-                PrevLineDispMin[j] = from1;
-                PrevLineDispMax[j] = to1;
+                PrevLineDispMin[pos & 1][j] = from1;
+                PrevLineDispMax[pos & 1][j] = to1;
             }
             else {
             // if the first frame:
             //    perform full search
 
-                // compute ScoreCache (costs from previous diagonal)
-                inputoffset = j * inputrowstride + (i << ScaleFactor);
-                right = RightImage + inputoffset;
-                left = LeftImage + inputoffset + MinDisparity + PrincipalPointOffset;
-
-                if (BlockSize > 1) {
-                    right -= halfblocksize;
-                    tmpintbuff = RightLineBuffer;
-                    for (d = 0; d < BlockSize; d ++) {
-                        *tmpintbuff = *right;
-                        tmpintbuff ++; right ++;
-                    }
-
-                    for (d = 0; d < DisparityRange; d ++) {
-                        left -= halfblocksize;
-
-                        // computing error
-                        tmpintbuff = RightLineBuffer;
-                        error = 0;
-                        for (d2 = 0; d2 < BlockSize; d2 ++) {
-                            diff = *tmpintbuff - *left;
-                            left ++; tmpintbuff ++;
-                            if (diff < 0) error -= diff;
-                            else error += diff;
-                        }
-                        // scoring
-                        ScoreCache[d] = error / BlockSize;
-
-                        left -= halfblocksize;
-                    }
-                }
-                else {
-                    rightval = *right;
+                // compute score_cache (costs from previous diagonal)
+                ComputeScores(inputoffset, 0, DisparityRange, score_cache);
 
-                    for (d = 0; d < DisparityRange; d ++) {
-                        // computing error
-                        diff = rightval - *left;
-                        left ++;
-                        if (diff < 0) error = -diff;
-                        else error = diff;
-                        // scoring
-                        ScoreCache[d] = error;
-                    }
-                }
-
-                // compute PrevCostCache
-                dispcost1 = DisparityCost + j; // DisparityCost(0, j, i - 1)
+                // compute prev_cost_cache
+                dispcost1 = dispcostin + j; // DisparityCost(0, j, i - 1)
                 dispcost2 = dispcost1 - 1 ; // DisparityCost(0, j - 1, i)
                 if (i > ValidAreaLeft) {
                     if (j > ValidAreaTop) {
                         for (d = 0; d < DisparityRange; d ++) {
-                            PrevCostCache[d] = (*dispcost1 + *dispcost2 + 1) >> 1;
+                            prev_cost_cache[d] = (*dispcost1 + *dispcost2 + 1) >> 1;
                             dispcost1 += ST_DP_TEMP_BUFF_SIZE;
                             dispcost2 += ST_DP_TEMP_BUFF_SIZE;
                         }
                     }
                     else {
                         for (d = 0; d < DisparityRange; d ++) {
-                            PrevCostCache[d] = *dispcost1;
+                            prev_cost_cache[d] = *dispcost1;
                             dispcost1 += ST_DP_TEMP_BUFF_SIZE;
                         }
                     }
                 }
                 else {
                     for (d = 0; d < DisparityRange; d ++) {
-                        PrevCostCache[d] = *dispcost2;
+                        prev_cost_cache[d] = *dispcost2;
                         dispcost2 += ST_DP_TEMP_BUFF_SIZE;
                     }
                 }
@@ -584,237 +557,315 @@ void svlStereoDPMono::DisparityOptimization()
                 ////////////////////////////////////////////////
                 // computing cost for new nodes
 
-                dispcost1 = DisparityCost + j; // DisparityCost(0, j, i)
+                dispcost1 = dispcostout + j; // DisparityCost(0, j, i)
                 dispgraph = DisparityGraph + ijoffset; // DisparityCost(0, j, i)
-                for (d = 0; d < DisparityRange; d ++) {
+                ComputeNodeCosts(0, DisparityRange, score_cache, prev_cost_cache, dispcost1, dispgraph);
+            }
+        // Processing nodes at position (i, j)
+        ////////////////////////////////////////
+        }
+
+        _SynchronizeThreads(procInfo);
+    }
 
-                    // compute neighborhood range
-                    from2 = d - MaxDisparityDifference;
-                    if (from2 < 0) from2 = 0;
-                    to2 = d + MaxDisparityDifference;
-                    if (to2 > DisparityRange) to2 = DisparityRange;
+    // Dynamic programming
+    ///////////////////////////////////////////////////////
 
-                    score = ScoreCache[d];
-                    if (score > ScoreTruncationLevel) score = ScoreTruncationLevel;
-                    iptr1 = PrevCostCache + from2;
-                    iptr2 = DispDiffLUT[d] + from2;
+    ///////////////////////////////////////////////////////////////////////////////////
+    // Going back along the lowest cost path (surface) to get the final disparity map
 
-                    min_cost = MAX_I32_VAL;
-					min_cost_pos = 0;
-                    for (l = from2; l < to2; l ++) {
+    // starting from the lower right corner:
+    _OnSingleThread(procInfo) {
+        i = ValidAreaRight - 1;
+        j = ValidAreaBottom - 1;
+
+        ijoffset = j * rowstride + i;
+
+        //   finding the lowest cost
+        min_cost = MAX_I32_VAL;
+        min_cost_pos = 0;
+        dispcost1 = DisparityCost + ((diagonals - 1) & 1) * costbuffersize + j; // DisparityCost(0, j, i)
+        for (d = 0; d < DisparityRange; d ++) {
+            cost = *dispcost1;
+            if (cost < min_cost) {
+                min_cost = cost;
+                min_cost_pos = d;
+            }
+            dispcost1 += ST_DP_TEMP_BUFF_SIZE;
+        }
+        if (!DisparityInterpolation) DisparityMap[ijoffset] = min_cost_pos;
+        else DisparityMap[ijoffset] = min_cost_pos << 2;
+    }
 
-                        cost_array[l] = cost = *iptr1 + *iptr2 + score;
+    _SynchronizeThreads(procInfo);
 
-                        iptr1 ++;
-                        iptr2 ++;
+    // walkback to process the whole graph: each node of a diagonal line
+    // gets its disparity from its right and bottom neighbors on the
+    // diagonal processed in the previous step
+    for (pos = diagonals - 2; pos >= 0; pos --) {
 
-                        if (cost < min_cost) {
-                            min_cost = cost;
-                            min_cost_pos = l;
-                        }
-                    }
+        first_i = ValidAreaLeft;
+        first_j = ValidAreaTop + pos;
+        if (first_j >= ValidAreaBottom) {
+            first_i = ValidAreaLeft + first_j - ValidAreaBottom + 1;
+            first_j = ValidAreaBottom - 1;
+        }
+        count = static_cast<unsigned int>(std::min(ValidAreaRight - first_i, first_j - ValidAreaTop + 1));
 
-                    *dispcost1 = min_cost;
+        // processing this thread's part of the diagonal line
+        _GetParallelSubRange(procInfo, count, from, to);
+        for (k = from; k < to; k ++) {
 
-                    if (!DisparityInterpolation) {
-                        *dispgraph = static_cast<unsigned short>(min_cost_pos);
-                    }
-                    else {
-                        if (min_cost_pos == from2) min_prev_cost = min_cost + 10000;
-                        else min_prev_cost = cost_array[min_cost_pos - 1];
-                        if (min_cost_pos == (to2 - 1)) min_next_cost = min_cost + 10000;
-                        else min_next_cost = cost_array[min_cost_pos + 1];
-
-                        // parabole fitting
-                        pb_min_cost_pos = ((min_cost_pos - 1) << 2);
-                        pb_h21 = (min_cost - min_prev_cost) << 1;
-                        pb_p1 = min_next_cost - min_prev_cost - pb_h21;
-                        if (pb_p1 > 0) {
-                            pb_p2 = (pb_p1 * (pb_min_cost_pos << 1)) - (pb_h21 << 3);
-                            pb_t1 = (pb_p2 / pb_p1) >> 1;
-                            pb_t2 = pb_min_cost_pos + 8;
-                            if (pb_t1 < pb_min_cost_pos) pb_t1 = pb_min_cost_pos;
-                            else if (pb_t1 > pb_t2) pb_t1 = pb_t2;
-                            *dispgraph = static_cast<unsigned short>(pb_t1);
-                        }
-                        else {
-                            *dispgraph = static_cast<unsigned short>(pb_min_cost_pos + 4);
-                        }
-                    }
+            i = first_i + k;
+            j = first_j - k;
+            ijoffset = j * rowstride + i;
 
-                    dispcost1 += ST_DP_TEMP_BUFF_SIZE;
-                    dispgraph += disparitystride;
+            if (j < ValidAreaBottom - 1) {
+                // bottom neighbor
+                disp = TraceDisparity(ijoffset + rowstride);
+                // right neighbor
+                if (i < ValidAreaRight - 1) {
+                    disp = (disp + TraceDisparity(ijoffset + 1) + 1) >> 1;
                 }
             }
-        // Processing nodes at position (i, j)
-        ////////////////////////////////////////
+            else {
+                // right neighbor
+                disp = TraceDisparity(ijoffset + 1);
+            }
+            DisparityMap[ijoffset] = disp;
+        }
 
-            i ++;
-            j --;
+        _SynchronizeThreads(procInfo);
+    }
 
-            processed = true;
-        }
+    // Going back along the lowest cost path (surface) to get the final disparity map
+    ///////////////////////////////////////////////////////////////////////////////////
 
-    } while (processed);
+    return SVL_OK;
+}
 
-    // Dynamic programming
-    ///////////////////////////////////////////////////////
+// *******************************************************************
+// svlStereoDPMono::ComputeNodeCosts PRIVATE method
+// arguments:
+//           from, to       - disparity range of the node
+//           scores         - block matching scores of the node
+//           prevcosts      - costs inherited from the neighboring nodes
+//           dispcost       - DisparityCost(from, j, i)
+//           dispgraph      - DisparityGraph(from, j, i)
+// function:
+//    Computes the cost and the best predecessor disparity for each
+//    disparity of a node. prevcosts has to be padded with
+//    MaxDisparityDifference elements of ST_DP_PADDING_COST on each side.
+// *******************************************************************
+void svlStereoDPMono::ComputeNodeCosts(const int from, const int to, const int* scores, const int* prevcosts,
+                                      unsigned short* dispcost, unsigned short* dispgraph)
+{
+    const int disparitystride = SurfaceWidth * SurfaceHeight;
+    const int *iptr1, *iptr2;
+    int d, l, from2, to2;
+    int cost, min_cost, min_cost_pos, score;
+    int min_prev_cost, min_next_cost;
+    int pb_min_cost_pos, pb_h21, pb_p1, pb_p2, pb_t1, pb_t2;
+    int cost_array[1024];
+    int min_costs[ST_DP_TEMP_BUFF_SIZE];
+    int min_positions[ST_DP_TEMP_BUFF_SIZE];
 
-    ///////////////////////////////////////////////////////////////////////////////////
-    // Going back along the lowest cost path (surface) to get the final disparity map
+    const bool simd = svlImageProcessingSIMD::StereoMinimizeCosts(prevcosts, DispDiffLUT[0], scores, ScoreTruncationLevel,
+                                                                  from, to, MaxDisparityDifference,
+                                                                  min_costs, min_positions);
 
-    pos -= 1;
+    for (d = from; d < to; d ++) {
 
-    // starting from the lower right corner:
-    i = ValidAreaRight - 1;
-    j = ValidAreaBottom - 1;
-
-    ijoffset = j * rowstride + i;
-
-    //   finding the lowest cost
-    min_cost = MAX_I32_VAL;
-	min_cost_pos = 0;
-    dispcost1 = DisparityCost + j; // DisparityCost(0, j, i)
-    for (d = 0; d < DisparityRange; d ++) {
-        cost = *dispcost1;
-        if (cost < min_cost) {
-            min_cost = cost;
-            min_cost_pos = d;
-        }
-        dispcost1 += ST_DP_TEMP_BUFF_SIZE;
-    }
-    if (!DisparityInterpolation) DisparityMap[ijoffset] = min_cost_pos;
-    else DisparityMap[ijoffset] = min_cost_pos << 2;
-
-    // "recursive" walkback to process the whole graph
-    do {
-        i = ValidAreaLeft;
-        j = ValidAreaTop + pos;
-        if (j >= ValidAreaBottom) {
-            i = ValidAreaLeft + j - ValidAreaBottom + 1;
-            j = ValidAreaBottom - 1;
+        // compute neighborhood range
+        from2 = d - MaxDisparityDifference;
+        if (from2 < 0) from2 = 0;
+        to2 = d + MaxDisparityDifference;
+        if (to2 > DisparityRange) to2 = DisparityRange;
+
+        score = scores[d];
+        if (score > ScoreTruncationLevel) score = ScoreTruncationLevel;
+
+        if (simd) {
+            min_cost = min_costs[d];
+            min_cost_pos = min_positions[d];
+
+            // the only neighbors needed for the interpolation
+            if (min_cost_pos > from2) cost_array[min_cost_pos - 1] = prevcosts[min_cost_pos - 1] + DispDiffLUT[d][min_cost_pos - 1] + score;
+            if (min_cost_pos < to2 - 1) cost_array[min_cost_pos + 1] = prevcosts[min_cost_pos + 1] + DispDiffLUT[d][min_cost_pos + 1] + score;
         }
-        pos --;
+        else {
+            iptr1 = prevcosts + from2;
+            iptr2 = DispDiffLUT[d] + from2;
 
-        // processing next diagonal line
-        while (i < ValidAreaRight && j >= ValidAreaTop) {
+            min_cost = MAX_I32_VAL;
+            min_cost_pos = 0;
+            for (l = from2; l < to2; l ++) {
 
-            ijoffset = j * rowstride + i;
+                cost_array[l] = cost = *iptr1 + *iptr2 + score;
 
-        ////////////////////////////////////////
-        // processing graph at position (i, j)
+                iptr1 ++;
+                iptr2 ++;
 
-            if (!DisparityInterpolation) {
-                disp = DisparityMap[ijoffset];
-                if (disp >= DisparityRange) disp = DisparityRange - 1;
-                offset = disp * disparitystride + ijoffset;
-                disp = DisparityGraph[offset]; // DisparityGraph(DisparityMap(j, i), j, i)
-            }
-            else {
-                disp = DisparityMap[ijoffset];
-                weight2 = disp % 4;
-                weight1 = 4 - weight2;
-                disp >>= 2;
-                if (disp < (DisparityRange - 1)) {
-                    offset = disp * disparitystride + ijoffset;
-                    disp = DisparityGraph[offset];
-                    offset += disparitystride;
-                    disp2 = DisparityGraph[offset];
-                    disp = (disp * weight1 + disp2 * weight2) >> 2;
-                }
-                else {
-                    offset = (DisparityRange - 1) * disparitystride + ijoffset;
-                    disp = DisparityGraph[offset];
+                if (cost < min_cost) {
+                    min_cost = cost;
+                    min_cost_pos = l;
                 }
             }
+        }
 
-            // left neighbor
-            if (i > ValidAreaLeft) {
-                offset = ijoffset - 1;
-                if (j < ValidAreaBottom - 1) {
-                    DisparityMap[offset] = (DisparityMap[offset] + disp + 1) >> 1;
-                }
-                else {
-                    DisparityMap[offset] = disp;
-                }
+        *dispcost = static_cast<unsigned short>(min_cost);
+
+        if (!DisparityInterpolation) {
+            *dispgraph = static_cast<unsigned short>(min_cost_pos);
+        }
+        else {
+            if (min_cost_pos == from2) min_prev_cost = min_cost + 10000;
+            else min_prev_cost = cost_array[min_cost_pos - 1];
+            if (min_cost_pos == (to2 - 1)) min_next_cost = min_cost + 10000;
+            else min_next_cost = cost_array[min_cost_pos + 1];
+
+            // parabole fitting
+            pb_min_cost_pos = ((min_cost_pos - 1) << 2);
+            pb_h21 = (min_cost - min_prev_cost) << 1;
+            pb_p1 = min_next_cost - min_prev_cost - pb_h21;
+            if (pb_p1 > 0) {
+                pb_p2 = (pb_p1 * (pb_min_cost_pos << 1)) - (pb_h21 << 3);
+                pb_t1 = (pb_p2 / pb_p1) >> 1;
+                pb_t2 = pb_min_cost_pos + 8;
+                if (pb_t1 < pb_min_cost_pos) pb_t1 = pb_min_cost_pos;
+                else if (pb_t1 > pb_t2) pb_t1 = pb_t2;
+                *dispgraph = static_cast<unsigned short>(pb_t1);
             }
-            // top neighbor
-            if (j > ValidAreaTop) {
-                offset = ijoffset - rowstride;
-                DisparityMap[offset] = disp;
+            else {
+                *dispgraph = static_cast<unsigned short>(pb_min_cost_pos + 4);
             }
+        }
 
-        // Processing graph at position (i, j)
-        ////////////////////////////////////////
+        dispcost += ST_DP_TEMP_BUFF_SIZE;
+        dispgraph += disparitystride;
+    }
+}
 
-            i ++;
-            j --;
-        }
+// *******************************************************************
+// svlStereoDPMono::TraceDisparity PRIVATE method
+// arguments:
+//           ijoffset       - position of the node on the disparity map
+// function:
+//    Follows the lowest cost path from a node to its left and top
+//    neighbors: returns the disparity stored in the graph for the
+//    node's disparity
+// *******************************************************************
+int svlStereoDPMono::TraceDisparity(const int ijoffset)
+{
+    const int disparitystride = SurfaceWidth * SurfaceHeight;
+    int disp, disp2, weight1, weight2, offset;
 
-    } while (pos > 0);
+    if (!DisparityInterpolation) {
+        disp = DisparityMap[ijoffset];
+        if (disp >= DisparityRange) disp = DisparityRange - 1;
+        offset = disp * disparitystride + ijoffset;
+        disp = DisparityGraph[offset]; // DisparityGraph(DisparityMap(j, i), j, i)
+    }
+    else {
+        disp = DisparityMap[ijoffset];
+        weight2 = disp % 4;
+        weight1 = 4 - weight2;
+        disp >>= 2;
+        if (disp < (DisparityRange - 1)) {
+            offset = disp * disparitystride + ijoffset;
+            disp = DisparityGraph[offset];
+            offset += disparitystride;
+            disp2 = DisparityGraph[offset];
+            disp = (disp * weight1 + disp2 * weight2) >> 2;
+        }
+        else {
+            offset = (DisparityRange - 1) * disparitystride + ijoffset;
+            disp = DisparityGraph[offset];
+        }
+    }
 
-    // Going back along the lowest cost path (surface) to get the final disparity map
-    ///////////////////////////////////////////////////////////////////////////////////
+    return disp;
 }
 
 // *******************************************************************
 // svlStereoDPMono::FilterDisparityMap PRIVATE method
 // arguments:
+//           procInfo       - thread information
 // function:
 //    Performs temporal filtering if enabled
 // *******************************************************************
-void svlStereoDPMono::FilterDisparityMap()
+int svlStereoDPMono::FilterDisparityMap(svlProcInfo* procInfo)
 {
-    if (fabs(TemporalFilter) < 0.01) return;
+    if (fabs(TemporalFilter) < 0.01) return SVL_OK;
+
+    unsigned int from, to;
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(SurfaceHeight), from, to);
+    if (to < from) to = from;
 
     if (FrameCounter > 0) {
         int i, j;
-        unsigned short *dmap = DisparityMap;
-        unsigned short *tdmap = DisparityMapTemp;
+        unsigned short *dmap = DisparityMap + from * SurfaceWidth;
+        unsigned short *tdmap = DisparityMapTemp + from * SurfaceWidth;
         const int tfilt = static_cast<int>(TemporalFilter * 256);
         const int dvdr = 256 + tfilt;
 
-        for (j = 0; j < SurfaceHeight; j ++) {
+        for (j = from; j < static_cast<int>(to); j ++) {
             for (i = 0; i < SurfaceWidth; i ++) {
                 *tdmap = static_cast<unsigned short>((( static_cast<int>(*tdmap) * tfilt) + (*dmap << 8)) / dvdr);
                 dmap ++; tdmap ++;
             }
         }
+
+        _SynchronizeThreads(procInfo);
+
         // swapping disparity buffers
-        unsigned short *tbuff;
-        tbuff = DisparityMap;
-        DisparityMap = DisparityMapTemp;
-        DisparityMapTemp = tbuff;
+        _OnSingleThread(procInfo) {
+            unsigned short *tbuff;
+            tbuff = DisparityMap;
+            DisparityMap = DisparityMapTemp;
+            DisparityMapTemp = tbuff;
+        }
     }
     else {
-        memcpy(DisparityMapTemp, DisparityMap, SurfaceWidth * SurfaceHeight * sizeof(unsigned short));
+        memcpy(DisparityMapTemp + from * SurfaceWidth,
+               DisparityMap + from * SurfaceWidth,
+               (to - from) * SurfaceWidth * sizeof(unsigned short));
     }
+
+    _SynchronizeThreads(procInfo);
+
+    return SVL_OK;
 }
 
 // *******************************************************************
 // svlStereoDPMono::RenderDisparityMap PRIVATE method
 // arguments:
+//           procInfo       - thread information, each thread renders a band of rows
 //           disparitymap   - output image pointer (non-padded, signed int32)
 // function:
 //    Stretches the scaled-down disparity map to full scale
 // *******************************************************************
-void svlStereoDPMono::RenderDisparityMap(int *disparitymap)
+void svlStereoDPMono::RenderDisparityMap(svlProcInfo* procInfo, int *disparitymap)
 {
     const int scale = 1 << ScaleFactor;
     const int nextrowstride = InputWidth - scale;
-    const int blockrowstride = InputWidth * (scale - 1);
 
-    int *output;
-    unsigned short *dmap = DisparityMap;
-    int i, j, k, l, val, dispoffset;
+    int *output, *outputrow;
+    unsigned short *dmap;
+    unsigned int j, from, to;
+    int i, k, l, val, dispoffset;
 
     if (DisparityInterpolation) dispoffset = (MinDisparity + PrincipalPointOffset) << 2;
     else dispoffset = MinDisparity + PrincipalPointOffset;
 
-    for (j = 0; j < SurfaceHeight; j ++) {
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(SurfaceHeight), from, to);
+
+    for (j = from; j < to; j ++) {
+        dmap = DisparityMap + j * SurfaceWidth;
+        outputrow = disparitymap + j * scale * InputWidth;
         for (i = 0; i < SurfaceWidth; i ++) {
             val = *dmap + dispoffset;
-            output = disparitymap;
+            output = outputrow;
             for (l = 0; l < scale; l ++) {
                 for (k = 0; k < scale; k ++) {
                     *output = val;
@@ -823,9 +874,7 @@ void svlStereoDPMono::RenderDisparityMap(int *disparitymap)
                 output += nextrowstride;
             }
             dmap ++;
-            disparitymap += scale;
+            outputrow += scale;
         }
-        disparitymap += blockrowstride;
     }
 }
-
@@ -45,6 +45,7 @@ public:
 
     virtual int Initialize();
     virtual int Process(svlSampleImage *images, int *disparitymap);
+    virtual int Process(svlProcInfo *procInfo, svlSampleImage *images, int *disparitymap);
     virtual void Free();
 
 private:
@@ -81,7 +82,6 @@ private:
 
     int *LeftImage;
     int *RightImage;
-    int *RightLineBuffer;
     unsigned short *DisparityMap;
     unsigned short *DisparityGraph;
     unsigned short *DisparityCost;
@@ -89,25 +89,29 @@ private:
     unsigned short *DisparityMapTemp;
 
     int DispDiffLUT[256][256];
-    int ScoreCache[ST_DP_TEMP_BUFF_SIZE];
-    int PrevCostCache[ST_DP_TEMP_BUFF_SIZE];
-    unsigned short PrevLineDispMin[ST_DP_TEMP_BUFF_SIZE];
-    unsigned short PrevLineDispMax[ST_DP_TEMP_BUFF_SIZE];
+    // Per diagonal of the graph, alternating between two buffers
+    unsigned short PrevLineDispMin[2][ST_DP_TEMP_BUFF_SIZE];
+    unsigned short PrevLineDispMax[2][ST_DP_TEMP_BUFF_SIZE];
 
     //////////////////////////
     // Functions
 
-    void DisparityOptimization();
-    void FilterDisparityMap();
-    void RenderDisparityMap(int *disparitymap);
+    void ComputeScores(const int inputoffset, const int from, const int to, int* scores);
+    void ComputeNodeCosts(const int from, const int to, const int* scores, const int* prevcosts,
+                          unsigned short* dispcost, unsigned short* dispgraph);
+    int  DisparityOptimization(svlProcInfo* procInfo);
+    int  TraceDisparity(const int ijoffset);
+    int  FilterDisparityMap(svlProcInfo* procInfo);
+    void RenderDisparityMap(svlProcInfo* procInfo, int *disparitymap);
 
     template <class _paramType>
-    void CreateScale(_paramType *src_img, int *dest_img);
+    void CreateScale(svlProcInfo* procInfo, _paramType *src_img, int *dest_img);
 };
 
 // *******************************************************************
 // CreateScale PRIVATE method
 // arguments:
+//           procInfo       - thread information, each thread scales a band of rows
 //           src_img        - input image pointer
 //           dest_img       - output image pointer
 // function:
@@ -115,15 +119,20 @@ private:
 //    Horizontal size preserved for maximal depth resolution
 // *******************************************************************
 template <class _paramType>
-void svlStereoDPMono::CreateScale(_paramType *src_img, int *dest_img)
+void svlStereoDPMono::CreateScale(svlProcInfo* procInfo, _paramType *src_img, int *dest_img)
 {
-    int i, j, l, val;
+    int i, l, val;
+    unsigned int j, from, to;
     const int magfact = 1 << ScaleFactor;
-    const int srclinestep = InputWidth * sizeof(_paramType);
-    const int srcblockstep_y = (magfact - 1) * InputWidth * sizeof(_paramType);
+    const int srclinestep = InputWidth;
+    const int srcblockstep_y = (magfact - 1) * InputWidth;
     _paramType *tsrc = 0;
 
-    for (j = 0; j < ScaleHeight; j ++) {
+    _GetParallelSubRange(procInfo, static_cast<unsigned int>(ScaleHeight), from, to);
+    src_img += from * magfact * InputWidth;
+    dest_img += from * ScaleWidth;
+
+    for (j = from; j < to; j ++) {
         for (i = 0; i < ScaleWidth; i ++) {
 
             tsrc = src_img;
@@ -31,6 +31,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstOSAbstraction/osaThread.h>
 #include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
 
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 
@@ -43,11 +45,19 @@ CMN_IMPLEMENT_SERVICES(svlStreamManager);
 svlStreamManager::svlStreamManager() :
     ThreadCount(1),
     SyncPoint(0),
+    SyncType(svlSyncSignals),
     CS(0),
     StreamSource(0),
     Initialized(false),
     Running(false),
-    StreamStatus(SVL_STREAM_CREATED)
+    StreamStatus(SVL_STREAM_CREATED),
+    Pipelined(false),
+    PipelineQueueSize(2),
+    PipelineTimeServer(0),
+    PipelineLatencySum(0.0),
+    PipelineLatencyMax(0.0),
+    PipelineFrames(0),
+    PipelineDrained(0)
 {
     CreateInterfaces();
 }
@@ -55,11 +65,19 @@ svlStreamManager::svlStreamManager() :
 svlStreamManager::svlStreamManager(unsigned int threadcount) :
     ThreadCount(std::max(1u, threadcount)),
     SyncPoint(0),
+    SyncType(svlSyncSignals),
     CS(0),
     StreamSource(0),
     Initialized(false),
     Running(false),
-    StreamStatus(SVL_STREAM_CREATED)
+    StreamStatus(SVL_STREAM_CREATED),
+    Pipelined(false),
+    PipelineQueueSize(2),
+    PipelineTimeServer(0),
+    PipelineLatencySum(0.0),
+    PipelineLatencyMax(0.0),
+    PipelineFrames(0),
+    PipelineDrained(0)
 {
     CreateInterfaces();
     // To do: autodetect the number of available processor cores
@@ -240,19 +258,22 @@ void svlStreamManager::Release(void)
     svlFilterOutput * output;
     svlFilterInput * input;
 
-    // There might be a thread object still open (in case of an internal shutdown)
-    for (i = 0; i < StreamProcInstance.size(); i ++) {
-        if (StreamProcInstance[i]) {
-            delete StreamProcInstance[i];
-            StreamProcInstance[i] = 0;
-        }
-    }
+    // There might be a thread object still open (in case of an internal shutdown);
+    // the thread may still be finishing InternalStop() so wait for it first
     for (i = 0; i < StreamProcThread.size(); i ++) {
         if (StreamProcThread[i]) {
+            StreamProcThread[i]->Wait();
             delete StreamProcThread[i];
             StreamProcThread[i] = 0;
         }
     }
+    for (i = 0; i < StreamProcInstance.size(); i ++) {
+        if (StreamProcInstance[i]) {
+            delete StreamProcInstance[i];
+            StreamProcInstance[i] = 0;
+        }
+    }
+    DeletePipeline();
 
     // Release the stream, starting from the stream source
     svlFilterBase *filter = StreamSource;
@@ -336,7 +357,8 @@ int svlStreamManager::Play(void)
     svlFilterBase * filter = StreamSource;
     while (filter) {
         filter->Running = true;
-        if (filter->OnStart(ThreadCount) != SVL_OK) {
+        // In pipeline mode each filter runs on a single thread
+        if (filter->OnStart(Pipelined ? 1 : ThreadCount) != SVL_OK) {
             Stop();
             CMN_LOG_CLASS_RUN_ERROR << "Play: filter \"" << filter->GetName()
                                     << "\" \"OnStart\" method failed while starting stream \""
@@ -359,27 +381,37 @@ int svlStreamManager::Play(void)
         }
     }
 
-    // There might be a thread object still open (in case of an internal shutdown)
-    for (i = 0; i < StreamProcInstance.size(); i ++) {
-        if (StreamProcInstance[i]) {
-            delete StreamProcInstance[i];
-            StreamProcInstance[i] = 0;
-        }
-    }
+    // There might be a thread object still open (in case of an internal shutdown);
+    // the thread may still be finishing InternalStop() so wait for it first
     for (i = 0; i < StreamProcThread.size(); i ++) {
         if (StreamProcThread[i]) {
+            StreamProcThread[i]->Wait();
             delete StreamProcThread[i];
             StreamProcThread[i] = 0;
         }
     }
+    for (i = 0; i < StreamProcInstance.size(); i ++) {
+        if (StreamProcInstance[i]) {
+            delete StreamProcInstance[i];
+            StreamProcInstance[i] = 0;
+        }
+    }
+    DeletePipeline();
 
-    // Allocate new thread control object array
-    StreamProcInstance.SetSize(ThreadCount);
-    StreamProcThread.SetSize(ThreadCount);
+    if (Pipelined) {
+        // Create stages, their queues and thread control objects
+        CreatePipeline();
+    }
+    else {
+        // Allocate new thread control object array
+        StreamProcInstance.SetSize(ThreadCount);
+        StreamProcThread.SetSize(ThreadCount);
+    }
 
     // Create thread synchronization object
-    if (ThreadCount > 1) {
+    if (ThreadCount > 1 && !Pipelined) {
         SyncPoint = new svlSyncPoint;
+        SyncPoint->Type(SyncType);
         SyncPoint->Count(ThreadCount);
         CS = new osaCriticalSection;
     }
@@ -391,11 +423,20 @@ int svlStreamManager::Play(void)
     if (StreamSource->PlayCounter != 0) StreamSource->PauseAtFrameID = -1;
     else StreamSource->PauseAtFrameID = 0;
 
-    for (i = 0; i < ThreadCount; i ++) {
-        // Starting multi thread processing
-        StreamProcInstance[i] = new svlStreamProc(ThreadCount, static_cast<unsigned int>(i));
-        StreamProcThread[i] = new osaThread;
-        StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::Proc, this);
+    if (Pipelined) {
+        for (i = 0; i < StreamProcInstance.size(); i ++) {
+            // Starting one thread per pipeline stage
+            StreamProcThread[i] = new osaThread;
+            StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::PipelineProc, this);
+        }
+    }
+    else {
+        for (i = 0; i < ThreadCount; i ++) {
+            // Starting multi thread processing
+            StreamProcInstance[i] = new svlStreamProc(ThreadCount, static_cast<unsigned int>(i));
+            StreamProcThread[i] = new osaThread;
+            StreamProcThread[i]->Create<svlStreamProc, svlStreamManager*>(StreamProcInstance[i], &svlStreamProc::Proc, this);
+        }
     }
 
     // Start all filter outputs recursively, if any
@@ -505,7 +546,7 @@ void svlStreamManager::Stop(void)
                                                       mtsComponentState::READY));
 
     // Stopping multi thread processing and delete thread objects
-    for (size_t i = 0; i < ThreadCount; i ++) {
+    for (size_t i = 0; i < StreamProcThread.size(); i ++) {
         if (StreamProcThread[i]) {
             StreamProcThread[i]->Wait();
             delete StreamProcThread[i];
@@ -520,6 +561,7 @@ void svlStreamManager::Stop(void)
     // Release thread control arrays and objects
     StreamProcThread.SetSize(0);
     StreamProcInstance.SetSize(0);
+    DeletePipeline();
     if (SyncPoint) {
         delete SyncPoint;
         SyncPoint = 0;
@@ -546,6 +588,13 @@ void svlStreamManager::Stop(void)
     }
 
     StreamStatus = SVL_STREAM_STOPPED;
+
+    if (Pipelined) {
+        CMN_LOG_CLASS_RUN_VERBOSE << "Stop: stream \"" << this->GetName() << "\" processed "
+                                  << PipelineFrames << " frames in " << PipelineBusyTime.size()
+                                  << " pipeline stages, average latency: " << GetPipelineAverageLatency()
+                                  << " s, maximum latency: " << PipelineLatencyMax << " s" << std::endl;
+    }
 }
 
 void svlStreamManager::InternalStop(unsigned int callingthreadID)
@@ -612,7 +661,7 @@ void svlStreamManager::InternalStop(unsigned int callingthreadID)
                                                       mtsComponentState::READY));
 
     // Stopping multi thread processing and delete thread objects
-    for (size_t i = 0; i < ThreadCount; i ++) {
+    for (size_t i = 0; i < StreamProcThread.size(); i ++) {
         if (i != callingthreadID) {
             if (StreamProcThread[i]) {
                 StreamProcThread[i]->Wait();
@@ -655,6 +704,13 @@ void svlStreamManager::InternalStop(unsigned int callingthreadID)
             if (input && input->Trunk) filter = input->Filter;
         }
     }
+
+    if (Pipelined) {
+        CMN_LOG_CLASS_RUN_VERBOSE << "InternalStop: stream \"" << this->GetName() << "\" processed "
+                                  << PipelineFrames << " frames in " << PipelineBusyTime.size()
+                                  << " pipeline stages, average latency: " << GetPipelineAverageLatency()
+                                  << " s, maximum latency: " << PipelineLatencyMax << " s" << std::endl;
+    }
 }
 
 bool svlStreamManager::IsRunning(void) const
@@ -719,6 +775,144 @@ void svlStreamManager::DisconnectAll(void)
     }
 }
 
+int svlStreamManager::SetSyncType(svlSyncType type)
+{
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetSyncType: stream \"" << this->GetName()
+                                 << "\" is already running, can't change thread synchronization" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    SyncType = type;
+    return SVL_OK;
+}
+
+svlSyncType svlStreamManager::GetSyncType(void) const
+{
+    return SyncType;
+}
+
+int svlStreamManager::SetPipelineMode(bool enable, unsigned int queuesize)
+{
+    if (Running) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetPipelineMode: stream \"" << this->GetName()
+                                 << "\" is already running, can't change execution mode" << std::endl;
+        return SVL_ALREADY_RUNNING;
+    }
+    Pipelined = enable;
+    PipelineQueueSize = std::max(1u, queuesize);
+    return SVL_OK;
+}
+
+bool svlStreamManager::GetPipelineMode(void) const
+{
+    return Pipelined;
+}
+
+unsigned int svlStreamManager::GetPipelineStageCount(void) const
+{
+    return static_cast<unsigned int>(PipelineBusyTime.size());
+}
+
+double svlStreamManager::GetPipelineStageOccupancy(unsigned int stage) const
+{
+    if (stage >= PipelineBusyTime.size() || PipelineElapsedTime[stage] <= 0.0) return 0.0;
+    return PipelineBusyTime[stage] / PipelineElapsedTime[stage];
+}
+
+double svlStreamManager::GetPipelineAverageLatency(void) const
+{
+    if (PipelineFrames == 0) return 0.0;
+    return PipelineLatencySum / PipelineFrames;
+}
+
+double svlStreamManager::GetPipelineMaximumLatency(void) const
+{
+    return PipelineLatencyMax;
+}
+
+unsigned int svlStreamManager::GetPipelineFrameCount(void) const
+{
+    return PipelineFrames;
+}
+
+void svlStreamManager::CreatePipeline(void)
+{
+    svlFilterOutput * output;
+    svlFilterInput * input;
+    unsigned int i, stage;
+
+    // Collect trunk filters, starting from the stream source
+    std::vector<svlFilterBase*> filters;
+    svlFilterBase * filter = StreamSource;
+    while (filter) {
+        filters.push_back(filter);
+
+        // Get next filter in the trunk
+        output = filter->GetOutput();
+        filter = 0;
+        // Check if trunk output exists
+        if (output) {
+            input = output->Connection;
+            // Check if trunk output is connected to a trunk input
+            if (input && input->Trunk) filter = input->Filter;
+        }
+    }
+
+    // Contiguous filters are assigned evenly to stages
+    const unsigned int filtercount = static_cast<unsigned int>(filters.size());
+    const unsigned int stagecount = std::min(ThreadCount, filtercount);
+
+    PipelineQueues.SetSize(stagecount - 1);
+    for (i = 0; i < PipelineQueues.size(); i ++) {
+        PipelineQueues[i] = new svlStreamPipelineQueue(PipelineQueueSize);
+    }
+
+    StreamProcInstance.SetSize(stagecount);
+    StreamProcThread.SetSize(stagecount);
+    StreamProcThread.SetAll(0);
+    unsigned int first = 0, last;
+    for (stage = 0; stage < stagecount; stage ++) {
+        last = (filtercount * (stage + 1)) / stagecount;
+        StreamProcInstance[stage] = new svlStreamProc(stage, filters[first], last - first,
+                                                      stage > 0 ? PipelineQueues[stage - 1] : 0,
+                                                      stage + 1 < stagecount ? PipelineQueues[stage] : 0);
+        CMN_LOG_CLASS_INIT_VERBOSE << "CreatePipeline: stream \"" << this->GetName() << "\" stage "
+                                   << stage << " runs filters \"" << filters[first]->GetName()
+                                   << "\" to \"" << filters[last - 1]->GetName() << "\"" << std::endl;
+        first = last;
+    }
+
+    // Reset statistics
+    PipelineBusyTime.SetSize(stagecount);
+    PipelineBusyTime.SetAll(0.0);
+    PipelineElapsedTime.SetSize(stagecount);
+    PipelineElapsedTime.SetAll(0.0);
+    PipelineLatencySum = 0.0;
+    PipelineLatencyMax = 0.0;
+    PipelineFrames = 0;
+    PipelineDrained = new osaThreadSignal;
+
+    PipelineTimeServer = new osaTimeServer;
+    PipelineTimeServer->SetTimeOrigin();
+}
+
+void svlStreamManager::DeletePipeline(void)
+{
+    // Samples left in the queues are owned by the queues
+    for (size_t i = 0; i < PipelineQueues.size(); i ++) {
+        if (PipelineQueues[i]) delete PipelineQueues[i];
+    }
+    PipelineQueues.SetSize(0);
+    if (PipelineTimeServer) {
+        delete PipelineTimeServer;
+        PipelineTimeServer = 0;
+    }
+    if (PipelineDrained) {
+        delete PipelineDrained;
+        PipelineDrained = 0;
+    }
+}
+
 void svlStreamManager::CreateInterfaces(void)
 {
     mtsInterfaceProvided * interfaceProvided = this->AddInterfaceProvided("Control", MTS_COMMANDS_SHOULD_NOT_BE_QUEUED);
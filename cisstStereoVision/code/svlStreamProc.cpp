@@ -29,13 +29,87 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaSleep.h>
 
 
+/**************************************/
+/*** svlStreamPipelineQueue class *****/
+/**************************************/
+
+svlStreamPipelineQueue::svlStreamPipelineQueue(unsigned int size) :
+    Size(std::max(1u, size)),
+    Slots(0)
+{
+    Slots = new Slot[Size];
+    for (unsigned int i = 0; i < Size; i ++) {
+        Slots[i].Sample = 0;
+        Slots[i].HasSample = false;
+        Slots[i].EndOfStream = false;
+        Slots[i].FrameCounter = 0;
+        Slots[i].StartTime = 0.0;
+    }
+    Head.StoreRelaxed(0);
+    Tail.StoreRelaxed(0);
+}
+
+svlStreamPipelineQueue::~svlStreamPipelineQueue()
+{
+    for (unsigned int i = 0; i < Size; i ++) {
+        if (Slots[i].Sample) delete Slots[i].Sample;
+    }
+    delete [] Slots;
+}
+
+bool svlStreamPipelineQueue::IsAborted(svlStreamManager* baseref) const
+{
+    return baseref->StopThread || baseref->StreamStatus != SVL_OK;
+}
+
+svlStreamPipelineQueue::Slot* svlStreamPipelineQueue::GetFreeSlot(svlStreamManager* baseref)
+{
+    // Only the producer modifies Head
+    const unsigned int head = Head.LoadRelaxed();
+    while (head - Tail.Load() >= Size) {
+        if (IsAborted(baseref)) return 0;
+        // Timeout to check the stop flag periodically
+        NotFull.Wait(0.05);
+    }
+    return Slots + (head % Size);
+}
+
+void svlStreamPipelineQueue::Push(void)
+{
+    Head.Store(Head.LoadRelaxed() + 1);
+    NotEmpty.Raise();
+}
+
+svlStreamPipelineQueue::Slot* svlStreamPipelineQueue::GetFilledSlot(svlStreamManager* baseref)
+{
+    // Only the consumer modifies Tail
+    const unsigned int tail = Tail.LoadRelaxed();
+    while (Head.Load() == tail) {
+        if (IsAborted(baseref)) return 0;
+        // Timeout to check the stop flag periodically
+        NotEmpty.Wait(0.05);
+    }
+    return Slots + (tail % Size);
+}
+
+void svlStreamPipelineQueue::Release(void)
+{
+    Tail.Store(Tail.LoadRelaxed() + 1);
+    NotFull.Raise();
+}
+
+
 /*****************************/
 /*** svlStreamProc class *****/
 /*****************************/
 
 svlStreamProc::svlStreamProc(unsigned int threadcount, unsigned int threadid) :
     ThreadID(threadid),
-    ThreadCount(threadcount)
+    ThreadCount(threadcount),
+    FirstFilter(0),
+    FilterCount(0),
+    InputQueue(0),
+    OutputQueue(0)
 {
 }
 
@@ -309,3 +383,272 @@ void* svlStreamProc::Proc(svlStreamManager* baseref)
     return this;
 }
 
+svlStreamProc::svlStreamProc(unsigned int stageid, svlFilterBase* firstfilter, unsigned int filtercount,
+                             svlStreamPipelineQueue* inputqueue, svlStreamPipelineQueue* outputqueue) :
+    ThreadID(stageid),
+    ThreadCount(1),
+    FirstFilter(firstfilter),
+    FilterCount(filtercount),
+    InputQueue(inputqueue),
+    OutputQueue(outputqueue)
+{
+}
+
+void* svlStreamProc::PipelineProc(svlStreamManager* baseref)
+{
+    svlStreamPipelineQueue::Slot *inputslot, *outputslot;
+    svlSample *inputsample, *outputsample;
+    svlFilterBase *filter;
+    svlFilterSourceBase* source = baseref->StreamSource;
+    svlFilterOutput* output;
+    svlFilterInput* input;
+    svlProcInfo info;
+    osaTimeServer* timeserver = baseref->PipelineTimeServer;
+    unsigned int i, counter = 0;
+    double timestamp, starttime, busystart, busytime = 0.0;
+    const double stagestart = timeserver->GetRelativeTime();
+    bool stoprequest = false, endofstream = false;
+    int status = SVL_OK;
+
+    // Filters of a stage are processed on a single thread
+    info.count = 1;
+    info.ID    = 0;
+    info.sync  = 0;
+    info.cs    = 0;
+
+    while (baseref->StopThread == false) {
+        inputslot = 0;
+        outputsample = 0;
+
+        if (InputQueue == 0) {
+        // First stage only - BEGIN
+
+            ///////////////////////////////////////
+            // Handle stream control (pause/play)
+
+            if (source->PauseAtFrameID == static_cast<int>(counter)) {
+                // Wait until playback resumed or stream stopped
+                while (source->PlayCounter == 0 && baseref->StopThread == false) {
+                    osaSleep(0.1); // check 10 times a second
+                }
+                if (baseref->StopThread) {
+                    CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): stream stopped while paused" << std::endl;
+                    break;
+                }
+            }
+
+            if (source->PlayCounter > 0) source->PlayCounter --;
+            if (source->PlayCounter == 0) {
+                // Pause when the next frame arrives
+                source->PauseAtFrameID = static_cast<int>(counter) + 1;
+            }
+
+            starttime = busystart = timeserver->GetRelativeTime();
+
+        // First stage only - END
+        }
+        else {
+            // Wait for the previous stage
+            inputslot = InputQueue->GetFilledSlot(baseref);
+            if (inputslot == 0) {
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << "): stream stopped while waiting for input" << std::endl;
+                break;
+            }
+            busystart = timeserver->GetRelativeTime();
+            if (inputslot->EndOfStream) {
+                InputQueue->Release();
+                endofstream = true;
+                break;
+            }
+            counter = inputslot->FrameCounter;
+            starttime = inputslot->StartTime;
+            if (inputslot->HasSample) outputsample = inputslot->Sample;
+        }
+
+    ////////////////////////////////////////////
+    // Going downstream filter by filter
+
+        filter = FirstFilter;
+        for (i = 0; i < FilterCount && filter != 0; i ++) {
+            filter->FrameCounter = counter;
+
+            if (filter == source) {
+                status = source->Process(&info, outputsample);
+                if (status == SVL_STOP_REQUEST) {
+                    CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): SVL_STOP_REQUEST received" << std::endl;
+                    stoprequest = true;
+                    break;
+                }
+                else if (status < 0) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << source->GetName() << "\"): svlFilterSourceBase::Process() returned error (" << status << ")" << std::endl;
+                    break;
+                }
+
+                if (outputsample && (source->AutoTimestamp || outputsample->GetTimestamp() < 0.0)) {
+                    // Get fresh timestamp and assign it to the output sample
+                    outputsample->SetTimestamp(GetAbsoluteTime(timeserver));
+                }
+            }
+            else {
+                // Pass samples downstream
+                inputsample = outputsample; outputsample = 0;
+
+                // Check if the previous output is valid input for the next filter
+                status = filter->IsDataValid(filter->GetInput()->Type, inputsample);
+                if (status != SVL_OK) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::IsDataValid() returned error (" << status << ")" << std::endl;
+                    break;
+                }
+
+                status = filter->Process(&info, inputsample, outputsample);
+                if (status < 0) {
+                    CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << ", Filter=\"" << filter->GetName() << "\"): svlFilterBase::Process() returned error (" << status << ")" << std::endl;
+                    break;
+                }
+
+                // Each filter is owned by a single stage thread
+                filter->EnabledInternal = filter->Enabled;
+
+                // Store input time stamp
+                filter->PrevInputTimestamp = inputsample->GetTimestamp();
+
+                // Pass input timestamp to output sample
+                if (outputsample) outputsample->SetTimestamp(filter->PrevInputTimestamp);
+            }
+
+            // Get next filter in the chain
+            output = filter->GetOutput();
+            filter = 0;
+            // Check if trunk output exists
+            if (output) {
+                input = output->Connection;
+                // Check if trunk output is connected
+                if (input) {
+                    // If connected input is trunk
+                    if (input->Trunk) filter = input->Filter;
+                    // If connected input is not trunk
+                    else if (outputsample) input->Buffer->Push(outputsample);
+                    // Store timestamps on both the filter input and the filter output
+                    if (outputsample) {
+                        timestamp = outputsample->GetTimestamp();
+                        output->Timestamp = timestamp;
+                        input->Timestamp = timestamp;
+                    }
+                }
+            }
+        }
+        if (stoprequest || status < 0) {
+            if (inputslot) InputQueue->Release();
+            break;
+        }
+
+        if (OutputQueue == 0) {
+            // Last stage: frame left the pipeline, even if the stream is stopping
+            timestamp = timeserver->GetRelativeTime() - starttime;
+            baseref->PipelineLatencySum += timestamp;
+            if (timestamp > baseref->PipelineLatencyMax) baseref->PipelineLatencyMax = timestamp;
+            baseref->PipelineFrames ++;
+        }
+
+        // Check for errors and stop request
+        if (baseref->StopThread) {
+            CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << "): StopThread flag is true" << std::endl;
+            if (inputslot) InputQueue->Release();
+            break;
+        }
+        else if (baseref->StreamStatus != SVL_OK) {
+            CMN_LOG_INIT_ERROR << "svlStreamProc::PipelineProc (Stage=" << ThreadID << "): StreamStatus signals error (" << baseref->StreamStatus << ")" << std::endl;
+            if (inputslot) InputQueue->Release();
+            break;
+        }
+
+        if (OutputQueue) {
+            // Wait for the next stage, waiting doesn't count as busy
+            busytime += timeserver->GetRelativeTime() - busystart;
+            outputslot = OutputQueue->GetFreeSlot(baseref);
+            busystart = timeserver->GetRelativeTime();
+            if (outputslot == 0) {
+                CMN_LOG_INIT_DEBUG << "svlStreamProc::PipelineProc (Stage=" << ThreadID << "): stream stopped while waiting for output" << std::endl;
+                if (inputslot) InputQueue->Release();
+                break;
+            }
+
+            // Filters reuse their output sample for the next frame, the
+            // next stage gets a copy-on-write reference to the data
+            outputslot->HasSample = false;
+            outputslot->EndOfStream = false;
+            if (outputsample) {
+                if (outputslot->Sample && outputslot->Sample->GetType() != outputsample->GetType()) {
+                    delete outputslot->Sample;
+                    outputslot->Sample = 0;
+                }
+                if (outputslot->Sample == 0) outputslot->Sample = outputsample->GetNewInstance();
+                outputslot->Sample->ShareOf(outputsample);
+                outputslot->HasSample = true;
+            }
+            outputslot->FrameCounter = counter;
+            outputslot->StartTime = starttime;
+            OutputQueue->Push();
+        }
+
+        // The input sample is no longer referenced by this stage
+        if (inputslot) InputQueue->Release();
+
+        busytime += timeserver->GetRelativeTime() - busystart;
+
+        // incrementing frame counter
+        counter ++;
+    }
+
+    // Statistics are only written by the stage itself
+    baseref->PipelineBusyTime[ThreadID] = busytime;
+    baseref->PipelineElapsedTime[ThreadID] = timeserver->GetRelativeTime() - stagestart;
+
+    if (InputQueue == 0) {
+    // First stage only - BEGIN
+
+        if (status >= 0 && OutputQueue &&
+            baseref->StopThread == false && baseref->StreamStatus == SVL_OK) {
+            // Let the frames already in the pipeline reach the last stage
+            outputslot = OutputQueue->GetFreeSlot(baseref);
+            if (outputslot) {
+                outputslot->HasSample = false;
+                outputslot->EndOfStream = true;
+                OutputQueue->Push();
+            }
+            while (baseref->StopThread == false && baseref->StreamStatus == SVL_OK) {
+                // Timeout to check the stop flag periodically
+                if (baseref->PipelineDrained->Wait(0.05)) break;
+            }
+        }
+
+        // Run InternalStop() method in case of internal shutdown;
+        // keep the error status of a later stage if any
+        if (baseref->StopThread == false) {
+            if (baseref->StreamStatus == SVL_OK) baseref->StreamStatus = status;
+            baseref->InternalStop(ThreadID);
+        }
+
+    // First stage only - END
+    }
+    else if (endofstream) {
+        // Forward end of stream to the next stage
+        if (OutputQueue) {
+            outputslot = OutputQueue->GetFreeSlot(baseref);
+            if (outputslot) {
+                outputslot->HasSample = false;
+                outputslot->EndOfStream = true;
+                OutputQueue->Push();
+            }
+        }
+        else {
+            baseref->PipelineDrained->Raise();
+        }
+    }
+    else if (status < 0 && baseref->StopThread == false) {
+        // Signal the error status, the first stage will stop the stream
+        baseref->StreamStatus = status;
+    }
+
+    return this;
+}
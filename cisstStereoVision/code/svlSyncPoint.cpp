@@ -22,6 +22,16 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlSyncPoint.h>
 #include <cisstStereoVision/svlDefinitions.h>
 
+#if (CISST_OS == CISST_LINUX)
+#include <limits.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+// Number of pause instructions before a waiting thread parks
+#define SVL_SYNC_SPIN_COUNT     4000
+
 
 /*************************************/
 /*** svlSyncPoint class **************/
@@ -33,10 +43,19 @@ http://www.cisst.org/cisst/license.txt.
 // *******************************************************************
 svlSyncPoint::svlSyncPoint() :
     ThreadCount(2),
-    LastChanged(-1)
+    SyncType(svlSyncSignals),
+    LastChanged(-1),
+    Released(false),
+    SpinCount(SVL_SYNC_SPIN_COUNT)
 {
     CheckedInCounter = ThreadCount;
     ReleaseEvent = new osaThreadSignal[ThreadCount];
+    Remaining.Store(ThreadCount);
+
+#if (CISST_OS == CISST_LINUX)
+    // Spinning can't help if there is no other processor to check in
+    if (sysconf(_SC_NPROCESSORS_ONLN) < 2) SpinCount = 0;
+#endif
 }
 
 // *******************************************************************
@@ -62,6 +81,8 @@ int svlSyncPoint::Count(unsigned int count)
     ThreadCount = count;
     CheckedInCounter = ThreadCount;
     LastChanged = -1;
+    Remaining.Store(ThreadCount);
+    Released = false;
 
     delete [] ReleaseEvent;
     ReleaseEvent = new osaThreadSignal[ThreadCount];
@@ -74,6 +95,30 @@ unsigned int svlSyncPoint::Count()
     return ThreadCount;
 }
 
+// *******************************************************************
+// svlSyncPoint::Type method
+// arguments:
+//           type           - barrier implementation
+// function:
+//    Sets or returns the barrier implementation used by Sync():
+//      svlSyncSignals - threads wait on their own signal, the last
+//                       thread raises the signal of every other thread
+//      svlSyncSpin    - sense-reversing barrier, waiting threads spin
+//                       for a short time then park until the last
+//                       thread flips the sense
+//    This method is not thread safe.
+// *******************************************************************
+int svlSyncPoint::Type(svlSyncType type)
+{
+    SyncType = type;
+    return SVL_SYNC_OK;
+}
+
+svlSyncType svlSyncPoint::Type()
+{
+    return SyncType;
+}
+
 // *******************************************************************
 // svlSyncPoint::Sync method
 // arguments:
@@ -85,8 +130,15 @@ unsigned int svlSyncPoint::Count()
 int svlSyncPoint::Sync(unsigned int _id)
 {
     if (_id >= ThreadCount) return SVL_SYNC_ERROR;
+    if (SyncType == svlSyncSpin) return SpinSync(_id);
 
     CS.Enter();
+        // All subsequent Sync() calls return immediately after ReleaseAll()
+        if (Released) {
+            CS.Leave();
+            return SVL_SYNC_OK;
+        }
+
         CheckedInCounter --;
         LastChanged = static_cast<int>(_id);
 
@@ -125,7 +177,18 @@ int svlSyncPoint::Sync(unsigned int _id)
 // *******************************************************************
 void svlSyncPoint::ReleaseAll()
 {
+    if (SyncType == svlSyncSpin) {
+        // All subsequent Sync() calls return immediately
+        Released = true;
+        Sense.FetchAdd(1);
+        WakeParked();
+        return;
+    }
+
     CS.Enter();
+        // A thread released by the last Sync() might not have consumed
+        // its signal yet, the second Raise() would be lost
+        Released = true;
         for (unsigned int i = 0; i < ThreadCount; i ++) {
             ReleaseEvent[i].Raise();
         }
@@ -135,3 +198,71 @@ void svlSyncPoint::ReleaseAll()
     CS.Leave();
 }
 
+// *******************************************************************
+// svlSyncPoint::SpinSync method
+// arguments:
+//           id             - thread ID
+// function:
+//    Sense-reversing barrier: each thread reads the sense and checks
+//    in by decrementing the counter.  The last thread resets the
+//    counter and changes the sense, which releases all the others.
+//    Waiting threads spin on the sense first and park only if the
+//    barrier takes longer, so the last thread needs a single wake up
+//    call, and only if some thread parked.
+// *******************************************************************
+int svlSyncPoint::SpinSync(unsigned int _id)
+{
+    if (Released) return SVL_SYNC_OK;
+
+    // The sense can't change before this thread checks in
+    const unsigned int sense = Sense.Load();
+
+    if (Remaining.FetchSub(1) == 1) {
+        // Last thread to check in: prepare for the next
+        // cycle before releasing the others
+        Remaining.Store(ThreadCount);
+        Sense.FetchAdd(1);
+        WakeParked();
+        return SVL_SYNC_OK;
+    }
+
+    unsigned int i;
+    for (i = 0; i < SpinCount; i ++) {
+        if (Sense.Load() != sense) return SVL_SYNC_OK;
+        osaCPUPause();
+    }
+
+    Parked.FetchAdd(1);
+    while (Sense.Load() == sense) {
+#if (CISST_OS == CISST_LINUX)
+        // Returns right away if the sense already changed
+        syscall(SYS_futex, const_cast<unsigned int*>(Sense.Pointer()),
+                FUTEX_WAIT_PRIVATE, sense, 0, 0, 0);
+#else
+        ReleaseEvent[_id].Wait(0.001);
+#endif
+    }
+    Parked.FetchSub(1);
+
+    return SVL_SYNC_OK;
+}
+
+// *******************************************************************
+// svlSyncPoint::WakeParked method
+// function:
+//    Wakes up threads parked in SpinSync() after the sense changed.
+// *******************************************************************
+void svlSyncPoint::WakeParked()
+{
+    // Read-modify-write to order the check after the sense change
+    if (Parked.FetchAdd(0) == 0) return;
+
+#if (CISST_OS == CISST_LINUX)
+    syscall(SYS_futex, const_cast<unsigned int*>(Sense.Pointer()),
+            FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+#else
+    for (unsigned int i = 0; i < ThreadCount; i ++) {
+        ReleaseEvent[i].Raise();
+    }
+#endif
+}
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstStereoVision/svlTrackerMSBruteForce.h>
+#include "svlImageProcessingSIMD.h"
 
 //#define __DEBUG_TRACKER
 
@@ -73,6 +74,21 @@ inline unsigned int sqrt_uint32(unsigned int value)
     return g;
 }
 
+// Sum of the [left, right] x [top, bottom] window from a summed-area
+// table; the row and the column preceding the area covered by the
+// table are expected to be zero.
+inline unsigned int sum_table_window(const unsigned int* table, const unsigned int width,
+                                     const int left, const int top, const int right, const int bottom)
+{
+    unsigned int sum = table[bottom * width + right];
+    if (left > 0) sum -= table[bottom * width + left - 1];
+    if (top > 0) {
+        sum -= table[(top - 1) * width + right];
+        if (left > 0) sum += table[(top - 1) * width + left - 1];
+    }
+    return sum;
+}
+
 
 /************************************/
 /*** svlTrackerMSBruteForce class ***/
@@ -338,12 +354,9 @@ int svlTrackerMSBruteForce::Initialize()
         Targets[i].image_data.SetAll(0);
     }
 
-    MatchMap.SetSize(SearchRadius * 2 + 1, SearchRadius * 2 + 1);
-
     TargetsAdded  = false;
     Initialized   = true;
     FrameCounter  = 0;
-    ThreadCounter = 0;
 
     return SVL_OK;
 }
@@ -399,7 +412,7 @@ int svlTrackerMSBruteForce::PreProcessImage(svlSampleImage & image, unsigned int
         }
     }
 
-    if (Metric == svlFastNCC) {
+    if (Metric == svlNCC || Metric == svlFastNCC) {
         CalculateSumTables(preproc_image->GetUCharPointer(videoch));
     }
 
@@ -422,260 +435,13 @@ int svlTrackerMSBruteForce::PreProcessImage(svlSampleImage & image, unsigned int
 
 int svlTrackerMSBruteForce::Track(svlSampleImage & image, unsigned int videoch)
 {
-    if (!Initialized) return SVL_FAIL;
-
-    svlSampleImage* raw_image = &image;
-    svlSampleImage* preproc_image = &image;
-
-    if (Scale == 1 && PreProcessedImage) {
-        preproc_image = PreProcessedImage;
-    }
-
-    int roi_margin = GetROIMargin();
-    svlRect image_roi(roi_margin, roi_margin, preproc_image->GetWidth() - roi_margin, preproc_image->GetHeight() - roi_margin);
-    bool ellipse_roi = false;
-    if (ROIEllipse.rx > 0 && ROIEllipse.ry > 0) ellipse_roi = true;
-
-    const unsigned int targetcount = static_cast<unsigned int>(Targets.size());
-    const unsigned int scalem1 = Scale - 1;
-    const int s_tmp_rad = TemplateRadius;
-    const int s_wdth = Width;
-    const int s_hght = Height;
-    unsigned int templatesize = TemplateRadius * 2 + 1;
-    templatesize *= templatesize * 3;
-
-    if (Metric == svlFastNCC) {
-        if (ZeroMeanTemplate[0].size() < templatesize) {
-            ZeroMeanTemplate[0].SetSize(templatesize);
-        }
-    }
-
-    int xpre, ypre, x, y;
-    svlTarget2D target, *ptgt;
-    unsigned char conf, *p_raw_img, *p_preproc_img;
-    unsigned int i;
-
-
-    if (FrameCounter > 0) {
-        p_raw_img = PreviousRawImage->GetUCharPointer();
-        p_preproc_img = PreviousPreProcessedImage->GetUCharPointer();
-    }
-    else {
-        p_raw_img = raw_image->GetUCharPointer(videoch);
-        p_preproc_img = preproc_image->GetUCharPointer(videoch);
-    }
-
-    for (i = 0, ptgt = Targets.Pointer(); i < targetcount; i ++, ptgt ++) {
-        if (!ptgt->used) {
-            ptgt->visible = false;
-            continue;
-        }
-
-        // Determine target visibility
-        x = ptgt->pos.x;
-        y = ptgt->pos.y;
-
-        if (!image_roi.IsWithin(x, y) || !ROIRect.IsWithin(x, y) ||
-            (ellipse_roi && !ROIEllipse.IsWithin(x, y))) {
-
-            ptgt->visible = false;
-            ptgt->conf    = 0;
-            // Skip target if not visible
-            continue;
-        }
-        ptgt->visible = true;
-
-        if (TemplateUpdateEnabled &&
-            x >= s_tmp_rad && y >= s_tmp_rad &&
-            (x + s_tmp_rad) <= s_wdth && (y + s_tmp_rad) <= s_hght) {
-
-            // Check if this scale already has a template
-            // Acquire target templates if necessary
-            if (ptgt->feature_quality == -1) {
-                ptgt->feature_data.SetSize(templatesize);
-                ptgt->image_data.SetSize(templatesize);
-
-                // Update this scale's template with the
-                // new position estimated by the tracker
-                // filter
-                CopyTemplate(p_preproc_img,
-                             ptgt->feature_data.Pointer(),
-                             x - TemplateRadius,
-                             y - TemplateRadius);
-                CopyTemplate(p_raw_img,
-                             ptgt->image_data.Pointer(),
-                             x - TemplateRadius,
-                             y - TemplateRadius);
-
-                ptgt->conf            = 255;
-                ptgt->feature_quality = 256;
-            }
-            else if (OverwriteTemplates) {
-                // Overwrite template based on updated position
-                UpdateTemplate(p_preproc_img,
-                               ptgt->feature_data.Pointer(),
-                               x - TemplateRadius,
-                               y - TemplateRadius);
-                UpdateTemplate(p_raw_img,
-                               ptgt->image_data.Pointer(),
-                               x - TemplateRadius,
-                               y - TemplateRadius);
-            }
-        }
-    }
-
-
-    if (LowerScale) {
-
-        // Call lower scales recursively
-        LowerScale->Track(*LowerScaleImage);
-
-        // Scale up the tracking results from the
-        // lower scale and use that as new position
-        for (i = 0, ptgt = Targets.Pointer(); i < targetcount; i ++, ptgt ++) {
-            if (!ptgt->used) continue;
-
-            // Scale up lower scale results only if this target has been initialized earlier
-            if (ptgt->feature_quality >= 0) {
-
-                LowerScale->GetTarget(i, target);
-
-                // Scale up only valid lower scale results
-                if (target.feature_quality >= 0 && target.visible) {
-                    ptgt->conf    = target.conf;
-                    ptgt->pos.x   = target.pos.x * 2 + 1;
-                    ptgt->pos.y   = target.pos.y * 2 + 1;
-                }
-                else {
-                    ptgt->visible = false;
-                    ptgt->conf    = 0;
-                }
-            }
-        }
-    }
-
-
-    // Track targets
-    for (i = 0, ptgt = Targets.Pointer(); i < targetcount; i ++, ptgt ++) {
-
-        // Skip non-visible targets
-        if (!ptgt->visible) continue;
-
-        // Skip templates with poor quality
-        if (ptgt->feature_quality < ConfidenceThreshold) {
-            ptgt->visible = false;
-            ptgt->conf    = 0;
-            continue;
-        }
-
-        // template matching + updating coordinates
-        xpre = ptgt->pos.x;
-        ypre = ptgt->pos.y;
-
-        if (Scale == 1) {
-            switch (Metric) {
-                case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
-                break;
-
-                case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
-                break;
-
-                case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
-                break;
-
-                case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
-                break;
-
-                case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
-                break;
-
-                default:
-                    return SVL_FAIL;
-            }
-        }
-        else {
-            switch (Metric) {
-                case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
-                break;
-
-                case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
-                break;
-
-                case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
-                break;
-
-                case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[0].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
-                break;
-
-                case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
-                break;
-
-                default:
-                    return SVL_FAIL;
-            }
-
-            if (ptgt->conf < ConfidenceThreshold) ptgt->conf = 0;
-            ptgt->conf = (static_cast<int>(ptgt->conf) * scalem1 + conf) / Scale;
-        }
-
-        if (ptgt->feature_quality == 256) {
-            // Determine the quality of the feature when it was first used
-            ptgt->feature_quality = ptgt->conf;
-        }
-
-        x += xpre;
-        y += ypre;
-        ptgt->pos.x = x;
-        ptgt->pos.y = y;
-
-#ifdef __DEBUG_TRACKER
-        cvNamedWindow(ScaleName.c_str(), CV_WINDOW_AUTOSIZE); 
-        cvShowImage(ScaleName.c_str(), image.IplImageRef(videoch));
-        cvWaitKey(1);
-#endif
-
-        if (TemplateUpdateEnabled && !OverwriteTemplates &&
-            x >= s_tmp_rad && y >= s_tmp_rad &&
-            (x + s_tmp_rad) <= s_wdth && (y + s_tmp_rad) <= s_hght) {
-
-            // Update template temporarily based on updated position
-            UpdateTemplate(preproc_image->GetUCharPointer(videoch),
-                           ptgt->feature_data.Pointer(),
-                           x - TemplateRadius,
-                           y - TemplateRadius);
-            UpdateTemplate(raw_image->GetUCharPointer(videoch),
-                           ptgt->image_data.Pointer(),
-                           x - TemplateRadius,
-                           y - TemplateRadius);
-       }
-    }
-
-    FrameCounter ++;
+    svlProcInfo procInfo;
+    procInfo.count = 1;
+    procInfo.ID = 0;
+    procInfo.sync = 0;
+    procInfo.cs = 0;
 
-    memcpy(PreviousRawImage->GetUCharPointer(), raw_image->GetUCharPointer(videoch), PreviousRawImage->GetDataSize());
-    memcpy(PreviousPreProcessedImage->GetUCharPointer(), preproc_image->GetUCharPointer(videoch), PreviousPreProcessedImage->GetDataSize());
-
-    return SVL_OK;
+    return Track(&procInfo, image, videoch);
 }
 
 int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image, unsigned int videoch)
@@ -689,12 +455,18 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         preproc_image = PreProcessedImage;
     }
 
-    if (Metric == svlFastNCC) {
-        if (ZeroMeanTemplate.size() < procInfo->count) {
-            // Too many threads
-            // Increase ZeroMeanTemplate array size
+    switch (Metric) {
+        case svlSAD:
+        case svlSSD:
+        case svlNCC:
+        case svlFastNCC:
+        case svlNotQuiteNCC:
+        break;
+
+        default:
+            // All threads have to fail, otherwise the
+            // others would wait for this one forever
             return SVL_FAIL;
-        }
     }
 
     int roi_margin = GetROIMargin();
@@ -703,19 +475,37 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
     if (ROIEllipse.rx > 0 && ROIEllipse.ry > 0) ellipse_roi = true;
 
     const unsigned int targetcount = static_cast<unsigned int>(Targets.size());
-    const unsigned int target_from = procInfo->ID;
-    const unsigned int target_step = procInfo->count;
+    // There are work buffers for MAX_THREADS threads only, the rest
+    // of the threads skip the targets and wait at the barriers
+    const unsigned int workers = std::min(procInfo->count, static_cast<unsigned int>(MAX_THREADS));
+    const bool worker = procInfo->ID < workers;
+    const unsigned int target_from = worker ? procInfo->ID : targetcount;
+    const unsigned int target_step = workers;
     const unsigned int scalem1 = Scale - 1;
     const int s_tmp_rad = TemplateRadius;
     const int s_wdth = Width;
     const int s_hght = Height;
+    const unsigned int winsize = SearchRadius * 2 + 1;
     unsigned int templatesize = TemplateRadius * 2 + 1;
     templatesize *= templatesize * 3;
 
-    if (Metric == svlFastNCC) {
-        if (ZeroMeanTemplate[procInfo->ID].size() < templatesize) {
-            ZeroMeanTemplate[procInfo->ID].SetSize(templatesize);
+    // Each thread works in its own buffers
+    int *map = 0, *zero_mean_tmp = 0, *correlations = 0;
+    if (worker) {
+        if (MatchMap[procInfo->ID].rows() != winsize || MatchMap[procInfo->ID].cols() != winsize) {
+            MatchMap[procInfo->ID].SetSize(winsize, winsize);
+        }
+        if (Metric == svlNCC || Metric == svlFastNCC) {
+            if (ZeroMeanTemplate[procInfo->ID].size() < templatesize) {
+                ZeroMeanTemplate[procInfo->ID].SetSize(templatesize);
+            }
+            if (Correlations[procInfo->ID].size() < winsize * winsize * 3) {
+                Correlations[procInfo->ID].SetSize(winsize * winsize * 3);
+            }
         }
+        map = MatchMap[procInfo->ID].Pointer();
+        zero_mean_tmp = ZeroMeanTemplate[procInfo->ID].Pointer();
+        correlations = Correlations[procInfo->ID].Pointer();
     }
 
     svlTarget2D target, *ptgt;
@@ -851,28 +641,28 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         if (Scale == 1) {
             switch (Metric) {
                 case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
+                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), map, xpre, ypre);
+                    GetBestMatch(map, x, y, ptgt->conf, false);
                 break;
 
                 case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, false);
+                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), map, xpre, ypre);
+                    GetBestMatch(map, x, y, ptgt->conf, false);
                 break;
 
                 case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), zero_mean_tmp, correlations, map, xpre, ypre);
+                    GetBestMatch(map, x, y, ptgt->conf, true);
                 break;
 
                 case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), zero_mean_tmp, correlations, map, xpre, ypre);
+                    GetBestMatch(map, x, y, ptgt->conf, true);
                 break;
 
                 case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, ptgt->conf, true);
+                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), map, xpre, ypre);
+                    GetBestMatch(map, x, y, ptgt->conf, true);
                 break;
 
                 default:
@@ -882,28 +672,28 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         else {
             switch (Metric) {
                 case svlSAD:
-                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
+                    MatchTemplateSAD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), map, xpre, ypre);
+                    GetBestMatch(map, x, y, conf, false);
                 break;
 
                 case svlSSD:
-                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, false);
+                    MatchTemplateSSD(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), map, xpre, ypre);
+                    GetBestMatch(map, x, y, conf, false);
                 break;
 
                 case svlNCC:
-                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), zero_mean_tmp, correlations, map, xpre, ypre);
+                    GetBestMatch(map, x, y, conf, true);
                 break;
 
                 case svlFastNCC:
-                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), ZeroMeanTemplate[procInfo->ID].Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateFastNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), zero_mean_tmp, correlations, map, xpre, ypre);
+                    GetBestMatch(map, x, y, conf, true);
                 break;
 
                 case svlNotQuiteNCC:
-                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), xpre, ypre);
-                    GetBestMatch(x, y, conf, true);
+                    MatchTemplateNotQuiteNCC(preproc_image->GetUCharPointer(videoch), ptgt->feature_data.Pointer(), map, xpre, ypre);
+                    GetBestMatch(map, x, y, conf, true);
                 break;
 
                 default:
@@ -946,16 +736,21 @@ int svlTrackerMSBruteForce::Track(svlProcInfo* procInfo, svlSampleImage & image,
         }
     }
 
-    ThreadCounter ++;
-    if (ThreadCounter == procInfo->count) {
-        // The last thread to finish stores the current images for later  use
+    // The previous images may only be overwritten once all the
+    // threads are done with them, and have to be ready before any
+    // thread starts with the next frame
+    _SynchronizeThreads(procInfo);
+
+    _OnSingleThread(procInfo) {
+        // Store the current images for later use
         memcpy(PreviousRawImage->GetUCharPointer(), raw_image->GetUCharPointer(videoch), PreviousRawImage->GetDataSize());
         memcpy(PreviousPreProcessedImage->GetUCharPointer(), preproc_image->GetUCharPointer(videoch), PreviousPreProcessedImage->GetDataSize());
 
-        ThreadCounter = 0;
         FrameCounter ++;
     }
 
+    _SynchronizeThreads(procInfo);
+
     return SVL_OK;
 }
 
@@ -1034,7 +829,7 @@ void svlTrackerMSBruteForce::UpdateTemplate(unsigned char* img, unsigned char* t
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int* map, int x, int y)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1045,8 +840,7 @@ void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char*
     const int imgwidth = static_cast<int>(Width);
     const int imgheight = static_cast<int>(Height);
 
-    int k, l, sum, ival, hfrom, vfrom;
-    int* map = MatchMap.Pointer();
+    int k, l, sum, ival, hfrom, vfrom, hfirst, hlast;
     unsigned char *timg, *ttmp;
     unsigned int i, j, v, h;
 
@@ -1061,10 +855,30 @@ void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char*
     k = vfrom * imgstride + hfrom * 3;
     if (k > 0) img += k;
     else img -= -k;
-    
+
+    // Positions within the image horizontally
+    hfirst = std::max(-hfrom, 0);
+    hlast = std::min(imgwidth - hfrom, static_cast<int>(winsize));
+
     for (v = 0, l = vfrom; v < winsize; v ++, l ++) {
         if (l >= 0 && l < imgheight) {
 
+            // match the whole row of positions at once, if possible
+            if (hfirst < hlast &&
+                svlImageProcessingSIMD::TemplateSAD(img + hfirst * 3, imgstride,
+                                                   tmp, tmpheight * 3, tmpheight,
+                                                   hlast - hfirst, 1, map + hfirst)) {
+                for (h = 0; h < winsize; h ++) {
+                    if (static_cast<int>(h) >= hfirst && static_cast<int>(h) < hlast) {
+                        map[h] = map[h] / static_cast<int>(tmppixcount) + 1;
+                    }
+                    else map[h] = 0;
+                }
+                map += winsize;
+                img += imgstride;
+                continue;
+            }
+
             for (h = 0, k = hfrom; h < winsize; h ++, k ++) {
                 if (k >= 0 && k < imgwidth) {
 
@@ -1113,7 +927,7 @@ void svlTrackerMSBruteForce::MatchTemplateSAD(unsigned char* img, unsigned char*
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int* map, int x, int y)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1124,8 +938,7 @@ void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char*
     const int imgwidth = static_cast<int>(Width);
     const int imgheight = static_cast<int>(Height);
 
-    int k, l, sum, ival, hfrom, vfrom;
-    int* map = MatchMap.Pointer();
+    int k, l, sum, ival, hfrom, vfrom, hfirst, hlast;
     unsigned char *timg, *ttmp;
     unsigned int i, j, v, h;
 
@@ -1140,10 +953,30 @@ void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char*
     k = vfrom * imgstride + hfrom * 3;
     if (k > 0) img += k;
     else img -= -k;
-    
+
+    // Positions within the image horizontally
+    hfirst = std::max(-hfrom, 0);
+    hlast = std::min(imgwidth - hfrom, static_cast<int>(winsize));
+
     for (v = 0, l = vfrom; v < winsize; v ++, l ++) {
         if (l >= 0 && l < imgheight) {
 
+            // match the whole row of positions at once, if possible
+            if (hfirst < hlast &&
+                svlImageProcessingSIMD::TemplateSSD(img + hfirst * 3, imgstride,
+                                                   tmp, tmpheight * 3, tmpheight,
+                                                   hlast - hfirst, 1, map + hfirst)) {
+                for (h = 0; h < winsize; h ++) {
+                    if (static_cast<int>(h) >= hfirst && static_cast<int>(h) < hlast) {
+                        map[h] = map[h] / static_cast<int>(tmppixcount) + 1;
+                    }
+                    else map[h] = 0;
+                }
+                map += winsize;
+                img += imgstride;
+                continue;
+            }
+
             for (h = 0, k = hfrom; h < winsize; h ++, k ++) {
                 if (k >= 0 && k < imgwidth) {
 
@@ -1192,7 +1025,7 @@ void svlTrackerMSBruteForce::MatchTemplateSSD(unsigned char* img, unsigned char*
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int* correlations, int* map, int x, int y)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1202,17 +1035,28 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
     const int imgwidth_m1 = static_cast<int>(Width) - 1;
     const int imgheight_m1 = static_cast<int>(Height) - 1;
     const int tmpheight_m1 = tmpheight - 1;
+    const int tmparea = tmpheight * tmpheight;
+
+    const unsigned int* sum_r = SumTable[0].Pointer();
+    const unsigned int* sum_g = SumTable[1].Pointer();
+    const unsigned int* sum_b = SumTable[2].Pointer();
+    const unsigned int* sq_sum_r = SqSumTable[0].Pointer();
+    const unsigned int* sq_sum_g = SqSumTable[1].Pointer();
+    const unsigned int* sq_sum_b = SqSumTable[2].Pointer();
 
     int i, j, k, l, sum, hfrom, vfrom;
+    int hfirst, hlast, vfirst, vlast;
     int tmpxfrom, tmpxto, tmpyfrom, tmpyto;
     int tmpstride, tmprowcount, tmpcolcount, tmppixcount;
     int xoffs, yoffs, ioffs;
     int mi1, mi2, mi3, mt1, mt2, mt3;
     int di1, di2, di3, dt1, dt2, dt3;
+    int si1, si2, si3, st1, st2, st3;
     int di, dt, cr1, cr2, cr3;
-    int* map = MatchMap.Pointer();
+    int *zm_tmp, *corr;
     unsigned char *timg, *ttmp;
     unsigned int v, h;
+    bool correlated;
 
     hfrom = x - TemplateRadius - SearchRadius;
     vfrom = y - TemplateRadius - SearchRadius;
@@ -1236,18 +1080,31 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
     }
     mt1 /= tmppixcount; mt2 /= tmppixcount; mt3 /= tmppixcount;
 
-    // Compute template standard deviations
-    ttmp = tmp; dt1 = dt2 = dt3 = 0;
+    // Compute template standard deviations, zero mean template and its sums
+    zm_tmp = zero_mean_tmp;
+    ttmp = tmp; dt1 = dt2 = dt3 = 0; st1 = st2 = st3 = 0;
     for (j = tmpyfrom; j < tmpyto; j ++) {
         for (i = tmpxfrom; i < tmpxto; i ++) {
-            dt = static_cast<int>(*ttmp) - mt1; dt1 += dt * dt; ttmp ++;
-            dt = static_cast<int>(*ttmp) - mt2; dt2 += dt * dt; ttmp ++;
-            dt = static_cast<int>(*ttmp) - mt3; dt3 += dt * dt; ttmp ++;
+            dt = static_cast<int>(*ttmp) - mt1; dt1 += dt * dt; st1 += dt; *zm_tmp = dt; zm_tmp ++; ttmp ++;
+            dt = static_cast<int>(*ttmp) - mt2; dt2 += dt * dt; st2 += dt; *zm_tmp = dt; zm_tmp ++; ttmp ++;
+            dt = static_cast<int>(*ttmp) - mt3; dt3 += dt * dt; st3 += dt; *zm_tmp = dt; zm_tmp ++; ttmp ++;
         }
     }
     dt1 = sqrt_uint32(dt1); dt2 = sqrt_uint32(dt2); dt3 = sqrt_uint32(dt3);
     if (dt1 == 0) dt1 = 1; if (dt2 == 0) dt2 = 1; if (dt3 == 0) dt3 = 1;
 
+    // Positions where the template is entirely within the image
+    hfirst = std::max(-hfrom, 0);
+    hlast = std::min(imgwidth_m1 - tmpheight_m1 + 1 - hfrom, static_cast<int>(winsize));
+    vfirst = std::max(-vfrom, 0);
+    vlast = std::min(imgheight_m1 - tmpheight_m1 + 1 - vfrom, static_cast<int>(winsize));
+
+    // Correlations with the zero mean template at all these positions at once, if possible
+    correlated = hfirst < hlast && vfirst < vlast &&
+                 svlImageProcessingSIMD::TemplateCorrelationRGB(img + vfirst * imgstride + hfirst * 3, imgstride,
+                                                                zero_mean_tmp, tmpwidth, tmpheight,
+                                                                hlast - hfirst, vlast - vfirst, correlations);
+
     for (v = 0, l = vfrom; v < winsize; v ++, l ++) {
 
         tmprowcount = 0;
@@ -1274,14 +1131,14 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
 
                 tmpcolcount = 0;
 
-                tmpxfrom = l;
+                tmpxfrom = k;
                 if (tmpxfrom <= imgwidth_m1) {
                     xoffs = 0;
                     if (tmpxfrom < 0) {
                         xoffs = -tmpxfrom;
                         tmpxfrom = 0;
                     }
-                    tmpxto = l + tmpheight_m1;
+                    tmpxto = k + tmpheight_m1;
                     if (tmpxto >= 0) {
                         if (tmpxto > imgwidth_m1) {
                             tmpxto = imgwidth_m1;
@@ -1292,43 +1149,102 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
 
                 if (tmpcolcount > 0) {
 
-                    tmpstride = imgstride - tmpcolcount * 3;
-                    tmppixcount = tmprowcount * tmpcolcount;
-
-                    xoffs *= 3;
-                    ioffs = yoffs * imgstride + xoffs;
+                    if (tmpcolcount == tmpheight_m1 + 1 && tmprowcount == tmpheight_m1 + 1) {
+                    // The whole template is within the image:
+                    //   sum((I - mi) * (T - mt)) = sum(I * (T - mt)) - mi * sum(T - mt)
+                    //   sum((I - mi)^2) = sum(I^2) - 2 * mi * sum(I) + n * mi^2
+
+                        // Compute image sums
+                        if (k >= SumTableRect.left && (k + tmpheight_m1) < SumTableRect.right &&
+                            l >= SumTableRect.top  && (l + tmpheight_m1) < SumTableRect.bottom) {
+                            si1 = sum_table_window(sum_r, Width, k, l, k + tmpheight_m1, l + tmpheight_m1);
+                            si2 = sum_table_window(sum_g, Width, k, l, k + tmpheight_m1, l + tmpheight_m1);
+                            si3 = sum_table_window(sum_b, Width, k, l, k + tmpheight_m1, l + tmpheight_m1);
+                            di1 = sum_table_window(sq_sum_r, Width, k, l, k + tmpheight_m1, l + tmpheight_m1);
+                            di2 = sum_table_window(sq_sum_g, Width, k, l, k + tmpheight_m1, l + tmpheight_m1);
+                            di3 = sum_table_window(sq_sum_b, Width, k, l, k + tmpheight_m1, l + tmpheight_m1);
+                        }
+                        else {
+                            timg = img;
+                            si1 = si2 = si3 = 0;
+                            di1 = di2 = di3 = 0;
+                            for (j = 0; j <= tmpheight_m1; j ++) {
+                                for (i = 0; i <= tmpheight_m1; i ++) {
+                                    di = *timg; si1 += di; di1 += di * di; timg ++;
+                                    di = *timg; si2 += di; di2 += di * di; timg ++;
+                                    di = *timg; si3 += di; di3 += di * di; timg ++;
+                                }
+                                timg += imgstride - tmpwidth;
+                            }
+                        }
 
-                    // Compute image means
-                    timg = img + ioffs;
-                    mi1 = mi2 = mi3 = 0;
-                    for (j = tmpyfrom; j <= tmpyto; j ++) {
-                        for (i = tmpxfrom; i <= tmpxto; i ++) {
-                            mi1 += *timg; timg ++;
-                            mi2 += *timg; timg ++;
-                            mi3 += *timg; timg ++;
+                        // Compute correlations with the zero mean template
+                        if (correlated) {
+                            corr = correlations + ((v - vfirst) * (hlast - hfirst) + (h - hfirst)) * 3;
+                            cr1 = corr[0]; cr2 = corr[1]; cr3 = corr[2];
+                        }
+                        else {
+                            timg = img;
+                            zm_tmp = zero_mean_tmp;
+                            cr1 = cr2 = cr3 = 0;
+                            for (j = 0; j <= tmpheight_m1; j ++) {
+                                for (i = 0; i <= tmpheight_m1; i ++) {
+                                    cr1 += static_cast<int>(*timg) * (*zm_tmp); timg ++; zm_tmp ++;
+                                    cr2 += static_cast<int>(*timg) * (*zm_tmp); timg ++; zm_tmp ++;
+                                    cr3 += static_cast<int>(*timg) * (*zm_tmp); timg ++; zm_tmp ++;
+                                }
+                                timg += imgstride - tmpwidth;
+                            }
                         }
-                        timg += tmpstride;
-                    }
-                    mi1 /= tmppixcount; mi2 /= tmppixcount; mi3 /= tmppixcount;
 
-                    // Compute image standard deviations and correlations
-                    timg = img + ioffs;
-                    ttmp = tmp + yoffs * tmpwidth + xoffs;
-                    cr1 = cr2 = cr3 = 0;
-                    di1 = di2 = di3 = 0;
-                    for (j = tmpyfrom; j <= tmpyto; j ++) {
-                        for (i = tmpxfrom; i <= tmpxto; i ++) {
-                            di = static_cast<int>(*timg) - mi1; di1 += di * di; timg ++;
-                            dt = static_cast<int>(*ttmp) - mt1;                 ttmp ++;
-                            cr1 += di * dt;
-                            di = static_cast<int>(*timg) - mi2; di2 += di * di; timg ++;
-                            dt = static_cast<int>(*ttmp) - mt2;                 ttmp ++;
-                            cr2 += di * dt;
-                            di = static_cast<int>(*timg) - mi3; di3 += di * di; timg ++;
-                            dt = static_cast<int>(*ttmp) - mt3;                 ttmp ++;
-                            cr3 += di * dt;
+                        mi1 = si1 / tmparea; mi2 = si2 / tmparea; mi3 = si3 / tmparea;
+                        cr1 -= mi1 * st1; cr2 -= mi2 * st2; cr3 -= mi3 * st3;
+                        di1 += mi1 * (tmparea * mi1 - 2 * si1);
+                        di2 += mi2 * (tmparea * mi2 - 2 * si2);
+                        di3 += mi3 * (tmparea * mi3 - 2 * si3);
+                    }
+                    else {
+                    // Template partially out of the image
+
+                        tmpstride = imgstride - tmpcolcount * 3;
+                        tmppixcount = tmprowcount * tmpcolcount;
+
+                        xoffs *= 3;
+                        ioffs = yoffs * imgstride + xoffs;
+
+                        // Compute image means
+                        timg = img + ioffs;
+                        mi1 = mi2 = mi3 = 0;
+                        for (j = tmpyfrom; j <= tmpyto; j ++) {
+                            for (i = tmpxfrom; i <= tmpxto; i ++) {
+                                mi1 += *timg; timg ++;
+                                mi2 += *timg; timg ++;
+                                mi3 += *timg; timg ++;
+                            }
+                            timg += tmpstride;
+                        }
+                        mi1 /= tmppixcount; mi2 /= tmppixcount; mi3 /= tmppixcount;
+
+                        // Compute image standard deviations and correlations
+                        timg = img + ioffs;
+                        ttmp = tmp + yoffs * tmpwidth + xoffs;
+                        cr1 = cr2 = cr3 = 0;
+                        di1 = di2 = di3 = 0;
+                        for (j = tmpyfrom; j <= tmpyto; j ++) {
+                            for (i = tmpxfrom; i <= tmpxto; i ++) {
+                                di = static_cast<int>(*timg) - mi1; di1 += di * di; timg ++;
+                                dt = static_cast<int>(*ttmp) - mt1;                 ttmp ++;
+                                cr1 += di * dt;
+                                di = static_cast<int>(*timg) - mi2; di2 += di * di; timg ++;
+                                dt = static_cast<int>(*ttmp) - mt2;                 ttmp ++;
+                                cr2 += di * dt;
+                                di = static_cast<int>(*timg) - mi3; di3 += di * di; timg ++;
+                                dt = static_cast<int>(*ttmp) - mt3;                 ttmp ++;
+                                cr3 += di * dt;
+                            }
+                            timg += tmpstride;
+                            ttmp += tmpwidth - tmpcolcount * 3;
                         }
-                        timg += tmpstride;
                     }
                     di1 = sqrt_uint32(di1); di2 = sqrt_uint32(di2); di3 = sqrt_uint32(di3);
 
@@ -1343,7 +1259,7 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
                         if (__res > 255) __res = 255;
                         img[0] = img[1] = img[2] = __res;
                     #endif
-                    
+
                 }
                 else {
 
@@ -1365,7 +1281,7 @@ void svlTrackerMSBruteForce::MatchTemplateNCC(unsigned char* img, unsigned char*
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int* correlations, int* map, int x, int y)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1384,15 +1300,17 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
     unsigned int* sq_sum_b = SqSumTable[2].Pointer();
 
     int i, j, k, l, k_m1, l_m1, sum, hfrom, vfrom;
+    int hfirst, hlast, vfirst, vlast;
     int tmpxfrom, tmpxto, tmpyfrom, tmpyto;
     int tmpstride, tmprowcount, tmpcolcount, tmpcolcount3, tmppixcount;
     int xoffs, yoffs, ioffs;
     int mt1, mt2, mt3;
     int di1, di2, di3, dis1, dis2, dis3, dt1, dt2, dt3;
     int dt, cr1, cr2, cr3;
-    int *zm_tmp, *map = MatchMap.Pointer();
+    int *zm_tmp, *corr;
     unsigned char *timg, *ttmp;
     unsigned int v, h, off1, off2, off3, off4;
+    bool correlated;
 
     hfrom = x - TemplateRadius - SearchRadius;
     vfrom = y - TemplateRadius - SearchRadius;
@@ -1439,6 +1357,18 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
     dt1 = sqrt_uint32(dt1); dt2 = sqrt_uint32(dt2); dt3 = sqrt_uint32(dt3);
     if (dt1 == 0) dt1 = 1; if (dt2 == 0) dt2 = 1; if (dt3 == 0) dt3 = 1;
 
+    // Positions where the template is entirely within the image
+    hfirst = std::max(-hfrom, 0);
+    hlast = std::min(imgwidth_m1 - tmpheight_m1 + 1 - hfrom, static_cast<int>(winsize));
+    vfirst = std::max(-vfrom, 0);
+    vlast = std::min(imgheight_m1 - tmpheight_m1 + 1 - vfrom, static_cast<int>(winsize));
+
+    // Correlations at all these positions at once, if possible
+    correlated = hfirst < hlast && vfirst < vlast &&
+                 svlImageProcessingSIMD::TemplateCorrelationRGB(img + vfirst * imgstride + hfirst * 3, imgstride,
+                                                                zero_mean_tmp, tmpwidth, tmpheight,
+                                                                hlast - hfirst, vlast - vfirst, correlations);
+
     for (v = 0, l = vfrom, l_m1 = l - 1; v < winsize; v ++, l ++, l_m1 ++) {
 
         tmprowcount = 0;
@@ -1493,18 +1423,24 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
                     xoffs *= 3;
                     ioffs = yoffs * imgstride + xoffs;
 
-                    // Compute image standard deviations and correlations
-                    timg = img + ioffs;
-                    zm_tmp = zero_mean_tmp + yoffs * tmpwidth + xoffs;
-                    cr1 = cr2 = cr3 = 0;
-                    for (j = tmpyfrom; j <= tmpyto; j ++) {
-                        for (i = tmpxfrom; i <= tmpxto; i ++) {
-                            cr1 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
-                            cr2 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
-                            cr3 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
+                    // Compute correlations
+                    if (correlated && tmppixcount == static_cast<int>(tmpheight * tmpheight)) {
+                        corr = correlations + ((v - vfirst) * (hlast - hfirst) + (h - hfirst)) * 3;
+                        cr1 = corr[0]; cr2 = corr[1]; cr3 = corr[2];
+                    }
+                    else {
+                        timg = img + ioffs;
+                        zm_tmp = zero_mean_tmp + yoffs * tmpwidth + xoffs;
+                        cr1 = cr2 = cr3 = 0;
+                        for (j = tmpyfrom; j <= tmpyto; j ++) {
+                            for (i = tmpxfrom; i <= tmpxto; i ++) {
+                                cr1 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
+                                cr2 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
+                                cr3 += (int)(*timg) * (int)(*zm_tmp); timg ++; zm_tmp ++;
+                            }
+                            timg += tmpstride;
+                            zm_tmp += tmpwidth - tmpcolcount3;
                         }
-                        timg += tmpstride;
-                        zm_tmp += tmpwidth - tmpcolcount3;
                     }
 
                     // Compute image normalization denominator
@@ -1542,10 +1478,11 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
                             dis3 += sq_sum_b[off4];
                         }
                     }
-                    di1 *= di1; di2 *= di2; di3 *= di3;
-                    di1 /= tmppixcount; di2 /= tmppixcount; di3 /= tmppixcount;
-                    dis1 -= di1; dis2 -= di2; dis3 -= di3;
-                    dis1 = sqrt_uint32(dis1); dis2 = sqrt_uint32(dis2); di3 = sqrt_uint32(dis3);
+                    // The squared window sums overflow 32 bits above a template radius of 8
+                    dis1 -= static_cast<int>(static_cast<long long int>(di1) * di1 / tmppixcount);
+                    dis2 -= static_cast<int>(static_cast<long long int>(di2) * di2 / tmppixcount);
+                    dis3 -= static_cast<int>(static_cast<long long int>(di3) * di3 / tmppixcount);
+                    dis1 = sqrt_uint32(dis1); dis2 = sqrt_uint32(dis2); dis3 = sqrt_uint32(dis3);
 
                     if (dis1 != 0) sum  = (cr1 << 8) / (dis1 * dt1); else sum  = (cr1 << 8);
                     if (dis2 != 0) sum += (cr2 << 8) / (dis2 * dt2); else sum += (cr2 << 8);
@@ -1580,7 +1517,7 @@ void svlTrackerMSBruteForce::MatchTemplateFastNCC(unsigned char* img, unsigned c
     }
 }
 
-void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int x, int y)
+void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int* map, int x, int y)
 {
     const unsigned int imgstride = Width * 3;
     const unsigned int tmpheight = TemplateRadius * 2 + 1;
@@ -1597,7 +1534,6 @@ void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsign
     int xoffs, yoffs, ioffs;
     int di1, di2, di3, dt1, dt2, dt3;
     int di, dt, cr1, cr2, cr3;
-    int* map = MatchMap.Pointer();
     unsigned char *timg, *ttmp;
     unsigned int v, h;
 
@@ -1728,12 +1664,11 @@ void svlTrackerMSBruteForce::MatchTemplateNotQuiteNCC(unsigned char* img, unsign
     }
 }
 
-void svlTrackerMSBruteForce::GetBestMatch(int &x, int &y, unsigned char &conf, bool higherbetter)
+void svlTrackerMSBruteForce::GetBestMatch(int* map, int &x, int &y, unsigned char &conf, bool higherbetter)
 {
     const int size = SearchRadius * 2 + 1;
     const int size2 = size * size;
     int i, j, t, avrg, best, best_x = 0, best_y = 0;
-    int* map = MatchMap.Pointer();
 
     // Compute average match and best match
     avrg = 0;
@@ -1866,10 +1801,10 @@ void svlTrackerMSBruteForce::ShrinkImage(unsigned char* src, unsigned char* dst)
 void svlTrackerMSBruteForce::CalculateSumTables(unsigned char* img)
 {
     for (unsigned int i = 0; i < 3; i ++) {
-        if (SumTable[i].rows() != Height && SumTable[i].cols() != Width) {
+        if (SumTable[i].rows() != Height || SumTable[i].cols() != Width) {
             SumTable[i].SetSize(Height, Width);
         }
-        if (SqSumTable[i].rows() != Height && SqSumTable[i].cols() != Width) {
+        if (SqSumTable[i].rows() != Height || SqSumTable[i].cols() != Width) {
             SqSumTable[i].SetSize(Height, Width);
         }
     }
@@ -1913,7 +1848,27 @@ void svlTrackerMSBruteForce::CalculateSumTables(unsigned char* img)
     const unsigned int stride = Width - (right - left);
     const unsigned int stride3 = stride * 3;
     unsigned int s_r, s_g, s_b, ss_r, ss_g, ss_b;
-    unsigned int i, j;
+    unsigned int i, j, k;
+
+    SumTableRect.Assign(left, top, right, bottom);
+
+    // Zero the row and the column preceding the area
+    // so that the sum of any window within the area
+    // can be computed from 4 values of the tables
+    for (k = 0; k < 3; k ++) {
+        if (top > 0) {
+            for (i = (left > 0) ? left - 1 : 0; i < right; i ++) {
+                SumTable[k].Element(top - 1, i) = 0;
+                SqSumTable[k].Element(top - 1, i) = 0;
+            }
+        }
+        if (left > 0) {
+            for (j = top; j < bottom; j ++) {
+                SumTable[k].Element(j, left - 1) = 0;
+                SqSumTable[k].Element(j, left - 1) = 0;
+            }
+        }
+    }
 
     img += offset * 3;
     sum_r += offset;
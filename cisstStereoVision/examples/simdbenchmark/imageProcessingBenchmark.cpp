@@ -0,0 +1,257 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Reports the throughput of the vectorized image processing kernels in
+// MPixel/s for every SIMD level supported by the processor.  The
+// comparison with the scalar reference is done by svlImageProcessingTest
+// in the cisstStereoVision tests.
+
+#include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstStereoVision/svlConverters.h>
+#include <cisstStereoVision/svlImageProcessing.h>
+#include <cisstStereoVision/svlSampleImageTypes.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// iterations of each kernel for the throughput measurement
+const unsigned int confNumberOfRuns = 20;
+
+const char * levelNames[] = { "scalar", "SSE2", "AVX2" };
+
+void benchmarkFill(svlSampleImage & image)
+{
+    unsigned char * buffer = image.GetUCharPointer();
+    for (unsigned int index = 0; index < image.GetDataSize(); ++index) {
+        buffer[index] = static_cast<unsigned char>(std::rand() >> 4);
+    }
+}
+
+// One kernel called through the public API.  Prepare restores the
+// inputs (some functions work in place or overwrite their source).
+class benchmarkCase {
+public:
+    std::string Name;
+    unsigned int Pixels;
+
+    virtual ~benchmarkCase() {}
+    virtual void Prepare(void) = 0;
+    virtual void Run(void) = 0;
+};
+
+// Source image and a destination image of the same or another size
+template <class _imageType>
+class benchmarkImageCase: public benchmarkCase {
+public:
+    _imageType Original, Source, Destination;
+
+    benchmarkImageCase(unsigned int width, unsigned int height,
+                       unsigned int destinationWidth, unsigned int destinationHeight) {
+        Original.SetSize(width, height);
+        Source.SetSize(width, height);
+        Destination.SetSize(destinationWidth, destinationHeight);
+        benchmarkFill(Original);
+        Pixels = width * height;
+    }
+    void Prepare(void) {
+        memcpy(Source.GetUCharPointer(), Original.GetUCharPointer(), Original.GetDataSize());
+        memset(Destination.GetUCharPointer(), 0, Destination.GetDataSize());
+    }
+};
+
+template <class _imageType>
+class benchmarkSeparableConvolution: public benchmarkImageCase<_imageType> {
+public:
+    vctDynamicVector<double> Kernel;
+    bool AbsoluteResult;
+
+    benchmarkSeparableConvolution(unsigned int width, unsigned int height,
+                                  const vctDynamicVector<double> & kernel, bool absres, const std::string & name):
+        benchmarkImageCase<_imageType>(width, height, width, height),
+        Kernel(kernel),
+        AbsoluteResult(absres)
+    {
+        this->Name = name;
+    }
+    void Run(void) {
+        svlImageProcessing::Convolution(&(this->Source), 0, &(this->Destination), 0, Kernel, Kernel, AbsoluteResult);
+    }
+};
+
+template <class _imageType>
+class benchmarkConvolution: public benchmarkImageCase<_imageType> {
+public:
+    vctDynamicMatrix<double> Kernel;
+
+    benchmarkConvolution(unsigned int width, unsigned int height,
+                         const vctDynamicMatrix<double> & kernel, const std::string & name):
+        benchmarkImageCase<_imageType>(width, height, width, height),
+        Kernel(kernel)
+    {
+        this->Name = name;
+    }
+    void Run(void) {
+        svlImageProcessing::Convolution(&(this->Source), 0, &(this->Destination), 0, Kernel, false);
+    }
+};
+
+class benchmarkUnsharpMask: public benchmarkImageCase<svlSampleImageRGB> {
+public:
+    benchmarkUnsharpMask(unsigned int width, unsigned int height):
+        benchmarkImageCase<svlSampleImageRGB>(width, height, width, height)
+    {
+        Name = "UnsharpMask RGB r=4";
+    }
+    void Run(void) {
+        svlImageProcessing::UnsharpMask(&Source, 0, &Destination, 0, 4, 1.5, 0);
+    }
+};
+
+template <class _imageType>
+class benchmarkResize: public benchmarkImageCase<_imageType> {
+public:
+    benchmarkResize(unsigned int width, unsigned int height,
+                    unsigned int destinationWidth, unsigned int destinationHeight, const std::string & name):
+        benchmarkImageCase<_imageType>(width, height, destinationWidth, destinationHeight)
+    {
+        this->Name = name;
+    }
+    void Run(void) {
+        svlImageProcessing::Resize(&(this->Source), 0, &(this->Destination), 0, true);
+    }
+};
+
+class benchmarkDeinterlace: public benchmarkImageCase<svlSampleImageRGB> {
+public:
+    svlImageProcessing::DI_Algorithm Algorithm;
+
+    benchmarkDeinterlace(unsigned int width, unsigned int height,
+                         svlImageProcessing::DI_Algorithm algorithm, const std::string & name):
+        benchmarkImageCase<svlSampleImageRGB>(width, height, 1, 1),
+        Algorithm(algorithm)
+    {
+        Name = name;
+    }
+    void Run(void) {
+        svlImageProcessing::Deinterlace(&Source, 0, Algorithm);
+    }
+};
+
+class benchmarkColorConversion: public benchmarkImageCase<svlSampleImageRGB> {
+public:
+    bool ToYUV;
+
+    benchmarkColorConversion(unsigned int width, unsigned int height, bool toYUV):
+        benchmarkImageCase<svlSampleImageRGB>(width, height, width, height),
+        ToYUV(toYUV)
+    {
+        Name = toYUV ? "RGB24toYUV444" : "YUV444toRGB24";
+    }
+    void Run(void) {
+        if (ToYUV) {
+            svlConverter::RGB24toYUV444(Source.GetUCharPointer(), Destination.GetUCharPointer(), Pixels);
+        }
+        else {
+            svlConverter::YUV444toRGB24(Source.GetUCharPointer(), Destination.GetUCharPointer(), Pixels);
+        }
+    }
+};
+
+void benchmarkCreateCases(std::vector<benchmarkCase *> & cases, unsigned int width, unsigned int height)
+{
+    vctDynamicVector<double> gaussian(5, 0.0625, 0.25, 0.375, 0.25, 0.0625);
+    vctDynamicVector<double> derivative(3, -0.5, 0.0, 0.5);
+    vctDynamicMatrix<double> box(5, 5, 1.0 / 25.0);
+    vctDynamicMatrix<double> laplacian(3, 3, 0.0);
+    laplacian.Assign(0.0, 1.0, 0.0,
+                     1.0, -4.0, 1.0,
+                     0.0, 1.0, 0.0);
+
+    cases.push_back(new benchmarkSeparableConvolution<svlSampleImageRGB>(width, height, gaussian, false, "Convolution RGB 5+5"));
+    cases.push_back(new benchmarkSeparableConvolution<svlSampleImageRGB>(width, height, derivative, true, "Convolution RGB 3+3 abs"));
+    cases.push_back(new benchmarkSeparableConvolution<svlSampleImageRGBA>(width, height, gaussian, false, "Convolution RGBA 5+5"));
+    cases.push_back(new benchmarkSeparableConvolution<svlSampleImageMono8>(width, height, gaussian, false, "Convolution Mono8 5+5"));
+    cases.push_back(new benchmarkConvolution<svlSampleImageRGB>(width, height, box, "Convolution RGB 5x5"));
+    cases.push_back(new benchmarkConvolution<svlSampleImageMono8>(width, height, laplacian, "Convolution Mono8 3x3"));
+    cases.push_back(new benchmarkUnsharpMask(width, height));
+    cases.push_back(new benchmarkResize<svlSampleImageRGB>(width, height, width, height * 3 / 4, "Resize RGB vertical"));
+    cases.push_back(new benchmarkResize<svlSampleImageRGB>(width, height, width * 5 / 4, height * 5 / 4, "Resize RGB"));
+    cases.push_back(new benchmarkResize<svlSampleImageMono8>(width, height, width, height * 3 / 2, "Resize Mono8 vertical"));
+    cases.push_back(new benchmarkDeinterlace(width, height, svlImageProcessing::DI_Blending, "Deinterlace blending"));
+    cases.push_back(new benchmarkDeinterlace(width, height, svlImageProcessing::DI_AdaptiveBlending, "Deinterlace adaptive"));
+    cases.push_back(new benchmarkColorConversion(width, height, true));
+    cases.push_back(new benchmarkColorConversion(width, height, false));
+}
+
+void benchmarkDeleteCases(std::vector<benchmarkCase *> & cases)
+{
+    for (size_t index = 0; index < cases.size(); ++index) {
+        delete cases[index];
+    }
+    cases.clear();
+}
+
+void benchmarkThroughput(unsigned int width, unsigned int height)
+{
+    const int supported = svlImageProcessing::GetSupportedSIMDLevel();
+    osaTimeServer timeServer;
+    timeServer.SetTimeOrigin();
+    std::vector<benchmarkCase *> cases;
+    benchmarkCreateCases(cases, width, height);
+
+    std::cout << std::setw(26) << std::left << "MPixel/s" << std::right;
+    for (int level = svlImageProcessing::SIMD_None; level <= supported; ++level) {
+        std::cout << std::setw(10) << levelNames[level];
+    }
+    std::cout << std::endl;
+
+    for (size_t index = 0; index < cases.size(); ++index) {
+        std::cout << std::setw(26) << std::left << cases[index]->Name << std::right;
+        for (int level = svlImageProcessing::SIMD_None; level <= supported; ++level) {
+            svlImageProcessing::SetSIMDLevel(static_cast<svlImageProcessing::SIMD_Level>(level));
+            double elapsed = 0.0;
+            for (unsigned int run = 0; run < confNumberOfRuns; ++run) {
+                cases[index]->Prepare();
+                const double start = timeServer.GetRelativeTime();
+                cases[index]->Run();
+                elapsed += timeServer.GetRelativeTime() - start;
+            }
+            std::cout << std::setw(10) << (cases[index]->Pixels * confNumberOfRuns) / elapsed * 1.0e-6;
+        }
+        std::cout << std::endl;
+    }
+    benchmarkDeleteCases(cases);
+}
+
+int main(void)
+{
+    const svlImageProcessing::SIMD_Level supported = svlImageProcessing::GetSupportedSIMDLevel();
+    std::cout << "Supported SIMD level: " << levelNames[supported] << std::endl;
+
+    std::srand(1);
+    std::cout << std::fixed << std::setprecision(1);
+    benchmarkThroughput(1280, 720);
+
+    svlImageProcessing::SetSIMDLevel(supported);
+    return 0;
+}
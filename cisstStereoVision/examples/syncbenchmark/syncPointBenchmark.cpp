@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+// Measures the average cost of svlSyncPoint::Sync for an increasing
+// number of threads, for each barrier type.  Pass the maximum number
+// of threads on the command line (default is 16).
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstStereoVision/svlSyncPoint.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// number of barriers measured for each configuration
+const unsigned int confNumberOfSyncs = 20000;
+
+class benchmarkWorker {
+public:
+    svlSyncPoint * SyncPoint;
+    unsigned int ID;
+    int Result;
+
+    void * Run(int) {
+        Result = SVL_SYNC_OK;
+        for (unsigned int iteration = 0; iteration < confNumberOfSyncs; ++iteration) {
+            if (SyncPoint->Sync(ID) != SVL_SYNC_OK) {
+                Result = SVL_SYNC_ERROR;
+                break;
+            }
+        }
+        return 0;
+    }
+};
+
+// returns the average time per barrier, in seconds
+double benchmarkRun(svlSyncType type, unsigned int threadCount)
+{
+    svlSyncPoint syncPoint;
+    syncPoint.Type(type);
+    syncPoint.Count(threadCount);
+
+    // thread 0 is the main thread
+    std::vector<benchmarkWorker> workers(threadCount);
+    std::vector<osaThread *> threads(threadCount, 0);
+    for (unsigned int index = 0; index < threadCount; ++index) {
+        workers[index].SyncPoint = &syncPoint;
+        workers[index].ID = index;
+    }
+
+    osaTimeServer timeServer;
+    timeServer.SetTimeOrigin();
+    const double start = timeServer.GetRelativeTime();
+    for (unsigned int index = 1; index < threadCount; ++index) {
+        threads[index] = new osaThread;
+        threads[index]->Create<benchmarkWorker, int>(&(workers[index]), &benchmarkWorker::Run, 0);
+    }
+    workers[0].Run(0);
+    const double elapsed = timeServer.GetRelativeTime() - start;
+
+    for (unsigned int index = 1; index < threadCount; ++index) {
+        threads[index]->Wait();
+        delete threads[index];
+    }
+    return elapsed / confNumberOfSyncs;
+}
+
+int main(int argc, char * argv[])
+{
+    unsigned int maximumThreads = 16;
+    if (argc > 1) {
+        maximumThreads = static_cast<unsigned int>(atoi(argv[1]));
+    }
+    if (maximumThreads < 2) {
+        std::cerr << "Usage: " << argv[0] << " [maximum number of threads, at least 2]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << confNumberOfSyncs << " barriers per configuration, average cost in us" << std::endl
+              << "threads   signals      spin" << std::endl;
+    unsigned int threadCount = 2;
+    while (true) {
+        std::cout << std::setw(7) << threadCount
+                  << std::setw(10) << benchmarkRun(svlSyncSignals, threadCount) / cmn_us
+                  << std::setw(10) << benchmarkRun(svlSyncSpin, threadCount) / cmn_us
+                  << std::endl;
+        if (threadCount == maximumThreads) {
+            break;
+        }
+        // powers of two, then the maximum
+        threadCount = std::min(2 * threadCount, maximumThreads);
+    }
+    return 0;
+}
@@ -181,6 +181,7 @@ http://www.cisst.org/cisst/license.txt.
 #define MAX_UI16_VAL                       0xFFFF
 #define MAX_I32_VAL                    0x7FFFFFFF
 #define BIG_I32_VAL                     100000000
+#define ST_DP_PADDING_COST             0x3FFFFFFF
 #define DS_INIT_TIMEOUT_INTV                  500
 #define INITIAL_TOLERANCE_WAIT_LENGTH         100 // [frames]
 #define SVL_OCV_FONT_SCALE                   16.0
@@ -295,5 +296,16 @@ enum svlPixelType
     svlPixelUnknown
 };
 
+
+/////////////////////////////////////////
+// Thread synchronization enumerations //
+/////////////////////////////////////////
+
+enum svlSyncType
+{
+    svlSyncSignals,     // critical section and one signal per thread
+    svlSyncSpin         // sense-reversing barrier, spins then parks
+};
+
 #endif // _svlDefinitions_h
 
@@ -37,6 +37,11 @@ public:
 
     virtual int Initialize() = 0;
     virtual int Process(svlSampleImage * images, int * depthmap) = 0;
+    // Called on every thread of the stream; methods may split the work
+    // among the threads.  Returns when the depth map is complete.  The
+    // default implementation calls the single threaded version on the
+    // first thread.
+    virtual int Process(svlProcInfo * procInfo, svlSampleImage * images, int * depthmap);
     virtual void Free() = 0;
 };
 
@@ -120,9 +125,9 @@ private:
     void CreateXCheckImageMono(_paramType* source, _paramType* target, const unsigned int width, const unsigned int height);
     void CreateXCheckImageColor(unsigned char* source, unsigned char* target, const unsigned int width, const unsigned int height);
 
-    void PerformXCheck();
+    void PerformXCheck(svlProcInfo* procInfo);
     void ConvertDisparitiesToFloat(int* input, float* output, const int width, const int height);
-    void ApplySpatialFilter(const int radius,
+    int  ApplySpatialFilter(svlProcInfo* procInfo, const int radius,
                             float* depthmap, float* tempbuffer,
                             const int mapwidth, const int mapheight, const int linestride);
 };
@@ -57,6 +57,23 @@ namespace svlImageProcessing
         DI_AdaptiveDiscarding
     };
 
+    enum SIMD_Level
+    {
+        SIMD_None,
+        SIMD_SSE2,
+        SIMD_AVX2
+    };
+
+
+    // Vector instructions used by the image processing functions and
+    // the color space converters.  The level defaults to the highest
+    // one supported by both the processor and the build; it can be
+    // lowered, e.g. to SIMD_None to run the scalar reference code.
+    // SetSIMDLevel returns the level actually selected.
+    SIMD_Level CISST_EXPORT GetSupportedSIMDLevel();
+    SIMD_Level CISST_EXPORT GetSIMDLevel();
+    SIMD_Level CISST_EXPORT SetSIMDLevel(SIMD_Level level);
+
 
     int CISST_EXPORT Convolution(svlSampleImage* src_img,
                                  unsigned int src_videoch,
@@ -42,6 +42,9 @@ public:
     virtual int SetSize(const svlSample& sample) = 0;
     virtual int CopyOf(const svlSample* sample) = 0;
     virtual int CopyOf(const svlSample& sample) = 0;
+    // Same as CopyOf, but the data may be shared with 'sample' until
+    // either of them is modified (copy-on-write) if the type allows it
+    virtual int ShareOf(const svlSample* sample);
     virtual bool IsInitialized() const;
     virtual unsigned char* GetUCharPointer() = 0;
     virtual const unsigned char* GetUCharPointer() const = 0;
@@ -0,0 +1,101 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#ifndef _svlSampleBufferPool_h
+#define _svlSampleBufferPool_h
+
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+
+#include <map>
+#include <vector>
+
+// Always include last!
+#include <cisstStereoVision/svlExport.h>
+
+
+// Reference counted memory block holding the pixels of a sample.
+// The data is aligned on OSA_CACHE_LINE_SIZE bytes.  The block goes
+// back to svlSampleBufferPool when its last reference is released.
+class CISST_EXPORT svlSampleBuffer
+{
+friend class svlSampleBufferPool;
+
+public:
+    unsigned char* GetPointer() const;
+    size_t GetSize() const;
+
+    void AddReference();
+    void Release();
+    // True if more than one sample references the data, which
+    // then has to be copied before being modified (copy-on-write)
+    bool IsShared() const;
+
+private:
+    svlSampleBuffer(size_t size);
+    ~svlSampleBuffer();
+    svlSampleBuffer(const svlSampleBuffer &);
+    svlSampleBuffer & operator= (const svlSampleBuffer &);
+
+    osaAtomic<unsigned int> ReferenceCount;
+    size_t Size;
+    unsigned char* Memory;
+    unsigned char* Data;
+};
+
+
+// Process wide pool of sample buffers, indexed by size.  Image samples
+// of a given type and dimensions always request the same size, so a
+// stream running at a constant resolution stops allocating memory
+// after the first frames.
+class CISST_EXPORT svlSampleBufferPool
+{
+public:
+    static svlSampleBufferPool* GetInstance();
+
+    // Returns a buffer with one reference
+    svlSampleBuffer* Acquire(size_t size);
+
+    // Number of unused buffers kept for each size
+    void SetMaximumFreeBuffers(unsigned int count);
+    unsigned int GetMaximumFreeBuffers() const;
+    // Deletes all unused buffers
+    void Clear();
+
+    unsigned int GetAllocationCount() const;
+    unsigned int GetReuseCount() const;
+
+private:
+    friend class svlSampleBuffer;
+
+    svlSampleBufferPool();
+    ~svlSampleBufferPool();
+    svlSampleBufferPool(const svlSampleBufferPool &);
+    svlSampleBufferPool & operator= (const svlSampleBufferPool &);
+
+    void Recycle(svlSampleBuffer* buffer);
+
+    typedef std::map<size_t, std::vector<svlSampleBuffer*> > FreeBuffersType;
+    FreeBuffersType FreeBuffers;
+    unsigned int MaximumFreeBuffers;
+    unsigned int AllocationCount;
+    unsigned int ReuseCount;
+    mutable osaCriticalSection CS;
+};
+
+#endif // _svlSampleBufferPool_h
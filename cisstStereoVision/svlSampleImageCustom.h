@@ -27,6 +27,9 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstStereoVision/svlProcInfo.h>
 #include <cisstStereoVision/svlSampleImage.h>
 #include <cisstStereoVision/svlSampleMatrix.h>
+#include <cisstStereoVision/svlSampleBufferPool.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
 #include <cisstStereoVision/svlImageIO.h>
 
 // Always include last!
@@ -49,8 +52,7 @@ public:
         OwnData(true)
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            OwnImage[vch] = new vctDynamicMatrix<_ValueType>;
-            Image[vch].SetRef(*(OwnImage[vch]));
+            Image[vch].SetRef(InvalidMatrix);
 #if CISST_SVL_HAS_OPENCV
             int ocvdepth = GetOCVDepth();
             if (ocvdepth >= 0) OCVImageHeader[vch] = cvCreateImageHeader(cvSize(0, 0), ocvdepth, _DataChannels);
@@ -64,13 +66,7 @@ public:
         OwnData(owndata)
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            if (OwnData) {
-                OwnImage[vch] = new vctDynamicMatrix<_ValueType>;
-                Image[vch].SetRef(*(OwnImage[vch]));
-            }
-            else {
-                OwnImage[vch] = 0;
-            }
+            if (OwnData) Image[vch].SetRef(InvalidMatrix);
 #if CISST_SVL_HAS_OPENCV
             int ocvdepth = GetOCVDepth();
             if (ocvdepth >= 0) OCVImageHeader[vch] = cvCreateImageHeader(cvSize(0, 0), ocvdepth, _DataChannels);
@@ -84,8 +80,7 @@ public:
         OwnData(true)
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            OwnImage[vch] = new vctDynamicMatrix<_ValueType>;
-            Image[vch].SetRef(*(OwnImage[vch]));
+            Image[vch].SetRef(InvalidMatrix);
 #if CISST_SVL_HAS_OPENCV
             int ocvdepth = GetOCVDepth();
             if (ocvdepth >= 0) OCVImageHeader[vch] = cvCreateImageHeader(cvSize(0, 0), ocvdepth, _DataChannels);
@@ -103,7 +98,8 @@ public:
     ~svlSampleImageCustom()
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
-            if (OwnImage[vch]) delete OwnImage[vch];
+            svlSampleBuffer* buffer = OwnBuffer[vch].LoadRelaxed();
+            if (buffer) buffer->Release();
 #if CISST_SVL_HAS_OPENCV
             if (OCVImageHeader[vch]) cvReleaseImageHeader(&(OCVImageHeader[vch]));
 #endif // CISST_SVL_HAS_OPENCV
@@ -211,6 +207,8 @@ public:
 
         const svlSampleImage* sampleimage = dynamic_cast<const svlSampleImage*>(sample);
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
+            // Previous content is overwritten, no need to copy it
+            Detach(vch, false);
             memcpy(GetUCharPointer(vch), sampleimage->GetUCharPointer(vch), GetDataSize(vch));
         }
         SetTimestamp(sample->GetTimestamp());
@@ -224,6 +222,8 @@ public:
 
         const svlSampleImage* sampleimage = dynamic_cast<const svlSampleImage*>(&sample);
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
+            // Previous content is overwritten, no need to copy it
+            Detach(vch, false);
             memcpy(GetUCharPointer(vch), sampleimage->GetUCharPointer(vch), GetDataSize(vch));
         }
         SetTimestamp(sample.GetTimestamp());
@@ -231,6 +231,26 @@ public:
         return SVL_OK;
     }
 
+    int ShareOf(const svlSample* sample)
+    {
+        if (!sample) return SVL_FAIL;
+        if (sample->GetType() != GetType()) return SVL_FAIL;
+
+        const svlSampleImageCustom<_ValueType, _DataChannels, _VideoChannels>* sampleimage =
+            dynamic_cast<const svlSampleImageCustom<_ValueType, _DataChannels, _VideoChannels>*>(sample);
+        if (!sampleimage || !OwnData || !sampleimage->OwnData) return CopyOf(sample);
+
+        for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
+            // Both samples reference the same data until one of them is modified
+            svlSampleBuffer* buffer = sampleimage->OwnBuffer[vch].Load();
+            if (buffer) buffer->AddReference();
+            SetBuffer(vch, buffer, sampleimage->GetWidth(vch), sampleimage->GetHeight(vch));
+        }
+        SetTimestamp(sample->GetTimestamp());
+
+        return SVL_OK;
+    }
+
     bool IsInitialized() const
     {
         for (unsigned int vch = 0; vch < _VideoChannels; vch ++) {
@@ -323,7 +343,11 @@ public:
 #endif // CISST_SVL_HAS_OPENCV
     {
 #if CISST_SVL_HAS_OPENCV
-        if (videochannel < _VideoChannels) return OCVImageHeader[videochannel];
+        if (videochannel < _VideoChannels) {
+            // OpenCV may modify the image through the header
+            const_cast<svlSampleImageCustom<_ValueType, _DataChannels, _VideoChannels>*>(this)->Detach(videochannel);
+            return OCVImageHeader[videochannel];
+        }
         else return 0;
 #else // CISST_SVL_HAS_OPENCV
         CMN_LOG_CLASS_INIT_ERROR << "Class svlSampleImageCustom: IplImageRef() called while OpenCV is disabled" << std::endl;
@@ -338,7 +362,11 @@ public:
 #endif // CISST_SVL_HAS_OPENCV
     {
 #if CISST_SVL_HAS_OPENCV
-        if (videochannel < _VideoChannels) return cv::Mat(OCVImageHeader[videochannel]);
+        if (videochannel < _VideoChannels) {
+            // OpenCV may modify the image through the header
+            const_cast<svlSampleImageCustom<_ValueType, _DataChannels, _VideoChannels>*>(this)->Detach(videochannel);
+            return cv::Mat(OCVImageHeader[videochannel]);
+        }
         else return cv::Mat();
 #else // CISST_SVL_HAS_OPENCV
         CMN_LOG_CLASS_INIT_ERROR << "Class svlSampleImageCustom: CvMatRef() called while OpenCV is disabled" << std::endl;
@@ -378,19 +406,11 @@ public:
         if (OwnData && videochannel < _VideoChannels) {
             if (GetWidth (videochannel) == width &&
                 GetHeight(videochannel) == height) return;
-            OwnImage[videochannel]->SetSize(height,  width * _DataChannels);
-            Image[videochannel].SetRef(*(OwnImage[videochannel]));
-#if CISST_SVL_HAS_OPENCV
-            if (OCVImageHeader[videochannel]) {
-                cvInitImageHeader(OCVImageHeader[videochannel],
-                                  cvSize(width, height),
-                                  GetOCVDepth(),
-                                  _DataChannels);
-                cvSetData(OCVImageHeader[videochannel],
-                          GetPointer(videochannel),
-                          width * GetBPP());
-            }
-#endif // CISST_SVL_HAS_OPENCV
+            // Image data comes from the pool of sample buffers
+            const size_t size = static_cast<size_t>(width) * height * GetBPP();
+            SetBuffer(videochannel,
+                      size ? svlSampleBufferPool::GetInstance()->Acquire(size) : 0,
+                      width, height);
         }
     }
 
@@ -433,6 +453,7 @@ public:
 #if CISST_SVL_HAS_OPENCV
         if (GetOCVImagePixelType(ipl_image) == GetPixelType()) {
             if (SetSize(ipl_image, videochannel) != SVL_OK) return SVL_FAIL;
+            Detach(videochannel, false);
             memcpy(GetUCharPointer(videochannel), ipl_image->imageData, GetDataSize(videochannel));
             return SVL_OK;
         }
@@ -449,6 +470,7 @@ public:
 #if CISST_SVL_HAS_OPENCV
         if (GetOCVImagePixelType(cv_mat) == GetPixelType()) {
             if (SetSize(cv_mat, videochannel) != SVL_OK) return SVL_FAIL;
+            Detach(videochannel, false);
             memcpy(GetUCharPointer(videochannel), cv_mat.data, GetDataSize(videochannel));
             return SVL_OK;
         }
@@ -503,6 +525,9 @@ public:
 
             const unsigned int width = GetWidth(videochannel);
 
+            // The sub-image may be modified
+            Detach(videochannel);
+
             // Create sub-matrix reference
             vctDynamicMatrixRef<_ValueType> subref(Image[videochannel], top, 0, height, width * _DataChannels);
 
@@ -584,7 +609,10 @@ public:
 
     vctDynamicMatrixRef<_ValueType> GetMatrixRef(const unsigned int videochannel = 0)
     {
-        if (videochannel < _VideoChannels) return Image[videochannel];
+        if (videochannel < _VideoChannels) {
+            Detach(videochannel);
+            return Image[videochannel];
+        }
         else return InvalidMatrix;
     }
 
@@ -596,7 +624,10 @@ public:
 
     _ValueType* GetPointer(const unsigned int videochannel = 0)
     {
-        if (videochannel < _VideoChannels) return Image[videochannel].Pointer();
+        if (videochannel < _VideoChannels) {
+            Detach(videochannel);
+            return Image[videochannel].Pointer();
+        }
         return 0;
     }
 
@@ -609,6 +640,7 @@ public:
     _ValueType* GetPointer(const unsigned int videochannel, const unsigned int x, const unsigned int y)
     {
         if (videochannel < _VideoChannels) {
+            Detach(videochannel);
             return Image[videochannel].Pointer(y, x * _DataChannels);
         }
         return 0;
@@ -625,9 +657,54 @@ public:
 private:
     bool OwnData;
     vctDynamicMatrixRef<_ValueType> Image[_VideoChannels];
-    vctDynamicMatrix<_ValueType>*   OwnImage[_VideoChannels];
+    osaAtomic<svlSampleBuffer*>     OwnBuffer[_VideoChannels];
+    osaCriticalSection              DetachCS[_VideoChannels];
     vctDynamicMatrix<_ValueType>    InvalidMatrix;
 
+    // Replaces the image data of a video channel, the sample takes
+    // over the reference to 'buffer'.  The buffer is set after the
+    // image reference and the previous one released last, see Detach.
+    void SetBuffer(const unsigned int videochannel, svlSampleBuffer* buffer, const unsigned int width, const unsigned int height)
+    {
+        svlSampleBuffer* previous = OwnBuffer[videochannel].LoadRelaxed();
+        Image[videochannel].SetRef(height, width * _DataChannels,
+                                   buffer ? reinterpret_cast<_ValueType*>(buffer->GetPointer()) : 0);
+#if CISST_SVL_HAS_OPENCV
+        if (OCVImageHeader[videochannel]) {
+            cvInitImageHeader(OCVImageHeader[videochannel],
+                              cvSize(width, height),
+                              GetOCVDepth(),
+                              _DataChannels);
+            cvSetData(OCVImageHeader[videochannel],
+                      Image[videochannel].Pointer(),
+                      width * GetBPP());
+        }
+#endif // CISST_SVL_HAS_OPENCV
+        OwnBuffer[videochannel].Store(buffer);
+        if (previous) previous->Release();
+    }
+
+    // Copy-on-write: called before the image data can be modified,
+    // gets a private copy if the data is shared with other samples.
+    // The processing threads of a filter call the non-const accessors
+    // on the same sample concurrently, so the channel is locked once
+    // the data is found shared: only one thread copies the data and
+    // the others wait for the copy.
+    void Detach(const unsigned int videochannel, const bool keepcontent = true)
+    {
+        svlSampleBuffer* buffer = OwnBuffer[videochannel].Load();
+        if (!buffer || !buffer->IsShared()) return;
+        DetachCS[videochannel].Enter();
+        // another thread may have detached the channel meanwhile
+        buffer = OwnBuffer[videochannel].LoadRelaxed();
+        if (buffer->IsShared()) {
+            svlSampleBuffer* copy = svlSampleBufferPool::GetInstance()->Acquire(buffer->GetSize());
+            if (keepcontent) memcpy(copy->GetPointer(), buffer->GetPointer(), buffer->GetSize());
+            SetBuffer(videochannel, copy, GetWidth(videochannel), GetHeight(videochannel));
+        }
+        DetachCS[videochannel].Leave();
+    }
+
 #if CISST_SVL_HAS_OPENCV
     IplImage* OCVImageHeader[_VideoChannels];
 
@@ -25,6 +25,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstMultiTask/mtsComponent.h>
+#include <cisstStereoVision/svlDefinitions.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -35,8 +36,11 @@ class svlSyncPoint;
 class svlFilterBase;
 class svlFilterSourceBase;
 class svlStreamProc;
+class svlStreamPipelineQueue;
 class osaThread;
 class osaCriticalSection;
+class osaTimeServer;
+class osaThreadSignal;
 
 
 class CISST_EXPORT svlStreamManager: public mtsComponent
@@ -44,6 +48,7 @@ class CISST_EXPORT svlStreamManager: public mtsComponent
     CMN_DECLARE_SERVICES(CMN_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
 
 friend class svlStreamProc;
+friend class svlStreamPipelineQueue;
 
 public:
     svlStreamManager();
@@ -61,6 +66,25 @@ public:
     int GetStreamStatus(void) const;
     void DisconnectAll(void);
 
+    // Barrier used to synchronize the threads processing each filter,
+    // see svlSyncPoint::Type.  Must be set before Play().
+    int SetSyncType(svlSyncType type);
+    svlSyncType GetSyncType(void) const;
+
+    // Pipeline mode: instead of splitting every filter across all the
+    // threads, the trunk filters are assigned to up to 'threadcount'
+    // stages, each running on its own thread.  Samples are copied into
+    // bounded queues of 'queuesize' slots between stages so that several
+    // frames are processed at the same time.  Must be set before Play().
+    int SetPipelineMode(bool enable, unsigned int queuesize = 2);
+    bool GetPipelineMode(void) const;
+    // Statistics of the last pipelined run
+    unsigned int GetPipelineStageCount(void) const;
+    double GetPipelineStageOccupancy(unsigned int stage) const;
+    double GetPipelineAverageLatency(void) const;
+    double GetPipelineMaximumLatency(void) const;
+    unsigned int GetPipelineFrameCount(void) const;
+
     // Virtual methods from mtsComponent (these are temporary measures until 
     // ticket #67 is resolved)
     void Start(void) { Play(); }
@@ -71,6 +95,7 @@ private:
     vctDynamicVector<svlStreamProc*> StreamProcInstance;
     vctDynamicVector<osaThread*> StreamProcThread;
     svlSyncPoint* SyncPoint;
+    svlSyncType SyncType;
     osaCriticalSection* CS;
 
     svlFilterSourceBase* StreamSource;
@@ -79,7 +104,22 @@ private:
     bool StopThread;
     int StreamStatus;
 
+    bool Pipelined;
+    unsigned int PipelineQueueSize;
+    vctDynamicVector<svlStreamPipelineQueue*> PipelineQueues;
+    osaTimeServer* PipelineTimeServer;
+    // Written by the stage threads
+    vctDynamicVector<double> PipelineBusyTime;
+    vctDynamicVector<double> PipelineElapsedTime;
+    double PipelineLatencySum;
+    double PipelineLatencyMax;
+    unsigned int PipelineFrames;
+    // Raised by the last stage when the end of stream went through
+    osaThreadSignal* PipelineDrained;
+
     void InternalStop(unsigned int callingthreadID);
+    void CreatePipeline(void);
+    void DeletePipeline(void);
 
 protected:
     virtual void CreateInterfaces(void);
@@ -24,16 +24,62 @@ http://www.cisst.org/cisst/license.txt.
 #define _svlStreamProc_h
 
 #include <cisstOSAbstraction/osaForwardDeclarations.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
 #include <cisstStereoVision/svlForwardDeclarations.h>
 #include <cisstStereoVision/svlTypes.h>
 
 
+// Bounded queue passing samples between two pipeline stages.
+// The producing stage copies its output sample into a free slot; the
+// consuming stage processes the copy and then releases the slot, so
+// that both stages can work on different frames at the same time.
+class svlStreamPipelineQueue
+{
+public:
+    struct Slot {
+        svlSample* Sample;
+        bool HasSample;
+        bool EndOfStream;
+        unsigned int FrameCounter;
+        double StartTime;
+    };
+
+    svlStreamPipelineQueue(unsigned int size);
+    ~svlStreamPipelineQueue();
+
+    // Producer side, returns 0 if the stream is stopped while waiting
+    Slot* GetFreeSlot(svlStreamManager* baseref);
+    void Push(void);
+
+    // Consumer side, returns 0 if the stream is stopped while waiting
+    Slot* GetFilledSlot(svlStreamManager* baseref);
+    void Release(void);
+
+private:
+    svlStreamPipelineQueue();
+    svlStreamPipelineQueue(const svlStreamPipelineQueue &);
+
+    bool IsAborted(svlStreamManager* baseref) const;
+
+    unsigned int Size;
+    Slot* Slots;
+    osaAtomic<unsigned int> Head;
+    osaAtomic<unsigned int> Tail;
+    osaThreadSignal NotEmpty;
+    osaThreadSignal NotFull;
+};
+
+
 class svlStreamProc
 {
 public:
     svlStreamProc(unsigned int threadcount, unsigned int threadid);
+    svlStreamProc(unsigned int stageid, svlFilterBase* firstfilter, unsigned int filtercount,
+                  svlStreamPipelineQueue* inputqueue, svlStreamPipelineQueue* outputqueue);
 
     void* Proc(svlStreamManager* baseref);
+    void* PipelineProc(svlStreamManager* baseref);
 
 private:
     svlStreamProc();
@@ -42,6 +88,12 @@ private:
 
     unsigned int ThreadID;
     unsigned int ThreadCount;
+
+    // Pipeline stage, see svlStreamManager::SetPipelineMode
+    svlFilterBase* FirstFilter;
+    unsigned int FilterCount;
+    svlStreamPipelineQueue* InputQueue;
+    svlStreamPipelineQueue* OutputQueue;
 };
 
 #endif // _svlStreamProc_h
@@ -24,6 +24,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstOSAbstraction/osaThreadSignal.h>
 #include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstStereoVision/svlDefinitions.h>
 
 // Always include last!
 #include <cisstStereoVision/svlExport.h>
@@ -37,15 +39,32 @@ public:
 
     int Count(unsigned int count);
     unsigned int Count();
+    int Type(svlSyncType type);
+    svlSyncType Type();
     int Sync(unsigned int _id);
     void ReleaseAll();
 
 private:
+    int SpinSync(unsigned int _id);
+    void WakeParked();
+
     unsigned int ThreadCount;
+    svlSyncType SyncType;
     int LastChanged;
     unsigned int CheckedInCounter;
     osaThreadSignal* ReleaseEvent;
     osaCriticalSection CS;
+
+    // svlSyncSpin: number of threads still expected in the current cycle
+    osaAtomic<unsigned int> Remaining;
+    char PaddingRemaining[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>)];
+    // svlSyncSpin: sense, changed by the last thread of each cycle;
+    // waiting threads spin on it then park on it
+    osaAtomic<unsigned int> Sense;
+    char PaddingSense[OSA_CACHE_LINE_SIZE - sizeof(osaAtomic<unsigned int>)];
+    osaAtomic<unsigned int> Parked;
+    bool Released;
+    unsigned int SpinCount;
 };
 
 #endif // _svlSyncPoint_h
@@ -78,15 +78,19 @@ protected:
     bool OverwriteTemplates;
     bool TemplateUpdateEnabled;
     unsigned int FrameCounter;
-    unsigned int ThreadCounter;
     unsigned int TemplateRadiusRequested;
     unsigned int SearchRadiusRequested;
     unsigned int TemplateRadius;
     unsigned int SearchRadius;
-    vctDynamicMatrix<int> MatchMap;
     vctFixedSizeVector<vctDynamicMatrix<unsigned int>, 3> SumTable;
     vctFixedSizeVector<vctDynamicMatrix<unsigned int>, 3> SqSumTable;
-    vctFixedSizeVector<vctDynamicVector<int>, 128> ZeroMeanTemplate;
+    svlRect SumTableRect;
+    // Work buffers, one for each processing thread; threads beyond
+    // MAX_THREADS take part in the synchronization but do not track
+    enum {MAX_THREADS = 128};
+    vctFixedSizeVector<vctDynamicMatrix<int>, MAX_THREADS> MatchMap;
+    vctFixedSizeVector<vctDynamicVector<int>, MAX_THREADS> ZeroMeanTemplate;
+    vctFixedSizeVector<vctDynamicVector<int>, MAX_THREADS> Correlations;
 
     int HighPassFilterRadius;
     double HighPassFilterStrength;
@@ -105,12 +109,12 @@ protected:
 
     virtual void CopyTemplate(unsigned char* img, unsigned char* tmp, unsigned int left, unsigned int top);
     virtual void UpdateTemplate(unsigned char* img, unsigned char* tmp, unsigned int left, unsigned int top);
-    virtual void MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void MatchTemplateNCC(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int x, int y);
-    virtual void MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int x, int y);
-    virtual void GetBestMatch(int &x, int &y, unsigned char &conf, bool higherbetter);
+    virtual void MatchTemplateSAD(unsigned char* img, unsigned char* tmp, int* map, int x, int y);
+    virtual void MatchTemplateSSD(unsigned char* img, unsigned char* tmp, int* map, int x, int y);
+    virtual void MatchTemplateNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int* correlations, int* map, int x, int y);
+    virtual void MatchTemplateFastNCC(unsigned char* img, unsigned char* tmp, int* zero_mean_tmp, int* correlations, int* map, int x, int y);
+    virtual void MatchTemplateNotQuiteNCC(unsigned char* img, unsigned char* tmp, int* map, int x, int y);
+    virtual void GetBestMatch(int* map, int &x, int &y, unsigned char &conf, bool higherbetter);
     virtual void ShrinkImage(unsigned char* src, unsigned char* dst);
     virtual void CalculateSumTables(unsigned char* img);
 };
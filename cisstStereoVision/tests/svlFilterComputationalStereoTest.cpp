@@ -0,0 +1,307 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlCameraGeometry.h>
+#include <cisstStereoVision/svlFilterSourceBase.h>
+#include <cisstStereoVision/svlFilterInput.h>
+#include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlFilterComputationalStereo.h>
+#include <cisstStereoVision/svlStreamManager.h>
+
+#include "svlFilterComputationalStereoTest.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+    const char * ComputationalStereoTestLevelNames[] = { "scalar", "SSE2", "AVX2" };
+
+    const int ComputationalStereoTestWidth = 160;
+    const int ComputationalStereoTestHeight = 96;
+    const int ComputationalStereoTestMaxDisparity = 24;
+    // disparity of the background and of the square in the middle
+    const int ComputationalStereoTestBackground = 6;
+    const int ComputationalStereoTestForeground = 14;
+    const unsigned int ComputationalStereoTestFrames = 2;
+
+    // random texture on the left, the right image sees the same texture
+    // shifted to the left by the disparity of each pixel
+    template <class _imageType>
+    void ComputationalStereoTestPair(_imageType & image)
+    {
+        const int width = ComputationalStereoTestWidth;
+        const int height = ComputationalStereoTestHeight;
+        const int channels = image.GetBPP();
+        image.SetSize(width, height);
+
+        std::srand(7);
+        unsigned char * left = image.GetUCharPointer(SVL_LEFT);
+        for (int index = 0; index < width * height * channels; ++index) {
+            left[index] = static_cast<unsigned char>(std::rand() >> 4);
+        }
+
+        unsigned char * right = image.GetUCharPointer(SVL_RIGHT);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const bool square = (x >= width / 3 && x < width * 2 / 3 &&
+                                     y >= height / 4 && y < height * 3 / 4);
+                const int source = x + (square ? ComputationalStereoTestForeground : ComputationalStereoTestBackground);
+                for (int channel = 0; channel < channels; ++channel) {
+                    right[(y * width + x) * channels + channel] =
+                        (source < width) ? left[(y * width + source) * channels + channel]
+                                         : static_cast<unsigned char>(std::rand() >> 4);
+                }
+            }
+        }
+    }
+
+    // sends the same stereo pair 'frameCount' times
+    class svlComputationalStereoTestSource: public svlFilterSourceBase
+    {
+    public:
+        svlComputationalStereoTestSource(svlSampleImage & image, unsigned int frameCount):
+            svlFilterSourceBase(),
+            Image(image),
+            FrameCount(frameCount),
+            Sent(0)
+        {
+            AddOutput("output", true);
+            SetAutomaticOutputType(false);
+            GetOutput()->SetType(image.GetType());
+            SetTargetFrequency(0.0);
+        }
+
+    protected:
+        int Initialize(svlSample * & syncOutput)
+        {
+            Sent = 0;
+            syncOutput = &Image;
+            return SVL_OK;
+        }
+
+        int Process(svlProcInfo * procInfo, svlSample * & syncOutput)
+        {
+            syncOutput = &Image;
+            _OnSingleThread(procInfo) {
+                if (Sent >= FrameCount) {
+                    return SVL_STOP_REQUEST;
+                }
+                Sent++;
+            }
+            return SVL_OK;
+        }
+
+    private:
+        svlSampleImage & Image;
+        unsigned int FrameCount;
+        unsigned int Sent;
+    };
+
+    // appends the disparity maps of all the frames
+    class svlComputationalStereoTestSink: public svlFilterBase
+    {
+    public:
+        svlComputationalStereoTestSink(void):
+            svlFilterBase()
+        {
+            AddInput("input", true);
+            AddInputType("input", svlTypeMatrixFloat);
+        }
+
+        std::vector<float> Disparities;
+
+    protected:
+        int Initialize(svlSample * syncInput, svlSample * & syncOutput)
+        {
+            syncOutput = syncInput;
+            return SVL_OK;
+        }
+
+        int Process(svlProcInfo * procInfo, svlSample * syncInput, svlSample * & syncOutput)
+        {
+            syncOutput = syncInput;
+            _OnSingleThread(procInfo) {
+                const svlSampleMatrixFloat * matrix = dynamic_cast<const svlSampleMatrixFloat *>(syncInput);
+                const float * data = reinterpret_cast<const float *>(matrix->GetUCharPointer());
+                Disparities.insert(Disparities.end(), data, data + matrix->GetCols() * matrix->GetRows());
+            }
+            return SVL_OK;
+        }
+    };
+
+    struct ComputationalStereoTestSetup {
+        unsigned int Threads;
+        svlSyncType Sync;
+        unsigned int ScaleFactor;
+        bool CrossCheck;
+    };
+
+    std::vector<float> ComputationalStereoTestRun(svlSampleImage & image,
+                                                  const ComputationalStereoTestSetup & setup)
+    {
+        const int width = ComputationalStereoTestWidth;
+        const int height = ComputationalStereoTestHeight;
+
+        svlCameraGeometry geometry;
+        for (int camera = SVL_LEFT; camera <= SVL_RIGHT; ++camera) {
+            geometry.SetIntrinsics(width, width, width / 2, height / 2,
+                                   0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+                                   camera);
+            geometry.SetExtrinsics(0.0, 0.0, 0.0,
+                                   (camera == SVL_RIGHT) ? 10.0 : 0.0, 0.0, 0.0,
+                                   camera);
+        }
+
+        svlComputationalStereoTestSource source(image, ComputationalStereoTestFrames);
+        svlFilterComputationalStereo stereo;
+        svlComputationalStereoTestSink sink;
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stereo.SetCameraGeometry(geometry));
+        stereo.SetROI(5, 5, width - ComputationalStereoTestMaxDisparity, height - 5);
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stereo.SetCrossCheck(setup.CrossCheck));
+        stereo.SetDisparityRange(0, ComputationalStereoTestMaxDisparity);
+        stereo.SetScalingFactor(setup.ScaleFactor);
+        stereo.SetBlockSize(3);
+        stereo.SetQuickSearchRadius(ComputationalStereoTestMaxDisparity);
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, source.GetOutput()->ConnectInternal(stereo.GetInput()));
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stereo.GetOutput()->ConnectInternal(sink.GetInput()));
+
+        svlStreamManager stream(setup.Threads);
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.SetSyncType(setup.Sync));
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.SetSourceFilter(&source));
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.Play());
+        // WaitForStop() would check every 0.2 s
+        for (unsigned int i = 0; i < 60000 && stream.IsRunning(); i++) {
+            osaSleep(0.001);
+        }
+        CPPUNIT_ASSERT(!stream.IsRunning());
+        stream.Release();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(ComputationalStereoTestFrames * width * height),
+                             sink.Disparities.size());
+        return sink.Disparities;
+    }
+
+    // most of the pixels well inside the background and the square
+    // have the disparity they were built with
+    void ComputationalStereoTestCheckDisparities(const std::string & name, const std::vector<float> & disparities,
+                                                 const ComputationalStereoTestSetup & setup)
+    {
+        const int width = ComputationalStereoTestWidth;
+        const int height = ComputationalStereoTestHeight;
+        const int margin = 8;
+        unsigned int background = 0, backgroundMatches = 0, square = 0, squareMatches = 0;
+        for (int y = height / 4 + margin; y < height * 3 / 4 - margin; ++y) {
+            for (int x = margin; x < width - ComputationalStereoTestMaxDisparity - margin; ++x) {
+                const float disparity = disparities[y * width + x];
+                if (x >= width / 3 + margin && x < width * 2 / 3 - margin) {
+                    square++;
+                    if (std::abs(disparity - ComputationalStereoTestForeground) <= 1.0f) squareMatches++;
+                }
+                else if (x < width / 3 - margin - ComputationalStereoTestForeground || x >= width * 2 / 3 + margin) {
+                    background++;
+                    if (std::abs(disparity - ComputationalStereoTestBackground) <= 1.0f) backgroundMatches++;
+                }
+            }
+        }
+        std::stringstream message;
+        message << name << ", scale " << setup.ScaleFactor << (setup.CrossCheck ? ", cross-check" : "")
+                << ": " << squareMatches << "/" << square << " pixels of the square and "
+                << backgroundMatches << "/" << background << " pixels of the background match";
+        CPPUNIT_ASSERT_MESSAGE(message.str(), squareMatches * 10 >= square * 9 && backgroundMatches * 10 >= background * 9);
+    }
+
+    // Compare every setup to the single threaded scalar reference
+    void ComputationalStereoTestCompare(const std::string & name, svlSampleImage & image, bool crossCheck)
+    {
+        const unsigned int threads[] = { 2, 3, 4, 7 };
+        const int supported = svlImageProcessing::GetSupportedSIMDLevel();
+
+        for (unsigned int scale = 0; scale <= 1; ++scale) {
+            ComputationalStereoTestSetup setup = { 1, svlSyncSignals, scale, crossCheck };
+            svlImageProcessing::SetSIMDLevel(svlImageProcessing::SIMD_None);
+            const std::vector<float> reference = ComputationalStereoTestRun(image, setup);
+            ComputationalStereoTestCheckDisparities(name, reference, setup);
+
+            for (int level = svlImageProcessing::SIMD_None; level <= supported; ++level) {
+                svlImageProcessing::SetSIMDLevel(static_cast<svlImageProcessing::SIMD_Level>(level));
+                for (unsigned int index = 0; index < sizeof(threads) / sizeof(threads[0]) + 1; ++index) {
+                    if (level == svlImageProcessing::SIMD_None && index == 0) {
+                        continue;
+                    }
+                    setup.Threads = (index == 0) ? 1 : threads[index - 1];
+                    for (int sync = svlSyncSignals; sync <= svlSyncSpin; ++sync) {
+                        setup.Sync = static_cast<svlSyncType>(sync);
+                        const std::vector<float> result = ComputationalStereoTestRun(image, setup);
+                        size_t differences = 0;
+                        for (size_t pixel = 0; pixel < result.size(); ++pixel) {
+                            if (result[pixel] != reference[pixel]) {
+                                ++differences;
+                            }
+                        }
+                        std::stringstream message;
+                        message << name << ", " << ComputationalStereoTestLevelNames[level] << ", " << setup.Threads << " threads, "
+                                << ((setup.Sync == svlSyncSpin) ? "spin" : "signals") << " barrier, scale "
+                                << scale << (crossCheck ? ", cross-check" : "") << ": " << differences
+                                << " disparities differ from the single threaded scalar reference";
+                        CPPUNIT_ASSERT_MESSAGE(message.str(), differences == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void svlFilterComputationalStereoTest::TestRGB(void)
+{
+    svlSampleImageRGBStereo image;
+    ComputationalStereoTestPair(image);
+    ComputationalStereoTestCompare("RGB", image, false);
+}
+
+
+void svlFilterComputationalStereoTest::TestRGBCrossCheck(void)
+{
+    svlSampleImageRGBStereo image;
+    ComputationalStereoTestPair(image);
+    ComputationalStereoTestCompare("RGB", image, true);
+}
+
+
+void svlFilterComputationalStereoTest::TestMono8(void)
+{
+    svlSampleImageMono8Stereo image;
+    ComputationalStereoTestPair(image);
+    ComputationalStereoTestCompare("Mono8", image, false);
+}
+
+
+void svlFilterComputationalStereoTest::TestMono8CrossCheck(void)
+{
+    svlSampleImageMono8Stereo image;
+    ComputationalStereoTestPair(image);
+    ComputationalStereoTestCompare("Mono8", image, true);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(svlFilterComputationalStereoTest);
@@ -0,0 +1,63 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstStereoVision/svlImageProcessing.h>
+
+/*! Compare the disparity maps computed by svlFilterComputationalStereo
+  on a synthetic stereo pair with a single thread and the scalar code
+  (svlImageProcessing::SIMD_None) to the ones computed with several
+  threads, both barrier types and every SIMD level supported by the
+  processor. */
+class svlFilterComputationalStereoTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(svlFilterComputationalStereoTest);
+    {
+        CPPUNIT_TEST(TestRGB);
+        CPPUNIT_TEST(TestRGBCrossCheck);
+        CPPUNIT_TEST(TestMono8);
+        CPPUNIT_TEST(TestMono8CrossCheck);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+    svlImageProcessing::SIMD_Level Level;
+
+public:
+    void setUp(void) {
+        Level = svlImageProcessing::GetSIMDLevel();
+    }
+
+    void tearDown(void) {
+        svlImageProcessing::SetSIMDLevel(Level);
+    }
+
+    /*! Test the color matcher (svlStereoDP) */
+    void TestRGB(void);
+
+    /*! Test the color matcher with cross-checking */
+    void TestRGBCrossCheck(void);
+
+    /*! Test the grayscale matcher (svlStereoDPMono) */
+    void TestMono8(void);
+
+    /*! Test the grayscale matcher with cross-checking */
+    void TestMono8CrossCheck(void);
+};
@@ -0,0 +1,301 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlConverters.h>
+
+#include "svlImageProcessingTest.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+    const char * ImageProcessingTestLevelNames[] = { "scalar", "SSE2", "AVX2" };
+
+    // odd widths and all tail lengths of 16 and 32 byte vectors, then
+    // a couple of larger images
+    const unsigned int ImageProcessingTestSizes[][2] = {
+        {1, 9}, {2, 9}, {3, 9}, {5, 9}, {7, 9}, {8, 9}, {9, 9}, {13, 9}, {15, 9}, {16, 9},
+        {17, 9}, {19, 11}, {23, 9}, {29, 9}, {31, 9}, {32, 9}, {33, 9}, {37, 9}, {43, 9},
+        {47, 9}, {48, 9}, {49, 9}, {63, 9}, {64, 9}, {65, 9}, {95, 9}, {97, 9},
+        {333, 245}, {640, 480}
+    };
+    const unsigned int ImageProcessingTestNumberOfSizes =
+        sizeof(ImageProcessingTestSizes) / sizeof(ImageProcessingTestSizes[0]);
+
+    void ImageProcessingTestFill(svlSampleImage & image)
+    {
+        unsigned char * buffer = image.GetUCharPointer();
+        for (unsigned int index = 0; index < image.GetDataSize(); ++index) {
+            buffer[index] = static_cast<unsigned char>(std::rand() >> 4);
+        }
+    }
+
+    void ImageProcessingTestAppend(std::vector<unsigned char> & result, const svlSampleImage & image)
+    {
+        result.insert(result.end(), image.GetUCharPointer(), image.GetUCharPointer() + image.GetDataSize());
+    }
+
+    // One kernel called through the public API.  Prepare restores the
+    // inputs (some functions work in place), Result collects every
+    // byte written by Run.
+    class ImageProcessingTestCase {
+    public:
+        std::string Name;
+        unsigned int Width, Height;
+
+        virtual ~ImageProcessingTestCase() {}
+        virtual void Prepare(void) = 0;
+        virtual void Run(void) = 0;
+        virtual void Result(std::vector<unsigned char> & result) const = 0;
+    };
+
+    // Source image and a destination image of the same or another size
+    template <class _imageType>
+    class ImageProcessingTestImageCase: public ImageProcessingTestCase {
+    public:
+        _imageType Original, Source, Destination;
+
+        ImageProcessingTestImageCase(unsigned int width, unsigned int height,
+                                     unsigned int destinationWidth, unsigned int destinationHeight) {
+            Original.SetSize(width, height);
+            Source.SetSize(width, height);
+            Destination.SetSize(destinationWidth, destinationHeight);
+            ImageProcessingTestFill(Original);
+            Width = width;
+            Height = height;
+        }
+        void Prepare(void) {
+            memcpy(Source.GetUCharPointer(), Original.GetUCharPointer(), Original.GetDataSize());
+            memset(Destination.GetUCharPointer(), 0, Destination.GetDataSize());
+        }
+        void Result(std::vector<unsigned char> & result) const {
+            ImageProcessingTestAppend(result, Source);
+            ImageProcessingTestAppend(result, Destination);
+        }
+    };
+
+    template <class _imageType>
+    class ImageProcessingTestSeparableConvolution: public ImageProcessingTestImageCase<_imageType> {
+    public:
+        vctDynamicVector<double> Kernel;
+        bool AbsoluteResult;
+
+        ImageProcessingTestSeparableConvolution(unsigned int width, unsigned int height,
+                                                const vctDynamicVector<double> & kernel, bool absres,
+                                                const std::string & name):
+            ImageProcessingTestImageCase<_imageType>(width, height, width, height),
+            Kernel(kernel),
+            AbsoluteResult(absres)
+        {
+            this->Name = name;
+        }
+        void Run(void) {
+            svlImageProcessing::Convolution(&(this->Source), 0, &(this->Destination), 0, Kernel, Kernel, AbsoluteResult);
+        }
+    };
+
+    template <class _imageType>
+    class ImageProcessingTestConvolution: public ImageProcessingTestImageCase<_imageType> {
+    public:
+        vctDynamicMatrix<double> Kernel;
+
+        ImageProcessingTestConvolution(unsigned int width, unsigned int height,
+                                       const vctDynamicMatrix<double> & kernel, const std::string & name):
+            ImageProcessingTestImageCase<_imageType>(width, height, width, height),
+            Kernel(kernel)
+        {
+            this->Name = name;
+        }
+        void Run(void) {
+            svlImageProcessing::Convolution(&(this->Source), 0, &(this->Destination), 0, Kernel, false);
+        }
+    };
+
+    class ImageProcessingTestUnsharpMask: public ImageProcessingTestImageCase<svlSampleImageRGB> {
+    public:
+        ImageProcessingTestUnsharpMask(unsigned int width, unsigned int height):
+            ImageProcessingTestImageCase<svlSampleImageRGB>(width, height, width, height)
+        {
+            Name = "UnsharpMask RGB r=4";
+        }
+        void Run(void) {
+            svlImageProcessing::UnsharpMask(&Source, 0, &Destination, 0, 4, 1.5, 0);
+        }
+    };
+
+    template <class _imageType>
+    class ImageProcessingTestResize: public ImageProcessingTestImageCase<_imageType> {
+    public:
+        ImageProcessingTestResize(unsigned int width, unsigned int height,
+                                  unsigned int destinationWidth, unsigned int destinationHeight,
+                                  const std::string & name):
+            ImageProcessingTestImageCase<_imageType>(width, height, destinationWidth, destinationHeight)
+        {
+            this->Name = name;
+        }
+        void Run(void) {
+            svlImageProcessing::Resize(&(this->Source), 0, &(this->Destination), 0, true);
+        }
+    };
+
+    class ImageProcessingTestDeinterlace: public ImageProcessingTestImageCase<svlSampleImageRGB> {
+    public:
+        svlImageProcessing::DI_Algorithm Algorithm;
+
+        ImageProcessingTestDeinterlace(unsigned int width, unsigned int height,
+                                       svlImageProcessing::DI_Algorithm algorithm, const std::string & name):
+            ImageProcessingTestImageCase<svlSampleImageRGB>(width, height, 1, 1),
+            Algorithm(algorithm)
+        {
+            Name = name;
+        }
+        void Run(void) {
+            svlImageProcessing::Deinterlace(&Source, 0, Algorithm);
+        }
+    };
+
+    class ImageProcessingTestColorConversion: public ImageProcessingTestImageCase<svlSampleImageRGB> {
+    public:
+        bool ToYUV;
+
+        ImageProcessingTestColorConversion(unsigned int width, unsigned int height, bool toYUV):
+            ImageProcessingTestImageCase<svlSampleImageRGB>(width, height, width, height),
+            ToYUV(toYUV)
+        {
+            Name = toYUV ? "RGB24toYUV444" : "YUV444toRGB24";
+        }
+        void Run(void) {
+            if (ToYUV) {
+                svlConverter::RGB24toYUV444(Source.GetUCharPointer(), Destination.GetUCharPointer(), Width * Height);
+            }
+            else {
+                svlConverter::YUV444toRGB24(Source.GetUCharPointer(), Destination.GetUCharPointer(), Width * Height);
+            }
+        }
+    };
+
+    // Run the case with the scalar code and with every supported SIMD
+    // level, deletes the case
+    void ImageProcessingTestCompare(ImageProcessingTestCase * testCase)
+    {
+        const int supported = svlImageProcessing::GetSupportedSIMDLevel();
+        std::vector<unsigned char> reference, result;
+
+        svlImageProcessing::SetSIMDLevel(svlImageProcessing::SIMD_None);
+        testCase->Prepare();
+        testCase->Run();
+        testCase->Result(reference);
+
+        for (int level = svlImageProcessing::SIMD_SSE2; level <= supported; ++level) {
+            svlImageProcessing::SetSIMDLevel(static_cast<svlImageProcessing::SIMD_Level>(level));
+            testCase->Prepare();
+            testCase->Run();
+            result.clear();
+            testCase->Result(result);
+            size_t differences = 0;
+            for (size_t byte = 0; byte < result.size(); ++byte) {
+                if (result[byte] != reference[byte]) {
+                    ++differences;
+                }
+            }
+            std::stringstream message;
+            message << testCase->Name << " (" << ImageProcessingTestLevelNames[level] << ", "
+                    << testCase->Width << "x" << testCase->Height << "): " << differences
+                    << " bytes differ from the scalar reference";
+            CPPUNIT_ASSERT_MESSAGE(message.str(), differences == 0);
+        }
+        delete testCase;
+    }
+}
+
+
+void svlImageProcessingTest::TestConvolution(void)
+{
+    vctDynamicVector<double> gaussian(5, 0.0625, 0.25, 0.375, 0.25, 0.0625);
+    vctDynamicVector<double> derivative(3, -0.5, 0.0, 0.5);
+    vctDynamicMatrix<double> box(5, 5, 1.0 / 25.0);
+    vctDynamicMatrix<double> laplacian(3, 3, 0.0);
+    laplacian.Assign(0.0, 1.0, 0.0,
+                     1.0, -4.0, 1.0,
+                     0.0, 1.0, 0.0);
+
+    std::srand(1);
+    for (unsigned int size = 0; size < ImageProcessingTestNumberOfSizes; ++size) {
+        const unsigned int width = ImageProcessingTestSizes[size][0];
+        const unsigned int height = ImageProcessingTestSizes[size][1];
+        ImageProcessingTestCompare(new ImageProcessingTestSeparableConvolution<svlSampleImageRGB>(width, height, gaussian, false, "Convolution RGB 5+5"));
+        ImageProcessingTestCompare(new ImageProcessingTestSeparableConvolution<svlSampleImageRGB>(width, height, derivative, true, "Convolution RGB 3+3 abs"));
+        ImageProcessingTestCompare(new ImageProcessingTestSeparableConvolution<svlSampleImageRGBA>(width, height, gaussian, false, "Convolution RGBA 5+5"));
+        ImageProcessingTestCompare(new ImageProcessingTestSeparableConvolution<svlSampleImageMono8>(width, height, gaussian, false, "Convolution Mono8 5+5"));
+        ImageProcessingTestCompare(new ImageProcessingTestConvolution<svlSampleImageRGB>(width, height, box, "Convolution RGB 5x5"));
+        ImageProcessingTestCompare(new ImageProcessingTestConvolution<svlSampleImageMono8>(width, height, laplacian, "Convolution Mono8 3x3"));
+    }
+}
+
+
+void svlImageProcessingTest::TestUnsharpMask(void)
+{
+    std::srand(2);
+    for (unsigned int size = 0; size < ImageProcessingTestNumberOfSizes; ++size) {
+        ImageProcessingTestCompare(new ImageProcessingTestUnsharpMask(ImageProcessingTestSizes[size][0],
+                                                                      ImageProcessingTestSizes[size][1]));
+    }
+}
+
+
+void svlImageProcessingTest::TestResize(void)
+{
+    std::srand(3);
+    for (unsigned int size = 0; size < ImageProcessingTestNumberOfSizes; ++size) {
+        const unsigned int width = ImageProcessingTestSizes[size][0];
+        const unsigned int height = ImageProcessingTestSizes[size][1];
+        ImageProcessingTestCompare(new ImageProcessingTestResize<svlSampleImageRGB>(width, height, width, height * 3 / 4, "Resize RGB vertical"));
+        ImageProcessingTestCompare(new ImageProcessingTestResize<svlSampleImageRGB>(width, height, width * 5 / 4, height * 5 / 4, "Resize RGB"));
+        ImageProcessingTestCompare(new ImageProcessingTestResize<svlSampleImageMono8>(width, height, width, height * 3 / 2, "Resize Mono8 vertical"));
+    }
+}
+
+
+void svlImageProcessingTest::TestDeinterlace(void)
+{
+    std::srand(4);
+    for (unsigned int size = 0; size < ImageProcessingTestNumberOfSizes; ++size) {
+        const unsigned int width = ImageProcessingTestSizes[size][0];
+        const unsigned int height = ImageProcessingTestSizes[size][1];
+        ImageProcessingTestCompare(new ImageProcessingTestDeinterlace(width, height, svlImageProcessing::DI_Blending, "Deinterlace blending"));
+        ImageProcessingTestCompare(new ImageProcessingTestDeinterlace(width, height, svlImageProcessing::DI_AdaptiveBlending, "Deinterlace adaptive"));
+    }
+}
+
+
+void svlImageProcessingTest::TestColorConversion(void)
+{
+    std::srand(5);
+    for (unsigned int size = 0; size < ImageProcessingTestNumberOfSizes; ++size) {
+        const unsigned int width = ImageProcessingTestSizes[size][0];
+        const unsigned int height = ImageProcessingTestSizes[size][1];
+        ImageProcessingTestCompare(new ImageProcessingTestColorConversion(width, height, true));
+        ImageProcessingTestCompare(new ImageProcessingTestColorConversion(width, height, false));
+    }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(svlImageProcessingTest);
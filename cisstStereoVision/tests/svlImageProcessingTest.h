@@ -0,0 +1,66 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstStereoVision/svlImageProcessing.h>
+
+/*! Compare the vectorized image processing kernels with the scalar
+  reference (svlImageProcessing::SIMD_None) for every SIMD level
+  supported by the processor.  The widths cover all the tails left by
+  16 and 32 byte vectors. */
+class svlImageProcessingTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(svlImageProcessingTest);
+    {
+        CPPUNIT_TEST(TestConvolution);
+        CPPUNIT_TEST(TestUnsharpMask);
+        CPPUNIT_TEST(TestResize);
+        CPPUNIT_TEST(TestDeinterlace);
+        CPPUNIT_TEST(TestColorConversion);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+    svlImageProcessing::SIMD_Level Level;
+
+public:
+    void setUp(void) {
+        Level = svlImageProcessing::GetSIMDLevel();
+    }
+
+    void tearDown(void) {
+        svlImageProcessing::SetSIMDLevel(Level);
+    }
+
+    /*! Test separable and matrix convolutions of Mono8, RGB and RGBA images */
+    void TestConvolution(void);
+
+    /*! Test unsharp masking of RGB images */
+    void TestUnsharpMask(void);
+
+    /*! Test interpolated resizing of Mono8 and RGB images */
+    void TestResize(void);
+
+    /*! Test blending and adaptive blending deinterlacing */
+    void TestDeinterlace(void);
+
+    /*! Test RGB to YUV444 and YUV444 to RGB conversions */
+    void TestColorConversion(void);
+};
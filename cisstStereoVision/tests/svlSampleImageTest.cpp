@@ -0,0 +1,142 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstStereoVision/svlTypes.h>
+
+#include "svlSampleImageTest.h"
+
+#include <vector>
+
+
+namespace {
+    const unsigned int SampleImageTestWidth = 64;
+    const unsigned int SampleImageTestHeight = 48;
+
+    void svlSampleImageTestFill(svlSampleImageRGB & image, const unsigned char value)
+    {
+        memset(image.GetUCharPointer(0), value, image.GetDataSize(0));
+    }
+
+    bool svlSampleImageTestCheck(const svlSampleImageRGB & image, const unsigned int from, const unsigned int to,
+                                 const unsigned char value)
+    {
+        const unsigned int rowSize = image.GetRowStride(0);
+        const unsigned char * data = image.GetUCharPointer(0) + from * rowSize;
+        const unsigned char * end = image.GetUCharPointer(0) + to * rowSize;
+        for (; data < end; data++) {
+            if (*data != value) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+
+void svlSampleImageTest::TestShareOf(void)
+{
+    svlSampleImageRGB frame, branch;
+    frame.SetSize(SampleImageTestWidth, SampleImageTestHeight);
+    svlSampleImageTestFill(frame, 1);
+
+    // same data until one of them is modified
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, branch.ShareOf(&frame));
+    const svlSampleImageRGB & constBranch = branch;
+    const svlSampleImageRGB & constFrame = frame;
+    CPPUNIT_ASSERT(constBranch.GetUCharPointer(0) == constFrame.GetUCharPointer(0));
+
+    svlSampleImageTestFill(branch, 2);
+    CPPUNIT_ASSERT(constBranch.GetUCharPointer(0) != constFrame.GetUCharPointer(0));
+    CPPUNIT_ASSERT(svlSampleImageTestCheck(frame, 0, SampleImageTestHeight, 1));
+    CPPUNIT_ASSERT(svlSampleImageTestCheck(branch, 0, SampleImageTestHeight, 2));
+
+    // no copy once detached
+    const unsigned char * data = constBranch.GetUCharPointer(0);
+    CPPUNIT_ASSERT(branch.GetUCharPointer(0) == data);
+}
+
+
+namespace {
+    struct svlSampleImageTestThreadData {
+        svlSampleImageRGB * Image;
+        unsigned int From, To;
+        unsigned char Value;
+    };
+
+    // each processing thread of a filter modifies a range of rows
+    void * svlSampleImageTestProcess(svlSampleImageTestThreadData * data)
+    {
+        const unsigned int rowSize = data->Image->GetRowStride(0);
+        for (unsigned int row = data->From; row < data->To; row++) {
+            memset(data->Image->GetUCharPointer(0, 0, row), data->Value, rowSize);
+        }
+        return 0;
+    }
+}
+
+
+void svlSampleImageTest::TestSplitterMultiThreading(void)
+{
+    const size_t numberOfBranches = 2;
+    const size_t numberOfThreads = 4;
+    const unsigned int rowsPerThread = SampleImageTestHeight / numberOfThreads;
+
+    svlSampleImageRGB frame;
+    frame.SetSize(SampleImageTestWidth, SampleImageTestHeight);
+    std::vector<svlSampleImageRGB> branches(numberOfBranches);
+    std::vector<svlSampleImageTestThreadData> data(numberOfBranches * numberOfThreads);
+    std::vector<osaThread *> threads(numberOfBranches * numberOfThreads);
+    size_t branch, thread, index;
+
+    bool error = false;
+    for (unsigned int iteration = 0; iteration < 200; iteration++) {
+        const unsigned char frameValue = static_cast<unsigned char>(iteration);
+        svlSampleImageTestFill(frame, frameValue);
+        // the splitter shares the frame with all branches
+        for (branch = 0; branch < numberOfBranches; branch++) {
+            branches[branch].ShareOf(&frame);
+        }
+        // all threads of all branches detach and modify the frame at once
+        for (branch = 0; branch < numberOfBranches; branch++) {
+            for (thread = 0; thread < numberOfThreads; thread++) {
+                index = branch * numberOfThreads + thread;
+                data[index].Image = &(branches[branch]);
+                data[index].From = static_cast<unsigned int>(thread) * rowsPerThread;
+                data[index].To = data[index].From + rowsPerThread;
+                data[index].Value = static_cast<unsigned char>(frameValue + branch + 1);
+                threads[index] = new osaThread;
+                threads[index]->Create(svlSampleImageTestProcess, &(data[index]));
+            }
+        }
+        for (index = 0; index < threads.size(); index++) {
+            threads[index]->Wait();
+            delete threads[index];
+        }
+        // each branch has its own copy, the frame is untouched
+        error = error || !svlSampleImageTestCheck(frame, 0, SampleImageTestHeight, frameValue);
+        for (branch = 0; branch < numberOfBranches; branch++) {
+            error = error || !svlSampleImageTestCheck(branches[branch], 0, SampleImageTestHeight,
+                                                      static_cast<unsigned char>(frameValue + branch + 1));
+        }
+    }
+    CPPUNIT_ASSERT(!error);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(svlSampleImageTest);
@@ -0,0 +1,43 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class svlSampleImageTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(svlSampleImageTest);
+    {
+        CPPUNIT_TEST(TestShareOf);
+        CPPUNIT_TEST(TestSplitterMultiThreading);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {}
+
+    void tearDown(void) {}
+
+    /*! Test that shared samples are detached when modified */
+    void TestShareOf(void);
+
+    /*! Test that the processing threads of the filters fed by a
+      splitter can modify the shared frame concurrently */
+    void TestSplitterMultiThreading(void);
+};
@@ -0,0 +1,248 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaAtomic.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlFilterSourceBase.h>
+#include <cisstStereoVision/svlFilterInput.h>
+#include <cisstStereoVision/svlFilterOutput.h>
+#include <cisstStereoVision/svlStreamManager.h>
+
+#include "svlStreamManagerTest.h"
+
+#include <vector>
+
+
+namespace {
+    const unsigned int StreamManagerTestWidth = 32;
+    const unsigned int StreamManagerTestHeight = 8;
+    // frame number is stored in the first bytes, followed by the
+    // number of filters that processed the frame
+    const unsigned int StreamManagerTestMarker = sizeof(unsigned int);
+
+    // produces 'frameCount' numbered frames, or until stopped if 0
+    class svlStreamManagerTestSource: public svlFilterSourceBase
+    {
+    public:
+        svlStreamManagerTestSource(unsigned int frameCount):
+            svlFilterSourceBase(),
+            FrameCount(frameCount)
+        {
+            AddOutput("output", true);
+            SetAutomaticOutputType(false);
+            GetOutput()->SetType(svlTypeImageMono8);
+            // as fast as possible
+            SetTargetFrequency(0.0);
+        }
+
+    protected:
+        int Initialize(svlSample * & syncOutput)
+        {
+            Image.SetSize(StreamManagerTestWidth, StreamManagerTestHeight);
+            syncOutput = &Image;
+            return SVL_OK;
+        }
+
+        int Process(svlProcInfo * procInfo, svlSample * & syncOutput)
+        {
+            syncOutput = &Image;
+            _OnSingleThread(procInfo) {
+                if (FrameCount > 0 && FrameCounter >= FrameCount) {
+                    return SVL_STOP_REQUEST;
+                }
+                // the previous frame might still be shared with the next stage
+                unsigned char * data = Image.GetUCharPointer();
+                memset(data, 0, Image.GetDataSize());
+                memcpy(data, &FrameCounter, sizeof(unsigned int));
+            }
+            return SVL_OK;
+        }
+
+    private:
+        unsigned int FrameCount;
+        svlSampleImageMono8 Image;
+    };
+
+    // increments the marker of the frame and passes it downstream
+    class svlStreamManagerTestFilter: public svlFilterBase
+    {
+    public:
+        svlStreamManagerTestFilter(void):
+            svlFilterBase()
+        {
+            AddInput("input", true);
+            AddInputType("input", svlTypeImageMono8);
+            AddOutput("output", true);
+            SetAutomaticOutputType(true);
+        }
+
+    protected:
+        int Initialize(svlSample * syncInput, svlSample * & syncOutput)
+        {
+            syncOutput = syncInput;
+            return SVL_OK;
+        }
+
+        int Process(svlProcInfo * procInfo, svlSample * syncInput, svlSample * & syncOutput)
+        {
+            syncOutput = syncInput;
+            _OnSingleThread(procInfo) {
+                svlSampleImage * image = dynamic_cast<svlSampleImage *>(syncInput);
+                image->GetUCharPointer()[StreamManagerTestMarker]++;
+            }
+            return SVL_OK;
+        }
+    };
+
+    // records the frame numbers and markers
+    class svlStreamManagerTestSink: public svlFilterBase
+    {
+    public:
+        svlStreamManagerTestSink(void):
+            svlFilterBase(),
+            StopCount(0)
+        {
+            AddInput("input", true);
+            AddInputType("input", svlTypeImageMono8);
+        }
+
+        std::vector<unsigned int> Frames;
+        std::vector<unsigned char> Markers;
+        osaAtomic<unsigned int> Received;
+        unsigned int StopCount;
+
+    protected:
+        int Initialize(svlSample * syncInput, svlSample * & syncOutput)
+        {
+            syncOutput = syncInput;
+            return SVL_OK;
+        }
+
+        int Process(svlProcInfo * procInfo, svlSample * syncInput, svlSample * & syncOutput)
+        {
+            syncOutput = syncInput;
+            _OnSingleThread(procInfo) {
+                const svlSampleImage * image = dynamic_cast<const svlSampleImage *>(syncInput);
+                const unsigned char * data = image->GetUCharPointer();
+                unsigned int frame;
+                memcpy(&frame, data, sizeof(unsigned int));
+                Frames.push_back(frame);
+                Markers.push_back(data[StreamManagerTestMarker]);
+                Received.FetchAdd(1);
+            }
+            return SVL_OK;
+        }
+
+        void OnStop(void)
+        {
+            StopCount++;
+        }
+    };
+
+    void svlStreamManagerTestCheckStatistics(const svlStreamManager & stream, const unsigned int stageCount,
+                                             const unsigned int frameCount)
+    {
+        CPPUNIT_ASSERT_EQUAL(stageCount, stream.GetPipelineStageCount());
+        CPPUNIT_ASSERT_EQUAL(frameCount, stream.GetPipelineFrameCount());
+        for (unsigned int stage = 0; stage < stageCount; stage++) {
+            CPPUNIT_ASSERT(stream.GetPipelineStageOccupancy(stage) >= 0.0);
+            CPPUNIT_ASSERT(stream.GetPipelineStageOccupancy(stage) <= 1.0);
+        }
+        CPPUNIT_ASSERT_EQUAL(0.0, stream.GetPipelineStageOccupancy(stageCount));
+        CPPUNIT_ASSERT(stream.GetPipelineAverageLatency() > 0.0);
+        CPPUNIT_ASSERT(stream.GetPipelineAverageLatency() <= stream.GetPipelineMaximumLatency());
+    }
+}
+
+
+void svlStreamManagerTest::TestPipelineEndOfStream(void)
+{
+    const unsigned int frameCount = 200;
+    const unsigned int stageCount = 3;
+    svlStreamManagerTestSource source(frameCount);
+    svlStreamManagerTestFilter filter1, filter2;
+    svlStreamManagerTestSink sink;
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, source.GetOutput()->ConnectInternal(filter1.GetInput()));
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, filter1.GetOutput()->ConnectInternal(filter2.GetInput()));
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, filter2.GetOutput()->ConnectInternal(sink.GetInput()));
+
+    svlStreamManager stream(stageCount);
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.SetSourceFilter(&source));
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.SetPipelineMode(true, 2));
+    CPPUNIT_ASSERT(stream.GetPipelineMode());
+
+    // the statistics are reset when the stream is started again
+    for (unsigned int run = 1; run <= 2; run++) {
+        sink.Frames.clear();
+        sink.Markers.clear();
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.Play());
+        CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.WaitForStop(10.0));
+
+        // end of stream went through all the stages before the stream stopped
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(frameCount), sink.Frames.size());
+        for (unsigned int frame = 0; frame < frameCount; frame++) {
+            CPPUNIT_ASSERT_EQUAL(frame, sink.Frames[frame]);
+            CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(sink.Markers[frame]));
+        }
+        CPPUNIT_ASSERT_EQUAL(run, sink.StopCount);
+        svlStreamManagerTestCheckStatistics(stream, stageCount, frameCount);
+    }
+
+    stream.Release();
+}
+
+
+void svlStreamManagerTest::TestPipelineStop(void)
+{
+    const unsigned int stageCount = 3;
+    svlStreamManagerTestSource source(0);
+    svlStreamManagerTestFilter filter;
+    svlStreamManagerTestSink sink;
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, source.GetOutput()->ConnectInternal(filter.GetInput()));
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, filter.GetOutput()->ConnectInternal(sink.GetInput()));
+
+    svlStreamManager stream(stageCount);
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.SetSourceFilter(&source));
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.SetPipelineMode(true, 2));
+    CPPUNIT_ASSERT_EQUAL(SVL_OK, stream.Play());
+
+    // can't change the mode while running
+    CPPUNIT_ASSERT(stream.SetPipelineMode(false) != SVL_OK);
+
+    for (unsigned int i = 0; i < 1000 && sink.Received.Load() < 100; i++) {
+        osaSleep(0.01);
+    }
+    stream.Stop();
+    CPPUNIT_ASSERT(!stream.IsRunning());
+    CPPUNIT_ASSERT_EQUAL(1u, sink.StopCount);
+
+    // frames in flight are dropped, the others reached the sink in order
+    const unsigned int frameCount = static_cast<unsigned int>(sink.Frames.size());
+    CPPUNIT_ASSERT(frameCount >= 100);
+    for (unsigned int frame = 0; frame < frameCount; frame++) {
+        CPPUNIT_ASSERT_EQUAL(frame, sink.Frames[frame]);
+        CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(sink.Markers[frame]));
+    }
+    svlStreamManagerTestCheckStatistics(stream, stageCount, frameCount);
+
+    stream.Release();
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(svlStreamManagerTest);
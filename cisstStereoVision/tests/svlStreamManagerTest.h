@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class svlStreamManagerTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(svlStreamManagerTest);
+    {
+        CPPUNIT_TEST(TestPipelineEndOfStream);
+        CPPUNIT_TEST(TestPipelineStop);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {}
+
+    void tearDown(void) {}
+
+    /*! Test that all the frames of a finite source reach the last
+      pipeline stage exactly once and in order before the stream stops */
+    void TestPipelineEndOfStream(void);
+
+    /*! Test that a pipelined stream stops on request and that the
+      frames that reached the last stage are consecutive */
+    void TestPipelineStop(void);
+};
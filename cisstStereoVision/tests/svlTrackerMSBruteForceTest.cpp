@@ -0,0 +1,356 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaCriticalSection.h>
+#include <cisstStereoVision/svlTypes.h>
+#include <cisstStereoVision/svlProcInfo.h>
+#include <cisstStereoVision/svlSyncPoint.h>
+#include <cisstStereoVision/svlTrackerMSBruteForce.h>
+
+#include "svlTrackerMSBruteForceTest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+    const char * TrackerTestLevelNames[] = { "scalar", "SSE2", "AVX2" };
+
+    const int TrackerTestWidth = 160;
+    const int TrackerTestHeight = 120;
+    // shift of the texture from the previous frame in each frame
+    const int TrackerTestFrameCount = 5;
+    const int TrackerTestShifts[TrackerTestFrameCount][2] = { {0, 0}, {3, -2}, {-4, 1}, {2, 4}, {-1, -3} };
+    // the corner targets are right at the ROI margin of the largest
+    // template and search radius, so the search windows get clipped
+    // once the texture moves towards the borders
+    const int TrackerTestTargetCount = 11;
+    const int TrackerTestTargets[TrackerTestTargetCount][2] = {
+        {16, 16}, {143, 16}, {16, 103}, {143, 103},
+        {40, 35}, {80, 35}, {120, 35},
+        {40, 85}, {80, 85}, {120, 85},
+        {81, 60}
+    };
+
+    struct TrackerTestSetup {
+        svlErrorMetric Metric;
+        const char * Name;
+        unsigned int Scales;
+        unsigned int TemplateRadius;
+        unsigned int SearchRadius;
+    };
+
+    std::string TrackerTestDescription(const TrackerTestSetup & setup)
+    {
+        std::stringstream description;
+        description << setup.Name << ", " << setup.Scales << " scale(s), template radius "
+                    << setup.TemplateRadius << ", search radius " << setup.SearchRadius;
+        return description.str();
+    }
+
+    // random texture moved by the shifts of TrackerTestShifts, the
+    // uncovered areas and some noise are new random values in each frame
+    void TrackerTestSequence(std::vector<svlSampleImageRGB> & frames, const int noise)
+    {
+        const int channels = 3;
+        const int width = TrackerTestWidth;
+        const int height = TrackerTestHeight;
+        std::srand(11);
+
+        svlSampleImageRGB texture;
+        texture.SetSize(width, height);
+        unsigned char * data = texture.GetUCharPointer();
+        for (int index = 0; index < width * height * channels; ++index) {
+            data[index] = static_cast<unsigned char>(std::rand() >> 4);
+        }
+        // low-pass so that the lower scales have something to track, the
+        // half resolution noise of odd and even shifts would differ
+        const int blur = 2;
+        std::vector<int> sum(width * height * channels);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int channel = 0; channel < channels; ++channel) {
+                    int value = 0, count = 0;
+                    for (int j = std::max(0, y - blur); j <= std::min(height - 1, y + blur); ++j) {
+                        for (int i = std::max(0, x - blur); i <= std::min(width - 1, x + blur); ++i) {
+                            value += data[(j * width + i) * channels + channel];
+                            ++count;
+                        }
+                    }
+                    // stretch the contrast lost by averaging
+                    sum[(y * width + x) * channels + channel] = 128 + 4 * (value / count - 128);
+                }
+            }
+        }
+        for (int index = 0; index < width * height * channels; ++index) {
+            data[index] = static_cast<unsigned char>(std::max(0, std::min(255, sum[index])));
+        }
+
+        frames.resize(TrackerTestFrameCount);
+        int dx = 0, dy = 0;
+        for (int frame = 0; frame < TrackerTestFrameCount; ++frame) {
+            dx += TrackerTestShifts[frame][0];
+            dy += TrackerTestShifts[frame][1];
+            frames[frame].SetSize(width, height);
+            unsigned char * shifted = frames[frame].GetUCharPointer();
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    const int sx = x - dx;
+                    const int sy = y - dy;
+                    for (int channel = 0; channel < channels; ++channel) {
+                        int value;
+                        if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+                            value = data[(sy * width + sx) * channels + channel];
+                            if (noise > 0) {
+                                value += std::rand() % (2 * noise + 1) - noise;
+                                value = std::max(0, std::min(255, value));
+                            }
+                        }
+                        else {
+                            value = std::rand() >> 4;
+                        }
+                        shifted[(y * width + x) * channels + channel] = static_cast<unsigned char>(value);
+                    }
+                }
+            }
+        }
+    }
+
+    struct TrackerTestThreadData {
+        svlTrackerMSBruteForce * Tracker;
+        svlSampleImageRGB * Image;
+        svlProcInfo Info;
+        int Result;
+    };
+
+    // processing thread of the tracker filter
+    void * TrackerTestTrack(TrackerTestThreadData * data)
+    {
+        data->Result = data->Tracker->Track(&(data->Info), *(data->Image));
+        return 0;
+    }
+
+    // tracks the targets through the frames, and returns all the
+    // targets of each frame one after the other
+    bool TrackerTestRun(const TrackerTestSetup & setup, std::vector<svlSampleImageRGB> & frames,
+                        const unsigned int threadCount, const svlSyncType syncType,
+                        std::vector<svlTarget2D> & results)
+    {
+        svlTrackerMSBruteForce tracker;
+        tracker.SetErrorMetric(setup.Metric);
+        tracker.SetScales(setup.Scales);
+        tracker.SetTemplateRadius(setup.TemplateRadius);
+        tracker.SetSearchRadius(setup.SearchRadius);
+        tracker.SetImageSize(TrackerTestWidth, TrackerTestHeight);
+        tracker.SetTargetCount(TrackerTestTargetCount);
+        if (tracker.Initialize() != SVL_OK) {
+            return false;
+        }
+        int target;
+        for (target = 0; target < TrackerTestTargetCount; ++target) {
+            tracker.SetTarget(target, svlTarget2D(true, true, 255,
+                                                  TrackerTestTargets[target][0], TrackerTestTargets[target][1]));
+        }
+
+        svlSyncPoint sync;
+        sync.Count(threadCount);
+        sync.Type(syncType);
+        osaCriticalSection cs;
+        std::vector<TrackerTestThreadData> data(threadCount);
+        std::vector<osaThread *> threads(threadCount);
+        unsigned int thread;
+
+        results.clear();
+        bool ok = true;
+        for (size_t frame = 0; frame < frames.size(); ++frame) {
+            tracker.SetROI(0, 0, TrackerTestWidth - 1, TrackerTestHeight - 1);
+            ok = ok && (tracker.PreProcessImage(frames[frame]) == SVL_OK);
+            if (threadCount == 1) {
+                ok = ok && (tracker.Track(frames[frame]) == SVL_OK);
+            }
+            else {
+                for (thread = 0; thread < threadCount; ++thread) {
+                    data[thread].Tracker = &tracker;
+                    data[thread].Image = &(frames[frame]);
+                    data[thread].Info.count = threadCount;
+                    data[thread].Info.ID = thread;
+                    data[thread].Info.sync = &sync;
+                    data[thread].Info.cs = &cs;
+                    data[thread].Result = SVL_FAIL;
+                    threads[thread] = new osaThread;
+                    threads[thread]->Create(TrackerTestTrack, &(data[thread]));
+                }
+                for (thread = 0; thread < threadCount; ++thread) {
+                    threads[thread]->Wait();
+                    delete threads[thread];
+                    ok = ok && (data[thread].Result == SVL_OK);
+                }
+            }
+            for (target = 0; target < TrackerTestTargetCount; ++target) {
+                svlTarget2D result;
+                tracker.GetTarget(target, result);
+                results.push_back(result);
+            }
+        }
+        tracker.Release();
+        return ok;
+    }
+
+    // number of targets that differ between the two runs
+    size_t TrackerTestDifferences(const std::vector<svlTarget2D> & reference,
+                                  const std::vector<svlTarget2D> & results)
+    {
+        if (results.size() != reference.size()) {
+            return reference.size();
+        }
+        size_t differences = 0;
+        for (size_t index = 0; index < reference.size(); ++index) {
+            if (results[index].visible != reference[index].visible ||
+                results[index].conf != reference[index].conf ||
+                results[index].pos.x != reference[index].pos.x ||
+                results[index].pos.y != reference[index].pos.y) {
+                ++differences;
+            }
+        }
+        return differences;
+    }
+
+    const TrackerTestSetup TrackerTestSetups[] = {
+        {svlSAD,     "SAD",     1, 3, 6},
+        {svlSAD,     "SAD",     1, 9, 6},
+        {svlSAD,     "SAD",     2, 5, 6},
+        {svlSSD,     "SSD",     1, 3, 6},
+        {svlSSD,     "SSD",     1, 9, 6},
+        {svlSSD,     "SSD",     2, 5, 6},
+        {svlNCC,     "NCC",     1, 3, 6},
+        {svlNCC,     "NCC",     1, 9, 6},
+        {svlNCC,     "NCC",     2, 5, 6},
+        {svlFastNCC, "FastNCC", 1, 3, 6},
+        {svlFastNCC, "FastNCC", 1, 9, 6},
+        {svlFastNCC, "FastNCC", 2, 5, 6}
+    };
+    const size_t TrackerTestSetupCount = sizeof(TrackerTestSetups) / sizeof(TrackerTestSetups[0]);
+}
+
+
+void svlTrackerMSBruteForceTest::TestShift(void)
+{
+    std::vector<svlSampleImageRGB> frames;
+    std::vector<svlTarget2D> results;
+    TrackerTestSequence(frames, 0);
+
+    for (size_t index = 0; index < TrackerTestSetupCount; ++index) {
+        const TrackerTestSetup & setup = TrackerTestSetups[index];
+        const std::string description = TrackerTestDescription(setup);
+        CPPUNIT_ASSERT_MESSAGE(description, TrackerTestRun(setup, frames, 1, svlSyncSignals, results));
+
+        // the lower scales track on their own half resolution grid and
+        // the full resolution only refines the scaled up positions within
+        // a search radius of 2, which leaves a rounding error of a pixel
+        const int tolerance = (setup.Scales > 1) ? 1 : 0;
+
+        // only the inner targets stay away from the borders in every frame
+        int dx = 0, dy = 0;
+        for (int frame = 0; frame < TrackerTestFrameCount; ++frame) {
+            dx += TrackerTestShifts[frame][0];
+            dy += TrackerTestShifts[frame][1];
+            for (int target = 4; target < TrackerTestTargetCount; ++target) {
+                const svlTarget2D & result = results[frame * TrackerTestTargetCount + target];
+                std::stringstream message;
+                message << description << ", frame " << frame << ", target " << target << ": ("
+                        << result.pos.x << ", " << result.pos.y << ") instead of ("
+                        << TrackerTestTargets[target][0] + dx << ", " << TrackerTestTargets[target][1] + dy << ")";
+                CPPUNIT_ASSERT_MESSAGE(message.str(), result.visible);
+                CPPUNIT_ASSERT_MESSAGE(message.str(),
+                                       std::abs(result.pos.x - (TrackerTestTargets[target][0] + dx)) <= tolerance &&
+                                       std::abs(result.pos.y - (TrackerTestTargets[target][1] + dy)) <= tolerance);
+            }
+        }
+    }
+}
+
+
+void svlTrackerMSBruteForceTest::TestSIMD(void)
+{
+    const int supported = svlImageProcessing::GetSupportedSIMDLevel();
+    std::vector<svlSampleImageRGB> frames;
+    std::vector<svlTarget2D> reference, results;
+    // with noise the match scores and confidences are not trivial
+    TrackerTestSequence(frames, 6);
+
+    for (size_t index = 0; index < TrackerTestSetupCount; ++index) {
+        const TrackerTestSetup & setup = TrackerTestSetups[index];
+        const std::string description = TrackerTestDescription(setup);
+
+        svlImageProcessing::SetSIMDLevel(svlImageProcessing::SIMD_None);
+        CPPUNIT_ASSERT_MESSAGE(description, TrackerTestRun(setup, frames, 1, svlSyncSignals, reference));
+
+        for (int level = svlImageProcessing::SIMD_SSE2; level <= supported; ++level) {
+            svlImageProcessing::SetSIMDLevel(static_cast<svlImageProcessing::SIMD_Level>(level));
+            CPPUNIT_ASSERT_MESSAGE(description, TrackerTestRun(setup, frames, 1, svlSyncSignals, results));
+            const size_t differences = TrackerTestDifferences(reference, results);
+            std::stringstream message;
+            message << description << " (" << TrackerTestLevelNames[level] << "): " << differences
+                    << " targets differ from the scalar reference";
+            CPPUNIT_ASSERT_MESSAGE(message.str(), differences == 0);
+        }
+    }
+}
+
+
+void svlTrackerMSBruteForceTest::TestThreads(void)
+{
+    // the tracker has work buffers for 128 threads, the others only
+    // take part in the synchronization
+    const unsigned int threadCounts[] = { 2, 3, 130 };
+    const svlSyncType syncTypes[] = { svlSyncSignals, svlSyncSpin };
+    std::vector<svlSampleImageRGB> frames;
+    std::vector<svlTarget2D> reference, results;
+    TrackerTestSequence(frames, 6);
+
+    for (size_t index = 0; index < TrackerTestSetupCount; ++index) {
+        const TrackerTestSetup & setup = TrackerTestSetups[index];
+        const std::string description = TrackerTestDescription(setup);
+
+        CPPUNIT_ASSERT_MESSAGE(description, TrackerTestRun(setup, frames, 1, svlSyncSignals, reference));
+
+        for (size_t count = 0; count < sizeof(threadCounts) / sizeof(threadCounts[0]); ++count) {
+            for (size_t sync = 0; sync < 2; ++sync) {
+                // spinning 130 threads on few processors takes too long
+                if (threadCounts[count] > 8 && syncTypes[sync] == svlSyncSpin) {
+                    continue;
+                }
+                std::stringstream message;
+                message << description << ", " << threadCounts[count] << " threads, "
+                        << (syncTypes[sync] == svlSyncSpin ? "spin" : "signals") << " barrier";
+                CPPUNIT_ASSERT_MESSAGE(message.str(),
+                                       TrackerTestRun(setup, frames, threadCounts[count], syncTypes[sync], results));
+                const size_t differences = TrackerTestDifferences(reference, results);
+                message << ": " << differences << " targets differ from a single thread";
+                CPPUNIT_ASSERT_MESSAGE(message.str(), differences == 0);
+            }
+        }
+    }
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(svlTrackerMSBruteForceTest);
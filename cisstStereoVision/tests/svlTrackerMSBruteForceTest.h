@@ -0,0 +1,61 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstStereoVision/svlImageProcessing.h>
+
+/*! Track a synthetic texture moved by known shifts with
+  svlTrackerMSBruteForce, and compare the tracking results of the
+  vectorized template matching and of several processing threads with
+  the ones of a single thread and the scalar code
+  (svlImageProcessing::SIMD_None). */
+class svlTrackerMSBruteForceTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(svlTrackerMSBruteForceTest);
+    {
+        CPPUNIT_TEST(TestShift);
+        CPPUNIT_TEST(TestSIMD);
+        CPPUNIT_TEST(TestThreads);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+    svlImageProcessing::SIMD_Level Level;
+
+public:
+    void setUp(void) {
+        Level = svlImageProcessing::GetSIMDLevel();
+    }
+
+    void tearDown(void) {
+        svlImageProcessing::SetSIMDLevel(Level);
+    }
+
+    /*! Test that the targets follow a known shift with SAD, SSD, NCC
+      and FastNCC, exactly on one scale and within a pixel on two */
+    void TestShift(void);
+
+    /*! Test that every SIMD level tracks exactly like the scalar code */
+    void TestSIMD(void);
+
+    /*! Test that several threads, including more threads than the
+      tracker has work buffers for, track exactly like a single one */
+    void TestThreads(void);
+};
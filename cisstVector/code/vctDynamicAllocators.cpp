@@ -0,0 +1,219 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicAllocators.h>
+#include <cisstCommon/cmnAssert.h>
+
+#include <stdlib.h>
+
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+#define VCT_DYNAMIC_ARENA_THREAD_LOCAL 1
+#endif
+
+
+/* The block is allocated with malloc with ALIGNMENT extra bytes and the
+   address returned by malloc is stored just before the aligned block.
+   This is as fast as malloc while posix_memalign and the aligned new
+   are several times slower for small blocks. */
+void * vctDynamicAlignedAllocator::AllocateMemory(size_t numberOfBytes)
+{
+    char * memory = static_cast<char *>(malloc(numberOfBytes + ALIGNMENT));
+    if (memory == 0) {
+        throw std::bad_alloc();
+    }
+    char * aligned = reinterpret_cast<char *>((reinterpret_cast<size_t>(memory) + ALIGNMENT)
+                                              & ~static_cast<size_t>(ALIGNMENT - 1));
+    *(reinterpret_cast<char **>(aligned) - 1) = memory;
+    return aligned;
+}
+
+
+void vctDynamicAlignedAllocator::DeallocateMemory(void * memory)
+{
+    free(*(static_cast<char **>(memory) - 1));
+}
+
+
+/* Each block allocated by the arena is preceded by ALIGNMENT bytes, the
+   last ones holding the size of the block and the address of the chunk
+   the block comes from, or 0 for blocks too large for a chunk which are
+   allocated on the heap.  The header of a chunk uses the first
+   ALIGNMENT bytes of the chunk.  Freeing the last block of a chunk
+   gives its memory back to the chunk, so scratch containers destroyed
+   in reverse order of creation don't use more memory. */
+namespace {
+
+    class vctDynamicArena;
+
+    struct vctDynamicArenaChunk {
+        vctDynamicArenaChunk * Next;
+        char * Top;
+        char * End;
+        size_t NumberOfBlocks;
+        vctDynamicArena * Arena;  // null once the thread exited
+
+        inline char * Begin(void) {
+            return reinterpret_cast<char *>(this) + vctDynamicArenaAllocator::ALIGNMENT;
+        }
+    };
+
+    struct vctDynamicArenaBlockHeader {
+        size_t PaddedSize;
+        vctDynamicArenaChunk * Chunk;
+    };
+
+    inline vctDynamicArenaBlockHeader & HeaderOf(void * memory) {
+        return *(reinterpret_cast<vctDynamicArenaBlockHeader *>(memory) - 1);
+    }
+
+    inline size_t PaddedSize(size_t numberOfBytes) {
+        const size_t alignment = vctDynamicArenaAllocator::ALIGNMENT;
+        return ((numberOfBytes + alignment - 1) / alignment) * alignment + alignment;
+    }
+
+    void * AllocateLargeBlock(size_t numberOfBytes) {
+        char * memory = static_cast<char *>(vctDynamicAlignedAllocator::AllocateMemory(PaddedSize(numberOfBytes)))
+            + vctDynamicArenaAllocator::ALIGNMENT;
+        HeaderOf(memory).Chunk = 0;
+        return memory;
+    }
+
+    void DeallocateLargeBlock(void * memory) {
+        vctDynamicAlignedAllocator::DeallocateMemory(static_cast<char *>(memory)
+                                                     - vctDynamicArenaAllocator::ALIGNMENT);
+    }
+
+    class vctDynamicArena {
+    public:
+        vctDynamicArena(void):
+            Chunks(0),
+            Current(0)
+        {}
+
+        /* Chunks still used by some blocks are orphaned, the last block
+           freed releases the chunk. */
+        ~vctDynamicArena() {
+            vctDynamicArenaChunk * chunk = Chunks;
+            while (chunk) {
+                vctDynamicArenaChunk * next = chunk->Next;
+                if (chunk->NumberOfBlocks == 0) {
+                    vctDynamicAlignedAllocator::DeallocateMemory(chunk);
+                } else {
+                    chunk->Arena = 0;
+                }
+                chunk = next;
+            }
+        }
+
+        void * Allocate(size_t numberOfBytes) {
+            const size_t paddedSize = PaddedSize(numberOfBytes);
+            if (paddedSize > (vctDynamicArenaAllocator::CHUNK_SIZE / 4)) {
+                return AllocateLargeBlock(numberOfBytes);
+            }
+            if ((Current == 0) || (Current->Top + paddedSize > Current->End)) {
+                Current = FindEmptyChunk();
+            }
+            char * memory = Current->Top + vctDynamicArenaAllocator::ALIGNMENT;
+            Current->Top += paddedSize;
+            Current->NumberOfBlocks++;
+            HeaderOf(memory).PaddedSize = paddedSize;
+            HeaderOf(memory).Chunk = Current;
+            return memory;
+        }
+
+        size_t NumberOfChunks(void) const {
+            size_t result = 0;
+            for (const vctDynamicArenaChunk * chunk = Chunks; chunk; chunk = chunk->Next) {
+                ++result;
+            }
+            return result;
+        }
+
+    protected:
+        /* Empty chunks are reset when their last block is freed. */
+        vctDynamicArenaChunk * FindEmptyChunk(void) {
+            for (vctDynamicArenaChunk * chunk = Chunks; chunk; chunk = chunk->Next) {
+                if (chunk->NumberOfBlocks == 0) {
+                    return chunk;
+                }
+            }
+            vctDynamicArenaChunk * chunk =
+                static_cast<vctDynamicArenaChunk *>(vctDynamicAlignedAllocator::AllocateMemory(vctDynamicArenaAllocator::CHUNK_SIZE));
+            chunk->Next = Chunks;
+            chunk->Top = chunk->Begin();
+            chunk->End = reinterpret_cast<char *>(chunk) + vctDynamicArenaAllocator::CHUNK_SIZE;
+            chunk->NumberOfBlocks = 0;
+            chunk->Arena = this;
+            Chunks = chunk;
+            return chunk;
+        }
+
+        vctDynamicArenaChunk * Chunks;
+        vctDynamicArenaChunk * Current;
+    };
+
+#if VCT_DYNAMIC_ARENA_THREAD_LOCAL
+    thread_local vctDynamicArena ThreadArena;
+#endif
+
+} // namespace
+
+
+void * vctDynamicArenaAllocator::AllocateMemory(size_t numberOfBytes)
+{
+#if VCT_DYNAMIC_ARENA_THREAD_LOCAL
+    return ThreadArena.Allocate(numberOfBytes);
+#else
+    return AllocateLargeBlock(numberOfBytes);
+#endif
+}
+
+
+void vctDynamicArenaAllocator::DeallocateMemory(void * memory)
+{
+    const vctDynamicArenaBlockHeader & header = HeaderOf(memory);
+    vctDynamicArenaChunk * chunk = header.Chunk;
+    if (chunk == 0) {
+        DeallocateLargeBlock(memory);
+        return;
+    }
+#if VCT_DYNAMIC_ARENA_THREAD_LOCAL
+    CMN_ASSERT((chunk->Arena == 0) || (chunk->Arena == &ThreadArena));
+#endif
+    chunk->NumberOfBlocks--;
+    if (chunk->NumberOfBlocks == 0) {
+        if (chunk->Arena == 0) {
+            vctDynamicAlignedAllocator::DeallocateMemory(chunk);
+        } else {
+            chunk->Top = chunk->Begin();
+        }
+    } else if (static_cast<char *>(memory) - ALIGNMENT + header.PaddedSize == chunk->Top) {
+        chunk->Top -= header.PaddedSize;
+    }
+}
+
+
+size_t vctDynamicArenaAllocator::NumberOfChunks(void)
+{
+#if VCT_DYNAMIC_ARENA_THREAD_LOCAL
+    return ThreadArena.NumberOfChunks();
+#else
+    return 0;
+#endif
+}
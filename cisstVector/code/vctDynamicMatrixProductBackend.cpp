@@ -0,0 +1,42 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicMatrixProductBackend.h>
+
+vctDynamicMatrixProductBackend::DoubleFunctionType vctDynamicMatrixProductBackend::DoubleFunctionMember = 0;
+size_t vctDynamicMatrixProductBackend::MinimumSizeMember = 0;
+
+
+void vctDynamicMatrixProductBackend::SetDoubleFunction(DoubleFunctionType function, size_t minimumSize)
+{
+    DoubleFunctionMember = function;
+    MinimumSizeMember = minimumSize;
+}
+
+
+vctDynamicMatrixProductBackend::DoubleFunctionType vctDynamicMatrixProductBackend::DoubleFunction(void)
+{
+    return DoubleFunctionMember;
+}
+
+
+size_t vctDynamicMatrixProductBackend::MinimumSize(void)
+{
+    return MinimumSizeMember;
+}
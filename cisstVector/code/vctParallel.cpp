@@ -0,0 +1,47 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctParallel.h>
+
+vctParallel::ExecutorFunctionType vctParallel::DefaultExecutorFunctionMember = 0;
+void * vctParallel::DefaultExecutorMember = 0;
+
+
+vctParallel::vctParallel(void):
+    ExecutorFunctionMember(DefaultExecutorFunctionMember),
+    ExecutorMember(DefaultExecutorMember),
+    MinimumSizeMember(DEFAULT_MINIMUM_SIZE)
+{
+}
+
+
+vctParallel::vctParallel(ExecutorFunctionType executorFunction, void * executor,
+                         size_type minimumSize):
+    ExecutorFunctionMember(executorFunction),
+    ExecutorMember(executor),
+    MinimumSizeMember(minimumSize)
+{
+}
+
+
+void vctParallel::SetDefaultExecutor(ExecutorFunctionType executorFunction, void * executor)
+{
+    DefaultExecutorFunctionMember = executorFunction;
+    DefaultExecutorMember = executor;
+}
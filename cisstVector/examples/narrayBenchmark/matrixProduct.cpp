@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicMatrix.h>
+#include <cisstVector/vctRandom.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstCommon/cmnPrintf.h>
+#include <iostream>
+
+/* This program compares the generic matrix product engine (one dot
+   product per output element) to ProductOf, which uses the blocked
+   engine for large compact matrices, for all the storage orders of
+   the inputs.  The output is always row major. */
+
+typedef double value_type;
+typedef vctDynamicMatrix<value_type> MatrixType;
+
+const size_t sizes[] = {16, 32, 64, 128, 256, 512, 1024};
+const size_t numberOfSizes = sizeof(sizes) / sizeof(size_t);
+
+/* time per product in seconds, repeating small products to get at
+   least a tenth of a second */
+template <class _engineType>
+double TimeProduct(MatrixType & output, const MatrixType & input1, const MatrixType & input2)
+{
+    osaStopwatch timer;
+    size_t iterations = 0;
+    timer.Reset();
+    timer.Start();
+    do {
+        _engineType::Run(output, input1, input2);
+        iterations++;
+    } while (timer.GetElapsedTime() < 0.1);
+    timer.Stop();
+    return timer.GetElapsedTime() / iterations;
+}
+
+class GenericEngine {
+public:
+    static void Run(MatrixType & output, const MatrixType & input1, const MatrixType & input2) {
+        vctDynamicMatrixLoopEngines::
+            Product<vctBinaryOperations<value_type, MatrixType::ConstRowRefType, MatrixType::ConstColumnRefType>::DotProduct>::
+            Run(output, input1, input2);
+    }
+};
+
+class ProductOfMethod {
+public:
+    static void Run(MatrixType & output, const MatrixType & input1, const MatrixType & input2) {
+        output.ProductOf(input1, input2);
+    }
+};
+
+
+int main(void)
+{
+    std::cout << "Matrix product, square matrices of doubles, time per product in ms" << std::endl
+              << cmnPrintf("%6s%8s%14s%14s%10s%12s\n")
+              << "size" << "inputs" << "generic" << "ProductOf" << "speedup" << "difference";
+
+    const bool orders[4][2] = {{VCT_ROW_MAJOR, VCT_ROW_MAJOR},
+                               {VCT_ROW_MAJOR, VCT_COL_MAJOR},
+                               {VCT_COL_MAJOR, VCT_ROW_MAJOR},
+                               {VCT_COL_MAJOR, VCT_COL_MAJOR}};
+    const char * orderNames[4] = {"RR", "RC", "CR", "CC"};
+
+    for (size_t sizeIndex = 0; sizeIndex < numberOfSizes; sizeIndex++) {
+        const size_t size = sizes[sizeIndex];
+        for (size_t order = 0; order < 4; order++) {
+            MatrixType input1(size, size, orders[order][0]);
+            MatrixType input2(size, size, orders[order][1]);
+            MatrixType outputGeneric(size, size);
+            MatrixType outputProductOf(size, size);
+            vctRandom(input1, value_type(-1), value_type(1));
+            vctRandom(input2, value_type(-1), value_type(1));
+
+            const double timeGeneric = TimeProduct<GenericEngine>(outputGeneric, input1, input2);
+            const double timeProductOf = TimeProduct<ProductOfMethod>(outputProductOf, input1, input2);
+            outputGeneric.Subtract(outputProductOf);
+
+            std::cout << cmnPrintf("%6d%8s%14.4f%14.4f%10.1f%12.1e\n")
+                      << size << orderNames[order]
+                      << timeGeneric * 1000.0 << timeProductOf * 1000.0
+                      << timeGeneric / timeProductOf
+                      << outputGeneric.MaxAbsElement();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstVector/vctDynamicNArray.h>
+#include <cisstVector/vctDynamicNArrayRef.h>
+#include <cisstVector/vctDynamicMatrix.h>
+#include <cisstVector/vctParallel.h>
+#include <cisstVector/vctRandom.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstOSAbstraction/osaThreadPool.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+#include <cisstCommon/cmnPrintf.h>
+#include <iostream>
+#include <cstdlib>
+
+/* This program measures the scaling of the parallel nArray and matrix
+   operations (see vctParallel) from 1 thread to the number of
+   processors, or to the number of threads given as first argument.
+   The volume is the same as in ImageAdd_nArray_Benchmark, i.e. a
+   72^4 window in a 80^4 volume, and a compact 160^3 volume.  The
+   reductions must be identical for all numbers of threads. */
+
+typedef float value_type;
+typedef vctDynamicNArray<value_type, 4> VolumeType;
+typedef vctDynamicNArray<value_type, 3> CompactVolumeType;
+typedef vctDynamicMatrix<value_type> MatrixType;
+
+/* time per call in seconds, repeating the operation to get at least a
+   tenth of a second */
+template <class _operationType>
+double TimeOperation(_operationType & operation, const vctParallel & parallel)
+{
+    osaStopwatch timer;
+    size_t iterations = 0;
+    timer.Reset();
+    timer.Start();
+    do {
+        operation.Run(parallel);
+        iterations++;
+    } while (timer.GetElapsedTime() < 0.1);
+    timer.Stop();
+    return timer.GetElapsedTime() / iterations;
+}
+
+class WindowSumOf {
+public:
+    VolumeType::SubarrayRefType Window1, Window2;
+    VolumeType Sum;
+    inline void Run(const vctParallel & parallel) {
+        Sum.SumOf(parallel, Window1, Window2);
+    }
+};
+
+class VolumeAddScalar {
+public:
+    CompactVolumeType Volume;
+    inline void Run(const vctParallel & parallel) {
+        Volume.Add(parallel, value_type(1));
+    }
+};
+
+class VolumeNormSquare {
+public:
+    CompactVolumeType Volume;
+    value_type Result;
+    inline void Run(const vctParallel & parallel) {
+        Result = Volume.NormSquare(parallel);
+    }
+};
+
+class MatrixElementwiseProductOf {
+public:
+    MatrixType Matrix1, Matrix2, Product;
+    inline void Run(const vctParallel & parallel) {
+        Product.ElementwiseProductOf(parallel, Matrix1, Matrix2);
+    }
+};
+
+class MatrixSumOfElements {
+public:
+    MatrixType Matrix;
+    value_type Result;
+    inline void Run(const vctParallel & parallel) {
+        Result = Matrix.SumOfElements(parallel);
+    }
+};
+
+
+int main(int argc, char * argv[])
+{
+    size_t maximumNumberOfThreads = static_cast<size_t>(osaCPUGetCount());
+    if (argc > 1) {
+        maximumNumberOfThreads = static_cast<size_t>(atoi(argv[1]));
+    }
+    if (maximumNumberOfThreads < 1) {
+        maximumNumberOfThreads = 1;
+    }
+
+    VolumeType parent1(VolumeType::nsize_type(80));
+    VolumeType parent2(parent1.sizes());
+    vctRandom(parent1, value_type(-20), value_type(20));
+    vctRandom(parent2, value_type(-20), value_type(20));
+    WindowSumOf windowSumOf;
+    windowSumOf.Window1.SubarrayOf(parent1, VolumeType::nsize_type(2), VolumeType::nsize_type(72));
+    windowSumOf.Window2.SubarrayOf(parent2, VolumeType::nsize_type(2), VolumeType::nsize_type(72));
+    windowSumOf.Sum.SetSize(VolumeType::nsize_type(72));
+
+    VolumeAddScalar volumeAddScalar;
+    volumeAddScalar.Volume.SetSize(CompactVolumeType::nsize_type(160));
+    vctRandom(volumeAddScalar.Volume, value_type(-1), value_type(1));
+
+    VolumeNormSquare volumeNormSquare;
+    volumeNormSquare.Volume.SetSize(CompactVolumeType::nsize_type(160));
+    vctRandom(volumeNormSquare.Volume, value_type(-1), value_type(1));
+
+    MatrixElementwiseProductOf matrixProductOf;
+    matrixProductOf.Matrix1.SetSize(2048, 2048);
+    matrixProductOf.Matrix2.SetSize(2048, 2048, VCT_COL_MAJOR);
+    matrixProductOf.Product.SetSize(2048, 2048);
+    vctRandom(matrixProductOf.Matrix1, value_type(-1), value_type(1));
+    vctRandom(matrixProductOf.Matrix2, value_type(-1), value_type(1));
+
+    MatrixSumOfElements matrixSumOfElements;
+    matrixSumOfElements.Matrix.SetSize(2048, 2048);
+    vctRandom(matrixSumOfElements.Matrix, value_type(-1), value_type(1));
+
+    std::cout << "Time per operation in ms, speedup relative to 1 thread" << std::endl
+              << cmnPrintf("%8s%18s%18s%18s%18s%18s\n")
+              << "threads" << "window SumOf" << "volume Add" << "volume NormSq"
+              << "matrix ElwProd" << "matrix SumOfElm";
+
+    double reference[5];
+    value_type referenceNormSquare = 0, referenceSumOfElements = 0;
+    bool deterministic = true;
+    for (size_t numberOfThreads = 1; numberOfThreads <= maximumNumberOfThreads; numberOfThreads++) {
+        osaThreadPool pool(numberOfThreads);
+        const vctParallel parallel(pool);
+        double times[5];
+        times[0] = TimeOperation(windowSumOf, parallel);
+        times[1] = TimeOperation(volumeAddScalar, parallel);
+        times[2] = TimeOperation(volumeNormSquare, parallel);
+        times[3] = TimeOperation(matrixProductOf, parallel);
+        times[4] = TimeOperation(matrixSumOfElements, parallel);
+        if (numberOfThreads == 1) {
+            for (size_t index = 0; index < 5; index++) {
+                reference[index] = times[index];
+            }
+            referenceNormSquare = volumeNormSquare.Result;
+            referenceSumOfElements = matrixSumOfElements.Result;
+        } else if ((volumeNormSquare.Result != referenceNormSquare)
+                   || (matrixSumOfElements.Result != referenceSumOfElements)) {
+            deterministic = false;
+        }
+        std::cout << cmnPrintf("%8d") << numberOfThreads;
+        for (size_t index = 0; index < 5; index++) {
+            std::cout << cmnPrintf("%10.3f (%4.1f)") << times[index] * 1000.0 << reference[index] / times[index];
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Reductions identical for all numbers of threads: "
+              << (deterministic ? "yes" : "NO") << std::endl;
+    return deterministic ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include "vctDynamicAllocatorsTest.h"
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicMatrix.h>
+#include <cisstVector/vctDynamicVectorTypes.h>
+#include <cisstVector/vctDynamicMatrixTypes.h>
+
+
+namespace {
+    typedef vctDynamicVector<double, vctDynamicInlineAllocator<> > InlineVectorType;
+    typedef vctDynamicMatrix<double, vctDynamicInlineAllocator<> > InlineMatrixType;
+
+    bool IsAligned(const void * pointer) {
+        return (reinterpret_cast<size_t>(pointer) % vctDynamicAlignedAllocator::ALIGNMENT) == 0;
+    }
+
+    // counts the elements alive
+    class vctDynamicAllocatorsTestElement {
+    public:
+        static int NumberAlive;
+        vctDynamicAllocatorsTestElement(void):
+            Constructed(true)
+        {
+            NumberAlive++;
+        }
+        vctDynamicAllocatorsTestElement(const vctDynamicAllocatorsTestElement & CMN_UNUSED(other)):
+            Constructed(true)
+        {
+            NumberAlive++;
+        }
+        ~vctDynamicAllocatorsTestElement() {
+            Constructed = false;
+            NumberAlive--;
+        }
+        bool Constructed;
+        int Value[3];
+    };
+
+    int vctDynamicAllocatorsTestElement::NumberAlive = 0;
+
+    vctReturnDynamicVector<double> MakeVector(size_t size) {
+        vctDoubleVec result(size);
+        for (size_t index = 0; index < size; ++index) {
+            result[index] = static_cast<double>(index);
+        }
+        return vctReturnDynamicVector<double>(result);
+    }
+
+    vctReturnDynamicMatrix<double> MakeMatrix(size_t rows, size_t cols, bool storageOrder) {
+        vctDoubleMat result(rows, cols, storageOrder);
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t col = 0; col < cols; ++col) {
+                result.Element(row, col) = static_cast<double>(row * cols + col);
+            }
+        }
+        return vctReturnDynamicMatrix<double>(result);
+    }
+}
+
+
+void vctDynamicAllocatorsTest::TestInlineBuffer(void)
+{
+    // only the inline policy uses a buffer, the other owners don't grow
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(vctDynamicVectorOwner<double>::INLINE_SIZE));
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(vctDynamicVectorOwner<double, vctDynamicArenaAllocator>::INLINE_SIZE));
+    CPPUNIT_ASSERT_EQUAL(sizeof(vctDynamicVectorOwner<double, vctDynamicNewAllocator>),
+                         sizeof(vctDynamicVectorOwner<double>));
+    CPPUNIT_ASSERT_EQUAL(sizeof(vctDynamicMatrixOwner<double, vctDynamicNewAllocator>),
+                         sizeof(vctDynamicMatrixOwner<double>));
+    CPPUNIT_ASSERT_EQUAL(16, static_cast<int>(InlineVectorType::OwnerType::INLINE_SIZE));
+    CPPUNIT_ASSERT_EQUAL(32, static_cast<int>(vctDynamicVectorOwner<float, vctDynamicInlineAllocator<> >::INLINE_SIZE));
+    CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(vctDynamicVectorOwner<double, vctDynamicInlineAllocator<32> >::INLINE_SIZE));
+
+    vctDoubleVec heapVector(7);
+    CPPUNIT_ASSERT(!heapVector.Owner().IsInline());
+
+    InlineVectorType vector;
+    CPPUNIT_ASSERT(vector.Pointer() == 0);
+    CPPUNIT_ASSERT(!vector.Owner().IsInline());
+    vector.SetSize(7);
+    CPPUNIT_ASSERT(vector.Owner().IsInline());
+    CPPUNIT_ASSERT(IsAligned(vector.Pointer()));
+    vector.SetSize(16);
+    CPPUNIT_ASSERT(vector.Owner().IsInline());
+    vector.SetSize(17);
+    CPPUNIT_ASSERT(!vector.Owner().IsInline());
+    CPPUNIT_ASSERT(IsAligned(vector.Pointer()));
+    vector.SetSize(3);
+    CPPUNIT_ASSERT(vector.Owner().IsInline());
+    vector.SetSize(0);
+    CPPUNIT_ASSERT(vector.Pointer() == 0);
+
+    InlineMatrixType matrix(4, 4);
+    CPPUNIT_ASSERT(matrix.Owner().IsInline());
+    CPPUNIT_ASSERT(IsAligned(matrix.Pointer()));
+    matrix.SetSize(4, 4, VCT_COL_MAJOR);
+    CPPUNIT_ASSERT(matrix.Owner().IsInline());
+    CPPUNIT_ASSERT(matrix.IsColMajor());
+    matrix.SetSize(6, 7);
+    CPPUNIT_ASSERT(!matrix.Owner().IsInline());
+    matrix.SetSize(2, 3);
+    CPPUNIT_ASSERT(matrix.Owner().IsInline());
+
+    // the inline buffer is aligned even if the owner is not
+    size_t index;
+    for (index = 0; index < 8; ++index) {
+        InlineVectorType * allocated = new InlineVectorType(7, 1.0);
+        CPPUNIT_ASSERT(allocated->Owner().IsInline());
+        CPPUNIT_ASSERT(IsAligned(allocated->Pointer()));
+        CPPUNIT_ASSERT(allocated->Equal(1.0));
+        delete allocated;
+    }
+
+    // copies don't share the inline buffer
+    InlineVectorType vector1(6, 1.0);
+    InlineVectorType vector2(vector1);
+    CPPUNIT_ASSERT(vector1.Pointer() != vector2.Pointer());
+    vector2.SetAll(2.0);
+    CPPUNIT_ASSERT(vector1.Equal(1.0));
+}
+
+
+void vctDynamicAllocatorsTest::TestAlignment(void)
+{
+    size_t size;
+    for (size = 1; size < 1000; size += 37) {
+        vctDoubleVec vector(size);
+        CPPUNIT_ASSERT(IsAligned(vector.Pointer()));
+        vctDynamicVector<char> bytes(size * 8 + 1);
+        CPPUNIT_ASSERT(IsAligned(bytes.Pointer()));
+        vctDoubleMat matrix(size, 3);
+        CPPUNIT_ASSERT(IsAligned(matrix.Pointer()));
+        vctDynamicVector<double, vctDynamicArenaAllocator> scratch(size);
+        CPPUNIT_ASSERT(IsAligned(scratch.Pointer()));
+        InlineVectorType small(size);
+        CPPUNIT_ASSERT(IsAligned(small.Pointer()));
+    }
+    // large blocks bypass the arena chunks
+    vctDynamicVector<double, vctDynamicArenaAllocator> scratch(vctDynamicArenaAllocator::CHUNK_SIZE);
+    CPPUNIT_ASSERT(IsAligned(scratch.Pointer()));
+    scratch.SetAll(1.0);
+    CPPUNIT_ASSERT(scratch.Equal(1.0));
+}
+
+
+void vctDynamicAllocatorsTest::TestReturnAndResize(void)
+{
+    size_t size, index;
+    for (size = 0; size < 40; size += 3) {
+        vctDoubleVec vector;
+        vector = MakeVector(size);
+        CPPUNIT_ASSERT_EQUAL(size, vector.size());
+        for (index = 0; index < size; ++index) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), vector[index]);
+        }
+        vctDoubleVec copy(MakeVector(size));
+        CPPUNIT_ASSERT(copy.Equal(vector));
+
+        // allocated data is transfered, not copied
+        vctDoubleVec original(size, 1.0);
+        const double * pointer = original.Pointer();
+        vctReturnDynamicVector<double> transfered(original);
+        CPPUNIT_ASSERT_EQUAL(size, transfered.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), original.size());
+        CPPUNIT_ASSERT(transfered.Pointer() == pointer);
+
+        // different allocation policies copy
+        vctDynamicVector<double, vctDynamicArenaAllocator> scratch(MakeVector(size));
+        CPPUNIT_ASSERT(scratch.Equal(vector));
+        InlineVectorType small;
+        small = MakeVector(size);
+        CPPUNIT_ASSERT(small.Equal(vector));
+
+        // resize preserves the elements between inline and allocated data
+        small.resize(size + 10);
+        for (index = 0; index < size; ++index) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), small[index]);
+        }
+        small.resize(size / 2);
+        for (index = 0; index < size / 2; ++index) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), small[index]);
+        }
+        vector.resize(size + 10);
+        for (index = 0; index < size; ++index) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), vector[index]);
+        }
+    }
+
+    size_t rows, cols, row, col;
+    for (rows = 1; rows < 9; rows += 3) {
+        for (cols = 1; cols < 9; cols += 2) {
+            vctDoubleMat rowMajor(MakeMatrix(rows, cols, VCT_ROW_MAJOR));
+            vctDoubleMat colMajor;
+            colMajor = MakeMatrix(rows, cols, VCT_COL_MAJOR);
+            CPPUNIT_ASSERT(rowMajor.IsRowMajor());
+            CPPUNIT_ASSERT(colMajor.IsColMajor());
+            CPPUNIT_ASSERT(rowMajor.Equal(colMajor));
+            for (row = 0; row < rows; ++row) {
+                for (col = 0; col < cols; ++col) {
+                    CPPUNIT_ASSERT_EQUAL(static_cast<double>(row * cols + col), colMajor.Element(row, col));
+                }
+            }
+            vctDynamicMatrix<double, vctDynamicArenaAllocator> scratch(MakeMatrix(rows, cols, VCT_COL_MAJOR));
+            CPPUNIT_ASSERT(scratch.IsColMajor());
+            CPPUNIT_ASSERT(scratch.Equal(rowMajor));
+
+            InlineMatrixType small(MakeMatrix(rows, cols, VCT_COL_MAJOR));
+            CPPUNIT_ASSERT(small.IsColMajor());
+            CPPUNIT_ASSERT(small.Equal(rowMajor));
+            small.resize(rows + 3, cols + 2);
+            CPPUNIT_ASSERT(small.IsColMajor());
+            for (row = 0; row < rows; ++row) {
+                for (col = 0; col < cols; ++col) {
+                    CPPUNIT_ASSERT_EQUAL(static_cast<double>(row * cols + col), small.Element(row, col));
+                }
+            }
+        }
+    }
+}
+
+
+void vctDynamicAllocatorsTest::TestArena(void)
+{
+    vctDynamicVector<double, vctDynamicArenaAllocator> first(100, 1.0);
+    const size_t numberOfChunks = vctDynamicArenaAllocator::NumberOfChunks();
+    CPPUNIT_ASSERT(numberOfChunks >= 1);
+    size_t iteration;
+    for (iteration = 0; iteration < 1000; ++iteration) {
+        vctDynamicVector<double, vctDynamicArenaAllocator> vector(100 + iteration % 50, 2.0);
+        vctDynamicMatrix<double, vctDynamicArenaAllocator> matrix(40, 40, 3.0);
+        vector.Add(1.0);
+        CPPUNIT_ASSERT(vector.Equal(3.0));
+        CPPUNIT_ASSERT(matrix.Equal(3.0));
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfChunks, vctDynamicArenaAllocator::NumberOfChunks());
+    CPPUNIT_ASSERT(first.Equal(1.0));
+}
+
+
+void vctDynamicAllocatorsTest::TestReleaseAndOwn(void)
+{
+    // with new[], the block is transfered
+    vctDynamicVectorOwner<double, vctDynamicNewAllocator> newOwner(3);
+    double * pointer = newOwner.Pointer();
+    newOwner.Pointer()[2] = 5.0;
+    double * data = newOwner.Release();
+    CPPUNIT_ASSERT(data == pointer);
+    CPPUNIT_ASSERT_EQUAL(5.0, data[2]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), newOwner.size());
+    CPPUNIT_ASSERT(newOwner.Own(3, data) == 0);
+    CPPUNIT_ASSERT(newOwner.Pointer() == data);
+
+    // other policies copy to and from blocks allocated with new[]
+    vctDynamicVectorOwner<double> alignedOwner(20);
+    alignedOwner.Pointer()[19] = 5.0;
+    data = alignedOwner.Release();
+    CPPUNIT_ASSERT_EQUAL(5.0, data[19]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), alignedOwner.size());
+    CPPUNIT_ASSERT(alignedOwner.Own(20, data) == 0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(20), alignedOwner.size());
+    CPPUNIT_ASSERT(IsAligned(alignedOwner.Pointer()));
+    CPPUNIT_ASSERT_EQUAL(5.0, alignedOwner.Pointer()[19]);
+    data = alignedOwner.Own(0, 0);
+    CPPUNIT_ASSERT_EQUAL(5.0, data[19]);
+    delete[] data;
+
+    vctDynamicVectorOwner<double, vctDynamicInlineAllocator<> > inlineOwner(3);
+    CPPUNIT_ASSERT(inlineOwner.IsInline());
+    inlineOwner.Pointer()[2] = 5.0;
+    data = inlineOwner.Release();
+    CPPUNIT_ASSERT_EQUAL(5.0, data[2]);
+    delete[] data;
+
+    vctDynamicMatrixOwner<double> matrixOwner(4, 5, VCT_COL_MAJOR);
+    matrixOwner.Pointer()[19] = 5.0;
+    data = matrixOwner.Release();
+    CPPUNIT_ASSERT_EQUAL(5.0, data[19]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), matrixOwner.size());
+    CPPUNIT_ASSERT(matrixOwner.Own(4, 5, VCT_COL_MAJOR, data) == 0);
+    CPPUNIT_ASSERT(matrixOwner.IsColMajor());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), matrixOwner.rows());
+    CPPUNIT_ASSERT_EQUAL(5.0, matrixOwner.Pointer()[19]);
+}
+
+
+void vctDynamicAllocatorsTest::TestElementsLifetime(void)
+{
+    typedef vctDynamicAllocatorsTestElement ElementType;
+    CPPUNIT_ASSERT_EQUAL(0, ElementType::NumberAlive);
+    {
+        // only the elements in use are constructed in the inline buffer
+        vctDynamicVectorOwner<ElementType, vctDynamicInlineAllocator<> > owner;
+        CPPUNIT_ASSERT(owner.INLINE_SIZE > 2);
+        CPPUNIT_ASSERT_EQUAL(0, ElementType::NumberAlive);
+        owner.SetSize(100);
+        CPPUNIT_ASSERT_EQUAL(100, ElementType::NumberAlive);
+        owner.SetSize(2);
+        CPPUNIT_ASSERT(owner.IsInline());
+        CPPUNIT_ASSERT_EQUAL(2, ElementType::NumberAlive);
+        CPPUNIT_ASSERT(owner.Pointer()[1].Constructed);
+        owner.SetSize(1);
+        CPPUNIT_ASSERT_EQUAL(1, ElementType::NumberAlive);
+        owner.SetSize(50);
+        CPPUNIT_ASSERT_EQUAL(50, ElementType::NumberAlive);
+
+        vctDynamicMatrixOwner<ElementType, vctDynamicArenaAllocator> matrixOwner(10, 10);
+        CPPUNIT_ASSERT_EQUAL(150, ElementType::NumberAlive);
+        matrixOwner.Disown();
+        CPPUNIT_ASSERT_EQUAL(50, ElementType::NumberAlive);
+
+        vctDynamicMatrixOwner<ElementType, vctDynamicInlineAllocator<> > smallMatrixOwner(1, 2);
+        CPPUNIT_ASSERT(smallMatrixOwner.IsInline());
+        CPPUNIT_ASSERT_EQUAL(52, ElementType::NumberAlive);
+
+        vctDynamicVectorOwner<ElementType, vctDynamicNewAllocator> newOwner(20);
+        CPPUNIT_ASSERT_EQUAL(72, ElementType::NumberAlive);
+    }
+    CPPUNIT_ASSERT_EQUAL(0, ElementType::NumberAlive);
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(vctDynamicAllocatorsTest);
@@ -0,0 +1,73 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#ifndef _vctDynamicAllocatorsTest_h
+#define _vctDynamicAllocatorsTest_h
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class vctDynamicAllocatorsTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(vctDynamicAllocatorsTest);
+    {
+        CPPUNIT_TEST(TestInlineBuffer);
+        CPPUNIT_TEST(TestAlignment);
+        CPPUNIT_TEST(TestReturnAndResize);
+        CPPUNIT_TEST(TestArena);
+        CPPUNIT_TEST(TestReleaseAndOwn);
+        CPPUNIT_TEST(TestElementsLifetime);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Test that small vectors and matrices use the inline buffer of
+      vctDynamicInlineAllocator and larger ones don't, including when
+      resized */
+    void TestInlineBuffer(void);
+
+    /*! Test that the allocated blocks are aligned on 64 bytes */
+    void TestAlignment(void);
+
+    /*! Test the transfer of data with vctReturnDynamicVector and
+      vctReturnDynamicMatrix and the non-destructive resize, for
+      inline and allocated data */
+    void TestReturnAndResize(void);
+
+    /*! Test that the arena recycles its chunks */
+    void TestArena(void);
+
+    /*! Test that Release and Own use blocks allocated with new[] for
+      all the allocation policies */
+    void TestReleaseAndOwn(void);
+
+    /*! Test that all the elements constructed are destroyed and that
+      the inline buffer only holds the elements in use */
+    void TestElementsLifetime(void);
+};
+
+
+#endif // _vctDynamicAllocatorsTest_h
@@ -26,6 +26,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctDynamicMatrix.h>
 #include <cisstVector/vctDynamicConstMatrixRef.h>
+#include <cisstVector/vctDynamicExpression.h>
 #include <cisstVector/vctRandomDynamicVector.h>
 #include <cisstVector/vctRandomDynamicMatrix.h>
 #include <cisstVector/vctRandomFixedSizeMatrix.h>
@@ -512,6 +513,218 @@ void vctDynamicMatrixTest::TestProductOperationsInt(void) {
 }
 
 
+template <class _elementType>
+void vctDynamicMatrixTest::TestLargeProductOperations(void) {
+    // sizes not multiple of the register blocks, common size larger
+    // than the cache blocks
+    enum {ROWS = 37, COLS = 43, COMSIZE = 300};
+    typedef _elementType value_type;
+    const bool orders[2] = {VCT_ROW_MAJOR, VCT_COL_MAJOR};
+    unsigned int order1, order2, order3;
+    for (order1 = 0; order1 < 2; order1++) {
+        for (order2 = 0; order2 < 2; order2++) {
+            for (order3 = 0; order3 < 2; order3++) {
+                vctDynamicMatrix<value_type> matrix1(ROWS, COMSIZE, orders[order1]);
+                vctDynamicMatrix<value_type> matrix2(COMSIZE, COLS, orders[order2]);
+                vctDynamicMatrix<value_type> matrix3(ROWS, COLS, orders[order3]);
+                vctRandom(matrix1, value_type(-1), value_type(1));
+                vctRandom(matrix2, value_type(-1), value_type(1));
+                vctGenericMatrixTest::TestMatrixMatrixProductOperations(matrix1, matrix2, matrix3);
+            }
+        }
+    }
+
+    // non compact operands use the generic engine
+    vctDynamicMatrix<value_type> parent1(ROWS + 2, COMSIZE + 2);
+    vctDynamicMatrix<value_type> parent2(COMSIZE + 2, COLS + 2);
+    vctDynamicMatrix<value_type> matrix3(ROWS, COLS);
+    vctRandom(parent1, value_type(-1), value_type(1));
+    vctRandom(parent2, value_type(-1), value_type(1));
+    vctDynamicMatrixRef<value_type> matrix1(parent1, 1, 1, ROWS, COMSIZE);
+    vctDynamicMatrixRef<value_type> matrix2(parent2, 1, 1, COMSIZE, COLS);
+    vctGenericMatrixTest::TestMatrixMatrixProductOperations(matrix1, matrix2, matrix3);
+}
+
+void vctDynamicMatrixTest::TestLargeProductOperationsDouble(void) {
+    TestLargeProductOperations<double>();
+}
+void vctDynamicMatrixTest::TestLargeProductOperationsFloat(void) {
+    TestLargeProductOperations<float>();
+}
+void vctDynamicMatrixTest::TestLargeProductOperationsInt(void) {
+    TestLargeProductOperations<int>();
+}
+
+
+
+template <class _elementType>
+void vctDynamicMatrixTest::TestExpressions(void) {
+    enum {ROWS = 7, COLS = 9};
+    typedef _elementType value_type;
+    typedef vctDynamicMatrix<value_type> MatrixType;
+    const value_type scalar = value_type(3);
+    const bool orders[2] = {VCT_ROW_MAJOR, VCT_COL_MAJOR};
+    unsigned int order1, order2, order3;
+    // same storage orders use the compact engine, others don't
+    for (order1 = 0; order1 < 2; order1++) {
+        for (order2 = 0; order2 < 2; order2++) {
+            for (order3 = 0; order3 < 2; order3++) {
+                MatrixType matrix1(ROWS, COLS, orders[order1]);
+                MatrixType matrix2(ROWS, COLS, orders[order2]);
+                MatrixType result(ROWS, COLS, orders[order3]);
+                MatrixType expected;
+                vctRandom(matrix1, value_type(-10), value_type(10));
+                vctRandom(matrix2, value_type(-10), value_type(10));
+
+                expected = matrix1 + matrix2 * scalar - matrix1 / scalar;
+                result = vctLazy(matrix1) + vctLazy(matrix2) * scalar - vctLazy(matrix1) / scalar;
+                CPPUNIT_ASSERT_EQUAL(orders[order3], result.StorageOrder());
+                CPPUNIT_ASSERT(expected.AlmostEqual(result));
+
+                expected = scalar - matrix1 - matrix2;
+                MatrixType constructed((scalar - vctLazy(matrix1)) - matrix2);
+                CPPUNIT_ASSERT_EQUAL(orders[order1], constructed.StorageOrder());
+                CPPUNIT_ASSERT(expected.AlmostEqual(constructed));
+
+                expected = -matrix1 + matrix2;
+                result = matrix2 + (-vctLazy(matrix1));
+                CPPUNIT_ASSERT(expected.AlmostEqual(result));
+
+                // store back operations, result used as an operand
+                expected = result + (matrix1 - matrix2 * scalar);
+                result += vctLazy(matrix1) - vctLazy(matrix2) * scalar;
+                CPPUNIT_ASSERT(expected.AlmostEqual(result));
+                expected.Subtract(matrix1 + scalar);
+                result -= vctLazy(matrix1) + scalar;
+                CPPUNIT_ASSERT(expected.AlmostEqual(result));
+                expected = result + matrix1;
+                result = vctLazy(result) + vctLazy(matrix1);
+                CPPUNIT_ASSERT(expected.AlmostEqual(result));
+            }
+        }
+    }
+
+    // non compact operands and result
+    MatrixType parent1(ROWS + 2, COLS + 2), parentResult(ROWS + 2, COLS + 2);
+    MatrixType matrix2(COLS, ROWS), expected;
+    vctRandom(parent1, value_type(-10), value_type(10));
+    vctRandom(matrix2, value_type(-10), value_type(10));
+    vctDynamicConstMatrixRef<value_type> ref1(parent1, 1, 1, ROWS, COLS);
+    vctDynamicMatrixRef<value_type> refResult(parentResult, 1, 1, ROWS, COLS);
+    expected = ref1 * scalar - matrix2.Transpose();
+    refResult = vctLazy(ref1) * scalar - vctLazy(matrix2.Transpose());
+    CPPUNIT_ASSERT(expected.AlmostEqual(refResult));
+
+    // size mismatch, between operands and with the result
+    MatrixType smaller(ROWS, COLS - 1);
+    bool exceptionReceived = false;
+    try {
+        expected = vctLazy(ref1) + vctLazy(smaller);
+    } catch (std::runtime_error) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+    exceptionReceived = false;
+    try {
+        smaller.Assign(vctLazy(ref1) * scalar);
+    } catch (std::runtime_error) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+}
+
+void vctDynamicMatrixTest::TestExpressionsDouble(void) {
+    TestExpressions<double>();
+}
+void vctDynamicMatrixTest::TestExpressionsFloat(void) {
+    TestExpressions<float>();
+}
+void vctDynamicMatrixTest::TestExpressionsInt(void) {
+    TestExpressions<int>();
+}
+
+
+
+/* executor running the tasks in reverse order, the results must be
+   the same as with the tasks run in order */
+static void vctDynamicMatrixTestReverseExecutor(void * CMN_UNUSED(executor),
+                                                vctParallel::TaskFunctionType task, void * taskData,
+                                                vctParallel::size_type numberOfTasks)
+{
+    for (vctParallel::size_type index = numberOfTasks; index > 0; --index) {
+        task(taskData, index - 1);
+    }
+}
+
+template <class _elementType>
+void vctDynamicMatrixTest::TestParallel(void) {
+    enum {ROWS = 17, COLS = 11};
+    typedef _elementType value_type;
+    typedef vctDynamicMatrix<value_type> MatrixType;
+    // small minimum size so that the matrices are split
+    const vctParallel sequential(0, 0, 100);
+    const vctParallel reverse(vctDynamicMatrixTestReverseExecutor, 0, 100);
+    const value_type scalar = value_type(3);
+    const bool orders[2] = {VCT_ROW_MAJOR, VCT_COL_MAJOR};
+    unsigned int order1, order2;
+    // the output storage order selects chunks of rows or columns
+    for (order1 = 0; order1 < 2; order1++) {
+        for (order2 = 0; order2 < 2; order2++) {
+            MatrixType matrix1(ROWS, COLS, orders[order1]);
+            MatrixType matrix2(ROWS, COLS, orders[order2]);
+            MatrixType expected(ROWS, COLS, orders[order1]);
+            MatrixType result(ROWS, COLS, orders[order1]);
+            vctRandom(matrix1, value_type(-10), value_type(10));
+            vctRandom(matrix2, value_type(1), value_type(10));
+
+            // elementwise operations are exact
+            expected.DifferenceOf(matrix1, matrix2);
+            result.DifferenceOf(reverse, matrix1, matrix2);
+            CPPUNIT_ASSERT(expected.Equal(result));
+            expected.ElementwiseProductOf(matrix1, matrix2);
+            result.ElementwiseProductOf(reverse, matrix1, matrix2);
+            CPPUNIT_ASSERT(expected.Equal(result));
+            expected.ElementwiseDivide(matrix2);
+            result.ElementwiseDivide(reverse, matrix2);
+            CPPUNIT_ASSERT(expected.Equal(result));
+            expected.Add(scalar);
+            result.Add(reverse, scalar);
+            CPPUNIT_ASSERT(expected.Equal(result));
+
+            // reductions don't depend on the order of the tasks
+            CPPUNIT_ASSERT_EQUAL(matrix2.SumOfElements(sequential), matrix2.SumOfElements(reverse));
+            CPPUNIT_ASSERT_EQUAL(matrix2.NormSquare(sequential), matrix2.NormSquare(reverse));
+            CPPUNIT_ASSERT_EQUAL(matrix1.MaxAbsElement(), matrix1.MaxAbsElement(reverse));
+            // the serial engines add the elements in a different order
+            const double tolerance = 1e-5 * matrix1.L1Norm();
+            VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(matrix1.L1Norm(), matrix1.L1Norm(reverse), tolerance);
+            VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(matrix1.SumOfElements(), matrix1.SumOfElements(reverse), tolerance);
+
+            // sizes are checked before running any task
+            MatrixType smaller(ROWS, COLS - 1, orders[order2]);
+            CPPUNIT_ASSERT_THROW(result.SumOf(reverse, matrix1, smaller), std::runtime_error);
+            CPPUNIT_ASSERT_THROW(result.Subtract(reverse, smaller), std::runtime_error);
+        }
+    }
+
+    // below the minimum size, same as the serial engines
+    MatrixType matrix(ROWS, COLS);
+    vctRandom(matrix, value_type(-10), value_type(10));
+    const vctParallel defaultParallel;
+    CPPUNIT_ASSERT_EQUAL(matrix.SumOfElements(), matrix.SumOfElements(defaultParallel));
+}
+
+void vctDynamicMatrixTest::TestParallelDouble(void) {
+    TestParallel<double>();
+}
+void vctDynamicMatrixTest::TestParallelFloat(void) {
+    TestParallel<float>();
+}
+void vctDynamicMatrixTest::TestParallelInt(void) {
+    TestParallel<int>();
+}
+
+
 
 template <class _elementType>
 void vctDynamicMatrixTest::TestMoMiOperations(void) {
@@ -79,6 +79,18 @@ class vctDynamicMatrixTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestProductOperationsFloat);
     CPPUNIT_TEST(TestProductOperationsInt);
 
+    CPPUNIT_TEST(TestLargeProductOperationsDouble);
+    CPPUNIT_TEST(TestLargeProductOperationsFloat);
+    CPPUNIT_TEST(TestLargeProductOperationsInt);
+
+    CPPUNIT_TEST(TestExpressionsDouble);
+    CPPUNIT_TEST(TestExpressionsFloat);
+    CPPUNIT_TEST(TestExpressionsInt);
+
+    CPPUNIT_TEST(TestParallelDouble);
+    CPPUNIT_TEST(TestParallelFloat);
+    CPPUNIT_TEST(TestParallelInt);
+
     CPPUNIT_TEST(TestMoMiOperationsDouble);
     CPPUNIT_TEST(TestMoMiOperationsFloat);
     CPPUNIT_TEST(TestMoMiOperationsInt);
@@ -220,6 +232,27 @@ class vctDynamicMatrixTest : public CppUnit::TestFixture
     void TestProductOperationsFloat(void);
     void TestProductOperationsInt(void);
 
+    /*! Test Product operations large enough to use the blocked engine */
+    template<class _elementType>
+        void TestLargeProductOperations(void);
+    void TestLargeProductOperationsDouble(void);
+    void TestLargeProductOperationsFloat(void);
+    void TestLargeProductOperationsInt(void);
+
+    /*! Test lazy expressions */
+    template<class _elementType>
+        void TestExpressions(void);
+    void TestExpressionsDouble(void);
+    void TestExpressionsFloat(void);
+    void TestExpressionsInt(void);
+
+    /*! Test the parallel engines */
+    template<class _elementType>
+        void TestParallel(void);
+    void TestParallelDouble(void);
+    void TestParallelFloat(void);
+    void TestParallelInt(void);
+
     /*! Test MoMi operations */
     template<class _elementType>
         void TestMoMiOperations(void);
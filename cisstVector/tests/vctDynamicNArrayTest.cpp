@@ -646,5 +646,93 @@ void vctDynamicNArrayTest::TestFastCopyOfInt(void) {
 }
 
 
+
+/* executor running the tasks in reverse order, the results must be
+   the same as with the tasks run in order */
+static void vctDynamicNArrayTestReverseExecutor(void * CMN_UNUSED(executor),
+                                                vctParallel::TaskFunctionType task, void * taskData,
+                                                vctParallel::size_type numberOfTasks)
+{
+    for (vctParallel::size_type index = numberOfTasks; index > 0; --index) {
+        task(taskData, index - 1);
+    }
+}
+
+template <class _elementType>
+void vctDynamicNArrayTest::TestParallel(void) {
+    enum {DIMENSION = 3};
+    typedef _elementType value_type;
+    typedef vctDynamicNArray<value_type, DIMENSION> ArrayType;
+    typedef vctDynamicNArrayRef<value_type, DIMENSION> ArrayRefType;
+    typedef typename ArrayType::nsize_type nsize_type;
+    typedef typename ArrayRefType::ndimension_type ndimension_type;
+
+    // small minimum size so that the nArrays are split
+    const vctParallel sequential(0, 0, 100);
+    const vctParallel reverse(vctDynamicNArrayTestReverseExecutor, 0, 100);
+    const value_type scalar = value_type(3);
+
+    ArrayType nArray1(nsize_type(13, 5, 7));
+    ArrayType nArray2(nArray1.sizes());
+    ArrayType expected(nArray1.sizes());
+    ArrayType result(nArray1.sizes());
+    vctRandom(nArray1, value_type(-10), value_type(10));
+    vctRandom(nArray2, value_type(1), value_type(10));
+
+    // elementwise operations are exact
+    expected.SumOf(nArray1, nArray2);
+    result.SumOf(reverse, nArray1, nArray2);
+    CPPUNIT_ASSERT(expected.Equal(result));
+    expected.ElementwiseRatioOf(nArray1, nArray2);
+    result.ElementwiseRatioOf(reverse, nArray1, nArray2);
+    CPPUNIT_ASSERT(expected.Equal(result));
+    expected.Subtract(nArray1);
+    result.Subtract(reverse, nArray1);
+    CPPUNIT_ASSERT(expected.Equal(result));
+    expected.Multiply(scalar);
+    result.Multiply(reverse, scalar);
+    CPPUNIT_ASSERT(expected.Equal(result));
+
+    // non compact nArray, the first dimension is not the outermost in memory
+    ArrayRefType permuted;
+    permuted.PermutationOf(nArray1, ndimension_type(2, 0, 1));
+    ArrayType permutedExpected(permuted.sizes());
+    ArrayType permutedResult(permuted.sizes());
+    permutedExpected.DifferenceOf(permuted, permuted);
+    permutedResult.SumOf(reverse, permuted, permuted);
+    permutedResult.Subtract(reverse, permuted);
+    permutedResult.Subtract(reverse, permuted);
+    CPPUNIT_ASSERT(permutedExpected.Equal(permutedResult));
+
+    // reductions don't depend on the order of the tasks
+    CPPUNIT_ASSERT_EQUAL(nArray1.SumOfElements(sequential), nArray1.SumOfElements(reverse));
+    CPPUNIT_ASSERT_EQUAL(permuted.NormSquare(sequential), permuted.NormSquare(reverse));
+    CPPUNIT_ASSERT_EQUAL(nArray1.MaxAbsElement(), nArray1.MaxAbsElement(reverse));
+    // the serial engines add the elements in a different order
+    const double tolerance = 1e-5 * nArray1.L1Norm();
+    VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(nArray1.L1Norm(), nArray1.L1Norm(reverse), tolerance);
+    VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(nArray1.SumOfElements(), nArray1.SumOfElements(reverse), tolerance);
+
+    // below the minimum size, same as the serial engines
+    const vctParallel defaultParallel;
+    CPPUNIT_ASSERT_EQUAL(nArray1.NormSquare(), nArray1.NormSquare(defaultParallel));
+
+    // sizes are checked before running any task
+    ArrayType smaller(nsize_type(12, 5, 7));
+    CPPUNIT_ASSERT_THROW(result.SumOf(reverse, nArray1, smaller), std::runtime_error);
+    CPPUNIT_ASSERT_THROW(result.Add(reverse, smaller), std::runtime_error);
+}
+
+void vctDynamicNArrayTest::TestParallelDouble(void) {
+    TestParallel<double>();
+}
+void vctDynamicNArrayTest::TestParallelFloat(void) {
+    TestParallel<float>();
+}
+void vctDynamicNArrayTest::TestParallelInt(void) {
+    TestParallel<int>();
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(vctDynamicNArrayTest);
 
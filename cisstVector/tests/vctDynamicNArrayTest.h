@@ -107,6 +107,10 @@ class vctDynamicNArrayTest: public CppUnit::TestFixture
     CPPUNIT_TEST(TestFastCopyOfFloat);
     CPPUNIT_TEST(TestFastCopyOfInt);
 
+    CPPUNIT_TEST(TestParallelDouble);
+    CPPUNIT_TEST(TestParallelFloat);
+    CPPUNIT_TEST(TestParallelInt);
+
     CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -259,6 +263,13 @@ class vctDynamicNArrayTest: public CppUnit::TestFixture
     void TestFastCopyOfFloat(void);
     void TestFastCopyOfInt(void);
 
+    /*! Test the parallel engines */
+    template<class _elementType>
+        void TestParallel(void);
+    void TestParallelDouble(void);
+    void TestParallelFloat(void);
+    void TestParallelInt(void);
+
 };
 
 
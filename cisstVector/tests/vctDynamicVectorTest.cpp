@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstVector/vctDynamicVectorRef.h>
 #include <cisstVector/vctDynamicConstVectorRef.h>
+#include <cisstVector/vctDynamicExpression.h>
 #include <cisstVector/vctRandomFixedSizeVector.h>
 #include <cisstVector/vctRandomDynamicVector.h>
 
@@ -858,5 +859,98 @@ void vctDynamicVectorTest::TestNormalizationFloat(void) {
     TestNormalization<float>();
 }
 
+
+
+template <class _elementType>
+void vctDynamicVectorTest::TestExpressions(void) {
+    enum {SIZE = 17};
+    typedef _elementType value_type;
+    typedef vctDynamicVector<value_type> VectorType;
+    VectorType vector1(SIZE), vector2(SIZE), vector3(SIZE);
+    vctRandom(vector1, value_type(-10), value_type(10));
+    vctRandom(vector2, value_type(-10), value_type(10));
+    vctRandom(vector3, value_type(-10), value_type(10));
+    const value_type scalar = value_type(3);
+
+    // compare to the eager operators, operations are performed in the same order
+    VectorType expected, result;
+    expected = vector1 + vector2 * scalar - vector3;
+    result = vctLazy(vector1) + vctLazy(vector2) * scalar - vctLazy(vector3);
+    CPPUNIT_ASSERT_EQUAL(vector1.size(), result.size());
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+
+    expected = -vector1 + scalar * vector2 - vector3 / scalar;
+    VectorType constructed(-vctLazy(vector1) + scalar * vctLazy(vector2) - vctLazy(vector3) / scalar);
+    CPPUNIT_ASSERT(expected.AlmostEqual(constructed));
+
+    // mixed expressions and containers, scalar first
+    expected = (scalar - vector1) + vector2;
+    result = (scalar - vctLazy(vector1)) + vector2;
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+    expected = vector3 - (vector1 + scalar);
+    result = vector3 - (vctLazy(vector1) + scalar);
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+
+    // store back operations
+    expected = vector1;
+    expected += vector2 * scalar;
+    result = vector1;
+    result += vctLazy(vector2) * scalar;
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+    expected -= vector3 - vector2;
+    result -= vctLazy(vector3) - vctLazy(vector2);
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+
+    // result used as an operand
+    expected = vector1 + vector2;
+    result = vector1;
+    result = vctLazy(result) + vctLazy(vector2);
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+
+    // non compact operands and result
+    VectorType data1(2 * SIZE), data2(3 * SIZE), dataResult(2 * SIZE);
+    vctRandom(data1, value_type(-10), value_type(10));
+    vctRandom(data2, value_type(-10), value_type(10));
+    vctDynamicVectorRef<value_type> ref1(SIZE, data1.Pointer(), 2);
+    vctDynamicConstVectorRef<value_type> ref2(SIZE, data2.Pointer(), 3);
+    vctDynamicVectorRef<value_type> refResult(SIZE, dataResult.Pointer() + 1, 2);
+    expected = ref1 * scalar - ref2 + vector3;
+    refResult = vctLazy(ref1) * scalar - vctLazy(ref2) + vctLazy(vector3);
+    CPPUNIT_ASSERT(expected.AlmostEqual(refResult));
+    result = vctLazy(ref1) * scalar - vctLazy(ref2) + vctLazy(vector3);
+    CPPUNIT_ASSERT(expected.AlmostEqual(result));
+    expected.Assign(vector1 + vector3);
+    vctDynamicVectorRef<value_type> compactRef(vector1);
+    refResult.Assign(vctLazy(compactRef) + vctLazy(vector3));
+    CPPUNIT_ASSERT(expected.AlmostEqual(refResult));
+
+    // size mismatch, between operands and with the result
+    VectorType shorter(SIZE - 1);
+    bool exceptionReceived = false;
+    try {
+        result = vctLazy(vector1) + vctLazy(shorter);
+    } catch (std::runtime_error) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+    exceptionReceived = false;
+    try {
+        shorter.Assign(vctLazy(vector1) + vctLazy(vector2));
+    } catch (std::runtime_error) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+}
+
+void vctDynamicVectorTest::TestExpressionsDouble(void) {
+    TestExpressions<double>();
+}
+void vctDynamicVectorTest::TestExpressionsFloat(void) {
+    TestExpressions<float>();
+}
+void vctDynamicVectorTest::TestExpressionsInt(void) {
+    TestExpressions<int>();
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(vctDynamicVectorTest);
 
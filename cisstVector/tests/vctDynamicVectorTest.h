@@ -130,6 +130,10 @@ class vctDynamicVectorTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestNormalizationDouble);
     CPPUNIT_TEST(TestNormalizationFloat);
 
+    CPPUNIT_TEST(TestExpressionsDouble);
+    CPPUNIT_TEST(TestExpressionsFloat);
+    CPPUNIT_TEST(TestExpressionsInt);
+
     CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -329,6 +333,12 @@ class vctDynamicVectorTest : public CppUnit::TestFixture
     void TestNormalizationDouble(void);
     void TestNormalizationFloat(void);
 
+    /*! Test lazy expressions */
+    template<class _elementType>
+        void TestExpressions(void);
+    void TestExpressionsDouble(void);
+    void TestExpressionsFloat(void);
+    void TestExpressionsInt(void);
 };
 
 
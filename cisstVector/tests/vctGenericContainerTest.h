@@ -105,7 +105,8 @@ class vctGenericContainerTest
             goal += (*iter1);
         }
         CPPUNIT_ASSERT(!cmnTypeTraits<value_type>::IsNaN(resultScalar));
-        VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(goal, resultScalar, tolerance);
+        // the compact engines can add the elements in a different order (SIMD)
+        VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(goal, resultScalar, tolerance * container1.size());
 
         container2.Zeros();
         VCT_CPPUNIT_ASSERT_DOUBLES_EQUAL_CAST(value_type(0), container2.SumOfElements(), tolerance);
@@ -130,7 +131,7 @@ class vctGenericContainerTest
             goal += abs;
         }
         CPPUNIT_ASSERT(!cmnTypeTraits<value_type>::IsNaN(resultScalar));
-        CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(goal), static_cast<double>(resultScalar), static_cast<double>(tolerance));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(goal), static_cast<double>(resultScalar), static_cast<double>(tolerance * goal));
 
         container2 = value_type(0);
         CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(0), container2.L1Norm(), tolerance);
@@ -0,0 +1,292 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicAllocators_h
+#define _vctDynamicAllocators_h
+
+/*!
+  \file
+  \brief Declaration of the allocators used by the dynamic vector and matrix owners
+*/
+
+#include <cisstCommon/cmnPortability.h>
+
+#include <new>
+#include <cstddef>
+
+// Always include last
+#include <cisstVector/vctExport.h>
+
+/*!
+  \brief Allocation policies of vctDynamicVectorOwner and vctDynamicMatrixOwner
+
+  An allocation policy is a class with:
+
+  - an enum INLINE_BYTES, the size in bytes of the buffer stored in
+    the owner itself.  Containers whose elements fit in this buffer
+    don't allocate any memory.  The number of elements stored inline
+    is INLINE_BYTES / sizeof(element), e.g. 16 doubles or 32 floats
+    for 128 bytes.  Only vctDynamicInlineAllocator uses a buffer, the
+    other policies use 0 so the owners don't grow.
+
+  - an enum NEW_ARRAY, 1 if the blocks are allocated with new[] and
+    can be freed with delete[].  The owners use it to hand over their
+    block in Release() without copy.
+
+  - a static method template Allocate<_elementType>(size) returning a
+    block of size elements, all default constructed.
+
+  - a static method template Deallocate<_elementType>(data, size)
+    destroying the elements and freeing a block returned by Allocate.
+
+  The policies provided are vctDynamicAlignedAllocator (default),
+  vctDynamicArenaAllocator, vctDynamicInlineAllocator and
+  vctDynamicNewAllocator.  The policy is the last template parameter
+  of the owners and containers, e.g.:
+  \code
+  vctDynamicVector<double, vctDynamicArenaAllocator> scratch(200);
+  vctDynamicVector<double, vctDynamicInlineAllocator<> > joints(7);
+  \endcode
+
+  This base class provides the construction and destruction of the
+  elements for policies allocating raw memory.
+*/
+class vctDynamicAllocatorBase {
+public:
+    /*! Default construct size elements in the raw memory block
+      allocated for them.  If a constructor throws an exception, the
+      elements already constructed are destroyed, the block is freed
+      with deallocateMemory (if not null) and the exception is
+      forwarded. */
+    template <class _elementType>
+    inline static _elementType * Construct(void * memory, size_t size,
+                                           void (*deallocateMemory)(void *)) {
+        _elementType * data = static_cast<_elementType *>(memory);
+        size_t index = 0;
+        try {
+            for (; index < size; ++index) {
+                new (data + index) _elementType;
+            }
+        } catch (...) {
+            Destroy(data, index);
+            if (deallocateMemory) {
+                deallocateMemory(memory);
+            }
+            throw;
+        }
+        return data;
+    }
+
+    /*! Destroy size elements, in reverse order of construction. */
+    template <class _elementType>
+    inline static void Destroy(_elementType * data, size_t size) {
+        while (size > 0) {
+            --size;
+            data[size].~_elementType();
+        }
+    }
+};
+
+
+/*!
+  \brief Default allocation policy, aligned blocks
+
+  Blocks are allocated on the heap and aligned on 64 bytes, i.e. on a
+  cache line and on the largest SIMD register (see
+  vctDynamicCompactLoopEnginesSIMD).
+*/
+class CISST_EXPORT vctDynamicAlignedAllocator: public vctDynamicAllocatorBase {
+public:
+    enum {INLINE_BYTES = 0};
+    enum {NEW_ARRAY = 0};
+    enum {ALIGNMENT = 64};
+
+    /*! Allocate a raw block of memory aligned on ALIGNMENT bytes.
+      Throws std::bad_alloc if the memory can't be allocated. */
+    static void * AllocateMemory(size_t numberOfBytes);
+
+    /*! Free a block returned by AllocateMemory. */
+    static void DeallocateMemory(void * memory);
+
+    template <class _elementType>
+    inline static _elementType * Allocate(size_t size) {
+        return Construct<_elementType>(AllocateMemory(size * sizeof(_elementType)), size,
+                                       &DeallocateMemory);
+    }
+
+    template <class _elementType>
+    inline static void Deallocate(_elementType * data, size_t size) {
+        Destroy(data, size);
+        DeallocateMemory(data);
+    }
+};
+
+
+/*!
+  \brief Allocation policy for scratch computations, thread local arena
+
+  Same alignment as vctDynamicAlignedAllocator, but the blocks are
+  carved out of large chunks owned by the calling thread.  A chunk is
+  recycled as soon as all the blocks allocated from it are freed, so
+  temporaries created and destroyed in a loop don't reach the heap
+  after the first iteration.  Blocks larger than a quarter of a chunk
+  are allocated on the heap.
+
+  The arena is not protected by any lock, memory allocated by a
+  thread must be freed by the same thread or after the thread exited.
+  This policy is meant for temporary containers local to a
+  computation.  If the compiler doesn't support thread local objects
+  (C++ 11), all blocks are allocated on the heap.
+*/
+class CISST_EXPORT vctDynamicArenaAllocator: public vctDynamicAllocatorBase {
+public:
+    enum {INLINE_BYTES = 0};
+    enum {NEW_ARRAY = 0};
+    enum {ALIGNMENT = vctDynamicAlignedAllocator::ALIGNMENT};
+    enum {CHUNK_SIZE = 256 * 1024};
+
+    /*! Allocate a raw block of memory aligned on ALIGNMENT bytes from
+      the arena of the calling thread. */
+    static void * AllocateMemory(size_t numberOfBytes);
+
+    /*! Free a block returned by AllocateMemory. */
+    static void DeallocateMemory(void * memory);
+
+    /*! Number of chunks owned by the arena of the calling thread. */
+    static size_t NumberOfChunks(void);
+
+    template <class _elementType>
+    inline static _elementType * Allocate(size_t size) {
+        return Construct<_elementType>(AllocateMemory(size * sizeof(_elementType)), size,
+                                       &DeallocateMemory);
+    }
+
+    template <class _elementType>
+    inline static void Deallocate(_elementType * data, size_t size) {
+        Destroy(data, size);
+        DeallocateMemory(data);
+    }
+};
+
+
+/*!
+  \brief Allocation policy using new[] and delete[]
+
+  This was the only allocation scheme before the allocation policies
+  were introduced.  Blocks are not aligned beyond the alignment of the
+  elements but Release() and Own() (see vctDynamicVectorOwner) don't
+  need to copy the elements.
+*/
+class vctDynamicNewAllocator {
+public:
+    enum {INLINE_BYTES = 0};
+    enum {NEW_ARRAY = 1};
+
+    template <class _elementType>
+    inline static _elementType * Allocate(size_t size) {
+        return new _elementType[size];
+    }
+
+    template <class _elementType>
+    inline static void Deallocate(_elementType * data, size_t CMN_UNUSED(size)) {
+        delete[] data;
+    }
+};
+
+
+/*!
+  \brief Allocation policy with a small buffer stored in the owner
+
+  Up to _inlineBytes bytes of elements are stored in the owner itself,
+  so a 6 or 7 joints vector or a 4 by 4 matrix of doubles never
+  allocates memory with the default 128 bytes.  The buffer is aligned
+  on vctDynamicAlignedAllocator::ALIGNMENT bytes.  Larger blocks are
+  allocated by _allocatorType.
+
+  The owners using this policy are about _inlineBytes + ALIGNMENT
+  bytes larger (see vctDynamicInlineBuffer) and transfering inline data
+  between owners (e.g. vctReturnDynamicVector) copies the elements
+  instead of a pointer, so this policy is meant for small containers
+  created often, e.g. joint vectors in a control loop:
+  \code
+  vctDynamicVector<double, vctDynamicInlineAllocator<> > joints(7);
+  \endcode
+*/
+template <size_t _inlineBytes = 128, class _allocatorType = vctDynamicAlignedAllocator>
+class vctDynamicInlineAllocator: public vctDynamicAllocatorBase {
+public:
+    enum {INLINE_BYTES = _inlineBytes};
+    enum {NEW_ARRAY = _allocatorType::NEW_ARRAY};
+
+    template <class _elementType>
+    inline static _elementType * Allocate(size_t size) {
+        return _allocatorType::template Allocate<_elementType>(size);
+    }
+
+    template <class _elementType>
+    inline static void Deallocate(_elementType * data, size_t size) {
+        _allocatorType::template Deallocate<_elementType>(data, size);
+    }
+};
+
+
+/*!
+  \brief Raw storage for the inline buffer of the dynamic owners
+
+  _bytes bytes of uninitialized memory aligned on
+  vctDynamicAlignedAllocator::ALIGNMENT, the owners construct and
+  destroy the elements in place.  The alignment is computed at
+  runtime so it doesn't depend on the alignment of the owner itself,
+  e.g. for an owner allocated with new.  The specialization for 0
+  bytes is empty so the owners using a policy without inline buffer
+  don't grow (empty base optimization).
+*/
+template <size_t _bytes>
+class vctDynamicInlineBuffer {
+public:
+    enum {ALIGNMENT = vctDynamicAlignedAllocator::ALIGNMENT};
+
+    inline void * InlineMemory(void) {
+        return reinterpret_cast<void *>((reinterpret_cast<size_t>(Storage) + ALIGNMENT - 1)
+                                        & ~static_cast<size_t>(ALIGNMENT - 1));
+    }
+
+    inline const void * InlineMemory(void) const {
+        return const_cast<vctDynamicInlineBuffer *>(this)->InlineMemory();
+    }
+
+private:
+    unsigned char Storage[_bytes + ALIGNMENT - 1];
+};
+
+#ifndef DOXYGEN
+template <>
+class vctDynamicInlineBuffer<0> {
+public:
+    inline void * InlineMemory(void) {
+        return 0;
+    }
+    inline const void * InlineMemory(void) const {
+        return 0;
+    }
+};
+#endif // DOXYGEN
+
+#endif // _vctDynamicAllocators_h
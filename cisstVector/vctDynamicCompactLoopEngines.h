@@ -29,6 +29,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnThrow.h>
+#include <cisstVector/vctDynamicCompactLoopEnginesSIMD.h>
 
 /*!  \brief Container class for the loop based engines for compact
   containers.
@@ -44,6 +45,11 @@ http://www.cisst.org/cisst/license.txt.
   "one", the operator "++" can be used which in some compilation mode
   can provide a slight speed boost.
 
+  For the most common operations on double, float and int elements,
+  the engines first process as many elements as possible using SIMD
+  instructions (see vctDynamicCompactLoopEnginesSIMD) and then use
+  their scalar loop for the remaining elements.
+
   \note These engines don't perform any layout check as this is done
   by the other engines.
 
@@ -94,7 +100,10 @@ class vctDynamicCompactLoopEngines {
             Input1PointerType input1Pointer = input1Owner.Pointer();
             Input2PointerType input2Pointer = input2Owner.Pointer();
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::CoCiCi<_elementOperationType>::
+                Run(outputPointer, input1Pointer, input2Pointer, size);
+
+            for (outputPointer += simdSize, input1Pointer += simdSize, input2Pointer += simdSize;
                  outputPointer != outputEnd;
                  outputPointer++, input1Pointer++, input2Pointer++) {
                 *outputPointer = _elementOperationType::Operate(*input1Pointer, *input2Pointer);
@@ -135,7 +144,10 @@ class vctDynamicCompactLoopEngines {
 
             InputPointerType inputPointer = inputOwner.Pointer();
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::CioCi<_elementOperationType>::
+                Run(inputOutputPointer, inputPointer, size);
+
+            for (inputOutputPointer += simdSize, inputPointer += simdSize;
                  inputOutputPointer != inputOutputEnd;
                  inputOutputPointer++, inputPointer++) {
                 *inputOutputPointer = _elementOperationType::Operate(*inputOutputPointer, *inputPointer);
@@ -144,6 +156,42 @@ class vctDynamicCompactLoopEngines {
     };
 
 
+    /*!  \brief Implement operation of the form \f$c_{io} = op(c_{io},
+      e)\f$ for compact containers, where \f$e\f$ is a lazy
+      expression (see vctDynamicExpression.h).
+
+      The whole expression is evaluated element by element in a
+      single loop, without any temporary container.  The expression
+      must be compact with the same memory layout as the input output
+      container, i.e. all the containers it refers to can be accessed
+      with the index of the element in memory.
+
+      \param _elementOperationType The type of the store back binary
+      operation, e.g. vctStoreBackBinaryOperations::SecondOperand for
+      an assignment.
+    */
+    template<class _elementOperationType>
+    class CioCe {
+    public:
+        template<class _inputOutputOwnerType, class _expressionNodeType>
+        static void Run(_inputOutputOwnerType & inputOutputOwner,
+                        const _expressionNodeType & expressionNode) {
+
+            typedef _inputOutputOwnerType InputOutputOwnerType;
+            typedef typename InputOutputOwnerType::pointer InputOutputPointerType;
+            typedef typename InputOutputOwnerType::size_type size_type;
+            typedef typename InputOutputOwnerType::index_type index_type;
+
+            const size_type size = inputOutputOwner.size();
+            InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
+
+            for (index_type index = 0; index < size; ++index) {
+                _elementOperationType::Operate(inputOutputPointer[index], expressionNode.CompactElement(index));
+            }
+        }
+    };
+
+
     /*!  \brief Implement operation of the form \f$(v_{1}, v_{2}) =
       op(v_{1}, v_{2})\f$ for compact containers.
 
@@ -219,7 +267,10 @@ class vctDynamicCompactLoopEngines {
 
             InputPointerType inputPointer = inputOwner.Pointer();
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::CoCiSi<_elementOperationType>::
+                Run(outputPointer, inputPointer, inputScalar, size);
+
+            for (outputPointer += simdSize, inputPointer += simdSize;
                  outputPointer != outputEnd;
                  outputPointer++, inputPointer++) {
                 *outputPointer = _elementOperationType::Operate(*inputPointer, inputScalar);
@@ -261,7 +312,10 @@ class vctDynamicCompactLoopEngines {
 
             InputPointerType inputPointer = inputOwner.Pointer();
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::CoSiCi<_elementOperationType>::
+                Run(outputPointer, inputScalar, inputPointer, size);
+
+            for (outputPointer += simdSize, inputPointer += simdSize;
                  outputPointer != outputEnd;
                  outputPointer++, inputPointer++) {
                 *outputPointer = _elementOperationType::Operate(inputScalar, *inputPointer);
@@ -296,9 +350,12 @@ class vctDynamicCompactLoopEngines {
             const size_type size = inputOutputOwner.size();
 
             InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
-            const InputOutputPointerType inputOutputEnd = inputOutputPointer + size;;
+            const InputOutputPointerType inputOutputEnd = inputOutputPointer + size;
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::CioSi<_elementOperationType>::
+                Run(inputOutputPointer, inputScalar, size);
+
+            for (inputOutputPointer += simdSize;
                  inputOutputPointer != inputOutputEnd;
                  inputOutputPointer++) {
                 _elementOperationType::Operate(*inputOutputPointer, inputScalar);
@@ -338,7 +395,10 @@ class vctDynamicCompactLoopEngines {
 
             InputPointerType inputPointer = inputOwner.Pointer();
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::CoCi<_elementOperationType>::
+                Run(outputPointer, inputPointer, size);
+
+            for (outputPointer += simdSize, inputPointer += simdSize;
                  outputPointer != outputEnd;
                  outputPointer++, inputPointer++) {
                 *outputPointer = _elementOperationType::Operate(*inputPointer);
@@ -375,7 +435,10 @@ class vctDynamicCompactLoopEngines {
             InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
             const InputOutputPointerType inputOutputEnd = inputOutputPointer + size;
 
-            for (;
+            const size_type simdSize = vctDynamicCompactLoopEnginesSIMD::Cio<_elementOperationType>::
+                Run(inputOutputPointer, size);
+
+            for (inputOutputPointer += simdSize;
                  inputOutputPointer != inputOutputEnd;
                  inputOutputPointer++) {
                 _elementOperationType::Operate(*inputOutputPointer);
@@ -415,7 +478,11 @@ class vctDynamicCompactLoopEngines {
             InputPointerType inputPointer = inputOwner.Pointer();
             const InputPointerType inputEnd = inputPointer + size;
 
-            for (;
+            const size_type simdSize =
+                vctDynamicCompactLoopEnginesSIMD::SoCi<_incrementalOperationType, _elementOperationType>::
+                Run(inputPointer, size, incrementalResult);
+
+            for (inputPointer += simdSize;
                  inputPointer != inputEnd;
                  inputPointer++) {
                 incrementalResult = _incrementalOperationType::Operate(incrementalResult,
@@ -466,7 +533,11 @@ class vctDynamicCompactLoopEngines {
 
             Input2PointerType input2Pointer = input2Owner.Pointer();
 
-            for (;
+            const size_type simdSize =
+                vctDynamicCompactLoopEnginesSIMD::SoCiCi<_incrementalOperationType, _elementOperationType>::
+                Run(input1Pointer, input2Pointer, size, incrementalResult);
+
+            for (input1Pointer += simdSize, input2Pointer += simdSize;
                  input1Pointer != input1End;
                  input1Pointer++, input2Pointer++) {
                 incrementalResult = _incrementalOperationType::Operate(incrementalResult,
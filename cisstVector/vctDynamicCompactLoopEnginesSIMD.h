@@ -0,0 +1,780 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicCompactLoopEnginesSIMD_h
+#define _vctDynamicCompactLoopEnginesSIMD_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicCompactLoopEnginesSIMD
+ */
+
+#include <cisstVector/vctContainerTraits.h>
+#include <cisstVector/vctUnaryOperations.h>
+#include <cisstVector/vctBinaryOperations.h>
+#include <cisstVector/vctStoreBackUnaryOperations.h>
+#include <cisstVector/vctStoreBackBinaryOperations.h>
+
+/*! Instruction set used by the compact loop engines, selected at
+  compile time: AVX2 if the code is compiled with AVX2 enabled
+  (e.g. -mavx2 or -march=native with gcc and clang, /arch:AVX2 with
+  Visual C++), SSE2 on all other x86 64 bits targets and NEON on ARM
+  64 bits targets.  Define VCT_SIMD_DISABLE before including any
+  cisstVector header to use the scalar loops only. */
+#if !defined(VCT_SIMD_DISABLE)
+  #if defined(__AVX2__)
+    #define VCT_SIMD_HAS_AVX2 1
+  #endif
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define VCT_SIMD_HAS_SSE2 1
+  #endif
+  #if defined(__ARM_NEON) && defined(__aarch64__)
+    #define VCT_SIMD_HAS_NEON 1
+  #endif
+#endif
+
+#if defined(VCT_SIMD_HAS_AVX2)
+  #include <immintrin.h>
+#elif defined(VCT_SIMD_HAS_SSE2)
+  #include <emmintrin.h>
+#elif defined(VCT_SIMD_HAS_NEON)
+  #include <arm_neon.h>
+#endif
+
+
+/*!
+  \brief Vector registers used by the SIMD compact loop engines.
+
+  For each supported element type (double, float and int), this
+  class defines the type of the register (PacketType), the number of
+  elements per register (Size) and the elementwise operations on
+  registers used by vctSIMDOperation.  All operations produce the
+  same results as the scalar operations of vctBinaryOperations and
+  vctUnaryOperations, including for signed zeros and NaNs, e.g.
+  Maximum(a, b) is (a > b) ? a : b.
+
+  Memory accesses don't require any alignment.
+
+  The generic version is empty, i.e. the element type is not
+  supported.
+*/
+template <class _elementType>
+class vctSIMDPacket {
+public:
+    enum {Size = 1};
+};
+
+
+#if defined(VCT_SIMD_HAS_AVX2)
+
+template <>
+class vctSIMDPacket<double> {
+public:
+    typedef double value_type;
+    typedef __m256d PacketType;
+    enum {Size = 4};
+    static inline PacketType Load(const value_type * pointer) { return _mm256_loadu_pd(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { _mm256_storeu_pd(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return _mm256_set1_pd(value); }
+    static inline PacketType Zero(void) { return _mm256_setzero_pd(); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return _mm256_add_pd(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return _mm256_sub_pd(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return _mm256_mul_pd(a, b); }
+    static inline PacketType Divide(const PacketType & a, const PacketType & b) { return _mm256_div_pd(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return _mm256_min_pd(a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return _mm256_max_pd(a, b); }
+    static inline PacketType AbsValue(const PacketType & a) {
+        const PacketType positive = _mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_GT_OQ);
+        return _mm256_blendv_pd(_mm256_xor_pd(a, _mm256_set1_pd(-0.0)), a, positive);
+    }
+    static inline value_type Sum(const PacketType & a) {
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+        return _mm_cvtsd_f64(sum);
+    }
+};
+
+template <>
+class vctSIMDPacket<float> {
+public:
+    typedef float value_type;
+    typedef __m256 PacketType;
+    enum {Size = 8};
+    static inline PacketType Load(const value_type * pointer) { return _mm256_loadu_ps(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { _mm256_storeu_ps(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return _mm256_set1_ps(value); }
+    static inline PacketType Zero(void) { return _mm256_setzero_ps(); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return _mm256_add_ps(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return _mm256_sub_ps(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return _mm256_mul_ps(a, b); }
+    static inline PacketType Divide(const PacketType & a, const PacketType & b) { return _mm256_div_ps(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return _mm256_min_ps(a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return _mm256_max_ps(a, b); }
+    static inline PacketType AbsValue(const PacketType & a) {
+        const PacketType positive = _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_GT_OQ);
+        return _mm256_blendv_ps(_mm256_xor_ps(a, _mm256_set1_ps(-0.0f)), a, positive);
+    }
+    static inline value_type Sum(const PacketType & a) {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+    }
+};
+
+template <>
+class vctSIMDPacket<int> {
+public:
+    typedef int value_type;
+    typedef __m256i PacketType;
+    enum {Size = 8};
+    static inline PacketType Load(const value_type * pointer) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pointer)); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(pointer), packet); }
+    static inline PacketType Set(const value_type & value) { return _mm256_set1_epi32(value); }
+    static inline PacketType Zero(void) { return _mm256_setzero_si256(); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return _mm256_add_epi32(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return _mm256_sub_epi32(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return _mm256_mullo_epi32(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return _mm256_min_epi32(a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return _mm256_max_epi32(a, b); }
+    static inline PacketType AbsValue(const PacketType & a) { return _mm256_abs_epi32(a); }
+    static inline value_type Sum(const PacketType & a) {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+};
+
+#elif defined(VCT_SIMD_HAS_SSE2)
+
+template <>
+class vctSIMDPacket<double> {
+public:
+    typedef double value_type;
+    typedef __m128d PacketType;
+    enum {Size = 2};
+    static inline PacketType Load(const value_type * pointer) { return _mm_loadu_pd(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { _mm_storeu_pd(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return _mm_set1_pd(value); }
+    static inline PacketType Zero(void) { return _mm_setzero_pd(); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return _mm_add_pd(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return _mm_sub_pd(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return _mm_mul_pd(a, b); }
+    static inline PacketType Divide(const PacketType & a, const PacketType & b) { return _mm_div_pd(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return _mm_min_pd(a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return _mm_max_pd(a, b); }
+    static inline PacketType AbsValue(const PacketType & a) {
+        const PacketType positive = _mm_cmpgt_pd(a, _mm_setzero_pd());
+        return _mm_or_pd(_mm_and_pd(positive, a),
+                         _mm_andnot_pd(positive, _mm_xor_pd(a, _mm_set1_pd(-0.0))));
+    }
+    static inline value_type Sum(const PacketType & a) {
+        return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+    }
+};
+
+template <>
+class vctSIMDPacket<float> {
+public:
+    typedef float value_type;
+    typedef __m128 PacketType;
+    enum {Size = 4};
+    static inline PacketType Load(const value_type * pointer) { return _mm_loadu_ps(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { _mm_storeu_ps(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return _mm_set1_ps(value); }
+    static inline PacketType Zero(void) { return _mm_setzero_ps(); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return _mm_add_ps(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return _mm_sub_ps(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return _mm_mul_ps(a, b); }
+    static inline PacketType Divide(const PacketType & a, const PacketType & b) { return _mm_div_ps(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return _mm_min_ps(a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return _mm_max_ps(a, b); }
+    static inline PacketType AbsValue(const PacketType & a) {
+        const PacketType positive = _mm_cmpgt_ps(a, _mm_setzero_ps());
+        return _mm_or_ps(_mm_and_ps(positive, a),
+                         _mm_andnot_ps(positive, _mm_xor_ps(a, _mm_set1_ps(-0.0f))));
+    }
+    static inline value_type Sum(const PacketType & a) {
+        PacketType sum = _mm_add_ps(a, _mm_movehl_ps(a, a));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+    }
+};
+
+template <>
+class vctSIMDPacket<int> {
+public:
+    typedef int value_type;
+    typedef __m128i PacketType;
+    enum {Size = 4};
+    static inline PacketType Load(const value_type * pointer) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(pointer)); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { _mm_storeu_si128(reinterpret_cast<__m128i *>(pointer), packet); }
+    static inline PacketType Set(const value_type & value) { return _mm_set1_epi32(value); }
+    static inline PacketType Zero(void) { return _mm_setzero_si128(); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return _mm_add_epi32(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return _mm_sub_epi32(a, b); }
+    // SSE2 has no 32 bits multiplication, minimum nor maximum, the
+    // emulated versions are not faster than the scalar loops
+    static inline PacketType AbsValue(const PacketType & a) {
+        const PacketType positive = _mm_cmpgt_epi32(a, _mm_setzero_si128());
+        return _mm_or_si128(_mm_and_si128(positive, a),
+                            _mm_andnot_si128(positive, _mm_sub_epi32(_mm_setzero_si128(), a)));
+    }
+    static inline value_type Sum(const PacketType & a) {
+        PacketType sum = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+};
+
+#elif defined(VCT_SIMD_HAS_NEON)
+
+template <>
+class vctSIMDPacket<double> {
+public:
+    typedef double value_type;
+    typedef float64x2_t PacketType;
+    enum {Size = 2};
+    static inline PacketType Load(const value_type * pointer) { return vld1q_f64(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { vst1q_f64(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return vdupq_n_f64(value); }
+    static inline PacketType Zero(void) { return vdupq_n_f64(0.0); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return vaddq_f64(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return vsubq_f64(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return vmulq_f64(a, b); }
+    static inline PacketType Divide(const PacketType & a, const PacketType & b) { return vdivq_f64(a, b); }
+    // vminq/vmaxq propagate NaNs, compare and select to match the scalar code
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return vbslq_f64(vcltq_f64(a, b), a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return vbslq_f64(vcgtq_f64(a, b), a, b); }
+    static inline PacketType AbsValue(const PacketType & a) { return vbslq_f64(vcgtq_f64(a, Zero()), a, vnegq_f64(a)); }
+    static inline value_type Sum(const PacketType & a) { return vaddvq_f64(a); }
+};
+
+template <>
+class vctSIMDPacket<float> {
+public:
+    typedef float value_type;
+    typedef float32x4_t PacketType;
+    enum {Size = 4};
+    static inline PacketType Load(const value_type * pointer) { return vld1q_f32(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { vst1q_f32(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return vdupq_n_f32(value); }
+    static inline PacketType Zero(void) { return vdupq_n_f32(0.0f); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return vaddq_f32(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return vsubq_f32(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return vmulq_f32(a, b); }
+    static inline PacketType Divide(const PacketType & a, const PacketType & b) { return vdivq_f32(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+    static inline PacketType AbsValue(const PacketType & a) { return vbslq_f32(vcgtq_f32(a, Zero()), a, vnegq_f32(a)); }
+    static inline value_type Sum(const PacketType & a) { return vaddvq_f32(a); }
+};
+
+template <>
+class vctSIMDPacket<int> {
+public:
+    typedef int value_type;
+    typedef int32x4_t PacketType;
+    enum {Size = 4};
+    static inline PacketType Load(const value_type * pointer) { return vld1q_s32(pointer); }
+    static inline void Store(value_type * pointer, const PacketType & packet) { vst1q_s32(pointer, packet); }
+    static inline PacketType Set(const value_type & value) { return vdupq_n_s32(value); }
+    static inline PacketType Zero(void) { return vdupq_n_s32(0); }
+    static inline PacketType Add(const PacketType & a, const PacketType & b) { return vaddq_s32(a, b); }
+    static inline PacketType Subtract(const PacketType & a, const PacketType & b) { return vsubq_s32(a, b); }
+    static inline PacketType Multiply(const PacketType & a, const PacketType & b) { return vmulq_s32(a, b); }
+    static inline PacketType Minimum(const PacketType & a, const PacketType & b) { return vminq_s32(a, b); }
+    static inline PacketType Maximum(const PacketType & a, const PacketType & b) { return vmaxq_s32(a, b); }
+    static inline PacketType AbsValue(const PacketType & a) { return vbslq_s32(vcgtq_s32(a, Zero()), a, vnegq_s32(a)); }
+    static inline value_type Sum(const PacketType & a) { return vaddvq_s32(a); }
+};
+
+#endif
+
+
+/*!
+  \brief Map the element operations of vctBinaryOperations,
+  vctStoreBackBinaryOperations, vctUnaryOperations and
+  vctStoreBackUnaryOperations to operations on vector registers.
+
+  The generic version is used for all the operations which are not
+  vectorized (Available is false).  The specializations define
+  value_type, PacketTraits (vctSIMDPacket of value_type) and a static
+  method Operate on registers.  IsAddition is true for the
+  vctBinaryOperations::Addition operations, i.e. the incremental
+  operation of Sum, NormSquare and DotProduct.
+*/
+template <class _elementOperationType>
+class vctSIMDOperation {
+public:
+    enum {Available = false, IsAddition = false};
+    typedef void value_type;
+};
+
+
+#if defined(VCT_SIMD_HAS_AVX2) || defined(VCT_SIMD_HAS_SSE2) || defined(VCT_SIMD_HAS_NEON)
+
+#define VCT_SIMD_OPERATION_TRAITS(type, isAddition) \
+public: \
+    typedef type value_type; \
+    typedef vctSIMDPacket<type> PacketTraits; \
+    typedef PacketTraits::PacketType PacketType; \
+    enum {Available = true, IsAddition = isAddition};
+
+#define VCT_SIMD_BINARY_OPERATION(type, operation, function, isAddition) \
+template <> \
+class vctSIMDOperation<vctBinaryOperations<type>::operation> { \
+    VCT_SIMD_OPERATION_TRAITS(type, isAddition) \
+    static inline PacketType Operate(const PacketType & input1, const PacketType & input2) { \
+        return PacketTraits::function(input1, input2); \
+    } \
+}; \
+template <> \
+class vctSIMDOperation<vctStoreBackBinaryOperations<type>::operation> { \
+    VCT_SIMD_OPERATION_TRAITS(type, false) \
+    static inline PacketType Operate(const PacketType & input1, const PacketType & input2) { \
+        return PacketTraits::function(input1, input2); \
+    } \
+};
+
+#define VCT_SIMD_UNARY_OPERATION(operationClass, type, operation, expression) \
+template <> \
+class vctSIMDOperation<operationClass<type>::operation> { \
+    VCT_SIMD_OPERATION_TRAITS(type, false) \
+    static inline PacketType Operate(const PacketType & input) { \
+        return expression; \
+    } \
+};
+
+#define VCT_SIMD_ADDITIVE_OPERATIONS(type) \
+VCT_SIMD_BINARY_OPERATION(type, Addition, Add, true) \
+VCT_SIMD_BINARY_OPERATION(type, Subtraction, Subtract, false) \
+VCT_SIMD_UNARY_OPERATION(vctUnaryOperations, type, Identity, input) \
+VCT_SIMD_UNARY_OPERATION(vctUnaryOperations, type, AbsValue, PacketTraits::AbsValue(input)) \
+VCT_SIMD_UNARY_OPERATION(vctStoreBackUnaryOperations, type, MakeAbs, PacketTraits::AbsValue(input))
+
+#define VCT_SIMD_MULTIPLICATIVE_OPERATIONS(type) \
+VCT_SIMD_BINARY_OPERATION(type, Multiplication, Multiply, false) \
+VCT_SIMD_BINARY_OPERATION(type, Minimum, Minimum, false) \
+VCT_SIMD_BINARY_OPERATION(type, Maximum, Maximum, false) \
+VCT_SIMD_UNARY_OPERATION(vctUnaryOperations, type, Square, PacketTraits::Multiply(input, input))
+
+VCT_SIMD_ADDITIVE_OPERATIONS(double)
+VCT_SIMD_MULTIPLICATIVE_OPERATIONS(double)
+VCT_SIMD_ADDITIVE_OPERATIONS(float)
+VCT_SIMD_MULTIPLICATIVE_OPERATIONS(float)
+VCT_SIMD_ADDITIVE_OPERATIONS(int)
+#if defined(VCT_SIMD_HAS_AVX2) || defined(VCT_SIMD_HAS_NEON)
+VCT_SIMD_MULTIPLICATIVE_OPERATIONS(int)
+#endif
+// there is no integer division instruction
+VCT_SIMD_BINARY_OPERATION(double, Division, Divide, false)
+VCT_SIMD_BINARY_OPERATION(float, Division, Divide, false)
+
+#undef VCT_SIMD_MULTIPLICATIVE_OPERATIONS
+#undef VCT_SIMD_ADDITIVE_OPERATIONS
+#undef VCT_SIMD_UNARY_OPERATION
+#undef VCT_SIMD_BINARY_OPERATION
+#undef VCT_SIMD_OPERATION_TRAITS
+
+#endif
+
+
+/*!  \brief Container class for the SIMD versions of the compact loop
+  engines.
+
+  Each engine of vctDynamicCompactLoopEngines starts with the engine
+  of the same name defined here.  If the element operations have a
+  vectorized implementation (see vctSIMDOperation) and all the
+  containers have the same element type, the engine processes as
+  many elements as possible with vector registers and returns the
+  number of elements processed.  The scalar loop of the calling
+  engine then processes the remaining elements, i.e. less than
+  vctSIMDPacket::Size.  For all the other operations, the SIMD
+  engines return 0 and the calling engine uses its scalar loop for
+  all the elements.  The selection is performed at compile time based
+  on the type of the operations.
+
+  The elementwise operations produce the same results as the scalar
+  loops.  For the floating point reductions (Sum, NormSquare,
+  DotProduct), the order of the additions differs from the scalar
+  loop so the result can differ by a few units in the last place.
+
+  \sa vctDynamicCompactLoopEngines, vctSIMDOperation, vctSIMDPacket
+*/
+class vctDynamicCompactLoopEnginesSIMD {
+
+ public:
+
+    typedef vct::size_type size_type;
+
+    /*! Compile time check that the incremental and element
+      operations of a reduction can be vectorized for the same element
+      type. */
+    template <class _type1, class _type2>
+    class SameType {
+    public:
+        enum {Value = false};
+    };
+
+    template <class _type>
+    class SameType<_type, _type> {
+    public:
+        enum {Value = true};
+    };
+
+    template <class _incrementalOperationType, class _elementOperationType>
+    class Reduction {
+    public:
+        enum {Available = (vctSIMDOperation<_incrementalOperationType>::IsAddition
+                           && vctSIMDOperation<_elementOperationType>::Available
+                           && SameType<typename vctSIMDOperation<_incrementalOperationType>::value_type,
+                                       typename vctSIMDOperation<_elementOperationType>::value_type>::Value)};
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::CoCiCi */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class CoCiCi {
+    public:
+        template <class _outputPointerType, class _input1PointerType, class _input2PointerType>
+        static inline size_type Run(_outputPointerType, _input1PointerType, _input2PointerType, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class CoCiCi<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * output, const value_type * input1, const value_type * input2,
+                                    size_type size) {
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(output + index,
+                              Operation::Operate(Packet::Load(input1 + index), Packet::Load(input2 + index)));
+            }
+            return index;
+        }
+
+        template <class _outputPointerType, class _input1PointerType, class _input2PointerType>
+        static inline size_type Run(_outputPointerType, _input1PointerType, _input2PointerType, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::CioCi */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class CioCi {
+    public:
+        template <class _inputOutputPointerType, class _inputPointerType>
+        static inline size_type Run(_inputOutputPointerType, _inputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class CioCi<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * inputOutput, const value_type * input, size_type size) {
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(inputOutput + index,
+                              Operation::Operate(Packet::Load(inputOutput + index), Packet::Load(input + index)));
+            }
+            return index;
+        }
+
+        template <class _inputOutputPointerType, class _inputPointerType>
+        static inline size_type Run(_inputOutputPointerType, _inputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::CoCiSi */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class CoCiSi {
+    public:
+        template <class _outputPointerType, class _inputPointerType, class _inputScalarType>
+        static inline size_type Run(_outputPointerType, _inputPointerType, const _inputScalarType &, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class CoCiSi<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * output, const value_type * input, const value_type & inputScalar,
+                                    size_type size) {
+            const typename Packet::PacketType scalar = Packet::Set(inputScalar);
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(output + index, Operation::Operate(Packet::Load(input + index), scalar));
+            }
+            return index;
+        }
+
+        template <class _outputPointerType, class _inputPointerType, class _inputScalarType>
+        static inline size_type Run(_outputPointerType, _inputPointerType, const _inputScalarType &, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::CoSiCi */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class CoSiCi {
+    public:
+        template <class _outputPointerType, class _inputScalarType, class _inputPointerType>
+        static inline size_type Run(_outputPointerType, const _inputScalarType &, _inputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class CoSiCi<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * output, const value_type & inputScalar, const value_type * input,
+                                    size_type size) {
+            const typename Packet::PacketType scalar = Packet::Set(inputScalar);
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(output + index, Operation::Operate(scalar, Packet::Load(input + index)));
+            }
+            return index;
+        }
+
+        template <class _outputPointerType, class _inputScalarType, class _inputPointerType>
+        static inline size_type Run(_outputPointerType, const _inputScalarType &, _inputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::CioSi */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class CioSi {
+    public:
+        template <class _inputOutputPointerType, class _inputScalarType>
+        static inline size_type Run(_inputOutputPointerType, const _inputScalarType &, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class CioSi<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * inputOutput, const value_type & inputScalar, size_type size) {
+            const typename Packet::PacketType scalar = Packet::Set(inputScalar);
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(inputOutput + index, Operation::Operate(Packet::Load(inputOutput + index), scalar));
+            }
+            return index;
+        }
+
+        template <class _inputOutputPointerType, class _inputScalarType>
+        static inline size_type Run(_inputOutputPointerType, const _inputScalarType &, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::CoCi */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class CoCi {
+    public:
+        template <class _outputPointerType, class _inputPointerType>
+        static inline size_type Run(_outputPointerType, _inputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class CoCi<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * output, const value_type * input, size_type size) {
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(output + index, Operation::Operate(Packet::Load(input + index)));
+            }
+            return index;
+        }
+
+        template <class _outputPointerType, class _inputPointerType>
+        static inline size_type Run(_outputPointerType, _inputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::Cio */
+    template <class _elementOperationType,
+              bool _available = vctSIMDOperation<_elementOperationType>::Available>
+    class Cio {
+    public:
+        template <class _inputOutputPointerType>
+        static inline size_type Run(_inputOutputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+    template <class _elementOperationType>
+    class Cio<_elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(value_type * inputOutput, size_type size) {
+            size_type index = 0;
+            for (; index + Packet::Size <= size; index += Packet::Size) {
+                Packet::Store(inputOutput + index, Operation::Operate(Packet::Load(inputOutput + index)));
+            }
+            return index;
+        }
+
+        template <class _inputOutputPointerType>
+        static inline size_type Run(_inputOutputPointerType, size_type) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::SoCi.  Only
+      sums are vectorized, i.e. the incremental operation must be
+      vctBinaryOperations::Addition.  The partial sum is added to
+      result using the incremental operation.  Two accumulators are
+      used to hide the latency of the additions. */
+    template <class _incrementalOperationType, class _elementOperationType,
+              bool _available = Reduction<_incrementalOperationType, _elementOperationType>::Available>
+    class SoCi {
+    public:
+        template <class _inputPointerType, class _outputType>
+        static inline size_type Run(_inputPointerType, size_type, _outputType &) {
+            return 0;
+        }
+    };
+
+    template <class _incrementalOperationType, class _elementOperationType>
+    class SoCi<_incrementalOperationType, _elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(const value_type * input, size_type size, value_type & result) {
+            typename Packet::PacketType sum0 = Packet::Zero();
+            typename Packet::PacketType sum1 = Packet::Zero();
+            size_type index = 0;
+            for (; index + 2 * Packet::Size <= size; index += 2 * Packet::Size) {
+                sum0 = Packet::Add(sum0, Operation::Operate(Packet::Load(input + index)));
+                sum1 = Packet::Add(sum1, Operation::Operate(Packet::Load(input + index + Packet::Size)));
+            }
+            if (index + Packet::Size <= size) {
+                sum0 = Packet::Add(sum0, Operation::Operate(Packet::Load(input + index)));
+                index += Packet::Size;
+            }
+            if (index != 0) {
+                result = _incrementalOperationType::Operate(result, Packet::Sum(Packet::Add(sum0, sum1)));
+            }
+            return index;
+        }
+
+        template <class _inputPointerType, class _outputType>
+        static inline size_type Run(_inputPointerType, size_type, _outputType &) {
+            return 0;
+        }
+    };
+
+
+    /*! SIMD version of vctDynamicCompactLoopEngines::SoCiCi, see
+      SoCi. */
+    template <class _incrementalOperationType, class _elementOperationType,
+              bool _available = Reduction<_incrementalOperationType, _elementOperationType>::Available>
+    class SoCiCi {
+    public:
+        template <class _input1PointerType, class _input2PointerType, class _outputType>
+        static inline size_type Run(_input1PointerType, _input2PointerType, size_type, _outputType &) {
+            return 0;
+        }
+    };
+
+    template <class _incrementalOperationType, class _elementOperationType>
+    class SoCiCi<_incrementalOperationType, _elementOperationType, true> {
+        typedef vctSIMDOperation<_elementOperationType> Operation;
+        typedef typename Operation::PacketTraits Packet;
+        typedef typename Operation::value_type value_type;
+    public:
+        static inline size_type Run(const value_type * input1, const value_type * input2, size_type size,
+                                    value_type & result) {
+            typename Packet::PacketType sum0 = Packet::Zero();
+            typename Packet::PacketType sum1 = Packet::Zero();
+            size_type index = 0;
+            for (; index + 2 * Packet::Size <= size; index += 2 * Packet::Size) {
+                sum0 = Packet::Add(sum0, Operation::Operate(Packet::Load(input1 + index),
+                                                            Packet::Load(input2 + index)));
+                sum1 = Packet::Add(sum1, Operation::Operate(Packet::Load(input1 + index + Packet::Size),
+                                                            Packet::Load(input2 + index + Packet::Size)));
+            }
+            if (index + Packet::Size <= size) {
+                sum0 = Packet::Add(sum0, Operation::Operate(Packet::Load(input1 + index),
+                                                            Packet::Load(input2 + index)));
+                index += Packet::Size;
+            }
+            if (index != 0) {
+                result = _incrementalOperationType::Operate(result, Packet::Sum(Packet::Add(sum0, sum1)));
+            }
+            return index;
+        }
+
+        template <class _input1PointerType, class _input2PointerType, class _outputType>
+        static inline size_type Run(_input1PointerType, _input2PointerType, size_type, _outputType &) {
+            return 0;
+        }
+    };
+};
+
+
+#endif  // _vctDynamicCompactLoopEnginesSIMD_h
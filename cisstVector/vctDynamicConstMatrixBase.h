@@ -37,6 +37,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctDynamicConstVectorRef.h>
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstVector/vctDynamicMatrixLoopEngines.h>
+#include <cisstVector/vctDynamicMatrixParallelLoopEngines.h>
 
 #include <iostream>
 #include <iomanip>
@@ -531,6 +532,44 @@ public:
             Run(*this);
     }
 
+    /*! Parallel versions of SumOfElements, NormSquare, L1Norm and
+      MaxAbsElement.  The matrix is split in chunks of rows (row
+      major) or columns (column major) and the chunks are processed
+      according to the execution policy, see vctParallel.  The result
+      doesn't depend on the number of threads used.
+
+      \param parallel The execution policy */
+    inline value_type SumOfElements(const vctParallel & parallel) const {
+        return vctDynamicMatrixParallelLoopEngines::
+            SoMi<typename vctBinaryOperations<value_type>::Addition,
+            typename vctUnaryOperations<value_type>::Identity>::
+            Run(parallel, *this);
+    }
+
+    /* documented above */
+    inline value_type NormSquare(const vctParallel & parallel) const {
+        return vctDynamicMatrixParallelLoopEngines::
+            SoMi<typename vctBinaryOperations<value_type>::Addition,
+            typename vctUnaryOperations<value_type>::Square>::
+            Run(parallel, *this);
+    }
+
+    /* documented above */
+    inline value_type L1Norm(const vctParallel & parallel) const {
+        return vctDynamicMatrixParallelLoopEngines::
+            SoMi<typename vctBinaryOperations<value_type>::Addition,
+            typename vctUnaryOperations<value_type>::AbsValue>::
+            Run(parallel, *this);
+    }
+
+    /* documented above */
+    inline value_type MaxAbsElement(const vctParallel & parallel) const {
+        return vctDynamicMatrixParallelLoopEngines::
+            SoMi<typename vctBinaryOperations<value_type>::Maximum,
+            typename vctUnaryOperations<value_type>::AbsValue>::
+            Run(parallel, *this);
+    }
+
     /*! Compute the minimum AND maximum elements of the matrix.
       This method is more runtime-efficient than computing them
       separately.
@@ -33,6 +33,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstVector/vctContainerTraits.h>
 #include <cisstVector/vctDynamicNArrayLoopEngines.h>
+#include <cisstVector/vctDynamicNArrayParallelLoopEngines.h>
 #include <cisstVector/vctFixedSizeVector.h>
 #include <cisstVector/vctForwardDeclarations.h>
 
@@ -620,6 +621,48 @@ public:
             Run(*this);
     }
 
+    /*! Parallel versions of SumOfElements, NormSquare, L1Norm and
+      MaxAbsElement.  The nArray is split along its first dimension
+      and the chunks are processed according to the execution policy,
+      see vctParallel.  The result doesn't depend on the number of
+      threads used.
+
+      \param parallel The execution policy */
+    inline value_type SumOfElements(const vctParallel & parallel) const
+    {
+        return vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            SoNi<typename vctBinaryOperations<value_type>::Addition,
+            typename vctUnaryOperations<value_type>::Identity>::
+            Run(parallel, *this);
+    }
+
+    /* documented above */
+    inline value_type NormSquare(const vctParallel & parallel) const
+    {
+        return vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            SoNi<typename vctBinaryOperations<value_type>::Addition,
+            typename vctUnaryOperations<value_type>::Square>::
+            Run(parallel, *this);
+    }
+
+    /* documented above */
+    inline value_type L1Norm(const vctParallel & parallel) const
+    {
+        return vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            SoNi<typename vctBinaryOperations<value_type>::Addition,
+            typename vctUnaryOperations<value_type>::AbsValue>::
+            Run(parallel, *this);
+    }
+
+    /* documented above */
+    inline value_type MaxAbsElement(const vctParallel & parallel) const
+    {
+        return vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            SoNi<typename vctBinaryOperations<value_type>::Maximum,
+            typename vctUnaryOperations<value_type>::AbsValue>::
+            Run(parallel, *this);
+    }
+
 
     /*! Compute the minimum AND maximum elements of the nArray.
       This method is more runtime-efficient than computing them
@@ -0,0 +1,552 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicExpression_h
+#define _vctDynamicExpression_h
+
+/*!
+  \file
+  \brief Lazy expressions of dynamic vectors and matrices
+
+  The overloaded operators of dynamic vectors and matrices (e.g.
+  <code>a + b * s - c</code>) create and return a new container for
+  each operation.  For long expressions on large containers, the
+  temporary containers and the multiple passes over the memory
+  dominate the cost of the computation.
+
+  The function vctLazy wraps a dynamic vector or matrix in a
+  lightweight expression object which doesn't own nor copy any data.
+  Operators applied to expressions build an expression tree (a type
+  describing the computation), and nothing is computed until the
+  expression is assigned to a vector or matrix.  At that point, the
+  whole tree is evaluated element by element in a single loop,
+  without any temporary container:
+
+  \code
+  vctDynamicVector<double> a(1000), b(1000), c(1000), result;
+  ...
+  result = vctLazy(a) + vctLazy(b) * 2.0 - vctLazy(c); // one loop, no temporary
+  result += vctLazy(b) * 0.5;                          // same as result.Add(...)
+  vctDynamicMatrix<double> m(vctLazy(m1) - vctLazy(m2));
+  \endcode
+
+  The loops are performed by vctDynamicVectorLoopEngines::VioVe and
+  vctDynamicMatrixLoopEngines::MioMe which use
+  vctDynamicCompactLoopEngines::CioCe when all the containers involved
+  are compact with the same storage order.  The operations themselves
+  are the ones defined in vctBinaryOperations and vctUnaryOperations.
+
+  Supported operations are the elementwise addition and subtraction of
+  two expressions or of an expression and a container, the addition,
+  subtraction, multiplication and division by a scalar and the
+  negation.
+
+  Since the expressions only refer to the data of the containers:
+  - the containers must outlive the expression, an expression should
+    not be stored but assigned directly;
+  - the result can be one of the operands as long as each element of
+    the result only depends on the elements with the same position,
+    e.g. <code>a = vctLazy(a) + vctLazy(b)</code> is valid while
+    assigning an expression using an overlapping reference or a
+    transposed matrix to its own data is not.
+
+  Using expressions is opt-in, the existing operators and their
+  return types are not modified.
+*/
+
+#include <cisstVector/vctDynamicVector.h>
+#include <cisstVector/vctDynamicMatrix.h>
+
+
+/*!
+  \brief Leaf of a lazy expression, refers to the elements of a
+  dynamic vector.
+
+  \sa vctDynamicExpression.h
+*/
+template <class _elementType>
+class vctDynamicExpressionVectorLeaf
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+    typedef size_type SizesType;
+
+    inline vctDynamicExpressionVectorLeaf(const_pointer data, size_type size, stride_type stride):
+        Data(data),
+        Size(size),
+        Stride(stride)
+    {}
+
+    inline SizesType sizes(void) const {
+        return Size;
+    }
+
+    inline bool StorageOrder(void) const {
+        return VCT_ROW_MAJOR;
+    }
+
+    inline bool IsCompact(bool CMN_UNUSED(storageOrder)) const {
+        return (Stride == 1);
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return Data[index];
+    }
+
+    inline value_type Element(index_type index) const {
+        return Data[static_cast<stride_type>(index) * Stride];
+    }
+
+protected:
+    const_pointer Data;
+    size_type Size;
+    stride_type Stride;
+};
+
+
+/*!
+  \brief Leaf of a lazy expression, refers to the elements of a
+  dynamic matrix.
+
+  \sa vctDynamicExpression.h
+*/
+template <class _elementType>
+class vctDynamicExpressionMatrixLeaf
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
+    VCT_NARRAY_TRAITS_TYPEDEFS(2);
+    typedef nsize_type SizesType;
+
+    inline vctDynamicExpressionMatrixLeaf(const_pointer data,
+                                          size_type rows, size_type cols,
+                                          stride_type rowStride, stride_type colStride,
+                                          bool isCompact, bool storageOrder):
+        Data(data),
+        Sizes(rows, cols),
+        RowStride(rowStride),
+        ColStride(colStride),
+        Compact(isCompact),
+        StorageOrderMember(storageOrder)
+    {}
+
+    inline const SizesType & sizes(void) const {
+        return Sizes;
+    }
+
+    inline bool StorageOrder(void) const {
+        return StorageOrderMember;
+    }
+
+    inline bool IsCompact(bool storageOrder) const {
+        return (Compact && (StorageOrderMember == storageOrder));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return Data[index];
+    }
+
+    inline value_type Element(index_type row, index_type col) const {
+        return Data[static_cast<stride_type>(row) * RowStride + static_cast<stride_type>(col) * ColStride];
+    }
+
+protected:
+    const_pointer Data;
+    SizesType Sizes;
+    stride_type RowStride;
+    stride_type ColStride;
+    bool Compact;
+    bool StorageOrderMember;
+};
+
+
+/*!
+  \brief Node of a lazy expression, elementwise binary operation
+  between two expressions, i.e. \f$op(e_1[i], e_2[i])\f$.
+
+  The sizes of both operands are checked when the node is created.
+
+  \param _elementOperationType A binary operation from vctBinaryOperations.
+  \sa vctDynamicExpression.h
+*/
+template <class _elementOperationType, class _node1Type, class _node2Type>
+class vctDynamicExpressionBinary
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _node1Type::value_type);
+    typedef typename _node1Type::SizesType SizesType;
+
+    inline vctDynamicExpressionBinary(const _node1Type & node1, const _node2Type & node2):
+        Node1(node1),
+        Node2(node2)
+    {
+        if (node1.sizes() != node2.sizes()) {
+            cmnThrow(std::runtime_error("vctDynamicExpression: Size mismatch between operands"));
+        }
+    }
+
+    inline SizesType sizes(void) const {
+        return Node1.sizes();
+    }
+
+    inline bool StorageOrder(void) const {
+        return Node1.StorageOrder();
+    }
+
+    inline bool IsCompact(bool storageOrder) const {
+        return (Node1.IsCompact(storageOrder) && Node2.IsCompact(storageOrder));
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Node1.CompactElement(index), Node2.CompactElement(index));
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Node1.Element(index), Node2.Element(index));
+    }
+
+    inline value_type Element(index_type row, index_type col) const {
+        return _elementOperationType::Operate(Node1.Element(row, col), Node2.Element(row, col));
+    }
+
+protected:
+    _node1Type Node1;
+    _node2Type Node2;
+};
+
+
+/*!
+  \brief Node of a lazy expression, elementwise binary operation
+  between an expression and a scalar, i.e. \f$op(e[i], s)\f$.
+
+  \param _elementOperationType A binary operation from vctBinaryOperations.
+  \sa vctDynamicExpression.h
+*/
+template <class _elementOperationType, class _nodeType>
+class vctDynamicExpressionNodeScalar
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _nodeType::value_type);
+    typedef typename _nodeType::SizesType SizesType;
+
+    inline vctDynamicExpressionNodeScalar(const _nodeType & node, const value_type & scalar):
+        Node(node),
+        Scalar(scalar)
+    {}
+
+    inline SizesType sizes(void) const {
+        return Node.sizes();
+    }
+
+    inline bool StorageOrder(void) const {
+        return Node.StorageOrder();
+    }
+
+    inline bool IsCompact(bool storageOrder) const {
+        return Node.IsCompact(storageOrder);
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Node.CompactElement(index), Scalar);
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Node.Element(index), Scalar);
+    }
+
+    inline value_type Element(index_type row, index_type col) const {
+        return _elementOperationType::Operate(Node.Element(row, col), Scalar);
+    }
+
+protected:
+    _nodeType Node;
+    value_type Scalar;
+};
+
+
+/*!
+  \brief Node of a lazy expression, elementwise binary operation
+  between a scalar and an expression, i.e. \f$op(s, e[i])\f$.
+
+  \param _elementOperationType A binary operation from vctBinaryOperations.
+  \sa vctDynamicExpression.h
+*/
+template <class _elementOperationType, class _nodeType>
+class vctDynamicExpressionScalarNode
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _nodeType::value_type);
+    typedef typename _nodeType::SizesType SizesType;
+
+    inline vctDynamicExpressionScalarNode(const value_type & scalar, const _nodeType & node):
+        Scalar(scalar),
+        Node(node)
+    {}
+
+    inline SizesType sizes(void) const {
+        return Node.sizes();
+    }
+
+    inline bool StorageOrder(void) const {
+        return Node.StorageOrder();
+    }
+
+    inline bool IsCompact(bool storageOrder) const {
+        return Node.IsCompact(storageOrder);
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Scalar, Node.CompactElement(index));
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Scalar, Node.Element(index));
+    }
+
+    inline value_type Element(index_type row, index_type col) const {
+        return _elementOperationType::Operate(Scalar, Node.Element(row, col));
+    }
+
+protected:
+    value_type Scalar;
+    _nodeType Node;
+};
+
+
+/*!
+  \brief Node of a lazy expression, elementwise unary operation,
+  i.e. \f$op(e[i])\f$.
+
+  \param _elementOperationType A unary operation from vctUnaryOperations.
+  \sa vctDynamicExpression.h
+*/
+template <class _elementOperationType, class _nodeType>
+class vctDynamicExpressionUnary
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _nodeType::value_type);
+    typedef typename _nodeType::SizesType SizesType;
+
+    inline vctDynamicExpressionUnary(const _nodeType & node):
+        Node(node)
+    {}
+
+    inline SizesType sizes(void) const {
+        return Node.sizes();
+    }
+
+    inline bool StorageOrder(void) const {
+        return Node.StorageOrder();
+    }
+
+    inline bool IsCompact(bool storageOrder) const {
+        return Node.IsCompact(storageOrder);
+    }
+
+    inline value_type CompactElement(index_type index) const {
+        return _elementOperationType::Operate(Node.CompactElement(index));
+    }
+
+    inline value_type Element(index_type index) const {
+        return _elementOperationType::Operate(Node.Element(index));
+    }
+
+    inline value_type Element(index_type row, index_type col) const {
+        return _elementOperationType::Operate(Node.Element(row, col));
+    }
+
+protected:
+    _nodeType Node;
+};
+
+
+/*!
+  \brief Lazy expression evaluated as a dynamic vector.
+
+  Objects of this type are created with vctLazy and the overloaded
+  operators defined in vctDynamicExpression.h.  They can be assigned
+  to dynamic vectors and vector references (see
+  vctDynamicVectorBase::Assign), added or subtracted in place.
+*/
+template <class _nodeType>
+class vctDynamicVectorExpression
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _nodeType::value_type);
+    typedef _nodeType NodeType;
+
+    explicit inline vctDynamicVectorExpression(const NodeType & node):
+        NodeMember(node)
+    {}
+
+    inline const NodeType & Node(void) const {
+        return NodeMember;
+    }
+
+    inline size_type size(void) const {
+        return NodeMember.sizes();
+    }
+
+protected:
+    NodeType NodeMember;
+};
+
+
+/*!
+  \brief Lazy expression evaluated as a dynamic matrix.
+
+  Objects of this type are created with vctLazy and the overloaded
+  operators defined in vctDynamicExpression.h.  They can be assigned
+  to dynamic matrices and matrix references (see
+  vctDynamicMatrixBase::Assign), added or subtracted in place.
+*/
+template <class _nodeType>
+class vctDynamicMatrixExpression
+{
+public:
+    VCT_CONTAINER_TRAITS_TYPEDEFS(typename _nodeType::value_type);
+    typedef _nodeType NodeType;
+
+    explicit inline vctDynamicMatrixExpression(const NodeType & node):
+        NodeMember(node)
+    {}
+
+    inline const NodeType & Node(void) const {
+        return NodeMember;
+    }
+
+    inline size_type rows(void) const {
+        return NodeMember.sizes()[0];
+    }
+
+    inline size_type cols(void) const {
+        return NodeMember.sizes()[1];
+    }
+
+    /*! Storage order of the first matrix used in the expression. */
+    inline bool StorageOrder(void) const {
+        return NodeMember.StorageOrder();
+    }
+
+protected:
+    NodeType NodeMember;
+};
+
+
+/*!
+  \name Creation of lazy expressions
+
+  Wrap a dynamic vector or matrix in an expression.  No data is
+  copied, see vctDynamicExpression.h.
+*/
+//@{
+template <class _vectorOwnerType, class _elementType>
+inline vctDynamicVectorExpression<vctDynamicExpressionVectorLeaf<_elementType> >
+vctLazy(const vctDynamicConstVectorBase<_vectorOwnerType, _elementType> & vector) {
+    typedef vctDynamicExpressionVectorLeaf<_elementType> LeafType;
+    return vctDynamicVectorExpression<LeafType>(LeafType(vector.Pointer(), vector.size(), vector.stride()));
+}
+
+template <class _matrixOwnerType, class _elementType>
+inline vctDynamicMatrixExpression<vctDynamicExpressionMatrixLeaf<_elementType> >
+vctLazy(const vctDynamicConstMatrixBase<_matrixOwnerType, _elementType> & matrix) {
+    typedef vctDynamicExpressionMatrixLeaf<_elementType> LeafType;
+    return vctDynamicMatrixExpression<LeafType>(LeafType(matrix.Pointer(), matrix.rows(), matrix.cols(),
+                                                         matrix.row_stride(), matrix.col_stride(),
+                                                         matrix.IsCompact(), matrix.StorageOrder()));
+}
+//@}
+
+
+/*! Define the operators for lazy expressions of a given kind of
+  container (Vector or Matrix):
+  - elementwise binary operation between two expressions, an
+    expression and a container, a container and an expression;
+  - elementwise binary operation between an expression and a scalar
+    or a scalar and an expression;
+  - unary operation on an expression.
+
+  The type of the scalar is not deduced, it is the type of the
+  elements of the expression so that <code>vctLazy(a) * 2</code> is
+  valid for vectors of doubles. */
+#define VCT_DYNAMIC_EXPRESSION_BINARY_OPERATOR(kind, op, operation) \
+template <class _node1Type, class _node2Type> \
+inline vctDynamic##kind##Expression<vctDynamicExpressionBinary<typename vctBinaryOperations<typename _node1Type::value_type>::operation, _node1Type, _node2Type> > \
+operator op (const vctDynamic##kind##Expression<_node1Type> & expression1, \
+             const vctDynamic##kind##Expression<_node2Type> & expression2) { \
+    typedef vctDynamicExpressionBinary<typename vctBinaryOperations<typename _node1Type::value_type>::operation, _node1Type, _node2Type> NodeType; \
+    return vctDynamic##kind##Expression<NodeType>(NodeType(expression1.Node(), expression2.Node())); \
+} \
+template <class _nodeType, class _ownerType, class _elementType> \
+inline vctDynamic##kind##Expression<vctDynamicExpressionBinary<typename vctBinaryOperations<typename _nodeType::value_type>::operation, _nodeType, vctDynamicExpression##kind##Leaf<_elementType> > > \
+operator op (const vctDynamic##kind##Expression<_nodeType> & expression, \
+             const vctDynamicConst##kind##Base<_ownerType, _elementType> & container) { \
+    return expression op vctLazy(container); \
+} \
+template <class _ownerType, class _elementType, class _nodeType> \
+inline vctDynamic##kind##Expression<vctDynamicExpressionBinary<typename vctBinaryOperations<_elementType>::operation, vctDynamicExpression##kind##Leaf<_elementType>, _nodeType> > \
+operator op (const vctDynamicConst##kind##Base<_ownerType, _elementType> & container, \
+             const vctDynamic##kind##Expression<_nodeType> & expression) { \
+    return vctLazy(container) op expression; \
+}
+
+#define VCT_DYNAMIC_EXPRESSION_SCALAR_OPERATOR(kind, op, operation) \
+template <class _nodeType> \
+inline vctDynamic##kind##Expression<vctDynamicExpressionNodeScalar<typename vctBinaryOperations<typename _nodeType::value_type>::operation, _nodeType> > \
+operator op (const vctDynamic##kind##Expression<_nodeType> & expression, \
+             const typename _nodeType::value_type & scalar) { \
+    typedef vctDynamicExpressionNodeScalar<typename vctBinaryOperations<typename _nodeType::value_type>::operation, _nodeType> NodeType; \
+    return vctDynamic##kind##Expression<NodeType>(NodeType(expression.Node(), scalar)); \
+} \
+template <class _nodeType> \
+inline vctDynamic##kind##Expression<vctDynamicExpressionScalarNode<typename vctBinaryOperations<typename _nodeType::value_type>::operation, _nodeType> > \
+operator op (const typename _nodeType::value_type & scalar, \
+             const vctDynamic##kind##Expression<_nodeType> & expression) { \
+    typedef vctDynamicExpressionScalarNode<typename vctBinaryOperations<typename _nodeType::value_type>::operation, _nodeType> NodeType; \
+    return vctDynamic##kind##Expression<NodeType>(NodeType(scalar, expression.Node())); \
+}
+
+#define VCT_DYNAMIC_EXPRESSION_UNARY_OPERATOR(kind, op, operation) \
+template <class _nodeType> \
+inline vctDynamic##kind##Expression<vctDynamicExpressionUnary<typename vctUnaryOperations<typename _nodeType::value_type>::operation, _nodeType> > \
+operator op (const vctDynamic##kind##Expression<_nodeType> & expression) { \
+    typedef vctDynamicExpressionUnary<typename vctUnaryOperations<typename _nodeType::value_type>::operation, _nodeType> NodeType; \
+    return vctDynamic##kind##Expression<NodeType>(NodeType(expression.Node())); \
+}
+
+#define VCT_DYNAMIC_EXPRESSION_OPERATORS(kind) \
+VCT_DYNAMIC_EXPRESSION_BINARY_OPERATOR(kind, +, Addition) \
+VCT_DYNAMIC_EXPRESSION_BINARY_OPERATOR(kind, -, Subtraction) \
+VCT_DYNAMIC_EXPRESSION_SCALAR_OPERATOR(kind, +, Addition) \
+VCT_DYNAMIC_EXPRESSION_SCALAR_OPERATOR(kind, -, Subtraction) \
+VCT_DYNAMIC_EXPRESSION_SCALAR_OPERATOR(kind, *, Multiplication) \
+VCT_DYNAMIC_EXPRESSION_SCALAR_OPERATOR(kind, /, Division) \
+VCT_DYNAMIC_EXPRESSION_UNARY_OPERATOR(kind, -, Negation)
+
+VCT_DYNAMIC_EXPRESSION_OPERATORS(Vector)
+VCT_DYNAMIC_EXPRESSION_OPERATORS(Matrix)
+
+#undef VCT_DYNAMIC_EXPRESSION_OPERATORS
+#undef VCT_DYNAMIC_EXPRESSION_UNARY_OPERATOR
+#undef VCT_DYNAMIC_EXPRESSION_SCALAR_OPERATOR
+#undef VCT_DYNAMIC_EXPRESSION_BINARY_OPERATOR
+
+
+#endif // _vctDynamicExpression_h
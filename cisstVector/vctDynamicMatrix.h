@@ -130,10 +130,15 @@ http://www.cisst.org/cisst/license.txt.
 
   \param _elementType the type of an element in the matrix
 
+  \param _allocatorType the allocation policy, see
+  vctDynamicAllocatorBase.  The default policy aligns the elements on
+  64 bytes, use vctDynamicInlineAllocator to store small containers
+  without any heap allocation.
+
   \sa vctDynamicMatrixBase vctDynamicConstMatrixBase
 */
-template <class _elementType>
-class vctDynamicMatrix : public vctDynamicMatrixBase<vctDynamicMatrixOwner<_elementType>, _elementType>
+template <class _elementType, class _allocatorType>
+class vctDynamicMatrix : public vctDynamicMatrixBase<vctDynamicMatrixOwner<_elementType, _allocatorType>, _elementType>
 {
 
     friend class vctReturnDynamicMatrix<_elementType>;
@@ -143,8 +148,8 @@ public:
     enum {DIMENSION = 2};
     VCT_NARRAY_TRAITS_TYPEDEFS(DIMENSION);
 
-    typedef vctDynamicMatrixBase<vctDynamicMatrixOwner<_elementType>, _elementType> BaseType;
-    typedef vctDynamicMatrix<_elementType> ThisType;
+    typedef vctDynamicMatrixBase<vctDynamicMatrixOwner<_elementType, _allocatorType>, _elementType> BaseType;
+    typedef vctDynamicMatrix<_elementType, _allocatorType> ThisType;
 
 
     /*! Default constructor. Initialize an empty matrix. */
@@ -243,6 +248,16 @@ public:
         this->ForceAssign(other);
     }
 
+    /*! Constructor from a lazy matrix expression (see vctLazy).  The
+      storage order is the one of the first matrix used in the
+      expression so the expression can be evaluated in a single
+      compact loop, without any temporary matrix. */
+    template <class __nodeType>
+    vctDynamicMatrix(const vctDynamicMatrixExpression<__nodeType> & expression) {
+        this->SetSize(expression.rows(), expression.cols(), expression.StorageOrder());
+        this->Assign(expression);
+    }
+
 
     /*!  Assignment from a dynamic matrix to a matrix.  The
       operation discards the old memory allocated for this matrix, and
@@ -295,6 +310,17 @@ public:
     */
     ThisType & operator = (const vctReturnDynamicMatrix<value_type> & otherMatrix);
 
+    /*! Assignment from a lazy matrix expression (see vctLazy).  This
+      matrix is resized if needed, keeping its storage order, and the
+      expression is evaluated in a single loop, without any temporary
+      matrix. */
+    template <class __nodeType>
+    ThisType & operator = (const vctDynamicMatrixExpression<__nodeType> & expression) {
+        this->SetSize(expression.rows(), expression.cols());
+        this->Assign(expression);
+        return *this;
+    }
+
     /*! Assignement of a scalar to all elements.  See also SetAll. */
     inline ThisType & operator = (const value_type & value) {
         this->SetAll(value);
@@ -351,8 +377,7 @@ public:
         vctDynamicConstMatrixRef<value_type> myDataMinSpaceRef(*this, corner, minSizes);
         vctDynamicMatrixRef<value_type> newDataMinSpaceRef(newData, corner, minSizes);
         newDataMinSpaceRef.Assign(myDataMinSpaceRef);
-        this->Matrix.Disown();
-        this->Matrix.Own(newSizes, isRowMajor, newData.Matrix.Release());
+        this->Matrix.TakeOwnershipOf(newData.Matrix);
     }
     //@}
 
@@ -417,6 +442,7 @@ public:
 */
 template <class _elementType>
 class vctReturnDynamicMatrix : public vctDynamicMatrix<_elementType> {
+    template <class __elementType, class __allocatorType> friend class vctDynamicMatrix;
 public:
     /*! Base type of vctReturnDynamicMatrix. */
     typedef vctDynamicMatrix<_elementType> BaseType;
@@ -426,40 +452,27 @@ public:
     explicit vctReturnDynamicMatrix(const BaseType & other)
     {
         BaseType & nonConstOther = const_cast<BaseType &>(other);
-        // if we don't save it in a variable, it will be destroyed in the Release operation
-        const size_type rows = other.rows();
-        const size_type cols = other.cols();
-        const bool storageOrder = other.StorageOrder();
-        this->Matrix.Own(rows, cols, storageOrder, nonConstOther.Matrix.Release());
+        this->Matrix.TakeOwnershipOf(nonConstOther.Matrix);
     }
 };
 
 
 // implementation of the special copy constuctor of vctDynamicMatrix
-template <class _elementType>
-vctDynamicMatrix<_elementType>::vctDynamicMatrix(const vctReturnDynamicMatrix<_elementType> & other) {
+template <class _elementType, class _allocatorType>
+vctDynamicMatrix<_elementType, _allocatorType>::vctDynamicMatrix(const vctReturnDynamicMatrix<_elementType> & other) {
     vctReturnDynamicMatrix<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicMatrix<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const size_type rows = other.rows();
-    const size_type cols = other.cols();
-    const bool storageOrder = other.StorageOrder();
-    this->Matrix.Own(rows, cols, storageOrder, nonConstOther.Matrix.Release());
+    this->Matrix.TakeOwnershipOf(nonConstOther.Matrix);
 }
 
 
 // implementation of the special assignment operator from vctReturnDynamicMatrix to vctDynamicMatrix
-template <class _elementType>
-vctDynamicMatrix<_elementType> &
-vctDynamicMatrix<_elementType>::operator = (const vctReturnDynamicMatrix<_elementType> & other) {
+template <class _elementType, class _allocatorType>
+vctDynamicMatrix<_elementType, _allocatorType> &
+vctDynamicMatrix<_elementType, _allocatorType>::operator = (const vctReturnDynamicMatrix<_elementType> & other) {
     vctReturnDynamicMatrix<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicMatrix<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const size_type rows = other.rows();
-    const size_type cols = other.cols();
-    const bool storageOrder = other.StorageOrder();
-    this->Matrix.Disown();
-    this->Matrix.Own(rows, cols, storageOrder, nonConstOther.Matrix.Release());
+    this->Matrix.TakeOwnershipOf(nonConstOther.Matrix);
     return *this;
 }
 
@@ -553,6 +553,34 @@ public:
     //@}
 
 
+    /*!
+      \name Assignment from a lazy matrix expression.
+
+      The expression is evaluated element by element in a single loop,
+      without any temporary matrix (see vctLazy and
+      vctDynamicExpression.h).  The sizes must match.  The expression
+      can refer to this matrix as long as each element of the result
+      only depends on the element of this matrix with the same
+      position, e.g. <code>a.Assign(vctLazy(a) + vctLazy(b) * 2.0)</code>.
+
+      \param expression The matrix expression to evaluate.
+    */
+    //@{
+    template <class __nodeType>
+    inline ThisType & Assign(const vctDynamicMatrixExpression<__nodeType> & expression) {
+        vctDynamicMatrixLoopEngines::
+            MioMe<typename vctStoreBackBinaryOperations<value_type>::SecondOperand>::
+            Run(*this, expression.Node());
+        return *this;
+    }
+
+    template <class __nodeType>
+    inline ThisType & operator = (const vctDynamicMatrixExpression<__nodeType> & expression) {
+        return this->Assign(expression);
+    }
+    //@}
+
+
     /*!  \name Forced assignment operation between matrices of
       different types.  This method will use SetSize on the
       destination matrix (this matrix) to make sure the assignment
@@ -929,6 +957,39 @@ public:
     inline ThisType & operator -= (const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix) {
         return this->Subtract(otherMatrix);
     }
+
+    /*! Store back binary elementwise operations between a matrix and
+      a lazy matrix expression.  The expression is evaluated in the
+      same loop as the store back operation, i.e. without any
+      temporary matrix.  See also Assign for lazy expressions. */
+    template <class __nodeType>
+    inline ThisType & Add(const vctDynamicMatrixExpression<__nodeType> & expression) {
+        vctDynamicMatrixLoopEngines::
+            MioMe<typename vctStoreBackBinaryOperations<value_type>::Addition>::
+            Run(*this, expression.Node());
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nodeType>
+    inline ThisType & Subtract(const vctDynamicMatrixExpression<__nodeType> & expression) {
+        vctDynamicMatrixLoopEngines::
+            MioMe<typename vctStoreBackBinaryOperations<value_type>::Subtraction>::
+            Run(*this, expression.Node());
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nodeType>
+    inline ThisType & operator += (const vctDynamicMatrixExpression<__nodeType> & expression) {
+        return this->Add(expression);
+    }
+
+    /* documented above */
+    template <class __nodeType>
+    inline ThisType & operator -= (const vctDynamicMatrixExpression<__nodeType> & expression) {
+        return this->Subtract(expression);
+    }
     //@}
 
 
@@ -1170,6 +1231,159 @@ public:
     //@}
 
 
+    /*! \name Parallel elementwise operations.
+      Same as the methods above, the matrices are split in chunks of
+      rows (row major) or columns (column major) and the chunks are
+      processed according to the execution policy, see vctParallel. */
+    //@{
+    /*! Parallel binary elementwise operations between two matrices,
+      see SumOf, DifferenceOf, ElementwiseProductOf and
+      ElementwiseRatioOf.
+
+      \param parallel The execution policy
+
+      \param matrix1 The first operand of the binary operation
+
+      \param matrix2 The second operand of the binary operation
+
+      \return The matrix "this" modified.
+    */
+    template <class __matrixOwnerType1, class __matrixOwnerType2>
+    inline ThisType & SumOf(const vctParallel & parallel,
+                            const vctDynamicConstMatrixBase<__matrixOwnerType1, _elementType> & matrix1,
+                            const vctDynamicConstMatrixBase<__matrixOwnerType2, _elementType> & matrix2) {
+        vctDynamicMatrixParallelLoopEngines::
+            MoMiMi< typename vctBinaryOperations<value_type>::Addition >
+            ::Run(parallel, *this, matrix1, matrix2);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __matrixOwnerType1, class __matrixOwnerType2>
+    inline ThisType & DifferenceOf(const vctParallel & parallel,
+                                   const vctDynamicConstMatrixBase<__matrixOwnerType1, _elementType> & matrix1,
+                                   const vctDynamicConstMatrixBase<__matrixOwnerType2, _elementType> & matrix2) {
+        vctDynamicMatrixParallelLoopEngines::
+            MoMiMi< typename vctBinaryOperations<value_type>::Subtraction >
+            ::Run(parallel, *this, matrix1, matrix2);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __matrixOwnerType1, class __matrixOwnerType2>
+    inline ThisType & ElementwiseProductOf(const vctParallel & parallel,
+                                           const vctDynamicConstMatrixBase<__matrixOwnerType1, _elementType> & matrix1,
+                                           const vctDynamicConstMatrixBase<__matrixOwnerType2, _elementType> & matrix2) {
+        vctDynamicMatrixParallelLoopEngines::
+            MoMiMi< typename vctBinaryOperations<value_type>::Multiplication >
+            ::Run(parallel, *this, matrix1, matrix2);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __matrixOwnerType1, class __matrixOwnerType2>
+    inline ThisType & ElementwiseRatioOf(const vctParallel & parallel,
+                                         const vctDynamicConstMatrixBase<__matrixOwnerType1, _elementType> & matrix1,
+                                         const vctDynamicConstMatrixBase<__matrixOwnerType2, _elementType> & matrix2) {
+        vctDynamicMatrixParallelLoopEngines::
+            MoMiMi< typename vctBinaryOperations<value_type>::Division >
+            ::Run(parallel, *this, matrix1, matrix2);
+        return *this;
+    }
+
+    /*! Parallel store back binary elementwise operations between two
+      matrices, see Add, Subtract, ElementwiseMultiply and
+      ElementwiseDivide.
+
+      \param parallel The execution policy
+
+      \param otherMatrix The second operand of the binary operation
+      (this[i] is the first operand)
+
+      \return The matrix "this" modified.
+    */
+    template <class __matrixOwnerType>
+    inline ThisType & Add(const vctParallel & parallel,
+                          const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioMi<typename vctStoreBackBinaryOperations<value_type>::Addition >::
+            Run(parallel, *this, otherMatrix);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __matrixOwnerType>
+    inline ThisType & Subtract(const vctParallel & parallel,
+                               const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioMi<typename vctStoreBackBinaryOperations<value_type>::Subtraction >::
+            Run(parallel, *this, otherMatrix);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __matrixOwnerType>
+    inline ThisType & ElementwiseMultiply(const vctParallel & parallel,
+                                          const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioMi<typename vctStoreBackBinaryOperations<value_type>::Multiplication >::
+            Run(parallel, *this, otherMatrix);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __matrixOwnerType>
+    inline ThisType & ElementwiseDivide(const vctParallel & parallel,
+                                        const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioMi<typename vctStoreBackBinaryOperations<value_type>::Division >::
+            Run(parallel, *this, otherMatrix);
+        return *this;
+    }
+
+    /*! Parallel store back binary elementwise operations between a
+      matrix and a scalar, see Add, Subtract, Multiply and Divide.
+
+      \param parallel The execution policy
+
+      \param scalar The second operand of the binary operation
+      (this[i] is the first operand).
+
+      \return The matrix "this" modified.
+    */
+    inline ThisType & Add(const vctParallel & parallel, const value_type scalar) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioSi< typename vctStoreBackBinaryOperations<value_type>::Addition >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+
+    /* documented above */
+    inline ThisType & Subtract(const vctParallel & parallel, const value_type scalar) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioSi< typename vctStoreBackBinaryOperations<value_type>::Subtraction >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+
+    /* documented above */
+    inline ThisType & Multiply(const vctParallel & parallel, const value_type scalar) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioSi< typename vctStoreBackBinaryOperations<value_type>::Multiplication >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+
+    /* documented above */
+    inline ThisType & Divide(const vctParallel & parallel, const value_type scalar) {
+        vctDynamicMatrixParallelLoopEngines::
+            MioSi< typename vctStoreBackBinaryOperations<value_type>::Division >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+    //@}
+
+
     template <class __matrixOwnerType>
     inline ThisType & AddProductOf(const value_type scalar,
                                    const vctDynamicConstMatrixBase<__matrixOwnerType, _elementType> & otherMatrix)
@@ -1296,7 +1510,11 @@ public:
 
 
     /*! Product of two matrices.  If the sizes of the matrices don't
-      match, an exception is thrown.
+      match or if "this" is one of the operands, an exception is
+      thrown.  Large products of compact matrices are computed by
+      blocks (see vctDynamicMatrixLoopEngines::BlockedProduct),
+      possibly using an external BLAS implementation (see
+      vctDynamicMatrixProductBackend).
 
     \param matrix1 The left operand of the binary operation.
 
@@ -1310,9 +1528,11 @@ public:
         typedef vctDynamicConstMatrixBase<__matrixOwnerType2, _elementType> Input2MatrixType;
         typedef typename Input1MatrixType::ConstRowRefType Input1RowRefType;
         typedef typename Input2MatrixType::ConstColumnRefType Input2ColumnRefType;
-        vctDynamicMatrixLoopEngines::
-            Product<typename vctBinaryOperations<value_type, Input1RowRefType, Input2ColumnRefType>::DotProduct>::
-            Run((*this), matrix1, matrix2);
+        if (!vctDynamicMatrixLoopEngines::BlockedProduct::Run((*this), matrix1, matrix2)) {
+            vctDynamicMatrixLoopEngines::
+                Product<typename vctBinaryOperations<value_type, Input1RowRefType, Input2ColumnRefType>::DotProduct>::
+                Run((*this), matrix1, matrix2);
+        }
     }
 
 
@@ -30,11 +30,14 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnThrow.h>
 #include <cisstVector/vctDynamicCompactLoopEngines.h>
+#include <cisstVector/vctDynamicMatrixProductBackend.h>
+
+#include <vector>
 
 /*!
   \brief Container class for the dynamic matrix engines.
 
-  \sa MoMiMi MioMi MoMiSi MoSiMi MioSi MoMi Mio SoMi SoMiMi
+  \sa MoMiMi MioMi MoMiSi MoSiMi MioSi MoMi Mio SoMi SoMiMi MioMe Product BlockedProduct
 */
 class vctDynamicMatrixLoopEngines {
 
@@ -336,6 +339,66 @@ public:
     };  // MioMi class
 
 
+    /*! Perform elementwise operation between a matrix and a lazy
+      matrix expression (see vctDynamicExpression.h) of identical
+      size.  The operation semantics is
+      \code
+      inputOutput[row][column] = op(inputOutput[row][column], expression[row][column]);
+      \endcode
+      The expression is evaluated in a single loop, without any
+      temporary matrix.  If the input output matrix and all the
+      matrices the expression refers to are compact with the same
+      storage order, the loop is performed by
+      vctDynamicCompactLoopEngines::CioCe.
+
+      \param _elementOperationType The type of the store back binary
+      operation.
+    */
+    template<class _elementOperationType>
+    class MioMe {
+    public:
+        template<class _inputOutputMatrixType, class _expressionNodeType>
+        static void Run(_inputOutputMatrixType & inputOutputMatrix,
+                        const _expressionNodeType & expressionNode)
+        {
+            typedef _inputOutputMatrixType InputOutputMatrixType;
+            typedef typename InputOutputMatrixType::OwnerType InputOutputOwnerType;
+            typedef typename InputOutputOwnerType::size_type size_type;
+            typedef typename InputOutputOwnerType::index_type index_type;
+            typedef typename InputOutputOwnerType::stride_type stride_type;
+            typedef typename InputOutputOwnerType::pointer InputOutputPointerType;
+
+            // retrieve owner
+            InputOutputOwnerType & inputOutputOwner = inputOutputMatrix.Owner();
+
+            const size_type rows = inputOutputOwner.rows();
+            const size_type cols = inputOutputOwner.cols();
+
+            // check sizes
+            if ((rows != expressionNode.sizes()[0]) || (cols != expressionNode.sizes()[1])) {
+                ThrowSizeMismatchException();
+            }
+
+            // if compact and same storage order
+            if (inputOutputOwner.IsCompact()
+                && expressionNode.IsCompact(inputOutputOwner.StorageOrder())) {
+                vctDynamicCompactLoopEngines::CioCe<_elementOperationType>::Run(inputOutputOwner, expressionNode);
+            } else {
+                const stride_type inputOutputColStride = inputOutputOwner.col_stride();
+                const stride_type inputOutputRowStride = inputOutputOwner.row_stride();
+
+                InputOutputPointerType inputOutputRowPointer = inputOutputOwner.Pointer();
+                for (index_type row = 0; row < rows; ++row, inputOutputRowPointer += inputOutputRowStride) {
+                    InputOutputPointerType inputOutputPointer = inputOutputRowPointer;
+                    for (index_type col = 0; col < cols; ++col, inputOutputPointer += inputOutputColStride) {
+                        _elementOperationType::Operate(*inputOutputPointer, expressionNode.Element(row, col));
+                    }
+                }
+            }
+        }  // Run method
+    };  // MioMe class
+
+
     template<class _elementOperationType>
     class MoMiSi {
     public:
@@ -955,6 +1018,281 @@ public:
     };  // Product class
 
 
+    /*! Matrix product engine for large compact matrices.  The generic
+      Product engine computes each element of the output as the dot
+      product of a row of the first input and a column of the second
+      input, walking the second input with its row stride.  Beyond a
+      few dozen rows and columns, every access to the second input
+      misses the cache.
+
+      This engine computes the same product by blocks.  The blocks of
+      the inputs are copied (packed) in small contiguous buffers sized
+      to remain in the cache (CacheRows x CacheCommon elements of the
+      first input, CacheCommon x CacheCols elements of the second
+      input), and the output is updated RegisterRows x RegisterCols
+      elements at a time by a micro kernel which keeps these elements
+      in registers.  The order of the loops is the one used by most
+      optimized BLAS implementations (Goto and van de Geijn, "Anatomy
+      of High-Performance Matrix Multiplication", ACM TOMS 2008).
+
+      Run returns false (without modifying the output) if any of the
+      matrices is not compact or if the product is too small to
+      benefit from blocking, in which case the caller should use the
+      Product engine (which also checks that the output is not one of
+      the inputs).  Otherwise, an exception is thrown if the output is
+      one of the inputs and the product is computed by the
+      function registered in vctDynamicMatrixProductBackend if any
+      and if the matrices are large enough, or by the blocked engine.
+      The sums are not computed in the same order as by the Product
+      engine, so the results of floating point products may differ by
+      a few units in the last place.
+    */
+    class BlockedProduct {
+    public:
+        enum {
+            RegisterRows = 4,
+            RegisterCols = 8,
+            CacheRows = 128,
+            CacheCommon = 256,
+            CacheCols = 2048,
+            /*! Products with fewer multiplications (rows x columns x
+              common dimension) use the Product engine */
+            MinimumWork = 32 * 32 * 32
+        };
+
+        template<class _outputMatrixType, class _input1MatrixType, class _input2MatrixType>
+        static bool Run(_outputMatrixType & outputMatrix,
+                        const _input1MatrixType & input1Matrix,
+                        const _input2MatrixType & input2Matrix)
+        {
+            typedef typename _outputMatrixType::size_type size_type;
+
+            const size_type rows = outputMatrix.rows();
+            const size_type cols = outputMatrix.cols();
+            const size_type common = input1Matrix.cols();
+            // check sizes
+            if ((rows != input1Matrix.rows())
+                || (cols != input2Matrix.cols())
+                || (common != input2Matrix.rows())) {
+                ThrowSizeMismatchException();
+            }
+            if (!(outputMatrix.IsCompact() && input1Matrix.IsCompact() && input2Matrix.IsCompact())
+                || (static_cast<double>(rows) * cols * common < MinimumWork)) {
+                return false;
+            }
+            // the blocked engine writes the output before all inputs are read
+            if ((outputMatrix.Pointer() == input1Matrix.Pointer())
+                || (outputMatrix.Pointer() == input2Matrix.Pointer())) {
+                ThrowSharedPointersException();
+            }
+
+            // external implementation, column major storage order
+            // and leading dimensions
+            const bool outputRowMajor = outputMatrix.IsRowMajor();
+            const bool input1RowMajor = input1Matrix.IsRowMajor();
+            const bool input2RowMajor = input2Matrix.IsRowMajor();
+            const size_type outputLead = LeadingDimension(outputMatrix);
+            const size_type input1Lead = LeadingDimension(input1Matrix);
+            const size_type input2Lead = LeadingDimension(input2Matrix);
+            bool done;
+            if (outputRowMajor) {
+                // compute the transposed product, i.e. input2^T * input1^T
+                done = vctDynamicMatrixProductBackend::Run(!input2RowMajor, !input1RowMajor,
+                                                           cols, rows, common,
+                                                           input2Matrix.Pointer(), input2Lead,
+                                                           input1Matrix.Pointer(), input1Lead,
+                                                           outputMatrix.Pointer(), outputLead);
+            } else {
+                done = vctDynamicMatrixProductBackend::Run(input1RowMajor, input2RowMajor,
+                                                           rows, cols, common,
+                                                           input1Matrix.Pointer(), input1Lead,
+                                                           input2Matrix.Pointer(), input2Lead,
+                                                           outputMatrix.Pointer(), outputLead);
+            }
+            if (!done) {
+                Compute(rows, cols, common,
+                        input1Matrix.Pointer(), input1Matrix.row_stride(), input1Matrix.col_stride(),
+                        input2Matrix.Pointer(), input2Matrix.row_stride(), input2Matrix.col_stride(),
+                        outputMatrix.Pointer(), outputMatrix.row_stride(), outputMatrix.col_stride());
+            }
+            return true;
+        }  // Run method
+
+    protected:
+        /*! Leading dimension of a compact matrix in BLAS terms, i.e. the
+          distance between two columns for a column major matrix or
+          between two rows for a row major one. */
+        template<class _matrixType>
+        static typename _matrixType::size_type LeadingDimension(const _matrixType & matrix)
+        {
+            typedef typename _matrixType::size_type size_type;
+            size_type lead, minimum;
+            if (matrix.IsRowMajor()) {
+                lead = static_cast<size_type>(matrix.row_stride());
+                minimum = matrix.cols();
+            } else {
+                lead = static_cast<size_type>(matrix.col_stride());
+                minimum = matrix.rows();
+            }
+            // strides of single row or column matrices are arbitrary
+            if (lead < minimum) {
+                lead = minimum;
+            }
+            return (lead > 0) ? lead : 1;
+        }
+
+        /*! Copy the rows x common block of input1 starting at
+          input1Pointer in RegisterRows x common panels, padded with
+          zeros. */
+        template<class _elementType, class _strideType>
+        static void PackInput1(size_t rows, size_t common,
+                               const _elementType * input1Pointer,
+                               _strideType rowStride, _strideType colStride,
+                               _elementType * buffer)
+        {
+            for (size_t panel = 0; panel < rows; panel += RegisterRows) {
+                const size_t panelRows = (rows - panel < RegisterRows) ? (rows - panel) : static_cast<size_t>(RegisterRows);
+                const _elementType * panelPointer = input1Pointer + panel * rowStride;
+                for (size_t index = 0; index < common; index++) {
+                    const _elementType * pointer = panelPointer + index * colStride;
+                    size_t row = 0;
+                    for (; row < panelRows; row++, buffer++) {
+                        *buffer = pointer[row * rowStride];
+                    }
+                    for (; row < RegisterRows; row++, buffer++) {
+                        *buffer = _elementType(0);
+                    }
+                }
+            }
+        }
+
+        /*! Copy the common x cols block of input2 starting at
+          input2Pointer in common x RegisterCols panels, padded with
+          zeros. */
+        template<class _elementType, class _strideType>
+        static void PackInput2(size_t common, size_t cols,
+                               const _elementType * input2Pointer,
+                               _strideType rowStride, _strideType colStride,
+                               _elementType * buffer)
+        {
+            for (size_t panel = 0; panel < cols; panel += RegisterCols) {
+                const size_t panelCols = (cols - panel < RegisterCols) ? (cols - panel) : static_cast<size_t>(RegisterCols);
+                const _elementType * panelPointer = input2Pointer + panel * colStride;
+                for (size_t index = 0; index < common; index++) {
+                    const _elementType * pointer = panelPointer + index * rowStride;
+                    size_t col = 0;
+                    for (; col < panelCols; col++, buffer++) {
+                        *buffer = pointer[col * colStride];
+                    }
+                    for (; col < RegisterCols; col++, buffer++) {
+                        *buffer = _elementType(0);
+                    }
+                }
+            }
+        }
+
+        /*! Add the product of a packed panel of input1 and a packed
+          panel of input2 to the rows x cols block of the output
+          starting at outputPointer.  The accumulators are kept in one
+          local array per row (RegisterRows is 4) with a fixed size
+          inner loop, a form which compilers hold in registers and
+          vectorize. */
+        template<class _elementType, class _strideType>
+        static void MicroKernel(size_t common,
+                                const _elementType * input1Panel,
+                                const _elementType * input2Panel,
+                                _elementType * outputPointer,
+                                _strideType rowStride, _strideType colStride,
+                                size_t rows, size_t cols)
+        {
+            _elementType accumulator0[RegisterCols], accumulator1[RegisterCols],
+                accumulator2[RegisterCols], accumulator3[RegisterCols];
+            size_t col;
+            for (col = 0; col < RegisterCols; col++) {
+                accumulator0[col] = accumulator1[col] = accumulator2[col] = accumulator3[col] = _elementType(0);
+            }
+            for (size_t index = 0; index < common; index++,
+                     input1Panel += RegisterRows, input2Panel += RegisterCols) {
+                const _elementType input1Element0 = input1Panel[0];
+                const _elementType input1Element1 = input1Panel[1];
+                const _elementType input1Element2 = input1Panel[2];
+                const _elementType input1Element3 = input1Panel[3];
+                for (col = 0; col < RegisterCols; col++) {
+                    accumulator0[col] += input1Element0 * input2Panel[col];
+                    accumulator1[col] += input1Element1 * input2Panel[col];
+                    accumulator2[col] += input1Element2 * input2Panel[col];
+                    accumulator3[col] += input1Element3 * input2Panel[col];
+                }
+            }
+            const _elementType * accumulators[RegisterRows] = {accumulator0, accumulator1, accumulator2, accumulator3};
+            for (size_t row = 0; row < rows; row++) {
+                _elementType * pointer = outputPointer + row * rowStride;
+                for (col = 0; col < cols; col++) {
+                    pointer[col * colStride] += accumulators[row][col];
+                }
+            }
+        }
+
+        /*! Blocked product for arbitrary strides. */
+        template<class _elementType, class _strideType>
+        static void Compute(size_t rows, size_t cols, size_t common,
+                            const _elementType * input1Pointer,
+                            _strideType input1RowStride, _strideType input1ColStride,
+                            const _elementType * input2Pointer,
+                            _strideType input2RowStride, _strideType input2ColStride,
+                            _elementType * outputPointer,
+                            _strideType outputRowStride, _strideType outputColStride)
+        {
+            size_t row, col;
+            for (row = 0; row < rows; row++) {
+                _elementType * pointer = outputPointer + row * outputRowStride;
+                for (col = 0; col < cols; col++) {
+                    pointer[col * outputColStride] = _elementType(0);
+                }
+            }
+
+            const size_t input1BlockRows = (rows < CacheRows) ? rows : static_cast<size_t>(CacheRows);
+            const size_t blockCommon = (common < CacheCommon) ? common : static_cast<size_t>(CacheCommon);
+            const size_t input2BlockCols = (cols < CacheCols) ? cols : static_cast<size_t>(CacheCols);
+            std::vector<_elementType> input1Buffer(((input1BlockRows + RegisterRows - 1) / RegisterRows)
+                                                   * RegisterRows * blockCommon);
+            std::vector<_elementType> input2Buffer(((input2BlockCols + RegisterCols - 1) / RegisterCols)
+                                                   * RegisterCols * blockCommon);
+
+            for (size_t colBlock = 0; colBlock < cols; colBlock += CacheCols) {
+                const size_t blockCols = (cols - colBlock < CacheCols) ? (cols - colBlock) : static_cast<size_t>(CacheCols);
+                for (size_t commonBlock = 0; commonBlock < common; commonBlock += CacheCommon) {
+                    const size_t blockSize = (common - commonBlock < CacheCommon) ? (common - commonBlock) : static_cast<size_t>(CacheCommon);
+                    PackInput2(blockSize, blockCols,
+                               input2Pointer + commonBlock * input2RowStride + colBlock * input2ColStride,
+                               input2RowStride, input2ColStride, &(input2Buffer[0]));
+                    for (size_t rowBlock = 0; rowBlock < rows; rowBlock += CacheRows) {
+                        const size_t blockRows = (rows - rowBlock < CacheRows) ? (rows - rowBlock) : static_cast<size_t>(CacheRows);
+                        PackInput1(blockRows, blockSize,
+                                   input1Pointer + rowBlock * input1RowStride + commonBlock * input1ColStride,
+                                   input1RowStride, input1ColStride, &(input1Buffer[0]));
+                        for (col = 0; col < blockCols; col += RegisterCols) {
+                            const size_t panelCols = (blockCols - col < RegisterCols) ? (blockCols - col) : static_cast<size_t>(RegisterCols);
+                            const _elementType * input2Panel = &(input2Buffer[0]) + col * blockSize;
+                            for (row = 0; row < blockRows; row += RegisterRows) {
+                                const size_t panelRows = (blockRows - row < RegisterRows) ? (blockRows - row) : static_cast<size_t>(RegisterRows);
+                                MicroKernel(blockSize,
+                                            &(input1Buffer[0]) + row * blockSize,
+                                            input2Panel,
+                                            outputPointer
+                                            + (rowBlock + row) * outputRowStride
+                                            + (colBlock + col) * outputColStride,
+                                            outputRowStride, outputColStride,
+                                            panelRows, panelCols);
+                            }
+                        }
+                    }
+                }
+            }
+        }  // Compute method
+    };  // BlockedProduct class
+
+
     /*! A specialized engine for computing the minimum and maximum
       elements of a matrix in one pass.  This implementation is more
       efficient than computing them separately.
@@ -30,12 +30,22 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstVector/vctForwardDeclarations.h>
 #include <cisstVector/vctVarStrideMatrixIterator.h>
 #include <cisstVector/vctDynamicMatrixRefOwner.h>
+#include <cisstVector/vctDynamicAllocators.h>
+
+#include <algorithm>
 
 /*!
   This templated class owns a dynamically allocated array, but does
-  not provide any other operations */
-template<class _elementType>
-class vctDynamicMatrixOwner
+  not provide any other operations.
+
+  The memory is managed by the allocation policy _allocatorType (see
+  vctDynamicAllocatorBase).  If the policy has an inline buffer
+  (vctDynamicInlineAllocator), matrices small enough to fit in it
+  don't allocate any memory.
+*/
+template<class _elementType, class _allocatorType>
+class vctDynamicMatrixOwner:
+    protected vctDynamicInlineBuffer<(_allocatorType::INLINE_BYTES / sizeof(_elementType)) * sizeof(_elementType)>
 {
 public:
     /* define most types from vctContainerTraits */
@@ -43,7 +53,13 @@ public:
     enum {DIMENSION = 2};
     VCT_NARRAY_TRAITS_TYPEDEFS(DIMENSION);
 
-    typedef vctDynamicMatrixOwner<value_type> ThisType;
+    typedef vctDynamicMatrixOwner<value_type, _allocatorType> ThisType;
+
+    /*! Allocation policy */
+    typedef _allocatorType AllocatorType;
+
+    /*! Maximum number of elements stored in the inline buffer */
+    enum {INLINE_SIZE = AllocatorType::INLINE_BYTES / sizeof(value_type)};
 
     /* iterators are container specific */
     typedef vctVarStrideMatrixConstIterator<value_type> const_iterator;
@@ -181,24 +197,46 @@ public:
         if ((newSizes == this->sizes()) && (rowMajor == RowMajor)) return;
         Disown();
         const size_type totalSize = newSizes.ProductOfElements();
-        Own(newSizes, rowMajor, (totalSize == 0) ? 0 : new value_type[totalSize]);
+        if (totalSize == 0) {
+            Data = 0;
+        } else if (totalSize <= static_cast<size_type>(INLINE_SIZE)) {
+            Data = vctDynamicAllocatorBase::Construct<value_type>(this->InlineMemory(), totalSize, 0);
+        } else {
+            Data = AllocatorType::template Allocate<value_type>(totalSize);
+        }
+        SetSizesAndStrides(newSizes, rowMajor);
     }
     //@}
 
     /*! Release the currently owned data pointer from being owned.
       Reset this owner's data pointer and size to zero.  Return the
-      old data pointer without freeing memory.
+      old data pointer without freeing memory.  The returned block
+      is always allocated with new[] and must be freed with delete[].
+      Unless AllocatorType allocates with new[]
+      (vctDynamicNewAllocator), the elements are copied to a new block.
      */
     pointer Release() {
-        pointer oldData = Data;
-        Data = 0;
-        SizesMember.SetAll(0);
+        pointer oldData = 0;
+        if (AllocatorType::NEW_ARRAY && !IsInline()) {
+            oldData = Data;
+            Data = 0;
+            SizesMember.SetAll(0);
+        } else if (Data != 0) {
+            oldData = new value_type[size()];
+            std::copy(Data, Data + size(), oldData);
+            Disown();
+        } else {
+            SizesMember.SetAll(0);
+        }
         RowMajor = VCT_DEFAULT_STORAGE;
         return oldData;
     }
 
     /*! Have this owner take ownership of a new data pointer. Return
-      the old data pointer without freeing memory.
+      the old data pointer without freeing memory.  As for Release(),
+      both the new and old data pointers are allocated with new[].
+      Unless AllocatorType allocates with new[]
+      (vctDynamicNewAllocator), the elements are copied.
 
       \note This method returns a pointer to the previously owned
       memory block but doesn't tell if the old block was row or column
@@ -210,12 +248,20 @@ public:
     }
 
     pointer Own(const nsize_type & newSizes, bool rowMajor, pointer data) {
-        pointer oldData = Data;
-        SizesMember.Assign(newSizes);
-        StridesMember.Element(0) = rowMajor ? this->cols() : 1;
-        StridesMember.Element(1) = rowMajor ? 1 : this->rows();
-        RowMajor = rowMajor;
-        Data = data;
+        if (AllocatorType::NEW_ARRAY && !IsInline()) {
+            pointer oldData = Data;
+            Data = data;
+            SetSizesAndStrides(newSizes, rowMajor);
+            return oldData;
+        }
+        pointer oldData = Release();
+        if (data == 0) {
+            SetSizesAndStrides(newSizes, rowMajor);
+        } else {
+            SetSize(newSizes, rowMajor);
+            std::copy(data, data + size(), Data);
+            delete[] data;
+        }
         return oldData;
     }
     //@}
@@ -224,13 +270,50 @@ public:
       pointer and size to zero.
     */
     void Disown(void) {
-        delete[] Data;
+        if (IsInline()) {
+            vctDynamicAllocatorBase::Destroy(Data, size());
+        } else if (Data != 0) {
+            AllocatorType::template Deallocate<value_type>(Data, size());
+        }
         SizesMember.SetAll(0);
         StridesMember.Element(0) = RowMajor ? 0 : 1;
         StridesMember.Element(1) = RowMajor ? 1 : 0;
         Data = 0;
     }
 
+    /*! Take the data of another owner, including its sizes and
+      storage order, and disown it.  The memory block of the other
+      owner is transfered without copy unless the data is stored in
+      its inline buffer. */
+    void TakeOwnershipOf(ThisType & other) {
+        if (&other == this) return;
+        if (other.IsInline()) {
+            SetSize(other.SizesMember, other.RowMajor);
+            std::copy(other.Data, other.Data + other.size(), Data);
+            other.Disown();
+        } else {
+            Disown();
+            Data = other.Data;
+            SetSizesAndStrides(other.SizesMember, other.RowMajor);
+            other.Data = 0;
+            other.Disown();
+        }
+    }
+
+    /*! Same as above for an owner using a different allocation
+      policy, the elements are always copied. */
+    template <class __allocatorType>
+    void TakeOwnershipOf(vctDynamicMatrixOwner<value_type, __allocatorType> & other) {
+        SetSize(other.sizes(), other.IsRowMajor());
+        std::copy(other.Pointer(), other.Pointer() + other.size(), Data);
+        other.Disown();
+    }
+
+    /*! Test if the data is stored in the inline buffer. */
+    inline bool IsInline(void) const {
+        return (INLINE_SIZE != 0) && (Data != 0) && (Data == this->InlineMemory());
+    }
+
     inline bool IsColMajor(void) const {
         return !RowMajor;
     }
@@ -248,6 +331,13 @@ public:
     }
 
 protected:
+    void SetSizesAndStrides(const nsize_type & newSizes, bool rowMajor) {
+        SizesMember.Assign(newSizes);
+        StridesMember.Element(0) = rowMajor ? this->cols() : 1;
+        StridesMember.Element(1) = rowMajor ? 1 : this->rows();
+        RowMajor = rowMajor;
+    }
+
     nsize_type SizesMember;
     nstride_type StridesMember;
     bool RowMajor;
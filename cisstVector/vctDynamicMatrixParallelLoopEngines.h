@@ -0,0 +1,561 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicMatrixParallelLoopEngines_h
+#define _vctDynamicMatrixParallelLoopEngines_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicMatrixParallelLoopEngines
+ */
+
+#include <cisstVector/vctForwardDeclarations.h>
+#include <cisstVector/vctDynamicMatrixLoopEngines.h>
+#include <cisstVector/vctParallel.h>
+
+/*!
+  \brief Container class for the parallel dynamic matrix engines.
+
+  Each engine has the same name and parameters as the corresponding
+  engine of vctDynamicMatrixLoopEngines, preceded by the execution
+  policy (see vctParallel).  The matrices are split in chunks of rows
+  if the first matrix (output or first input) is row major, in chunks
+  of columns otherwise, and each chunk is processed by the engine of
+  vctDynamicMatrixLoopEngines.  If the policy doesn't split the
+  matrices, the engines of vctDynamicMatrixLoopEngines are used
+  directly.
+
+  \sa MoMiMi MoMiSi MoSiMi MoMi MioMi MioSi Mio SoMi SoMiMi
+*/
+class vctDynamicMatrixParallelLoopEngines
+{
+public:
+    /* define types */
+    typedef vct::size_type size_type;
+    typedef vct::stride_type stride_type;
+
+    /*! Returns true if the matrix should be split in chunks of rows,
+      i.e. if rows are the outermost dimension in memory. */
+    template <class _matrixType>
+    inline static bool ChunkRows(const _matrixType & matrix)
+    {
+        const stride_type rowStride = matrix.row_stride();
+        const stride_type colStride = matrix.col_stride();
+        return ((rowStride < 0) ? -rowStride : rowStride) >= ((colStride < 0) ? -colStride : colStride);
+    }
+
+    /*! Number of chunks to split a matrix in, 1 if it should be
+      processed by the serial engines. */
+    template <class _matrixType>
+    inline static size_type NumberOfChunks(const vctParallel & parallel, const _matrixType & matrix,
+                                           bool splitRows)
+    {
+        return parallel.NumberOfChunks(matrix.size(), splitRows ? matrix.rows() : matrix.cols());
+    }
+
+    /*! Helper function to throw an exception if the sizes of two
+      matrices don't match before creating the tasks. */
+    template <class _matrix1Type, class _matrix2Type>
+    inline static void CheckSizes(const _matrix1Type & matrix1, const _matrix2Type & matrix2)
+    {
+        if ((matrix1.rows() != matrix2.rows()) || (matrix1.cols() != matrix2.cols())) {
+            vctDynamicMatrixLoopEngines::ThrowSizeMismatchException();
+        }
+    }
+
+    /*! Reference on a chunk of rows or columns of a matrix, see
+      vctParallel::ChunkBegin. */
+    template <class _matrixType>
+    class ChunkRef: public vctDynamicMatrixRef<typename _matrixType::value_type>
+    {
+    public:
+        ChunkRef(_matrixType & matrix, bool splitRows, size_type chunkIndex, size_type numberOfChunks)
+        {
+            const size_type outerSize = splitRows ? matrix.rows() : matrix.cols();
+            const size_type begin = vctParallel::ChunkBegin(chunkIndex, numberOfChunks, outerSize);
+            const size_type size = vctParallel::ChunkBegin(chunkIndex + 1, numberOfChunks, outerSize) - begin;
+            if (splitRows) {
+                this->SetRef(size, matrix.cols(), matrix.row_stride(), matrix.col_stride(), matrix.Pointer(begin, 0));
+            } else {
+                this->SetRef(matrix.rows(), size, matrix.row_stride(), matrix.col_stride(), matrix.Pointer(0, begin));
+            }
+        }
+    };
+
+    /*! Const reference on a chunk of rows or columns of a matrix. */
+    template <class _matrixType>
+    class ConstChunkRef: public vctDynamicConstMatrixRef<typename _matrixType::value_type>
+    {
+    public:
+        ConstChunkRef(const _matrixType & matrix, bool splitRows, size_type chunkIndex, size_type numberOfChunks)
+        {
+            const size_type outerSize = splitRows ? matrix.rows() : matrix.cols();
+            const size_type begin = vctParallel::ChunkBegin(chunkIndex, numberOfChunks, outerSize);
+            const size_type size = vctParallel::ChunkBegin(chunkIndex + 1, numberOfChunks, outerSize) - begin;
+            if (splitRows) {
+                this->SetRef(size, matrix.cols(), matrix.row_stride(), matrix.col_stride(), matrix.Pointer(begin, 0));
+            } else {
+                this->SetRef(matrix.rows(), size, matrix.row_stride(), matrix.col_stride(), matrix.Pointer(0, begin));
+            }
+        }
+    };
+
+
+    template <class _elementOperationType>
+    class MoMiMi
+    {
+        typedef vctDynamicMatrixLoopEngines::MoMiMi<_elementOperationType> SerialEngine;
+
+        template <class _outputMatrixType, class _input1MatrixType, class _input2MatrixType>
+        class Task
+        {
+        public:
+            _outputMatrixType & Output;
+            const _input1MatrixType & Input1;
+            const _input2MatrixType & Input2;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_outputMatrixType & output, const _input1MatrixType & input1,
+                 const _input2MatrixType & input2, bool splitRows, size_type numberOfChunks):
+                Output(output), Input1(input1), Input2(input2), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputMatrixType> output(task.Output, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_input1MatrixType> input1(task.Input1, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_input2MatrixType> input2(task.Input2, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, input1, input2);
+            }
+        };
+
+    public:
+        template <class _outputMatrixType, class _input1MatrixType, class _input2MatrixType>
+        static void Run(const vctParallel & parallel,
+                        _outputMatrixType & outputMatrix,
+                        const _input1MatrixType & input1Matrix,
+                        const _input2MatrixType & input2Matrix)
+        {
+            const bool splitRows = ChunkRows(outputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputMatrix, input1Matrix, input2Matrix);
+                return;
+            }
+            CheckSizes(outputMatrix, input1Matrix);
+            CheckSizes(outputMatrix, input2Matrix);
+            typedef Task<_outputMatrixType, _input1MatrixType, _input2MatrixType> TaskType;
+            TaskType task(outputMatrix, input1Matrix, input2Matrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // MoMiMi class
+
+
+    template <class _elementOperationType>
+    class MoMiSi
+    {
+        typedef vctDynamicMatrixLoopEngines::MoMiSi<_elementOperationType> SerialEngine;
+
+        template <class _outputMatrixType, class _inputMatrixType, class _inputScalarType>
+        class Task
+        {
+        public:
+            _outputMatrixType & Output;
+            const _inputMatrixType & Input;
+            const _inputScalarType & Scalar;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_outputMatrixType & output, const _inputMatrixType & input,
+                 const _inputScalarType & scalar, bool splitRows, size_type numberOfChunks):
+                Output(output), Input(input), Scalar(scalar), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputMatrixType> output(task.Output, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputMatrixType> input(task.Input, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, input, task.Scalar);
+            }
+        };
+
+    public:
+        template <class _outputMatrixType, class _inputMatrixType, class _inputScalarType>
+        static void Run(const vctParallel & parallel,
+                        _outputMatrixType & outputMatrix,
+                        const _inputMatrixType & inputMatrix,
+                        const _inputScalarType inputScalar)
+        {
+            const bool splitRows = ChunkRows(outputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputMatrix, inputMatrix, inputScalar);
+                return;
+            }
+            CheckSizes(outputMatrix, inputMatrix);
+            typedef Task<_outputMatrixType, _inputMatrixType, _inputScalarType> TaskType;
+            TaskType task(outputMatrix, inputMatrix, inputScalar, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // MoMiSi class
+
+
+    template <class _elementOperationType>
+    class MoSiMi
+    {
+        typedef vctDynamicMatrixLoopEngines::MoSiMi<_elementOperationType> SerialEngine;
+
+        template <class _outputMatrixType, class _inputScalarType, class _inputMatrixType>
+        class Task
+        {
+        public:
+            _outputMatrixType & Output;
+            const _inputScalarType & Scalar;
+            const _inputMatrixType & Input;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_outputMatrixType & output, const _inputScalarType & scalar,
+                 const _inputMatrixType & input, bool splitRows, size_type numberOfChunks):
+                Output(output), Scalar(scalar), Input(input), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputMatrixType> output(task.Output, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputMatrixType> input(task.Input, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, task.Scalar, input);
+            }
+        };
+
+    public:
+        template <class _outputMatrixType, class _inputScalarType, class _inputMatrixType>
+        static void Run(const vctParallel & parallel,
+                        _outputMatrixType & outputMatrix,
+                        const _inputScalarType inputScalar,
+                        const _inputMatrixType & inputMatrix)
+        {
+            const bool splitRows = ChunkRows(outputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputMatrix, inputScalar, inputMatrix);
+                return;
+            }
+            CheckSizes(outputMatrix, inputMatrix);
+            typedef Task<_outputMatrixType, _inputScalarType, _inputMatrixType> TaskType;
+            TaskType task(outputMatrix, inputScalar, inputMatrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // MoSiMi class
+
+
+    template <class _elementOperationType>
+    class MoMi
+    {
+        typedef vctDynamicMatrixLoopEngines::MoMi<_elementOperationType> SerialEngine;
+
+        template <class _outputMatrixType, class _inputMatrixType>
+        class Task
+        {
+        public:
+            _outputMatrixType & Output;
+            const _inputMatrixType & Input;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_outputMatrixType & output, const _inputMatrixType & input, bool splitRows, size_type numberOfChunks):
+                Output(output), Input(input), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputMatrixType> output(task.Output, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputMatrixType> input(task.Input, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, input);
+            }
+        };
+
+    public:
+        template <class _outputMatrixType, class _inputMatrixType>
+        static void Run(const vctParallel & parallel,
+                        _outputMatrixType & outputMatrix,
+                        const _inputMatrixType & inputMatrix)
+        {
+            const bool splitRows = ChunkRows(outputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputMatrix, inputMatrix);
+                return;
+            }
+            CheckSizes(outputMatrix, inputMatrix);
+            typedef Task<_outputMatrixType, _inputMatrixType> TaskType;
+            TaskType task(outputMatrix, inputMatrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // MoMi class
+
+
+    template <class _elementOperationType>
+    class MioMi
+    {
+        typedef vctDynamicMatrixLoopEngines::MioMi<_elementOperationType> SerialEngine;
+
+        template <class _inputOutputMatrixType, class _inputMatrixType>
+        class Task
+        {
+        public:
+            _inputOutputMatrixType & InputOutput;
+            const _inputMatrixType & Input;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_inputOutputMatrixType & inputOutput, const _inputMatrixType & input, bool splitRows, size_type numberOfChunks):
+                InputOutput(inputOutput), Input(input), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_inputOutputMatrixType> inputOutput(task.InputOutput, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputMatrixType> input(task.Input, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(inputOutput, input);
+            }
+        };
+
+    public:
+        template <class _inputOutputMatrixType, class _inputMatrixType>
+        static void Run(const vctParallel & parallel,
+                        _inputOutputMatrixType & inputOutputMatrix,
+                        const _inputMatrixType & inputMatrix)
+        {
+            const bool splitRows = ChunkRows(inputOutputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputOutputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(inputOutputMatrix, inputMatrix);
+                return;
+            }
+            CheckSizes(inputOutputMatrix, inputMatrix);
+            typedef Task<_inputOutputMatrixType, _inputMatrixType> TaskType;
+            TaskType task(inputOutputMatrix, inputMatrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // MioMi class
+
+
+    template <class _elementOperationType>
+    class MioSi
+    {
+        typedef vctDynamicMatrixLoopEngines::MioSi<_elementOperationType> SerialEngine;
+
+        template <class _inputOutputMatrixType, class _inputScalarType>
+        class Task
+        {
+        public:
+            _inputOutputMatrixType & InputOutput;
+            const _inputScalarType & Scalar;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_inputOutputMatrixType & inputOutput, const _inputScalarType & scalar, bool splitRows, size_type numberOfChunks):
+                InputOutput(inputOutput), Scalar(scalar), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_inputOutputMatrixType> inputOutput(task.InputOutput, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(inputOutput, task.Scalar);
+            }
+        };
+
+    public:
+        template <class _inputOutputMatrixType, class _inputScalarType>
+        static void Run(const vctParallel & parallel,
+                        _inputOutputMatrixType & inputOutputMatrix,
+                        const _inputScalarType inputScalar)
+        {
+            const bool splitRows = ChunkRows(inputOutputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputOutputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(inputOutputMatrix, inputScalar);
+                return;
+            }
+            typedef Task<_inputOutputMatrixType, _inputScalarType> TaskType;
+            TaskType task(inputOutputMatrix, inputScalar, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // MioSi class
+
+
+    template <class _elementOperationType>
+    class Mio
+    {
+        typedef vctDynamicMatrixLoopEngines::Mio<_elementOperationType> SerialEngine;
+
+        template <class _inputOutputMatrixType>
+        class Task
+        {
+        public:
+            _inputOutputMatrixType & InputOutput;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+
+            Task(_inputOutputMatrixType & inputOutput, bool splitRows, size_type numberOfChunks):
+                InputOutput(inputOutput), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_inputOutputMatrixType> inputOutput(task.InputOutput, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(inputOutput);
+            }
+        };
+
+    public:
+        template <class _inputOutputMatrixType>
+        static void Run(const vctParallel & parallel,
+                        _inputOutputMatrixType & inputOutputMatrix)
+        {
+            const bool splitRows = ChunkRows(inputOutputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputOutputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(inputOutputMatrix);
+                return;
+            }
+            typedef Task<_inputOutputMatrixType> TaskType;
+            TaskType task(inputOutputMatrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // Mio class
+
+
+    /*! The result of each chunk is stored and the results are combined
+      with the incremental operation in the order of the chunks, so the
+      result doesn't depend on the order in which the chunks are
+      processed. */
+    template <class _incrementalOperationType, class _elementOperationType>
+    class SoMi
+    {
+        typedef vctDynamicMatrixLoopEngines::SoMi<_incrementalOperationType, _elementOperationType> SerialEngine;
+
+    public:
+        typedef typename _incrementalOperationType::OutputType OutputType;
+
+    protected:
+        template <class _inputMatrixType>
+        class Task
+        {
+        public:
+            const _inputMatrixType & Input;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+            OutputType Results[vctParallel::MAXIMUM_NUMBER_OF_CHUNKS];
+
+            Task(const _inputMatrixType & input, bool splitRows, size_type numberOfChunks):
+                Input(input), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                Task & task = *static_cast<Task *>(data);
+                ConstChunkRef<_inputMatrixType> input(task.Input, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                task.Results[chunkIndex] = SerialEngine::Run(input);
+            }
+        };
+
+    public:
+        template <class _inputMatrixType>
+        static OutputType Run(const vctParallel & parallel,
+                              const _inputMatrixType & inputMatrix)
+        {
+            const bool splitRows = ChunkRows(inputMatrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputMatrix, splitRows);
+            if (numberOfChunks == 1) {
+                return SerialEngine::Run(inputMatrix);
+            }
+            typedef Task<_inputMatrixType> TaskType;
+            TaskType task(inputMatrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+            OutputType incrementalResult = _incrementalOperationType::NeutralElement();
+            for (size_type chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex) {
+                incrementalResult = _incrementalOperationType::Operate(incrementalResult, task.Results[chunkIndex]);
+            }
+            return incrementalResult;
+        }
+    };  // SoMi class
+
+
+    /*! See SoMi for the order of the operations. */
+    template <class _incrementalOperationType, class _elementOperationType>
+    class SoMiMi
+    {
+        typedef vctDynamicMatrixLoopEngines::SoMiMi<_incrementalOperationType, _elementOperationType> SerialEngine;
+
+    public:
+        typedef typename _incrementalOperationType::OutputType OutputType;
+
+    protected:
+        template <class _input1MatrixType, class _input2MatrixType>
+        class Task
+        {
+        public:
+            const _input1MatrixType & Input1;
+            const _input2MatrixType & Input2;
+            const bool SplitRows;
+            const size_type NumberOfChunks;
+            OutputType Results[vctParallel::MAXIMUM_NUMBER_OF_CHUNKS];
+
+            Task(const _input1MatrixType & input1, const _input2MatrixType & input2, bool splitRows, size_type numberOfChunks):
+                Input1(input1), Input2(input2), SplitRows(splitRows), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                Task & task = *static_cast<Task *>(data);
+                ConstChunkRef<_input1MatrixType> input1(task.Input1, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_input2MatrixType> input2(task.Input2, task.SplitRows, chunkIndex, task.NumberOfChunks);
+                task.Results[chunkIndex] = SerialEngine::Run(input1, input2);
+            }
+        };
+
+    public:
+        template <class _input1MatrixType, class _input2MatrixType>
+        static OutputType Run(const vctParallel & parallel,
+                              const _input1MatrixType & input1Matrix,
+                              const _input2MatrixType & input2Matrix)
+        {
+            const bool splitRows = ChunkRows(input1Matrix);
+            const size_type numberOfChunks = NumberOfChunks(parallel, input1Matrix, splitRows);
+            if (numberOfChunks == 1) {
+                return SerialEngine::Run(input1Matrix, input2Matrix);
+            }
+            CheckSizes(input1Matrix, input2Matrix);
+            typedef Task<_input1MatrixType, _input2MatrixType> TaskType;
+            TaskType task(input1Matrix, input2Matrix, splitRows, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+            OutputType incrementalResult = _incrementalOperationType::NeutralElement();
+            for (size_type chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex) {
+                incrementalResult = _incrementalOperationType::Operate(incrementalResult, task.Results[chunkIndex]);
+            }
+            return incrementalResult;
+        }
+    };  // SoMiMi class
+
+};
+
+
+#endif  // _vctDynamicMatrixParallelLoopEngines_h
@@ -0,0 +1,108 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicMatrixProductBackend_h
+#define _vctDynamicMatrixProductBackend_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicMatrixProductBackend
+*/
+
+#include <cisstCommon/cmnPortability.h>
+
+// Always include last
+#include <cisstVector/vctExport.h>
+
+/*!
+  \brief Optional external implementation of the dynamic matrix product
+
+  cisstVector doesn't depend on any BLAS library.  A library which
+  does (e.g. cisstNumerical with cisstNetlib, see
+  nmrUseBLASForMatrixProduct) can register a general matrix product
+  function here.  Once registered, vctDynamicMatrixBase::ProductOf
+  forwards the products of compact double precision matrices to this
+  function when all the dimensions (rows, columns and common
+  dimension) are greater or equal to MinimumSize().  All other
+  products use the engines of vctDynamicMatrixLoopEngines.
+
+  The registered function follows the BLAS conventions for column
+  major storage: it computes C = op(A) * op(B) where C is m x n, op(A)
+  is m x k and op(B) is k x n, op(X) being either X or its transpose.
+
+  The registration is not thread safe, it should be performed during
+  the initialization of the application, before any thread might
+  compute a product.
+*/
+class CISST_EXPORT vctDynamicMatrixProductBackend {
+public:
+    /*! Type of the function computing the product of double precision
+      matrices in column major storage order. */
+    typedef void (*DoubleFunctionType)(bool transposeA, bool transposeB,
+                                       size_t m, size_t n, size_t k,
+                                       const double * A, size_t lda,
+                                       const double * B, size_t ldb,
+                                       double * C, size_t ldc);
+
+    /*! Register the function used for double precision products with
+      all dimensions greater or equal to minimumSize.  Use a null
+      pointer to disable the backend. */
+    static void SetDoubleFunction(DoubleFunctionType function, size_t minimumSize);
+
+    /*! Function currently registered, null pointer if none. */
+    static DoubleFunctionType DoubleFunction(void);
+
+    /*! Smallest dimension forwarded to the registered function. */
+    static size_t MinimumSize(void);
+
+    /*! Compute the product with the registered function if any and if
+      all the dimensions are large enough.  Return false if the
+      product has not been computed, i.e. the caller should compute
+      it.  The generic version is used for all element types but
+      double and always returns false. */
+    template <class _elementType>
+    inline static bool Run(bool CMN_UNUSED(transposeA), bool CMN_UNUSED(transposeB),
+                           size_t CMN_UNUSED(m), size_t CMN_UNUSED(n), size_t CMN_UNUSED(k),
+                           const _elementType * CMN_UNUSED(A), size_t CMN_UNUSED(lda),
+                           const _elementType * CMN_UNUSED(B), size_t CMN_UNUSED(ldb),
+                           _elementType * CMN_UNUSED(C), size_t CMN_UNUSED(ldc)) {
+        return false;
+    }
+
+    /*! Double precision version, see generic version above. */
+    inline static bool Run(bool transposeA, bool transposeB,
+                           size_t m, size_t n, size_t k,
+                           const double * A, size_t lda,
+                           const double * B, size_t ldb,
+                           double * C, size_t ldc) {
+        if ((DoubleFunctionMember == 0)
+            || (m < MinimumSizeMember) || (n < MinimumSizeMember) || (k < MinimumSizeMember)) {
+            return false;
+        }
+        DoubleFunctionMember(transposeA, transposeB, m, n, k, A, lda, B, ldb, C, ldc);
+        return true;
+    }
+
+protected:
+    static DoubleFunctionType DoubleFunctionMember;
+    static size_t MinimumSizeMember;
+};
+
+#endif  // _vctDynamicMatrixProductBackend_h
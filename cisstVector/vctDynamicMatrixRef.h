@@ -349,6 +349,11 @@ public:
     inline ThisType & operator = (const vctFixedSizeConstMatrixBase<__rows, __cols, __rowStride, __colStride, _elementType, __dataPtrType> & other) {
         return reinterpret_cast<ThisType &>(this->Assign(other));
     }
+
+    template <class __nodeType>
+    inline ThisType & operator = (const vctDynamicMatrixExpression<__nodeType> & expression) {
+        return reinterpret_cast<ThisType &>(this->Assign(expression));
+    }
     //@}
 
     /*! Assignement of a scalar to all elements.  See also SetAll. */
@@ -987,6 +987,171 @@ public:
     //@}
 
 
+    /*! \name Parallel elementwise operations.
+      Same as the methods above, the nArrays are split along their
+      first dimension and the chunks are processed according to the
+      execution policy, see vctParallel. */
+    //@{
+    /*! Parallel binary elementwise operations between two nArrays,
+      see SumOf, DifferenceOf, ElementwiseProductOf and
+      ElementwiseRatioOf.
+
+      \param parallel The execution policy
+
+      \param nArray1 The first operand of the binary operation
+
+      \param nArray2 The second operand of the binary operation
+
+      \return The nArray "this" modified.
+    */
+    template <class __nArrayOwnerType1, class __nArrayOwnerType2>
+    inline ThisType & SumOf(const vctParallel & parallel,
+                            const vctDynamicConstNArrayBase<__nArrayOwnerType1, value_type, DIMENSION> & nArray1,
+                            const vctDynamicConstNArrayBase<__nArrayOwnerType2, value_type, DIMENSION> & nArray2)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NoNiNi< typename vctBinaryOperations<value_type>::Addition >
+            ::Run(parallel, *this, nArray1, nArray2);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nArrayOwnerType1, class __nArrayOwnerType2>
+    inline ThisType & DifferenceOf(const vctParallel & parallel,
+                                   const vctDynamicConstNArrayBase<__nArrayOwnerType1, value_type, DIMENSION> & nArray1,
+                                   const vctDynamicConstNArrayBase<__nArrayOwnerType2, value_type, DIMENSION> & nArray2)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NoNiNi< typename vctBinaryOperations<value_type>::Subtraction >
+            ::Run(parallel, *this, nArray1, nArray2);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nArrayOwnerType1, class __nArrayOwnerType2>
+    inline ThisType & ElementwiseProductOf(const vctParallel & parallel,
+                                           const vctDynamicConstNArrayBase<__nArrayOwnerType1, value_type, DIMENSION> & nArray1,
+                                           const vctDynamicConstNArrayBase<__nArrayOwnerType2, value_type, DIMENSION> & nArray2)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NoNiNi< typename vctBinaryOperations<value_type>::Multiplication >
+            ::Run(parallel, *this, nArray1, nArray2);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nArrayOwnerType1, class __nArrayOwnerType2>
+    inline ThisType & ElementwiseRatioOf(const vctParallel & parallel,
+                                         const vctDynamicConstNArrayBase<__nArrayOwnerType1, value_type, DIMENSION> & nArray1,
+                                         const vctDynamicConstNArrayBase<__nArrayOwnerType2, value_type, DIMENSION> & nArray2)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NoNiNi< typename vctBinaryOperations<value_type>::Division >
+            ::Run(parallel, *this, nArray1, nArray2);
+        return *this;
+    }
+
+    /*! Parallel store back binary elementwise operations between two
+      nArrays, see Add, Subtract, ElementwiseMultiply and
+      ElementwiseDivide.
+
+      \param parallel The execution policy
+
+      \param otherNArray The second operand of the binary operation
+      (this[i] is the first operand)
+
+      \return The nArray "this" modified.
+    */
+    template <class __nArrayOwnerType>
+    inline ThisType & Add(const vctParallel & parallel,
+                          const vctDynamicConstNArrayBase<__nArrayOwnerType, value_type, DIMENSION> & otherNArray)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioNi<typename vctStoreBackBinaryOperations<value_type>::Addition >::
+            Run(parallel, *this, otherNArray);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nArrayOwnerType>
+    inline ThisType & Subtract(const vctParallel & parallel,
+                               const vctDynamicConstNArrayBase<__nArrayOwnerType, value_type, DIMENSION> & otherNArray)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioNi<typename vctStoreBackBinaryOperations<value_type>::Subtraction >::
+            Run(parallel, *this, otherNArray);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nArrayOwnerType>
+    inline ThisType & ElementwiseMultiply(const vctParallel & parallel,
+                                          const vctDynamicConstNArrayBase<__nArrayOwnerType, value_type, DIMENSION> & otherNArray)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioNi<typename vctStoreBackBinaryOperations<value_type>::Multiplication >::
+            Run(parallel, *this, otherNArray);
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nArrayOwnerType>
+    inline ThisType & ElementwiseDivide(const vctParallel & parallel,
+                                        const vctDynamicConstNArrayBase<__nArrayOwnerType, value_type, DIMENSION> & otherNArray)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioNi<typename vctStoreBackBinaryOperations<value_type>::Division >::
+            Run(parallel, *this, otherNArray);
+        return *this;
+    }
+
+    /*! Parallel store back binary elementwise operations between an
+      nArray and a scalar, see Add, Subtract, Multiply and Divide.
+
+      \param parallel The execution policy
+
+      \param scalar The second operand of the binary operation
+        (this[i] is the first operand).
+
+      \return The nArray "this" modified.
+    */
+    inline ThisType & Add(const vctParallel & parallel, const value_type scalar)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioSi< typename vctStoreBackBinaryOperations<value_type>::Addition >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+
+    /* documented above */
+    inline ThisType & Subtract(const vctParallel & parallel, const value_type scalar)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioSi< typename vctStoreBackBinaryOperations<value_type>::Subtraction >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+
+    /* documented above */
+    inline ThisType & Multiply(const vctParallel & parallel, const value_type scalar)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioSi< typename vctStoreBackBinaryOperations<value_type>::Multiplication >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+
+    /* documented above */
+    inline ThisType & Divide(const vctParallel & parallel, const value_type scalar)
+    {
+        vctDynamicNArrayParallelLoopEngines<DIMENSION>::template
+            NioSi< typename vctStoreBackBinaryOperations<value_type>::Division >::
+            Run(parallel, *this, scalar);
+        return *this;
+    }
+    //@}
+
+
     template <class __nArrayOwnerType>
     inline ThisType & AddProductOf(const value_type scalar,
                                    const vctDynamicConstNArrayBase<__nArrayOwnerType, value_type, DIMENSION> & otherNArray)
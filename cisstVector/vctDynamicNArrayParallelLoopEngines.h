@@ -0,0 +1,532 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctDynamicNArrayParallelLoopEngines_h
+#define _vctDynamicNArrayParallelLoopEngines_h
+
+/*!
+  \file
+  \brief Declaration of vctDynamicNArrayParallelLoopEngines
+ */
+
+#include <cisstVector/vctForwardDeclarations.h>
+#include <cisstVector/vctDynamicNArrayLoopEngines.h>
+#include <cisstVector/vctParallel.h>
+
+/*!
+  \brief Container class for the parallel dynamic nArray engines.
+
+  Each engine has the same name and parameters as the corresponding
+  engine of vctDynamicNArrayLoopEngines, preceded by the execution
+  policy (see vctParallel).  The nArrays are split along their first
+  dimension and each chunk is processed by the engine of
+  vctDynamicNArrayLoopEngines, so the compact and SIMD loops are still
+  used within the chunks.  If the policy doesn't split the nArrays,
+  the engines of vctDynamicNArrayLoopEngines are used directly.
+
+  \sa NoNiNi NoNiSi NoSiNi NoNi NioNi NioSi Nio SoNi SoNiNi
+*/
+template <vct::size_type _dimension>
+class vctDynamicNArrayParallelLoopEngines
+{
+public:
+    /* define types */
+    typedef vct::size_type size_type;
+    typedef vct::stride_type stride_type;
+    typedef vct::difference_type difference_type;
+    typedef vct::index_type index_type;
+    typedef vctDynamicNArrayLoopEngines<_dimension> SerialEngines;
+
+    VCT_NARRAY_TRAITS_TYPEDEFS(_dimension);
+
+    /*! Number of chunks to split an nArray in, 1 if it should be
+      processed by the serial engines. */
+    template <class _nArrayType>
+    inline static size_type NumberOfChunks(const vctParallel & parallel, const _nArrayType & nArray)
+    {
+        return parallel.NumberOfChunks(nArray.size(), nArray.size(0));
+    }
+
+    /*! Helper function to throw an exception if the sizes of two
+      nArrays don't match before creating the tasks. */
+    template <class _nArray1Type, class _nArray2Type>
+    inline static void CheckSizes(const _nArray1Type & nArray1, const _nArray2Type & nArray2)
+    {
+        if (nArray1.sizes().NotEqual(nArray2.sizes())) {
+            SerialEngines::ThrowSizeMismatchException();
+        }
+    }
+
+    /*! Reference on a chunk of an nArray, see vctParallel::ChunkBegin. */
+    template <class _nArrayType>
+    class ChunkRef: public vctDynamicNArrayRef<typename _nArrayType::value_type, _dimension>
+    {
+    public:
+        ChunkRef(_nArrayType & nArray, size_type chunkIndex, size_type numberOfChunks)
+        {
+            const size_type outerSize = nArray.size(0);
+            const size_type begin = vctParallel::ChunkBegin(chunkIndex, numberOfChunks, outerSize);
+            nsize_type sizes(nArray.sizes());
+            sizes[0] = vctParallel::ChunkBegin(chunkIndex + 1, numberOfChunks, outerSize) - begin;
+            this->SetRef(nArray.Pointer() + static_cast<stride_type>(begin) * nArray.stride(0),
+                         sizes, nArray.strides());
+        }
+    };
+
+    /*! Const reference on a chunk of an nArray. */
+    template <class _nArrayType>
+    class ConstChunkRef: public vctDynamicConstNArrayRef<typename _nArrayType::value_type, _dimension>
+    {
+    public:
+        ConstChunkRef(const _nArrayType & nArray, size_type chunkIndex, size_type numberOfChunks)
+        {
+            const size_type outerSize = nArray.size(0);
+            const size_type begin = vctParallel::ChunkBegin(chunkIndex, numberOfChunks, outerSize);
+            nsize_type sizes(nArray.sizes());
+            sizes[0] = vctParallel::ChunkBegin(chunkIndex + 1, numberOfChunks, outerSize) - begin;
+            this->SetRef(nArray.Pointer() + static_cast<stride_type>(begin) * nArray.stride(0),
+                         sizes, nArray.strides());
+        }
+    };
+
+
+    template <class _elementOperationType>
+    class NoNiNi
+    {
+        typedef typename SerialEngines::template NoNiNi<_elementOperationType> SerialEngine;
+
+        template <class _outputNArrayType, class _input1NArrayType, class _input2NArrayType>
+        class Task
+        {
+        public:
+            _outputNArrayType & Output;
+            const _input1NArrayType & Input1;
+            const _input2NArrayType & Input2;
+            const size_type NumberOfChunks;
+
+            Task(_outputNArrayType & output, const _input1NArrayType & input1,
+                 const _input2NArrayType & input2, size_type numberOfChunks):
+                Output(output), Input1(input1), Input2(input2), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputNArrayType> output(task.Output, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_input1NArrayType> input1(task.Input1, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_input2NArrayType> input2(task.Input2, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, input1, input2);
+            }
+        };
+
+    public:
+        template <class _outputNArrayType, class _input1NArrayType, class _input2NArrayType>
+        static void Run(const vctParallel & parallel,
+                        _outputNArrayType & outputNArray,
+                        const _input1NArrayType & input1NArray,
+                        const _input2NArrayType & input2NArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputNArray, input1NArray, input2NArray);
+                return;
+            }
+            CheckSizes(outputNArray, input1NArray);
+            CheckSizes(outputNArray, input2NArray);
+            typedef Task<_outputNArrayType, _input1NArrayType, _input2NArrayType> TaskType;
+            TaskType task(outputNArray, input1NArray, input2NArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // NoNiNi class
+
+
+    template <class _elementOperationType>
+    class NoNiSi
+    {
+        typedef typename SerialEngines::template NoNiSi<_elementOperationType> SerialEngine;
+
+        template <class _outputNArrayType, class _inputNArrayType, class _inputScalarType>
+        class Task
+        {
+        public:
+            _outputNArrayType & Output;
+            const _inputNArrayType & Input;
+            const _inputScalarType & Scalar;
+            const size_type NumberOfChunks;
+
+            Task(_outputNArrayType & output, const _inputNArrayType & input,
+                 const _inputScalarType & scalar, size_type numberOfChunks):
+                Output(output), Input(input), Scalar(scalar), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputNArrayType> output(task.Output, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputNArrayType> input(task.Input, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, input, task.Scalar);
+            }
+        };
+
+    public:
+        template <class _outputNArrayType, class _inputNArrayType, class _inputScalarType>
+        static void Run(const vctParallel & parallel,
+                        _outputNArrayType & outputNArray,
+                        const _inputNArrayType & inputNArray,
+                        const _inputScalarType inputScalar)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputNArray, inputNArray, inputScalar);
+                return;
+            }
+            CheckSizes(outputNArray, inputNArray);
+            typedef Task<_outputNArrayType, _inputNArrayType, _inputScalarType> TaskType;
+            TaskType task(outputNArray, inputNArray, inputScalar, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // NoNiSi class
+
+
+    template <class _elementOperationType>
+    class NoSiNi
+    {
+        typedef typename SerialEngines::template NoSiNi<_elementOperationType> SerialEngine;
+
+        template <class _outputNArrayType, class _inputScalarType, class _inputNArrayType>
+        class Task
+        {
+        public:
+            _outputNArrayType & Output;
+            const _inputScalarType & Scalar;
+            const _inputNArrayType & Input;
+            const size_type NumberOfChunks;
+
+            Task(_outputNArrayType & output, const _inputScalarType & scalar,
+                 const _inputNArrayType & input, size_type numberOfChunks):
+                Output(output), Scalar(scalar), Input(input), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputNArrayType> output(task.Output, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputNArrayType> input(task.Input, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, task.Scalar, input);
+            }
+        };
+
+    public:
+        template <class _outputNArrayType, class _inputScalarType, class _inputNArrayType>
+        static void Run(const vctParallel & parallel,
+                        _outputNArrayType & outputNArray,
+                        const _inputScalarType inputScalar,
+                        const _inputNArrayType & inputNArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputNArray, inputScalar, inputNArray);
+                return;
+            }
+            CheckSizes(outputNArray, inputNArray);
+            typedef Task<_outputNArrayType, _inputScalarType, _inputNArrayType> TaskType;
+            TaskType task(outputNArray, inputScalar, inputNArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // NoSiNi class
+
+
+    template <class _elementOperationType>
+    class NoNi
+    {
+        typedef typename SerialEngines::template NoNi<_elementOperationType> SerialEngine;
+
+        template <class _outputNArrayType, class _inputNArrayType>
+        class Task
+        {
+        public:
+            _outputNArrayType & Output;
+            const _inputNArrayType & Input;
+            const size_type NumberOfChunks;
+
+            Task(_outputNArrayType & output, const _inputNArrayType & input, size_type numberOfChunks):
+                Output(output), Input(input), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_outputNArrayType> output(task.Output, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputNArrayType> input(task.Input, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(output, input);
+            }
+        };
+
+    public:
+        template <class _outputNArrayType, class _inputNArrayType>
+        static void Run(const vctParallel & parallel,
+                        _outputNArrayType & outputNArray,
+                        const _inputNArrayType & inputNArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, outputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(outputNArray, inputNArray);
+                return;
+            }
+            CheckSizes(outputNArray, inputNArray);
+            typedef Task<_outputNArrayType, _inputNArrayType> TaskType;
+            TaskType task(outputNArray, inputNArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // NoNi class
+
+
+    template <class _elementOperationType>
+    class NioNi
+    {
+        typedef typename SerialEngines::template NioNi<_elementOperationType> SerialEngine;
+
+        template <class _inputOutputNArrayType, class _inputNArrayType>
+        class Task
+        {
+        public:
+            _inputOutputNArrayType & InputOutput;
+            const _inputNArrayType & Input;
+            const size_type NumberOfChunks;
+
+            Task(_inputOutputNArrayType & inputOutput, const _inputNArrayType & input, size_type numberOfChunks):
+                InputOutput(inputOutput), Input(input), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_inputOutputNArrayType> inputOutput(task.InputOutput, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_inputNArrayType> input(task.Input, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(inputOutput, input);
+            }
+        };
+
+    public:
+        template <class _inputOutputNArrayType, class _inputNArrayType>
+        static void Run(const vctParallel & parallel,
+                        _inputOutputNArrayType & inputOutputNArray,
+                        const _inputNArrayType & inputNArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputOutputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(inputOutputNArray, inputNArray);
+                return;
+            }
+            CheckSizes(inputOutputNArray, inputNArray);
+            typedef Task<_inputOutputNArrayType, _inputNArrayType> TaskType;
+            TaskType task(inputOutputNArray, inputNArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // NioNi class
+
+
+    template <class _elementOperationType>
+    class NioSi
+    {
+        typedef typename SerialEngines::template NioSi<_elementOperationType> SerialEngine;
+
+        template <class _inputOutputNArrayType, class _inputScalarType>
+        class Task
+        {
+        public:
+            _inputOutputNArrayType & InputOutput;
+            const _inputScalarType & Scalar;
+            const size_type NumberOfChunks;
+
+            Task(_inputOutputNArrayType & inputOutput, const _inputScalarType & scalar, size_type numberOfChunks):
+                InputOutput(inputOutput), Scalar(scalar), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_inputOutputNArrayType> inputOutput(task.InputOutput, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(inputOutput, task.Scalar);
+            }
+        };
+
+    public:
+        template <class _inputOutputNArrayType, class _inputScalarType>
+        static void Run(const vctParallel & parallel,
+                        _inputOutputNArrayType & inputOutputNArray,
+                        const _inputScalarType inputScalar)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputOutputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(inputOutputNArray, inputScalar);
+                return;
+            }
+            typedef Task<_inputOutputNArrayType, _inputScalarType> TaskType;
+            TaskType task(inputOutputNArray, inputScalar, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // NioSi class
+
+
+    template <class _elementOperationType>
+    class Nio
+    {
+        typedef typename SerialEngines::template Nio<_elementOperationType> SerialEngine;
+
+        template <class _inputOutputNArrayType>
+        class Task
+        {
+        public:
+            _inputOutputNArrayType & InputOutput;
+            const size_type NumberOfChunks;
+
+            Task(_inputOutputNArrayType & inputOutput, size_type numberOfChunks):
+                InputOutput(inputOutput), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                const Task & task = *static_cast<const Task *>(data);
+                ChunkRef<_inputOutputNArrayType> inputOutput(task.InputOutput, chunkIndex, task.NumberOfChunks);
+                SerialEngine::Run(inputOutput);
+            }
+        };
+
+    public:
+        template <class _inputOutputNArrayType>
+        static void Run(const vctParallel & parallel,
+                        _inputOutputNArrayType & inputOutputNArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputOutputNArray);
+            if (numberOfChunks == 1) {
+                SerialEngine::Run(inputOutputNArray);
+                return;
+            }
+            typedef Task<_inputOutputNArrayType> TaskType;
+            TaskType task(inputOutputNArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+        }
+    };  // Nio class
+
+
+    /*! The result of each chunk is stored and the results are combined
+      with the incremental operation in the order of the chunks, so the
+      result doesn't depend on the order in which the chunks are
+      processed. */
+    template <class _incrementalOperationType, class _elementOperationType>
+    class SoNi
+    {
+        typedef typename SerialEngines::template SoNi<_incrementalOperationType, _elementOperationType> SerialEngine;
+
+    public:
+        typedef typename _incrementalOperationType::OutputType OutputType;
+
+    protected:
+        template <class _inputNArrayType>
+        class Task
+        {
+        public:
+            const _inputNArrayType & Input;
+            const size_type NumberOfChunks;
+            OutputType Results[vctParallel::MAXIMUM_NUMBER_OF_CHUNKS];
+
+            Task(const _inputNArrayType & input, size_type numberOfChunks):
+                Input(input), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                Task & task = *static_cast<Task *>(data);
+                ConstChunkRef<_inputNArrayType> input(task.Input, chunkIndex, task.NumberOfChunks);
+                task.Results[chunkIndex] = SerialEngine::Run(input);
+            }
+        };
+
+    public:
+        template <class _inputNArrayType>
+        static OutputType Run(const vctParallel & parallel,
+                              const _inputNArrayType & inputNArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, inputNArray);
+            if (numberOfChunks == 1) {
+                return SerialEngine::Run(inputNArray);
+            }
+            typedef Task<_inputNArrayType> TaskType;
+            TaskType task(inputNArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+            OutputType incrementalResult = _incrementalOperationType::NeutralElement();
+            for (size_type chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex) {
+                incrementalResult = _incrementalOperationType::Operate(incrementalResult, task.Results[chunkIndex]);
+            }
+            return incrementalResult;
+        }
+    };  // SoNi class
+
+
+    /*! See SoNi for the order of the operations. */
+    template <class _incrementalOperationType, class _elementOperationType>
+    class SoNiNi
+    {
+        typedef typename SerialEngines::template SoNiNi<_incrementalOperationType, _elementOperationType> SerialEngine;
+
+    public:
+        typedef typename _incrementalOperationType::OutputType OutputType;
+
+    protected:
+        template <class _input1NArrayType, class _input2NArrayType>
+        class Task
+        {
+        public:
+            const _input1NArrayType & Input1;
+            const _input2NArrayType & Input2;
+            const size_type NumberOfChunks;
+            OutputType Results[vctParallel::MAXIMUM_NUMBER_OF_CHUNKS];
+
+            Task(const _input1NArrayType & input1, const _input2NArrayType & input2, size_type numberOfChunks):
+                Input1(input1), Input2(input2), NumberOfChunks(numberOfChunks)
+            {}
+
+            static void Run(void * data, size_type chunkIndex) {
+                Task & task = *static_cast<Task *>(data);
+                ConstChunkRef<_input1NArrayType> input1(task.Input1, chunkIndex, task.NumberOfChunks);
+                ConstChunkRef<_input2NArrayType> input2(task.Input2, chunkIndex, task.NumberOfChunks);
+                task.Results[chunkIndex] = SerialEngine::Run(input1, input2);
+            }
+        };
+
+    public:
+        template <class _input1NArrayType, class _input2NArrayType>
+        static OutputType Run(const vctParallel & parallel,
+                              const _input1NArrayType & input1NArray,
+                              const _input2NArrayType & input2NArray)
+        {
+            const size_type numberOfChunks = NumberOfChunks(parallel, input1NArray);
+            if (numberOfChunks == 1) {
+                return SerialEngine::Run(input1NArray, input2NArray);
+            }
+            CheckSizes(input1NArray, input2NArray);
+            typedef Task<_input1NArrayType, _input2NArrayType> TaskType;
+            TaskType task(input1NArray, input2NArray, numberOfChunks);
+            parallel.Run(&TaskType::Run, &task, numberOfChunks);
+            OutputType incrementalResult = _incrementalOperationType::NeutralElement();
+            for (size_type chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex) {
+                incrementalResult = _incrementalOperationType::Operate(incrementalResult, task.Results[chunkIndex]);
+            }
+            return incrementalResult;
+        }
+    };  // SoNiNi class
+
+};
+
+
+#endif  // _vctDynamicNArrayParallelLoopEngines_h
@@ -121,18 +121,23 @@ http://www.cisst.org/cisst/license.txt.
 
   \param _elementType the type of an element in the vector
 
+  \param _allocatorType the allocation policy, see
+  vctDynamicAllocatorBase.  The default policy aligns the elements on
+  64 bytes, use vctDynamicInlineAllocator to store small containers
+  without any heap allocation.
+
   \sa vctDynamicVectorBase vctDynamicConstVectorBase
 */
-template <class _elementType>
-class vctDynamicVector : public vctDynamicVectorBase<vctDynamicVectorOwner<_elementType>, _elementType>
+template <class _elementType, class _allocatorType>
+class vctDynamicVector : public vctDynamicVectorBase<vctDynamicVectorOwner<_elementType, _allocatorType>, _elementType>
 {
 
     friend class vctReturnDynamicVector<_elementType>;
 
 public:
     VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
-    typedef vctDynamicVector<_elementType> ThisType;
-    typedef vctDynamicVectorBase<vctDynamicVectorOwner<_elementType>, _elementType> BaseType;
+    typedef vctDynamicVector<_elementType, _allocatorType> ThisType;
+    typedef vctDynamicVectorBase<vctDynamicVectorOwner<_elementType, _allocatorType>, _elementType> BaseType;
     typedef typename BaseType::CopyType CopyType;
     typedef typename BaseType::TypeTraits TypeTraits;
     typedef typename BaseType::ElementVaArgPromotion ElementVaArgPromotion;
@@ -236,6 +241,15 @@ public:
         this->Assign(fixedVector);
     }
 
+    /*! Constructor from a lazy vector expression (see vctLazy).  The
+      expression is evaluated in a single loop, without any temporary
+      vector. */
+    template <class __nodeType>
+    vctDynamicVector(const vctDynamicVectorExpression<__nodeType> & expression) {
+        this->SetSize(expression.size());
+        this->Assign(expression);
+    }
+
     /*!  Assignment from a dynamic vector to a vector.  The
       operation discards the old memory allocated for this vector, and
       allocates new memory the size of the input vector.  Then the
@@ -269,6 +283,16 @@ public:
     */
     ThisType & operator = (const vctReturnDynamicVector<value_type> & other);
 
+    /*! Assignment from a lazy vector expression (see vctLazy).  This
+      vector is resized if needed and the expression is evaluated in a
+      single loop, without any temporary vector. */
+    template <class __nodeType>
+    ThisType & operator = (const vctDynamicVectorExpression<__nodeType> & expression) {
+        this->SetSize(expression.size());
+        this->Assign(expression);
+        return *this;
+    }
+
     /*! Assignement of a scalar to all elements.  See also SetAll. */
     inline ThisType & operator = (const value_type & value) {
         this->SetAll(value);
@@ -306,8 +330,7 @@ public:
         vctDynamicConstVectorRef<value_type> myDataMinSpaceRef(*this, corner, minSizes);
         vctDynamicVectorRef<value_type> newDataMinSpaceRef(newData, corner, minSizes);
         newDataMinSpaceRef.Assign(myDataMinSpaceRef);
-        this->Vector.Disown();
-        this->Vector.Own(size, newData.Vector.Release());
+        this->Vector.TakeOwnershipOf(newData.Vector);
     }
 
     /*! DESTRUCTIVE size change.  Change the size to the specified
@@ -395,39 +418,33 @@ public:
 */
 template <class _elementType>
 class vctReturnDynamicVector : public vctDynamicVector<_elementType> {
+    template <class __elementType, class __allocatorType> friend class vctDynamicVector;
 public:
     /*! Base type of vctReturnDynamicVector. */
     typedef vctDynamicVector<_elementType> BaseType;
     explicit vctReturnDynamicVector(const BaseType & other) {
         BaseType & nonConstOther = const_cast<BaseType &>(other);
-        // if we don't save it in a variable, it will be destroyed in the Release operation
-        const vct::size_type size = other.size();
-        this->Vector.Own(size, nonConstOther.Vector.Release());
+        this->Vector.TakeOwnershipOf(nonConstOther.Vector);
     }
 };
 
 
 // implementation of the special copy constuctor of vctDynamicVector
-template <class _elementType>
-vctDynamicVector<_elementType>::vctDynamicVector(const vctReturnDynamicVector<_elementType> & other) {
+template <class _elementType, class _allocatorType>
+vctDynamicVector<_elementType, _allocatorType>::vctDynamicVector(const vctReturnDynamicVector<_elementType> & other) {
     vctReturnDynamicVector<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicVector<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const size_type size = other.size();
-    this->Vector.Own(size, nonConstOther.Vector.Release());
+    this->Vector.TakeOwnershipOf(nonConstOther.Vector);
 }
 
 
 // implementation of the special assignment operator from vctReturnDynamicVector to vctDynamicVector
-template <class _elementType>
-vctDynamicVector<_elementType> &
-vctDynamicVector<_elementType>::operator = (const vctReturnDynamicVector<_elementType> & other) {
+template <class _elementType, class _allocatorType>
+vctDynamicVector<_elementType, _allocatorType> &
+vctDynamicVector<_elementType, _allocatorType>::operator = (const vctReturnDynamicVector<_elementType> & other) {
     vctReturnDynamicVector<_elementType> & nonConstOther =
         const_cast< vctReturnDynamicVector<_elementType> & >(other);
-    // if we don't save it in a variable, it will be destroyed in the Release operation
-    const vct::size_type size = other.size();
-    this->Vector.Disown();
-    this->Vector.Own(size, nonConstOther.Vector.Release());
+    this->Vector.TakeOwnershipOf(nonConstOther.Vector);
     return *this;
 }
 
@@ -300,6 +300,34 @@ public:
     //@}
 
 
+    /*!
+      \name Assignment from a lazy vector expression.
+
+      The expression is evaluated element by element in a single loop,
+      without any temporary vector (see vctLazy and
+      vctDynamicExpression.h).  The sizes must match.  The expression
+      can refer to this vector as long as each element of the result
+      only depends on the element of this vector with the same
+      position, e.g. <code>a.Assign(vctLazy(a) + vctLazy(b) * 2.0)</code>.
+
+      \param expression The vector expression to evaluate.
+    */
+    //@{
+    template <class __nodeType>
+    inline ThisType & Assign(const vctDynamicVectorExpression<__nodeType> & expression) {
+        vctDynamicVectorLoopEngines::
+            VioVe<typename vctStoreBackBinaryOperations<value_type>::SecondOperand>::
+            Run(*this, expression.Node());
+        return *this;
+    }
+
+    template <class __nodeType>
+    inline ThisType & operator = (const vctDynamicVectorExpression<__nodeType> & expression) {
+        return this->Assign(expression);
+    }
+    //@}
+
+
     /*!  \name Forced assignment operation between vectors of
       different types.  This method will use SetSize on the
       destination vector (this vector) to make sure the assignment
@@ -903,6 +931,39 @@ public:
     inline ThisType & operator -= (const vctDynamicConstVectorBase<__vectorOwnerType, _elementType> & otherVector) {
         return this->Subtract(otherVector);
     }
+
+    /*! Store back binary elementwise operations between a vector and
+      a lazy vector expression.  The expression is evaluated in the
+      same loop as the store back operation, i.e. without any
+      temporary vector.  See also Assign for lazy expressions. */
+    template <class __nodeType>
+    inline ThisType & Add(const vctDynamicVectorExpression<__nodeType> & expression) {
+        vctDynamicVectorLoopEngines::
+            VioVe<typename vctStoreBackBinaryOperations<value_type>::Addition>::
+            Run(*this, expression.Node());
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nodeType>
+    inline ThisType & Subtract(const vctDynamicVectorExpression<__nodeType> & expression) {
+        vctDynamicVectorLoopEngines::
+            VioVe<typename vctStoreBackBinaryOperations<value_type>::Subtraction>::
+            Run(*this, expression.Node());
+        return *this;
+    }
+
+    /* documented above */
+    template <class __nodeType>
+    inline ThisType & operator += (const vctDynamicVectorExpression<__nodeType> & expression) {
+        return this->Add(expression);
+    }
+
+    /* documented above */
+    template <class __nodeType>
+    inline ThisType & operator -= (const vctDynamicVectorExpression<__nodeType> & expression) {
+        return this->Subtract(expression);
+    }
     //@}
 
 
@@ -29,6 +29,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnPortability.h>
 #include <cisstCommon/cmnThrow.h>
+#include <cisstVector/vctForwardDeclarations.h>
 #include <cisstVector/vctDynamicCompactLoopEngines.h>
 
 /*!
@@ -231,6 +232,58 @@ class vctDynamicVectorLoopEngines {
     };
 
 
+    /*!  \brief Implement operation of the form \f$v_{io} = op(v_{io},
+      e)\f$ for dynamic vectors, where \f$e\f$ is a lazy vector
+      expression (see vctDynamicExpression.h)
+
+      The expression is evaluated element by element in a single
+      loop, i.e. \f$v_{io}[i] = \mathrm{op}(v_{io}[i], e[i])\f$.  If
+      the input output vector and all the vectors the expression
+      refers to are compact, the loop is performed by
+      vctDynamicCompactLoopEngines::CioCe.
+
+      \param _elementOperationType The type of the store back binary
+      operation.
+
+      \sa vctDynamicVectorLoopEngines
+    */
+    template<class _elementOperationType>
+    class VioVe {
+    public:
+        template<class _inputOutputVectorType, class _expressionNodeType>
+        static void Run(_inputOutputVectorType & inputOutputVector,
+                        const _expressionNodeType & expressionNode) {
+            typedef _inputOutputVectorType InputOutputVectorType;
+            typedef typename InputOutputVectorType::OwnerType InputOutputOwnerType;
+            typedef typename InputOutputOwnerType::pointer InputOutputPointerType;
+            typedef typename InputOutputOwnerType::size_type size_type;
+            typedef typename InputOutputOwnerType::index_type index_type;
+            typedef typename InputOutputOwnerType::stride_type stride_type;
+
+            // retrieve owner
+            InputOutputOwnerType & inputOutputOwner = inputOutputVector.Owner();
+
+            const size_type size = inputOutputOwner.size();
+            if (size != expressionNode.sizes()) {
+                ThrowException();
+            }
+
+            const stride_type inputOutputStride = inputOutputOwner.stride();
+
+            if ((inputOutputStride == 1) && expressionNode.IsCompact(VCT_ROW_MAJOR)) {
+                vctDynamicCompactLoopEngines::CioCe<_elementOperationType>::Run(inputOutputOwner, expressionNode);
+            } else {
+                InputOutputPointerType inputOutputPointer = inputOutputOwner.Pointer();
+                for (index_type index = 0;
+                     index < size;
+                     ++index, inputOutputPointer += inputOutputStride) {
+                    _elementOperationType::Operate(*inputOutputPointer, expressionNode.Element(index));
+                }
+            }
+        }
+    };
+
+
     /*!  \brief Implement operation of the form \f$(v_{1}, v_{2}) = op(v_{1},
       v_{2})\f$ for dynamic vectors
 
@@ -27,20 +27,37 @@ http://www.cisst.org/cisst/license.txt.
   \brief Declaration of vctDynamicVectorOwner
 */
 
+#include <cisstVector/vctForwardDeclarations.h>
+#include <cisstVector/vctDynamicAllocators.h>
 #include <cisstVector/vctFixedStrideVectorIterator.h>
 
+#include <algorithm>
+
 /*!
   This templated class owns a dynamically allocated array, but does
-  not provide any other operations */
-template<class _elementType>
-class vctDynamicVectorOwner
+  not provide any other operations.
+
+  The memory is managed by the allocation policy _allocatorType (see
+  vctDynamicAllocatorBase).  If the policy has an inline buffer
+  (vctDynamicInlineAllocator), vectors small enough to fit in it
+  don't allocate any memory.
+*/
+template<class _elementType, class _allocatorType>
+class vctDynamicVectorOwner:
+    protected vctDynamicInlineBuffer<(_allocatorType::INLINE_BYTES / sizeof(_elementType)) * sizeof(_elementType)>
 {
 public:
     /* define most types from vctContainerTraits */
     VCT_CONTAINER_TRAITS_TYPEDEFS(_elementType);
 
     /*! The type of this owner. */
-    typedef vctDynamicVectorOwner<_elementType> ThisType;
+    typedef vctDynamicVectorOwner<_elementType, _allocatorType> ThisType;
+
+    /*! Allocation policy */
+    typedef _allocatorType AllocatorType;
+
+    /*! Maximum number of elements stored in the inline buffer */
+    enum {INLINE_SIZE = AllocatorType::INLINE_BYTES / sizeof(value_type)};
 
     /* iterators are container specific */
     enum { DEFAULT_STRIDE = 1 };
@@ -57,7 +74,8 @@ public:
     {}
 
     vctDynamicVectorOwner(size_type size):
-        Size(0)
+        Size(0),
+        Data(0)
     {
         SetSize(size);
     }
@@ -127,28 +145,50 @@ public:
     void SetSize(size_type size) {
         if (size == Size) return;
         Disown();
-        Own(size, (size == 0) ? 0 : new value_type[size]);
+        Allocate(size);
     }
 
     /*! Release the currently owned data pointer from being owned.
       Reset this owner's data pointer and size to zero.  Return the
-      old data pointer without freeing memory.
+      old data pointer without freeing memory.  The returned block
+      is always allocated with new[] and must be freed with delete[].
+      Unless AllocatorType allocates with new[]
+      (vctDynamicNewAllocator), the elements are copied to a new block.
      */
     value_type * Release()
     {
-        value_type * oldData = Data;
-        Data = 0;
-        Size = 0;
+        value_type * oldData = 0;
+        if (AllocatorType::NEW_ARRAY && !IsInline()) {
+            oldData = Data;
+            Data = 0;
+            Size = 0;
+        } else if (Size != 0) {
+            oldData = new value_type[Size];
+            std::copy(Data, Data + Size, oldData);
+            Disown();
+        }
         return oldData;
     }
 
     /*! Have this owner take ownership of a new data pointer. Return
-      the old data pointer without freeing memory.
+      the old data pointer without freeing memory.  As for Release(),
+      both the new and old data pointers are allocated with new[].
+      Unless AllocatorType allocates with new[]
+      (vctDynamicNewAllocator), the elements are copied.
     */
     value_type * Own(size_type size, value_type * data) {
-        value_type * oldData = Data;
-        Size = size;
-        Data = data;
+        if (AllocatorType::NEW_ARRAY && !IsInline()) {
+            value_type * oldData = Data;
+            Size = size;
+            Data = data;
+            return oldData;
+        }
+        value_type * oldData = Release();
+        if (data != 0) {
+            SetSize(size);
+            std::copy(data, data + size, Data);
+            delete[] data;
+        }
         return oldData;
     }
 
@@ -156,13 +196,60 @@ public:
       pointer and size to zero.
     */
     void Disown(void) {
-        delete[] Data;
+        if (IsInline()) {
+            vctDynamicAllocatorBase::Destroy(Data, Size);
+        } else if (Data != 0) {
+            AllocatorType::template Deallocate<value_type>(Data, Size);
+        }
         Size = 0;
         Data = 0;
     }
 
+    /*! Take the data of another owner and disown it.  The memory
+      block of the other owner is transfered without copy unless the
+      data is stored in its inline buffer. */
+    void TakeOwnershipOf(ThisType & other) {
+        if (&other == this) return;
+        if (other.IsInline()) {
+            SetSize(other.Size);
+            std::copy(other.Data, other.Data + other.Size, Data);
+            other.Disown();
+        } else {
+            Disown();
+            Size = other.Size;
+            Data = other.Data;
+            other.Size = 0;
+            other.Data = 0;
+        }
+    }
+
+    /*! Same as above for an owner using a different allocation
+      policy, the elements are always copied. */
+    template <class __allocatorType>
+    void TakeOwnershipOf(vctDynamicVectorOwner<value_type, __allocatorType> & other) {
+        SetSize(other.size());
+        std::copy(other.Pointer(), other.Pointer() + other.size(), Data);
+        other.Disown();
+    }
+
+    /*! Test if the data is stored in the inline buffer. */
+    inline bool IsInline(void) const {
+        return (INLINE_SIZE != 0) && (Data != 0) && (Data == this->InlineMemory());
+    }
+
 
 protected:
+    /*! Allocate size elements, assumes the owner is empty. */
+    void Allocate(size_type size) {
+        if (size == 0) return;
+        if (size <= static_cast<size_type>(INLINE_SIZE)) {
+            Data = vctDynamicAllocatorBase::Construct<value_type>(this->InlineMemory(), size, 0);
+        } else {
+            Data = AllocatorType::template Allocate<value_type>(size);
+        }
+        Size = size;
+    }
+
     size_type Size;
     value_type* Data;
 
@@ -250,6 +250,11 @@ public:
     (const vctFixedSizeConstVectorBase<__size, __stride, __elementType, __dataPtrType> & other) {
         return reinterpret_cast<ThisType &>(this->Assign(other));
     }
+
+    template <class __nodeType>
+    inline ThisType & operator = (const vctDynamicVectorExpression<__nodeType> & expression) {
+        return reinterpret_cast<ThisType &>(this->Assign(expression));
+    }
     //@}
 
     /*! Assignement of a scalar to all elements.  See also SetAll. */
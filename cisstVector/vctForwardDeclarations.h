@@ -116,6 +116,12 @@ template <class _elementType, vct::size_type _rows, vct::size_type _cols,
 class vctFixedSizeMatrix;
 
 
+// allocation policies of dynamic vectors and matrices, see vctDynamicAllocators.h
+class vctDynamicAlignedAllocator;
+class vctDynamicArenaAllocator;
+class vctDynamicNewAllocator;
+
+
 // dynamic vectors
 template <class _vectorOwnerType, class _elementType>
 class vctDynamicConstVectorBase;
@@ -129,13 +135,13 @@ class vctDynamicConstVectorRef;
 template <class _elementType>
 class vctDynamicVectorRef;
 
-template <class _elementType>
+template <class _elementType, class _allocatorType = vctDynamicAlignedAllocator>
 class vctDynamicVector;
 
 template <class _elementType>
 class vctReturnDynamicVector;
 
-template <class _elementType>
+template <class _elementType, class _allocatorType = vctDynamicAlignedAllocator>
 class vctDynamicVectorOwner;
 
 template <class _elementType>
@@ -155,19 +161,27 @@ class vctDynamicConstMatrixRef;
 template <class _elementType>
 class vctDynamicMatrixRef;
 
-template <class _elementType>
+template <class _elementType, class _allocatorType = vctDynamicAlignedAllocator>
 class vctDynamicMatrix;
 
 template <class _elementType>
 class vctReturnDynamicMatrix;
 
-template <class _elementType>
+template <class _elementType, class _allocatorType = vctDynamicAlignedAllocator>
 class vctDynamicMatrixOwner;
 
 template <class _elementType>
 class vctDynamicMatrixRefOwner;
 
 
+// lazy expressions of dynamic vectors and matrices
+template <class _nodeType>
+class vctDynamicVectorExpression;
+
+template <class _nodeType>
+class vctDynamicMatrixExpression;
+
+
 // dynamic nArrays
 template <class _nArrayOwnerType, class _elementType, vct::size_type _dimension>
 class vctDynamicConstNArrayBase;
@@ -0,0 +1,175 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+
+  Created on: 2026-10-16
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _vctParallel_h
+#define _vctParallel_h
+
+/*!
+  \file
+  \brief Declaration of vctParallel
+*/
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstVector/vctContainerTraits.h>
+
+// Always include last
+#include <cisstVector/vctExport.h>
+
+/*!
+  \brief Execution policy for the parallel dynamic matrix and nArray engines
+
+  The methods of vctDynamicMatrixBase and vctDynamicNArrayBase taking
+  a vctParallel as first parameter (e.g. SumOf, Add, SumOfElements)
+  and the engines of vctDynamicMatrixParallelLoopEngines and
+  vctDynamicNArrayParallelLoopEngines split the containers along their
+  outermost dimension in chunks and process the chunks concurrently.
+  Containers with fewer elements than MinimumSize() are processed by
+  the usual single threaded engines.
+
+  cisstVector doesn't create any thread.  The chunks are handed to an
+  executor, i.e. a function running a number of tasks and returning
+  once they are all done.  osaThreadPool (cisstOSAbstraction) is such
+  an executor:
+  \code
+  osaThreadPool pool;             // one thread per processor
+  vctParallel parallel(pool);
+  volume.SumOf(parallel, volume1, volume2);
+  double sum = volume.SumOfElements(parallel);
+  \endcode
+  Without executor, the chunks are processed in the calling thread.
+
+  The number of chunks depends only on the size of the outermost
+  dimension, not on the number of threads, and the partial results
+  of reductions (e.g. SumOfElements) are always combined in the same
+  order.  Results are therefore identical from one run to the next
+  and for any number of threads.  They may differ from the single
+  threaded engines by rounding.
+
+  The tasks must not be stopped by an exception.  The parallel engines
+  check the sizes of all the operands before creating any task.
+*/
+class CISST_EXPORT vctParallel {
+public:
+    typedef vct::size_type size_type;
+
+    /*! Type of a task, called once per task index with the task
+      data given to Run. */
+    typedef void (*TaskFunctionType)(void * taskData, size_type taskIndex);
+
+    /*! Type of an executor function.  It must call task(taskData,
+      index) for all indices from 0 to numberOfTasks - 1, in any
+      order and from any thread, and return once all calls are
+      completed. */
+    typedef void (*ExecutorFunctionType)(void * executor,
+                                         TaskFunctionType task, void * taskData,
+                                         size_type numberOfTasks);
+
+    enum {
+        /*! Default minimum number of elements to use multiple chunks */
+        DEFAULT_MINIMUM_SIZE = 32768,
+        /*! Maximum number of chunks, containers are split in at most
+          as many chunks as the size of their outermost dimension */
+        MAXIMUM_NUMBER_OF_CHUNKS = 64
+    };
+
+    /*! Constructor using the default executor (see
+      SetDefaultExecutor) and minimum size. */
+    vctParallel(void);
+
+    /*! Constructor using the executor function, called with the
+      executor pointer as first parameter. */
+    vctParallel(ExecutorFunctionType executorFunction, void * executor,
+                size_type minimumSize = DEFAULT_MINIMUM_SIZE);
+
+    /*! Constructor using any executor class providing a static method
+      Execute with the signature of ExecutorFunctionType, e.g.
+      osaThreadPool.  The executor must exist as long as this policy
+      is used. */
+    template <class _executorType>
+    explicit vctParallel(_executorType & executor,
+                         size_type minimumSize = DEFAULT_MINIMUM_SIZE):
+        ExecutorFunctionMember(&_executorType::Execute),
+        ExecutorMember(&executor),
+        MinimumSizeMember(minimumSize)
+    {}
+
+    /*! Set the executor used by the policies created with the default
+      constructor afterwards.  Use a null function to process the
+      chunks in the calling thread.  This is not thread safe, it
+      should be performed during the initialization of the
+      application. */
+    static void SetDefaultExecutor(ExecutorFunctionType executorFunction, void * executor);
+
+    /*! Set the default executor, see the templated constructor. */
+    template <class _executorType>
+    inline static void SetDefaultExecutor(_executorType & executor) {
+        SetDefaultExecutor(&_executorType::Execute, &executor);
+    }
+
+    /*! Minimum number of elements to split a container in chunks. */
+    inline size_type MinimumSize(void) const {
+        return MinimumSizeMember;
+    }
+
+    inline void SetMinimumSize(size_type minimumSize) {
+        MinimumSizeMember = minimumSize;
+    }
+
+    /*! Number of chunks used for a container with size elements and
+      outerSize elements along its outermost dimension.  Returns 1 if
+      the container should be processed by the single threaded
+      engines. */
+    inline size_type NumberOfChunks(size_type size, size_type outerSize) const {
+        if ((size < MinimumSizeMember) || (size == 0)) {
+            return 1;
+        }
+        const size_type maximumNumberOfChunks = MAXIMUM_NUMBER_OF_CHUNKS;
+        return (outerSize < maximumNumberOfChunks) ? outerSize : maximumNumberOfChunks;
+    }
+
+    /*! First index along the outermost dimension of a chunk.  Chunk
+      chunkIndex covers the indices from ChunkBegin(chunkIndex) to
+      ChunkBegin(chunkIndex + 1) - 1. */
+    inline static size_type ChunkBegin(size_type chunkIndex, size_type numberOfChunks, size_type outerSize) {
+        return (chunkIndex * outerSize) / numberOfChunks;
+    }
+
+    /*! Run all the tasks using the executor, or sequentially in the
+      calling thread if there is no executor. */
+    inline void Run(TaskFunctionType task, void * taskData, size_type numberOfTasks) const {
+        if ((ExecutorFunctionMember != 0) && (numberOfTasks > 1)) {
+            ExecutorFunctionMember(ExecutorMember, task, taskData, numberOfTasks);
+        } else {
+            for (size_type index = 0; index < numberOfTasks; ++index) {
+                task(taskData, index);
+            }
+        }
+    }
+
+protected:
+    ExecutorFunctionType ExecutorFunctionMember;
+    void * ExecutorMember;
+    size_type MinimumSizeMember;
+
+    static ExecutorFunctionType DefaultExecutorFunctionMember;
+    static void * DefaultExecutorMember;
+};
+
+#endif  // _vctParallel_h